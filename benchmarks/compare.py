@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+"""Compares two results files written by pvbenchmarks.
+
+Usage: compare.py baseline.json candidate.json [threshold]
+
+For each case present in both files, prints the baseline and candidate median times and their
+ratio. A case whose median time grew by more than the threshold (a fraction, 0.05 by default)
+is marked as a regression, and one that shrank by more than the threshold as an improvement.
+The exit status is 1 if any case regressed, so that the script can be used in a build.
+"""
+import json
+import sys
+
+def readresults(filename):
+    with open(filename) as f:
+        contents = json.load(f)
+    results = {}
+    for r in contents['results']:
+        results[r['description']] = r
+    return contents, results
+
+def main(argv):
+    if len(argv) < 3 or len(argv) > 4:
+        sys.stderr.write(__doc__)
+        return 2
+    threshold = float(argv[3]) if len(argv) == 4 else 0.05
+    baseline, baseresults = readresults(argv[1])
+    candidate, candresults = readresults(argv[2])
+    if baseline['numProcesses'] != candidate['numProcesses']:
+        sys.stderr.write('Warning: the files were run with %d and %d processes\n' %
+                         (baseline['numProcesses'], candidate['numProcesses']))
+
+    print('baseline:  %s (%s)' % (baseline['revision'], baseline['date']))
+    print('candidate: %s (%s)' % (candidate['revision'], candidate['date']))
+    width = max([len(d) for d in set(baseresults) | set(candresults)] + [4])
+    print('%-*s %14s %14s %8s' % (width, 'case', 'baseline (us)', 'candidate (us)', 'ratio'))
+    numRegressions = 0
+    for description in sorted(candresults):
+        if description not in baseresults:
+            continue
+        base = baseresults[description]['medianSeconds']
+        cand = candresults[description]['medianSeconds']
+        ratio = cand / base if base > 0 else float('inf')
+        mark = ''
+        if ratio > 1.0 + threshold:
+            mark = 'REGRESSION'
+            numRegressions += 1
+        elif ratio < 1.0 - threshold:
+            mark = 'improvement'
+        line = '%-*s %14.3f %14.3f %8.3f %s' % (width, description, base * 1.0e6, cand * 1.0e6,
+                                                 ratio, mark)
+        print(line.rstrip())
+    for description in sorted(set(baseresults) - set(candresults)):
+        print('%-*s only in baseline' % (width, description))
+    for description in sorted(set(candresults) - set(baseresults)):
+        print('%-*s only in candidate' % (width, description))
+    return 1 if numRegressions > 0 else 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,31 @@
+#include "ActiveIndicesBenchmark.hpp"
+#include <random>
+
+namespace PV {
+
+ActiveIndicesBenchmark::ActiveIndicesBenchmark(int numItems, double sparsity)
+      : Benchmark("ActiveIndices"), mNumItems(numItems), mSparsity(sparsity) {
+   addParameter("n", numItems);
+   addParameter("sparsity", sparsity);
+}
+
+ActiveIndicesBenchmark::~ActiveIndicesBenchmark() { delete mDataStore; }
+
+void ActiveIndicesBenchmark::setUp() {
+   mDataStore  = new DataStore(1 /*numBuffers*/, mNumItems, 1 /*numLevels*/, true /*isSparse*/);
+   float *data = mDataStore->buffer(0, 0);
+   std::mt19937 generator(1U);
+   std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+   for (int k = 0; k < mNumItems; k++) {
+      data[k] = uniform(generator) >= (float)mSparsity ? 1.0f - uniform(generator) : 0.0f;
+   }
+}
+
+void ActiveIndicesBenchmark::run() { mDataStore->updateActiveIndices(0, 0); }
+
+void ActiveIndicesBenchmark::tearDown() {
+   delete mDataStore;
+   mDataStore = nullptr;
+}
+
+} // namespace PV
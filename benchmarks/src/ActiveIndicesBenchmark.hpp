@@ -0,0 +1,35 @@
+#ifndef ACTIVEINDICESBENCHMARK_HPP_
+#define ACTIVEINDICESBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include "columns/DataStore.hpp"
+
+namespace PV {
+
+/**
+ * Times DataStore::updateActiveIndices(), which builds the list of nonzero values of a sparse
+ * layer's activity. The data store holds one buffer of the given number of values, of which the
+ * given fraction are zero.
+ *
+ * The work unit is the activity value scanned.
+ */
+class ActiveIndicesBenchmark : public Benchmark {
+  public:
+   ActiveIndicesBenchmark(int numItems, double sparsity);
+   virtual ~ActiveIndicesBenchmark();
+
+   virtual void setUp() override;
+   virtual void run() override;
+   virtual void tearDown() override;
+   virtual double getWorkPerRun() const override { return (double)mNumItems; }
+   virtual char const *getWorkUnit() const override { return "values"; }
+
+  private:
+   int mNumItems;
+   double mSparsity;
+   DataStore *mDataStore = nullptr;
+};
+
+} // namespace PV
+
+#endif // ACTIVEINDICESBENCHMARK_HPP_
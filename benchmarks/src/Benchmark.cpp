@@ -0,0 +1,33 @@
+#include "Benchmark.hpp"
+#include <cstdio>
+
+namespace PV {
+
+std::string Benchmark::getDescription() const {
+   std::string description = mName;
+   if (!mParameters.empty()) {
+      description.append("[");
+      for (std::size_t k = 0; k < mParameters.size(); k++) {
+         description.append(k == 0 ? "" : ",");
+         description.append(mParameters[k].first).append("=").append(mParameters[k].second);
+      }
+      description.append("]");
+   }
+   return description;
+}
+
+void Benchmark::addParameter(std::string const &key, std::string const &value) {
+   mParameters.emplace_back(key, value);
+}
+
+void Benchmark::addParameter(std::string const &key, int value) {
+   addParameter(key, std::to_string(value));
+}
+
+void Benchmark::addParameter(std::string const &key, double value) {
+   char valueString[32];
+   snprintf(valueString, sizeof(valueString), "%g", value);
+   addParameter(key, std::string(valueString));
+}
+
+} // namespace PV
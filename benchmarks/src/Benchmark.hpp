@@ -0,0 +1,64 @@
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace PV {
+
+/**
+ * A base class for one case of the micro-benchmark suite. A case is a named operation together
+ * with the parameters it was set up with, for example the presynaptic convolve delivery with a
+ * 7x7 patch and 90% sparse input. BenchmarkRunner calls setUp() once, calls run() repeatedly
+ * while timing it, and then calls tearDown().
+ *
+ * run() must be repeatable: each call should do the same amount of work as the last one, so that
+ * the timings are samples of the same quantity.
+ */
+class Benchmark {
+  public:
+   Benchmark(std::string const &name) : mName(name) {}
+   virtual ~Benchmark() {}
+
+   /** Allocates and initializes the data that run() operates on. */
+   virtual void setUp() {}
+
+   /** The operation being timed. */
+   virtual void run() = 0;
+
+   /** Frees the data allocated by setUp(). */
+   virtual void tearDown() {}
+
+   /**
+    * The amount of work done on this process by one call to run(), in the units returned by
+    * getWorkUnit(). The throughput of the case is this quantity, summed over processes, divided
+    * by the median time of run().
+    */
+   virtual double getWorkPerRun() const = 0;
+
+   /** The unit of getWorkPerRun(), for example "synapses" or "bytes". */
+   virtual char const *getWorkUnit() const = 0;
+
+   std::string const &getName() const { return mName; }
+
+   /** The name and parameters, in the form name[key=value,key=value]. */
+   std::string getDescription() const;
+
+   std::vector<std::pair<std::string, std::string>> const &getParameters() const {
+      return mParameters;
+   }
+
+  protected:
+   void addParameter(std::string const &key, std::string const &value);
+   void addParameter(std::string const &key, int value);
+   void addParameter(std::string const &key, double value);
+
+  private:
+   std::string mName;
+   std::vector<std::pair<std::string, std::string>> mParameters;
+};
+
+} // namespace PV
+
+#endif // BENCHMARK_HPP_
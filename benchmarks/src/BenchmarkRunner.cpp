@@ -0,0 +1,164 @@
+#include "BenchmarkRunner.hpp"
+#include "io/FileStream.hpp"
+#include "utils/PVLog.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+namespace PV {
+
+namespace {
+
+std::string jsonString(std::string const &s) {
+   std::string quoted("\"");
+   for (char c : s) {
+      if (c == '"' or c == '\\') {
+         quoted.push_back('\\');
+      }
+      quoted.push_back(c);
+   }
+   quoted.push_back('"');
+   return quoted;
+}
+
+} // end anonymous namespace
+
+BenchmarkRunner::BenchmarkRunner(MPI_Comm comm) : mComm(comm) {}
+
+BenchmarkRunner::~BenchmarkRunner() {
+   for (auto &b : mBenchmarks) {
+      delete b;
+   }
+}
+
+void BenchmarkRunner::addBenchmark(Benchmark *benchmark) { mBenchmarks.push_back(benchmark); }
+
+void BenchmarkRunner::list() const {
+   for (auto &b : mBenchmarks) {
+      InfoLog() << b->getDescription() << "\n";
+   }
+}
+
+int BenchmarkRunner::run(std::string const &filter) {
+   int rank;
+   MPI_Comm_rank(mComm, &rank);
+   int numRun = 0;
+   for (auto &b : mBenchmarks) {
+      if (!filter.empty() and b->getDescription().find(filter) == std::string::npos) {
+         continue;
+      }
+      b->setUp();
+      Result result = measure(b);
+      b->tearDown();
+      mResults.push_back(result);
+      numRun++;
+      if (rank == 0) {
+         InfoLog().printf(
+               "%-64s median %11.3f us  p95 %11.3f us  %10.4g %s/s\n",
+               result.mDescription.c_str(),
+               result.mMedian * 1.0e6,
+               result.mP95 * 1.0e6,
+               result.mThroughput,
+               result.mWorkUnit.c_str());
+      }
+   }
+   return numRun;
+}
+
+double BenchmarkRunner::timeRuns(Benchmark *benchmark, int numRuns) {
+   MPI_Barrier(mComm);
+   auto start = std::chrono::steady_clock::now();
+   for (int n = 0; n < numRuns; n++) {
+      benchmark->run();
+   }
+   auto stop      = std::chrono::steady_clock::now();
+   double elapsed = std::chrono::duration<double>(stop - start).count();
+   MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, mComm);
+   return elapsed;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::measure(Benchmark *benchmark) {
+   for (int n = 0; n < mNumWarmups; n++) {
+      benchmark->run();
+   }
+   // The number of runs per sample is computed from the reduced time, so it is the same on
+   // every process.
+   double const oneRun = timeRuns(benchmark, 1);
+   int runsPerSample   = 1;
+   if (oneRun < mMinSampleTime) {
+      runsPerSample = (int)std::ceil(mMinSampleTime / std::max(oneRun, 1.0e-9));
+   }
+
+   std::vector<double> samples(mNumSamples);
+   for (auto &s : samples) {
+      s = timeRuns(benchmark, runsPerSample) / (double)runsPerSample;
+   }
+   std::sort(samples.begin(), samples.end());
+   int const n = mNumSamples;
+
+   Result result;
+   result.mName          = benchmark->getName();
+   result.mDescription   = benchmark->getDescription();
+   result.mParameters    = benchmark->getParameters();
+   result.mNumSamples    = n;
+   result.mRunsPerSample = runsPerSample;
+   result.mMedian        = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+   result.mP95           = samples[std::max((int)std::ceil(0.95 * n) - 1, 0)];
+   result.mMin           = samples[0];
+   double sum            = 0.0;
+   for (auto const &s : samples) {
+      sum += s;
+   }
+   result.mMean = sum / (double)n;
+
+   double work = benchmark->getWorkPerRun();
+   MPI_Allreduce(MPI_IN_PLACE, &work, 1, MPI_DOUBLE, MPI_SUM, mComm);
+   result.mThroughput = result.mMedian > 0.0 ? work / result.mMedian : 0.0;
+   result.mWorkUnit   = benchmark->getWorkUnit();
+   return result;
+}
+
+void BenchmarkRunner::writeJSON(std::string const &path, std::string const &revision) const {
+   int rank, size;
+   MPI_Comm_rank(mComm, &rank);
+   MPI_Comm_size(mComm, &size);
+   if (rank != 0) {
+      return;
+   }
+   char dateString[32];
+   std::time_t now = std::time(nullptr);
+   std::strftime(dateString, sizeof(dateString), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+   FileStream stream(path.c_str(), std::ios_base::out);
+   stream << "{\n";
+   stream << "  \"revision\": " << jsonString(revision) << ",\n";
+   stream << "  \"date\": " << jsonString(dateString) << ",\n";
+   stream << "  \"numProcesses\": " << size << ",\n";
+   stream << "  \"results\": [";
+   for (std::size_t k = 0; k < mResults.size(); k++) {
+      Result const &r = mResults[k];
+      stream << (k == 0 ? "\n" : ",\n");
+      stream << "    {\n";
+      stream << "      \"name\": " << jsonString(r.mName) << ",\n";
+      stream << "      \"description\": " << jsonString(r.mDescription) << ",\n";
+      stream << "      \"parameters\": {";
+      for (std::size_t p = 0; p < r.mParameters.size(); p++) {
+         stream << (p == 0 ? "" : ", ") << jsonString(r.mParameters[p].first) << ": "
+                << jsonString(r.mParameters[p].second);
+      }
+      stream << "},\n";
+      stream.printf("      \"samples\": %d,\n", r.mNumSamples);
+      stream.printf("      \"runsPerSample\": %d,\n", r.mRunsPerSample);
+      stream.printf("      \"medianSeconds\": %.9g,\n", r.mMedian);
+      stream.printf("      \"p95Seconds\": %.9g,\n", r.mP95);
+      stream.printf("      \"minSeconds\": %.9g,\n", r.mMin);
+      stream.printf("      \"meanSeconds\": %.9g,\n", r.mMean);
+      stream.printf("      \"throughput\": %.9g,\n", r.mThroughput);
+      stream << "      \"throughputUnit\": " << jsonString(r.mWorkUnit + "/s") << "\n";
+      stream << "    }";
+   }
+   stream << "\n  ]\n}\n";
+}
+
+} // namespace PV
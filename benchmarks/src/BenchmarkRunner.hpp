@@ -0,0 +1,82 @@
+#ifndef BENCHMARKRUNNER_HPP_
+#define BENCHMARKRUNNER_HPP_
+
+#include "Benchmark.hpp"
+#include "arch/mpi/mpi.h"
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * Times a list of Benchmark cases and reports robust statistics of the timings.
+ *
+ * For each case, the runner calls run() a few times to warm up caches and lazily allocated
+ * buffers, and then times one call to choose how many calls make up one sample, so that each
+ * sample takes at least the minimum sample time and timer resolution does not matter. Each sample
+ * is preceded by a barrier, and its time is the maximum over the processes of the communicator,
+ * so that cases that communicate are timed by their slowest process. The median and the 95th
+ * percentile of the samples are reported, since they are insensitive to the occasional sample
+ * that is slowed down by the operating system.
+ */
+class BenchmarkRunner {
+  public:
+   struct Result {
+      std::string mName;
+      std::string mDescription;
+      std::vector<std::pair<std::string, std::string>> mParameters;
+      int mNumSamples;
+      int mRunsPerSample;
+      double mMedian; // seconds per call to run()
+      double mP95;
+      double mMin;
+      double mMean;
+      double mThroughput; // work units per second, at the median time
+      std::string mWorkUnit;
+   };
+
+   BenchmarkRunner(MPI_Comm comm);
+
+   /** Deletes the benchmarks that were added. */
+   ~BenchmarkRunner();
+
+   /** Adds a case to the list. The runner takes ownership of the benchmark. */
+   void addBenchmark(Benchmark *benchmark);
+
+   /**
+    * Runs every case whose description contains the filter string (every case if the filter is
+    * empty), in the order they were added. Returns the number of cases that were run.
+    */
+   int run(std::string const &filter);
+
+   /** Prints the name of each case, one per line, to the output stream. */
+   void list() const;
+
+   /**
+    * Writes the results to a JSON file, on the root process only. The revision string
+    * identifies the build, so that files from different commits can be compared.
+    */
+   void writeJSON(std::string const &path, std::string const &revision) const;
+
+   void setNumSamples(int numSamples) { mNumSamples = numSamples; }
+   void setNumWarmups(int numWarmups) { mNumWarmups = numWarmups; }
+   void setMinSampleTime(double seconds) { mMinSampleTime = seconds; }
+
+   std::vector<Result> const &getResults() const { return mResults; }
+
+  private:
+   double timeRuns(Benchmark *benchmark, int numRuns);
+   Result measure(Benchmark *benchmark);
+
+  private:
+   MPI_Comm mComm;
+   int mNumSamples       = 20;
+   int mNumWarmups       = 2;
+   double mMinSampleTime = 0.01;
+   std::vector<Benchmark *> mBenchmarks;
+   std::vector<Result> mResults;
+};
+
+} // namespace PV
+
+#endif // BENCHMARKRUNNER_HPP_
@@ -0,0 +1,61 @@
+#include "BorderExchangeBenchmark.hpp"
+#include "structures/MPIBlock.hpp"
+
+namespace PV {
+
+BorderExchangeBenchmark::BorderExchangeBenchmark(
+      PV_Init *initObj,
+      int localSize,
+      int nf,
+      int margin)
+      : Benchmark("BorderExchange"),
+        mInitObj(initObj),
+        mLocalSize(localSize),
+        mNumFeatures(nf),
+        mMargin(margin) {
+   addParameter("n", localSize);
+   addParameter("nf", nf);
+   addParameter("margin", margin);
+}
+
+BorderExchangeBenchmark::~BorderExchangeBenchmark() { delete mBorderExchange; }
+
+void BorderExchangeBenchmark::setUp() {
+   // The PV_Init object rebuilds its Communicator whenever its params change, so the MPI block
+   // is retrieved here instead of in the constructor.
+   MPIBlock const *mpiBlock = mInitObj->getCommunicator()->getLocalMPIBlock();
+
+   PVLayerLoc loc;
+   loc.nbatch       = 1;
+   loc.nx           = mLocalSize;
+   loc.ny           = mLocalSize;
+   loc.nf           = mNumFeatures;
+   loc.nbatchGlobal = 1;
+   loc.nxGlobal     = mLocalSize * mpiBlock->getNumColumns();
+   loc.nyGlobal     = mLocalSize * mpiBlock->getNumRows();
+   loc.kb0          = 0;
+   loc.kx0          = mLocalSize * mpiBlock->getColumnIndex();
+   loc.ky0          = mLocalSize * mpiBlock->getRowIndex();
+   loc.halo.lt      = mMargin;
+   loc.halo.rt      = mMargin;
+   loc.halo.dn      = mMargin;
+   loc.halo.up      = mMargin;
+
+   mBorderExchange = new BorderExchange(*mpiBlock, loc);
+   int const numExtended = (mLocalSize + 2 * mMargin) * (mLocalSize + 2 * mMargin) * mNumFeatures;
+   mData.assign(numExtended, 1.0f);
+   mNumBytes = (double)mBorderExchange->getNumBytesPerExchange();
+}
+
+void BorderExchangeBenchmark::run() {
+   mBorderExchange->exchange(mData.data(), mRequests);
+   BorderExchange::wait(mRequests);
+}
+
+void BorderExchangeBenchmark::tearDown() {
+   delete mBorderExchange;
+   mBorderExchange = nullptr;
+   mData.clear();
+}
+
+} // namespace PV
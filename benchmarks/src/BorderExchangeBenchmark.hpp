@@ -0,0 +1,43 @@
+#ifndef BORDEREXCHANGEBENCHMARK_HPP_
+#define BORDEREXCHANGEBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include "columns/PV_Init.hpp"
+#include "utils/BorderExchange.hpp"
+#include <vector>
+
+namespace PV {
+
+/**
+ * Times one border exchange, BorderExchange::exchange() followed by BorderExchange::wait(), of a
+ * layer of the given local size, number of features, and margin width, using the process
+ * arrangement of the local MPI block.
+ *
+ * The work unit is the byte sent. With a single process there is nothing to send, and the
+ * throughput is zero.
+ */
+class BorderExchangeBenchmark : public Benchmark {
+  public:
+   BorderExchangeBenchmark(PV_Init *initObj, int localSize, int nf, int margin);
+   virtual ~BorderExchangeBenchmark();
+
+   virtual void setUp() override;
+   virtual void run() override;
+   virtual void tearDown() override;
+   virtual double getWorkPerRun() const override { return mNumBytes; }
+   virtual char const *getWorkUnit() const override { return "bytes"; }
+
+  private:
+   PV_Init *mInitObj;
+   int mLocalSize;
+   int mNumFeatures;
+   int mMargin;
+   BorderExchange *mBorderExchange = nullptr;
+   std::vector<float> mData;
+   std::vector<MPI_Request> mRequests;
+   double mNumBytes = 0.0;
+};
+
+} // namespace PV
+
+#endif // BORDEREXCHANGEBENCHMARK_HPP_
@@ -0,0 +1,53 @@
+#include "ConvolveDeliveryBenchmark.hpp"
+#include "layers/HyPerLayer.hpp"
+
+namespace PV {
+
+ConvolveDeliveryBenchmark::ConvolveDeliveryBenchmark(
+      PV_Init *initObj,
+      std::string const &workingDirectory,
+      bool postPerspective,
+      int patchSize,
+      double sparsity)
+      : NetworkBenchmark("ConvolveDelivery", initObj, workingDirectory),
+        mPostPerspective(postPerspective),
+        mPatchSize(patchSize),
+        mSparsity(sparsity) {
+   addParameter("perspective", std::string(postPerspective ? "post" : "pre"));
+   addParameter("patch", patchSize);
+   addParameter("sparsity", sparsity);
+}
+
+void ConvolveDeliveryBenchmark::writeGroups(std::ostream &params) {
+   writeLayer(params, "Pre", 1.0, 4, mSparsity > 0.0);
+   writeLayer(params, "Post", 1.0, 8, false);
+   writeHyPerConn(
+         params,
+         "PreToPost",
+         "Pre",
+         "Post",
+         mPatchSize,
+         8,
+         true /*sharedWeights*/,
+         mPostPerspective,
+         false /*plasticityFlag*/);
+}
+
+void ConvolveDeliveryBenchmark::setUpNetwork() {
+   HyPerLayer *pre         = getObject<HyPerLayer>("Pre");
+   HyPerLayer *post        = getObject<HyPerLayer>("Post");
+   mConnection             = getObject<HyPerConn>("PreToPost");
+   long const numNonzero   = fillActivity(pre, mSparsity, 1U);
+   double const patchCount = (double)(mPatchSize * mPatchSize);
+   if (mPostPerspective) {
+      int const nbatch = post->getLayerLoc()->nbatch;
+      mWorkPerRun      = (double)post->getNumNeurons() * nbatch * patchCount * 4.0;
+   }
+   else {
+      mWorkPerRun = (double)numNonzero * patchCount * 8.0;
+   }
+}
+
+void ConvolveDeliveryBenchmark::run() { mConnection->deliver(); }
+
+} // namespace PV
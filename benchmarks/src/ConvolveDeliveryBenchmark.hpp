@@ -0,0 +1,47 @@
+#ifndef CONVOLVEDELIVERYBENCHMARK_HPP_
+#define CONVOLVEDELIVERYBENCHMARK_HPP_
+
+#include "NetworkBenchmark.hpp"
+#include "connections/HyPerConn.hpp"
+
+namespace PV {
+
+/**
+ * Times the delivery of a HyPerConn with the convolve accumulate type, from either the
+ * presynaptic or the postsynaptic perspective. The presynaptic layer is 4 features and the
+ * postsynaptic layer 8 features, both at the column's size. The sparsity is the fraction of
+ * presynaptic neurons that are zero; the presynaptic layer is a sparse layer when the sparsity is
+ * positive, so that the presynaptic perspective loops over the active indices.
+ *
+ * The work unit is the synapse: the number of nonzero presynaptic neurons times the patch size for
+ * the presynaptic perspective, and the number of postsynaptic neurons times the postsynaptic patch
+ * size for the postsynaptic perspective.
+ */
+class ConvolveDeliveryBenchmark : public NetworkBenchmark {
+  public:
+   ConvolveDeliveryBenchmark(
+         PV_Init *initObj,
+         std::string const &workingDirectory,
+         bool postPerspective,
+         int patchSize,
+         double sparsity);
+
+   virtual void run() override;
+   virtual double getWorkPerRun() const override { return mWorkPerRun; }
+   virtual char const *getWorkUnit() const override { return "synapses"; }
+
+  protected:
+   virtual void writeGroups(std::ostream &params) override;
+   virtual void setUpNetwork() override;
+
+  private:
+   bool mPostPerspective;
+   int mPatchSize;
+   double mSparsity;
+   HyPerConn *mConnection = nullptr;
+   double mWorkPerRun     = 0.0;
+};
+
+} // namespace PV
+
+#endif // CONVOLVEDELIVERYBENCHMARK_HPP_
@@ -0,0 +1,52 @@
+#include "HebbianUpdateBenchmark.hpp"
+#include "columns/Messages.hpp"
+#include "layers/HyPerLayer.hpp"
+#include <memory>
+
+namespace PV {
+
+HebbianUpdateBenchmark::HebbianUpdateBenchmark(
+      PV_Init *initObj,
+      std::string const &workingDirectory,
+      int patchSize,
+      bool sharedWeights)
+      : NetworkBenchmark("HebbianUpdate", initObj, workingDirectory),
+        mPatchSize(patchSize),
+        mSharedWeights(sharedWeights) {
+   addParameter("patch", patchSize);
+   addParameter("shared", std::string(sharedWeights ? "true" : "false"));
+}
+
+void HebbianUpdateBenchmark::writeGroups(std::ostream &params) {
+   writeLayer(params, "Pre", 1.0, 4, false);
+   writeLayer(params, "Post", 1.0, 8, false);
+   writeHyPerConn(
+         params,
+         "PreToPost",
+         "Pre",
+         "Post",
+         mPatchSize,
+         8,
+         mSharedWeights,
+         false /*postPerspective*/,
+         true /*plasticityFlag*/);
+}
+
+void HebbianUpdateBenchmark::setUpNetwork() {
+   HyPerLayer *pre  = getObject<HyPerLayer>("Pre");
+   HyPerLayer *post = getObject<HyPerLayer>("Post");
+   mConnection      = getObject<HyPerConn>("PreToPost");
+   fillActivity(pre, 0.0, 1U);
+   fillActivity(post, 0.0, 2U);
+   mSimTime = 0.0;
+
+   int const nbatch = pre->getLayerLoc()->nbatch;
+   mWorkPerRun      = (double)pre->getNumNeurons() * nbatch * mPatchSize * mPatchSize * 8.0;
+}
+
+void HebbianUpdateBenchmark::run() {
+   mSimTime += 1.0;
+   mConnection->respond(std::make_shared<ConnectionUpdateMessage>(mSimTime, 1.0));
+}
+
+} // namespace PV
@@ -0,0 +1,44 @@
+#ifndef HEBBIANUPDATEBENCHMARK_HPP_
+#define HEBBIANUPDATEBENCHMARK_HPP_
+
+#include "NetworkBenchmark.hpp"
+#include "connections/HyPerConn.hpp"
+
+namespace PV {
+
+/**
+ * Times the Hebbian weight update of a plastic HyPerConn from a 4-feature layer to an 8-feature
+ * layer, both at the column's size: computing dW, reducing it across processes and batch
+ * elements for shared weights, and adding it to the weights. Each call to run() advances the
+ * time by one timestep and sends a ConnectionUpdateMessage, so that every call does an update.
+ *
+ * The work unit is the synapse update: the number of presynaptic neurons times the patch size,
+ * for each batch element.
+ */
+class HebbianUpdateBenchmark : public NetworkBenchmark {
+  public:
+   HebbianUpdateBenchmark(
+         PV_Init *initObj,
+         std::string const &workingDirectory,
+         int patchSize,
+         bool sharedWeights);
+
+   virtual void run() override;
+   virtual double getWorkPerRun() const override { return mWorkPerRun; }
+   virtual char const *getWorkUnit() const override { return "synapses"; }
+
+  protected:
+   virtual void writeGroups(std::ostream &params) override;
+   virtual void setUpNetwork() override;
+
+  private:
+   int mPatchSize;
+   bool mSharedWeights;
+   HyPerConn *mConnection = nullptr;
+   double mSimTime        = 0.0;
+   double mWorkPerRun     = 0.0;
+};
+
+} // namespace PV
+
+#endif // HEBBIANUPDATEBENCHMARK_HPP_
@@ -0,0 +1,88 @@
+#include "ImageBenchmark.hpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace PV {
+
+ImageBenchmark::ImageBenchmark(
+      std::string const &workingDirectory,
+      int globalRank,
+      int width,
+      int height)
+      : Benchmark("ImageDecode"), mRescaleMode(false), mWidth(width), mHeight(height) {
+   addParameter("width", width);
+   addParameter("height", height);
+   mPath = workingDirectory + "/ImageDecode_" + std::to_string(globalRank) + ".png";
+}
+
+ImageBenchmark::ImageBenchmark(
+      std::string const &workingDirectory,
+      int globalRank,
+      int width,
+      int height,
+      int newWidth,
+      int newHeight,
+      BufferUtils::RescaleMethod rescaleMethod,
+      BufferUtils::InterpolationMethod interpolationMethod)
+      : Benchmark("ImageRescale"),
+        mRescaleMode(true),
+        mWidth(width),
+        mHeight(height),
+        mNewWidth(newWidth),
+        mNewHeight(newHeight),
+        mRescaleMethod(rescaleMethod),
+        mInterpolationMethod(interpolationMethod) {
+   addParameter("width", width);
+   addParameter("height", height);
+   addParameter("newWidth", newWidth);
+   addParameter("newHeight", newHeight);
+   addParameter("method", std::string(rescaleMethod == BufferUtils::CROP ? "crop" : "pad"));
+   addParameter(
+         "interpolation",
+         std::string(interpolationMethod == BufferUtils::BICUBIC ? "bicubic" : "nearest"));
+   mPath = workingDirectory + "/ImageRescale_" + std::to_string(globalRank) + ".png";
+}
+
+void ImageBenchmark::setUp() {
+   // Random pixels make the PNG incompressible, which is the slow case for the decoder.
+   int const numChannels = 3;
+   std::vector<float> data(mWidth * mHeight * numChannels);
+   std::mt19937 generator(1U);
+   std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+   for (auto &d : data) {
+      d = uniform(generator);
+   }
+   Image source(data, mWidth, mHeight, numChannels);
+   source.write(mPath);
+   if (mRescaleMode) {
+      mDecoded = Image(mPath);
+   }
+}
+
+void ImageBenchmark::run() {
+   if (mRescaleMode) {
+      Buffer<float> rescaled(mDecoded);
+      BufferUtils::rescale(
+            rescaled,
+            mNewWidth,
+            mNewHeight,
+            mRescaleMethod,
+            mInterpolationMethod,
+            Buffer<float>::CENTER);
+   }
+   else {
+      Image decoded(mPath);
+   }
+}
+
+void ImageBenchmark::tearDown() {
+   std::remove(mPath.c_str());
+   mDecoded = Buffer<float>();
+}
+
+double ImageBenchmark::getWorkPerRun() const {
+   return mRescaleMode ? (double)mNewWidth * mNewHeight : (double)mWidth * mHeight;
+}
+
+} // namespace PV
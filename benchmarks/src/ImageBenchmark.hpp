@@ -0,0 +1,57 @@
+#ifndef IMAGEBENCHMARK_HPP_
+#define IMAGEBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include "structures/Image.hpp"
+#include "utils/BufferUtilsRescale.hpp"
+#include <string>
+
+namespace PV {
+
+/**
+ * Times the two steps an ImageLayer takes to bring an image file into a layer: decoding a PNG
+ * file into an Image, and rescaling the decoded image to the layer's size with
+ * BufferUtils::rescale(). The source image is a random RGB image of the given size, written to the
+ * working directory in setUp(). In rescale mode, each run copies the decoded image before
+ * rescaling it, since rescale() works in place; the copy is a small part of the time.
+ *
+ * The work unit is the pixel: the source pixels for decoding, and the rescaled pixels for
+ * rescaling.
+ */
+class ImageBenchmark : public Benchmark {
+  public:
+   /** Decoding case */
+   ImageBenchmark(std::string const &workingDirectory, int globalRank, int width, int height);
+
+   /** Rescaling case */
+   ImageBenchmark(
+         std::string const &workingDirectory,
+         int globalRank,
+         int width,
+         int height,
+         int newWidth,
+         int newHeight,
+         BufferUtils::RescaleMethod rescaleMethod,
+         BufferUtils::InterpolationMethod interpolationMethod);
+
+   virtual void setUp() override;
+   virtual void run() override;
+   virtual void tearDown() override;
+   virtual double getWorkPerRun() const override;
+   virtual char const *getWorkUnit() const override { return "pixels"; }
+
+  private:
+   std::string mPath;
+   bool mRescaleMode;
+   int mWidth;
+   int mHeight;
+   int mNewWidth                                         = 0;
+   int mNewHeight                                        = 0;
+   BufferUtils::RescaleMethod mRescaleMethod             = BufferUtils::CROP;
+   BufferUtils::InterpolationMethod mInterpolationMethod = BufferUtils::NEAREST;
+   Buffer<float> mDecoded;
+};
+
+} // namespace PV
+
+#endif // IMAGEBENCHMARK_HPP_
@@ -0,0 +1,118 @@
+#include "LCAUpdateBenchmark.hpp"
+#include "layers/updateStateFunctions.h"
+#include <cstring>
+#include <random>
+
+namespace PV {
+
+namespace {
+
+int const margin = 2;
+
+} // namespace
+
+LCAUpdateBenchmark::LCAUpdateBenchmark(int n, int nf, bool fused)
+      : Benchmark("LCAUpdate"), mN(n), mNf(nf), mFused(fused) {
+   addParameter("n", n);
+   addParameter("nf", nf);
+   addParameter("fused", fused ? 1 : 0);
+}
+
+LCAUpdateBenchmark::~LCAUpdateBenchmark() {
+   delete mFusedUpdate;
+   delete mDataStore;
+}
+
+void LCAUpdateBenchmark::setUp() {
+   mLoc.nbatch       = 1;
+   mLoc.nx           = mN;
+   mLoc.ny           = mN;
+   mLoc.nf           = mNf;
+   mLoc.nbatchGlobal = 1;
+   mLoc.nxGlobal     = mN;
+   mLoc.nyGlobal     = mN;
+   mLoc.kb0          = 0;
+   mLoc.kx0          = 0;
+   mLoc.ky0          = 0;
+   mLoc.halo.lt      = margin;
+   mLoc.halo.rt      = margin;
+   mLoc.halo.dn      = margin;
+   mLoc.halo.up      = margin;
+
+   mVerticesV  = {0.9f};
+   mVerticesA  = {0.0f};
+   mSlopes     = {0.0f, 1.0f};
+   mDeltaTimes = {1.0};
+
+   int const numNeurons  = mN * mN * mNf;
+   int const numExtended = (mN + 2 * margin) * (mN + 2 * margin) * mNf;
+   mGSyn.resize(numNeurons);
+   mV.resize(numNeurons);
+   mA.assign(numExtended, 0.0f);
+   std::mt19937 generator(1U);
+   std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+   for (int k = 0; k < numNeurons; k++) {
+      mGSyn[k] = 0.1f * uniform(generator);
+      mV[k]    = uniform(generator);
+   }
+   mFusedUpdate = new FusedLCAUpdate(&mLoc, 1 /*numChannels*/, true /*emitActiveIndices*/);
+   mDataStore   = new DataStore(1 /*numBuffers*/, numExtended, 1 /*numLevels*/, true /*sparse*/);
+}
+
+void LCAUpdateBenchmark::run() {
+   float const tau = 100.0f;
+   if (mFused) {
+      PtwiseLinearTransfer transfer(1, mVerticesV.data(), mVerticesA.data(), mSlopes.data());
+      mFusedUpdate->updateLCA(
+            mGSyn.data(),
+            mV.data(),
+            mA.data(),
+            mDeltaTimes.data(),
+            tau,
+            true /*selfInteract*/,
+            transfer);
+   }
+   else {
+      updateV_HyPerLCALayer(
+            1 /*nbatch*/,
+            mN * mN * mNf,
+            1 /*numChannels*/,
+            mV.data(),
+            mGSyn.data(),
+            mA.data(),
+            1 /*numVertices*/,
+            mVerticesV.data(),
+            mVerticesA.data(),
+            mSlopes.data(),
+            mDeltaTimes.data(),
+            tau,
+            1.0f /*selfInteract*/,
+            mN,
+            mN,
+            mNf,
+            margin,
+            margin,
+            margin,
+            margin);
+   }
+   std::memcpy(mDataStore->buffer(0, 0), mA.data(), sizeof(float) * mA.size());
+   if (mFused) {
+      mDataStore->updateActiveIndices(
+            0, 0, mLoc, mFusedUpdate->getRowEntries(), mFusedUpdate->getRowCounts());
+   }
+   else {
+      mDataStore->updateActiveIndices(0, 0);
+   }
+}
+
+void LCAUpdateBenchmark::tearDown() {
+   delete mFusedUpdate;
+   mFusedUpdate = nullptr;
+   delete mDataStore;
+   mDataStore = nullptr;
+   mGSyn.clear();
+   mV.clear();
+   mA.clear();
+}
+
+} // namespace PV
@@ -0,0 +1,50 @@
+#ifndef LCAUPDATEBENCHMARK_HPP_
+#define LCAUPDATEBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include "columns/DataStore.hpp"
+#include "layers/FusedLCAUpdate.hpp"
+#include <vector>
+
+namespace PV {
+
+/**
+ * Times one update of a sparse HyPerLCALayer on an n-by-n layer with nf features and a margin of
+ * 2: the update of V and A, the copy of A into a data store as Publisher::publish() does, and the
+ * building of the data store's active indices. If fused is true, the update is that of
+ * FusedLCAUpdate, and the active indices are built from its lists of nonzero activities; if not,
+ * the update is updateV_HyPerLCALayer() followed by a scan of the whole buffer. The transfer
+ * function is a soft threshold that leaves about a tenth of the neurons active.
+ *
+ * The work unit is the neuron.
+ */
+class LCAUpdateBenchmark : public Benchmark {
+  public:
+   LCAUpdateBenchmark(int n, int nf, bool fused);
+   virtual ~LCAUpdateBenchmark();
+
+   virtual void setUp() override;
+   virtual void run() override;
+   virtual void tearDown() override;
+   virtual double getWorkPerRun() const override { return (double)mN * mN * mNf; }
+   virtual char const *getWorkUnit() const override { return "neurons"; }
+
+  private:
+   int mN;
+   int mNf;
+   bool mFused;
+   PVLayerLoc mLoc;
+   std::vector<float> mVerticesV;
+   std::vector<float> mVerticesA;
+   std::vector<float> mSlopes;
+   std::vector<double> mDeltaTimes;
+   std::vector<float> mGSyn;
+   std::vector<float> mV;
+   std::vector<float> mA;
+   FusedLCAUpdate *mFusedUpdate = nullptr;
+   DataStore *mDataStore        = nullptr;
+};
+
+} // namespace PV
+
+#endif // LCAUPDATEBENCHMARK_HPP_
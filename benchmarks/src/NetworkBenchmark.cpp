@@ -0,0 +1,166 @@
+#include "NetworkBenchmark.hpp"
+#include "columns/Publisher.hpp"
+#include "include/PVLayerLoc.h"
+#include "layers/HyPerLayer.hpp"
+#include "utils/conversions.h"
+#include <fstream>
+#include <random>
+
+namespace PV {
+
+NetworkBenchmark::NetworkBenchmark(
+      std::string const &name,
+      PV_Init *initObj,
+      std::string const &workingDirectory)
+      : Benchmark(name), mInitObj(initObj), mWorkingDirectory(workingDirectory) {}
+
+NetworkBenchmark::~NetworkBenchmark() { delete mHyPerCol; }
+
+void NetworkBenchmark::setColumnSize(int nx, int ny, int nbatch) {
+   mNx     = nx;
+   mNy     = ny;
+   mNBatch = nbatch;
+}
+
+void NetworkBenchmark::setUp() {
+   std::string caseName = getDescription();
+   for (auto &c : caseName) {
+      if (c == '/' or c == '[' or c == ']' or c == ',' or c == '=') {
+         c = '_';
+      }
+   }
+   std::string const outputPath = mWorkingDirectory + "/" + caseName;
+   std::string const paramsPath = mWorkingDirectory + "/" + caseName + ".params";
+   if (mInitObj->getWorldRank() == 0) {
+      std::ofstream params(paramsPath);
+      FatalIf(!params.good(), "Unable to write \"%s\".\n", paramsPath.c_str());
+      params << "debugParsing = false;\n\n";
+      params << "HyPerCol \"column\" = {\n";
+      params << "   dt                          = 1;\n";
+      params << "   stopTime                    = 1;\n";
+      params << "   progressInterval            = 1;\n";
+      params << "   writeProgressToErr          = false;\n";
+      params << "   verifyWrites                = false;\n";
+      params << "   outputPath                  = \"" << outputPath << "\";\n";
+      params << "   printParamsFilename         = \"pv.params\";\n";
+      params << "   randomSeed                  = 1234567890;\n";
+      params << "   nx                          = " << mNx << ";\n";
+      params << "   ny                          = " << mNy << ";\n";
+      params << "   nbatch                      = " << mNBatch << ";\n";
+      params << "   initializeFromCheckpointDir = \"\";\n";
+      params << "   checkpointWrite             = false;\n";
+      params << "   lastCheckpointDir           = \"" << outputPath << "/Last\";\n";
+      params << "   errorOnNotANumber           = false;\n";
+      params << "};\n\n";
+      writeGroups(params);
+   }
+   MPI_Barrier(mInitObj->getCommunicator()->globalCommunicator());
+   mInitObj->setParams(paramsPath.c_str());
+   mHyPerCol = new HyPerCol(mInitObj);
+   mHyPerCol->allocateColumn();
+   setUpNetwork();
+}
+
+void NetworkBenchmark::tearDown() {
+   delete mHyPerCol;
+   mHyPerCol = nullptr;
+}
+
+void NetworkBenchmark::writeLayer(
+      std::ostream &params,
+      char const *name,
+      double scale,
+      int nf,
+      bool sparseLayer) {
+   params << "ANNLayer \"" << name << "\" = {\n";
+   params << "   nxScale          = " << scale << ";\n";
+   params << "   nyScale          = " << scale << ";\n";
+   params << "   nf               = " << nf << ";\n";
+   params << "   phase            = 0;\n";
+   params << "   writeStep        = -1;\n";
+   params << "   mirrorBCflag     = false;\n";
+   params << "   valueBC          = 0.0;\n";
+   params << "   sparseLayer      = " << (sparseLayer ? "true" : "false") << ";\n";
+   params << "   triggerLayerName = NULL;\n";
+   params << "   InitVType        = \"ZeroV\";\n";
+   params << "   VThresh          = -infinity;\n";
+   params << "   AMax             = infinity;\n";
+   params << "   AMin             = -infinity;\n";
+   params << "   AShift           = 0.0;\n";
+   params << "   VWidth           = 0.0;\n";
+   params << "};\n\n";
+}
+
+void NetworkBenchmark::writeHyPerConn(
+      std::ostream &params,
+      char const *name,
+      char const *preLayerName,
+      char const *postLayerName,
+      int patchSize,
+      int nfp,
+      bool sharedWeights,
+      bool postPerspective,
+      bool plasticityFlag) {
+   params << "HyPerConn \"" << name << "\" = {\n";
+   params << "   preLayerName                  = \"" << preLayerName << "\";\n";
+   params << "   postLayerName                 = \"" << postLayerName << "\";\n";
+   params << "   channelCode                   = 0;\n";
+   params << "   sharedWeights                 = " << (sharedWeights ? "true" : "false") << ";\n";
+   params << "   nxp                           = " << patchSize << ";\n";
+   params << "   nyp                           = " << patchSize << ";\n";
+   params << "   nfp                           = " << nfp << ";\n";
+   params << "   numAxonalArbors               = 1;\n";
+   params << "   delay                         = 0;\n";
+   params << "   updateGSynFromPostPerspective = " << (postPerspective ? "true" : "false")
+          << ";\n";
+   params << "   pvpatchAccumulateType         = \"convolve\";\n";
+   params << "   convertRateToSpikeCount       = false;\n";
+   params << "   receiveGpu                    = false;\n";
+   params << "   writeStep                     = -1;\n";
+   params << "   writeCompressedCheckpoints    = false;\n";
+   params << "   weightInitType                = \"UniformRandomWeight\";\n";
+   params << "   wMinInit                      = -1.0;\n";
+   params << "   wMaxInit                      = 1.0;\n";
+   params << "   sparseFraction                = 0.0;\n";
+   params << "   normalizeMethod               = \"none\";\n";
+   params << "   plasticityFlag                = " << (plasticityFlag ? "true" : "false") << ";\n";
+   if (plasticityFlag) {
+      params << "   triggerLayerName              = NULL;\n";
+      params << "   weightUpdatePeriod            = 1.0;\n";
+      params << "   initialWeightUpdateTime       = 1.0;\n";
+      params << "   immediateWeightUpdate         = true;\n";
+      params << "   combine_dW_with_W_flag        = false;\n";
+      params << "   dWMax                         = 1.0e-6;\n";
+      params << "   normalizeDw                   = true;\n";
+   }
+   params << "};\n\n";
+}
+
+long NetworkBenchmark::fillActivity(HyPerLayer *layer, double sparsity, unsigned int seed) {
+   PVLayerLoc const *loc = layer->getLayerLoc();
+   PVHalo const &halo    = loc->halo;
+   int const numNeurons  = layer->getNumNeurons();
+   int const numExtended = layer->getNumExtended();
+   float *activity       = layer->getActivity();
+
+   std::mt19937 generator(seed);
+   std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+   long numNonzero = 0L;
+   for (int b = 0; b < loc->nbatch; b++) {
+      float *activityBatch = activity + b * numExtended;
+      for (int k = 0; k < numNeurons; k++) {
+         int const kExt =
+               kIndexExtended(k, loc->nx, loc->ny, loc->nf, halo.lt, halo.rt, halo.dn, halo.up);
+         bool const active   = uniform(generator) >= (float)sparsity;
+         activityBatch[kExt] = active ? 1.0f - uniform(generator) : 0.0f;
+         numNonzero += active ? 1L : 0L;
+      }
+   }
+   Publisher *publisher = layer->getPublisher();
+   publisher->publish(0.0);
+   publisher->wait();
+   publisher->updateAllActiveIndices();
+   return numNonzero;
+}
+
+} // namespace PV
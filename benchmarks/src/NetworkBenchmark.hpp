@@ -0,0 +1,94 @@
+#ifndef NETWORKBENCHMARK_HPP_
+#define NETWORKBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include "columns/HyPerCol.hpp"
+#include "columns/PV_Init.hpp"
+#include "utils/PVLog.hpp"
+#include <ostream>
+#include <string>
+
+namespace PV {
+
+class HyPerLayer;
+
+/**
+ * A base class for benchmarks of operations that need a HyPerCol: layers and connections that
+ * are allocated the same way as in a run. setUp() writes a params file with the HyPerCol group
+ * and the groups written by the derived class's writeGroups(), builds the HyPerCol from it,
+ * allocates it, and then calls setUpNetwork(), where the derived class looks up the objects it
+ * times. tearDown() deletes the HyPerCol.
+ */
+class NetworkBenchmark : public Benchmark {
+  public:
+   /**
+    * The params file and the HyPerCol's output are written to a directory named after the case,
+    * inside workingDirectory.
+    */
+   NetworkBenchmark(std::string const &name, PV_Init *initObj, std::string const &workingDirectory);
+   virtual ~NetworkBenchmark();
+
+   virtual void setUp() override;
+   virtual void tearDown() override;
+
+  protected:
+   /** Writes the layer, connection and other groups of the network, after the HyPerCol group. */
+   virtual void writeGroups(std::ostream &params) = 0;
+
+   /** Called after the HyPerCol is allocated. */
+   virtual void setUpNetwork() {}
+
+   void setColumnSize(int nx, int ny, int nbatch);
+
+   HyPerCol *getHyPerCol() { return mHyPerCol; }
+
+   template <typename T>
+   T *getObject(char const *objectName) {
+      T *object = dynamic_cast<T *>(mHyPerCol->getObjectFromName(std::string(objectName)));
+      FatalIf(object == nullptr, "%s has no object \"%s\".\n", getName().c_str(), objectName);
+      return object;
+   }
+
+   /**
+    * Writes an ANNLayer group with the identity transfer function. The layer's activity is
+    * filled by fillActivity() rather than by updates.
+    */
+   static void
+   writeLayer(std::ostream &params, char const *name, double scale, int nf, bool sparseLayer);
+
+   /**
+    * Writes a HyPerConn group with one arbor, no delay, uniformly random weights, and no
+    * normalization. If the plasticity flag is set, the weights are updated immediately, every
+    * timestep, by the Hebbian rule.
+    */
+   static void writeHyPerConn(
+         std::ostream &params,
+         char const *name,
+         char const *preLayerName,
+         char const *postLayerName,
+         int patchSize,
+         int nfp,
+         bool sharedWeights,
+         bool postPerspective,
+         bool plasticityFlag);
+
+   /**
+    * Fills the restricted activity of each batch element of the layer with values uniform in
+    * (0, 1], each neuron being zero with probability equal to the sparsity, publishes the
+    * activity, and computes the active indices. Returns the number of nonzero values on this
+    * process, over all batch elements.
+    */
+   static long fillActivity(HyPerLayer *layer, double sparsity, unsigned int seed);
+
+  private:
+   PV_Init *mInitObj = nullptr;
+   std::string mWorkingDirectory;
+   HyPerCol *mHyPerCol = nullptr;
+   int mNx             = 64;
+   int mNy             = 64;
+   int mNBatch         = 1;
+};
+
+} // namespace PV
+
+#endif // NETWORKBENCHMARK_HPP_
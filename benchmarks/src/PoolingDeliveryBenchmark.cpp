@@ -0,0 +1,51 @@
+#include "PoolingDeliveryBenchmark.hpp"
+#include "layers/HyPerLayer.hpp"
+
+namespace PV {
+
+PoolingDeliveryBenchmark::PoolingDeliveryBenchmark(
+      PV_Init *initObj,
+      std::string const &workingDirectory,
+      std::string const &poolingType,
+      bool postPerspective,
+      double sparsity)
+      : NetworkBenchmark("PoolingDelivery", initObj, workingDirectory),
+        mPoolingType(poolingType),
+        mPostPerspective(postPerspective),
+        mSparsity(sparsity) {
+   addParameter("type", poolingType);
+   addParameter("perspective", std::string(postPerspective ? "post" : "pre"));
+   addParameter("sparsity", sparsity);
+}
+
+void PoolingDeliveryBenchmark::writeGroups(std::ostream &params) {
+   writeLayer(params, "Pre", 1.0, 8, mSparsity > 0.0);
+   writeLayer(params, "Post", 0.5, 8, false);
+   params << "PoolingConn \"PreToPost\" = {\n";
+   params << "   preLayerName                  = \"Pre\";\n";
+   params << "   postLayerName                 = \"Post\";\n";
+   params << "   channelCode                   = 0;\n";
+   params << "   nxp                           = 1;\n";
+   params << "   nyp                           = 1;\n";
+   params << "   nfp                           = 8;\n";
+   params << "   numAxonalArbors               = 1;\n";
+   params << "   delay                         = 0;\n";
+   params << "   updateGSynFromPostPerspective = " << (mPostPerspective ? "true" : "false")
+          << ";\n";
+   params << "   pvpatchAccumulateType         = \"" << mPoolingType << "\";\n";
+   params << "   convertRateToSpikeCount       = false;\n";
+   params << "   receiveGpu                    = false;\n";
+   params << "   needPostIndexLayer            = false;\n";
+   params << "};\n\n";
+}
+
+void PoolingDeliveryBenchmark::setUpNetwork() {
+   HyPerLayer *pre = getObject<HyPerLayer>("Pre");
+   mConnection     = getObject<PoolingConn>("PreToPost");
+   fillActivity(pre, mSparsity, 1U);
+   mWorkPerRun = (double)pre->getNumNeurons() * pre->getLayerLoc()->nbatch;
+}
+
+void PoolingDeliveryBenchmark::run() { mConnection->deliver(); }
+
+} // namespace PV
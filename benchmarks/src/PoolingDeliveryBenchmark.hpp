@@ -0,0 +1,44 @@
+#ifndef POOLINGDELIVERYBENCHMARK_HPP_
+#define POOLINGDELIVERYBENCHMARK_HPP_
+
+#include "NetworkBenchmark.hpp"
+#include "connections/PoolingConn.hpp"
+
+namespace PV {
+
+/**
+ * Times the delivery of a PoolingConn from an 8-feature layer at the column's size to an
+ * 8-feature layer at half the column's size, from either the presynaptic or the postsynaptic
+ * perspective. The pooling type is the pvpatchAccumulateType, "maxpooling" or "sumpooling".
+ *
+ * The work unit is the presynaptic neuron, since every presynaptic neuron contributes to the
+ * pooled values once whichever perspective is used.
+ */
+class PoolingDeliveryBenchmark : public NetworkBenchmark {
+  public:
+   PoolingDeliveryBenchmark(
+         PV_Init *initObj,
+         std::string const &workingDirectory,
+         std::string const &poolingType,
+         bool postPerspective,
+         double sparsity);
+
+   virtual void run() override;
+   virtual double getWorkPerRun() const override { return mWorkPerRun; }
+   virtual char const *getWorkUnit() const override { return "neurons"; }
+
+  protected:
+   virtual void writeGroups(std::ostream &params) override;
+   virtual void setUpNetwork() override;
+
+  private:
+   std::string mPoolingType;
+   bool mPostPerspective;
+   double mSparsity;
+   PoolingConn *mConnection = nullptr;
+   double mWorkPerRun       = 0.0;
+};
+
+} // namespace PV
+
+#endif // POOLINGDELIVERYBENCHMARK_HPP_
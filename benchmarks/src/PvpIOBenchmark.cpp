@@ -0,0 +1,55 @@
+#include "PvpIOBenchmark.hpp"
+#include "utils/BufferUtilsPvp.hpp"
+#include <cstdio>
+#include <random>
+
+namespace PV {
+
+PvpIOBenchmark::PvpIOBenchmark(
+      std::string const &workingDirectory,
+      int globalRank,
+      bool readMode,
+      int size,
+      int nf)
+      : Benchmark("PvpIO"), mReadMode(readMode), mSize(size), mNumFeatures(nf) {
+   addParameter("mode", std::string(readMode ? "read" : "write"));
+   addParameter("n", size);
+   addParameter("nf", nf);
+   mPath = workingDirectory + "/PvpIO_" + std::to_string(globalRank) + ".pvp";
+}
+
+void PvpIOBenchmark::setUp() {
+   mBuffer = Buffer<float>(mSize, mSize, mNumFeatures);
+   std::mt19937 generator(1U);
+   std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+   for (int y = 0; y < mSize; y++) {
+      for (int x = 0; x < mSize; x++) {
+         for (int f = 0; f < mNumFeatures; f++) {
+            mBuffer.set(x, y, f, uniform(generator));
+         }
+      }
+   }
+   if (mReadMode) {
+      BufferUtils::writeToPvp<float>(mPath.c_str(), &mBuffer, 0.0);
+   }
+}
+
+void PvpIOBenchmark::run() {
+   if (mReadMode) {
+      BufferUtils::readDenseFromPvp<float>(mPath.c_str(), &mBuffer, 0);
+   }
+   else {
+      BufferUtils::writeToPvp<float>(mPath.c_str(), &mBuffer, 0.0);
+   }
+}
+
+void PvpIOBenchmark::tearDown() {
+   std::remove(mPath.c_str());
+   mBuffer = Buffer<float>();
+}
+
+double PvpIOBenchmark::getWorkPerRun() const {
+   return (double)mSize * mSize * mNumFeatures * sizeof(float);
+}
+
+} // namespace PV
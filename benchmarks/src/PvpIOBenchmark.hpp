@@ -0,0 +1,43 @@
+#ifndef PVPIOBENCHMARK_HPP_
+#define PVPIOBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include "structures/Buffer.hpp"
+#include <string>
+
+namespace PV {
+
+/**
+ * Times writing a dense frame to a pvp file with BufferUtils::writeToPvp(), or reading it back
+ * with BufferUtils::readDenseFromPvp(). Each process writes and reads its own file in the working
+ * directory, so that the case measures the file system's bandwidth when every process does I/O
+ * at once.
+ *
+ * The work unit is the byte of activity data written or read.
+ */
+class PvpIOBenchmark : public Benchmark {
+  public:
+   PvpIOBenchmark(
+         std::string const &workingDirectory,
+         int globalRank,
+         bool readMode,
+         int size,
+         int nf);
+
+   virtual void setUp() override;
+   virtual void run() override;
+   virtual void tearDown() override;
+   virtual double getWorkPerRun() const override;
+   virtual char const *getWorkUnit() const override { return "bytes"; }
+
+  private:
+   std::string mPath;
+   bool mReadMode;
+   int mSize;
+   int mNumFeatures;
+   Buffer<float> mBuffer;
+};
+
+} // namespace PV
+
+#endif // PVPIOBENCHMARK_HPP_
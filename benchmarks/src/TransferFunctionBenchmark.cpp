@@ -0,0 +1,79 @@
+#include "TransferFunctionBenchmark.hpp"
+#include "layers/updateStateFunctions.h"
+#include <random>
+
+namespace PV {
+
+namespace {
+
+int const margin = 2;
+
+} // namespace
+
+TransferFunctionBenchmark::TransferFunctionBenchmark(int n, int nf, int numVertices)
+      : Benchmark("TransferFunction"), mN(n), mNf(nf), mNumVertices(numVertices) {
+   addParameter("n", n);
+   addParameter("nf", nf);
+   addParameter("vertices", numVertices);
+}
+
+void TransferFunctionBenchmark::setUp() {
+   mVerticesV.resize(mNumVertices);
+   mVerticesA.resize(mNumVertices);
+   mSlopes.resize(mNumVertices + 1);
+   if (mNumVertices == 1) {
+      mVerticesV[0] = 0.0f;
+      mVerticesA[0] = -0.1f;
+      mSlopes[0]    = 1.0f;
+      mSlopes[1]    = 1.0f;
+   }
+   else {
+      for (int k = 0; k < mNumVertices; k++) {
+         mVerticesV[k] = 0.1f * (float)k;
+         mVerticesA[k] = 0.05f * (float)k;
+      }
+      mSlopes[0] = 0.0f;
+      for (int k = 1; k < mNumVertices; k++) {
+         mSlopes[k] = 0.5f;
+      }
+      mSlopes[mNumVertices] = 1.0f;
+   }
+
+   int const numNeurons  = mN * mN * mNf;
+   int const numExtended = (mN + 2 * margin) * (mN + 2 * margin) * mNf;
+   float const lowest    = mVerticesV.front() - 0.5f;
+   float const highest   = mVerticesV.back() + 0.5f;
+   mV.resize(numNeurons);
+   mA.assign(numExtended, 0.0f);
+   std::mt19937 generator(1U);
+   std::uniform_real_distribution<float> uniform(lowest, highest);
+   for (auto &v : mV) {
+      v = uniform(generator);
+   }
+}
+
+void TransferFunctionBenchmark::run() {
+   setActivity_PtwiseLinearTransferLayer(
+         1 /*nbatch*/,
+         mN * mN * mNf,
+         mA.data(),
+         mV.data(),
+         mN,
+         mN,
+         mNf,
+         margin,
+         margin,
+         margin,
+         margin,
+         mNumVertices,
+         mVerticesV.data(),
+         mVerticesA.data(),
+         mSlopes.data());
+}
+
+void TransferFunctionBenchmark::tearDown() {
+   mV.clear();
+   mA.clear();
+}
+
+} // namespace PV
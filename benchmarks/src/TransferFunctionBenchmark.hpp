@@ -0,0 +1,41 @@
+#ifndef TRANSFERFUNCTIONBENCHMARK_HPP_
+#define TRANSFERFUNCTIONBENCHMARK_HPP_
+
+#include "Benchmark.hpp"
+#include <vector>
+
+namespace PV {
+
+/**
+ * Times setActivity_PtwiseLinearTransferLayer(), which sets an ANNLayer's activity from its
+ * membrane potential, on an n-by-n layer with nf features and a margin of 2. With one vertex, the
+ * transfer function is linear; with more, it is zero below the first vertex, rises with slope one
+ * half through the vertices, and has slope one above the last vertex, like a soft threshold. The
+ * potentials are uniformly distributed over the vertices and a little beyond them.
+ *
+ * The work unit is the neuron.
+ */
+class TransferFunctionBenchmark : public Benchmark {
+  public:
+   TransferFunctionBenchmark(int n, int nf, int numVertices);
+
+   virtual void setUp() override;
+   virtual void run() override;
+   virtual void tearDown() override;
+   virtual double getWorkPerRun() const override { return (double)mN * mN * mNf; }
+   virtual char const *getWorkUnit() const override { return "neurons"; }
+
+  private:
+   int mN;
+   int mNf;
+   int mNumVertices;
+   std::vector<float> mVerticesV;
+   std::vector<float> mVerticesA;
+   std::vector<float> mSlopes;
+   std::vector<float> mV;
+   std::vector<float> mA;
+};
+
+} // namespace PV
+
+#endif // TRANSFERFUNCTIONBENCHMARK_HPP_
@@ -0,0 +1,61 @@
+#include "TransposeWeightsBenchmark.hpp"
+#include "components/WeightsPair.hpp"
+#include "connections/HyPerConn.hpp"
+#include "utils/TransposeWeights.hpp"
+
+namespace PV {
+
+TransposeWeightsBenchmark::TransposeWeightsBenchmark(
+      PV_Init *initObj,
+      std::string const &workingDirectory,
+      int patchSize,
+      bool sharedWeights)
+      : NetworkBenchmark("TransposeWeights", initObj, workingDirectory),
+        mPatchSize(patchSize),
+        mSharedWeights(sharedWeights) {
+   addParameter("patch", patchSize);
+   addParameter("shared", std::string(sharedWeights ? "true" : "false"));
+}
+
+void TransposeWeightsBenchmark::writeGroups(std::ostream &params) {
+   writeLayer(params, "Pre", 1.0, 4, false);
+   writeLayer(params, "Post", 1.0, 8, false);
+   writeHyPerConn(
+         params,
+         "PreToPost",
+         "Pre",
+         "Post",
+         mPatchSize,
+         8,
+         mSharedWeights,
+         false /*postPerspective*/,
+         false /*plasticityFlag*/);
+   params << "TransposeConn \"PostToPre\" = {\n";
+   params << "   preLayerName                  = \"Post\";\n";
+   params << "   postLayerName                 = \"Pre\";\n";
+   params << "   originalConnName              = \"PreToPost\";\n";
+   params << "   channelCode                   = 0;\n";
+   params << "   delay                         = 0;\n";
+   params << "   updateGSynFromPostPerspective = false;\n";
+   params << "   pvpatchAccumulateType         = \"convolve\";\n";
+   params << "   convertRateToSpikeCount       = false;\n";
+   params << "   receiveGpu                    = false;\n";
+   params << "   writeStep                     = -1;\n";
+   params << "};\n\n";
+}
+
+void TransposeWeightsBenchmark::setUpNetwork() {
+   auto *connection  = getObject<HyPerConn>("PreToPost");
+   auto *weightsPair = connection->getComponentByType<WeightsPair>();
+   FatalIf(weightsPair == nullptr, "%s has no WeightsPair.\n", connection->getDescription_c());
+   mPreWeights  = weightsPair->getPreWeights();
+   mPostWeights = weightsPair->getPostWeights();
+   FatalIf(mPostWeights == nullptr, "%s has no postsynaptic weights.\n", getName().c_str());
+   mWorkPerRun = (double)mPreWeights->getNumDataPatches() * mPreWeights->getPatchSizeOverall();
+}
+
+void TransposeWeightsBenchmark::run() {
+   TransposeWeights::transpose(mPreWeights, mPostWeights, getHyPerCol()->getCommunicator());
+}
+
+} // namespace PV
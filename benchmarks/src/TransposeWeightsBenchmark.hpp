@@ -0,0 +1,44 @@
+#ifndef TRANSPOSEWEIGHTSBENCHMARK_HPP_
+#define TRANSPOSEWEIGHTSBENCHMARK_HPP_
+
+#include "NetworkBenchmark.hpp"
+#include "components/Weights.hpp"
+
+namespace PV {
+
+/**
+ * Times TransposeWeights::transpose(), which computes the postsynaptic-perspective weights of a
+ * connection from its presynaptic-perspective weights. The connection goes from a 4-feature layer
+ * to an 8-feature layer, both at the column's size; a TransposeConn of it is in the network so
+ * that its postsynaptic weights are allocated. For nonshared weights, the transpose exchanges
+ * the weights in the border region with the neighboring processes.
+ *
+ * The work unit is the weight: the number of presynaptic weight values of one arbor.
+ */
+class TransposeWeightsBenchmark : public NetworkBenchmark {
+  public:
+   TransposeWeightsBenchmark(
+         PV_Init *initObj,
+         std::string const &workingDirectory,
+         int patchSize,
+         bool sharedWeights);
+
+   virtual void run() override;
+   virtual double getWorkPerRun() const override { return mWorkPerRun; }
+   virtual char const *getWorkUnit() const override { return "weights"; }
+
+  protected:
+   virtual void writeGroups(std::ostream &params) override;
+   virtual void setUpNetwork() override;
+
+  private:
+   int mPatchSize;
+   bool mSharedWeights;
+   Weights *mPreWeights  = nullptr;
+   Weights *mPostWeights = nullptr;
+   double mWorkPerRun    = 0.0;
+};
+
+} // namespace PV
+
+#endif // TRANSPOSEWEIGHTSBENCHMARK_HPP_
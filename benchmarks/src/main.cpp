@@ -0,0 +1,142 @@
+/*
+ * main.cpp for pvbenchmarks
+ *
+ * Runs the micro-benchmark suite and writes the timings to a JSON file.
+ *
+ * Options:
+ *   --list                   Print the names of the cases and exit.
+ *   --filter <string>        Run only the cases whose name contains the string.
+ *   --samples <n>            Number of timed samples per case (default 20).
+ *   --warmups <n>            Number of untimed runs before the samples (default 2).
+ *   --min-sample-time <sec>  Minimum duration of a sample (default 0.01).
+ *   --json <path>            Path of the results file (default benchmarks.json).
+ *   --workdir <path>         Directory for params, pvp and image files (default
+ *                            benchmarks_output).
+ *
+ * The usual PetaVision options are also recognized: -t for the number of threads, which is
+ * required when built with OpenMP, and -rows, -columns and -batchwidth for the MPI arrangement.
+ */
+
+#include "ActiveIndicesBenchmark.hpp"
+#include "BenchmarkRunner.hpp"
+#include "BorderExchangeBenchmark.hpp"
+#include "ConvolveDeliveryBenchmark.hpp"
+#include "HebbianUpdateBenchmark.hpp"
+#include "ImageBenchmark.hpp"
+#include "LCAUpdateBenchmark.hpp"
+#include "PoolingDeliveryBenchmark.hpp"
+#include "PvpIOBenchmark.hpp"
+#include "TransferFunctionBenchmark.hpp"
+#include "TransposeWeightsBenchmark.hpp"
+#include "columns/PV_Init.hpp"
+#include "io/fileio.hpp"
+#include "io/io.hpp"
+#include "pvGitRevision.h"
+#include <cstdlib>
+#include <string>
+
+using namespace PV;
+
+std::string getStringOption(int argc, char **argv, char const *option, char const *defaultValue) {
+   char *value = nullptr;
+   pv_getopt_str(argc, argv, option, &value, nullptr);
+   std::string result(value ? value : defaultValue);
+   free(value);
+   return result;
+}
+
+void addBenchmarks(BenchmarkRunner &runner, PV_Init &initObj, std::string const &workdir) {
+   int const rank = initObj.getWorldRank();
+
+   int const patchSizes[] = {3, 7, 11};
+   for (int patchSize : patchSizes) {
+      double const sparsities[] = {0.0, 0.9, 0.99};
+      for (double sparsity : sparsities) {
+         runner.addBenchmark(
+               new ConvolveDeliveryBenchmark(&initObj, workdir, false, patchSize, sparsity));
+      }
+      runner.addBenchmark(new ConvolveDeliveryBenchmark(&initObj, workdir, true, patchSize, 0.0));
+   }
+
+   char const *poolingTypes[] = {"maxpooling", "sumpooling"};
+   for (char const *poolingType : poolingTypes) {
+      runner.addBenchmark(new PoolingDeliveryBenchmark(&initObj, workdir, poolingType, false, 0.0));
+      runner.addBenchmark(new PoolingDeliveryBenchmark(&initObj, workdir, poolingType, false, 0.9));
+      runner.addBenchmark(new PoolingDeliveryBenchmark(&initObj, workdir, poolingType, true, 0.0));
+   }
+
+   int const plasticPatchSizes[] = {3, 7};
+   for (int patchSize : plasticPatchSizes) {
+      runner.addBenchmark(new HebbianUpdateBenchmark(&initObj, workdir, patchSize, true));
+      runner.addBenchmark(new HebbianUpdateBenchmark(&initObj, workdir, patchSize, false));
+      runner.addBenchmark(new TransposeWeightsBenchmark(&initObj, workdir, patchSize, true));
+      runner.addBenchmark(new TransposeWeightsBenchmark(&initObj, workdir, patchSize, false));
+   }
+
+   double const activeSparsities[] = {0.5, 0.9, 0.99};
+   for (double sparsity : activeSparsities) {
+      runner.addBenchmark(new ActiveIndicesBenchmark(1 << 20, sparsity));
+   }
+
+   int const transferVertices[] = {1, 2, 3, 16, 64};
+   for (int numVertices : transferVertices) {
+      runner.addBenchmark(new TransferFunctionBenchmark(256, 8, numVertices));
+   }
+
+   runner.addBenchmark(new LCAUpdateBenchmark(256, 8, false /*fused*/));
+   runner.addBenchmark(new LCAUpdateBenchmark(256, 8, true /*fused*/));
+
+   int const exchangeFeatures[] = {1, 8, 32};
+   for (int nf : exchangeFeatures) {
+      runner.addBenchmark(new BorderExchangeBenchmark(&initObj, 64, nf, 1));
+      runner.addBenchmark(new BorderExchangeBenchmark(&initObj, 64, nf, 4));
+   }
+
+   runner.addBenchmark(new PvpIOBenchmark(workdir, rank, false /*readMode*/, 256, 8));
+   runner.addBenchmark(new PvpIOBenchmark(workdir, rank, true /*readMode*/, 256, 8));
+
+   runner.addBenchmark(new ImageBenchmark(workdir, rank, 640, 480));
+   runner.addBenchmark(new ImageBenchmark(
+         workdir, rank, 640, 480, 224, 224, BufferUtils::CROP, BufferUtils::NEAREST));
+   runner.addBenchmark(new ImageBenchmark(
+         workdir, rank, 640, 480, 224, 224, BufferUtils::CROP, BufferUtils::BICUBIC));
+   runner.addBenchmark(new ImageBenchmark(
+         workdir, rank, 640, 480, 224, 224, BufferUtils::PAD, BufferUtils::BICUBIC));
+   runner.addBenchmark(new ImageBenchmark(
+         workdir, rank, 1920, 1080, 512, 512, BufferUtils::CROP, BufferUtils::BICUBIC));
+}
+
+int main(int argc, char *argv[]) {
+   PV_Init initObj(&argc, &argv, true /*allowUnrecognizedArguments*/);
+
+   std::string const workdir  = getStringOption(argc, argv, "--workdir", "benchmarks_output");
+   std::string const jsonPath = getStringOption(argc, argv, "--json", "benchmarks.json");
+   std::string const filter   = getStringOption(argc, argv, "--filter", "");
+   int numSamples             = 20;
+   int numWarmups             = 2;
+   pv_getopt_int(argc, argv, "--samples", &numSamples, nullptr);
+   pv_getopt_int(argc, argv, "--warmups", &numWarmups, nullptr);
+   std::string const minSampleTime = getStringOption(argc, argv, "--min-sample-time", "0.01");
+
+   BenchmarkRunner runner(MPI_COMM_WORLD);
+   runner.setNumSamples(numSamples);
+   runner.setNumWarmups(numWarmups);
+   runner.setMinSampleTime(std::atof(minSampleTime.c_str()));
+   addBenchmarks(runner, initObj, workdir);
+
+   if (pv_getopt(argc, argv, "--list", nullptr) == 0) {
+      if (initObj.getWorldRank() == 0) {
+         runner.list();
+      }
+      return EXIT_SUCCESS;
+   }
+
+   ensureDirExists(initObj.getCommunicator()->getGlobalMPIBlock(), workdir.c_str());
+   int const numRun = runner.run(filter);
+   FatalIf(numRun == 0, "No benchmark matches the filter \"%s\".\n", filter.c_str());
+   runner.writeJSON(jsonPath, PV_GIT_REVISION);
+   if (initObj.getWorldRank() == 0) {
+      InfoLog() << "Ran " << numRun << " benchmarks; results written to " << jsonPath << "\n";
+   }
+   return EXIT_SUCCESS;
+}
@@ -246,6 +246,10 @@ macro(pv_config_project)
     find_package(MPI)
   endif()
 
+  # The asynchronous probe writer uses std::thread.
+  find_package(Threads REQUIRED)
+  set(PV_LIBRARIES ${PV_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+
   if (PV_USE_LUA)
     find_package(Lua)
     if (LUA_FOUND)
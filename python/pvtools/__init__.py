@@ -1,6 +1,7 @@
 """ This file causes this directory to be seen as an importable python module."""
 from .readpvpfile import readpvpfile
 from .readpvpheader import readpvpheader
+from .readprobefile import readprobefile, readprobeheader
 from .writepvpfile import writepvpfile
 #from .pv_object import PV_Object
 from .display import view
@@ -0,0 +1,155 @@
+"""Reads the files written by probes whose probeOutputFormat parameter is "binary".
+
+The format is described in src/io/ProbeBinaryFile.hpp. An uncompressed file is memory-mapped,
+so that opening it costs nothing and columns are read from disk only as they are used.
+A compressed file is decompressed block by block into memory. The blocks are in the LZ4 block
+format, and are decoded with the lz4 package. If the lz4 package cannot be imported, they are
+decoded instead by a pure-Python decoder, which is much slower.
+"""
+import re
+import numpy as np
+try:
+    import lz4.block as lz4block
+except ImportError:
+    lz4block = None
+
+headerPattern = [('magic', 'S4'),
+                 ('version', np.uint32),
+                 ('headersize', np.uint32),
+                 ('numcolumns', np.uint32),
+                 ('recordsize', np.uint32),
+                 ('compressed', np.uint32),
+                 ('recordsperblock', np.uint32),
+                 ('schemasize', np.uint32)]
+
+# Constants of the lossless compressor in src/utils/BufferUtilsCompress.cpp
+losslessBlockSize = 1 << 16
+storedFlag = 1 << 31
+minMatch = 4
+run255 = re.compile(b'\xff*')
+
+def readprobeheader(filename):
+    """Returns the header of a binary probe file as a dictionary. The 'name' entry holds the
+    name of the probe and the 'columns' entry holds the list of column names."""
+    with open(filename, 'rb') as f:
+        header = np.fromfile(f, np.dtype(headerPattern), 1)
+        if len(header) != 1 or header['magic'][0] != b'PVPB':
+            raise ValueError('"%s" is not a binary probe file' % filename)
+        header = dict(zip(header.dtype.names, header[0]))
+        schema = f.read(int(header['schemasize'])).decode('utf-8').split('\n')[:-1]
+    header['name'] = schema[0]
+    header['columns'] = schema[1:]
+    return header
+
+def probedtype(header):
+    """Returns the numpy dtype of the records of the file with the given header."""
+    return np.dtype([('time', np.float64), ('batch', np.int32), ('padding', np.int32)] +
+                    [(c, np.float64) for c in header['columns']])
+
+def readprobefile(filename):
+    """Returns a pair (header, records). The header is the dictionary returned by
+    readprobeheader. The records are a numpy structured array with fields 'time', 'batch',
+    and one field for each column; for example, records['time'] and records['Avg'] are
+    one-dimensional arrays with one element per record."""
+    header = readprobeheader(filename)
+    dtype = probedtype(header)
+    headerSize = int(header['headersize'])
+    if not header['compressed']:
+        if _filesize(filename) == headerSize:
+            return header, np.zeros(0, dtype)
+        return header, np.memmap(filename, dtype, mode='r', offset=headerSize)
+
+    blocks = []
+    with open(filename, 'rb') as f:
+        f.seek(headerSize)
+        while True:
+            lengthBytes = f.read(8)
+            if len(lengthBytes) < 8:
+                break
+            length = int(np.frombuffer(lengthBytes, np.uint64)[0])
+            chunk = f.read(length)
+            if len(chunk) < length:
+                raise ValueError('"%s" is truncated' % filename)
+            blocks.append(_decompresslossless(chunk))
+    data = b''.join(blocks)
+    return header, np.frombuffer(data, dtype)
+
+def _filesize(filename):
+    with open(filename, 'rb') as f:
+        f.seek(0, 2)
+        return f.tell()
+
+def _decompresslossless(chunk):
+    """Decompresses a chunk created by BufferUtils::compressLossless."""
+    size, elementSize, numBlocks = np.frombuffer(chunk, np.dtype(
+            [('size', np.uint64), ('elementsize', np.uint32), ('numblocks', np.uint32)]), 1)[0]
+    size, elementSize, numBlocks = int(size), int(elementSize), int(numBlocks)
+    records = np.frombuffer(chunk, np.uint32, numBlocks, 16)
+    pos = 16 + 4 * numBlocks
+    out = bytearray()
+    for b in range(numBlocks):
+        blockSize = min(losslessBlockSize, size - b * losslessBlockSize)
+        payloadSize = int(records[b]) & ~storedFlag
+        payload = chunk[pos:pos + payloadSize]
+        pos += payloadSize
+        if int(records[b]) & storedFlag:
+            out += payload
+        else:
+            shuffled = _decompressblock(payload, blockSize)
+            out += _unshuffle(shuffled, elementSize)
+    if len(out) != size:
+        raise ValueError('compressed chunk is corrupt')
+    return bytes(out)
+
+def _readcount(data, i, count):
+    """Reads a count that continues through bytes of 255 and ends at a byte less than 255,
+    starting at data[i]. A run of 255s is scanned in one call instead of a byte at a time."""
+    if data[i] != 255:
+        return i + 1, count + data[i]
+    stop = run255.match(data, i).end()
+    return stop + 1, count + 255 * (stop - i) + data[stop]
+
+def _decompressblock(data, outSize):
+    if lz4block is None:
+        return _decompressblockpython(data, outSize)
+    out = lz4block.decompress(data, uncompressed_size=outSize)
+    if len(out) != outSize:
+        raise ValueError('compressed block is corrupt')
+    return out
+
+def _decompressblockpython(data, outSize):
+    """Decodes a block without the lz4 package."""
+    out = bytearray()
+    i = 0
+    end = len(data)
+    while i < end:
+        token = data[i]
+        i += 1
+        numLiterals = token >> 4
+        if numLiterals == 15:
+            i, numLiterals = _readcount(data, i, numLiterals)
+        out += data[i:i + numLiterals]
+        i += numLiterals
+        if i == end:
+            break # The last sequence has no match.
+        offset = data[i] | (data[i + 1] << 8)
+        i += 2
+        matchLength = token & 0x0f
+        if matchLength == 15:
+            i, matchLength = _readcount(data, i, matchLength)
+        matchLength += minMatch
+        start = len(out) - offset
+        if offset >= matchLength:
+            out += out[start:start + matchLength]
+        else:
+            # The match overlaps the bytes it produces, so it repeats with period offset.
+            pattern = out[start:]
+            out += (pattern * (matchLength // offset + 1))[:matchLength]
+    if len(out) != outSize:
+        raise ValueError('compressed block is corrupt')
+    return out
+
+def _unshuffle(shuffled, width):
+    numElements = len(shuffled) // width
+    body = np.frombuffer(shuffled, np.uint8, numElements * width)
+    return body.reshape(width, numElements).T.tobytes() + bytes(shuffled[numElements * width:])
@@ -0,0 +1,142 @@
+#include "EmbeddedColumn.hpp"
+#include "connections/HyPerConn.hpp"
+#include "layers/ImageFromMemoryBuffer.hpp"
+#include "probes/BaseProbe.hpp"
+#include "utils/PVLog.hpp"
+
+namespace PV {
+
+EmbeddedColumn::EmbeddedColumn(PV_Init *initObj, std::string const &paramsString) {
+   FatalIf(initObj == nullptr, "EmbeddedColumn requires a PV_Init object.\n");
+   int status = initObj->setParamsString(paramsString);
+   FatalIf(status != PV_SUCCESS, "EmbeddedColumn: unable to create params from the string.\n");
+   mHyPerCol = new HyPerCol(initObj);
+}
+
+EmbeddedColumn::~EmbeddedColumn() {
+   if (!mFinished and mAllocated) {
+      finish();
+   }
+   delete mHyPerCol;
+}
+
+int EmbeddedColumn::advance(int numSteps) {
+   if (mFinished) {
+      ErrorLog() << "EmbeddedColumn: " << mHyPerCol->getDescription()
+                 << " cannot be advanced after finish() has been called.\n";
+      return PV_FAILURE;
+   }
+   mHyPerCol->advanceSteps(numSteps);
+   mAllocated = true;
+   return PV_SUCCESS;
+}
+
+void EmbeddedColumn::finish() {
+   if (mFinished) {
+      return;
+   }
+   mHyPerCol->allocateColumn();
+   mHyPerCol->finishRun();
+   mAllocated = true;
+   mFinished  = true;
+}
+
+template <typename T>
+int EmbeddedColumn::setInput(
+      std::string const &layerName,
+      T const *data,
+      int height,
+      int width,
+      int numBands,
+      T zeroValue,
+      T oneValue) {
+   auto *layer = dynamic_cast<ImageFromMemoryBuffer *>(mHyPerCol->getObjectFromName(layerName));
+   if (layer == nullptr) {
+      ErrorLog().printf(
+            "EmbeddedColumn: there is no ImageFromMemoryBuffer layer \"%s\".\n",
+            layerName.c_str());
+      return PV_FAILURE;
+   }
+   return layer->setMemoryBuffer(
+         data,
+         height,
+         width,
+         numBands,
+         numBands /*xstride*/,
+         width * numBands /*ystride*/,
+         1 /*bandstride*/,
+         zeroValue,
+         oneValue);
+}
+
+template int EmbeddedColumn::setInput<float>(
+      std::string const &layerName,
+      float const *data,
+      int height,
+      int width,
+      int numBands,
+      float zeroValue,
+      float oneValue);
+template int EmbeddedColumn::setInput<uint8_t>(
+      std::string const &layerName,
+      uint8_t const *data,
+      int height,
+      int width,
+      int numBands,
+      uint8_t zeroValue,
+      uint8_t oneValue);
+
+EmbeddedColumn::View EmbeddedColumn::getActivity(std::string const &layerName) {
+   View view;
+   auto *layer = dynamic_cast<HyPerLayer *>(mHyPerCol->getObjectFromName(layerName));
+   if (layer == nullptr or !mAllocated) {
+      return view;
+   }
+   PVLayerLoc const *loc = layer->getLayerLoc();
+   view.data             = layer->getActivity();
+   view.shape[0]         = loc->nbatch;
+   view.shape[1]         = loc->ny + loc->halo.dn + loc->halo.up;
+   view.shape[2]         = loc->nx + loc->halo.lt + loc->halo.rt;
+   view.shape[3]         = loc->nf;
+   return view;
+}
+
+EmbeddedColumn::View EmbeddedColumn::getV(std::string const &layerName) {
+   View view;
+   auto *layer = dynamic_cast<HyPerLayer *>(mHyPerCol->getObjectFromName(layerName));
+   if (layer == nullptr or !mAllocated or layer->getV() == nullptr) {
+      return view;
+   }
+   PVLayerLoc const *loc = layer->getLayerLoc();
+   view.data             = layer->getV();
+   view.shape[0]         = loc->nbatch;
+   view.shape[1]         = loc->ny;
+   view.shape[2]         = loc->nx;
+   view.shape[3]         = loc->nf;
+   return view;
+}
+
+EmbeddedColumn::View EmbeddedColumn::getWeights(std::string const &connName, int arbor) {
+   View view;
+   auto *conn = dynamic_cast<HyPerConn *>(mHyPerCol->getObjectFromName(connName));
+   if (conn == nullptr or !mAllocated or arbor < 0 or arbor >= conn->getNumAxonalArbors()) {
+      return view;
+   }
+   view.data     = conn->getWeightsDataStart(arbor);
+   view.shape[0] = conn->getNumDataPatches();
+   view.shape[1] = conn->getPatchSizeY();
+   view.shape[2] = conn->getPatchSizeX();
+   view.shape[3] = conn->getPatchSizeF();
+   return view;
+}
+
+int EmbeddedColumn::getProbeValues(std::string const &probeName, std::vector<double> *values) {
+   auto *probe = dynamic_cast<BaseProbe *>(mHyPerCol->getObjectFromName(probeName));
+   if (probe == nullptr or !mAllocated or mHyPerCol->simulationTime() <= 0.0) {
+      return PV_FAILURE;
+   }
+   probe->getValues(mHyPerCol->simulationTime(), values);
+   return PV_SUCCESS;
+}
+
+} // namespace PV
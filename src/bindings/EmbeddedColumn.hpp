@@ -0,0 +1,110 @@
+#ifndef EMBEDDEDCOLUMN_HPP_
+#define EMBEDDEDCOLUMN_HPP_
+
+#include "columns/HyPerCol.hpp"
+#include "columns/PV_Init.hpp"
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * A HyPerCol driven by another program, a few timesteps at a time, instead of by run(). The
+ * program builds the column from a params string, pushes input frames into ImageFromMemoryBuffer
+ * layers, advances the column, and reads the activity and membrane potential of layers, the
+ * weights of connections and the values of probes, without the column ever reaching its
+ * stopTime. A server can keep a column resident and run it once per request.
+ *
+ * The buffers are returned as views of the column's own memory: they are not copied, they
+ * change as the column advances, and they are valid until the EmbeddedColumn is deleted.
+ *
+ * Under MPI, every process must make the same calls in the same order, since advancing the
+ * column and computing probe values communicate. Each process's views are of its own part of
+ * the layers.
+ */
+class EmbeddedColumn {
+  public:
+   /**
+    * A view of a buffer of the column, in row-major order with the last index varying fastest.
+    * The data pointer is null if there was no buffer of the requested name and kind.
+    */
+   struct View {
+      float *data  = nullptr;
+      int shape[4] = {0, 0, 0, 0};
+   };
+
+   /**
+    * Builds the column from paramsString, using the arguments (the number of threads, the output
+    * path, the random seed, etc.) of initObj. The params of initObj are replaced. The
+    * column is allocated when it is first advanced. The initObj must outlive the EmbeddedColumn,
+    * and can be used to build another column after this one has been deleted.
+    */
+   EmbeddedColumn(PV_Init *initObj, std::string const &paramsString);
+
+   /** Calls finish() if it has not been called, and deletes the column. */
+   ~EmbeddedColumn();
+
+   /**
+    * Advances the column numSteps timesteps, allocating it first if necessary; advance(0) only
+    * allocates it. Returns PV_FAILURE, without advancing, if finish() has been called.
+    */
+   int advance(int numSteps);
+
+   /**
+    * Sends the column's Cleanup message and writes its final checkpoint, as the end of
+    * HyPerCol::run() does. The column cannot be advanced afterward; its buffers can still be read.
+    */
+   void finish();
+
+   /**
+    * Sets the image of the named ImageFromMemoryBuffer layer, which the layer shows from the next
+    * timestep on. The data has height rows of width pixels of numBands bands, with the band index
+    * varying fastest; zeroValue and oneValue are the pixel values that are converted to 0 and 1.
+    * Only the root process reads the data. Returns PV_FAILURE if there is no such layer.
+    */
+   template <typename T>
+   int setInput(
+         std::string const &layerName,
+         T const *data,
+         int height,
+         int width,
+         int numBands,
+         T zeroValue,
+         T oneValue);
+
+   /**
+    * The activity of the named layer: nbatch by the extended ny by the extended nx by nf. The
+    * views are null until the column has been allocated.
+    */
+   View getActivity(std::string const &layerName);
+
+   /** The membrane potential of the named layer: nbatch by ny by nx by nf. */
+   View getV(std::string const &layerName);
+
+   /**
+    * The weights of the given arbor of the named connection: the number of data patches by nyp by
+    * nxp by nfp. If the weights are shared, there is a data patch per kernel; if not, a data patch
+    * per extended presynaptic neuron.
+    */
+   View getWeights(std::string const &connName, int arbor);
+
+   /**
+    * Sets values to the current values of the named probe, and returns PV_SUCCESS; or returns
+    * PV_FAILURE if there is no such probe or the column has not been advanced a timestep. (Before
+    * the first timestep, layers report an update at time dt, and a probe computed then would not
+    * be recomputed after the first timestep.)
+    */
+   int getProbeValues(std::string const &probeName, std::vector<double> *values);
+
+   HyPerCol *getHyPerCol() { return mHyPerCol; }
+   double getSimulationTime() const { return mHyPerCol->simulationTime(); }
+
+  private:
+   HyPerCol *mHyPerCol = nullptr;
+   bool mAllocated     = false;
+   bool mFinished      = false;
+};
+
+} // namespace PV
+
+#endif // EMBEDDEDCOLUMN_HPP_
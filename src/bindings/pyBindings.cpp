@@ -1,10 +1,89 @@
 #include "../columns/buildandrun.hpp"
+#include "EmbeddedColumn.hpp"
+#include <cstring>
 #include <stddef.h>
 
+namespace {
+
+// Copies the view's pointer and shape to the caller's four-element shape array.
+float *exportView(EmbeddedColumn::View const &view, int *shape) {
+   std::memcpy(shape, view.shape, sizeof(view.shape));
+   return view.data;
+}
+
+} // namespace
+
 extern "C" {
 HyPerCol *pvBuild(int argc, char *argv[]) {
    PV_Init *initObj = new PV_Init(&argc, &argv, false /*allowUnrecognizedArguments*/);
    return build(initObj);
 }
 int pvRun(HyPerCol *hc) { return hc->run(); }
+
+// The embedding interface. pvInitialize() is called once per process: it initializes MPI, which
+// pvFinalize() finalizes. argv must be null-terminated, and must stay valid until pvFinalize().
+PV_Init *pvInitialize(int argc, char *argv[]) {
+   return new PV_Init(&argc, &argv, false /*allowUnrecognizedArguments*/);
+}
+void pvFinalize(PV_Init *initObj) { delete initObj; }
+
+EmbeddedColumn *pvCreateColumn(PV_Init *initObj, char const *params) {
+   return new EmbeddedColumn(initObj, std::string(params));
+}
+void pvDeleteColumn(EmbeddedColumn *column) { delete column; }
+int pvAdvance(EmbeddedColumn *column, int numSteps) { return column->advance(numSteps); }
+void pvFinish(EmbeddedColumn *column) { column->finish(); }
+double pvSimulationTime(EmbeddedColumn *column) { return column->getSimulationTime(); }
+
+int pvSetInputFloat(
+      EmbeddedColumn *column,
+      char const *layerName,
+      float const *data,
+      int height,
+      int width,
+      int numBands,
+      float zeroValue,
+      float oneValue) {
+   return column->setInput(
+         std::string(layerName), data, height, width, numBands, zeroValue, oneValue);
+}
+int pvSetInputUint8(
+      EmbeddedColumn *column,
+      char const *layerName,
+      uint8_t const *data,
+      int height,
+      int width,
+      int numBands,
+      uint8_t zeroValue,
+      uint8_t oneValue) {
+   return column->setInput(
+         std::string(layerName), data, height, width, numBands, zeroValue, oneValue);
+}
+
+// Each of these returns a pointer into the column's memory, and its shape in shape[0..3];
+// or the null pointer if there is no such buffer.
+float *pvGetActivity(EmbeddedColumn *column, char const *layerName, int *shape) {
+   return exportView(column->getActivity(std::string(layerName)), shape);
+}
+float *pvGetV(EmbeddedColumn *column, char const *layerName, int *shape) {
+   return exportView(column->getV(std::string(layerName)), shape);
+}
+float *pvGetWeights(EmbeddedColumn *column, char const *connName, int arbor, int *shape) {
+   return exportView(column->getWeights(std::string(connName), arbor), shape);
+}
+
+// Copies at most capacity values of the probe to values, and returns the number of values the
+// probe has; or returns -1 if there is no such probe.
+int pvGetProbeValues(EmbeddedColumn *column, char const *probeName, double *values, int capacity) {
+   std::vector<double> probeValues;
+   if (column->getProbeValues(std::string(probeName), &probeValues) != PV_SUCCESS) {
+      return -1;
+   }
+   int const numValues = (int)probeValues.size();
+   int const numCopied = numValues < capacity ? numValues : capacity;
+   if (numCopied > 0) {
+      std::memcpy(values, probeValues.data(), sizeof(double) * (std::size_t)numCopied);
+   }
+   return numValues;
+}
 }
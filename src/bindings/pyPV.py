@@ -1,41 +1,231 @@
 from ctypes import *
+import os
+import socket
+import struct
 import sys
 
+import numpy as np
+
+# The PetaVision library must be built as a shared library (PV_BUILD_SHARED). Its location can be
+# set with the PV_LIBRARY environment variable.
+def loadLibrary():
+   if sys.platform == "linux" or sys.platform == "linux2":
+      defaultPath = '../../lib/libpv.so'
+      mpiLibrary = 'libmpi.so'
+   elif sys.platform == "darwin":
+      defaultPath = '../../lib/libpv.dylib'
+      mpiLibrary = 'libmpi.dylib'
+   else:
+      print("Operating system", sys.platform, "not supported")
+      sys.exit()
+   CDLL(mpiLibrary, RTLD_GLOBAL)
+   lib = cdll.LoadLibrary(os.environ.get('PV_LIBRARY', defaultPath))
+
+   lib.pvBuild.restype = c_void_p
+   lib.pvBuild.argtypes = [c_int, POINTER(c_char_p)]
+   lib.pvRun.argtypes = [c_void_p]
+   lib.pvInitialize.restype = c_void_p
+   lib.pvInitialize.argtypes = [c_int, POINTER(c_char_p)]
+   lib.pvFinalize.argtypes = [c_void_p]
+   lib.pvCreateColumn.restype = c_void_p
+   lib.pvCreateColumn.argtypes = [c_void_p, c_char_p]
+   lib.pvDeleteColumn.argtypes = [c_void_p]
+   lib.pvAdvance.argtypes = [c_void_p, c_int]
+   lib.pvFinish.argtypes = [c_void_p]
+   lib.pvSimulationTime.restype = c_double
+   lib.pvSimulationTime.argtypes = [c_void_p]
+   lib.pvSetInputFloat.argtypes = [
+         c_void_p, c_char_p, POINTER(c_float), c_int, c_int, c_int, c_float, c_float]
+   lib.pvSetInputUint8.argtypes = [
+         c_void_p, c_char_p, POINTER(c_uint8), c_int, c_int, c_int, c_uint8, c_uint8]
+   for getter in (lib.pvGetActivity, lib.pvGetV):
+      getter.restype = POINTER(c_float)
+      getter.argtypes = [c_void_p, c_char_p, POINTER(c_int)]
+   lib.pvGetWeights.restype = POINTER(c_float)
+   lib.pvGetWeights.argtypes = [c_void_p, c_char_p, c_int, POINTER(c_int)]
+   lib.pvGetProbeValues.argtypes = [c_void_p, c_char_p, POINTER(c_double), c_int]
+   return lib
+
+def makeArgv(arguments):
+   argv = (c_char_p * (len(arguments) + 1))()
+   for i, argument in enumerate(arguments):
+      argv[i] = argument.encode()
+   #Last element in argv should be NULL
+   argv[len(arguments)] = None
+   return argv
+
 class pyHyPerCol(object):
    #Arguments is a list of parameter strings
    def __init__(self, arguments):
-      #If use linux
-      if sys.platform == "linux" or sys.platform == "linux2":
-         self.lib = cdll.LoadLibrary('../../lib/libpv.so')
-         mpi =  CDLL('libmpi.so', RTLD_GLOBAL)
-      elif sys.platform == "darwin":
-         #If use mac
-         self.lib = cdll.LoadLibrary('../../lib/libpv.dylib')
-         self.lib.pvBuild.restype = POINTER(c_char_p)
-         mpi =  CDLL('libmpi.dylib', RTLD_GLOBAL)
-      elif sys.platform == "win32":
-         print "Windows not supported"
-         sys.exit()
-      else:
-         print "Operating system", sys.platform, "not known"
-         sys.exit()
-      argc = len(arguments)
-      argv = (c_char_p * (argc+1))()
-      for i in range(argc):
-         argv[i] = arguments[i]
-      #Last element in argv should be NULL
-      argv[argc] = None
-
-      self.hc = self.lib.pvBuild(argc, argv)
+      self.lib = loadLibrary()
+      self.argv = makeArgv(arguments)
+      self.hc = self.lib.pvBuild(len(arguments), self.argv)
 
    def run(self):
       return self.lib.pvRun(self.hc)
 
+class pyPVInit(object):
+   """The PetaVision environment of the process. Create one, before any column; it initializes
+   MPI, and finalizes it when it is closed. The arguments are those of the command line, without
+   the params file, e.g. ["pv", "-t", "4", "-o", "output"]."""
+   def __init__(self, arguments):
+      self.lib = loadLibrary()
+      self.argv = makeArgv(arguments)
+      self.initObj = self.lib.pvInitialize(len(arguments), self.argv)
+
+   def close(self):
+      if self.initObj:
+         self.lib.pvFinalize(self.initObj)
+         self.initObj = None
+
+class pyEmbeddedColumn(object):
+   """A column built from a params string and advanced a few steps at a time. The arrays returned
+   by activity(), V() and weights() are views of the column's memory: they change as the column
+   advances, and must not be used after the column is closed."""
+   def __init__(self, pvInit, params):
+      self.lib = pvInit.lib
+      self.column = self.lib.pvCreateColumn(pvInit.initObj, params.encode())
+
+   def advance(self, numSteps=1):
+      if self.lib.pvAdvance(self.column, numSteps) != 0:
+         raise RuntimeError("the column cannot be advanced after it has been finished")
+
+   def time(self):
+      return self.lib.pvSimulationTime(self.column)
+
+   # Sets the image of an ImageFromMemoryBuffer layer from an array of shape (height, width) or
+   # (height, width, bands), of type float32 or uint8. zeroValue and oneValue are the pixel
+   # values converted to 0 and 1; by default 0 and 1 for float32 and 0 and 255 for uint8.
+   def setInput(self, layerName, image, zeroValue=None, oneValue=None):
+      if image.dtype == np.uint8:
+         image = np.ascontiguousarray(image)
+         setter = self.lib.pvSetInputUint8
+         pointer = image.ctypes.data_as(POINTER(c_uint8))
+         defaults = (0, 255)
+      else:
+         image = np.ascontiguousarray(image, dtype=np.float32)
+         setter = self.lib.pvSetInputFloat
+         pointer = image.ctypes.data_as(POINTER(c_float))
+         defaults = (0.0, 1.0)
+      zeroValue = defaults[0] if zeroValue is None else zeroValue
+      oneValue = defaults[1] if oneValue is None else oneValue
+      bands = image.shape[2] if image.ndim == 3 else 1
+      status = setter(self.column, layerName.encode(), pointer,
+                      image.shape[0], image.shape[1], bands, zeroValue, oneValue)
+      if status != 0:
+         raise KeyError("no ImageFromMemoryBuffer layer " + layerName)
+
+   def view(self, pointer, shape, name):
+      if not pointer:
+         raise KeyError("no buffer for " + name + " (is the column allocated?)")
+      return np.ctypeslib.as_array(pointer, shape=tuple(shape))
+
+   # The activity of a layer, of shape (nbatch, extended ny, extended nx, nf).
+   def activity(self, layerName):
+      shape = (c_int * 4)()
+      return self.view(self.lib.pvGetActivity(self.column, layerName.encode(), shape), shape,
+                       layerName)
+
+   # The membrane potential of a layer, of shape (nbatch, ny, nx, nf).
+   def V(self, layerName):
+      shape = (c_int * 4)()
+      return self.view(self.lib.pvGetV(self.column, layerName.encode(), shape), shape, layerName)
+
+   # The weights of an arbor of a connection, of shape (number of data patches, nyp, nxp, nfp).
+   def weights(self, connName, arbor=0):
+      shape = (c_int * 4)()
+      return self.view(self.lib.pvGetWeights(self.column, connName.encode(), arbor, shape),
+                       shape, connName)
+
+   # The current values of a probe, copied to a new array.
+   def probeValues(self, probeName):
+      numValues = self.lib.pvGetProbeValues(self.column, probeName.encode(), None, 0)
+      if numValues < 0:
+         raise KeyError("no probe " + probeName)
+      values = np.zeros(numValues, dtype=np.float64)
+      self.lib.pvGetProbeValues(self.column, probeName.encode(),
+                                values.ctypes.data_as(POINTER(c_double)), numValues)
+      return values
+
+   # Writes the final checkpoint. The column can still be read, but not advanced.
+   def finish(self):
+      self.lib.pvFinish(self.column)
+
+   def close(self):
+      if self.column:
+         self.lib.pvDeleteColumn(self.column)
+         self.column = None
+
+class pyInferenceClient(object):
+   """A client of a column run with --serve (see InferenceServer and InferenceProtocol). It talks
+   to the server over its socket, and does not need the PetaVision library. Frames are arrays of
+   shape (height, width) or (height, width, bands), of type float32 (0 and 1 are converted to 0
+   and 1) or uint8 (0 and 255 are converted to 0 and 1)."""
+   headerFormat = '=Iiii'
+   codeFormat = '=iiiid'
+   statsFormat = '=qqddddd'
+   statsFields = ('numRequests', 'numBatches', 'meanLatency', 'latency50', 'latency90',
+                  'latency99', 'maxLatency')
+
+   def __init__(self, socketPath):
+      self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+      self.sock.connect(socketPath)
+
+   def receiveAll(self, size):
+      data = bytearray()
+      while len(data) < size:
+         chunk = self.sock.recv(size - len(data))
+         if not chunk:
+            raise ConnectionError("the server closed the connection")
+         data.extend(chunk)
+      return bytes(data)
+
+   def encode(self, image):
+      if image.dtype == np.uint8:
+         requestType = 2
+      else:
+         requestType = 1
+         image = image.astype(np.float32)
+      bands = image.shape[2] if image.ndim == 3 else 1
+      header = struct.pack(self.headerFormat, requestType, image.shape[0], image.shape[1], bands)
+      return header + np.ascontiguousarray(image).tobytes()
+
+   # Sends the frames together, so that the server can process them in one batch, and returns
+   # their codes in order. Each code is a tuple (indices, values, numNeurons), where indices are
+   # the global restricted indices of the nonzero activities of the output layer.
+   def infer(self, *images):
+      self.sock.sendall(b''.join(self.encode(image) for image in images))
+      codes = []
+      for image in images:
+         status, numActive, numNeurons, batchSize, simTime = struct.unpack(
+               self.codeFormat, self.receiveAll(struct.calcsize(self.codeFormat)))
+         if status != 0:
+            raise ValueError("the server rejected the frame")
+         indices = np.frombuffer(self.receiveAll(4 * numActive), dtype=np.int32)
+         values = np.frombuffer(self.receiveAll(4 * numActive), dtype=np.float32)
+         codes.append((indices, values, numNeurons))
+      return codes
+
+   def requestStats(self, requestType):
+      self.sock.sendall(struct.pack(self.headerFormat, requestType, 0, 0, 0))
+      values = struct.unpack(
+            self.statsFormat, self.receiveAll(struct.calcsize(self.statsFormat)))
+      return dict(zip(self.statsFields, values))
+
+   # The server's request count, batch count and latencies in milliseconds, as a dict.
+   def stats(self):
+      return self.requestStats(3)
+
+   # Asks the server to stop, and returns its final stats.
+   def shutdown(self):
+      return self.requestStats(4)
+
+   def close(self):
+      self.sock.close()
+
 
-#Test scripti
+#Test script
 if __name__ == "__main__":
-   #c_argc = 4
-   #c_argv = (c_char_p * (c_argc+1))("pv", "-p", "input/BasicSystemTest.params", "-t", None)
    args = ["pv", "-p", "input/BasicSystemTest.params", "-t"]
    pvObj = pyHyPerCol(args)
    pvObj.run()
@@ -36,6 +36,16 @@ class CheckpointEntry {
    virtual void remove(std::string const &checkpointDirectory) const { return; }
    std::string const &getName() const { return mName; }
 
+   /**
+    * If set, entries that write pvp files compress their float data without loss
+    * (see BufferUtils::compressLossless). Entries that do not support compression ignore it.
+    * Reading does not depend on the flag; compressed files are recognized from their headers.
+    */
+   void setLosslessCompression(bool losslessCompression) {
+      mLosslessCompression = losslessCompression;
+   }
+   bool getLosslessCompression() const { return mLosslessCompression; }
+
   protected:
    std::string
    generatePath(std::string const &checkpointDirectory, std::string const &extension) const;
@@ -46,6 +56,7 @@ class CheckpointEntry {
   private:
    std::string mName;
    MPIBlock const *mMPIBlock;
+   bool mLosslessCompression = false;
 };
 
 } // end namespace PV
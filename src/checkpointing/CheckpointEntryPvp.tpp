@@ -61,12 +61,18 @@ void CheckpointEntryPvp<T>::write(
    int const nxBlock   = mLayerLoc->nx * getMPIBlock()->getNumColumns();
    int const nyBlock   = mLayerLoc->ny * getMPIBlock()->getNumRows();
 
+   // Only float data has a compressed pvp data type.
+   bool const lossless =
+         getLosslessCompression() and BufferUtils::returnDataType<T>() == BufferUtils::FLOAT;
    FileStream *fileStream = nullptr;
    if (getMPIBlock()->getRank() == 0) {
       std::string path = generatePath(checkpointDirectory, "pvp");
       fileStream       = new FileStream(path.c_str(), std::ios_base::out, verifyWritesFlag);
       BufferUtils::ActivityHeader header =
             BufferUtils::buildActivityHeader<T>(nxBlock, nyBlock, mLayerLoc->nf, numFrames);
+      if (lossless) {
+         header.dataType = BufferUtils::LOSSLESS_FLOAT;
+      }
       BufferUtils::writeActivityHeader(*fileStream, header);
    }
    int const nxExtLocal = mLayerLoc->nx + mXMargins;
@@ -90,7 +96,12 @@ void CheckpointEntryPvp<T>::write(
          pvAssert(fileStream);
          pvAssert(globalPvpBuffer.getWidth() == nxBlock);
          pvAssert(globalPvpBuffer.getHeight() == nyBlock);
-         BufferUtils::writeFrame(*fileStream, &globalPvpBuffer, simTime);
+         if (lossless) {
+            BufferUtils::writeLosslessFrame(*fileStream, &globalPvpBuffer, simTime);
+         }
+         else {
+            BufferUtils::writeFrame(*fileStream, &globalPvpBuffer, simTime);
+         }
       }
    }
    delete fileStream;
@@ -121,13 +132,14 @@ void CheckpointEntryPvp<T>::read(std::string const &checkpointDirectory, double
             numFrames);
    }
    Buffer<T> pvpBuffer;
+   BufferUtils::SparseFileTable frameTable;
    std::vector<double> frameTimestamps;
    frameTimestamps.resize(numFrames);
    for (int frame = 0; frame < numFrames; frame++) {
       int const mpiBatchIndex = calcMPIBatchIndex(frame);
       if (getMPIBlock()->getRank() == 0) {
          frameTimestamps.at(frame) =
-               BufferUtils::readActivityFromPvp(path.c_str(), &pvpBuffer, frame, nullptr);
+               BufferUtils::readActivityFromPvp(path.c_str(), &pvpBuffer, frame, &frameTable);
          pvpBuffer.grow(nxExtGlobal, nyExtGlobal, Buffer<float>::CENTER);
       }
       else if (mpiBatchIndex == getMPIBlock()->getBatchIndex()) {
@@ -32,6 +32,7 @@ void CheckpointEntryWeightPvp::write(
    }
 
    WeightsFileIO weightFileIO(fileStream, getMPIBlock(), mWeights);
+   weightFileIO.setLosslessCompression(getLosslessCompression());
    weightFileIO.writeWeights(simTime, mCompressFlag);
    delete fileStream;
 }
@@ -41,6 +41,7 @@ Checkpointer::Checkpointer(
    // This doesn't get put into mCheckpointRegistry because we handle the timeinfo separately.
    mCheckpointTimer = new Timer(mName.c_str(), "column", "checkpoint");
    registerTimer(mCheckpointTimer);
+   mMetricsRegistry = new MetricsRegistry(mMPIBlock->getGlobalComm());
 }
 
 Checkpointer::~Checkpointer() {
@@ -49,7 +50,9 @@ Checkpointer::~Checkpointer() {
    free(mCheckpointWriteWallclockUnit);
    free(mLastCheckpointDir);
    free(mInitializeFromCheckpointDir);
+   free(mCheckpointFormatString);
    delete mCheckpointTimer;
+   delete mMetricsRegistry;
    delete mMPIBlock;
 }
 
@@ -130,6 +133,10 @@ void Checkpointer::ioParamsFillGroup(enum ParamsIOFlag ioFlag, PVParams *params)
    ioParam_numCheckpointsKept(ioFlag, params);
    ioParam_lastCheckpointDir(ioFlag, params);
    ioParam_initializeFromCheckpointDir(ioFlag, params);
+   ioParam_checkpointFormat(ioFlag, params);
+   ioParam_losslessCheckpointCompression(ioFlag, params);
+   ioParam_metricsWriteStepInterval(ioFlag, params);
+   ioParam_asyncProbeOutput(ioFlag, params);
 }
 
 void Checkpointer::ioParam_verifyWrites(enum ParamsIOFlag ioFlag, PVParams *params) {
@@ -447,6 +454,71 @@ void Checkpointer::ioParam_initializeFromCheckpointDir(enum ParamsIOFlag ioFlag,
    }
 }
 
+void Checkpointer::ioParam_checkpointFormat(enum ParamsIOFlag ioFlag, PVParams *params) {
+   params->ioParamString(
+         ioFlag, mName.c_str(), "checkpointFormat", &mCheckpointFormatString, "directory");
+   if (ioFlag == PARAMS_IO_READ) {
+      pvAssert(mCheckpointFormatString);
+      for (size_t n = 0; n < strlen(mCheckpointFormatString); n++) {
+         mCheckpointFormatString[n] = tolower(mCheckpointFormatString[n]);
+      }
+      if (!strcmp(mCheckpointFormatString, "directory")) {
+         mCheckpointFormat = DIRECTORY;
+      }
+      else if (!strcmp(mCheckpointFormatString, "blockcontainer")) {
+         mCheckpointFormat = BLOCK_CONTAINER;
+      }
+      else if (!strcmp(mCheckpointFormatString, "sharedcontainer")) {
+         mCheckpointFormat = SHARED_CONTAINER;
+      }
+      else {
+         if (mMPIBlock->getRank() == 0) {
+            ErrorLog().printf(
+                  "checkpointFormat \"%s\" is unrecognized.  Use \"directory\", "
+                  "\"blockContainer\", or \"sharedContainer\".\n",
+                  mCheckpointFormatString);
+         }
+         MPI_Barrier(mMPIBlock->getComm());
+         exit(EXIT_FAILURE);
+      }
+   }
+}
+
+void Checkpointer::ioParam_losslessCheckpointCompression(
+      enum ParamsIOFlag ioFlag,
+      PVParams *params) {
+   params->ioParamValue(
+         ioFlag,
+         mName.c_str(),
+         "losslessCheckpointCompression",
+         &mLosslessCheckpointCompression,
+         mLosslessCheckpointCompression);
+}
+
+void Checkpointer::ioParam_metricsWriteStepInterval(enum ParamsIOFlag ioFlag, PVParams *params) {
+   params->ioParamValue(
+         ioFlag,
+         mName.c_str(),
+         "metricsWriteStepInterval",
+         &mMetricsWriteStepInterval,
+         mMetricsWriteStepInterval);
+   if (ioFlag == PARAMS_IO_READ) {
+      FatalIf(
+            mMetricsWriteStepInterval < 0L,
+            "%s: metricsWriteStepInterval must be nonnegative (value is %ld).\n",
+            mName.c_str(),
+            mMetricsWriteStepInterval);
+   }
+}
+
+void Checkpointer::ioParam_asyncProbeOutput(enum ParamsIOFlag ioFlag, PVParams *params) {
+   params->ioParamValue(
+         ioFlag, mName.c_str(), "asyncProbeOutput", &mAsyncProbeOutput, mAsyncProbeOutput);
+   if (ioFlag == PARAMS_IO_READ and mAsyncProbeOutput and !mProbeOutputWriter) {
+      mProbeOutputWriter = std::make_shared<AsyncWriter>();
+   }
+}
+
 void Checkpointer::provideFinalStep(long int finalStep) {
    if (mCheckpointIndexWidth < 0) {
       mWidthOfFinalStepNumber = (int)std::floor(std::log10((float)finalStep)) + 1;
@@ -469,6 +541,7 @@ bool Checkpointer::registerCheckpointEntry(
          return false;
       }
    }
+   checkpointEntry->setLosslessCompression(mLosslessCheckpointCompression);
    mCheckpointRegistry.push_back(checkpointEntry);
    return true;
 }
@@ -494,6 +567,8 @@ void Checkpointer::readNamedCheckpointEntry(
       return;
    }
    std::string checkpointDirectory = generateBlockPath(mInitializeFromCheckpointDir);
+   // If initializeFromCheckpointDir is a container checkpoint, readStateFromCheckpoint()
+   // has mounted it at checkpointDirectory.
    for (auto &c : mCheckpointRegistry) {
       if (c->getName() == checkpointEntryName) {
          double timestamp = 0.0; // not used
@@ -585,10 +660,12 @@ void Checkpointer::findWarmStartDirectory() {
 
 void Checkpointer::readStateFromCheckpoint() {
    if (getInitializeFromCheckpointDir() and getInitializeFromCheckpointDir()[0]) {
+      FileContainer *container = mountCheckpointContainer(mInitializeFromCheckpointDir);
       notify(
             mObserverTable,
             std::make_shared<ReadStateFromCheckpointMessage<Checkpointer>>(this),
             mMPIBlock->getRank() == 0 /*printFlag*/);
+      delete container;
    }
 }
 
@@ -637,6 +714,7 @@ void Checkpointer::extractCheckpointReadDirectory() {
 void Checkpointer::checkpointRead(double *simTimePointer, long int *currentStepPointer) {
    verifyDirectory(mCheckpointReadDirectory.c_str(), "CheckpointReadDirectory");
    std::string checkpointReadDirectory = generateBlockPath(mCheckpointReadDirectory);
+   FileContainer *container            = mountCheckpointContainer(mCheckpointReadDirectory);
    double readTime;
    for (auto &c : mCheckpointRegistry) {
       c->read(checkpointReadDirectory, &readTime);
@@ -652,6 +730,7 @@ void Checkpointer::checkpointRead(double *simTimePointer, long int *currentStepP
          mObserverTable,
          std::make_shared<ProcessCheckpointReadMessage const>(checkpointReadDirectory),
          mMPIBlock->getRank() == 0 /*printFlag*/);
+   delete container;
 }
 
 void Checkpointer::checkpointWrite(double simTime) {
@@ -798,19 +877,34 @@ void Checkpointer::checkpointNow() {
 void Checkpointer::checkpointToDirectory(std::string const &directory) {
    std::string checkpointDirectory = generateBlockPath(directory);
    mCheckpointTimer->start();
+   if (mProbeOutputWriter) {
+      // Probe output files should be complete up to the time of the checkpoint.
+      mProbeOutputWriter->flush();
+   }
    if (mMPIBlock->getRank() == 0) {
       InfoLog() << "Checkpointing to directory \"" << checkpointDirectory
                 << "\" at simTime = " << mTimeInfo.mSimTime << "\n";
-      struct stat timeinfostat;
-      std::string timeinfoFilename(checkpointDirectory);
-      timeinfoFilename.append("/timeinfo.bin");
-      int statstatus = stat(timeinfoFilename.c_str(), &timeinfostat);
-      if (statstatus == 0) {
-         WarnLog() << "Checkpoint directory \"" << checkpointDirectory
-                   << "\" has existing timeinfo.bin, which is now being deleted.\n";
-         mTimeInfoCheckpointEntry->remove(checkpointDirectory);
+      if (mCheckpointFormat == DIRECTORY) {
+         struct stat timeinfostat;
+         std::string timeinfoFilename(checkpointDirectory);
+         timeinfoFilename.append("/timeinfo.bin");
+         int statstatus = stat(timeinfoFilename.c_str(), &timeinfostat);
+         if (statstatus == 0) {
+            WarnLog() << "Checkpoint directory \"" << checkpointDirectory
+                      << "\" has existing timeinfo.bin, which is now being deleted.\n";
+            mTimeInfoCheckpointEntry->remove(checkpointDirectory);
+         }
       }
    }
+   // In the container formats, the entries are collected in a container mounted at the block
+   // path, and only the checkpoint directory itself exists on disk. A container file is renamed
+   // into place only after it is completely written, so it plays the role of timeinfo.bin
+   // in marking the checkpoint complete.
+   FileContainer *container = nullptr;
+   if (mCheckpointFormat != DIRECTORY) {
+      ensureDirExists(mMPIBlock, directory.c_str());
+      container = new FileContainer(checkpointDirectory);
+   }
    notify(
          mObserverTable,
          std::make_shared<PrepareCheckpointWriteMessage const>(checkpointDirectory),
@@ -823,6 +917,10 @@ void Checkpointer::checkpointToDirectory(std::string const &directory) {
    mCheckpointTimer->stop();
    mCheckpointTimer->start();
    writeTimers(checkpointDirectory);
+   if (container) {
+      writeCheckpointContainer(directory, container);
+      delete container;
+   }
    mCheckpointTimer->stop();
    if (mMPIBlock->getRank() == 0) {
       InfoLog().printf("checkpointWrite complete. simTime = %f\n", mTimeInfo.mSimTime);
@@ -832,6 +930,9 @@ void Checkpointer::checkpointToDirectory(std::string const &directory) {
 
 void Checkpointer::finalCheckpoint(double simTime) {
    mTimeInfo.mSimTime = simTime;
+   if (mProbeOutputWriter) {
+      mProbeOutputWriter->flush();
+   }
    if (mCheckpointWriteFlag) {
       checkpointNow();
    }
@@ -843,7 +944,10 @@ void Checkpointer::finalCheckpoint(double simTime) {
 void Checkpointer::rotateOldCheckpoints(std::string const &newCheckpointDirectory) {
    std::string &oldestCheckpointDir = mOldCheckpointDirectories[mOldCheckpointDirectoriesIndex];
    if (!oldestCheckpointDir.empty()) {
-      if (mMPIBlock->getRank() == 0) {
+      if (mCheckpointFormat != DIRECTORY) {
+         deleteCheckpointContainer(oldestCheckpointDir);
+      }
+      else if (mMPIBlock->getRank() == 0) {
          std::string targetDirectory = generateBlockPath(oldestCheckpointDir);
          struct stat lcp_stat;
          int statstatus = stat(targetDirectory.c_str(), &lcp_stat);
@@ -896,6 +1000,89 @@ void Checkpointer::rotateOldCheckpoints(std::string const &newCheckpointDirector
    }
 }
 
+std::string Checkpointer::getContainerBlockName() const {
+   return mBlockDirectoryName.empty() ? std::string("checkpoint") : mBlockDirectoryName;
+}
+
+FileContainer *Checkpointer::mountCheckpointContainer(std::string const &directory) {
+   std::string const expandedDirectory = expandLeadingTilde(directory);
+   std::string containerPath;
+   int found = 0;
+   if (mMPIBlock->getRank() == 0) {
+      // A blockContainer checkpoint has <blockname>.pvcp; a sharedContainer checkpoint has
+      // checkpoint.pvcp. With only one block, the two names coincide.
+      std::string const blockPath  = expandedDirectory + "/" + getContainerBlockName() + ".pvcp";
+      std::string const sharedPath = expandedDirectory + "/checkpoint.pvcp";
+      struct stat containerStat;
+      if (stat(blockPath.c_str(), &containerStat) == 0) {
+         containerPath = blockPath;
+         found         = 1;
+      }
+      else if (stat(sharedPath.c_str(), &containerStat) == 0) {
+         containerPath = sharedPath;
+         found         = 1;
+      }
+   }
+   MPI_Bcast(&found, 1, MPI_INT, 0, mMPIBlock->getComm());
+   if (!found) {
+      return nullptr;
+   }
+   FileContainer *container = new FileContainer(generateBlockPath(directory));
+   if (mMPIBlock->getRank() == 0) {
+      InfoLog() << "Reading checkpoint container \"" << containerPath << "\"\n";
+      container->openFile(containerPath, getContainerBlockName());
+   }
+   return container;
+}
+
+void Checkpointer::writeCheckpointContainer(
+      std::string const &directory,
+      FileContainer *container) {
+   std::string const expandedDirectory = expandLeadingTilde(directory);
+   if (mCheckpointFormat == SHARED_CONTAINER) {
+      container->writeShared(
+            expandedDirectory + "/checkpoint.pvcp", mMPIBlock, getContainerBlockName());
+   }
+   else if (mMPIBlock->getRank() == 0) {
+      pvAssert(mCheckpointFormat == BLOCK_CONTAINER);
+      container->writeFile(
+            expandedDirectory + "/" + getContainerBlockName() + ".pvcp", mVerifyWrites);
+   }
+}
+
+void Checkpointer::deleteCheckpointContainer(std::string const &directory) {
+   std::string containerPath = expandLeadingTilde(directory);
+   bool deleter              = false;
+   if (mCheckpointFormat == SHARED_CONTAINER) {
+      containerPath.append("/checkpoint.pvcp");
+      deleter = mMPIBlock->getGlobalRank() == 0;
+   }
+   else {
+      containerPath.append("/").append(getContainerBlockName()).append(".pvcp");
+      deleter = mMPIBlock->getRank() == 0;
+   }
+   if (deleter and unlink(containerPath.c_str()) != 0) {
+      WarnLog().printf(
+            "unable to delete older checkpoint container \"%s\": %s\n",
+            containerPath.c_str(),
+            strerror(errno));
+   }
+}
+
+void Checkpointer::writeMetrics(double simTime) {
+   if (mMetricsWriteStepInterval <= 0L) {
+      return;
+   }
+   mMetricsStepCount++;
+   if (mMetricsStepCount % mMetricsWriteStepInterval == 0L) {
+      std::string path;
+      if (mMPIBlock->getGlobalRank() == 0) {
+         path = makeOutputPathFilename(std::string("metrics.csv"));
+      }
+      mMetricsRegistry->write(path, simTime);
+   }
+}
+
 void Checkpointer::writeTimers(PrintStream &stream) const {
    for (auto timer : mTimers) {
       timer->fprint_time(stream);
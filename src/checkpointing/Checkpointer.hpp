@@ -10,10 +10,13 @@
 
 #include "checkpointing/CheckpointEntry.hpp"
 #include "checkpointing/CheckpointEntryData.hpp"
+#include "io/FileContainer.hpp"
 #include "io/PVParams.hpp"
 // #include "io/io.hpp"
 #include "observerpattern/Subject.hpp"
 // #include "structures/MPIBlock.hpp"
+#include "io/AsyncWriter.hpp"
+#include "utils/MetricsRegistry.hpp"
 #include "utils/Timer.hpp"
 #include <ctime>
 // #include <map>
@@ -139,10 +142,52 @@ class Checkpointer : public Subject {
     * Relative paths are relative to the working directory.
     */
    void ioParam_lastCheckpointDir(enum ParamsIOFlag ioFlag, PVParams *params);
+
+   /**
+    * @brief checkpointFormat: Specifies how checkpoints are written.
+    * @details Possible choices include
+    * - directory: Each checkpoint entry is a separate file in the checkpoint directory
+    *   (or in its block subdirectory if CheckpointCells are in use).
+    * - blockContainer: Each MPIBlock writes all of its entries into a single indexed
+    *   container file, <blockname>.pvcp, in the checkpoint directory. If there is only one
+    *   block, the file is checkpoint.pvcp.
+    * - sharedContainer: All MPIBlocks write into a single file, checkpoint.pvcp, using MPI-IO.
+    * Checkpoints in any of these formats can be read, whatever the value of this parameter.
+    * The default is directory.
+    */
+   void ioParam_checkpointFormat(enum ParamsIOFlag ioFlag, PVParams *params);
+
+   /**
+    * @brief losslessCheckpointCompression: If true, the float data in activity and weight
+    * checkpoint files is compressed without loss, using byte shuffling and LZ-type block
+    * compression. Restarting from a compressed checkpoint reproduces the run exactly.
+    * Connections with writeCompressedCheckpoints set still use the lossy 8-bit format.
+    * Compressed checkpoints are recognized when read, whatever the value of this parameter.
+    * The default is false.
+    */
+   void ioParam_losslessCheckpointCompression(enum ParamsIOFlag ioFlag, PVParams *params);
+
+   /**
+    * @brief metricsWriteStepInterval: If positive, the performance counters that layers,
+    * connections and weight updaters report into the MetricsRegistry are reduced across
+    * processes and written to metrics.csv in the output directory every this many timesteps.
+    * If zero (the default), the metrics are not written.
+    */
+   void ioParam_metricsWriteStepInterval(enum ParamsIOFlag ioFlag, PVParams *params);
+
+   /**
+    * @brief asyncProbeOutput: If true, probes that write to a probeOutputFile collect their
+    * output in memory, and a background thread writes it to the files, so that file I/O
+    * overlaps the next timestep. The files are brought up to date at each checkpoint and at the
+    * end of the run. Probes that write to standard output are not affected.
+    * The default is false.
+    */
+   void ioParam_asyncProbeOutput(enum ParamsIOFlag ioFlag, PVParams *params);
    /** @} */
 
    enum CheckpointWriteTriggerMode { NONE, STEP, SIMTIME, WALLCLOCK };
    enum WallClockUnit { SECOND, MINUTE, HOUR, DAY };
+   enum CheckpointFormat { DIRECTORY, BLOCK_CONTAINER, SHARED_CONTAINER };
 
   public:
    struct TimeInfo {
@@ -194,7 +239,20 @@ class Checkpointer : public Subject {
    void finalCheckpoint(double simTime);
    void writeTimers(PrintStream &stream) const;
 
+   /**
+    * Called once per timestep. Writes the metrics registry's counters if metricsWriteStepInterval
+    * timesteps have passed since the last write.
+    */
+   void writeMetrics(double simTime);
+
    MPIBlock const *getMPIBlock() { return mMPIBlock; }
+   MetricsRegistry *getMetricsRegistry() { return mMetricsRegistry; }
+
+   /**
+    * Returns the writer that probes hand their output to if asyncProbeOutput is true,
+    * or an empty pointer if asyncProbeOutput is false.
+    */
+   std::shared_ptr<AsyncWriter> getProbeOutputWriter() { return mProbeOutputWriter; }
    bool doesVerifyWrites() { return mVerifyWrites; }
    std::string const &getOutputPath() { return mOutputPath; }
    bool getCheckpointWriteFlag() const { return mCheckpointWriteFlag; }
@@ -208,6 +266,7 @@ class Checkpointer : public Subject {
    std::string const &getCheckpointReadDirectory() const { return mCheckpointReadDirectory; }
    char const *getLastCheckpointDir() const { return mLastCheckpointDir; }
    char const *getInitializeFromCheckpointDir() const { return mInitializeFromCheckpointDir; }
+   enum CheckpointFormat getCheckpointFormat() const { return mCheckpointFormat; }
    std::string const &getBlockDirectoryName() const { return mBlockDirectoryName; }
 
   private:
@@ -292,6 +351,32 @@ class Checkpointer : public Subject {
     * old checkpoint directories, and adds the new checkpoint directory to the list.
     */
    void rotateOldCheckpoints(std::string const &newCheckpointDirectory);
+
+   /**
+    * The name under which this process's MPIBlock is stored in a container checkpoint:
+    * the block directory name, or "checkpoint" if there is only one block.
+    */
+   std::string getContainerBlockName() const;
+
+   /**
+    * If the given checkpoint directory holds a container file for this process's MPIBlock,
+    * mounts the container at the block path of the directory and returns it. Returns null
+    * for a checkpoint written in the directory format. The caller deletes the container,
+    * which unmounts it.
+    */
+   FileContainer *mountCheckpointContainer(std::string const &directory);
+
+   /**
+    * Writes the container holding the entries of a checkpoint into the checkpoint directory,
+    * either as one file per MPIBlock or as one shared file, depending on checkpointFormat.
+    */
+   void writeCheckpointContainer(std::string const &directory, FileContainer *container);
+
+   /**
+    * Called by rotateOldCheckpoints when the checkpointFormat is not directory.
+    * Deletes the container files of the given checkpoint directory.
+    */
+   void deleteCheckpointContainer(std::string const &directory);
    void writeTimers(std::string const &directory);
    std::string generateBlockPath(std::string const &baseDirectory);
    void verifyDirectory(char const *directory, std::string const &description);
@@ -325,6 +410,12 @@ class Checkpointer : public Subject {
    int mNumCheckpointsKept                                                 = 2;
    char *mLastCheckpointDir                                                = nullptr;
    char *mInitializeFromCheckpointDir                                      = nullptr;
+   char *mCheckpointFormatString                                           = nullptr;
+   enum CheckpointFormat mCheckpointFormat                                 = DIRECTORY;
+   bool mLosslessCheckpointCompression                                     = false;
+   long int mMetricsWriteStepInterval                                      = 0L;
+   long int mMetricsStepCount                                              = 0L;
+   bool mAsyncProbeOutput                                                  = false;
    std::string mCheckpointReadDirectory;
    long int mNextCheckpointStep         = 0L; // kept only for consistency with HyPerCol
    double mNextCheckpointSimtime        = 0.0;
@@ -337,6 +428,8 @@ class Checkpointer : public Subject {
    // used if mDeleteOlderCheckpoints is true.
    std::vector<Timer const *> mTimers;
    Timer *mCheckpointTimer = nullptr;
+   MetricsRegistry *mMetricsRegistry = nullptr;
+   std::shared_ptr<AsyncWriter> mProbeOutputWriter;
 
    static std::string const mDefaultOutputPath;
 };
@@ -0,0 +1,182 @@
+#include "BenchmarkReport.hpp"
+#include "io/FileStream.hpp"
+#include "utils/PVLog.hpp"
+#include <sys/resource.h>
+
+namespace PV {
+
+BenchmarkReport::BenchmarkReport(int numPhases, int numThreads, MPI_Comm comm)
+      : mNumPhases(numPhases), mNumThreads(numThreads), mComm(comm) {
+   MPI_Comm_rank(mComm, &mRank);
+   MPI_Comm_size(mComm, &mNumProcesses);
+   mPhaseTimes.assign(mNumPhases, 0U);
+}
+
+void BenchmarkReport::addLayerCounters(int phase, PerformanceCounters const *counters) {
+   if (counters != nullptr) {
+      mLayerCounters.push_back({phase, counters});
+   }
+}
+
+void BenchmarkReport::addDeliveryCounters(int phase, PerformanceCounters const *counters) {
+   if (counters != nullptr) {
+      mDeliveryCounters.push_back({phase, counters});
+   }
+}
+
+void BenchmarkReport::readCounters(
+      std::vector<double> &neuronUpdates,
+      std::vector<double> &synapticOps) const {
+   neuronUpdates.assign(mNumPhases, 0.0);
+   synapticOps.assign(mNumPhases, 0.0);
+   for (auto const &c : mLayerCounters) {
+      neuronUpdates[c.mPhase] += (double)c.mCounters->mNeuronUpdates;
+   }
+   for (auto const &c : mDeliveryCounters) {
+      synapticOps[c.mPhase] += (double)c.mCounters->mSynapticOps;
+   }
+}
+
+void BenchmarkReport::start() {
+   MPI_Barrier(mComm);
+   readCounters(mStartNeuronUpdates, mStartSynapticOps);
+   mPhaseTimes.assign(mNumPhases, 0U);
+   mStartCPUTime = getCPUSeconds();
+   mStartTime    = std::chrono::steady_clock::now();
+}
+
+void BenchmarkReport::stop(long numWarmupSteps, long numTimedSteps) {
+   MPI_Barrier(mComm);
+   auto const stopTime = std::chrono::steady_clock::now();
+   mWallTime           = std::chrono::duration<double>(stopTime - mStartTime).count();
+   mCPUTime            = getCPUSeconds() - mStartCPUTime;
+   mWarmupSteps        = numWarmupSteps;
+   mTimedSteps         = numTimedSteps;
+
+   readCounters(mNeuronUpdates, mSynapticOps);
+   mPhaseSeconds.resize(mNumPhases);
+   for (int p = 0; p < mNumPhases; p++) {
+      mNeuronUpdates[p] -= mStartNeuronUpdates[p];
+      mSynapticOps[p] -= mStartSynapticOps[p];
+      mPhaseSeconds[p] = (double)mPhaseTimes[p] * 1.0e-9;
+   }
+
+   // The MPI stub has no 64-bit integer type, so counts are reduced as doubles, as in
+   // MetricsRegistry.
+   mMaxMemory   = getMaxResidentBytes();
+   mTotalMemory = mMaxMemory;
+   MPI_Allreduce(MPI_IN_PLACE, mNeuronUpdates.data(), mNumPhases, MPI_DOUBLE, MPI_SUM, mComm);
+   MPI_Allreduce(MPI_IN_PLACE, mSynapticOps.data(), mNumPhases, MPI_DOUBLE, MPI_SUM, mComm);
+   MPI_Allreduce(MPI_IN_PLACE, mPhaseSeconds.data(), mNumPhases, MPI_DOUBLE, MPI_MAX, mComm);
+   MPI_Allreduce(MPI_IN_PLACE, &mWallTime, 1, MPI_DOUBLE, MPI_MAX, mComm);
+   MPI_Allreduce(MPI_IN_PLACE, &mCPUTime, 1, MPI_DOUBLE, MPI_SUM, mComm);
+   MPI_Allreduce(MPI_IN_PLACE, &mMaxMemory, 1, MPI_DOUBLE, MPI_MAX, mComm);
+   MPI_Allreduce(MPI_IN_PLACE, &mTotalMemory, 1, MPI_DOUBLE, MPI_SUM, mComm);
+}
+
+double BenchmarkReport::getCPUSeconds() {
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   double seconds = (double)usage.ru_utime.tv_sec + (double)usage.ru_stime.tv_sec;
+   seconds += 1.0e-6 * (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+   return seconds;
+}
+
+double BenchmarkReport::getMaxResidentBytes() {
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+   return (double)usage.ru_maxrss; // bytes on macOS
+#else
+   return (double)usage.ru_maxrss * 1024.0; // kilobytes on Linux
+#endif // __APPLE__
+}
+
+void BenchmarkReport::print() const {
+   if (mRank != 0) {
+      return;
+   }
+   double totalNeuronUpdates = 0.0;
+   double totalSynapticOps   = 0.0;
+   for (int p = 0; p < mNumPhases; p++) {
+      totalNeuronUpdates += mNeuronUpdates[p];
+      totalSynapticOps += mSynapticOps[p];
+   }
+   double const wallTime   = mWallTime > 0.0 ? mWallTime : 1.0e-9;
+   double const efficiency = mCPUTime / (wallTime * (double)(mNumThreads * mNumProcesses));
+   InfoLog().printf(
+         "Benchmark: %ld timed steps after %ld warm-up steps, %d processes x %d threads\n",
+         mTimedSteps,
+         mWarmupSteps,
+         mNumProcesses,
+         mNumThreads);
+   InfoLog().printf(
+         "Benchmark: %.6f s, %.4g steps/s, %.4g neuron updates/s, %.4g synaptic events/s\n",
+         mWallTime,
+         (double)mTimedSteps / wallTime,
+         totalNeuronUpdates / wallTime,
+         totalSynapticOps / wallTime);
+   for (int p = 0; p < mNumPhases; p++) {
+      double const phaseTime = mPhaseSeconds[p] > 0.0 ? mPhaseSeconds[p] : 1.0e-9;
+      InfoLog().printf(
+            "Benchmark: phase %d: %.6f s, %.4g neuron updates/s, %.4g synaptic events/s\n",
+            p,
+            mPhaseSeconds[p],
+            mNeuronUpdates[p] / phaseTime,
+            mSynapticOps[p] / phaseTime);
+   }
+   InfoLog().printf(
+         "Benchmark: memory high-water mark %.1f MiB per process (maximum), %.1f MiB total\n",
+         mMaxMemory / 1048576.0,
+         mTotalMemory / 1048576.0);
+   InfoLog().printf("Benchmark: thread efficiency %.1f%%\n", 100.0 * efficiency);
+}
+
+void BenchmarkReport::writeJSON(std::string const &path) const {
+   if (mRank != 0) {
+      return;
+   }
+   double totalNeuronUpdates = 0.0;
+   double totalSynapticOps   = 0.0;
+   for (int p = 0; p < mNumPhases; p++) {
+      totalNeuronUpdates += mNeuronUpdates[p];
+      totalSynapticOps += mSynapticOps[p];
+   }
+   double const wallTime = mWallTime > 0.0 ? mWallTime : 1.0e-9;
+
+   FileStream stream(path.c_str(), std::ios_base::out);
+   stream << "{\n";
+   stream.printf("  \"numProcesses\": %d,\n", mNumProcesses);
+   stream.printf("  \"numThreads\": %d,\n", mNumThreads);
+   stream.printf("  \"warmupSteps\": %ld,\n", mWarmupSteps);
+   stream.printf("  \"timedSteps\": %ld,\n", mTimedSteps);
+   stream.printf("  \"seconds\": %.9g,\n", mWallTime);
+   stream.printf("  \"stepsPerSecond\": %.9g,\n", (double)mTimedSteps / wallTime);
+   stream.printf("  \"neuronUpdates\": %.0f,\n", totalNeuronUpdates);
+   stream.printf("  \"neuronUpdatesPerSecond\": %.9g,\n", totalNeuronUpdates / wallTime);
+   stream.printf("  \"synapticEvents\": %.0f,\n", totalSynapticOps);
+   stream.printf("  \"synapticEventsPerSecond\": %.9g,\n", totalSynapticOps / wallTime);
+   stream.printf("  \"maxMemoryBytes\": %.0f,\n", mMaxMemory);
+   stream.printf("  \"totalMemoryBytes\": %.0f,\n", mTotalMemory);
+   stream.printf(
+         "  \"threadEfficiency\": %.6f,\n",
+         mCPUTime / (wallTime * (double)(mNumThreads * mNumProcesses)));
+   stream << "  \"phases\": [";
+   for (int p = 0; p < mNumPhases; p++) {
+      double const phaseTime = mPhaseSeconds[p] > 0.0 ? mPhaseSeconds[p] : 1.0e-9;
+      stream << (p == 0 ? "\n" : ",\n");
+      stream.printf(
+            "    {\"phase\": %d, \"seconds\": %.9g, \"neuronUpdates\": %.0f, "
+            "\"neuronUpdatesPerSecond\": %.9g, \"synapticEvents\": %.0f, "
+            "\"synapticEventsPerSecond\": %.9g}",
+            p,
+            mPhaseSeconds[p],
+            mNeuronUpdates[p],
+            mNeuronUpdates[p] / phaseTime,
+            mSynapticOps[p],
+            mSynapticOps[p] / phaseTime);
+   }
+   stream << "\n  ]\n}\n";
+}
+
+} // namespace PV
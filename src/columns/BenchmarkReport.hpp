@@ -0,0 +1,90 @@
+#ifndef BENCHMARKREPORT_HPP_
+#define BENCHMARKREPORT_HPP_
+
+#include "arch/mpi/mpi.h"
+#include "utils/MetricsRegistry.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * Measures the throughput of the timed window of a run in the --benchmark run mode, and reports
+ * it as one set of numbers per params file: timesteps per second, neuron updates per second and
+ * synaptic events per second, overall and for each phase, together with the memory high-water
+ * mark and the thread efficiency.
+ *
+ * HyPerCol registers the performance counters of each layer and each connection's delivery,
+ * with the phase they belong to (a delivery belongs to its postsynaptic layer's phase), and then
+ * brackets the timed window with start() and stop(). The counters accumulate over the run, so
+ * the report takes the difference of their values at stop() and start(). Neuron updates and
+ * synaptic events are summed over processes; times are the maximum over processes.
+ *
+ * Thread efficiency is the CPU time used by all processes, divided by the wall-clock time
+ * multiplied by the total number of threads. It is near one when every thread is busy for the
+ * whole window, and falls when threads wait for each other or for MPI.
+ */
+class BenchmarkReport {
+  public:
+   BenchmarkReport(int numPhases, int numThreads, MPI_Comm comm);
+
+   void addLayerCounters(int phase, PerformanceCounters const *counters);
+   void addDeliveryCounters(int phase, PerformanceCounters const *counters);
+
+   /** Must be called by all processes. Synchronizes them and starts the timed window. */
+   void start();
+
+   /** Adds to the time spent in the given phase during the timed window. */
+   void addPhaseTime(int phase, std::uint64_t nanoseconds) { mPhaseTimes[phase] += nanoseconds; }
+
+   /**
+    * Must be called by all processes. Synchronizes them, ends the timed window, and reduces the
+    * measurements across processes.
+    */
+   void stop(long numWarmupSteps, long numTimedSteps);
+
+   /** Prints the report to the output stream, on the root process only. */
+   void print() const;
+
+   /** Writes the report as a JSON object to the given path, on the root process only. */
+   void writeJSON(std::string const &path) const;
+
+  private:
+   struct CounterSet {
+      int mPhase;
+      PerformanceCounters const *mCounters;
+   };
+
+   void readCounters(std::vector<double> &neuronUpdates, std::vector<double> &synapticOps) const;
+   static double getCPUSeconds();
+   static double getMaxResidentBytes();
+
+  private:
+   int mNumPhases;
+   int mNumThreads;
+   MPI_Comm mComm;
+   int mRank           = 0;
+   int mNumProcesses   = 1;
+   long mWarmupSteps   = 0L;
+   long mTimedSteps    = 0L;
+   double mWallTime    = 0.0;
+   double mCPUTime     = 0.0;
+   double mMaxMemory   = 0.0; // largest high-water mark of any process, in bytes
+   double mTotalMemory = 0.0; // sum over processes of the high-water marks, in bytes
+   std::vector<CounterSet> mLayerCounters;
+   std::vector<CounterSet> mDeliveryCounters;
+   std::vector<std::uint64_t> mPhaseTimes;
+   std::vector<double> mStartNeuronUpdates;
+   std::vector<double> mStartSynapticOps;
+   std::vector<double> mNeuronUpdates; // per phase, over the timed window
+   std::vector<double> mSynapticOps;   // per phase, over the timed window
+   std::vector<double> mPhaseSeconds;
+   std::chrono::steady_clock::time_point mStartTime;
+   double mStartCPUTime = 0.0;
+};
+
+} // namespace PV
+
+#endif // BENCHMARKREPORT_HPP_
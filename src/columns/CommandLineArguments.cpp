@@ -52,6 +52,16 @@ void CommandLineArguments::resetState(
    int numRows               = 0;
    int numColumns            = 0;
    int batchWidth            = 0;
+   int autoDecomposition     = 0;
+   char *traceFile           = nullptr;
+   bool useDefaultWarmup     = false;
+   int benchmarkWarmup       = -1;
+   int benchmarkQuiet        = 0;
+   char *costCalibration     = nullptr;
+   char *serveSocket         = nullptr;
+   char *serveInput          = nullptr;
+   char *serveOutput         = nullptr;
+   char *paramsCache         = nullptr;
    int dryRun                = 0;
    parse_options(
          argc,
@@ -71,6 +81,16 @@ void CommandLineArguments::resetState(
          &numRows,
          &numColumns,
          &batchWidth,
+         &autoDecomposition,
+         &traceFile,
+         &useDefaultWarmup,
+         &benchmarkWarmup,
+         &benchmarkQuiet,
+         &costCalibration,
+         &serveSocket,
+         &serveInput,
+         &serveOutput,
+         &paramsCache,
          &dryRun);
    std::string configString = ConfigParser::createString(
          requireReturn,
@@ -87,6 +107,16 @@ void CommandLineArguments::resetState(
          numRows,
          numColumns,
          batchWidth,
+         (bool)autoDecomposition,
+         std::string{traceFile ? traceFile : ""},
+         useDefaultWarmup,
+         benchmarkWarmup,
+         (bool)benchmarkQuiet,
+         std::string{costCalibration ? costCalibration : ""},
+         std::string{serveSocket ? serveSocket : ""},
+         std::string{serveInput ? serveInput : ""},
+         std::string{serveOutput ? serveOutput : ""},
+         std::string{paramsCache ? paramsCache : ""},
          (bool)dryRun);
    std::istringstream configStream{configString};
    Arguments::resetState(configStream, allowUnrecognizedArguments);
@@ -96,6 +126,12 @@ void CommandLineArguments::resetState(
    free(gpuDevices);
    free(workingDir);
    free(checkpointReadDir);
+   free(traceFile);
+   free(costCalibration);
+   free(serveSocket);
+   free(serveInput);
+   free(serveOutput);
+   free(paramsCache);
 }
 
 } /* namespace PV */
@@ -63,12 +63,27 @@ class CommandLineArguments : public Arguments {
     * NumColumns setting.
     *    "-batchwidth": the next argument is parsed as an integer and used as
     * the BatchWidth setting.
+    *    "--auto-decomposition": the AutoDecomposition flag is set to true.
+    *    "-trace": the next argument is used as the TraceFile string.
+    *    "--benchmark": turns on the benchmark run mode. If the next argument is a nonnegative
+    * integer, it is used as the number of warm-up steps; otherwise the default number is used.
+    * Either way, the setting is stored in the Benchmark argument, in the same way as "-t".
+    *    "--benchmark-quiet": the BenchmarkQuiet flag is set to true.
+    *    "--cost-calibration": the next argument is used as the CostCalibration string.
+    *    "--serve": the next argument is used as the Serve string, the socket path of the
+    * inference-serving run mode.
+    *    "--serve-input": the next argument is used as the ServeInput string.
+    *    "--serve-output": the next argument is used as the ServeOutput string.
+    *    "--params-cache": the next argument is used as the ParamsCache string, the path of a
+    * cache of the parsed params. The cache is keyed on the params text, so a Lua params program
+    * is still run every time; only the parsing of its output is skipped.
     *    "-n": the DryRun flag is set to true.
     *    "--require-return": the RequireReturn flag is set to true.
     * It is an error to have both the -r and -c options.
     *
     * Note that all arguments have a single hyphen, except for
-    * "--require-return".
+    * "--require-return", "--auto-decomposition", "--benchmark", "--benchmark-quiet",
+    * "--cost-calibration", "--serve", "--serve-input", "--serve-output" and "--params-cache".
     *
     * If an option depends on the next argument but there is no next argument,
     * the corresponding
@@ -0,0 +1,444 @@
+#include "CostModel.hpp"
+#include "components/ArborList.hpp"
+#include "components/CloneWeightsPair.hpp"
+#include "components/PatchGeometry.hpp"
+#include "components/PatchSize.hpp"
+#include "components/SharedWeights.hpp"
+#include "components/WeightsPair.hpp"
+#include "connections/BaseConnection.hpp"
+#include "delivery/HyPerDeliveryFacade.hpp"
+#include "layers/HyPerLayer.hpp"
+#include "utils/PVLog.hpp"
+#include "weightupdaters/BaseWeightUpdater.hpp"
+#include "weightupdaters/HebbianUpdater.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace PV {
+
+namespace {
+
+// Rough throughputs of one thread, used when the model has not been calibrated.
+double const defaultSynapsesPerThread         = 5.0e8;
+double const defaultNeuronUpdatesPerThread    = 2.0e8;
+double const defaultLearningSynapsesPerThread = 2.5e8;
+double const defaultExchangeBytesPerSecond    = 1.0e9;
+
+struct RankedDecomposition {
+   double mSeconds;
+   CostModel::Decomposition mDecomposition;
+};
+
+bool compareRankedDecompositions(RankedDecomposition const &a, RankedDecomposition const &b) {
+   if (a.mSeconds != b.mSeconds) {
+      return a.mSeconds < b.mSeconds;
+   }
+   // Prefer splitting the batch, which needs no border exchange, and then square tiles.
+   if (a.mDecomposition.mBatchWidth != b.mDecomposition.mBatchWidth) {
+      return a.mDecomposition.mBatchWidth > b.mDecomposition.mBatchWidth;
+   }
+   return std::abs(a.mDecomposition.mRows - a.mDecomposition.mColumns)
+          < std::abs(b.mDecomposition.mRows - b.mDecomposition.mColumns);
+}
+
+bool compareEstimateTimes(CostModel::Estimate const &a, CostModel::Estimate const &b) {
+   return a.mSeconds > b.mSeconds;
+}
+
+double median(std::vector<double> values) {
+   std::sort(values.begin(), values.end());
+   std::size_t const n = values.size();
+   return n % 2 == 1 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+} // namespace
+
+CostModel::CostModel(int numThreads, double deltaTime)
+      : mNumThreads(numThreads > 0 ? numThreads : 1), mDeltaTime(deltaTime) {
+   mSynapsesPerSecond         = defaultSynapsesPerThread * mNumThreads;
+   mNeuronUpdatesPerSecond    = defaultNeuronUpdatesPerThread * mNumThreads;
+   mLearningSynapsesPerSecond = defaultLearningSynapsesPerThread * mNumThreads;
+   mExchangeBytesPerSecond    = defaultExchangeBytesPerSecond;
+}
+
+void CostModel::calibrate(std::string const &path) {
+   std::ifstream calibrationStream(path);
+   FatalIf(
+         calibrationStream.fail(),
+         "Unable to open cost calibration file \"%s\".\n",
+         path.c_str());
+   std::stringstream buffer;
+   buffer << calibrationStream.rdbuf();
+   std::string const contents = buffer.str();
+
+   // Each result object of the pvbenchmarks report has a "name" field, followed later in the
+   // same object by a "throughput" field.
+   std::map<std::string, std::vector<double>> throughputs;
+   std::string const nameKey("\"name\": \"");
+   std::string const throughputKey("\"throughput\": ");
+   std::size_t pos = contents.find(nameKey);
+   while (pos != std::string::npos) {
+      std::size_t const nameStart = pos + nameKey.size();
+      std::size_t const nameEnd   = contents.find('"', nameStart);
+      std::size_t const nextName  = contents.find(nameKey, nameStart);
+      std::size_t const found     = contents.find(throughputKey, nameStart);
+      if (nameEnd != std::string::npos and found != std::string::npos and found < nextName) {
+         std::string const name = contents.substr(nameStart, nameEnd - nameStart);
+         double const value = std::strtod(contents.c_str() + found + throughputKey.size(), nullptr);
+         if (value > 0.0) {
+            throughputs[name].push_back(value);
+         }
+      }
+      pos = nextName;
+   }
+   FatalIf(
+         throughputs.empty(),
+         "Cost calibration file \"%s\" has no benchmark results.\n",
+         path.c_str());
+
+   auto found = throughputs.find("ConvolveDelivery");
+   if (found != throughputs.end()) {
+      mSynapsesPerSecond = median(found->second);
+   }
+   found = throughputs.find("HebbianUpdate");
+   if (found != throughputs.end()) {
+      mLearningSynapsesPerSecond = median(found->second);
+   }
+   found = throughputs.find("BorderExchange");
+   if (found != throughputs.end()) {
+      mExchangeBytesPerSecond = median(found->second);
+   }
+   mCalibrated = true;
+}
+
+void CostModel::addObjects(std::map<std::string, Observer *> const &objectMap) {
+   for (auto &obj : objectMap) {
+      auto *layer = dynamic_cast<HyPerLayer *>(obj.second);
+      if (layer != nullptr) {
+         addLayer(layer);
+      }
+   }
+   for (auto &obj : objectMap) {
+      auto *connection = dynamic_cast<BaseConnection *>(obj.second);
+      if (connection != nullptr) {
+         addConnection(connection);
+      }
+   }
+}
+
+void CostModel::addLayer(HyPerLayer *layer) {
+   PVLayerLoc const *loc = layer->getLayerLoc();
+   LayerInfo info;
+   info.mName           = std::string(layer->getName());
+   info.mNxGlobal       = loc->nxGlobal;
+   info.mNyGlobal       = loc->nyGlobal;
+   info.mNf             = loc->nf;
+   info.mNBatchGlobal   = loc->nbatchGlobal;
+   info.mHalo           = loc->halo;
+   info.mNumChannels    = layer->getNumChannels();
+   info.mNumDelayLevels = layer->getNumDelayLevels();
+   info.mSparse         = layer->getSparseFlag();
+   mLayerIndices.emplace(info.mName, (int)mLayers.size());
+   mLayers.push_back(info);
+}
+
+void CostModel::addConnection(BaseConnection *connection) {
+   auto preFound  = mLayerIndices.find(std::string(connection->getPreLayerName()));
+   auto postFound = mLayerIndices.find(std::string(connection->getPostLayerName()));
+   FatalIf(
+         preFound == mLayerIndices.end() or postFound == mLayerIndices.end(),
+         "CostModel: the layers of %s must be added before the connection.\n",
+         connection->getDescription_c());
+
+   ConnectionInfo info;
+   info.mName      = std::string(connection->getName());
+   info.mPreIndex  = preFound->second;
+   info.mPostIndex = postFound->second;
+
+   auto *patchSize  = connection->getComponentByType<PatchSize>();
+   info.mHasPatch   = patchSize != nullptr;
+   info.mPatchSizeX = patchSize ? patchSize->getPatchSizeX() : 1;
+   info.mPatchSizeY = patchSize ? patchSize->getPatchSizeY() : 1;
+   info.mPatchSizeF = patchSize ? patchSize->getPatchSizeF() : 1;
+
+   auto *arborList = connection->getComponentByType<ArborList>();
+   info.mNumArbors = arborList ? arborList->getNumAxonalArbors() : 1;
+
+   auto *sharedWeights = connection->getComponentByType<SharedWeights>();
+   info.mSharedWeights = sharedWeights ? sharedWeights->getSharedWeights() : false;
+
+   auto *deliveryFacade  = connection->getComponentByType<HyPerDeliveryFacade>();
+   info.mPostPerspective = deliveryFacade ? deliveryFacade->getUpdateGSynFromPostPerspective()
+                                          : false;
+
+   auto *weightsPair = connection->getComponentByType<WeightsPair>();
+   info.mOwnsWeights = weightsPair != nullptr
+                       and dynamic_cast<CloneWeightsPair *>(weightsPair) == nullptr;
+
+   auto *weightUpdater = connection->getComponentByType<BaseWeightUpdater>();
+   info.mPlastic       = weightUpdater ? weightUpdater->getPlasticityFlag() : false;
+
+   // A weight update period longer than a timestep spreads the learning cost over several steps.
+   // Updates driven by a trigger layer are assumed to happen every step.
+   info.mStepsPerUpdate = 1.0;
+   auto *hebbianUpdater = dynamic_cast<HebbianUpdater *>(weightUpdater);
+   if (hebbianUpdater != nullptr) {
+      char const *triggerLayerName = hebbianUpdater->getTriggerLayerName();
+      bool const triggered         = triggerLayerName != nullptr and triggerLayerName[0] != '\0';
+      double const period          = hebbianUpdater->getWeightUpdatePeriod();
+      if (!triggered and mDeltaTime > 0.0 and period > mDeltaTime) {
+         info.mStepsPerUpdate = period / mDeltaTime;
+      }
+   }
+   mConnections.push_back(info);
+}
+
+void CostModel::makeLocalLoc(LayerInfo const &layer, Decomposition const &d, PVLayerLoc *loc)
+      const {
+   loc->nxGlobal     = layer.mNxGlobal;
+   loc->nyGlobal     = layer.mNyGlobal;
+   loc->nbatchGlobal = layer.mNBatchGlobal;
+   loc->nx           = layer.mNxGlobal / d.mColumns;
+   loc->ny           = layer.mNyGlobal / d.mRows;
+   loc->nf           = layer.mNf;
+   loc->nbatch       = layer.mNBatchGlobal / d.mBatchWidth;
+   loc->kx0          = 0;
+   loc->ky0          = 0;
+   loc->kb0          = 0;
+   loc->halo         = layer.mHalo;
+}
+
+bool CostModel::isValid(Decomposition const &decomposition) const {
+   if (decomposition.mRows <= 0 or decomposition.mColumns <= 0
+       or decomposition.mBatchWidth <= 0) {
+      return false;
+   }
+   for (auto const &layer : mLayers) {
+      if (layer.mNxGlobal % decomposition.mColumns != 0
+          or layer.mNyGlobal % decomposition.mRows != 0
+          or layer.mNBatchGlobal % decomposition.mBatchWidth != 0) {
+         return false;
+      }
+      int const nx = layer.mNxGlobal / decomposition.mColumns;
+      int const ny = layer.mNyGlobal / decomposition.mRows;
+      if (decomposition.mColumns > 1 and nx < std::max(layer.mHalo.lt, layer.mHalo.rt)) {
+         return false;
+      }
+      if (decomposition.mRows > 1 and ny < std::max(layer.mHalo.dn, layer.mHalo.up)) {
+         return false;
+      }
+   }
+   return true;
+}
+
+CostModel::Estimate CostModel::estimateLayer(LayerInfo const &layer, Decomposition const &d) const {
+   PVLayerLoc loc;
+   makeLocalLoc(layer, d, &loc);
+   double const numRestricted = (double)(loc.nx * loc.ny * loc.nf);
+   double const numExtended   = (double)((loc.nx + loc.halo.lt + loc.halo.rt)
+                                       * (loc.ny + loc.halo.dn + loc.halo.up) * loc.nf);
+   double const nbatch        = (double)loc.nbatch;
+
+   Estimate estimate;
+   estimate.mName          = layer.mName;
+   estimate.mIsLayer       = true;
+   estimate.mFlops         = (double)(layer.mNumChannels + 3) * numRestricted * nbatch;
+   estimate.mLearningFlops = 0.0;
+
+   // V and GSyn are restricted; activity and each delay level of the data store are extended.
+   double const numFloats = numRestricted * (double)(1 + layer.mNumChannels)
+                            + numExtended * (double)(1 + layer.mNumDelayLevels);
+   estimate.mStateBytes = sizeof(float) * numFloats * nbatch;
+   if (layer.mSparse) {
+      // The data store keeps an index-value pair per active neuron for each delay level.
+      estimate.mStateBytes += (sizeof(int) + sizeof(float)) * numExtended
+                              * (double)layer.mNumDelayLevels * nbatch;
+   }
+
+   bool const exchangesBorders = d.mRows * d.mColumns > 1;
+   estimate.mExchangeBytes =
+         exchangesBorders ? sizeof(float) * (numExtended - numRestricted) * nbatch : 0.0;
+   estimate.mSeconds = numRestricted * nbatch / mNeuronUpdatesPerSecond
+                       + estimate.mExchangeBytes / mExchangeBytesPerSecond;
+   return estimate;
+}
+
+CostModel::Estimate
+CostModel::estimateConnection(ConnectionInfo const &conn, Decomposition const &d) const {
+   LayerInfo const &pre  = mLayers[conn.mPreIndex];
+   LayerInfo const &post = mLayers[conn.mPostIndex];
+   PVLayerLoc preLoc, postLoc;
+   makeLocalLoc(pre, d, &preLoc);
+   makeLocalLoc(post, d, &postLoc);
+   double const nbatch         = (double)postLoc.nbatch;
+   double const numPostNeurons = (double)(postLoc.nx * postLoc.ny * postLoc.nf);
+   double const numPreExtended = (double)((preLoc.nx + preLoc.halo.lt + preLoc.halo.rt)
+                                          * (preLoc.ny + preLoc.halo.dn + preLoc.halo.up)
+                                          * preLoc.nf);
+   double const patchSize = (double)(conn.mPatchSizeX * conn.mPatchSizeY * conn.mPatchSizeF);
+   double const numArbors = (double)conn.mNumArbors;
+
+   double synapses = numPostNeurons * nbatch;
+   if (conn.mHasPatch and conn.mPostPerspective) {
+      // The postsynaptic patch covers the presynaptic patch scaled by the ratio of the layers.
+      double const postPatchX =
+            (double)conn.mPatchSizeX * (double)pre.mNxGlobal / (double)post.mNxGlobal;
+      double const postPatchY =
+            (double)conn.mPatchSizeY * (double)pre.mNyGlobal / (double)post.mNyGlobal;
+      synapses = numPostNeurons * postPatchX * postPatchY * (double)pre.mNf * numArbors * nbatch;
+   }
+   else if (conn.mHasPatch) {
+      synapses = numPreExtended * patchSize * numArbors * nbatch;
+   }
+
+   Estimate estimate;
+   estimate.mName          = conn.mName;
+   estimate.mIsLayer       = false;
+   estimate.mFlops         = 2.0 * synapses;
+   estimate.mLearningFlops = 0.0;
+   estimate.mStateBytes    = 0.0;
+   estimate.mExchangeBytes = 0.0;
+   estimate.mSeconds       = synapses / mSynapsesPerSecond;
+
+   if (conn.mHasPatch and conn.mOwnsWeights) {
+      PatchGeometry geometry(
+            conn.mName, conn.mPatchSizeX, conn.mPatchSizeY, conn.mPatchSizeF, &preLoc, &postLoc);
+      double const numPatches = (double)geometry.getNumPatches();
+      double const numDataPatches =
+            conn.mSharedWeights ? (double)geometry.getNumKernels() : numPatches;
+      double const numWeights = numArbors * numDataPatches * patchSize;
+      double weightBytes      = sizeof(float) * numWeights;
+      if (conn.mSharedWeights) {
+         weightBytes += sizeof(int) * numPatches; // patch-to-data lookup table
+      }
+      estimate.mStateBytes += weightBytes;
+
+      if (conn.mPlastic) {
+         double const learningSynapses = numPreExtended * patchSize * numArbors * nbatch;
+         estimate.mLearningFlops = 2.0 * learningSynapses / conn.mStepsPerUpdate;
+         estimate.mSeconds += learningSynapses / conn.mStepsPerUpdate / mLearningSynapsesPerSecond;
+         estimate.mStateBytes += weightBytes;
+         if (conn.mSharedWeights) {
+            estimate.mStateBytes += sizeof(long) * numWeights; // kernel activation counts
+            if (d.mRows * d.mColumns * d.mBatchWidth > 1) {
+               estimate.mExchangeBytes = sizeof(float) * numWeights / conn.mStepsPerUpdate;
+               estimate.mSeconds += estimate.mExchangeBytes / mExchangeBytesPerSecond;
+            }
+         }
+      }
+   }
+   if (mNumThreads > 1 and !conn.mPostPerspective) {
+      // Presynaptic delivery gives each thread its own GSyn buffer.
+      estimate.mStateBytes += sizeof(float) * (double)mNumThreads * numPostNeurons;
+   }
+   return estimate;
+}
+
+std::vector<CostModel::Estimate> CostModel::estimate(Decomposition const &decomposition) const {
+   FatalIf(
+         !isValid(decomposition),
+         "CostModel: the layers do not divide into %d rows, %d columns and batch width %d.\n",
+         decomposition.mRows,
+         decomposition.mColumns,
+         decomposition.mBatchWidth);
+   std::vector<Estimate> estimates;
+   for (auto const &layer : mLayers) {
+      estimates.push_back(estimateLayer(layer, decomposition));
+   }
+   for (auto const &conn : mConnections) {
+      estimates.push_back(estimateConnection(conn, decomposition));
+   }
+   return estimates;
+}
+
+double CostModel::predictStepSeconds(Decomposition const &decomposition) const {
+   double seconds = 0.0;
+   for (auto const &e : estimate(decomposition)) {
+      seconds += e.mSeconds;
+   }
+   return seconds;
+}
+
+std::vector<CostModel::Decomposition>
+CostModel::suggestDecompositions(int numProcesses, int maxCount) const {
+   std::vector<RankedDecomposition> candidates;
+   for (int rows = 1; rows <= numProcesses; rows++) {
+      if (numProcesses % rows != 0) {
+         continue;
+      }
+      for (int columns = 1; columns <= numProcesses / rows; columns++) {
+         if ((numProcesses / rows) % columns != 0) {
+            continue;
+         }
+         Decomposition d{rows, columns, numProcesses / (rows * columns)};
+         if (isValid(d)) {
+            candidates.push_back({predictStepSeconds(d), d});
+         }
+      }
+   }
+   std::stable_sort(candidates.begin(), candidates.end(), compareRankedDecompositions);
+   std::vector<Decomposition> suggestions;
+   for (auto const &c : candidates) {
+      if ((int)suggestions.size() >= maxCount) {
+         break;
+      }
+      suggestions.push_back(c.mDecomposition);
+   }
+   return suggestions;
+}
+
+void CostModel::printReport(Decomposition const &current) const {
+   std::vector<Estimate> estimates = estimate(current);
+   double totalSeconds             = 0.0;
+   double totalBytes               = 0.0;
+   for (auto const &e : estimates) {
+      totalSeconds += e.mSeconds;
+      totalBytes += e.mStateBytes;
+   }
+   InfoLog().printf(
+         "Cost model for %d rows, %d columns, batch width %d, %d threads (%s rates):\n",
+         current.mRows,
+         current.mColumns,
+         current.mBatchWidth,
+         mNumThreads,
+         mCalibrated ? "calibrated" : "default");
+   InfoLog().printf(
+         "   predicted %.6g ms per timestep and %.3f MiB of state per process\n",
+         1.0e3 * totalSeconds,
+         totalBytes / 1048576.0);
+
+   std::stable_sort(estimates.begin(), estimates.end(), compareEstimateTimes);
+   InfoLog().printf("   time share, object, FLOPs, learning FLOPs, state, exchange bytes:\n");
+   for (auto const &e : estimates) {
+      InfoLog().printf(
+            "   %6.2f%%  %-10s \"%s\": %.4g, %.4g, %.3f MiB, %.4g\n",
+            totalSeconds > 0.0 ? 100.0 * e.mSeconds / totalSeconds : 0.0,
+            e.mIsLayer ? "layer" : "connection",
+            e.mName.c_str(),
+            e.mFlops,
+            e.mLearningFlops,
+            e.mStateBytes / 1048576.0,
+            e.mExchangeBytes);
+   }
+
+   int const numProcesses = current.mRows * current.mColumns * current.mBatchWidth;
+   InfoLog().printf("Suggested decompositions of %d processes:\n", numProcesses);
+   for (auto const &d : suggestDecompositions(numProcesses, 5)) {
+      double stateBytes = 0.0;
+      for (auto const &e : estimate(d)) {
+         stateBytes += e.mStateBytes;
+      }
+      InfoLog().printf(
+            "   -rows %d -columns %d -batchwidth %d: %.6g ms per timestep, %.3f MiB per process\n",
+            d.mRows,
+            d.mColumns,
+            d.mBatchWidth,
+            1.0e3 * predictStepSeconds(d),
+            stateBytes / 1048576.0);
+   }
+}
+
+} // namespace PV
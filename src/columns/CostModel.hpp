@@ -0,0 +1,154 @@
+#ifndef COSTMODEL_HPP_
+#define COSTMODEL_HPP_
+
+#include "include/PVLayerLoc.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+class BaseConnection;
+class HyPerLayer;
+class Observer;
+
+/**
+ * Predicts the cost of a timestep of a network from its layer and connection geometry, without
+ * allocating it. HyPerCol builds a CostModel after the CommunicateInitInfo stage when the
+ * dry-run flag is set, when the layer sizes, margins, delay levels and patch sizes are known.
+ *
+ * For each layer and connection, and for a given MPI decomposition into rows, columns and batch
+ * processes, the model estimates the work per timestep on one process:
+ * - FLOPs: two per synapse for delivery; for a layer, one per GSyn channel and three more per
+ *   neuron for the state update.
+ * - State bytes: for a layer, the membrane potential, the GSyn channels, the activity and the
+ *   data store; for a connection, the weights it owns, and for a plastic connection the weight
+ *   changes and, for shared weights, the kernel activation counts.
+ * - Exchange bytes: for a layer, the halo sent on each border exchange; for a plastic connection
+ *   with shared weights, the weight changes reduced across processes on each update.
+ * - Learning FLOPs: two per synapse of the weight update, averaged over the timesteps between
+ *   updates.
+ *
+ * Presynaptic delivery visits every extended presynaptic neuron, and postsynaptic delivery every
+ * restricted postsynaptic neuron, so the synapse counts assume dense activity and are an upper
+ * bound for sparse layers. Weight counts come from a PatchGeometry built with the local layer
+ * sizes of the decomposition, as the connection's own Weights would be.
+ *
+ * Times are the work divided by a rate. The default rates are rough per-thread figures
+ * multiplied by the number of threads. calibrate() replaces them with the throughputs that the
+ * pvbenchmarks suite measured on the target machine.
+ */
+class CostModel {
+  public:
+   struct Decomposition {
+      int mRows;
+      int mColumns;
+      int mBatchWidth;
+   };
+
+   struct Estimate {
+      std::string mName;
+      bool mIsLayer;
+      double mFlops;
+      double mLearningFlops;
+      double mStateBytes;
+      double mExchangeBytes;
+      double mSeconds;
+   };
+
+   CostModel(int numThreads, double deltaTime);
+
+   /**
+    * Reads a JSON file written by pvbenchmarks, and sets the rates from the median throughput
+    * of the ConvolveDelivery, HebbianUpdate and BorderExchange cases. Rates without a
+    * corresponding case keep their defaults.
+    */
+   void calibrate(std::string const &path);
+
+   /** Adds each layer and connection in the object map. Other objects are ignored. */
+   void addObjects(std::map<std::string, Observer *> const &objectMap);
+   void addLayer(HyPerLayer *layer);
+   void addConnection(BaseConnection *connection);
+
+   /**
+    * Returns true if every layer divides evenly among the rows, columns and batch processes of
+    * the decomposition, and each local layer is at least as wide and as tall as its margins.
+    */
+   bool isValid(Decomposition const &decomposition) const;
+
+   /**
+    * Returns the estimates for one process under the given decomposition, layers first and then
+    * connections, each in the order they were added.
+    */
+   std::vector<Estimate> estimate(Decomposition const &decomposition) const;
+
+   /** Returns the predicted time of a timestep, the sum of the times of the estimates. */
+   double predictStepSeconds(Decomposition const &decomposition) const;
+
+   /**
+    * Returns the valid decompositions of the given number of processes, fastest first, up to
+    * maxCount of them.
+    */
+   std::vector<Decomposition> suggestDecompositions(int numProcesses, int maxCount) const;
+
+   /**
+    * Prints the predicted step time and memory for the given decomposition, the objects ranked
+    * by predicted time, and the suggested decompositions of the same number of processes.
+    */
+   void printReport(Decomposition const &current) const;
+
+   double getSynapsesPerSecond() const { return mSynapsesPerSecond; }
+   double getNeuronUpdatesPerSecond() const { return mNeuronUpdatesPerSecond; }
+   double getLearningSynapsesPerSecond() const { return mLearningSynapsesPerSecond; }
+   double getExchangeBytesPerSecond() const { return mExchangeBytesPerSecond; }
+   bool isCalibrated() const { return mCalibrated; }
+
+  private:
+   struct LayerInfo {
+      std::string mName;
+      int mNxGlobal;
+      int mNyGlobal;
+      int mNf;
+      int mNBatchGlobal;
+      PVHalo mHalo;
+      int mNumChannels;
+      int mNumDelayLevels;
+      bool mSparse;
+   };
+
+   struct ConnectionInfo {
+      std::string mName;
+      int mPreIndex;
+      int mPostIndex;
+      bool mHasPatch; // false for connections that deliver one-to-one, such as IdentConn
+      int mPatchSizeX;
+      int mPatchSizeY;
+      int mPatchSizeF;
+      int mNumArbors;
+      bool mSharedWeights;
+      bool mPostPerspective;
+      bool mOwnsWeights;
+      bool mPlastic;
+      double mStepsPerUpdate;
+   };
+
+   void makeLocalLoc(LayerInfo const &layer, Decomposition const &d, PVLayerLoc *loc) const;
+   Estimate estimateLayer(LayerInfo const &layer, Decomposition const &d) const;
+   Estimate estimateConnection(ConnectionInfo const &conn, Decomposition const &d) const;
+
+  private:
+   int mNumThreads;
+   double mDeltaTime;
+   double mSynapsesPerSecond;
+   double mNeuronUpdatesPerSecond;
+   double mLearningSynapsesPerSecond;
+   double mExchangeBytesPerSecond;
+   bool mCalibrated = false;
+   std::vector<LayerInfo> mLayers;
+   std::vector<ConnectionInfo> mConnections;
+   std::map<std::string, int> mLayerIndices;
+};
+
+} // namespace PV
+
+#endif // COSTMODEL_HPP_
@@ -47,12 +47,66 @@ void DataStore::updateActiveIndices(int bufferId, int level) {
    if (!mSparseFlag) {
       return;
    }
-   int numActive   = 0;
-   float *activity = buffer(bufferId, level);
+   float *activity                         = buffer(bufferId, level);
+   SparseList<float>::Entry *activeIndices = activeIndicesBuffer(bufferId, level);
+
+   int numActive = appendActiveIndices(activity, 0, getNumItems(), activeIndices, 0);
+
+   long *numActiveBuf = numActiveBuffer(bufferId, level);
+   *numActiveBuf      = numActive;
+}
 
+void DataStore::updateActiveIndices(
+      int bufferId,
+      int level,
+      PVLayerLoc const &loc,
+      SparseList<float>::Entry const *rowEntries,
+      int const *rowCounts) {
+   if (!mSparseFlag) {
+      return;
+   }
+   PVHalo const &halo        = loc.halo;
+   int const rowSize         = loc.nx * loc.nf;
+   int const extendedRowSize = (loc.nx + halo.lt + halo.rt) * loc.nf;
+   pvAssert(extendedRowSize * (loc.ny + halo.dn + halo.up) == getNumItems());
+
+   float *activity                         = buffer(bufferId, level);
    SparseList<float>::Entry *activeIndices = activeIndicesBuffer(bufferId, level);
-   //   unsigned int *activeIndices = activeIndicesBuffer(bufferId, level);
-   for (int kex = 0; kex < getNumItems(); kex++) {
+
+   // The rows of the top margin, then each restricted row between its left and right margins,
+   // then the rows of the bottom margin, so that the indices are in increasing order.
+   int numActive = appendActiveIndices(activity, 0, halo.up * extendedRowSize, activeIndices, 0);
+   for (int y = 0; y < loc.ny; y++) {
+      int const rowStart   = (y + halo.up) * extendedRowSize;
+      int const rowEnd     = rowStart + extendedRowSize;
+      int const leftEnd    = rowStart + halo.lt * loc.nf;
+      int const rightStart = leftEnd + rowSize;
+
+      numActive = appendActiveIndices(activity, rowStart, leftEnd, activeIndices, numActive);
+
+      int const row                           = bufferId * loc.ny + y;
+      SparseList<float>::Entry const *entries = &rowEntries[row * rowSize];
+      int const count                         = rowCounts[row];
+      std::memcpy(&activeIndices[numActive], entries, sizeof(*entries) * (std::size_t)count);
+      numActive += count;
+
+      numActive = appendActiveIndices(activity, rightStart, rowEnd, activeIndices, numActive);
+   }
+   int const bottomStart = (halo.up + loc.ny) * extendedRowSize;
+
+   numActive = appendActiveIndices(activity, bottomStart, getNumItems(), activeIndices, numActive);
+
+   long *numActiveBuf = numActiveBuffer(bufferId, level);
+   *numActiveBuf      = numActive;
+}
+
+int DataStore::appendActiveIndices(
+      float const *activity,
+      int begin,
+      int end,
+      SparseList<float>::Entry *activeIndices,
+      int numActive) {
+   for (int kex = begin; kex < end; kex++) {
       float a = activity[kex];
       if (a != 0.0f) {
          activeIndices[numActive].index = kex;
@@ -60,9 +114,7 @@ void DataStore::updateActiveIndices(int bufferId, int level) {
          numActive++;
       }
    }
-
-   long *numActiveBuf = numActiveBuffer(bufferId, level);
-   *numActiveBuf      = numActive;
+   return numActive;
 }
 
 PVLayerCube DataStore::createCube(PVLayerLoc const &loc, int delay) {
@@ -81,4 +133,16 @@ PVLayerCube DataStore::createCube(PVLayerLoc const &loc, int delay) {
    return cube;
 }
 
+std::size_t DataStore::getMemorySize() const {
+   std::size_t const numLevels  = (std::size_t)mNumLevels;
+   std::size_t const numBuffers = (std::size_t)mNumBuffers;
+   std::size_t const numItems   = (std::size_t)mNumItems;
+
+   std::size_t size = numLevels * numBuffers * (numItems * sizeof(float) + sizeof(double));
+   if (mSparseFlag) {
+      size += numLevels * numBuffers * (numItems * sizeof(SparseList<float>::Entry) + sizeof(long));
+   }
+   return size;
+}
+
 } // end namespace PV
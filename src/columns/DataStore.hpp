@@ -81,6 +81,20 @@ class DataStore {
 
    void updateActiveIndices(int bufferId, int level);
 
+   /**
+    * Sets the active indices of the given buffer and level to the same list as
+    * updateActiveIndices(bufferId, level), using lists of the nonzero values in the restricted
+    * region that the layer made when it computed the buffer. Only the margins of the buffer are
+    * scanned. The entries of restricted row y of batch element b start at rowEntries[(b * loc.ny
+    * + y) * loc.nx * loc.nf], and there are rowCounts[b * loc.ny + y] of them, in increasing order.
+    */
+   void updateActiveIndices(
+         int bufferId,
+         int level,
+         PVLayerLoc const &loc,
+         SparseList<float>::Entry const *rowEntries,
+         int const *rowCounts);
+
    int getNumItems() const { return mNumItems; }
 
    /**
@@ -90,6 +104,24 @@ class DataStore {
     */
    PVLayerCube createCube(PVLayerLoc const &loc, int delay);
 
+   /**
+    * Returns the number of bytes held by the ring buffers: the data, the update times and, for
+    * a sparse data store, the active indices.
+    */
+   std::size_t getMemorySize() const;
+
+  private:
+   /**
+    * Appends the nonzero values of activity[begin] through activity[end - 1] to activeIndices,
+    * starting at index numActive, and returns the new number of active indices.
+    */
+   static int appendActiveIndices(
+         float const *activity,
+         int begin,
+         int end,
+         SparseList<float>::Entry *activeIndices,
+         int numActive);
+
   private:
    int mNumItems;
    int mCurrentLevel;
@@ -0,0 +1,212 @@
+#include "DecompositionSearch.hpp"
+#include "utils/PVLog.hpp"
+#include "utils/conversions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace PV {
+
+namespace {
+
+// The cost of receiving one halo value, in units of the cost of updating one neuron.
+double const haloValueWeight = 4.0;
+
+bool isPowerOfTwo(int n) { return n > 0 and (n & (n - 1)) == 0; }
+
+// The margin that requiredConvolveMargin() would give, or zero if the layer sizes and patch size
+// are not a combination that a connection accepts.
+int convolveMargin(int nPre, int nPost, int patchSize) {
+   if (nPre <= 0 or nPost <= 0 or patchSize <= 0) {
+      return 0;
+   }
+   if (nPre == nPost) {
+      return patchSize % 2 == 1 ? requiredConvolveMargin(nPre, nPost, patchSize) : 0;
+   }
+   if (nPre > nPost) {
+      bool const valid = nPre % nPost == 0 and isPowerOfTwo(nPre / nPost);
+      return valid ? requiredConvolveMargin(nPre, nPost, patchSize) : 0;
+   }
+   bool const valid = nPost % nPre == 0 and isPowerOfTwo(nPost / nPre)
+                      and patchSize % (nPost / nPre) == 0;
+   return valid ? requiredConvolveMargin(nPre, nPost, patchSize) : 0;
+}
+
+bool compareCandidates(
+      DecompositionSearch::Candidate const &a,
+      DecompositionSearch::Candidate const &b) {
+   if (a.mScore != b.mScore) {
+      return a.mScore < b.mScore;
+   }
+   if (a.mBatchWidth != b.mBatchWidth) {
+      return a.mBatchWidth > b.mBatchWidth;
+   }
+   int const aAspect = std::abs(a.mRows - a.mColumns);
+   int const bAspect = std::abs(b.mRows - b.mColumns);
+   if (aAspect != bAspect) {
+      return aAspect < bAspect;
+   }
+   return a.mRows < b.mRows;
+}
+
+} // namespace
+
+DecompositionSearch::DecompositionSearch(int numProcesses) : mNumProcesses(numProcesses) {}
+
+void DecompositionSearch::addLayer(std::string const &name, int nxGlobal, int nyGlobal, int nf) {
+   Layer &layer    = mLayers[name];
+   layer.mNxGlobal = nxGlobal;
+   layer.mNyGlobal = nyGlobal;
+   layer.mNf       = nf;
+}
+
+void DecompositionSearch::requireMargins(std::string const &name, int marginX, int marginY) {
+   auto found = mLayers.find(name);
+   FatalIf(found == mLayers.end(), "DecompositionSearch has no layer \"%s\".\n", name.c_str());
+   found->second.mMarginX = std::max(found->second.mMarginX, marginX);
+   found->second.mMarginY = std::max(found->second.mMarginY, marginY);
+}
+
+void DecompositionSearch::setCheckpointCellSize(int rows, int columns, int batchDimension) {
+   mCellRows           = rows;
+   mCellColumns        = columns;
+   mCellBatchDimension = batchDimension;
+}
+
+void DecompositionSearch::addParams(PVParams *params) {
+   char const *columnName = nullptr;
+   int const numGroups    = params->numberOfGroups();
+   for (int g = 0; g < numGroups; g++) {
+      if (!std::strcmp(params->groupKeywordFromIndex(g), "HyPerCol")) {
+         columnName = params->groupNameFromIndex(g);
+         break;
+      }
+   }
+   if (columnName == nullptr) {
+      return;
+   }
+   double const nx = params->value(columnName, "nx", 0.0, false);
+   double const ny = params->value(columnName, "ny", 0.0, false);
+   setBatchSize((int)params->value(columnName, "nbatch", 1.0, false));
+
+   // A group is a layer if it has a layer's scale parameters, or if a connection names it.
+   std::vector<std::string> layerNames;
+   for (int g = 0; g < numGroups; g++) {
+      char const *name = params->groupNameFromIndex(g);
+      if (params->present(name, "nxScale") or params->present(name, "nyScale")) {
+         layerNames.emplace_back(name);
+      }
+      else if (
+            params->stringPresent(name, "preLayerName")
+            and params->stringPresent(name, "postLayerName")) {
+         layerNames.emplace_back(params->stringValue(name, "preLayerName", false));
+         layerNames.emplace_back(params->stringValue(name, "postLayerName", false));
+      }
+   }
+   for (auto const &name : layerNames) {
+      if (mLayers.find(name) != mLayers.end() or params->group(name.c_str()) == nullptr) {
+         continue;
+      }
+      double const nxScale = params->value(name.c_str(), "nxScale", 1.0, false);
+      double const nyScale = params->value(name.c_str(), "nyScale", 1.0, false);
+      int const nf         = (int)params->value(name.c_str(), "nf", 1.0, false);
+      addLayer(name, (int)std::nearbyint(nx * nxScale), (int)std::nearbyint(ny * nyScale), nf);
+   }
+
+   for (int g = 0; g < numGroups; g++) {
+      char const *name = params->groupNameFromIndex(g);
+      if (!params->stringPresent(name, "preLayerName")
+          or !params->stringPresent(name, "postLayerName")) {
+         continue;
+      }
+      auto pre  = mLayers.find(std::string(params->stringValue(name, "preLayerName", false)));
+      auto post = mLayers.find(std::string(params->stringValue(name, "postLayerName", false)));
+      if (pre == mLayers.end() or post == mLayers.end()) {
+         continue;
+      }
+      int const nxp     = (int)params->value(name, "nxp", 1.0, false);
+      int const nyp     = (int)params->value(name, "nyp", 1.0, false);
+      int const marginX = convolveMargin(pre->second.mNxGlobal, post->second.mNxGlobal, nxp);
+      int const marginY = convolveMargin(pre->second.mNyGlobal, post->second.mNyGlobal, nyp);
+      requireMargins(pre->first, marginX, marginY);
+   }
+}
+
+bool DecompositionSearch::evaluate(
+      int rows,
+      int columns,
+      int batchWidth,
+      Candidate *candidate) const {
+   if (rows * columns * batchWidth != mNumProcesses or mBatchSize % batchWidth != 0) {
+      return false;
+   }
+   if ((mCellRows > 0 and rows % mCellRows != 0)
+       or (mCellColumns > 0 and columns % mCellColumns != 0)
+       or (mCellBatchDimension > 0 and batchWidth % mCellBatchDimension != 0)) {
+      return false;
+   }
+   double const localBatch = (double)(mBatchSize / batchWidth);
+   double work             = 0.0;
+   double halo             = 0.0;
+   for (auto const &l : mLayers) {
+      Layer const &layer = l.second;
+      if (layer.mNxGlobal % columns != 0 or layer.mNyGlobal % rows != 0) {
+         return false;
+      }
+      int const nx = layer.mNxGlobal / columns;
+      int const ny = layer.mNyGlobal / rows;
+      if ((columns > 1 and nx < layer.mMarginX) or (rows > 1 and ny < layer.mMarginY)) {
+         return false;
+      }
+      int const marginX       = columns > 1 ? layer.mMarginX : 0;
+      int const marginY       = rows > 1 ? layer.mMarginY : 0;
+      double const restricted = (double)nx * (double)ny * (double)layer.mNf;
+      double const extended =
+            (double)(nx + 2 * marginX) * (double)(ny + 2 * marginY) * (double)layer.mNf;
+      work += restricted * localBatch;
+      halo += (extended - restricted) * localBatch;
+   }
+   candidate->mRows       = rows;
+   candidate->mColumns    = columns;
+   candidate->mBatchWidth = batchWidth;
+   candidate->mWork       = work;
+   candidate->mHalo       = halo;
+   candidate->mScore      = work + haloValueWeight * halo;
+   return true;
+}
+
+std::vector<DecompositionSearch::Candidate> DecompositionSearch::search() const {
+   std::vector<Candidate> candidates;
+   for (int batchWidth = 1; batchWidth <= mNumProcesses; batchWidth++) {
+      if (mNumProcesses % batchWidth != 0) {
+         continue;
+      }
+      int const blockSize = mNumProcesses / batchWidth;
+      for (int rows = 1; rows <= blockSize; rows++) {
+         if (blockSize % rows != 0) {
+            continue;
+         }
+         Candidate candidate;
+         if (evaluate(rows, blockSize / rows, batchWidth, &candidate)) {
+            candidates.push_back(candidate);
+         }
+      }
+   }
+   std::sort(candidates.begin(), candidates.end(), compareCandidates);
+   return candidates;
+}
+
+DecompositionSearch::Candidate DecompositionSearch::findBest() const {
+   std::vector<Candidate> candidates = search();
+   FatalIf(
+         candidates.empty(),
+         "No decomposition that uses all %d processes divides every layer and the batch of %d "
+         "evenly.\n",
+         mNumProcesses,
+         mBatchSize);
+   return candidates.front();
+}
+
+} // namespace PV
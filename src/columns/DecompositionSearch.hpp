@@ -0,0 +1,93 @@
+#ifndef DECOMPOSITIONSEARCH_HPP_
+#define DECOMPOSITIONSEARCH_HPP_
+
+#include "io/PVParams.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * Chooses how to divide a network among MPI processes: the number of rows, columns and batch
+ * processes that Communicator uses when the AutoDecomposition flag is set.
+ *
+ * Each candidate decomposition that uses exactly the available number of processes, so that no
+ * rank is left idle, divides every layer and the batch evenly, and leaves each local layer at
+ * least as wide and as tall as its margins, is scored by the cost of one process's timestep:
+ * - its work, the number of restricted neurons it updates summed over its layers and batch
+ *   elements, and
+ * - its halo surface, the number of margin values it receives on each border exchange. A process
+ *   only exchanges the x-margins with other processes if there is more than one column, and the
+ *   y-margins if there is more than one row.
+ * A halo value is weighted as several neuron updates, since it crosses the network. The
+ * candidate with the lowest score is best; ties go to the wider batch, and then to the squarer
+ * grid.
+ *
+ * The layer shapes can be read from a params file with addParams(), before any layers exist: the
+ * HyPerCol group gives nx, ny and nbatch, each layer its nxScale, nyScale and nf, and each
+ * connection with explicit preLayerName and postLayerName its nxp and nyp, from which the margin
+ * it requires of its presynaptic layer follows.
+ */
+class DecompositionSearch {
+  public:
+   struct Candidate {
+      int mRows;
+      int mColumns;
+      int mBatchWidth;
+      double mWork; // neuron updates per process
+      double mHalo; // halo values received per process on each border exchange
+      double mScore;
+   };
+
+   DecompositionSearch(int numProcesses);
+
+   /**
+    * Adds a layer with the given global size, or, if a layer with the same name has been added,
+    * updates its size. The margins of a layer added this way start at zero.
+    */
+   void addLayer(std::string const &name, int nxGlobal, int nyGlobal, int nf);
+
+   /** Makes the margins of the named layer at least the given widths. */
+   void requireMargins(std::string const &name, int marginX, int marginY);
+
+   void setBatchSize(int nbatch) { mBatchSize = nbatch; }
+
+   /**
+    * Restricts the candidates to those that the checkpoint cells of the given size divide
+    * evenly. A size of zero or less leaves the corresponding dimension unrestricted.
+    */
+   void setCheckpointCellSize(int rows, int columns, int batchDimension);
+
+   /** Adds the layers, margins and batch size described by the params. */
+   void addParams(PVParams *params);
+
+   /** Returns the valid candidates, best first. */
+   std::vector<Candidate> search() const;
+
+   /** Returns the best candidate. If none is valid, exits with an error. */
+   Candidate findBest() const;
+
+  private:
+   struct Layer {
+      int mNxGlobal;
+      int mNyGlobal;
+      int mNf;
+      int mMarginX;
+      int mMarginY;
+   };
+
+   bool evaluate(int rows, int columns, int batchWidth, Candidate *candidate) const;
+
+  private:
+   int mNumProcesses;
+   int mBatchSize          = 1;
+   int mCellRows           = 0;
+   int mCellColumns        = 0;
+   int mCellBatchDimension = 0;
+   std::map<std::string, Layer> mLayers;
+};
+
+} // namespace PV
+
+#endif // DECOMPOSITIONSEARCH_HPP_
@@ -11,12 +11,19 @@
 #include "HyPerCol.hpp"
 #include "columns/Communicator.hpp"
 #include "columns/Factory.hpp"
+#include "columns/InferenceServer.hpp"
 #include "columns/RandomSeed.hpp"
+#include "connections/BaseConnection.hpp"
 #include "io/PrintStream.hpp"
 #include "io/io.hpp"
+#include "layers/HyPerLayer.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "pvGitRevision.h"
+#include "utils/Tracer.hpp"
 
+#include <algorithm>
 #include <assert.h>
+#include <cctype>
 #include <cmath>
 #include <csignal>
 #include <float.h>
@@ -66,8 +73,10 @@ HyPerCol::~HyPerCol() {
    }
 
    delete mRunTimer;
+   delete mCostModel;
    // TODO: Change these old C strings into std::string
    free(mPrintParamsFilename);
+   free(mRandomGeneratorString);
    free(mName);
 }
 
@@ -110,6 +119,7 @@ int HyPerCol::initialize_base() {
 }
 
 int HyPerCol::initialize(PV_Init *initObj) {
+   mStartupLap   = std::chrono::steady_clock::now();
    mPVInitObj    = initObj;
    mCommunicator = mPVInitObj->getCommunicator();
    mParams       = mPVInitObj->getParams();
@@ -183,6 +193,7 @@ int HyPerCol::initialize(PV_Init *initObj) {
    mNextProgressTime = 0.0;
 
    RandomSeed::instance()->initialize(mRandomSeed);
+   RandomSeed::instance()->setGenerator(mRandomGenerator);
    if (getCommunicator()->globalCommRank() == 0) {
       InfoLog() << "RandomSeed initialized to " << mRandomSeed << ".\n";
    }
@@ -225,6 +236,7 @@ int HyPerCol::initialize(PV_Init *initObj) {
          addObject(addedObject);
       }
    } // for-loop over parameter groups
+   mConstructionTime = lapStartupTimer();
    return PV_SUCCESS;
 }
 
@@ -260,10 +272,12 @@ int HyPerCol::ioParamsFillGroup(enum ParamsIOFlag ioFlag) {
    mCheckpointer->ioParams(ioFlag, parameters());
    ioParam_printParamsFilename(ioFlag);
    ioParam_randomSeed(ioFlag);
+   ioParam_randomGenerator(ioFlag);
    ioParam_nx(ioFlag);
    ioParam_ny(ioFlag);
    ioParam_nBatch(ioFlag);
    ioParam_errorOnNotANumber(ioFlag);
+   ioParam_memoryBudget(ioFlag);
 
    return PV_SUCCESS;
 }
@@ -333,6 +347,28 @@ void HyPerCol::ioParam_randomSeed(enum ParamsIOFlag ioFlag) {
    }
 }
 
+void HyPerCol::ioParam_randomGenerator(enum ParamsIOFlag ioFlag) {
+   parameters()->ioParamString(
+         ioFlag, mName, "randomGenerator", &mRandomGeneratorString, "tausworthe");
+   if (ioFlag == PARAMS_IO_READ) {
+      std::string generator(mRandomGeneratorString ? mRandomGeneratorString : "");
+      std::transform(generator.begin(), generator.end(), generator.begin(), ::tolower);
+      if (generator == "tausworthe") {
+         mRandomGenerator = RandomSeed::TAUSWORTHE;
+      }
+      else if (generator == "philox") {
+         mRandomGenerator = RandomSeed::PHILOX;
+      }
+      else {
+         Fatal().printf(
+               "%s: randomGenerator \"%s\" is unrecognized. "
+               "Allowed values are \"tausworthe\" and \"philox\".\n",
+               mName,
+               generator.c_str());
+      }
+   }
+}
+
 void HyPerCol::ioParam_nx(enum ParamsIOFlag ioFlag) {
    parameters()->ioParamValueRequired(ioFlag, mName, "nx", &mNumXGlobal);
 }
@@ -359,33 +395,22 @@ void HyPerCol::ioParam_errorOnNotANumber(enum ParamsIOFlag ioFlag) {
          ioFlag, mName, "errorOnNotANumber", &mErrorOnNotANumber, mErrorOnNotANumber);
 }
 
+void HyPerCol::ioParam_memoryBudget(enum ParamsIOFlag ioFlag) {
+   parameters()->ioParamValue(ioFlag, mName, "memoryBudget", &mMemoryBudget, mMemoryBudget);
+   if (ioFlag == PARAMS_IO_READ) {
+      FatalIf(mMemoryBudget < 0.0, "%s: memoryBudget cannot be negative.\n", mName);
+      MemoryTracker::instance()->setBudget((std::size_t)(mMemoryBudget * 1048576.0));
+   }
+}
+
 void HyPerCol::allocateColumn() {
    if (mReadyFlag) {
       return;
    }
 
-   setNumThreads(false);
-   // When we call processParams, the communicateInitInfo stage will run, which
-   // can put out a lot of messages.
-   // So if there's a problem with the -t option setting, the error message can
-   // be hard to find.
-   // Instead of printing the error messages here, we will call setNumThreads a
-   // second time after processParams(), and only then print messages.
-
-   // processParams function does communicateInitInfo stage, sets up adaptive
-   // time step, and prints params
-   pvAssert(mPrintParamsFilename && mPrintParamsFilename[0]);
-   if (mPrintParamsFilename[0] != '/') {
-      std::string printParamsFilename(mPrintParamsFilename);
-      std::string printParamsPath = mCheckpointer->makeOutputPathFilename(printParamsFilename);
-      processParams(printParamsPath.c_str());
-   }
-   else {
-      // If using absolute path, only global rank 0 writes, to avoid collisions.
-      if (mCheckpointer->getMPIBlock()->getGlobalRank() == 0) {
-         processParams(mPrintParamsFilename);
-      }
-   }
+   mStartupLap = std::chrono::steady_clock::now();
+   communicateColumn();
+   mCommunicateTime = lapStartupTimer();
 
 #ifdef PV_USE_CUDA
    // Needs to go between CommunicateInitInfo (called by processParams) and
@@ -396,34 +421,27 @@ void HyPerCol::allocateColumn() {
    initializeCUDA(gpu_devices);
 #endif
 
-   int thread_status =
-         setNumThreads(true /*now, print messages related to setting number of threads*/);
-   MPI_Barrier(mCommunicator->globalCommunicator());
-   if (thread_status != PV_SUCCESS) {
-      exit(EXIT_FAILURE);
-   }
-
-#ifdef PV_USE_OPENMP_THREADS
-   pvAssert(mNumThreads > 0); // setNumThreads should fail if it sets
-   // mNumThreads less than or equal to zero
-   omp_set_num_threads(mNumThreads);
-#endif // PV_USE_OPENMP_THREADS
-
    notifyLoop(std::make_shared<AllocateDataMessage>());
+   printMemoryReport();
 
    notifyLoop(std::make_shared<LayerSetMaxPhaseMessage>(&mNumPhases));
    mNumPhases++;
 
    mPhaseRecvTimers.clear();
+   mPhaseTraceNames.clear();
    for (int phase = 0; phase < mNumPhases; phase++) {
       std::string timerTypeString("phRecv");
       timerTypeString.append(std::to_string(phase));
       Timer *phaseRecvTimer = new Timer(mName, "column", timerTypeString.c_str());
       mPhaseRecvTimers.push_back(phaseRecvTimer);
       mCheckpointer->registerTimer(phaseRecvTimer);
+      std::string phaseTraceName("phase ");
+      phaseTraceName.append(std::to_string(phase));
+      mPhaseTraceNames.push_back(Tracer::instance()->internName(phaseTraceName));
    }
 
    notifyLoop(std::make_shared<RegisterDataMessage<Checkpointer>>(mCheckpointer));
+   mAllocateTime = lapStartupTimer();
 
 #ifdef DEBUG_OUTPUT
    InfoLog().printf("[%d]: HyPerCol: running...\n", mCommunicator->globalCommRank());
@@ -468,37 +486,157 @@ void HyPerCol::allocateColumn() {
          notifyLoop(std::make_shared<LayerOutputStateMessage>(phase, mSimTime));
       }
    }
+   mInitializeTime = lapStartupTimer();
+   printStartupReport();
    mReadyFlag = true;
 }
 
+void HyPerCol::communicateColumn() {
+   setNumThreads(false);
+   // When we call processParams, the communicateInitInfo stage will run, which
+   // can put out a lot of messages.
+   // So if there's a problem with the -t option setting, the error message can
+   // be hard to find.
+   // Instead of printing the error messages here, we will call setNumThreads a
+   // second time after processParams(), and only then print messages.
+
+   // processParams function does communicateInitInfo stage, sets up adaptive
+   // time step, and prints params
+   pvAssert(mPrintParamsFilename && mPrintParamsFilename[0]);
+   if (mPrintParamsFilename[0] != '/') {
+      std::string printParamsFilename(mPrintParamsFilename);
+      std::string printParamsPath = mCheckpointer->makeOutputPathFilename(printParamsFilename);
+      processParams(printParamsPath.c_str());
+   }
+   else {
+      // If using absolute path, only global rank 0 writes, to avoid collisions.
+      if (mCheckpointer->getMPIBlock()->getGlobalRank() == 0) {
+         processParams(mPrintParamsFilename);
+      }
+   }
+
+   int thread_status =
+         setNumThreads(true /*now, print messages related to setting number of threads*/);
+   MPI_Barrier(mCommunicator->globalCommunicator());
+   if (thread_status != PV_SUCCESS) {
+      exit(EXIT_FAILURE);
+   }
+
+#ifdef PV_USE_OPENMP_THREADS
+   pvAssert(mNumThreads > 0); // setNumThreads should fail if it sets
+   // mNumThreads less than or equal to zero
+   omp_set_num_threads(mNumThreads);
+#endif // PV_USE_OPENMP_THREADS
+}
+
+void HyPerCol::estimateColumn() {
+   communicateColumn();
+
+   delete mCostModel;
+   mCostModel = new CostModel(mNumThreads, mDeltaTime);
+   std::string const &calibrationFile = mPVInitObj->getStringArgument("CostCalibration");
+   if (!calibrationFile.empty()) {
+      mCostModel->calibrate(expandLeadingTilde(calibrationFile));
+   }
+   mCostModel->addObjects(mObjectHierarchy.getObjectMap());
+   if (globalRank() == 0) {
+      CostModel::Decomposition const current{
+            mCommunicator->numCommRows(),
+            mCommunicator->numCommColumns(),
+            mCommunicator->numCommBatches()};
+      mCostModel->printReport(current);
+   }
+}
+
+void HyPerCol::printMemoryReport() {
+   MemoryTracker *memoryTracker = MemoryTracker::instance();
+   double maxTrackedBytes       = (double)memoryTracker->getCurrentBytes();
+   MPI_Comm const globalComm    = mCommunicator->globalCommunicator();
+   MPI_Allreduce(MPI_IN_PLACE, &maxTrackedBytes, 1, MPI_DOUBLE, MPI_MAX, globalComm);
+   if (globalRank() == 0) {
+      InfoLog().printf("%s", memoryTracker->formatReport().c_str());
+      if (mCommunicator->globalCommSize() > 1) {
+         InfoLog().printf(
+               "   (process 0 shown; largest total over %d processes %.3f MiB)\n",
+               mCommunicator->globalCommSize(),
+               maxTrackedBytes / 1048576.0);
+      }
+   }
+}
+
+double HyPerCol::lapStartupTimer() {
+   auto const now   = std::chrono::steady_clock::now();
+   double const lap = std::chrono::duration<double>(now - mStartupLap).count();
+   mStartupLap      = now;
+   return lap;
+}
+
+void HyPerCol::printStartupReport() {
+   double times[5] = {mConstructionTime,
+                      mCommunicateTime,
+                      mAllocateTime,
+                      mInitializeTime,
+                      mConstructionTime + mCommunicateTime + mAllocateTime + mInitializeTime};
+   MPI_Comm const globalComm = mCommunicator->globalCommunicator();
+   MPI_Allreduce(MPI_IN_PLACE, times, 5, MPI_DOUBLE, MPI_MAX, globalComm);
+   mTimeToFirstStep = times[4];
+   if (globalRank() == 0) {
+      InfoLog().printf(
+            "Time to first step: %.3f s (construction %.3f s, communicateInitInfo %.3f s, "
+            "allocateDataStructures %.3f s, initializeState %.3f s)\n",
+            times[4],
+            times[0],
+            times[1],
+            times[2],
+            times[3]);
+   }
+}
+
 // typically called by buildandrun via HyPerCol::run()
 int HyPerCol::run(double stopTime, double dt) {
    mStopTime  = stopTime;
    mDeltaTime = dt;
 
-   allocateColumn();
-   getOutputStream().flush();
-
    bool dryRunFlag = mPVInitObj->getBooleanArgument("DryRun");
    if (dryRunFlag) {
+      estimateColumn();
+      getOutputStream().flush();
       return PV_SUCCESS;
    }
 
+   allocateColumn();
+   getOutputStream().flush();
+
 #ifdef TIMER_ON
    Clock runClock;
    runClock.start_clock();
 #endif
 
-   advanceTimeLoop(runClock, 10 /*runClockStartingStep*/);
+   std::string const &traceFile = mPVInitObj->getStringArgument("TraceFile");
+   if (!traceFile.empty()) {
+      Tracer::instance()->enable();
+   }
 
-   notifyLoop(std::make_shared<CleanupMessage>());
+   std::string const &serveSocket          = mPVInitObj->getStringArgument("Serve");
+   Configuration::IntOptional benchmarkArg = mPVInitObj->getIntOptionalArgument("Benchmark");
+   if (!serveSocket.empty()) {
+      runServer(serveSocket);
+   }
+   else if (benchmarkArg.mUseDefault or benchmarkArg.mValue >= 0) {
+      int const numWarmupSteps = benchmarkArg.mUseDefault ? 10 : benchmarkArg.mValue;
+      runBenchmark(numWarmupSteps, mPVInitObj->getBooleanArgument("BenchmarkQuiet"));
+   }
+   else {
+      advanceTimeLoop(runClock, 10 /*runClockStartingStep*/);
+   }
 
-#ifdef DEBUG_OUTPUT
-   InfoLog().printf("[%d]: HyPerCol: done...\n", mCommunicator->globalCommRank());
-   InfoLog().flush();
-#endif
+   finishRun();
 
-   mCheckpointer->finalCheckpoint(mSimTime);
+   if (!traceFile.empty()) {
+      Tracer::instance()->disable();
+      Tracer::instance()->writeChromeTrace(
+            expandLeadingTilde(traceFile), mCommunicator->globalCommunicator());
+   }
 
 #ifdef TIMER_ON
    runClock.stop_clock();
@@ -510,6 +648,25 @@ int HyPerCol::run(double stopTime, double dt) {
    return PV_SUCCESS;
 }
 
+void HyPerCol::advanceSteps(int numSteps) {
+   allocateColumn();
+   for (int step = 0; step < numSteps; step++) {
+      mCheckpointer->checkpointWrite(mSimTime);
+      advanceTime(mSimTime);
+   }
+}
+
+void HyPerCol::finishRun() {
+   notifyLoop(std::make_shared<CleanupMessage>());
+
+#ifdef DEBUG_OUTPUT
+   InfoLog().printf("[%d]: HyPerCol: done...\n", mCommunicator->globalCommRank());
+   InfoLog().flush();
+#endif
+
+   mCheckpointer->finalCheckpoint(mSimTime);
+}
+
 // This routine sets the mNumThreads member variable.  It should only be called
 // by the run() method,
 // and only inside the !ready if-statement.
@@ -640,6 +797,62 @@ void HyPerCol::advanceTimeLoop(Clock &runClock, int const runClockStartingStep)
    } // end time loop
 }
 
+void HyPerCol::runBenchmark(int numWarmupSteps, bool suppressOutput) {
+   long int step = 0;
+   while (step < (long int)numWarmupSteps and mSimTime < mStopTime - mDeltaTime / 2.0) {
+      mCheckpointer->checkpointWrite(mSimTime);
+      advanceTime(mSimTime);
+      step += 1;
+   }
+   FatalIf(
+         mSimTime >= mStopTime - mDeltaTime / 2.0,
+         "%s: benchmark run has no timesteps left after %d warm-up steps.\n",
+         getDescription_c(),
+         numWarmupSteps);
+
+   mBenchmarkReport = new BenchmarkReport(
+         mNumPhases, mNumThreads, mCommunicator->globalCommunicator());
+   for (auto &obj : mObjectHierarchy.getObjectMap()) {
+      auto *layer = dynamic_cast<HyPerLayer *>(obj.second);
+      if (layer != nullptr) {
+         mBenchmarkReport->addLayerCounters(layer->getPhase(), layer->getMetrics());
+      }
+      auto *conn = dynamic_cast<BaseConnection *>(obj.second);
+      if (conn != nullptr) {
+         mBenchmarkReport->addDeliveryCounters(
+               conn->getPost()->getPhase(), conn->getDeliveryMetrics());
+      }
+   }
+
+   mBenchmarkReport->start();
+   mSuppressOutput     = suppressOutput;
+   long int timedSteps = 0;
+   while (mSimTime < mStopTime - mDeltaTime / 2.0) {
+      if (!mSuppressOutput) {
+         mCheckpointer->checkpointWrite(mSimTime);
+      }
+      advanceTime(mSimTime);
+      timedSteps += 1;
+   }
+   mSuppressOutput = false;
+   mBenchmarkReport->stop(step, timedSteps);
+
+   mBenchmarkReport->print();
+   mBenchmarkReport->writeJSON(mCheckpointer->makeOutputPathFilename("benchmark.json"));
+   delete mBenchmarkReport;
+   mBenchmarkReport = nullptr;
+}
+
+void HyPerCol::runServer(std::string const &socketPath) {
+   InferenceServer server(
+         this,
+         mPVInitObj->getStringArgument("ServeInput"),
+         mPVInitObj->getStringArgument("ServeOutput"));
+   server.listen(expandLeadingTilde(socketPath));
+   server.serve();
+   server.printReport();
+}
+
 int HyPerCol::advanceTime(double sim_time) {
    if (mSimTime >= mNextProgressTime) {
       mNextProgressTime += mProgressInterval;
@@ -675,10 +888,14 @@ int HyPerCol::advanceTime(double sim_time) {
    notifyLoop(std::make_shared<ConnectionUpdateMessage>(mSimTime, mDeltaTime));
    notifyLoop(std::make_shared<ConnectionNormalizeMessage>());
    notifyLoop(std::make_shared<ConnectionFinalizeUpdateMessage>(mSimTime, mDeltaTime));
-   notifyLoop(std::make_shared<ConnectionOutputMessage>(mSimTime, mDeltaTime));
+   if (!mSuppressOutput) {
+      notifyLoop(std::make_shared<ConnectionOutputMessage>(mSimTime, mDeltaTime));
+   }
 
    // Each layer's phase establishes a priority for updating
    for (int phase = 0; phase < mNumPhases; phase++) {
+      TraceZone phaseZone(mPhaseTraceNames[phase], "column");
+      std::uint64_t const phaseStart = mBenchmarkReport ? Tracer::now() : 0U;
       notifyLoop(std::make_shared<LayerClearProgressFlagsMessage>());
 
       // nonblockingLayerUpdate allows for more concurrency than notifyLoop.
@@ -773,15 +990,23 @@ int HyPerCol::advanceTime(double sim_time) {
 
       // Feb 2, 2017: waiting and updating active indices have been moved into
       // OutputState and CheckNotANumber, where they are called if needed.
-      notifyLoop(std::make_shared<LayerOutputStateMessage>(phase, mSimTime));
+      if (!mSuppressOutput) {
+         notifyLoop(std::make_shared<LayerOutputStateMessage>(phase, mSimTime));
+      }
       if (mErrorOnNotANumber) {
          notifyLoop(std::make_shared<LayerCheckNotANumberMessage>(phase));
       }
+      if (mBenchmarkReport) {
+         mBenchmarkReport->addPhaseTime(phase, Tracer::now() - phaseStart);
+      }
    }
 
    mRunTimer->stop();
 
-   notifyLoop(std::make_shared<ColProbeOutputStateMessage>(mSimTime, mDeltaTime));
+   if (!mSuppressOutput) {
+      notifyLoop(std::make_shared<ColProbeOutputStateMessage>(mSimTime, mDeltaTime));
+      mCheckpointer->writeMetrics(mSimTime);
+   }
 
    return status;
 }
@@ -10,9 +10,12 @@
 
 #include "checkpointing/Checkpointer.hpp"
 #include "columns/BaseObject.hpp"
+#include "columns/BenchmarkReport.hpp"
 #include "columns/Communicator.hpp"
+#include "columns/CostModel.hpp"
 #include "columns/Messages.hpp"
 #include "columns/PV_Init.hpp"
+#include "columns/RandomSeed.hpp"
 #include "include/pv_types.h"
 #include "io/PVParams.hpp"
 #include "observerpattern/Observer.hpp"
@@ -20,6 +23,7 @@
 #include "observerpattern/Subject.hpp"
 #include "utils/Clock.hpp"
 #include "utils/Timer.hpp"
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <sstream>
@@ -84,6 +88,16 @@ class HyPerCol : public Subject, public Observer {
     */
    virtual void ioParam_randomSeed(enum ParamsIOFlag ioFlag);
 
+   /**
+    * @brief randomGenerator: The kind of random number generator used by the objects that
+    * support more than one, "tausworthe" (the default) or "philox".
+    * @details The Philox generator computes each random number from the global index of the
+    * neuron, the timestep and the number of the draw within the timestep, so that the numbers
+    * do not depend on the MPI configuration, the number of threads or the order of the updates,
+    * and the generator needs no checkpointed state. At present the stochastic deliveries use it.
+    */
+   virtual void ioParam_randomGenerator(enum ParamsIOFlag ioFlag);
+
    /**
     * @brief nx: Specifies the size of the column
     */
@@ -105,6 +119,16 @@ class HyPerCol : public Subject, public Observer {
     */
    virtual void ioParam_errorOnNotANumber(enum ParamsIOFlag ioFlag);
 
+   /**
+    * @brief memoryBudget: The memory, in MiB, that the objects of the column may allocate on each
+    * process.
+    * @details Allocations by layers and connections are recorded with the MemoryTracker, and a
+    * report of them is printed after the allocate stage. If the budget is positive and the
+    * recorded allocations exceed it, the run exits with the report. The default, zero, means
+    * there is no budget.
+    */
+   virtual void ioParam_memoryBudget(enum ParamsIOFlag ioFlag);
+
   public:
    HyPerCol(PV_Init *initObj);
    virtual ~HyPerCol();
@@ -132,6 +156,55 @@ class HyPerCol : public Subject, public Observer {
 
    void advanceTimeLoop(Clock &runClock, int const runClockStartingStep);
    int advanceTime(double time);
+
+   /**
+    * The time loop of the --benchmark run mode. Runs the given number of warm-up steps as
+    * advanceTimeLoop would, and then times the remaining steps with a BenchmarkReport, which
+    * is printed and written to benchmark.json in the output path. If suppressOutput is true,
+    * layer and connection output, probes, metrics and checkpoints are skipped during the timed
+    * window.
+    */
+   void runBenchmark(int numWarmupSteps, bool suppressOutput);
+
+   /**
+    * The --serve run mode. Serves inference requests on the given socket path with an
+    * InferenceServer, using the ServeInput and ServeOutput layers, until a client asks the server
+    * to shut down. The stop time is not used.
+    */
+   void runServer(std::string const &socketPath);
+
+   /**
+    * Prints the MemoryTracker's report of the allocations on the root process, with the largest
+    * total over all processes. Called by allocateColumn() after the allocate stage.
+    */
+   void printMemoryReport();
+
+   /**
+    * Returns the seconds since the previous call, or since mStartupLap was last set, and
+    * restarts the lap. Used to time the stages of building and allocating the column.
+    */
+   double lapStartupTimer();
+
+   /**
+    * Reduces the startup stage times to their maximum over all processes, sets
+    * mTimeToFirstStep, and prints the times on the root process. Called at the end of
+    * allocateColumn().
+    */
+   void printStartupReport();
+
+   /**
+    * The dry-run alternative to allocateColumn(). Performs the CommunicateInitInfo stage and
+    * outputs the generated params file, but does not allocate the objects. Instead, builds a
+    * CostModel of the network, calibrated with the CostCalibration file if there is one, and
+    * prints its predictions on the root process.
+    */
+   void estimateColumn();
+
+   /**
+    * The part of allocateColumn() and estimateColumn() before the allocate stage: sets the
+    * number of threads, runs the CommunicateInitInfo stage and outputs the params file.
+    */
+   void communicateColumn();
    void nonblockingLayerUpdate(std::shared_ptr<LayerUpdateStateMessage const> updateMessage);
    void nonblockingLayerUpdate(
          std::shared_ptr<LayerRecvSynapticInputMessage const> recvMessage,
@@ -153,6 +226,20 @@ class HyPerCol : public Subject, public Observer {
    int run() { return run(mStopTime, mDeltaTime); }
    int run(double stopTime, double dt);
 
+   /**
+    * For a program that embeds the column and drives it a few timesteps at a time instead of
+    * calling run(): allocates the column if necessary, and then advances it numSteps timesteps,
+    * writing checkpoints as advanceTimeLoop() does. The stopTime parameter does not limit the
+    * number of steps.
+    */
+   void advanceSteps(int numSteps);
+
+   /**
+    * The end of run(): sends the Cleanup message and writes the final checkpoint. A program that
+    * drives the column with advanceSteps() calls it once, when it is done with the column.
+    */
+   void finishRun();
+
    // Getters and setters
 
    bool getVerifyWrites() { return mCheckpointer->doesVerifyWrites(); }
@@ -183,6 +270,17 @@ class HyPerCol : public Subject, public Observer {
    int numCommBatches() { return mCommunicator->numCommBatches(); }
    Communicator *getCommunicator() const { return mCommunicator; }
    PV_Init *getPV_InitObj() const { return mPVInitObj; }
+
+   /**
+    * The wall-clock seconds spent constructing the column and running the CommunicateInitInfo,
+    * AllocateDataStructures and InitializeState stages, on the slowest process.
+    * Time spent between the constructor and the first advanceSteps() or run() call is not
+    * included. Zero until the column has been allocated.
+    */
+   double getTimeToFirstStep() const { return mTimeToFirstStep; }
+
+   /** The cost model of a dry run, or null if the run was not a dry run. */
+   CostModel const *getCostModel() const { return mCostModel; }
    FileStream *getPrintParamsStream() const { return mPrintParamsStream; }
    PVParams *parameters() const { return mParams; }
    long int getInitialStep() const { return mInitialStep; }
@@ -247,6 +345,7 @@ class HyPerCol : public Subject, public Observer {
    bool mErrorOnNotANumber; // If true, check each layer's activity buffer for
    // not-a-numbers and
    // exit with an error if any appear
+   double mMemoryBudget = 0.0; // in MiB per process; zero means there is no budget
    bool mCheckpointReadFlag; // whether to load from a checkpoint directory
    bool mReadyFlag; // Initially false; set to true when communicateInitInfo,
    // allocateDataStructures, and initializeState stages are completed
@@ -296,7 +395,19 @@ class HyPerCol : public Subject, public Observer {
    std::ofstream mTimeScaleStream;
    Timer *mRunTimer;
    std::vector<Timer *> mPhaseRecvTimers; // Timer ** mPhaseRecvTimers;
+   std::vector<char const *> mPhaseTraceNames;
+   BenchmarkReport *mBenchmarkReport = nullptr; // non-null during a benchmark's timed window
+   bool mSuppressOutput              = false;
+   CostModel *mCostModel             = nullptr; // set by a dry run
+   std::chrono::steady_clock::time_point mStartupLap;
+   double mConstructionTime = 0.0;
+   double mCommunicateTime  = 0.0;
+   double mAllocateTime     = 0.0;
+   double mInitializeTime   = 0.0;
+   double mTimeToFirstStep  = 0.0;
    unsigned int mRandomSeed;
+   char *mRandomGeneratorString           = nullptr;
+   RandomSeed::Generator mRandomGenerator = RandomSeed::TAUSWORTHE;
 #ifdef PV_USE_CUDA
    PVCuda::CudaDevice *mCudaDevice; // object for running kernels on OpenCL device
 #endif
@@ -0,0 +1,188 @@
+#include "InferenceClient.hpp"
+#include "include/pv_common.h"
+#include "utils/PVLog.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace PV {
+
+using namespace InferenceProtocol;
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+int const sendFlags = MSG_NOSIGNAL;
+#else
+int const sendFlags = 0;
+#endif // MSG_NOSIGNAL
+
+} // namespace
+
+InferenceClient::~InferenceClient() {
+   if (mSocket >= 0) {
+      close(mSocket);
+   }
+}
+
+int InferenceClient::connect(std::string const &socketPath, double timeoutSeconds) {
+   struct sockaddr_un address;
+   std::memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   if (socketPath.empty() or socketPath.size() >= sizeof(address.sun_path)) {
+      ErrorLog().printf("InferenceClient: invalid socket path \"%s\".\n", socketPath.c_str());
+      return PV_FAILURE;
+   }
+   std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+   auto const deadline = std::chrono::steady_clock::now()
+                         + std::chrono::duration<double>(timeoutSeconds);
+   while (true) {
+      mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (mSocket < 0) {
+         ErrorLog().printf("InferenceClient: unable to create a socket: %s\n", strerror(errno));
+         return PV_FAILURE;
+      }
+      if (::connect(mSocket, (struct sockaddr *)&address, sizeof(address)) == 0) {
+         return PV_SUCCESS;
+      }
+      close(mSocket);
+      mSocket = -1;
+      if (std::chrono::steady_clock::now() >= deadline) {
+         ErrorLog().printf(
+               "InferenceClient: unable to connect to \"%s\": %s\n",
+               socketPath.c_str(),
+               strerror(errno));
+         return PV_FAILURE;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+   }
+}
+
+void InferenceClient::queueRequest(std::uint32_t type, int height, int width, int bands) {
+   RequestHeader header;
+   header.mType   = type;
+   header.mHeight = height;
+   header.mWidth  = width;
+   header.mBands  = bands;
+   char const *bytes = reinterpret_cast<char const *>(&header);
+   mOutgoing.insert(mOutgoing.end(), bytes, bytes + sizeof(header));
+}
+
+void InferenceClient::submit(float const *pixels, int height, int width, int bands) {
+   queueRequest(FRAME_FLOAT, height, width, bands);
+   char const *bytes = reinterpret_cast<char const *>(pixels);
+   mOutgoing.insert(mOutgoing.end(), bytes, bytes + sizeof(float) * height * width * bands);
+}
+
+void InferenceClient::submit(std::uint8_t const *pixels, int height, int width, int bands) {
+   queueRequest(FRAME_UINT8, height, width, bands);
+   char const *bytes = reinterpret_cast<char const *>(pixels);
+   mOutgoing.insert(mOutgoing.end(), bytes, bytes + height * width * bands);
+}
+
+int InferenceClient::sendQueued() {
+   std::size_t offset = 0;
+   while (offset < mOutgoing.size()) {
+      ssize_t numSent =
+            send(mSocket, mOutgoing.data() + offset, mOutgoing.size() - offset, sendFlags);
+      if (numSent < 0 and errno == EINTR) {
+         continue;
+      }
+      if (numSent <= 0) {
+         ErrorLog().printf("InferenceClient: send failed: %s\n", strerror(errno));
+         return PV_FAILURE;
+      }
+      offset += (std::size_t)numSent;
+   }
+   mOutgoing.clear();
+   return PV_SUCCESS;
+}
+
+int InferenceClient::receiveAll(void *data, std::size_t size) {
+   char *bytes = static_cast<char *>(data);
+   while (size > 0) {
+      ssize_t numRead = recv(mSocket, bytes, size, 0);
+      if (numRead < 0 and errno == EINTR) {
+         continue;
+      }
+      if (numRead <= 0) {
+         ErrorLog().printf(
+               "InferenceClient: %s\n",
+               numRead == 0 ? "the server closed the connection" : strerror(errno));
+         return PV_FAILURE;
+      }
+      bytes += numRead;
+      size -= (std::size_t)numRead;
+   }
+   return PV_SUCCESS;
+}
+
+int InferenceClient::receive(SparseCode *code) {
+   if (mSocket < 0 or sendQueued() != PV_SUCCESS) {
+      return PV_FAILURE;
+   }
+   CodeReply reply;
+   if (receiveAll(&reply, sizeof(reply)) != PV_SUCCESS) {
+      return PV_FAILURE;
+   }
+   code->mNumNeurons = reply.mNumNeurons;
+   code->mBatchSize  = reply.mBatchSize;
+   code->mSimTime    = reply.mSimTime;
+   code->mIndices.resize(reply.mNumActive);
+   code->mValues.resize(reply.mNumActive);
+   if (reply.mStatus != 0) {
+      ErrorLog().printf("InferenceClient: the server rejected the frame.\n");
+      return PV_FAILURE;
+   }
+   std::vector<std::int32_t> indices(reply.mNumActive);
+   if (receiveAll(indices.data(), indices.size() * sizeof(std::int32_t)) != PV_SUCCESS
+       or receiveAll(code->mValues.data(), code->mValues.size() * sizeof(float)) != PV_SUCCESS) {
+      return PV_FAILURE;
+   }
+   for (std::size_t k = 0; k < indices.size(); k++) {
+      code->mIndices[k] = (int)indices[k];
+   }
+   return PV_SUCCESS;
+}
+
+int InferenceClient::infer(
+      float const *pixels,
+      int height,
+      int width,
+      int bands,
+      SparseCode *code) {
+   submit(pixels, height, width, bands);
+   return receive(code);
+}
+
+int InferenceClient::infer(
+      std::uint8_t const *pixels,
+      int height,
+      int width,
+      int bands,
+      SparseCode *code) {
+   submit(pixels, height, width, bands);
+   return receive(code);
+}
+
+int InferenceClient::requestStatsReply(std::uint32_t type, StatsReply *stats) {
+   queueRequest(type, 0, 0, 0);
+   if (mSocket < 0 or sendQueued() != PV_SUCCESS) {
+      return PV_FAILURE;
+   }
+   return receiveAll(stats, sizeof(*stats));
+}
+
+int InferenceClient::requestStats(StatsReply *stats) { return requestStatsReply(STATS, stats); }
+
+int InferenceClient::requestShutdown(StatsReply *stats) {
+   return requestStatsReply(SHUTDOWN, stats);
+}
+
+} // namespace PV
@@ -0,0 +1,79 @@
+#ifndef INFERENCECLIENT_HPP_
+#define INFERENCECLIENT_HPP_
+
+#include "columns/InferenceProtocol.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * A client of InferenceServer, for testing a server and for programs that send it frames from the
+ * same machine. Frames can be sent one at a time with infer(), or several can be submitted before
+ * their replies are received, in which case they are sent together and the server can put them
+ * into one batch. Replies come back in the order the frames were submitted.
+ *
+ * The methods return PV_SUCCESS, or PV_FAILURE if the connection fails or the server rejects a
+ * frame.
+ */
+class InferenceClient {
+  public:
+   /** The sparse code of a frame, as returned by the server. */
+   struct SparseCode {
+      std::vector<int> mIndices; // global restricted indices into the output layer
+      std::vector<float> mValues;
+      int mNumNeurons = 0;
+      int mBatchSize  = 0;
+      double mSimTime = 0.0;
+   };
+
+   InferenceClient() {}
+
+   /** Closes the connection. */
+   ~InferenceClient();
+
+   /**
+    * Connects to the server listening on socketPath. Since the server may still be starting, it
+    * keeps trying for up to timeoutSeconds.
+    */
+   int connect(std::string const &socketPath, double timeoutSeconds);
+
+   /**
+    * Queues a frame of height rows of width pixels of the given number of bands, with the band
+    * index varying fastest. Float pixels of 0 and 1 are converted to 0 and 1; uint8 pixels of 0
+    * and 255 are converted to 0 and 1.
+    */
+   void submit(float const *pixels, int height, int width, int bands);
+   void submit(std::uint8_t const *pixels, int height, int width, int bands);
+
+   /** Sends the queued frames, if any, and receives the reply to the oldest unanswered frame. */
+   int receive(SparseCode *code);
+
+   /** Submits a frame and receives its reply. There must be no other unanswered frames. */
+   int infer(float const *pixels, int height, int width, int bands, SparseCode *code);
+   int infer(std::uint8_t const *pixels, int height, int width, int bands, SparseCode *code);
+
+   /** Asks for the server's statistics. There must be no unanswered frames. */
+   int requestStats(InferenceProtocol::StatsReply *stats);
+
+   /**
+    * Asks the server to shut down, and receives its final statistics once it has finished the
+    * frames it has. There must be no unanswered frames.
+    */
+   int requestShutdown(InferenceProtocol::StatsReply *stats);
+
+  private:
+   void queueRequest(std::uint32_t type, int height, int width, int bands);
+   int sendQueued();
+   int receiveAll(void *data, std::size_t size);
+   int requestStatsReply(std::uint32_t type, InferenceProtocol::StatsReply *stats);
+
+  private:
+   int mSocket = -1;
+   std::vector<char> mOutgoing;
+};
+
+} // namespace PV
+
+#endif // INFERENCECLIENT_HPP_
@@ -0,0 +1,69 @@
+#ifndef INFERENCEPROTOCOL_HPP_
+#define INFERENCEPROTOCOL_HPP_
+
+#include <cstdint>
+
+namespace PV {
+
+/**
+ * The messages exchanged by InferenceServer and InferenceClient over a local (Unix domain)
+ * socket. Both ends run on the same machine, so the structs are sent as they are, in the
+ * machine's byte order.
+ */
+namespace InferenceProtocol {
+
+enum RequestType : std::uint32_t {
+   FRAME_FLOAT = 1U, // a frame of float pixels; 0 and 1 are converted to 0 and 1
+   FRAME_UINT8 = 2U, // a frame of 8-bit pixels; 0 and 255 are converted to 0 and 1
+   STATS       = 3U, // asks for the server's request and latency statistics
+   SHUTDOWN    = 4U  // asks the server to finish the requests it has and stop
+};
+
+/**
+ * The header of every request. A frame request is followed by height * width * bands pixels, in
+ * row-major order with the band index varying fastest. For the other requests, the height, width
+ * and bands are ignored.
+ */
+struct RequestHeader {
+   std::uint32_t mType;
+   std::int32_t mHeight;
+   std::int32_t mWidth;
+   std::int32_t mBands;
+};
+
+/**
+ * The reply to a frame request, followed by mNumActive neuron indices (std::int32_t) and then
+ * mNumActive activities (float): the nonzero activities of the output layer for the frame. The
+ * indices are global restricted indices, with the feature index varying fastest, then x, then y.
+ * If mStatus is nonzero the request was rejected, and there are no indices or activities.
+ */
+struct CodeReply {
+   std::int32_t mStatus;
+   std::int32_t mNumActive;
+   std::int32_t mNumNeurons; // the number of neurons in the output layer
+   std::int32_t mBatchSize; // the number of requests processed together with this one
+   double mSimTime; // the simulation time at which the activities were read
+};
+
+/**
+ * The reply to a stats or shutdown request. Latencies are in milliseconds, from the time the
+ * server has received the whole request to the time it sends the reply.
+ */
+struct StatsReply {
+   std::int64_t mNumRequests;
+   std::int64_t mNumBatches;
+   double mMeanLatency;
+   double mLatency50;
+   double mLatency90;
+   double mLatency99;
+   double mMaxLatency;
+};
+
+// Frames with more pixels than this are rejected, and the connection is closed.
+std::int64_t const maxFramePixels = (std::int64_t)1 << 26;
+
+} // namespace InferenceProtocol
+
+} // namespace PV
+
+#endif // INFERENCEPROTOCOL_HPP_
@@ -0,0 +1,532 @@
+#include "InferenceServer.hpp"
+#include "connections/BaseConnection.hpp"
+#include "utils/BufferUtilsMPI.hpp"
+#include "utils/PVAssert.hpp"
+#include "utils/PVLog.hpp"
+#include "weightupdaters/BaseWeightUpdater.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace PV {
+
+using namespace InferenceProtocol;
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+int const sendFlags = MSG_NOSIGNAL;
+#else
+int const sendFlags = 0;
+#endif // MSG_NOSIGNAL
+
+// How long a reply waits for a client to make room in its socket before the client is dropped.
+int const sendTimeoutMilliseconds = 10000;
+
+void setNonblocking(int socket) {
+   int flags = fcntl(socket, F_GETFL, 0);
+   fcntl(socket, F_SETFL, flags | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+   int on = 1;
+   setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif // SO_NOSIGPIPE
+}
+
+// Sends all of the data on a nonblocking socket. Returns false if the socket fails, or if the
+// peer does not make room for the data in time.
+bool sendAll(int socket, void const *data, std::size_t size) {
+   char const *bytes = static_cast<char const *>(data);
+   while (size > 0) {
+      ssize_t numSent = send(socket, bytes, size, sendFlags);
+      if (numSent > 0) {
+         bytes += numSent;
+         size -= (std::size_t)numSent;
+         continue;
+      }
+      if (numSent < 0 and errno == EINTR) {
+         continue;
+      }
+      if (numSent < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+         struct pollfd pollFd;
+         pollFd.fd     = socket;
+         pollFd.events = POLLOUT;
+         if (poll(&pollFd, 1, sendTimeoutMilliseconds) > 0) {
+            continue;
+         }
+      }
+      return false;
+   }
+   return true;
+}
+
+// The nearest-rank percentile of the sorted values.
+double percentile(std::vector<double> const &sorted, double percent) {
+   if (sorted.empty()) {
+      return 0.0;
+   }
+   std::size_t rank = (std::size_t)std::ceil(percent / 100.0 * (double)sorted.size());
+   return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+std::size_t pixelSize(std::uint32_t type) {
+   return type == FRAME_UINT8 ? sizeof(std::uint8_t) : sizeof(float);
+}
+
+} // namespace
+
+InferenceServer::InferenceServer(
+      HyPerCol *hc,
+      std::string const &inputLayerName,
+      std::string const &outputLayerName)
+      : mHyPerCol(hc) {
+   FatalIf(
+         inputLayerName.empty() or outputLayerName.empty(),
+         "The serve run mode needs an input layer (--serve-input) and an output layer "
+         "(--serve-output).\n");
+   mInputLayer = dynamic_cast<ImageFromMemoryBuffer *>(hc->getObjectFromName(inputLayerName));
+   FatalIf(
+         mInputLayer == nullptr,
+         "%s: there is no ImageFromMemoryBuffer layer \"%s\" to serve frames to.\n",
+         hc->getDescription_c(),
+         inputLayerName.c_str());
+   mOutputLayer = dynamic_cast<HyPerLayer *>(hc->getObjectFromName(outputLayerName));
+   FatalIf(
+         mOutputLayer == nullptr,
+         "%s: there is no layer \"%s\" to serve codes from.\n",
+         hc->getDescription_c(),
+         outputLayerName.c_str());
+   Communicator *communicator = hc->getCommunicator();
+   FatalIf(
+         mOutputLayer->getMPIBlock()->getSize() != communicator->globalCommSize(),
+         "%s: the serve run mode needs all processes to be in one MPI block, with no MPI batch "
+         "dimension.\n",
+         hc->getDescription_c());
+   mIsRoot        = communicator->globalCommRank() == 0;
+   mBatchWidth    = hc->getNBatchGlobal();
+   mStepsPerBatch = std::max(mInputLayer->getDisplayPeriod(), 1);
+
+   int numFrozen    = 0;
+   PVParams *params = hc->parameters();
+   for (int g = 0; g < params->numberOfGroups(); g++) {
+      std::string const groupName(params->groupNameFromIndex(g));
+      auto *conn    = dynamic_cast<BaseConnection *>(hc->getObjectFromName(groupName));
+      auto *updater = conn ? conn->getComponentByType<BaseWeightUpdater>() : nullptr;
+      if (updater != nullptr and updater->getPlasticityFlag()) {
+         updater->turnOffPlasticity();
+         numFrozen++;
+      }
+   }
+   if (mIsRoot) {
+      InfoLog().printf(
+            "Serving codes of %s for frames sent to %s: %d batch elements, %d timesteps per "
+            "batch. Plasticity turned off in %d connections.\n",
+            mOutputLayer->getDescription_c(),
+            mInputLayer->getDescription_c(),
+            mBatchWidth,
+            mStepsPerBatch,
+            numFrozen);
+   }
+}
+
+InferenceServer::~InferenceServer() {
+   for (auto &c : mConnections) {
+      close(c.second.mSocket);
+   }
+   if (mListenSocket >= 0) {
+      close(mListenSocket);
+      unlink(mSocketPath.c_str());
+   }
+}
+
+void InferenceServer::listen(std::string const &socketPath) {
+   mSocketPath = socketPath;
+   if (!mIsRoot) {
+      return;
+   }
+   struct sockaddr_un address;
+   std::memset(&address, 0, sizeof(address));
+   address.sun_family = AF_UNIX;
+   FatalIf(
+         socketPath.empty() or socketPath.size() >= sizeof(address.sun_path),
+         "The socket path \"%s\" must have between 1 and %zu characters.\n",
+         socketPath.c_str(),
+         sizeof(address.sun_path) - 1);
+   std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+   mListenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+   FatalIf(mListenSocket < 0, "Unable to create a socket: %s\n", std::strerror(errno));
+
+   // An old socket file is removed, unless a server is still listening on it.
+   struct stat pathStat;
+   if (stat(socketPath.c_str(), &pathStat) == 0) {
+      FatalIf(
+            !S_ISSOCK(pathStat.st_mode),
+            "\"%s\" exists and is not a socket.\n",
+            socketPath.c_str());
+      int probe       = socket(AF_UNIX, SOCK_STREAM, 0);
+      bool const live = connect(probe, (struct sockaddr *)&address, sizeof(address)) == 0;
+      close(probe);
+      FatalIf(live, "Another server is listening on \"%s\".\n", socketPath.c_str());
+      unlink(socketPath.c_str());
+   }
+
+   int status = bind(mListenSocket, (struct sockaddr *)&address, sizeof(address));
+   FatalIf(
+         status != 0,
+         "Unable to bind a socket to \"%s\": %s\n",
+         socketPath.c_str(),
+         std::strerror(errno));
+   status = ::listen(mListenSocket, SOMAXCONN);
+   FatalIf(
+         status != 0,
+         "Unable to listen on \"%s\": %s\n",
+         socketPath.c_str(),
+         std::strerror(errno));
+   setNonblocking(mListenSocket);
+   InfoLog().printf("Listening for inference requests on \"%s\".\n", socketPath.c_str());
+}
+
+void InferenceServer::serve() {
+   MPI_Comm const comm = mHyPerCol->getCommunicator()->globalCommunicator();
+   while (true) {
+      std::vector<Request> batch;
+      int batchSize = 0;
+      if (mIsRoot) {
+         // Take in everything that has arrived during the last batch, then wait for work.
+         pollConnections(0);
+         while (mPending.empty() and !mShutdownRequested) {
+            pollConnections(-1);
+         }
+         while (!mPending.empty() and (int)batch.size() < mBatchWidth) {
+            batch.push_back(std::move(mPending.front()));
+            mPending.pop_front();
+         }
+         batchSize = (int)batch.size();
+      }
+      // A batch size of zero means that a shutdown was requested and the pending frames are done.
+      MPI_Bcast(&batchSize, 1, MPI_INT, 0, comm);
+      if (batchSize == 0) {
+         break;
+      }
+      std::vector<RequestHeader> headers(batchSize);
+      if (mIsRoot) {
+         for (int b = 0; b < batchSize; b++) {
+            headers[b] = batch[b].mHeader;
+         }
+      }
+      MPI_Bcast(headers.data(), batchSize * (int)sizeof(RequestHeader), MPI_BYTE, 0, comm);
+      if (!mIsRoot) {
+         batch.resize(batchSize);
+         for (int b = 0; b < batchSize; b++) {
+            batch[b].mHeader = headers[b];
+         }
+      }
+      runBatch(batch);
+   }
+   if (mIsRoot and mShutdownConnectionId >= 0) {
+      StatsReply stats = getStats();
+      sendReply(mShutdownConnectionId, &stats, sizeof(stats));
+   }
+}
+
+void InferenceServer::pollConnections(int timeoutMilliseconds) {
+   if (mShutdownRequested) {
+      return;
+   }
+   std::vector<struct pollfd> pollFds(mConnections.size() + 1);
+   std::vector<int> connectionIds;
+   pollFds[0].fd     = mListenSocket;
+   pollFds[0].events = POLLIN;
+   for (auto &c : mConnections) {
+      struct pollfd &pollFd = pollFds[connectionIds.size() + 1];
+      pollFd.fd             = c.second.mSocket;
+      pollFd.events         = POLLIN;
+      connectionIds.push_back(c.first);
+   }
+   for (auto &p : pollFds) {
+      p.revents = 0;
+   }
+   int numReady = poll(pollFds.data(), (nfds_t)pollFds.size(), timeoutMilliseconds);
+   FatalIf(numReady < 0 and errno != EINTR, "poll failed: %s\n", std::strerror(errno));
+   if (numReady <= 0) {
+      return;
+   }
+   if (pollFds[0].revents != 0) {
+      acceptConnections();
+   }
+   for (std::size_t i = 0; i < connectionIds.size(); i++) {
+      if (pollFds[i + 1].revents == 0) {
+         continue;
+      }
+      int const id = connectionIds[i];
+      auto found   = mConnections.find(id);
+      pvAssert(found != mConnections.end());
+      if (!readConnection(found->second) or !parseRequests(id, found->second)) {
+         closeConnection(id);
+      }
+   }
+}
+
+void InferenceServer::acceptConnections() {
+   while (true) {
+      int clientSocket = accept(mListenSocket, nullptr, nullptr);
+      if (clientSocket < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         return;
+      }
+      setNonblocking(clientSocket);
+      Connection connection;
+      connection.mSocket = clientSocket;
+      mConnections.emplace(mNextConnectionId++, std::move(connection));
+   }
+}
+
+bool InferenceServer::readConnection(Connection &connection) {
+   char chunk[65536];
+   while (true) {
+      ssize_t numRead = recv(connection.mSocket, chunk, sizeof(chunk), 0);
+      if (numRead > 0) {
+         connection.mInput.insert(connection.mInput.end(), chunk, chunk + numRead);
+         continue;
+      }
+      if (numRead == 0) {
+         return false; // The client has closed the connection.
+      }
+      if (errno == EINTR) {
+         continue;
+      }
+      return errno == EAGAIN or errno == EWOULDBLOCK;
+   }
+}
+
+bool InferenceServer::parseRequests(int connectionId, Connection &connection) {
+   std::vector<char> &input = connection.mInput;
+   std::size_t offset       = 0;
+   bool valid               = true;
+   while (!mShutdownRequested and input.size() - offset >= sizeof(RequestHeader)) {
+      RequestHeader header;
+      std::memcpy(&header, &input[offset], sizeof(header));
+      if (header.mType == STATS) {
+         offset += sizeof(header);
+         StatsReply stats = getStats();
+         valid            = sendAll(connection.mSocket, &stats, sizeof(stats));
+         if (!valid) {
+            break;
+         }
+         continue;
+      }
+      if (header.mType == SHUTDOWN) {
+         offset += sizeof(header);
+         mShutdownRequested    = true;
+         mShutdownConnectionId = connectionId;
+         break;
+      }
+      // A frame that cannot be served is rejected, and the connection is closed, since the rest
+      // of its input cannot be trusted to line up with the requests.
+      std::int64_t const numPixels = (std::int64_t)header.mHeight * header.mWidth * header.mBands;
+      int const inputFeatures      = mInputLayer->getLayerLoc()->nf;
+      bool const convertible       = header.mBands == inputFeatures
+                                     or (header.mBands <= 4 and inputFeatures <= 4);
+      if ((header.mType != FRAME_FLOAT and header.mType != FRAME_UINT8) or header.mHeight <= 0
+          or header.mWidth <= 0 or header.mBands <= 0 or numPixels > maxFramePixels
+          or !convertible) {
+         CodeReply reply;
+         std::memset(&reply, 0, sizeof(reply));
+         reply.mStatus     = 1;
+         reply.mNumNeurons = mOutputLayer->getNumGlobalNeurons();
+         reply.mSimTime    = mHyPerCol->simulationTime();
+         sendAll(connection.mSocket, &reply, sizeof(reply));
+         valid = false;
+         break;
+      }
+      std::size_t const payloadSize = (std::size_t)numPixels * pixelSize(header.mType);
+      if (input.size() - offset - sizeof(header) < payloadSize) {
+         break; // The rest of the frame has not arrived yet.
+      }
+      char const *payload = input.data() + offset + sizeof(header);
+      Request request;
+      request.mConnectionId = connectionId;
+      request.mHeader       = header;
+      request.mPixels.assign(payload, payload + payloadSize);
+      request.mReceivedTime = std::chrono::steady_clock::now();
+      mPending.push_back(std::move(request));
+      offset += sizeof(header) + payloadSize;
+   }
+   input.erase(input.begin(), input.begin() + offset);
+   return valid;
+}
+
+void InferenceServer::closeConnection(int connectionId) {
+   auto found = mConnections.find(connectionId);
+   if (found != mConnections.end()) {
+      close(found->second.mSocket);
+      mConnections.erase(found);
+   }
+}
+
+void InferenceServer::sendReply(int connectionId, void const *data, std::size_t size) {
+   auto found = mConnections.find(connectionId);
+   if (found == mConnections.end()) {
+      return; // The client has gone away; the reply is dropped.
+   }
+   if (!sendAll(found->second.mSocket, data, size)) {
+      closeConnection(connectionId);
+   }
+}
+
+void InferenceServer::runBatch(std::vector<Request> &requests) {
+   int const batchSize = (int)requests.size();
+   for (int b = 0; b < batchSize; b++) {
+      setFrame(b, requests[b]);
+   }
+   mHyPerCol->advanceSteps(mStepsPerBatch);
+   for (int b = 0; b < batchSize; b++) {
+      replyWithCode(b, requests[b], batchSize);
+   }
+   mNumRequests += batchSize;
+   mNumBatches++;
+}
+
+void InferenceServer::setFrame(int batchElement, Request const &request) {
+   RequestHeader const &header = request.mHeader;
+   int const xstride           = header.mBands;
+   int const ystride           = header.mWidth * header.mBands;
+   int status                  = PV_SUCCESS;
+   // Only the root process has the pixels; the others need only the frame's dimensions.
+   if (header.mType == FRAME_UINT8) {
+      auto const *pixels =
+            mIsRoot ? reinterpret_cast<std::uint8_t const *>(request.mPixels.data()) : nullptr;
+      status = mInputLayer->setMemoryBuffer(
+            batchElement,
+            pixels,
+            header.mHeight,
+            header.mWidth,
+            header.mBands,
+            xstride,
+            ystride,
+            1 /*bandstride*/,
+            (std::uint8_t)0,
+            (std::uint8_t)255);
+   }
+   else {
+      auto const *pixels =
+            mIsRoot ? reinterpret_cast<float const *>(request.mPixels.data()) : nullptr;
+      status = mInputLayer->setMemoryBuffer(
+            batchElement,
+            pixels,
+            header.mHeight,
+            header.mWidth,
+            header.mBands,
+            xstride,
+            ystride,
+            1 /*bandstride*/,
+            0.0f,
+            1.0f);
+   }
+   pvAssert(status == PV_SUCCESS);
+}
+
+void InferenceServer::replyWithCode(int batchElement, Request const &request, int batchSize) {
+   PVLayerLoc const *loc = mOutputLayer->getLayerLoc();
+   PVHalo const &halo    = loc->halo;
+   int const nxExtended  = loc->nx + halo.lt + halo.rt;
+   int const nyExtended  = loc->ny + halo.dn + halo.up;
+   float const *activity =
+         mOutputLayer->getActivity() + batchElement * mOutputLayer->getNumExtended();
+   Buffer<float> localActivity(activity, nxExtended, nyExtended, loc->nf);
+   Buffer<float> globalActivity = BufferUtils::gather<float>(
+         mOutputLayer->getMPIBlock(), localActivity, loc->nx, loc->ny, 0, 0);
+   if (!mIsRoot) {
+      return;
+   }
+
+   std::vector<std::int32_t> indices;
+   std::vector<float> values;
+   for (int y = 0; y < loc->nyGlobal; y++) {
+      for (int x = 0; x < loc->nxGlobal; x++) {
+         for (int f = 0; f < loc->nf; f++) {
+            float const a = globalActivity.at(x + halo.lt, y + halo.up, f);
+            if (a != 0.0f) {
+               indices.push_back((std::int32_t)((y * loc->nxGlobal + x) * loc->nf + f));
+               values.push_back(a);
+            }
+         }
+      }
+   }
+   CodeReply reply;
+   reply.mStatus     = 0;
+   reply.mNumActive  = (std::int32_t)indices.size();
+   reply.mNumNeurons = mOutputLayer->getNumGlobalNeurons();
+   reply.mBatchSize  = batchSize;
+   reply.mSimTime    = mHyPerCol->simulationTime();
+
+   std::size_t const indicesSize = indices.size() * sizeof(std::int32_t);
+   std::size_t const valuesSize  = values.size() * sizeof(float);
+   std::vector<char> message(sizeof(reply) + indicesSize + valuesSize);
+   std::memcpy(message.data(), &reply, sizeof(reply));
+   if (!indices.empty()) {
+      std::memcpy(message.data() + sizeof(reply), indices.data(), indicesSize);
+      std::memcpy(message.data() + sizeof(reply) + indicesSize, values.data(), valuesSize);
+   }
+   sendReply(request.mConnectionId, message.data(), message.size());
+   recordLatency(request.mReceivedTime);
+}
+
+void InferenceServer::recordLatency(std::chrono::steady_clock::time_point receivedTime) {
+   auto const elapsed = std::chrono::steady_clock::now() - receivedTime;
+   mLatencies.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+}
+
+StatsReply InferenceServer::getStats() const {
+   StatsReply stats;
+   std::memset(&stats, 0, sizeof(stats));
+   stats.mNumRequests = mNumRequests;
+   stats.mNumBatches  = mNumBatches;
+   if (!mLatencies.empty()) {
+      std::vector<double> sorted(mLatencies);
+      std::sort(sorted.begin(), sorted.end());
+      double sum = 0.0;
+      for (double latency : sorted) {
+         sum += latency;
+      }
+      stats.mMeanLatency = sum / (double)sorted.size();
+      stats.mLatency50   = percentile(sorted, 50.0);
+      stats.mLatency90   = percentile(sorted, 90.0);
+      stats.mLatency99   = percentile(sorted, 99.0);
+      stats.mMaxLatency  = sorted.back();
+   }
+   return stats;
+}
+
+void InferenceServer::printReport() const {
+   if (!mIsRoot) {
+      return;
+   }
+   StatsReply const stats = getStats();
+   InfoLog().printf(
+         "Inference server: %lld requests in %lld batches (%.2f requests per batch, "
+         "%d timesteps per batch)\n",
+         (long long)stats.mNumRequests,
+         (long long)stats.mNumBatches,
+         stats.mNumBatches > 0 ? (double)stats.mNumRequests / (double)stats.mNumBatches : 0.0,
+         mStepsPerBatch);
+   InfoLog().printf(
+         "   latency (ms): mean %.3f, 50%% %.3f, 90%% %.3f, 99%% %.3f, max %.3f\n",
+         stats.mMeanLatency,
+         stats.mLatency50,
+         stats.mLatency90,
+         stats.mLatency99,
+         stats.mMaxLatency);
+}
+
+} // namespace PV
@@ -0,0 +1,146 @@
+#ifndef INFERENCESERVER_HPP_
+#define INFERENCESERVER_HPP_
+
+#include "columns/HyPerCol.hpp"
+#include "columns/InferenceProtocol.hpp"
+#include "layers/ImageFromMemoryBuffer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * Keeps an allocated HyPerCol resident and runs it on frames sent by clients over a local socket,
+ * for the --serve run mode. Each frame is put into one batch element of an ImageFromMemoryBuffer
+ * input layer; the column is advanced the input layer's displayPeriod timesteps (one if the
+ * displayPeriod is not positive); and the nonzero activities of the output layer for that batch
+ * element are sent back as the frame's sparse code.
+ *
+ * Requests that arrive while a batch is being run wait for the next batch, which takes as many of
+ * them as there are batch elements, so that under load the batch fills up and the cost of the
+ * timesteps is shared among the requests (micro-batching). Batch elements with no request keep
+ * their previous frame, and their activities are not sent anywhere.
+ *
+ * The server turns off the plasticity of every connection, so that the weights stay as trained.
+ * It measures the latency of each request, from the time the whole request has been received to
+ * the time the reply is sent, and reports the percentiles in the replies to stats and shutdown
+ * requests, and in printReport(). See InferenceProtocol for the messages, and InferenceClient for
+ * a client.
+ *
+ * Under MPI, the root process does all the socket I/O and broadcasts each batch to the other
+ * processes. All the processes must be in one MPI block, so there can be no MPI batch dimension.
+ */
+class InferenceServer {
+  public:
+   /**
+    * Must be called by all processes, after the column has been allocated. Exits with an error
+    * if inputLayerName is not an ImageFromMemoryBuffer layer or outputLayerName is not a layer.
+    */
+   InferenceServer(
+         HyPerCol *hc,
+         std::string const &inputLayerName,
+         std::string const &outputLayerName);
+
+   /** Closes the connections and the listening socket, and removes the socket file. */
+   ~InferenceServer();
+
+   /**
+    * Creates the listening socket at the given path, replacing an old socket file if there is
+    * one. Clients can connect once this has returned. Only the root process opens the socket,
+    * but all processes must call listen().
+    */
+   void listen(std::string const &socketPath);
+
+   /**
+    * Serves requests until a client sends a shutdown request, and then finishes the pending
+    * frames, sends the shutdown reply, and returns. Must be called by all processes.
+    */
+   void serve();
+
+   /** Prints the request and latency statistics to the output stream, on the root process. */
+   void printReport() const;
+
+   /** The request and latency statistics so far. Only meaningful on the root process. */
+   InferenceProtocol::StatsReply getStats() const;
+
+  private:
+   struct Connection {
+      int mSocket = -1;
+      std::vector<char> mInput; // bytes received but not yet parsed into requests
+   };
+
+   struct Request {
+      int mConnectionId;
+      InferenceProtocol::RequestHeader mHeader;
+      std::vector<char> mPixels;
+      std::chrono::steady_clock::time_point mReceivedTime;
+   };
+
+   /**
+    * Root process only. Waits up to timeoutMilliseconds (forever if negative) for activity on
+    * the sockets, then accepts new connections and reads all the data available, adding the
+    * complete frame requests to mPending and answering stats requests.
+    */
+   void pollConnections(int timeoutMilliseconds);
+
+   void acceptConnections();
+
+   /** Reads what is available from the connection. Returns false if it should be closed. */
+   bool readConnection(Connection &connection);
+
+   /** Parses the complete requests in the connection's input. Returns false on a bad request. */
+   bool parseRequests(int connectionId, Connection &connection);
+
+   void closeConnection(int connectionId);
+
+   /**
+    * Sends the reply to a connection, if it is still open. Closes the connection if the reply
+    * cannot be sent.
+    */
+   void sendReply(int connectionId, void const *data, std::size_t size);
+
+   /**
+    * Runs one batch. On the root process, requests holds the requests of the batch; on the
+    * other processes, it holds their headers only.
+    */
+   void runBatch(std::vector<Request> &requests);
+
+   /** Sets the frame of the given batch element of the input layer. */
+   void setFrame(int batchElement, Request const &request);
+
+   /**
+    * Gathers the output layer's activity of the given batch element and, on the root process,
+    * sends its nonzero values to the requester.
+    */
+   void replyWithCode(int batchElement, Request const &request, int batchSize);
+
+   void recordLatency(std::chrono::steady_clock::time_point receivedTime);
+
+  private:
+   HyPerCol *mHyPerCol                = nullptr;
+   ImageFromMemoryBuffer *mInputLayer = nullptr;
+   HyPerLayer *mOutputLayer           = nullptr;
+   int mStepsPerBatch                 = 1;
+   int mBatchWidth                    = 1;
+   bool mIsRoot                       = false;
+
+   std::string mSocketPath;
+   int mListenSocket     = -1;
+   int mNextConnectionId = 0;
+   std::map<int, Connection> mConnections;
+   std::deque<Request> mPending;
+   bool mShutdownRequested   = false;
+   int mShutdownConnectionId = -1;
+
+   std::int64_t mNumRequests = 0;
+   std::int64_t mNumBatches  = 0;
+   std::vector<double> mLatencies; // milliseconds, one per frame request served
+};
+
+} // namespace PV
+
+#endif // INFERENCESERVER_HPP_
@@ -8,7 +8,9 @@
 #include "cMakeHeader.h"
 #include "columns/CommandLineArguments.hpp"
 #include "columns/ConfigFileArguments.hpp"
+#include "columns/DecompositionSearch.hpp"
 #include "columns/HyPerCol.hpp"
+#include "io/io.hpp"
 #include "utils/PVLog.hpp"
 #include <csignal>
 #ifdef PV_USE_OPENMP_THREADS
@@ -88,13 +90,51 @@ int PV_Init::initialize() {
    delete params;
    params                 = nullptr;
    std::string paramsFile = arguments->getStringArgument("ParamsFile");
-   if (!paramsFile.empty()) {
+   if (!paramsFile.empty() or !mParamsString.empty()) {
       status = createParams();
    }
+   if (status == PV_SUCCESS and chooseDecomposition()) {
+      return initialize();
+   }
    printInitMessage();
    return status;
 }
 
+bool PV_Init::chooseDecomposition() {
+   if (params == nullptr or !arguments->getBooleanArgument("AutoDecomposition")) {
+      return false;
+   }
+   if (arguments->getIntegerArgument("NumRows") != 0
+       or arguments->getIntegerArgument("NumColumns") != 0
+       or arguments->getIntegerArgument("BatchWidth") != 0) {
+      return false;
+   }
+   int numProcesses;
+   MPI_Comm_size(MPI_COMM_WORLD, &numProcesses);
+   DecompositionSearch search(numProcesses);
+   search.setCheckpointCellSize(
+         arguments->getIntegerArgument("CheckpointCellNumRows"),
+         arguments->getIntegerArgument("CheckpointCellNumColumns"),
+         arguments->getIntegerArgument("CheckpointCellBatchDimension"));
+   search.addParams(params);
+   DecompositionSearch::Candidate const best = search.findBest();
+   if (mCommunicator->globalCommRank() == 0) {
+      InfoLog().printf(
+            "Automatic decomposition of %d processes: %d rows, %d columns, batch width %d "
+            "(%g neuron updates and %g halo values per process)\n",
+            numProcesses,
+            best.mRows,
+            best.mColumns,
+            best.mBatchWidth,
+            best.mWork,
+            best.mHalo);
+   }
+   arguments->setIntegerArgument("NumRows", best.mRows);
+   arguments->setIntegerArgument("NumColumns", best.mColumns);
+   arguments->setIntegerArgument("BatchWidth", best.mBatchWidth);
+   return true;
+}
+
 int PV_Init::initMaxThreads() {
 #ifdef PV_USE_OPENMP_THREADS
    maxThreads = omp_get_max_threads();
@@ -180,20 +220,44 @@ int PV_Init::setParams(char const *params_file) {
       return PV_FAILURE;
    }
    arguments->setStringArgument("ParamsFile", std::string{params_file});
+   mParamsString.clear();
    initialize();
    return createParams();
 }
 
+int PV_Init::setParamsString(std::string const &paramsString) {
+   if (paramsString.empty()) {
+      return PV_FAILURE;
+   }
+   arguments->setStringArgument("ParamsFile", std::string{});
+   mParamsString = paramsString;
+   return initialize();
+}
+
 int PV_Init::createParams() {
    std::string paramsFile = arguments->getStringArgument("ParamsFile");
-   if (!paramsFile.empty()) {
+   if (!mParamsString.empty()) {
       delete params;
       params = new PVParams(
-            paramsFile.c_str(),
+            mParamsString.c_str(),
+            (long int)mParamsString.size(),
             2 * (INITIAL_LAYER_ARRAY_SIZE + INITIAL_CONNECTION_ARRAY_SIZE),
             mCommunicator);
       return PV_SUCCESS;
    }
+   else if (!paramsFile.empty()) {
+      std::string paramsCache = arguments->getStringArgument("ParamsCache");
+      if (!paramsCache.empty()) {
+         paramsCache = expandLeadingTilde(paramsCache);
+      }
+      delete params;
+      params = new PVParams(
+            paramsFile.c_str(),
+            2 * (INITIAL_LAYER_ARRAY_SIZE + INITIAL_CONNECTION_ARRAY_SIZE),
+            mCommunicator,
+            paramsCache);
+      return PV_SUCCESS;
+   }
    else {
       return PV_FAILURE;
    }
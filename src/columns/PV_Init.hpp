@@ -153,6 +153,14 @@ class PV_Init {
     */
    int setParams(char const *paramsFile);
 
+   /**
+    * setParamsString(paramsString) is the counterpart of setParams() for a program that holds the
+    * params in memory: it clears the ParamsFile argument and calls PV_Init::initialize, which
+    * creates the params by parsing paramsString. Every process must pass the same string.
+    * Return value is the status returned by PV_Init::initialize.
+    */
+   int setParamsString(std::string const &paramsString);
+
    /**
     * Sets the log file.  If the string argument is null, logging returns to the
     * default streams (probably cout and cerr).  The previous log file,
@@ -264,6 +272,15 @@ class PV_Init {
     */
    int createParams();
 
+   /**
+    * Called by initialize() after the params have been created. If the AutoDecomposition flag
+    * is set and none of NumRows, NumColumns and BatchWidth is, uses a DecompositionSearch of the
+    * params to choose them, sets them in the arguments, and returns true, so that initialize()
+    * recreates the Communicator and the PVParams with the new decomposition. Otherwise returns
+    * false. Settings given explicitly always take precedence.
+    */
+   bool chooseDecomposition();
+
    /**
     * Sends a timestamp and the effective command line to the InfoLog stream.
     * The effective command line is based on the current state of the arguments
@@ -276,6 +293,7 @@ class PV_Init {
    int mArgC = 0;
    std::vector<char const *> mArgV;
    PVParams *params;
+   std::string mParamsString; // Set by setParamsString; used instead of ParamsFile if nonempty.
    Arguments *arguments;
    int maxThreads;
    Communicator *mCommunicator;
@@ -9,6 +9,7 @@
 #include "checkpointing/CheckpointEntryDataStore.hpp"
 #include "include/pv_common.h"
 #include "utils/PVAssert.hpp"
+#include "utils/Tracer.hpp"
 
 namespace PV {
 
@@ -64,16 +65,34 @@ PVLayerCube Publisher::createCube(int delay) {
 
 void Publisher::updateActiveIndices(int delay) {
    if (store->isSparse()) {
+      bool const useRowLists = delay == 0 and mPublishedRowEntries != nullptr;
       for (int b = 0; b < store->getNumBuffers(); b++) {
          // Active indicies stored as local extended values
          if (*store->numActiveBuffer(b, delay) < 0L) {
-            store->updateActiveIndices(b, delay);
+            if (useRowLists) {
+               store->updateActiveIndices(
+                     b, delay, mLayerCube->loc, mPublishedRowEntries, mPublishedRowCounts);
+            }
+            else {
+               store->updateActiveIndices(b, delay);
+            }
          }
          pvAssert(*store->numActiveBuffer(b, delay) >= 0L);
       }
+      if (delay == 0) {
+         mPublishedRowEntries = nullptr;
+         mPublishedRowCounts  = nullptr;
+      }
    }
 }
 
+void Publisher::setRestrictedActiveIndices(
+      SparseList<float>::Entry const *rowEntries,
+      int const *rowCounts) {
+   mPendingRowEntries = rowEntries;
+   mPendingRowCounts  = rowCounts;
+}
+
 int Publisher::publish(double lastUpdateTime) {
    //
    // Everyone publishes border region to neighbors even if no subscribers.
@@ -92,6 +111,10 @@ int Publisher::publish(double lastUpdateTime) {
    for (int b = 0; b < store->getNumBuffers(); b++) {
       store->markActiveIndicesOutOfSync(b, 0);
    }
+   mPublishedRowEntries = mPendingRowEntries;
+   mPublishedRowCounts  = mPendingRowCounts;
+   mPendingRowEntries   = nullptr;
+   mPendingRowCounts    = nullptr;
    // Updating active indices is done after MPI wait in HyPerCol
    // to avoid race condition because exchangeBorders mpi is async
 
@@ -99,6 +122,8 @@ int Publisher::publish(double lastUpdateTime) {
 }
 
 void Publisher::copyForward(double lastUpdateTime) {
+   mPendingRowEntries = nullptr;
+   mPendingRowCounts  = nullptr;
    if (store->getNumLevels() > 1) {
       float *recvBuf  = recvBuffer(0); // Grab all of the buffer, allocated continuously
       size_t dataSize = mLayerCube->numItems * sizeof(float);
@@ -136,6 +161,9 @@ int Publisher::exchangeBorders(const PVLayerLoc *loc, int delay /*default 0*/) {
             requestsVector->end(), batchElementMPIRequest.begin(), batchElementMPIRequest.end());
       pvAssert(requestsVector->size() == (b + 1) * exchangeVectorSize);
    }
+   if (mMetrics) {
+      mMetrics->mHaloBytes += mBorderExchanger->getNumBytesPerExchange() * (std::size_t)loc->nbatch;
+   }
 
 #endif // PV_USE_MPI
 
@@ -172,8 +200,12 @@ int Publisher::wait(int delay /*default 0*/) {
 
    auto *requestsVector = mpiRequestsBuffer->getBuffer(delay, 0);
    if (!requestsVector->empty()) {
+      std::uint64_t const waitStart = Tracer::now();
       mBorderExchanger->wait(*requestsVector);
       pvAssert(requestsVector->empty());
+      if (mMetrics) {
+         mMetrics->mMPIWaitTime += Tracer::now() - waitStart;
+      }
    }
    updateActiveIndices(delay);
 
@@ -182,6 +214,9 @@ int Publisher::wait(int delay /*default 0*/) {
 
 void Publisher::increaseTimeLevel() {
    wait(mpiRequestsBuffer->getNumLevels() - 1);
+   // Delay zero is about to become delay one, so the lists no longer describe delay zero.
+   mPublishedRowEntries = nullptr;
+   mPublishedRowCounts  = nullptr;
    mpiRequestsBuffer->newLevel();
    store->newLevelIndex();
 }
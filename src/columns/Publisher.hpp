@@ -15,6 +15,7 @@
 #include "include/pv_types.h"
 #include "structures/MPIBlock.hpp"
 #include "utils/BorderExchange.hpp"
+#include "utils/MetricsRegistry.hpp"
 
 namespace PV {
 
@@ -43,6 +44,12 @@ class Publisher {
    int exchangeBorders(const PVLayerLoc *loc, int delay = 0);
    int isExchangeFinished(int delay = 0);
 
+   /**
+    * Sets the performance counters that border exchanges report into: the halo bytes sent,
+    * and the time spent waiting for the exchanges to complete.
+    */
+   void setMetrics(PerformanceCounters *metrics) { mMetrics = metrics; }
+
    /**
     * creates a PVLayerCube pointing to the data in the data store at the given delay.
     * This method blocks until any pending border exchange for that delay level are completed.
@@ -56,6 +63,20 @@ class Publisher {
    void updateAllActiveIndices();
    void updateActiveIndices(int delay = 0);
 
+   /**
+    * Gives the publisher lists of the nonzero values in each restricted row of the cube, in the
+    * layout of DataStore::updateActiveIndices(). The next call to publish() uses them to find the
+    * active indices of the data it publishes, so that only the margins need to be scanned. The
+    * lists must not change until the active indices of delay zero have been updated. If the cube
+    * is not published before the next call to copyForward(), the lists are not used.
+    */
+   void setRestrictedActiveIndices(
+         SparseList<float>::Entry const *rowEntries,
+         int const *rowCounts);
+
+   /** Returns the number of bytes held by the data store. */
+   std::size_t getMemorySize() const { return store->getMemorySize(); }
+
   private:
    float *recvBuffer(int bufferId) { return store->buffer(bufferId); }
    float *recvBuffer(int bufferId, int delay) { return store->buffer(bufferId, delay); }
@@ -77,6 +98,14 @@ class Publisher {
    PVLayerCube *mLayerCube;
 
    BorderExchange *mBorderExchanger = nullptr;
+   PerformanceCounters *mMetrics    = nullptr;
+
+   // The lists passed to setRestrictedActiveIndices(), and the lists that describe the data
+   // published at delay zero, whose active indices have not been updated yet.
+   SparseList<float>::Entry const *mPendingRowEntries   = nullptr;
+   int const *mPendingRowCounts                         = nullptr;
+   SparseList<float>::Entry const *mPublishedRowEntries = nullptr;
+   int const *mPublishedRowCounts                       = nullptr;
 
    RingBuffer<std::vector<MPI_Request>> *mpiRequestsBuffer = nullptr;
    // std::vector<MPI_Request> requests;
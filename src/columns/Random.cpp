@@ -8,6 +8,7 @@
 #include "Random.hpp"
 #include "columns/RandomSeed.hpp"
 #include "utils/PVLog.hpp"
+#include "utils/Philox.hpp"
 
 namespace PV {
 
@@ -18,8 +19,9 @@ Random::Random() {
 }
 
 // N independent random number generators, all processes have the same N seeds.
-Random::Random(int count) {
+Random::Random(int count, RandomSeed::Generator generator) {
    initialize_base();
+   mGenerator = generator;
    initializeFromCount((unsigned int)count);
 }
 
@@ -30,8 +32,9 @@ Random::Random(int count) {
 // The seed of each RNG is determined by *global* index; this way the initial
 // state of the
 // random number does not depend on the MPI configuration.
-Random::Random(const PVLayerLoc *locptr, bool isExtended) {
+Random::Random(const PVLayerLoc *locptr, bool isExtended, RandomSeed::Generator generator) {
    initialize_base();
+   mGenerator = generator;
    initializeFromLoc(locptr, isExtended);
 }
 
@@ -60,6 +63,20 @@ int Random::initializeFromLoc(const PVLayerLoc *locptr, bool isExtended) {
    int nxGlobalExt  = locptr->nxGlobal + halo.lt + halo.rt;
    int nyGlobalExt  = locptr->nyGlobal + halo.up + halo.dn;
    int nbatchGlobal = locptr->nbatchGlobal;
+   if (isCounterBased()) {
+      // The seeds are allocated as for the Tausworthe generator, so that the seeds of other
+      // objects do not depend on the choice of generator.
+      int numTotalSeeds   = nxGlobalExt * nyGlobalExt * nf * nbatchGlobal;
+      mKey[0]             = RandomSeed::instance()->allocate(numTotalSeeds);
+      mLocalRowSize       = nxExt * nf;
+      mLocalRowsPerBatch  = nyExt;
+      mGlobalRowSize      = nxGlobalExt * nf;
+      mGlobalRowsPerBatch = nyGlobalExt;
+      mRowOffset          = locptr->ky0;
+      mColumnOffset       = locptr->kx0 * nf;
+      mBatchOffset        = locptr->kb0;
+      return status;
+   }
    // Allocate buffer to store rngArraySize
    rngArray.resize(rngCount);
    if (status == PV_SUCCESS) {
@@ -71,7 +88,11 @@ int Random::initializeFromLoc(const PVLayerLoc *locptr, bool isExtended) {
       int syGlobal          = nxGlobalExt * nf;
 
       // Only thing that is continuous in memory is nx and ny, so loop over batch
-      // and y
+      // and y. Each generator's seed depends only on its global index, so the rows can be
+      // seeded in parallel.
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for collapse(2)
+#endif // PV_USE_OPENMP_THREADS
       for (int kb = 0; kb < nbatch; kb++) {
          for (int ky = 0; ky < nyExt; ky++) {
             // Calculate start index into local rngArray
@@ -89,24 +110,160 @@ int Random::initializeFromLoc(const PVLayerLoc *locptr, bool isExtended) {
 
 int Random::initializeFromCount(int count) {
    int status = PV_SUCCESS;
+   if (isCounterBased()) {
+      mKey[0] = RandomSeed::instance()->allocate(count);
+      return status;
+   }
    rngArray.resize(count);
    if (status == PV_SUCCESS) {
       unsigned int seedBase = RandomSeed::instance()->allocate(count);
-      cl_random_init(rngArray.data(), (size_t)count, seedBase);
+      // cl_random_init seeds each generator from seedBase plus its index, so seeding in blocks
+      // gives the same states as seeding all at once.
+      int const blockSize = 4096;
+      int const numBlocks = (count + blockSize - 1) / blockSize;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif // PV_USE_OPENMP_THREADS
+      for (int block = 0; block < numBlocks; block++) {
+         int const start = block * blockSize;
+         int const size  = count - start < blockSize ? count - start : blockSize;
+         cl_random_init(&rngArray[start], (size_t)size, seedBase + (unsigned int)start);
+      }
    }
    return status;
 }
 
 float Random::uniformRandom(int localIndex) {
+   pvAssert(!isCounterBased());
    rngArray[localIndex] = cl_random_get(rngArray[localIndex]);
    return rngArray[localIndex].s0 / (float)randomUIntMax();
 }
 
 unsigned int Random::randomUInt(int localIndex) {
+   pvAssert(!isCounterBased());
    rngArray[localIndex] = cl_random_get(rngArray[localIndex]);
    return rngArray[localIndex].s0;
 }
 
+std::uint32_t Random::globalIndex(int localIndex) const {
+   if (mLocalRowSize == 0) {
+      return (std::uint32_t)localIndex;
+   }
+   int const row       = localIndex / mLocalRowSize;
+   int const column    = localIndex - row * mLocalRowSize;
+   int const b         = row / mLocalRowsPerBatch;
+   int const y         = row - b * mLocalRowsPerBatch;
+   int const globalRow = (b + mBatchOffset) * mGlobalRowsPerBatch + y + mRowOffset;
+   return (std::uint32_t)globalRow * (std::uint32_t)mGlobalRowSize
+          + (std::uint32_t)(column + mColumnOffset);
+}
+
+int Random::contiguousCount(int localIndex, int count) const {
+   if (mLocalRowSize == 0) {
+      return count;
+   }
+   int const rowRemaining = mLocalRowSize - localIndex % mLocalRowSize;
+   return rowRemaining < count ? rowRemaining : count;
+}
+
+unsigned int Random::counterUInt(int localIndex, long step, unsigned int position) const {
+   FatalIf(!isCounterBased(), "Random::counterUInt requires the Philox generator.\n");
+   std::uint32_t const counter[4] = {globalIndex(localIndex),
+                                     (std::uint32_t)step,
+                                     (std::uint32_t)((unsigned long)step >> 32),
+                                     (std::uint32_t)(position / 4U)};
+   std::uint32_t result[4];
+   philox4x32(counter, mKey, result);
+   return result[position % 4U];
+}
+
+float Random::counterUniform(int localIndex, long step, unsigned int position) const {
+   return philoxToUniform(counterUInt(localIndex, step, position));
+}
+
+void Random::fillUInt(
+      unsigned int *values,
+      int localIndex,
+      int count,
+      long step,
+      unsigned int position) const {
+   FatalIf(!isCounterBased(), "Random::fillUInt requires the Philox generator.\n");
+   std::uint32_t const stepLow  = (std::uint32_t)step;
+   std::uint32_t const stepHigh = (std::uint32_t)((unsigned long)step >> 32);
+   std::uint32_t const block    = position / 4U;
+   unsigned int const lane      = position % 4U;
+   int k                        = 0;
+   while (k < count) {
+      // Within a run, consecutive local indices have consecutive global indices, so that the
+      // counters of the run differ only in their first word.
+      int const runLength      = contiguousCount(localIndex + k, count - k);
+      std::uint32_t const base = globalIndex(localIndex + k);
+      unsigned int *runValues  = &values[k];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int n = 0; n < runLength; n++) {
+         std::uint32_t const counter[4] = {base + (std::uint32_t)n, stepLow, stepHigh, block};
+         std::uint32_t result[4];
+         philox4x32(counter, mKey, result);
+         runValues[n] = result[lane];
+      }
+      k += runLength;
+   }
+}
+
+void Random::fillUniform(
+      float *values,
+      int localIndex,
+      int count,
+      long step,
+      unsigned int position) const {
+   FatalIf(!isCounterBased(), "Random::fillUniform requires the Philox generator.\n");
+   std::uint32_t const stepLow  = (std::uint32_t)step;
+   std::uint32_t const stepHigh = (std::uint32_t)((unsigned long)step >> 32);
+   std::uint32_t const block    = position / 4U;
+   unsigned int const lane      = position % 4U;
+   int k                        = 0;
+   while (k < count) {
+      int const runLength      = contiguousCount(localIndex + k, count - k);
+      std::uint32_t const base = globalIndex(localIndex + k);
+      float *runValues         = &values[k];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int n = 0; n < runLength; n++) {
+         std::uint32_t const counter[4] = {base + (std::uint32_t)n, stepLow, stepHigh, block};
+         std::uint32_t result[4];
+         philox4x32(counter, mKey, result);
+         runValues[n] = philoxToUniform(result[lane]);
+      }
+      k += runLength;
+   }
+}
+
+void Random::fillUniformSequence(
+      float *values,
+      int localIndex,
+      long step,
+      unsigned int firstPosition,
+      int count) const {
+   FatalIf(!isCounterBased(), "Random::fillUniformSequence requires the Philox generator.\n");
+   // Each evaluation of the Philox function gives four consecutive positions.
+   std::uint32_t counter[4] = {globalIndex(localIndex),
+                               (std::uint32_t)step,
+                               (std::uint32_t)((unsigned long)step >> 32),
+                               0U};
+   std::uint32_t result[4];
+   unsigned int position = firstPosition;
+   for (int k = 0; k < count; k++, position++) {
+      if (k == 0 or position % 4U == 0U) {
+         counter[3] = (std::uint32_t)(position / 4U);
+         philox4x32(counter, mKey, result);
+      }
+      values[k] = philoxToUniform(result[position % 4U]);
+   }
+}
+
 Random::~Random() {}
 
 } /* namespace PV */
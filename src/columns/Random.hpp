@@ -21,18 +21,41 @@
 #ifndef RANDOM_HPP_
 #define RANDOM_HPP_
 
+#include "columns/RandomSeed.hpp"
+#include "include/PVLayerLoc.h"
+#include "utils/PVAssert.hpp"
 #include "utils/cl_random.h"
+#include <cstdint>
 #include <vector>
 
 namespace PV {
 
+/**
+ * With the PHILOX generator, the object keeps no per-index state. The numbers for an index form a
+ * separate sequence for each timestep, and the position-th number of that sequence is computed
+ * directly from the global index, the timestep and the position by the Philox4x32 function, keyed
+ * by the seed the object was allocated. The numbers therefore do not depend on the MPI
+ * configuration, the number of threads or the order of the calls, and there is nothing to
+ * checkpoint. The methods that use per-index state (getRNG, and the uniformRandom and randomUInt
+ * methods without a step argument) are not available with this generator; use counterUniform,
+ * counterUInt, fillUniform, fillUInt and fillUniformSequence instead.
+ */
 class Random {
   public:
-   Random(int count);
-   Random(const PVLayerLoc *locptr, bool isExtended);
+   Random(int count, RandomSeed::Generator generator = RandomSeed::TAUSWORTHE);
+   Random(
+         const PVLayerLoc *locptr,
+         bool isExtended,
+         RandomSeed::Generator generator = RandomSeed::TAUSWORTHE);
    virtual ~Random();
 
-   taus_uint4 *getRNG(int index) { return &rngArray[index]; }
+   RandomSeed::Generator getGenerator() const { return mGenerator; }
+   bool isCounterBased() const { return mGenerator == RandomSeed::PHILOX; }
+
+   taus_uint4 *getRNG(int index) {
+      pvAssert(!isCounterBased());
+      return &rngArray[index];
+   }
    float uniformRandom(int localIndex = 0);
    float uniformRandom(int localIndex, float min, float max) {
       return min + uniformRandom(localIndex) * (max - min);
@@ -53,17 +76,81 @@ class Random {
    }
    static inline unsigned int randomUIntMax() { return CL_RANDOM_MAX; }
 
+   /**
+    * Returns the given number of the sequence for the given index and timestep. Requires the
+    * PHILOX generator.
+    */
+   unsigned int counterUInt(int localIndex, long step, unsigned int position) const;
+
+   /** As counterUInt, but converted to a float uniformly distributed on [0, 1). */
+   float counterUniform(int localIndex, long step, unsigned int position) const;
+
+   /**
+    * Sets values[k] to counterUInt(localIndex + k, step, position) for k = 0, ..., count - 1.
+    * The loop is vectorized.
+    */
+   void fillUInt(
+         unsigned int *values,
+         int localIndex,
+         int count,
+         long step,
+         unsigned int position) const;
+
+   /** Sets values[k] to counterUniform(localIndex + k, step, position) for k < count. */
+   void fillUniform(
+         float *values,
+         int localIndex,
+         int count,
+         long step,
+         unsigned int position) const;
+
+   /**
+    * Sets values[k] to counterUniform(localIndex, step, firstPosition + k) for k < count: count
+    * consecutive numbers of the sequence of a single index.
+    */
+   void fillUniformSequence(
+         float *values,
+         int localIndex,
+         long step,
+         unsigned int firstPosition,
+         int count) const;
+
   protected:
    Random();
    int initializeFromCount(int count);
    int initializeFromLoc(const PVLayerLoc *locptr, bool isExtended);
 
+   /**
+    * Returns the global index of the given local index. The global index is the same for a
+    * neuron whatever the MPI configuration.
+    */
+   std::uint32_t globalIndex(int localIndex) const;
+
+   /**
+    * Returns the number of local indices, starting at localIndex, that have consecutive global
+    * indices, up to count.
+    */
+   int contiguousCount(int localIndex, int count) const;
+
   private:
    int initialize_base();
 
    // Member variables
   protected:
+   RandomSeed::Generator mGenerator = RandomSeed::TAUSWORTHE;
    std::vector<taus_uint4> rngArray;
+
+   // The key of the Philox function, and the geometry that converts local indices to global
+   // indices. mLocalRowSize is zero if the object was created from a count, in which case the
+   // global index is the local index.
+   std::uint32_t mKey[2]   = {0U, 0U};
+   int mLocalRowSize       = 0;
+   int mLocalRowsPerBatch  = 0;
+   int mGlobalRowSize      = 0;
+   int mGlobalRowsPerBatch = 0;
+   int mRowOffset          = 0;
+   int mColumnOffset       = 0;
+   int mBatchOffset        = 0;
 };
 
 } /* namespace PV */
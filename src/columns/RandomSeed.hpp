@@ -12,11 +12,25 @@ namespace PV {
 
 class RandomSeed {
   public:
+   /**
+    * The kinds of random number generator that Random provides. TAUSWORTHE keeps the state of a
+    * Tausworthe generator for each index; PHILOX computes each number from its index, the
+    * timestep and its position in the sequence for that timestep, and keeps no state.
+    */
+   enum Generator { TAUSWORTHE, PHILOX };
+
    static RandomSeed *instance();
    void initialize(unsigned int initialSeed);
    unsigned int allocate(unsigned int numRequested);
    unsigned int getInitialSeed() { return mInitialSeed; }
 
+   /**
+    * Sets the generator that objects which support both kinds should use. HyPerCol sets it from
+    * its randomGenerator parameter.
+    */
+   void setGenerator(Generator generator) { mGenerator = generator; }
+   Generator getGenerator() const { return mGenerator; }
+
   private:
    RandomSeed();
    virtual ~RandomSeed() {}
@@ -28,6 +42,7 @@ class RandomSeed {
    unsigned int mNextSeed    = 0U;
    unsigned int mInitialSeed = 0U;
    bool mInitialized         = false;
+   Generator mGenerator      = TAUSWORTHE;
    // minSeed needs to be high enough that for the pseudorandom sequence to be
    // good,
    // but must be less than (and should be much less than) ULONG_MAX/2
@@ -7,6 +7,7 @@
 
 #include "Weights.hpp"
 #include "checkpointing/CheckpointEntryWeightPvp.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "utils/PVAssert.hpp"
 #include "utils/conversions.h"
 #include <cstring>
@@ -52,6 +53,8 @@ void Weights::initialize(
 #endif // PV_USE_CUDA
 }
 
+Weights::~Weights() { MemoryTracker::instance()->release(mName, mMemoryCategory, mMemorySize); }
+
 void Weights::initialize(Weights const *baseWeights) {
    auto geometry = baseWeights->getGeometry();
    initialize(
@@ -94,6 +97,8 @@ void Weights::allocateDataStructures() {
       for (int arbor = 0; arbor < mNumArbors; arbor++) {
          mData[arbor].resize(numDataPatches * numItemsPerPatch);
       }
+      mMemorySize += sizeof(float) * (std::size_t)mNumArbors * (std::size_t)numDataPatches
+                     * (std::size_t)numItemsPerPatch;
    }
    if (mSharedFlag and getNumDataPatches() > 0) {
       int const numPatches = mGeometry->getNumPatches();
@@ -101,7 +106,9 @@ void Weights::allocateDataStructures() {
       for (int p = 0; p < numPatches; p++) {
          dataIndexLookupTable[p] = calcDataIndexFromPatchIndex(p);
       }
+      mMemorySize += sizeof(int) * (std::size_t)numPatches;
    }
+   MemoryTracker::instance()->allocate(mName, mMemoryCategory, mMemorySize);
 #ifdef PV_USE_CUDA
    if (mUsingGPUFlag) {
       allocateCudaBuffers();
@@ -68,7 +68,7 @@ class Weights {
          double timestamp);
 
    /** The destructor for Weights. */
-   virtual ~Weights() {}
+   virtual ~Weights();
 
    /**
     * An initializer that uses the specified PatchGeometry object as its patch geometry.
@@ -107,6 +107,13 @@ class Weights {
     */
    void allocateDataStructures();
 
+   /**
+    * Sets the category under which allocateDataStructures() records the patch data with the
+    * MemoryTracker, under the Weights object's name. The default is "weights"; an object holding
+    * weight changes, for example, can use a different category to be reported separately.
+    */
+   void setMemoryCategory(std::string const &category) { mMemoryCategory = category; }
+
    void checkpointWeightPvp(Checkpointer *checkpointer, char const *bufferName, bool compressFlag);
 
    /** Calculates the minimum value of the patch data over all arbors. For nonshared weights, only
@@ -301,6 +308,9 @@ class Weights {
 
    bool mWeightsArePlastic = false;
 
+   std::string mMemoryCategory = "weights";
+   std::size_t mMemorySize     = 0U;
+
 #ifdef PV_USE_CUDA
    bool mUsingGPUFlag                           = false;
    PVCuda::CudaDevice *mCudaDevice              = nullptr;
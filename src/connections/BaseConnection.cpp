@@ -9,6 +9,8 @@
 #include "columns/HyPerCol.hpp"
 #include "columns/ObjectMapComponent.hpp"
 #include "utils/MapLookupByType.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Tracer.hpp"
 
 namespace PV {
 
@@ -19,6 +21,7 @@ BaseConnection::BaseConnection() {}
 BaseConnection::~BaseConnection() {
    deleteComponents();
    delete mIOTimer;
+   MemoryTracker::instance()->releaseOwner(name);
 }
 
 int BaseConnection::initialize(char const *name, HyPerCol *hc) {
@@ -169,9 +172,21 @@ Response::Status BaseConnection::registerData(Checkpointer *checkpointer) {
          parent->getCommunicator()->globalCommRank() == 0 /*printFlag*/);
    mIOTimer = new Timer(getName(), "conn", "io");
    checkpointer->registerTimer(mIOTimer);
+   mDeliveryObject->setMetrics(
+         checkpointer->getMetricsRegistry()->addCounters(std::string(getName()), "delivery"));
    return status;
 }
 
+int BaseConnection::deliver() {
+   std::uint64_t const start = Tracer::now();
+   mDeliveryObject->deliver();
+   PerformanceCounters *metrics = mDeliveryObject->getMetrics();
+   if (metrics) {
+      metrics->mComputeTime += Tracer::now() - start;
+   }
+   return PV_SUCCESS;
+}
+
 void BaseConnection::deleteComponents() {
    mComponentTable.clear(true); // Deletes each component and clears the component table
 }
@@ -34,12 +34,10 @@ class BaseConnection : public BaseObject, public Subject {
    virtual Response::Status respond(std::shared_ptr<BaseMessage const> message) override;
 
    /**
-    * The function that calls the DeliveryObject's deliver method
+    * The function that calls the DeliveryObject's deliver method, and adds the time it took
+    * to the delivery object's performance counters.
     */
-   int deliver() {
-      mDeliveryObject->deliver();
-      return PV_SUCCESS;
-   }
+   int deliver();
 
    void deliverUnitInput(float *recvBuffer) { mDeliveryObject->deliverUnitInput(recvBuffer); }
 
@@ -53,6 +51,9 @@ class BaseConnection : public BaseObject, public Subject {
    ChannelType getChannelCode() const { return mDeliveryObject->getChannelCode(); }
    bool getReceiveGpu() const { return mDeliveryObject->getReceiveGpu(); }
 
+   /** The delivery's performance counters, or null before registerData() has been called. */
+   PerformanceCounters const *getDeliveryMetrics() const { return mDeliveryObject->getMetrics(); }
+
   protected:
    BaseConnection();
 
@@ -18,7 +18,10 @@ HyPerConn::HyPerConn(char const *name, HyPerCol *hc) { initialize(name, hc); }
 
 HyPerConn::HyPerConn() {}
 
-HyPerConn::~HyPerConn() { delete mUpdateTimer; }
+HyPerConn::~HyPerConn() {
+   delete mUpdateTimer;
+   delete mNormalizeTimer;
+}
 
 int HyPerConn::initialize(char const *name, HyPerCol *hc) {
    int status = BaseConnection::initialize(name, hc);
@@ -190,8 +193,15 @@ HyPerConn::respondConnectionUpdate(std::shared_ptr<ConnectionUpdateMessage const
 
 Response::Status
 HyPerConn::respondConnectionNormalize(std::shared_ptr<ConnectionNormalizeMessage const> message) {
-   return notify(
+   if (mNormalizeTimer) {
+      mNormalizeTimer->start();
+   }
+   auto status = notify(
          mComponentTable, message, parent->getCommunicator()->globalCommRank() == 0 /*printFlag*/);
+   if (mNormalizeTimer) {
+      mNormalizeTimer->stop();
+   }
+   return status;
 }
 
 Response::Status HyPerConn::initializeState() {
@@ -207,6 +217,10 @@ Response::Status HyPerConn::registerData(Checkpointer *checkpointer) {
       if (mWeightUpdater) {
          mUpdateTimer = new Timer(getName(), "conn", "update");
          checkpointer->registerTimer(mUpdateTimer);
+         // Plastic connections are renormalized after each weight update, so the time spent
+         // normalizing is reported separately from the update itself.
+         mNormalizeTimer = new Timer(getName(), "conn", "normalize");
+         checkpointer->registerTimer(mNormalizeTimer);
       }
    }
    return status;
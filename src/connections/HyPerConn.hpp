@@ -104,7 +104,8 @@ class HyPerConn : public BaseConnection {
    NormalizeBase *mWeightNormalizer   = nullptr;
    BaseWeightUpdater *mWeightUpdater  = nullptr;
 
-   Timer *mUpdateTimer = nullptr;
+   Timer *mUpdateTimer    = nullptr;
+   Timer *mNormalizeTimer = nullptr;
 
 }; // class HyPerConn
 
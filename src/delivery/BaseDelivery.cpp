@@ -130,4 +130,15 @@ BaseDelivery::communicateInitInfo(std::shared_ptr<CommunicateInitInfoMessage con
    return Response::SUCCESS;
 }
 
+void BaseDelivery::countDelivery(
+      std::uint64_t numActive,
+      std::uint64_t numSynapticOps,
+      std::uint64_t numBytes) {
+   if (mMetrics) {
+      mMetrics->mActiveNeurons += numActive;
+      mMetrics->mSynapticOps += numSynapticOps;
+      mMetrics->mBytesMoved += numBytes;
+   }
+}
+
 } // namespace PV
@@ -11,6 +11,7 @@
 #include "columns/BaseObject.hpp"
 #include "components/ConnectionData.hpp"
 #include "layers/HyPerLayer.hpp"
+#include "utils/MetricsRegistry.hpp"
 
 namespace PV {
 
@@ -56,6 +57,13 @@ class BaseDelivery : public BaseObject {
    HyPerLayer *getPreLayer() const { return mPreLayer; }
    HyPerLayer *getPostLayer() const { return mPostLayer; }
 
+   /**
+    * Sets the performance counters that deliver() reports into. The connection that owns
+    * the delivery object creates the counters when it registers its data.
+    */
+   virtual void setMetrics(PerformanceCounters *metrics) { mMetrics = metrics; }
+   PerformanceCounters *getMetrics() const { return mMetrics; }
+
   protected:
    BaseDelivery() {}
 
@@ -68,6 +76,16 @@ class BaseDelivery : public BaseObject {
    virtual Response::Status
    communicateInitInfo(std::shared_ptr<CommunicateInitInfoMessage const> message) override;
 
+   /**
+    * Adds the work of one delivery to the performance counters, if they have been set:
+    * the number of presynaptic neurons that contributed, the number of synaptic operations,
+    * and an estimate of the bytes of weights, activity and GSyn touched.
+    */
+   void countDelivery(
+         std::uint64_t numActive,
+         std::uint64_t numSynapticOps,
+         std::uint64_t numBytes);
+
   protected:
    ChannelType mChannelCode = CHANNEL_EXC;
    bool mReceiveGpu         = false;
@@ -75,6 +93,7 @@ class BaseDelivery : public BaseObject {
    ConnectionData *mConnectionData = nullptr;
    HyPerLayer *mPreLayer           = nullptr;
    HyPerLayer *mPostLayer          = nullptr;
+   PerformanceCounters *mMetrics   = nullptr;
    // Rather than the layers, should we store the buffers and the PVLayerLoc data?
 };
 
@@ -191,6 +191,13 @@ void HyPerDeliveryFacade::deliverUnitInput(float *recvBuffer) {
    }
 }
 
+void HyPerDeliveryFacade::setMetrics(PerformanceCounters *metrics) {
+   BaseDelivery::setMetrics(metrics);
+   if (mDeliveryIntern) {
+      mDeliveryIntern->setMetrics(metrics);
+   }
+}
+
 bool HyPerDeliveryFacade::isAllInputReady() {
    return getChannelCode() == CHANNEL_NOUPDATE ? true : mDeliveryIntern->isAllInputReady();
 }
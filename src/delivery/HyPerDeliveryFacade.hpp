@@ -62,6 +62,11 @@ class HyPerDeliveryFacade : public BaseDelivery {
 
    virtual bool isAllInputReady() override;
 
+   /**
+    * Sets the performance counters of both the facade and the HyPerDelivery object it owns.
+    */
+   virtual void setMetrics(PerformanceCounters *metrics) override;
+
    HyPerDelivery::AccumulateType getAccumulateType() const { return mAccumulateType; }
 
    bool getUpdateGSynFromPostPerspective() const { return mUpdateGSynFromPostPerspective; }
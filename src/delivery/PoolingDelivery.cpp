@@ -10,6 +10,7 @@
 #include "columns/ObjectMapComponent.hpp"
 #include "delivery/accumulate_functions.hpp"
 #include "utils/MapLookupByType.hpp"
+#include "utils/MemoryTracker.hpp"
 
 namespace PV {
 
@@ -257,6 +258,10 @@ void PoolingDelivery::allocateThreadGSyn() {
          mThreadGSyn[th].resize(mPostLayer->getNumNeurons());
          mThreadGateIdxBuffer[th].resize(mPostLayer->getNumNeurons());
       }
+      std::size_t const threadBufferSize =
+            sizeof(float) * (std::size_t)numThreads * (std::size_t)mPostLayer->getNumNeurons();
+      MemoryTracker::instance()->allocate(name, "thread GSyn", threadBufferSize);
+      MemoryTracker::instance()->allocate(name, "thread gate indices", threadBufferSize);
    }
 }
 
@@ -279,6 +284,12 @@ void PoolingDelivery::deliver() {
          deliverPresynapticPerspective();
       }
    }
+   // Estimated as each presynaptic neuron contributing to one pooling patch of postsynaptic
+   // neurons, whichever perspective was used.
+   std::uint64_t const numPre = (std::uint64_t)mPreLayer->getNumExtendedAllBatches();
+   std::uint64_t const numSynapses =
+         numPre * (std::uint64_t)mPatchSize->getPatchSizeX() * mPatchSize->getPatchSizeY();
+   countDelivery(numPre, numSynapses, numSynapses * 2U * sizeof(float));
 #ifdef PV_USE_CUDA
    mPostLayer->setUpdatedDeviceGSynFlag(!mReceiveGpu);
 #endif // PV_USE_CUDA
@@ -152,6 +152,13 @@ void PostsynapticPerspectiveConvolveDelivery::deliver() {
             }
          }
       }
+      // Each postsynaptic neuron reads one weight and one activity value per synapse.
+      std::uint64_t const numSynapses = (std::uint64_t)nbatch * (std::uint64_t)numPostRestricted
+                                        * (std::uint64_t)postWeights->getPatchSizeOverall();
+      countDelivery(
+            (std::uint64_t)nbatch * (std::uint64_t)mPreLayer->getNumExtended(),
+            numSynapses,
+            numSynapses * 2U * sizeof(float));
    }
 #ifdef PV_USE_CUDA
    // CPU updated GSyn, now need to update GSyn on GPU
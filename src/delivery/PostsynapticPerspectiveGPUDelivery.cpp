@@ -292,6 +292,13 @@ void PostsynapticPerspectiveGPUDelivery::deliver() {
       // Make sure local sizes are divisible by f, x, and y
       mRecvKernel->run(totX, totY, totF, 1L, 1L, 1L);
 
+      std::uint64_t const numSynapses = (std::uint64_t)nbatch * (std::uint64_t)numPostRestricted
+                                        * (std::uint64_t)weights->getPatchSizeOverall();
+      countDelivery(
+            (std::uint64_t)nbatch * (std::uint64_t)numPreExtended,
+            numSynapses,
+            numSynapses * 2U * sizeof(float));
+
 #ifdef PV_USE_CUDNN
       mRecvKernel->permuteGSynCudnnToPV(getChannelCode());
 #endif
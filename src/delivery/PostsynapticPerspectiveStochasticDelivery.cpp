@@ -7,6 +7,8 @@
 
 #include "PostsynapticPerspectiveStochasticDelivery.hpp"
 #include "columns/HyPerCol.hpp"
+#include "utils/MemoryTracker.hpp"
+#include <cmath>
 
 namespace PV {
 
@@ -59,10 +61,29 @@ Response::Status PostsynapticPerspectiveStochasticDelivery::allocateDataStructur
    if (!Response::completed(status)) {
       return status;
    }
-   mRandState = new Random(mPostLayer->getLayerLoc(), false /*restricted, not extended*/);
+   mRandState = new Random(
+         mPostLayer->getLayerLoc(),
+         false /*restricted, not extended*/,
+         RandomSeed::instance()->getGenerator());
+   if (mRandState->isCounterBased()) {
+      // A buffer for each thread, for the random numbers of one row of a patch.
+      Weights *postWeights   = mWeightsPair->getPostWeights();
+      mRandomDrawsPerThread  = postWeights->getPatchSizeX() * postWeights->getPatchSizeF();
+      std::size_t const size = (std::size_t)parent->getNumThreads() * mRandomDrawsPerThread;
+      mRandomDraws.resize(size);
+      MemoryTracker::instance()->allocate(name, "random draws", sizeof(float) * size);
+   }
    return Response::SUCCESS;
 }
 
+float *PostsynapticPerspectiveStochasticDelivery::getRandomDraws() {
+   int thread = 0;
+#ifdef PV_USE_OPENMP_THREADS
+   thread = omp_get_thread_num();
+#endif // PV_USE_OPENMP_THREADS
+   return &mRandomDraws[(std::size_t)thread * mRandomDrawsPerThread];
+}
+
 void PostsynapticPerspectiveStochasticDelivery::deliver() {
    // Check if we need to update based on connection's channel
    if (getChannelCode() == CHANNEL_NOUPDATE) {
@@ -105,6 +126,7 @@ void PostsynapticPerspectiveStochasticDelivery::deliver() {
       int yPatchSize        = postWeights->getPatchSizeY();
       int numPerStride      = postWeights->getPatchSizeX() * postWeights->getPatchSizeF();
       int neuronIndexStride = targetNf < 4 ? 1 : targetNf / 4;
+      long step             = (long)nearbyint(parent->simulationTime() / parent->getDeltaTime());
 
       for (int b = 0; b < nbatch; b++) {
          int sourceNxExt       = sourceNx + sourceHalo->rt + sourceHalo->lt;
@@ -123,8 +145,7 @@ void PostsynapticPerspectiveStochasticDelivery::deliver() {
 #endif
             for (int feature = 0; feature < neuronIndexStride; feature++) {
                for (int idx = feature; idx < numPostRestricted; idx += neuronIndexStride) {
-                  float *gSyn     = gSynPatchHeadBatch + idx;
-                  taus_uint4 *rng = mRandState->getRNG(idx);
+                  float *gSyn = gSynPatchHeadBatch + idx;
 
                   int idxExtended = kIndexExtended(
                         idx,
@@ -151,16 +172,38 @@ void PostsynapticPerspectiveStochasticDelivery::deliver() {
                   float *weightValues = weightBuf + ky * syp;
 
                   float dv = 0.0f;
-                  for (int k = 0; k < numPerStride; ++k) {
-                     *rng     = cl_random_get(*rng);
-                     double p = (double)rng->s0 / cl_random_max(); // 0.0 < p < 1.0
-                     dv += (p < (double)(a[k] * mDeltaTimeFactor)) * weightValues[k];
+                  if (mRandState->isCounterBased()) {
+                     float *draws = getRandomDraws();
+                     mRandState->fillUniformSequence(
+                           draws,
+                           b * numPostRestricted + idx,
+                           step,
+                           (unsigned int)((arbor * yPatchSize + ky) * numPerStride),
+                           numPerStride);
+                     for (int k = 0; k < numPerStride; ++k) {
+                        dv += (draws[k] < a[k] * mDeltaTimeFactor) * weightValues[k];
+                     }
+                  }
+                  else {
+                     taus_uint4 *rng = mRandState->getRNG(idx);
+                     for (int k = 0; k < numPerStride; ++k) {
+                        *rng     = cl_random_get(*rng);
+                        double p = (double)rng->s0 / cl_random_max(); // 0.0 < p < 1.0
+                        dv += (p < (double)(a[k] * mDeltaTimeFactor)) * weightValues[k];
+                     }
                   }
                   *gSyn += dv;
                }
             }
          }
       }
+      // Each postsynaptic neuron reads one weight and one activity value per synapse.
+      std::uint64_t const numSynapses = (std::uint64_t)nbatch * (std::uint64_t)numPostRestricted
+                                        * (std::uint64_t)postWeights->getPatchSizeOverall();
+      countDelivery(
+            (std::uint64_t)nbatch * (std::uint64_t)mPreLayer->getNumExtended(),
+            numSynapses,
+            numSynapses * 2U * sizeof(float));
    }
 #ifdef PV_USE_CUDA
    // CPU updated GSyn, now need to update GSyn on GPU
@@ -187,6 +230,7 @@ void PostsynapticPerspectiveStochasticDelivery::deliverUnitInput(float *recvBuff
    int yPatchSize        = postWeights->getPatchSizeY();
    int numPerStride      = postWeights->getPatchSizeX() * postWeights->getPatchSizeF();
    int neuronIndexStride = targetNf < 4 ? 1 : targetNf / 4;
+   long step             = (long)nearbyint(parent->simulationTime() / parent->getDeltaTime());
 
    int numAxonalArbors = mArborList->getNumAxonalArbors();
    for (int arbor = 0; arbor < numAxonalArbors; arbor++) {
@@ -203,7 +247,6 @@ void PostsynapticPerspectiveStochasticDelivery::deliverUnitInput(float *recvBuff
             for (int feature = 0; feature < neuronIndexStride; feature++) {
                for (int idx = feature; idx < numPostRestricted; idx += neuronIndexStride) {
                   float *recvLocation = recvBatch + idx;
-                  taus_uint4 *rng     = mRandState->getRNG(idx);
 
                   int kTargetExt = kIndexExtended(
                         idx,
@@ -218,10 +261,27 @@ void PostsynapticPerspectiveStochasticDelivery::deliverUnitInput(float *recvBuff
                   float *weightValues = weightBuf + ky * syp;
 
                   float dv = 0.0f;
-                  for (int k = 0; k < numPerStride; ++k) {
-                     *rng     = cl_random_get(*rng);
-                     double p = (double)rng->s0 / cl_random_max(); // 0.0 < p < 1.0
-                     dv += (p < (double)mDeltaTimeFactor) * weightValues[k];
+                  if (mRandState->isCounterBased()) {
+                     // The unit input draws from the second half of each sequence, so that it
+                     // does not reuse the numbers that deliver() uses in the same timestep.
+                     float *draws = getRandomDraws();
+                     mRandState->fillUniformSequence(
+                           draws,
+                           b * numPostRestricted + idx,
+                           step,
+                           (1U << 31) + (unsigned int)((arbor * yPatchSize + ky) * numPerStride),
+                           numPerStride);
+                     for (int k = 0; k < numPerStride; ++k) {
+                        dv += (draws[k] < mDeltaTimeFactor) * weightValues[k];
+                     }
+                  }
+                  else {
+                     taus_uint4 *rng = mRandState->getRNG(idx);
+                     for (int k = 0; k < numPerStride; ++k) {
+                        *rng     = cl_random_get(*rng);
+                        double p = (double)rng->s0 / cl_random_max(); // 0.0 < p < 1.0
+                        dv += (p < (double)mDeltaTimeFactor) * weightValues[k];
+                     }
                   }
                   *recvLocation += mDeltaTimeFactor * dv;
                }
@@ -67,9 +67,17 @@ class PostsynapticPerspectiveStochasticDelivery : public HyPerDelivery {
 
    void allocateThreadGSyn();
 
+   /**
+    * Returns the calling thread's buffer for the random numbers of one row of a patch. Used only
+    * with a counter-based generator.
+    */
+   float *getRandomDraws();
+
    // Data members
   protected:
    Random *mRandState = nullptr;
+   std::vector<float> mRandomDraws;
+   std::size_t mRandomDrawsPerThread = 0;
 
 }; // end class PostsynapticPerspectiveStochasticDelivery
 
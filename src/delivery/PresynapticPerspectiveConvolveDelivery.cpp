@@ -7,6 +7,7 @@
 
 #include "PresynapticPerspectiveConvolveDelivery.hpp"
 #include "columns/HyPerCol.hpp"
+#include "utils/MemoryTracker.hpp"
 
 namespace PV {
 
@@ -68,6 +69,10 @@ void PresynapticPerspectiveConvolveDelivery::allocateThreadGSyn() {
       for (auto &th : mThreadGSyn) {
          th.resize(mPostLayer->getNumNeurons());
       }
+      MemoryTracker::instance()->allocate(
+            name,
+            "thread GSyn",
+            sizeof(float) * (std::size_t)numThreads * (std::size_t)mPostLayer->getNumNeurons());
    }
 }
 
@@ -219,6 +224,10 @@ void PresynapticPerspectiveConvolveDelivery::deliver() {
                }
             }
          }
+         // Every visited presynaptic neuron touches one weight and one GSyn value per synapse.
+         std::uint64_t const numSynapses =
+               (std::uint64_t)numNeurons * (std::uint64_t)weights->getPatchSizeOverall();
+         countDelivery((std::uint64_t)numNeurons, numSynapses, numSynapses * 3U * sizeof(float));
 #ifdef PV_USE_OPENMP_THREADS
          // Accumulate back into gSyn. Should this be done in HyPerLayer where it can be done once,
          // as opposed to once per connection?
@@ -7,6 +7,7 @@
 
 #include "PresynapticPerspectiveGPUDelivery.hpp"
 #include "columns/HyPerCol.hpp"
+#include "utils/MemoryTracker.hpp"
 
 namespace PV {
 
@@ -192,6 +193,10 @@ void PresynapticPerspectiveGPUDelivery::allocateThreadGSyn() {
       for (auto &th : mThreadGSyn) {
          th.resize(mPostLayer->getNumNeurons());
       }
+      MemoryTracker::instance()->allocate(
+            name,
+            "thread GSyn",
+            sizeof(float) * (std::size_t)numThreads * (std::size_t)mPostLayer->getNumNeurons());
    }
 }
 
@@ -279,6 +284,13 @@ void PresynapticPerspectiveGPUDelivery::deliver() {
 
       long totPatchSize   = (long)weights->getPatchSizeOverall();
       long totThreads     = maxTotalActiveNeuron * totPatchSize;
+
+      std::uint64_t numActive = 0U;
+      for (int b = 0; b < parent->getNBatch(); b++) {
+         numActive += (std::uint64_t)totActiveNeuron[b];
+      }
+      std::uint64_t const numSynapses = numActive * (std::uint64_t)totPatchSize;
+      countDelivery(numActive, numSynapses, numSynapses * 3U * sizeof(float));
       int maxThreads      = parent->getDevice()->get_max_threads();
       int numLocalThreads = totPatchSize < maxThreads ? totPatchSize : maxThreads;
 
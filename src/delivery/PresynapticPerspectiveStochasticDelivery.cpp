@@ -7,6 +7,8 @@
 
 #include "PresynapticPerspectiveStochasticDelivery.hpp"
 #include "columns/HyPerCol.hpp"
+#include "utils/MemoryTracker.hpp"
+#include <cmath>
 
 // Note: there is a lot of code duplication between PresynapticPerspectiveConvolveDelivery
 // and PresynapticPerspectiveStochasticDelivery.
@@ -74,11 +76,34 @@ void PresynapticPerspectiveStochasticDelivery::allocateThreadGSyn() {
       for (auto &th : mThreadGSyn) {
          th.resize(mPostLayer->getNumNeurons());
       }
+      MemoryTracker::instance()->allocate(
+            name,
+            "thread GSyn",
+            sizeof(float) * (std::size_t)numThreads * (std::size_t)mPostLayer->getNumNeurons());
    }
 }
 
 void PresynapticPerspectiveStochasticDelivery::allocateRandState() {
-   mRandState = new Random(mPreLayer->getLayerLoc(), true /*need RNGs in the extended buffer*/);
+   mRandState = new Random(
+         mPreLayer->getLayerLoc(),
+         true /*need RNGs in the extended buffer*/,
+         RandomSeed::instance()->getGenerator());
+   if (mRandState->isCounterBased()) {
+      // A buffer for each thread, for the random numbers of one row of a patch.
+      Weights *weights       = mWeightsPair->getPreWeights();
+      mRandomDrawsPerThread  = weights->getPatchSizeX() * weights->getPatchSizeF();
+      std::size_t const size = (std::size_t)parent->getNumThreads() * mRandomDrawsPerThread;
+      mRandomDraws.resize(size);
+      MemoryTracker::instance()->allocate(name, "random draws", sizeof(float) * size);
+   }
+}
+
+float *PresynapticPerspectiveStochasticDelivery::getRandomDraws() {
+   int thread = 0;
+#ifdef PV_USE_OPENMP_THREADS
+   thread = omp_get_thread_num();
+#endif // PV_USE_OPENMP_THREADS
+   return &mRandomDraws[(std::size_t)thread * mRandomDrawsPerThread];
 }
 
 void PresynapticPerspectiveStochasticDelivery::deliver() {
@@ -107,6 +132,14 @@ void PresynapticPerspectiveStochasticDelivery::deliver() {
 
    bool const preLayerIsSparse = mPreLayer->getSparseFlag();
 
+   // With a counter-based generator, the random numbers of a presynaptic neuron are numbered by
+   // the position of the weight in the unshrunken patch, so that they do not depend on how the
+   // patch is shrunken at the edges of the process's region.
+   int const numPreExtendedLocal = mPreLayer->getNumExtended();
+   int const patchSize           = weights->getPatchSizeOverall();
+
+   long const step = (long)nearbyint(parent->simulationTime() / parent->getDeltaTime());
+
    int numAxonalArbors = mArborList->getNumAxonalArbors();
    for (int arbor = 0; arbor < numAxonalArbors; arbor++) {
       int delay                = mArborList->getDelay(arbor);
@@ -174,14 +207,28 @@ void PresynapticPerspectiveStochasticDelivery::deliver() {
                   const int nk                 = patch->nx * weights->getPatchSizeF();
                   float const *weightDataHead  = weights->getDataFromPatchIndex(arbor, kPreExt);
                   float const *weightDataStart = &weightDataHead[patch->offset];
-                  taus_uint4 *rng              = mRandState->getRNG(kPreExt);
-                  long along                   = (long)((double)a * cl_random_max());
 
                   float *v                  = postPatchStart + y * sy;
                   float const *weightValues = weightDataStart + y * syw;
-                  for (int k = 0; k < nk; k++) {
-                     *rng = cl_random_get(*rng);
-                     v[k] += (rng->s0 < along) * weightValues[k];
+                  if (mRandState->isCounterBased()) {
+                     float *draws = getRandomDraws();
+                     mRandState->fillUniformSequence(
+                           draws,
+                           b * numPreExtendedLocal + kPreExt,
+                           step,
+                           (unsigned int)(arbor * patchSize + patch->offset + y * syw),
+                           nk);
+                     for (int k = 0; k < nk; k++) {
+                        v[k] += (draws[k] < a) * weightValues[k];
+                     }
+                  }
+                  else {
+                     taus_uint4 *rng = mRandState->getRNG(kPreExt);
+                     long along      = (long)((double)a * cl_random_max());
+                     for (int k = 0; k < nk; k++) {
+                        *rng = cl_random_get(*rng);
+                        v[k] += (rng->s0 < along) * weightValues[k];
+                     }
                   }
                }
             }
@@ -223,18 +270,36 @@ void PresynapticPerspectiveStochasticDelivery::deliver() {
                   const int nk                 = patch->nx * weights->getPatchSizeF();
                   float const *weightDataHead  = weights->getDataFromPatchIndex(arbor, kPreExt);
                   float const *weightDataStart = &weightDataHead[patch->offset];
-                  taus_uint4 *rng              = mRandState->getRNG(kPreExt);
-                  long along                   = (long)((double)a * cl_random_max());
 
                   float *v                  = postPatchStart + y * sy;
                   float const *weightValues = weightDataStart + y * syw;
-                  for (int k = 0; k < nk; k++) {
-                     *rng = cl_random_get(*rng);
-                     v[k] += (rng->s0 < along) * weightValues[k];
+                  if (mRandState->isCounterBased()) {
+                     float *draws = getRandomDraws();
+                     mRandState->fillUniformSequence(
+                           draws,
+                           b * numPreExtendedLocal + kPreExt,
+                           step,
+                           (unsigned int)(arbor * patchSize + patch->offset + y * syw),
+                           nk);
+                     for (int k = 0; k < nk; k++) {
+                        v[k] += (draws[k] < a) * weightValues[k];
+                     }
+                  }
+                  else {
+                     taus_uint4 *rng = mRandState->getRNG(kPreExt);
+                     long along      = (long)((double)a * cl_random_max());
+                     for (int k = 0; k < nk; k++) {
+                        *rng = cl_random_get(*rng);
+                        v[k] += (rng->s0 < along) * weightValues[k];
+                     }
                   }
                }
             }
          }
+         // Every visited presynaptic neuron touches one weight and one GSyn value per synapse.
+         std::uint64_t const numSynapses =
+               (std::uint64_t)numNeurons * (std::uint64_t)weights->getPatchSizeOverall();
+         countDelivery((std::uint64_t)numNeurons, numSynapses, numSynapses * 3U * sizeof(float));
 #ifdef PV_USE_OPENMP_THREADS
          // Accumulate back into gSyn. Should this be done in HyPerLayer where it can be done once,
          // as opposed to once per connection?
@@ -271,6 +336,11 @@ void PresynapticPerspectiveStochasticDelivery::deliverUnitInput(float *recvBuffe
    const int sy  = postLoc->nx * postLoc->nf; // stride in restricted layer
    const int syw = weights->getGeometry()->getPatchStrideY(); // stride in patch
 
+   int const numPreExtendedLocal = mPreLayer->getNumExtended();
+   int const patchSize           = weights->getPatchSizeOverall();
+
+   long const step = (long)nearbyint(parent->simulationTime() / parent->getDeltaTime());
+
    int const numAxonalArbors = mArborList->getNumAxonalArbors();
    for (int arbor = 0; arbor < numAxonalArbors; arbor++) {
       int delay                = mArborList->getDelay(arbor);
@@ -324,14 +394,30 @@ void PresynapticPerspectiveStochasticDelivery::deliverUnitInput(float *recvBuffe
                const int nk                 = patch->nx * weights->getPatchSizeF();
                float const *weightDataHead  = weights->getDataFromPatchIndex(arbor, kPreExt);
                float const *weightDataStart = &weightDataHead[patch->offset];
-               taus_uint4 *rng              = mRandState->getRNG(kPreExt);
-               long along                   = (long)cl_random_max();
 
                float *v                  = postPatchStart + y * sy;
                float const *weightValues = weightDataStart + y * syw;
-               for (int k = 0; k < nk; k++) {
-                  *rng = cl_random_get(*rng);
-                  v[k] += (rng->s0 < along) * weightValues[k];
+               if (mRandState->isCounterBased()) {
+                  // The unit input draws from the second half of each sequence, so that it does
+                  // not reuse the numbers that deliver() uses in the same timestep.
+                  float *draws = getRandomDraws();
+                  mRandState->fillUniformSequence(
+                        draws,
+                        b * numPreExtendedLocal + kPreExt,
+                        step,
+                        (1U << 31) + (unsigned int)(arbor * patchSize + patch->offset + y * syw),
+                        nk);
+                  for (int k = 0; k < nk; k++) {
+                     v[k] += (draws[k] < a) * weightValues[k];
+                  }
+               }
+               else {
+                  taus_uint4 *rng = mRandState->getRNG(kPreExt);
+                  long along      = (long)cl_random_max();
+                  for (int k = 0; k < nk; k++) {
+                     *rng = cl_random_get(*rng);
+                     v[k] += (rng->s0 < along) * weightValues[k];
+                  }
                }
             }
          }
@@ -69,10 +69,18 @@ class PresynapticPerspectiveStochasticDelivery : public HyPerDelivery {
 
    void allocateRandState();
 
+   /**
+    * Returns the calling thread's buffer for the random numbers of one row of a patch. Used only
+    * with a counter-based generator.
+    */
+   float *getRandomDraws();
+
    // Data members
   protected:
    std::vector<std::vector<float>> mThreadGSyn;
    Random *mRandState = nullptr;
+   std::vector<float> mRandomDraws;
+   std::size_t mRandomDrawsPerThread = 0;
 }; // end class PresynapticPerspectiveStochasticDelivery
 
 } // end namespace PV
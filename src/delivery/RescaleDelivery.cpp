@@ -95,6 +95,9 @@ void RescaleDelivery::deliver() {
             }
          }
       }
+      std::uint64_t const numSynapses = (std::uint64_t)(
+            preActivityCube.isSparse ? preActivityCube.numActive[b] : numPostRestricted);
+      countDelivery(numSynapses, numSynapses, numSynapses * 3U * sizeof(float));
    }
 #ifdef PV_USE_CUDA
    mPostLayer->setUpdatedDeviceGSynFlag(!mReceiveGpu);
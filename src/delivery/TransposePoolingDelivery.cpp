@@ -7,6 +7,7 @@
 
 #include "TransposePoolingDelivery.hpp"
 #include "columns/HyPerCol.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "columns/ObjectMapComponent.hpp"
 #include "components/OriginalConnNameParam.hpp"
 #include "connections/PoolingConn.hpp"
@@ -246,6 +247,10 @@ void TransposePoolingDelivery::allocateThreadGSyn() {
       for (auto &th : mThreadGSyn) {
          th.resize(mPostLayer->getNumNeurons());
       }
+      MemoryTracker::instance()->allocate(
+            name,
+            "thread GSyn",
+            sizeof(float) * (std::size_t)numThreads * (std::size_t)mPostLayer->getNumNeurons());
    }
 }
 
@@ -268,6 +273,12 @@ void TransposePoolingDelivery::deliver() {
          deliverPresynapticPerspective();
       }
    }
+   // Estimated as each presynaptic neuron contributing to one pooling patch of postsynaptic
+   // neurons, whichever perspective was used.
+   std::uint64_t const numPre = (std::uint64_t)mPreLayer->getNumExtendedAllBatches();
+   std::uint64_t const numSynapses =
+         numPre * (std::uint64_t)mPatchSize->getPatchSizeX() * mPatchSize->getPatchSizeY();
+   countDelivery(numPre, numSynapses, numSynapses * 2U * sizeof(float));
 }
 
 void TransposePoolingDelivery::deliverPostsynapticPerspective() {
@@ -89,6 +89,7 @@ void InitVFromFile::readDenseActivityPvp(
    std::size_t frameSize   = (std::size_t)header.recordSize * sizeof(float) + sizeof(double);
    int numFrames           = header.nBands;
    int blockBatchDimension = mpiBlock->getBatchDimension();
+   BufferUtils::SparseFileTable frameTable;
    for (int m = 0; m < blockBatchDimension; m++) {
       for (int b = 0; b < loc->nbatch; b++) {
          int globalBatchIndex = (mpiBlock->getStartBatch() + m) * loc->nbatch + b;
@@ -99,8 +100,15 @@ void InitVFromFile::readDenseActivityPvp(
             fileStream.setOutPos(sizeof(header) + frameIndex * sizeof(float) * frameSize, true);
             int xStart = header.nx * mpiBlock->getStartColumn() / mpiBlock->getNumColumns();
             int yStart = header.ny * mpiBlock->getStartRow() / mpiBlock->getNumRows();
-            pvpBuffer.resize(header.nx, header.ny, header.nf);
-            BufferUtils::readFrameWindow(fileStream, &pvpBuffer, header, xStart, yStart, 0);
+            if (header.dataType == BufferUtils::LOSSLESS_FLOAT) {
+               // A compressed frame cannot be read piecewise; read all of it and shift the window.
+               BufferUtils::readDenseFromPvp(mVfilename, &pvpBuffer, frameIndex, &frameTable);
+               pvpBuffer.translate(-xStart, -yStart);
+            }
+            else {
+               pvpBuffer.resize(header.nx, header.ny, header.nf);
+               BufferUtils::readFrameWindow(fileStream, &pvpBuffer, header, xStart, yStart, 0);
+            }
          }
          else {
             pvpBuffer.resize(loc->nx, loc->ny, loc->nf);
@@ -0,0 +1,44 @@
+#ifndef ASYNCPRINTSTREAM_HPP_
+#define ASYNCPRINTSTREAM_HPP_
+
+#include "io/AsyncWriter.hpp"
+#include "io/PrintStream.hpp"
+#include <memory>
+#include <sstream>
+
+namespace PV {
+
+/**
+ * A PrintStream that collects its output in memory. Each call to submit() hands the text
+ * collected since the previous call to an AsyncWriter, whose thread writes it to the target
+ * stream. The AsyncPrintStream takes ownership of the target stream, and deletes it when
+ * all of its text has been written.
+ */
+class AsyncPrintStream : public PrintStream {
+  public:
+   AsyncPrintStream(PrintStream *target, std::shared_ptr<AsyncWriter> writer)
+         : mTarget(target), mWriter(writer) {
+      setOutStream(mBuffer);
+   }
+
+   virtual ~AsyncPrintStream() {
+      submit();
+      mWriter->flush();
+      delete mTarget;
+   }
+
+   /** Passes the text collected so far to the writer, and empties the buffer. */
+   void submit() {
+      mWriter->submit(mTarget, mBuffer.str());
+      mBuffer.str(std::string());
+   }
+
+  private:
+   PrintStream *mTarget;
+   std::shared_ptr<AsyncWriter> mWriter;
+   std::ostringstream mBuffer;
+};
+
+} // namespace PV
+
+#endif // ASYNCPRINTSTREAM_HPP_
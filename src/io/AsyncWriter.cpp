@@ -0,0 +1,55 @@
+#include "AsyncWriter.hpp"
+
+namespace PV {
+
+AsyncWriter::AsyncWriter() { mThread = std::thread(&AsyncWriter::run, this); }
+
+AsyncWriter::~AsyncWriter() {
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStopping = true;
+   }
+   mBlockSubmitted.notify_one();
+   mThread.join();
+}
+
+void AsyncWriter::submit(PrintStream *stream, std::string &&text) {
+   if (text.empty()) {
+      return;
+   }
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mQueue.push_back(Block{stream, std::move(text)});
+   }
+   mBlockSubmitted.notify_one();
+}
+
+void AsyncWriter::flush() {
+   std::unique_lock<std::mutex> lock(mMutex);
+   while (mWriting or !mQueue.empty()) {
+      mBlockWritten.wait(lock);
+   }
+}
+
+void AsyncWriter::run() {
+   std::unique_lock<std::mutex> lock(mMutex);
+   while (true) {
+      while (mQueue.empty() and !mStopping) {
+         mBlockSubmitted.wait(lock);
+      }
+      if (mQueue.empty()) {
+         break; // stopping, and nothing left to write
+      }
+      Block block = std::move(mQueue.front());
+      mQueue.pop_front();
+      mWriting = true;
+      lock.unlock();
+      (*block.mStream) << block.mText;
+      block.mStream->flush();
+      lock.lock();
+      mWriting = false;
+      mBlockWritten.notify_all();
+   }
+}
+
+} // namespace PV
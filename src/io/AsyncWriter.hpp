@@ -0,0 +1,54 @@
+#ifndef ASYNCWRITER_HPP_
+#define ASYNCWRITER_HPP_
+
+#include "io/PrintStream.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace PV {
+
+/**
+ * Owns a background thread that writes blocks of text to PrintStreams, so that the thread that
+ * produces the text does not wait on file I/O. Blocks are written in the order they are submitted,
+ * and each stream is flushed after each block is written to it.
+ *
+ * Once a stream has been passed to submit(), only the writer thread may touch it until flush()
+ * has returned.
+ */
+class AsyncWriter {
+  public:
+   AsyncWriter();
+
+   /** Writes any blocks still pending, then stops the background thread. */
+   ~AsyncWriter();
+
+   /** Queues the text to be written to the stream, and returns without waiting. */
+   void submit(PrintStream *stream, std::string &&text);
+
+   /** Blocks until all the text submitted so far has been written. */
+   void flush();
+
+  private:
+   struct Block {
+      PrintStream *mStream;
+      std::string mText;
+   };
+
+   void run();
+
+  private:
+   std::mutex mMutex;
+   std::condition_variable mBlockSubmitted;
+   std::condition_variable mBlockWritten;
+   std::deque<Block> mQueue;
+   bool mWriting  = false;
+   bool mStopping = false;
+   std::thread mThread;
+};
+
+} // namespace PV
+
+#endif // ASYNCWRITER_HPP_
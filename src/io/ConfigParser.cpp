@@ -105,6 +105,16 @@ std::string ConfigParser::createString(
       int numRows,
       int numColumns,
       int batchWidth,
+      bool autoDecompositionFlag,
+      std::string const &traceFile,
+      bool useDefaultBenchmarkWarmup,
+      int benchmarkWarmup,
+      bool benchmarkQuietFlag,
+      std::string const &costCalibrationFile,
+      std::string const &serveSocket,
+      std::string const &serveInput,
+      std::string const &serveOutput,
+      std::string const &paramsCacheFile,
       bool dryRunFlag) {
    std::string configString;
    FatalIf(
@@ -152,6 +162,36 @@ std::string ConfigParser::createString(
    if (batchWidth) {
       configString.append("BatchWidth:").append(std::to_string(batchWidth)).append("\n");
    }
+   if (autoDecompositionFlag) {
+      configString.append("AutoDecomposition:true\n");
+   }
+   if (!traceFile.empty()) {
+      configString.append("TraceFile:").append(traceFile).append("\n");
+   }
+   if (useDefaultBenchmarkWarmup) {
+      configString.append("Benchmark:-\n");
+   }
+   else if (benchmarkWarmup >= 0) {
+      configString.append("Benchmark:").append(std::to_string(benchmarkWarmup)).append("\n");
+   }
+   if (benchmarkQuietFlag) {
+      configString.append("BenchmarkQuiet:true\n");
+   }
+   if (!costCalibrationFile.empty()) {
+      configString.append("CostCalibration:").append(costCalibrationFile).append("\n");
+   }
+   if (!serveSocket.empty()) {
+      configString.append("Serve:").append(serveSocket).append("\n");
+   }
+   if (!serveInput.empty()) {
+      configString.append("ServeInput:").append(serveInput).append("\n");
+   }
+   if (!serveOutput.empty()) {
+      configString.append("ServeOutput:").append(serveOutput).append("\n");
+   }
+   if (!paramsCacheFile.empty()) {
+      configString.append("ParamsCache:").append(paramsCacheFile).append("\n");
+   }
    if (dryRunFlag) {
       configString.append("DryRun:true\n");
    }
@@ -107,6 +107,16 @@ class ConfigParser {
          int numRows,
          int numColumns,
          int batchWidth,
+         bool autoDecompositionFlag,
+         std::string const &traceFile,
+         bool useDefaultBenchmarkWarmup,
+         int benchmarkWarmup,
+         bool benchmarkQuietFlag,
+         std::string const &costCalibrationFile,
+         std::string const &serveSocket,
+         std::string const &serveInput,
+         std::string const &serveOutput,
+         std::string const &paramsCacheFile,
          bool dryRunFlag);
 
    /**
@@ -141,6 +151,15 @@ class ConfigParser {
     *   NumRows (parseInteger)
     *   NumColumns (parseInteger)
     *   BatchWidth (parseInteger)
+    *   AutoDecomposition (parseBoolean)
+    *   TraceFile (parseString)
+    *   Benchmark (parseIntOptional)
+    *   BenchmarkQuiet (parseBoolean)
+    *   CostCalibration (parseString)
+    *   Serve (parseString)
+    *   ServeInput (parseString)
+    *   ServeOutput (parseString)
+    *   ParamsCache (parseString)
     *   DryRun (parseBoolean)
     * Any other argument names are ignored if the allowUnrecognizedArguments
     * flag is true, and cause an error if the flag is false.
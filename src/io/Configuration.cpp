@@ -18,9 +18,18 @@ Configuration::Configuration() {
    registerIntegerArgument("NumRows");
    registerIntegerArgument("NumColumns");
    registerIntegerArgument("BatchWidth");
+   registerBooleanArgument("AutoDecomposition");
    registerIntegerArgument("CheckpointCellNumRows");
    registerIntegerArgument("CheckpointCellNumColumns");
    registerIntegerArgument("CheckpointCellBatchDimension");
+   registerStringArgument("TraceFile");
+   registerIntOptionalArgument("Benchmark");
+   registerBooleanArgument("BenchmarkQuiet");
+   registerStringArgument("CostCalibration");
+   registerStringArgument("Serve");
+   registerStringArgument("ServeInput");
+   registerStringArgument("ServeOutput");
+   registerStringArgument("ParamsCache");
    registerBooleanArgument("DryRun");
 }
 
@@ -0,0 +1,596 @@
+#include "FileContainer.hpp"
+#include "io/io.hpp"
+#include "utils/PVAssert.hpp"
+#include "utils/PVLog.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace PV {
+
+namespace {
+
+char const containerMagic[8]         = {'P', 'V', 'C', 'N', 'T', 'N', 'R', '\0'};
+std::uint32_t const containerVersion = 1U;
+std::size_t const copyPieceSize      = (std::size_t)1 << 24;
+
+std::vector<FileContainer *> &mountTable() {
+   static std::vector<FileContainer *> table;
+   return table;
+}
+
+/**
+ * A read-only stream buffer over a region of memory, typically part of a memory-mapped
+ * container file. Reading through it does not copy the region.
+ */
+class MappedStreamBuffer : public std::streambuf {
+  public:
+   MappedStreamBuffer(char const *data, std::size_t size) {
+      char *begin = const_cast<char *>(data);
+      setg(begin, begin, begin + size);
+   }
+
+  protected:
+   virtual pos_type
+   seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+      if (!(which & std::ios_base::in)) {
+         return pos_type(off_type(-1));
+      }
+      off_type base = (off_type)0;
+      if (dir == std::ios_base::cur) {
+         base = gptr() - eback();
+      }
+      else if (dir == std::ios_base::end) {
+         base = egptr() - eback();
+      }
+      off_type target = base + off;
+      if (target < 0 or target > egptr() - eback()) {
+         return pos_type(off_type(-1));
+      }
+      setg(eback(), eback() + target, egptr());
+      return pos_type(target);
+   }
+
+   virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+      return seekoff(off_type(pos), std::ios_base::beg, which);
+   }
+};
+
+/**
+ * A growable in-memory stream buffer for entries being written. Unlike std::stringbuf, it
+ * has a single position shared by reading and writing, and allows seeking past the end,
+ * as a file does; writing past the end fills the gap with zeroes.
+ */
+class MemoryStreamBuffer : public std::streambuf {
+  public:
+   MemoryStreamBuffer(std::string const &contents) : mData(contents) {}
+
+   std::string const &getData() const { return mData; }
+
+  protected:
+   virtual std::streamsize xsputn(char const *s, std::streamsize n) override {
+      std::size_t const end = mPosition + (std::size_t)n;
+      if (end > mData.size()) {
+         mData.resize(end, '\0');
+      }
+      mData.replace(mPosition, (std::size_t)n, s, (std::size_t)n);
+      mPosition = end;
+      return n;
+   }
+
+   virtual int_type overflow(int_type c) override {
+      if (traits_type::eq_int_type(c, traits_type::eof())) {
+         return traits_type::not_eof(c);
+      }
+      char ch = traits_type::to_char_type(c);
+      xsputn(&ch, 1);
+      return c;
+   }
+
+   virtual std::streamsize xsgetn(char *s, std::streamsize n) override {
+      std::size_t available = mPosition < mData.size() ? mData.size() - mPosition : 0;
+      std::size_t numRead   = std::min((std::size_t)n, available);
+      memcpy(s, &mData[mPosition], numRead);
+      mPosition += numRead;
+      return (std::streamsize)numRead;
+   }
+
+   virtual int_type underflow() override {
+      if (mPosition >= mData.size()) {
+         return traits_type::eof();
+      }
+      return traits_type::to_int_type(mData[mPosition]);
+   }
+
+   virtual int_type uflow() override {
+      int_type c = underflow();
+      if (!traits_type::eq_int_type(c, traits_type::eof())) {
+         mPosition++;
+      }
+      return c;
+   }
+
+   virtual pos_type
+   seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+      off_type base = (off_type)0;
+      if (dir == std::ios_base::cur) {
+         base = (off_type)mPosition;
+      }
+      else if (dir == std::ios_base::end) {
+         base = (off_type)mData.size();
+      }
+      off_type target = base + off;
+      if (target < 0) {
+         return pos_type(off_type(-1));
+      }
+      mPosition = (std::size_t)target;
+      return pos_type(target);
+   }
+
+   virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+      return seekoff(off_type(pos), std::ios_base::beg, which);
+   }
+
+  private:
+   std::string mData;
+   std::size_t mPosition = (std::size_t)0;
+};
+
+void writeAt(int fd, void const *data, std::size_t size, off_t offset, std::string const &path) {
+   char const *bytes = static_cast<char const *>(data);
+   while (size > (std::size_t)0) {
+      ssize_t numWritten = pwrite(fd, bytes, size, offset);
+      FatalIf(
+            numWritten < 0,
+            "FileContainer failed writing %zu bytes at offset %ld of \"%s\": %s\n",
+            size,
+            (long)offset,
+            path.c_str(),
+            strerror(errno));
+      bytes += numWritten;
+      size -= (std::size_t)numWritten;
+      offset += (off_t)numWritten;
+   }
+}
+
+void readAt(int fd, void *data, std::size_t size, off_t offset, std::string const &path) {
+   char *bytes         = static_cast<char *>(data);
+   std::size_t numRead = (std::size_t)0;
+   while (numRead < size) {
+      ssize_t n = pread(fd, &bytes[numRead], size - numRead, offset + (off_t)numRead);
+      FatalIf(
+            n <= 0,
+            "FileContainer failed reading %zu bytes at offset %ld of \"%s\"\n",
+            size,
+            (long)offset,
+            path.c_str());
+      numRead += (std::size_t)n;
+   }
+}
+
+void verifyAt(int fd, void const *data, std::size_t size, off_t offset, std::string const &path) {
+   std::vector<char> check(size);
+   readAt(fd, check.data(), size, offset, path);
+   FatalIf(
+         size > (std::size_t)0 and memcmp(check.data(), data, size) != 0,
+         "Verify write failed when writing %zu bytes to position %ld of \"%s\"\n",
+         size,
+         (long)offset,
+         path.c_str());
+}
+
+void writeAtShared(MPI_File fileHandle, MPI_Offset offset, char const *data, std::size_t size) {
+   std::size_t const maxChunk = (std::size_t)1 << 30;
+   while (size > (std::size_t)0) {
+      int count = (int)std::min(size, maxChunk);
+      MPI_Status status;
+      int result = MPI_File_write_at(
+            fileHandle, offset, const_cast<char *>(data), count, MPI_CHAR, &status);
+      FatalIf(result != MPI_SUCCESS, "FileContainer: MPI_File_write_at failed.\n");
+      data += count;
+      size -= (std::size_t)count;
+      offset += (MPI_Offset)count;
+   }
+}
+
+void appendRecord(
+      std::string &toc,
+      std::string const &name,
+      std::uint64_t offset,
+      std::uint64_t size) {
+   std::uint32_t nameLength = (std::uint32_t)name.size();
+   toc.append(reinterpret_cast<char const *>(&offset), sizeof(offset));
+   toc.append(reinterpret_cast<char const *>(&size), sizeof(size));
+   toc.append(reinterpret_cast<char const *>(&nameLength), sizeof(nameLength));
+   toc.append(name);
+}
+
+} // end anonymous namespace
+
+std::size_t const FileContainer::alignment;
+
+FileContainer::FileContainer(std::string const &mountPoint) {
+   mMountPoint = expandLeadingTilde(mountPoint);
+   while (mMountPoint.size() > (std::size_t)1 and mMountPoint.back() == '/') {
+      mMountPoint.pop_back();
+   }
+   FatalIf(
+         isMountPoint(mMountPoint),
+         "FileContainer: \"%s\" is already a mount point.\n",
+         mMountPoint.c_str());
+   mountTable().push_back(this);
+}
+
+FileContainer::~FileContainer() {
+   auto &table = mountTable();
+   table.erase(std::remove(table.begin(), table.end(), this), table.end());
+   unmapFile();
+   if (mImageFd >= 0) {
+      close(mImageFd);
+      // An image that was not renamed into place by writeFile() is only a temporary file.
+      if (!mImageRenamed) {
+         unlink(mImagePath.c_str());
+      }
+   }
+}
+
+FileContainer *FileContainer::findMount(std::string const &path, std::string *entryName) {
+   for (auto *container : mountTable()) {
+      std::string const &mountPoint = container->mMountPoint;
+      std::size_t const length      = mountPoint.size();
+      if (path.size() > length + 1 and path.compare(0, length, mountPoint) == 0
+          and path[length] == '/' and path.find('/', length + 1) == std::string::npos) {
+         if (entryName) {
+            *entryName = path.substr(length + 1);
+         }
+         return container;
+      }
+   }
+   return nullptr;
+}
+
+bool FileContainer::isMountPoint(std::string const &path) {
+   std::string expanded = expandLeadingTilde(path);
+   while (expanded.size() > (std::size_t)1 and expanded.back() == '/') {
+      expanded.pop_back();
+   }
+   for (auto *container : mountTable()) {
+      if (container->mMountPoint == expanded) {
+         return true;
+      }
+   }
+   return false;
+}
+
+void FileContainer::openFile(std::string const &path, std::string const &blockName) {
+   unmapFile();
+   mEntries.clear();
+   int fd = open(path.c_str(), O_RDONLY);
+   FatalIf(fd < 0, "FileContainer unable to open \"%s\": %s\n", path.c_str(), strerror(errno));
+   struct stat fileStat;
+   FatalIf(
+         fstat(fd, &fileStat) != 0,
+         "FileContainer unable to stat \"%s\": %s\n",
+         path.c_str(),
+         strerror(errno));
+   mMappedSize = (std::size_t)fileStat.st_size;
+   FatalIf(
+         mMappedSize < sizeof(Header),
+         "FileContainer \"%s\" is too short to be a container.\n",
+         path.c_str());
+   mMappedFile = mmap(nullptr, mMappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+   FatalIf(
+         mMappedFile == MAP_FAILED,
+         "FileContainer unable to map \"%s\": %s\n",
+         path.c_str(),
+         strerror(errno));
+   close(fd);
+   madvise(mMappedFile, mMappedSize, MADV_WILLNEED);
+
+   char const *image = static_cast<char const *>(mMappedFile);
+   std::size_t size  = mMappedSize;
+   Header header;
+   memcpy(&header, image, sizeof(header));
+   if (header.contentType == BLOCKS) {
+      parseImage(image, size, path);
+      auto found = mEntries.find(blockName);
+      FatalIf(
+            found == mEntries.end(),
+            "FileContainer \"%s\" has no block \"%s\".\n",
+            path.c_str(),
+            blockName.c_str());
+      image = found->second.mMappedData;
+      size  = found->second.mSize;
+      mEntries.clear();
+   }
+   parseImage(image, size, path);
+}
+
+void FileContainer::parseImage(char const *image, std::size_t size, std::string const &path) {
+   Header header;
+   FatalIf(size < sizeof(header), "FileContainer \"%s\": truncated header.\n", path.c_str());
+   memcpy(&header, image, sizeof(header));
+   FatalIf(
+         memcmp(header.magic, containerMagic, sizeof(containerMagic)) != 0,
+         "\"%s\" is not a PetaVision file container.\n",
+         path.c_str());
+   FatalIf(
+         header.version != containerVersion,
+         "FileContainer \"%s\" has version %u; only version %u is supported.\n",
+         path.c_str(),
+         header.version,
+         containerVersion);
+   FatalIf(
+         header.tocOffset + header.tocSize > size,
+         "FileContainer \"%s\": table of contents extends past the end of the container.\n",
+         path.c_str());
+   char const *record    = image + header.tocOffset;
+   char const *recordEnd = record + header.tocSize;
+   for (std::uint64_t n = 0; n < header.numEntries; n++) {
+      std::uint64_t offset, entrySize;
+      std::uint32_t nameLength;
+      std::size_t const fixedSize = sizeof(offset) + sizeof(entrySize) + sizeof(nameLength);
+      FatalIf(
+            record + fixedSize > recordEnd,
+            "FileContainer \"%s\": corrupt table of contents.\n",
+            path.c_str());
+      memcpy(&offset, record, sizeof(offset));
+      memcpy(&entrySize, record + sizeof(offset), sizeof(entrySize));
+      memcpy(&nameLength, record + sizeof(offset) + sizeof(entrySize), sizeof(nameLength));
+      record += fixedSize;
+      FatalIf(
+            record + nameLength > recordEnd or offset + entrySize > size,
+            "FileContainer \"%s\": corrupt table of contents.\n",
+            path.c_str());
+      Entry &entry      = mEntries[std::string(record, (std::size_t)nameLength)];
+      entry.mMappedData = image + offset;
+      entry.mSize       = (std::size_t)entrySize;
+      record += nameLength;
+   }
+}
+
+void FileContainer::unmapFile() {
+   if (mMappedFile != nullptr) {
+      munmap(mMappedFile, mMappedSize);
+      mMappedFile = nullptr;
+      mMappedSize = (std::size_t)0;
+   }
+}
+
+bool FileContainer::hasEntry(std::string const &name) const {
+   return mEntries.find(name) != mEntries.end();
+}
+
+std::string FileContainer::readEntry(Entry const &entry) const {
+   if (entry.mMappedData) {
+      return std::string(entry.mMappedData, entry.mSize);
+   }
+   std::string contents(entry.mSize, '\0');
+   readAt(mImageFd, &contents[0], entry.mSize, (off_t)entry.mOffset, mImagePath);
+   return contents;
+}
+
+std::streambuf *FileContainer::createBuffer(std::string const &name, std::ios_base::openmode mode) {
+   auto found = mEntries.find(name);
+   if (!(mode & std::ios_base::out)) {
+      if (found == mEntries.end()) {
+         return nullptr;
+      }
+      if (found->second.mMappedData) {
+         return new MappedStreamBuffer(found->second.mMappedData, found->second.mSize);
+      }
+      return new MemoryStreamBuffer(readEntry(found->second));
+   }
+   std::string initialContents;
+   bool keepContents = (mode & (std::ios_base::in | std::ios_base::app | std::ios_base::ate))
+                       and !(mode & std::ios_base::trunc);
+   if (keepContents and found != mEntries.end()) {
+      initialContents = readEntry(found->second);
+   }
+   auto *buffer = new MemoryStreamBuffer(initialContents);
+   if (mode & (std::ios_base::app | std::ios_base::ate)) {
+      buffer->pubseekoff(0, std::ios_base::end, mode);
+   }
+   return buffer;
+}
+
+void FileContainer::openImageFile() {
+   if (mImageFd >= 0) {
+      return;
+   }
+   mImagePath = mMountPoint + ".part";
+   mImageFd   = open(mImagePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+   FatalIf(
+         mImageFd < 0,
+         "FileContainer unable to create \"%s\": %s\n",
+         mImagePath.c_str(),
+         strerror(errno));
+   mImageEnd = alignUp((std::uint64_t)sizeof(Header));
+}
+
+void FileContainer::commitBuffer(
+      std::string const &name,
+      std::streambuf *buffer,
+      bool verifyWrites) {
+   auto *memoryBuffer = dynamic_cast<MemoryStreamBuffer *>(buffer);
+   pvAssert(memoryBuffer);
+   FatalIf(
+         mImageSize > (std::uint64_t)0,
+         "FileContainer \"%s\": entry \"%s\" was written after the container was completed.\n",
+         mMountPoint.c_str(),
+         name.c_str());
+   openImageFile();
+   std::string const &data = memoryBuffer->getData();
+   writeAt(mImageFd, data.data(), data.size(), (off_t)mImageEnd, mImagePath);
+   if (verifyWrites) {
+      verifyAt(mImageFd, data.data(), data.size(), (off_t)mImageEnd, mImagePath);
+   }
+   Entry &entry      = mEntries[name];
+   entry.mMappedData = nullptr;
+   entry.mOffset     = mImageEnd;
+   entry.mSize       = data.size();
+   mImageEnd         = alignUp(mImageEnd + (std::uint64_t)data.size());
+}
+
+std::uint64_t FileContainer::finishImage(bool verifyWrites) {
+   if (mImageSize > (std::uint64_t)0) {
+      return mImageSize;
+   }
+   openImageFile();
+   // The table of contents starts at the first aligned position after the data.
+   std::uint64_t const tocOffset = mImageEnd;
+   std::string toc;
+   for (auto const &e : mEntries) {
+      FatalIf(
+            e.second.mMappedData != nullptr,
+            "FileContainer \"%s\": entries read from a container file cannot be written.\n",
+            mMountPoint.c_str());
+      appendRecord(toc, e.first, e.second.mOffset, (std::uint64_t)e.second.mSize);
+   }
+   Header const header = buildHeader(FILES, (std::uint64_t)mEntries.size(), tocOffset, toc.size());
+   writeAt(mImageFd, toc.data(), toc.size(), (off_t)tocOffset, mImagePath);
+   writeAt(mImageFd, &header, sizeof(header), (off_t)0, mImagePath);
+   mImageSize = tocOffset + (std::uint64_t)toc.size();
+   FatalIf(
+         ftruncate(mImageFd, (off_t)mImageSize) != 0,
+         "FileContainer unable to set the size of \"%s\": %s\n",
+         mImagePath.c_str(),
+         strerror(errno));
+   if (verifyWrites) {
+      verifyAt(mImageFd, &header, sizeof(header), (off_t)0, mImagePath);
+      verifyAt(mImageFd, toc.data(), toc.size(), (off_t)tocOffset, mImagePath);
+   }
+   return mImageSize;
+}
+
+FileContainer::Header FileContainer::buildHeader(
+      ContentType contentType,
+      std::uint64_t numEntries,
+      std::uint64_t tocOffset,
+      std::uint64_t tocSize) const {
+   Header header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.magic, containerMagic, sizeof(containerMagic));
+   header.version     = containerVersion;
+   header.contentType = (std::uint32_t)contentType;
+   header.alignment   = (std::uint64_t)alignment;
+   header.numEntries  = numEntries;
+   header.tocOffset   = tocOffset;
+   header.tocSize     = tocSize;
+   header.imageSize   = tocOffset + tocSize;
+   return header;
+}
+
+void FileContainer::writeFile(std::string const &path, bool verifyWrites) {
+   finishImage(verifyWrites);
+   FatalIf(
+         rename(mImagePath.c_str(), path.c_str()) != 0,
+         "FileContainer unable to rename \"%s\" to \"%s\": %s\n",
+         mImagePath.c_str(),
+         path.c_str(),
+         strerror(errno));
+   mImagePath    = path;
+   mImageRenamed = true;
+}
+
+void FileContainer::writeShared(
+      std::string const &path,
+      MPIBlock const *mpiBlock,
+      std::string const &blockName) {
+   MPI_Comm const globalComm = mpiBlock->getGlobalComm();
+   int const globalRank      = mpiBlock->getGlobalRank();
+   int globalSize;
+   MPI_Comm_size(globalComm, &globalSize);
+   bool const isBlockRoot = mpiBlock->getRank() == 0;
+
+   // Each block root completes its own container image.
+   std::uint64_t imageSize = isBlockRoot ? finishImage(false) : (std::uint64_t)0;
+
+   // Gather the image sizes and block names, so that every process can compute the layout
+   // of the shared file. Non-root processes contribute a zero size and an empty name.
+   std::vector<std::uint64_t> imageSizes(globalSize);
+   MPI_Allgather(&imageSize, 1, MPI_UINT64_T, imageSizes.data(), 1, MPI_UINT64_T, globalComm);
+   int nameLength = isBlockRoot ? (int)blockName.size() : 0;
+   std::vector<int> nameLengths(globalSize);
+   MPI_Allgather(&nameLength, 1, MPI_INT, nameLengths.data(), 1, MPI_INT, globalComm);
+   std::vector<int> nameDisplacements(globalSize, 0);
+   for (int r = 1; r < globalSize; r++) {
+      nameDisplacements[r] = nameDisplacements[r - 1] + nameLengths[r - 1];
+   }
+   std::vector<char> allNames(nameDisplacements.back() + nameLengths.back() + 1);
+   MPI_Allgatherv(
+         const_cast<char *>(blockName.data()),
+         nameLength,
+         MPI_CHAR,
+         allNames.data(),
+         nameLengths.data(),
+         nameDisplacements.data(),
+         MPI_CHAR,
+         globalComm);
+
+   std::string outerToc;
+   std::uint64_t numBlocks   = (std::uint64_t)0;
+   std::uint64_t blockOffset = alignUp((std::uint64_t)sizeof(Header));
+   std::uint64_t myOffset    = (std::uint64_t)0;
+   for (int r = 0; r < globalSize; r++) {
+      if (imageSizes[r] == (std::uint64_t)0) {
+         continue;
+      }
+      std::string name(&allNames[nameDisplacements[r]], (std::size_t)nameLengths[r]);
+      appendRecord(outerToc, name, blockOffset, imageSizes[r]);
+      numBlocks++;
+      if (r == globalRank) {
+         myOffset = blockOffset;
+      }
+      blockOffset = alignUp(blockOffset + imageSizes[r]);
+   }
+   std::uint64_t const outerTocOffset = blockOffset;
+
+   std::string const tmpPath = path + ".tmp";
+   MPI_File fileHandle;
+   int result = MPI_File_open(
+         globalComm,
+         const_cast<char *>(tmpPath.c_str()),
+         MPI_MODE_CREATE | MPI_MODE_WRONLY,
+         MPI_INFO_NULL,
+         &fileHandle);
+   FatalIf(result != MPI_SUCCESS, "FileContainer unable to open \"%s\".\n", tmpPath.c_str());
+   MPI_File_set_size(fileHandle, (MPI_Offset)(outerTocOffset + outerToc.size()));
+   if (globalRank == 0) {
+      Header const outerHeader = buildHeader(BLOCKS, numBlocks, outerTocOffset, outerToc.size());
+      writeAtShared(fileHandle, (MPI_Offset)0, (char const *)&outerHeader, sizeof(outerHeader));
+      writeAtShared(fileHandle, (MPI_Offset)outerTocOffset, outerToc.data(), outerToc.size());
+   }
+   if (isBlockRoot) {
+      // Copy the image in pieces, so that it is never held in memory all at once.
+      std::vector<char> piece(std::min(imageSize, (std::uint64_t)copyPieceSize));
+      for (std::uint64_t copied = (std::uint64_t)0; copied < imageSize;) {
+         std::size_t const size =
+               (std::size_t)std::min(imageSize - copied, (std::uint64_t)piece.size());
+         readAt(mImageFd, piece.data(), size, (off_t)copied, mImagePath);
+         writeAtShared(fileHandle, (MPI_Offset)(myOffset + copied), piece.data(), size);
+         copied += (std::uint64_t)size;
+      }
+   }
+   MPI_File_close(&fileHandle);
+   MPI_Barrier(globalComm);
+   if (globalRank == 0) {
+      FatalIf(
+            rename(tmpPath.c_str(), path.c_str()) != 0,
+            "FileContainer unable to rename \"%s\" to \"%s\": %s\n",
+            tmpPath.c_str(),
+            path.c_str(),
+            strerror(errno));
+   }
+   MPI_Barrier(globalComm);
+}
+
+} // namespace PV
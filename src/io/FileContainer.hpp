@@ -0,0 +1,163 @@
+#ifndef FILECONTAINER_HPP_
+#define FILECONTAINER_HPP_
+
+#include "structures/MPIBlock.hpp"
+#include <cstdint>
+#include <ios>
+#include <map>
+#include <streambuf>
+#include <string>
+
+namespace PV {
+
+/**
+ * A FileContainer packs the files of a directory into a single file, together with a
+ * table of contents mapping each file name to its offset and size.
+ *
+ * A container is "mounted" at a directory path. While it is mounted, any FileStream
+ * opened on a path of the form <mountPoint>/<name> reads and writes the container entry
+ * <name> instead of a file on disk, so code that writes a directory of files (for example
+ * the CheckpointEntry classes) can be redirected into a container without change.
+ *
+ * Every entry in the container file starts at a multiple of FileContainer::alignment
+ * bytes, so that entries can be transferred with direct I/O and read in place from a
+ * memory-mapped file.
+ *
+ * A container file is laid out as a header, padded to the alignment; the entry data;
+ * and the table of contents. Each table-of-contents record is an 8-byte offset,
+ * an 8-byte size, a 4-byte name length, and the name (not null-terminated).
+ * Offsets are relative to the start of the header.
+ *
+ * A container whose content type is BLOCKS holds one complete container per MPIBlock;
+ * this is the layout written by writeShared().
+ *
+ * Entries are not held in memory once they are written: each entry is written to the
+ * container image under construction, the file <mountPoint>.part, when the FileStream
+ * writing it is closed. Only the table of contents is kept in memory. writeFile() renames
+ * the image into place, and writeShared() copies it into the shared file.
+ */
+class FileContainer {
+  public:
+   enum ContentType : std::uint32_t { FILES = 0, BLOCKS = 1 };
+
+   struct Header {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t contentType;
+      std::uint64_t alignment;
+      std::uint64_t numEntries;
+      std::uint64_t tocOffset;
+      std::uint64_t tocSize;
+      std::uint64_t imageSize;
+   };
+
+   static std::size_t const alignment = (std::size_t)4096;
+
+   /**
+    * Creates an empty container, mounted at the given directory path. The container
+    * stays mounted until it is deleted. All processes that might open a FileStream
+    * inside the mount point should mount the container, even if they do not hold data.
+    */
+   FileContainer(std::string const &mountPoint);
+
+   ~FileContainer();
+
+   std::string const &getMountPoint() const { return mMountPoint; }
+
+   /**
+    * Returns the mounted container that holds the given path, or null if the path is not
+    * inside a mount point. If the container is found and entryName is not null, the
+    * name of the entry is returned in *entryName.
+    */
+   static FileContainer *findMount(std::string const &path, std::string *entryName);
+
+   /**
+    * Returns true if the given path is the mount point of a container.
+    */
+   static bool isMountPoint(std::string const &path);
+
+   /**
+    * Maps the container file at the given path into memory, and makes the entries of the
+    * block named blockName available for reading. If the file holds a single block,
+    * blockName is ignored. Only the processes that actually read entries need to call
+    * this method.
+    */
+   void openFile(std::string const &path, std::string const &blockName);
+
+   bool hasEntry(std::string const &name) const;
+
+   /**
+    * Creates a stream buffer for the given entry, to be used by a FileStream opened with
+    * the given mode. Buffers for read-only streams on a mapped container refer directly to
+    * the memory-mapped file. Buffers for write streams are committed back into the container
+    * by commitBuffer().
+    */
+   std::streambuf *createBuffer(std::string const &name, std::ios_base::openmode mode);
+
+   /**
+    * Appends the contents of a buffer created by createBuffer() to the container image under
+    * construction, as the given entry. If the entry was already written, the new contents
+    * replace it. If verifyWrites is true, the data is read back and compared.
+    */
+   void commitBuffer(std::string const &name, std::streambuf *buffer, bool verifyWrites);
+
+   /**
+    * Completes the container image and renames it to the given path, so that a file with
+    * the final name is always complete. No entries can be committed afterward.
+    */
+   void writeFile(std::string const &path, bool verifyWrites);
+
+   /**
+    * Writes the containers of all MPIBlocks into a single file using MPI-IO.
+    * Must be called by all processes of the global communicator of mpiBlock; the container
+    * of the root process of each block is written, under the entry name blockName.
+    * No entries can be committed afterward.
+    */
+   void writeShared(
+         std::string const &path,
+         MPIBlock const *mpiBlock,
+         std::string const &blockName);
+
+  private:
+   struct Entry {
+      char const *mMappedData = nullptr; // entries read from a mapped container file
+      std::uint64_t mOffset   = (std::uint64_t)0; // entries written to the image file
+      std::size_t mSize       = (std::size_t)0;
+   };
+
+   static std::uint64_t alignUp(std::uint64_t n) {
+      return (n + alignment - 1) / alignment * alignment;
+   }
+   std::string readEntry(Entry const &entry) const;
+   void openImageFile();
+
+   /**
+    * Writes the table of contents and the header of the image file, if that has not been
+    * done yet, and returns the size of the image.
+    */
+   std::uint64_t finishImage(bool verifyWrites);
+   Header buildHeader(
+         ContentType contentType,
+         std::uint64_t numEntries,
+         std::uint64_t tocOffset,
+         std::uint64_t tocSize) const;
+   void parseImage(char const *image, std::size_t size, std::string const &path);
+   void unmapFile();
+
+  private:
+   std::string mMountPoint;
+   std::map<std::string, Entry> mEntries;
+   void *mMappedFile       = nullptr;
+   std::size_t mMappedSize = (std::size_t)0;
+
+   // The container image being written, created by the first commitBuffer().
+   std::string mImagePath;
+   int mImageFd             = -1;
+   std::uint64_t mImageEnd  = (std::uint64_t)0; // the end of the entries written so far
+   std::uint64_t mImageSize = (std::uint64_t)0; // nonzero once the image is complete
+   bool mImageRenamed       = false;
+};
+
+} // namespace PV
+
+#endif // FILECONTAINER_HPP_
@@ -16,6 +16,7 @@ extern "C" {
 #include <vector>
 
 #include "FileStream.hpp"
+#include "io/FileContainer.hpp"
 #include "io/io.hpp"
 #include "utils/PVAssert.hpp"
 #include "utils/PVLog.hpp"
@@ -29,14 +30,22 @@ FileStream::FileStream(char const *path, std::ios_base::openmode mode, bool veri
    openFile(path, mode, verifyWrites);
 }
 
-FileStream::~FileStream() {}
+FileStream::~FileStream() {
+   if (mContainer and writeable()) {
+      mContainer->commitBuffer(mContainerEntry, mContainerBuffer.get(), mVerifyWrites);
+   }
+}
 
 void FileStream::openFile(char const *path, std::ios_base::openmode mode, bool verifyWrites) {
    string fullPath = expandLeadingTilde(path);
    mFileName       = fullPath;
    mMode           = mode;
    mVerifyWrites   = verifyWrites;
-   int attempts    = 0;
+   if (openContainerEntry(fullPath, mode)) {
+      verifyFlags("openFile");
+      return;
+   }
+   int attempts = 0;
    while (!mFStream.is_open()) {
       mFStream.open(fullPath, mode);
       if (!mFStream.fail()) {
@@ -62,22 +71,40 @@ void FileStream::openFile(char const *path, std::ios_base::openmode mode, bool v
    verifyFlags("openFile");
 }
 
+bool FileStream::openContainerEntry(std::string const &fullPath, std::ios_base::openmode mode) {
+   mContainer = FileContainer::findMount(fullPath, &mContainerEntry);
+   if (mContainer == nullptr) {
+      return false;
+   }
+   mContainerBuffer.reset(mContainer->createBuffer(mContainerEntry, mode));
+   FatalIf(
+         mContainerBuffer == nullptr,
+         "FileStream::openFile failure for \"%s\": no such entry in the container mounted at "
+         "\"%s\".\n",
+         fullPath.c_str(),
+         mContainer->getMountPoint().c_str());
+   mContainerStream.rdbuf(mContainerBuffer.get());
+   setOutStream(mContainerStream);
+   return true;
+}
+
 void FileStream::verifyFlags(const char *caller) {
-   FatalIf(mFStream.fail(), "%s %s: Logical error.\n", mFileName.c_str(), caller);
-   FatalIf(mFStream.bad(), "%s %s: Read / Write error.\n", mFileName.c_str(), caller);
+   FatalIf(stream().fail(), "%s %s: Logical error.\n", mFileName.c_str(), caller);
+   FatalIf(stream().bad(), "%s %s: Read / Write error.\n", mFileName.c_str(), caller);
    FatalIf(writeable() && getOutPos() == -1, "%s %s: out pos == -1\n", mFileName.c_str(), caller);
    FatalIf(readable() && getInPos() == -1, "%s %s: in pos == -1\n", mFileName.c_str(), caller);
 }
 
 void FileStream::write(void const *data, long length) {
    long startPos = getOutPos();
-   mFStream.write((char *)data, length);
-   mFStream.flush();
+   stream().write((char *)data, length);
+   stream().flush();
 
    std::string errmsg;
    errmsg.append("writing ").append(std::to_string(length)).append(" bytes");
    verifyFlags(errmsg.c_str());
-   if (mVerifyWrites) {
+   // Container entries are verified when they are committed to the container.
+   if (mVerifyWrites and mContainer == nullptr) {
       std::ios_base::openmode mode = std::ios_base::in;
       if (binary()) {
          mode |= std::ios_base::binary;
@@ -98,10 +125,10 @@ void FileStream::write(void const *data, long length) {
 }
 
 void FileStream::read(void *data, long length) {
-   FatalIf(mFStream.eof(), "Attempting to read after EOF.\n");
+   FatalIf(stream().eof(), "Attempting to read after EOF.\n");
    long startPos = getInPos();
-   mFStream.read((char *)data, length);
-   long numRead = mFStream.gcount();
+   stream().read((char *)data, length);
+   long numRead = stream().gcount();
    FatalIf(
          numRead != length,
          "Expected to read %d bytes from %s at position %d; read %d instead. "
@@ -115,37 +142,37 @@ void FileStream::read(void *data, long length) {
 }
 
 void FileStream::setOutPos(long pos, std::ios_base::seekdir seekAnchor) {
-   mFStream.seekp(pos, seekAnchor);
+   stream().seekp(pos, seekAnchor);
    verifyFlags("setOutPos");
 }
 
 void FileStream::setOutPos(long pos, bool fromBeginning) {
    if (!fromBeginning) {
-      mFStream.seekp(pos, std::ios_base::cur);
+      stream().seekp(pos, std::ios_base::cur);
    }
    else {
-      mFStream.seekp(pos);
+      stream().seekp(pos);
    }
    verifyFlags("setOutPos");
 }
 
 void FileStream::setInPos(long pos, std::ios_base::seekdir seekAnchor) {
-   mFStream.seekg(pos, seekAnchor);
+   stream().seekg(pos, seekAnchor);
    verifyFlags("setInPos");
 }
 
 void FileStream::setInPos(long pos, bool fromBeginning) {
    if (!fromBeginning) {
-      mFStream.seekg(pos, std::ios_base::cur);
+      stream().seekg(pos, std::ios_base::cur);
    }
    else {
-      mFStream.seekg(pos);
+      stream().seekg(pos);
    }
    verifyFlags("setInPos");
 }
 
-long FileStream::getOutPos() { return mFStream.tellp(); }
+long FileStream::getOutPos() { return stream().tellp(); }
 
-long FileStream::getInPos() { return mFStream.tellg(); }
+long FileStream::getInPos() { return stream().tellg(); }
 
 } /* namespace PV */
@@ -11,9 +11,12 @@
 #include "PrintStream.hpp"
 
 #include <fstream>
+#include <memory>
 
 namespace PV {
 
+class FileContainer;
+
 class FileStream : public PrintStream {
   public:
    FileStream(char const *path, std::ios_base::openmode mode, bool verifyWrites = false);
@@ -26,7 +29,7 @@ class FileStream : public PrintStream {
    virtual void setInPos(long pos, bool fromBeginning);
    bool readable() { return mMode & std::ios_base::in; }
    bool writeable() { return mMode & std::ios_base::out; }
-   bool binary() { return mFStream.flags() & std::ios_base::binary; }
+   bool binary() { return stream().flags() & std::ios_base::binary; }
    bool readwrite() { return readable() && writeable(); }
    long getOutPos();
    long getInPos();
@@ -37,13 +40,30 @@ class FileStream : public PrintStream {
    void verifyFlags(const char *caller);
    void openFile(char const *path, std::ios_base::openmode mode, bool verifyWrites);
 
+   /**
+    * Returns the stream that reads and writes the file: mFStream for an ordinary file,
+    * or a stream on the container entry if the path is inside a mounted FileContainer.
+    */
+   std::iostream &stream() {
+      return mContainer ? static_cast<std::iostream &>(mContainerStream) : mFStream;
+   }
+
    std::fstream mFStream;
    std::string mFileName;
 
+  private:
+   bool openContainerEntry(std::string const &fullPath, std::ios_base::openmode mode);
+
   private:
    std::ios_base::openmode mMode;
    bool mVerifyWrites     = false;
    int const mMaxAttempts = 5;
+
+   // Used instead of mFStream when the file is an entry of a mounted FileContainer.
+   FileContainer *mContainer = nullptr;
+   std::string mContainerEntry;
+   std::unique_ptr<std::streambuf> mContainerBuffer;
+   std::iostream mContainerStream{nullptr};
 };
 
 } /* namespace PV */
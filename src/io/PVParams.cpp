@@ -11,6 +11,8 @@
 #include <assert.h>
 #include <climits> // INT_MIN
 #include <cmath> // nearbyint()
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
@@ -58,6 +60,101 @@ int main() {
 
 namespace PV {
 
+namespace {
+
+// The serialization of the parsed params (see PVParams::serialize()) is a sequence of 32-bit
+// integers, doubles and strings, in the machine's byte order. A string is its length followed by
+// its characters; a null string has length -1.
+
+void appendBytes(std::vector<char> &buffer, void const *data, std::size_t size) {
+   char const *bytes = static_cast<char const *>(data);
+   buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void appendInt(std::vector<char> &buffer, int value) {
+   std::int32_t const value32 = (std::int32_t)value;
+   appendBytes(buffer, &value32, sizeof(value32));
+}
+
+void appendDouble(std::vector<char> &buffer, double value) {
+   appendBytes(buffer, &value, sizeof(value));
+}
+
+void appendString(std::vector<char> &buffer, char const *s) {
+   if (s == nullptr) {
+      appendInt(buffer, -1);
+      return;
+   }
+   int const length = (int)strlen(s);
+   appendInt(buffer, length);
+   appendBytes(buffer, s, (std::size_t)length);
+}
+
+struct SerialReader {
+   std::vector<char> const &mBuffer;
+   std::size_t mOffset;
+};
+
+void readBytes(SerialReader &reader, void *data, std::size_t size) {
+   FatalIf(
+         reader.mOffset + size > reader.mBuffer.size(),
+         "Serialized params are truncated at byte %zu.\n",
+         reader.mOffset);
+   memcpy(data, reader.mBuffer.data() + reader.mOffset, size);
+   reader.mOffset += size;
+}
+
+int readInt(SerialReader &reader) {
+   std::int32_t value32;
+   readBytes(reader, &value32, sizeof(value32));
+   return (int)value32;
+}
+
+double readDouble(SerialReader &reader) {
+   double value;
+   readBytes(reader, &value, sizeof(value));
+   return value;
+}
+
+// Returns false for a null string.
+bool readString(SerialReader &reader, std::string &s) {
+   int const length = readInt(reader);
+   if (length < 0) {
+      s.clear();
+      return false;
+   }
+   s.resize((std::size_t)length);
+   if (length > 0) {
+      readBytes(reader, &s[0], (std::size_t)length);
+   }
+   return true;
+}
+
+// 64-bit FNV-1a, used to match a cache file to its params text and to check its contents.
+std::uint64_t hashBytes(char const *data, std::size_t size) {
+   std::uint64_t hash = 14695981039346656037ULL;
+   for (std::size_t k = 0; k < size; k++) {
+      hash ^= (std::uint64_t)(unsigned char)data[k];
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+char const cacheMagic[8]         = {'P', 'V', 'P', 'A', 'R', 'A', 'M', 'S'};
+std::uint32_t const cacheVersion = 1U;
+
+struct CacheHeader {
+   char mMagic[8];
+   std::uint32_t mVersion;
+   std::uint32_t mReserved;
+   std::uint64_t mSourceSize; // the size of the params text the cache was written from
+   std::uint64_t mSourceHash;
+   std::uint64_t mPayloadSize; // the size of the serialized params that follow the header
+   std::uint64_t mPayloadHash;
+};
+
+} // namespace
+
 /**
  * @name
  * @value
@@ -318,6 +415,26 @@ ParameterGroup::ParameterGroup(
    this->arrayStack   = array_stack;
    this->stringStack  = string_stack;
    this->processRank  = rank;
+   indexParameters();
+}
+
+void ParameterGroup::indexParameters() {
+   // emplace keeps the first parameter of a given name, which is the one the stacks would find.
+   mParameterIndex.clear();
+   for (int i = 0; i < stack->size(); i++) {
+      Parameter *p = stack->peek(i);
+      mParameterIndex.emplace(std::string(p->name()), p);
+   }
+   mArrayIndex.clear();
+   for (int i = 0; i < arrayStack->size(); i++) {
+      ParameterArray *p = arrayStack->peek(i);
+      mArrayIndex.emplace(std::string(p->name()), p);
+   }
+   mStringIndex.clear();
+   for (int i = 0; i < stringStack->size(); i++) {
+      ParameterString *p = stringStack->peek(i);
+      mStringIndex.emplace(std::string(p->getName()), p);
+   }
 }
 
 ParameterGroup::~ParameterGroup() {
@@ -346,6 +463,7 @@ int ParameterGroup::setGroupKeyword(const char *keyword) {
 
 int ParameterGroup::setStringStack(ParameterStringStack *stringStack) {
    this->stringStack = stringStack;
+   indexParameters();
    // ParameterGroup::setStringStack takes ownership of the stringStack;
    // i.e. it will delete it when the ParameterGroup is deleted.
    // You shouldn't use a stringStack after calling this routine with it.
@@ -358,26 +476,16 @@ int ParameterGroup::setStringStack(ParameterStringStack *stringStack) {
  * @name
  */
 int ParameterGroup::present(const char *name) {
-   int count = stack->size();
-   for (int i = 0; i < count; i++) {
-      Parameter *p = stack->peek(i);
-      if (strcmp(name, p->name()) == 0) {
-         return 1; // string is present
-      }
-   }
-   return 0; // string not present
+   return mParameterIndex.find(std::string(name)) != mParameterIndex.end() ? 1 : 0;
 }
 
 /**
  * @name
  */
 double ParameterGroup::value(const char *name) {
-   int count = stack->size();
-   for (int i = 0; i < count; i++) {
-      Parameter *p = stack->peek(i);
-      if (strcmp(name, p->name()) == 0) {
-         return p->value();
-      }
+   auto found = mParameterIndex.find(std::string(name));
+   if (found != mParameterIndex.end()) {
+      return found->second->value();
    }
    Fatal().printf(
          "PVParams::ParameterGroup::value: ERROR, couldn't find a value for %s"
@@ -388,42 +496,20 @@ double ParameterGroup::value(const char *name) {
 }
 
 bool ParameterGroup::arrayPresent(const char *name) {
-   int array_found = 0;
-   int count       = arrayStack->size();
-   for (int i = 0; i < count; i++) {
-      ParameterArray *p = arrayStack->peek(i);
-      if (strcmp(name, p->name()) == 0) {
-         array_found = 1; // string is present
-         break;
-      }
-   }
-   return array_found;
+   return mArrayIndex.find(std::string(name)) != mArrayIndex.end();
 }
 
 const float *ParameterGroup::arrayValues(const char *name, int *size) {
-   int count         = arrayStack->size();
-   *size             = 0;
-   const float *v    = NULL;
-   ParameterArray *p = NULL;
-   for (int i = 0; i < count; i++) {
-      p = arrayStack->peek(i);
-      if (strcmp(name, p->name()) == 0) {
-         v = p->getValues(size);
-         break;
-      }
+   *size           = 0;
+   const float *v  = NULL;
+   auto foundArray = mArrayIndex.find(std::string(name));
+   if (foundArray != mArrayIndex.end()) {
+      v = foundArray->second->getValues(size);
    }
    if (!v) {
-      Parameter *q = NULL;
-      for (int i = 0; i < stack->size(); i++) {
-         Parameter *q1 = stack->peek(i);
-         assert(q1);
-         if (strcmp(name, q1->name()) == 0) {
-            q = q1;
-            break;
-         }
-      }
-      if (q) {
-         v     = q->valuePtr();
+      auto found = mParameterIndex.find(std::string(name));
+      if (found != mParameterIndex.end()) {
+         v     = found->second->valuePtr();
          *size = 1;
       }
    }
@@ -431,29 +517,16 @@ const float *ParameterGroup::arrayValues(const char *name, int *size) {
 }
 
 const double *ParameterGroup::arrayValuesDbl(const char *name, int *size) {
-   int count         = arrayStack->size();
-   *size             = 0;
-   const double *v   = NULL;
-   ParameterArray *p = NULL;
-   for (int i = 0; i < count; i++) {
-      p = arrayStack->peek(i);
-      if (strcmp(name, p->name()) == 0) {
-         v = p->getValuesDbl(size);
-         break;
-      }
+   *size           = 0;
+   const double *v = NULL;
+   auto foundArray = mArrayIndex.find(std::string(name));
+   if (foundArray != mArrayIndex.end()) {
+      v = foundArray->second->getValuesDbl(size);
    }
    if (!v) {
-      Parameter *q = NULL;
-      for (int i = 0; i < stack->size(); i++) {
-         Parameter *q1 = stack->peek(i);
-         assert(q1);
-         if (strcmp(name, q1->name()) == 0) {
-            q = q1;
-            break;
-         }
-      }
-      if (q) {
-         v     = q->valueDblPtr();
+      auto found = mParameterIndex.find(std::string(name));
+      if (found != mParameterIndex.end()) {
+         v     = found->second->valueDblPtr();
          *size = 1;
       }
    }
@@ -466,29 +539,14 @@ int ParameterGroup::stringPresent(const char *stringName) {
    // value and present methods for floating-point parameters
    if (!stringName)
       return 0;
-   int count = stringStack->size();
-   for (int i = 0; i < count; i++) {
-      ParameterString *pstr = stringStack->peek(i);
-      assert(pstr);
-      if (!strcmp(stringName, pstr->getName())) {
-         return 1; // string is present
-      }
-   }
-   return 0; // string not present
+   return mStringIndex.find(std::string(stringName)) != mStringIndex.end() ? 1 : 0;
 }
 
 const char *ParameterGroup::stringValue(const char *stringName) {
    if (!stringName)
       return NULL;
-   int count = stringStack->size();
-   for (int i = 0; i < count; i++) {
-      ParameterString *pstr = stringStack->peek(i);
-      assert(pstr);
-      if (!strcmp(stringName, pstr->getName())) {
-         return pstr->getValue();
-      }
-   }
-   return NULL;
+   auto found = mStringIndex.find(std::string(stringName));
+   return found != mStringIndex.end() ? found->second->getValue() : NULL;
 }
 
 int ParameterGroup::warnUnread() {
@@ -533,27 +591,18 @@ int ParameterGroup::warnUnread() {
 }
 
 bool ParameterGroup::hasBeenRead(const char *paramName) {
-   int count;
-   count = stack->size();
-   for (int i = 0; i < count; i++) {
-      Parameter *p = stack->peek(i);
-      if (!strcmp(p->name(), paramName)) {
-         return p->hasBeenRead();
-      }
+   std::string const name(paramName);
+   auto found = mParameterIndex.find(name);
+   if (found != mParameterIndex.end()) {
+      return found->second->hasBeenRead();
    }
-   count = arrayStack->size();
-   for (int i = 0; i < count; i++) {
-      ParameterArray *parr = arrayStack->peek(i);
-      if (!strcmp(parr->name(), paramName)) {
-         return parr->hasBeenRead();
-      }
+   auto foundArray = mArrayIndex.find(name);
+   if (foundArray != mArrayIndex.end()) {
+      return foundArray->second->hasBeenRead();
    }
-   count = stringStack->size();
-   for (int i = 0; i < count; i++) {
-      ParameterString *pstr = stringStack->peek(i);
-      if (!strcmp(pstr->getName(), paramName)) {
-         return pstr->hasBeenRead();
-      }
+   auto foundString = mStringIndex.find(name);
+   if (foundString != mStringIndex.end()) {
+      return foundString->second->hasBeenRead();
    }
    return false;
 }
@@ -578,19 +627,22 @@ int ParameterGroup::clearHasBeenReadFlags() {
    return status;
 }
 
-int ParameterGroup::pushNumerical(Parameter *param) { return stack->push(param); }
+int ParameterGroup::pushNumerical(Parameter *param) {
+   mParameterIndex.emplace(std::string(param->name()), param);
+   return stack->push(param);
+}
 
-int ParameterGroup::pushString(ParameterString *param) { return stringStack->push(param); }
+int ParameterGroup::pushString(ParameterString *param) {
+   mStringIndex.emplace(std::string(param->getName()), param);
+   return stringStack->push(param);
+}
 
 int ParameterGroup::setValue(const char *param_name, double value) {
    int status = PV_SUCCESS;
-   int count  = stack->size();
-   for (int i = 0; i < count; i++) {
-      Parameter *p = stack->peek(i);
-      if (strcmp(param_name, p->name()) == 0) {
-         p->setValue(value);
-         return PV_SUCCESS;
-      }
+   auto found = mParameterIndex.find(std::string(param_name));
+   if (found != mParameterIndex.end()) {
+      found->second->setValue(value);
+      return PV_SUCCESS;
    }
    Fatal().printf(
          "PVParams::ParameterGroup::setValue: ERROR, couldn't find parameter %s"
@@ -603,13 +655,10 @@ int ParameterGroup::setValue(const char *param_name, double value) {
 
 int ParameterGroup::setStringValue(const char *param_name, const char *svalue) {
    int status = PV_SUCCESS;
-   int count  = stringStack->size();
-   for (int i = 0; i < count; i++) {
-      ParameterString *p = stringStack->peek(i);
-      if (strcmp(param_name, p->getName()) == 0) {
-         p->setValue(svalue);
-         return PV_SUCCESS;
-      }
+   auto found = mStringIndex.find(std::string(param_name));
+   if (found != mStringIndex.end()) {
+      found->second->setValue(svalue);
+      return PV_SUCCESS;
    }
    Fatal().printf(
          "PVParams::ParameterGroup::setStringValue: ERROR, couldn't find a string value for %s"
@@ -653,6 +702,32 @@ ParameterStringStack *ParameterGroup::copyStringStack() {
    return returnStack;
 }
 
+void ParameterGroup::serialize(std::vector<char> &buffer) {
+   appendString(buffer, groupKeyword);
+   appendString(buffer, groupName);
+   appendInt(buffer, stack->size());
+   for (int i = 0; i < stack->size(); i++) {
+      Parameter *p = stack->peek(i);
+      appendString(buffer, p->name());
+      appendDouble(buffer, p->peekValue());
+   }
+   appendInt(buffer, arrayStack->size());
+   for (int i = 0; i < arrayStack->size(); i++) {
+      ParameterArray *p = arrayStack->peek(i);
+      appendString(buffer, p->name());
+      appendInt(buffer, p->getArraySize());
+      for (int k = 0; k < p->getArraySize(); k++) {
+         appendDouble(buffer, p->peek(k));
+      }
+   }
+   appendInt(buffer, stringStack->size());
+   for (int i = 0; i < stringStack->size(); i++) {
+      ParameterString *p = stringStack->peek(i);
+      appendString(buffer, p->getName());
+      appendString(buffer, p->peekValue());
+   }
+}
+
 ParameterSweep::ParameterSweep() {
    groupName         = NULL;
    paramName         = NULL;
@@ -783,8 +858,13 @@ const char *ParameterSweep::getStringValue(int n) {
  * @initialSize
  * @icComm
  */
-PVParams::PVParams(const char *filename, size_t initialSize, Communicator *inIcComm) {
+PVParams::PVParams(
+      const char *filename,
+      size_t initialSize,
+      Communicator *inIcComm,
+      std::string const &cachePath) {
    this->icComm = inIcComm;
+   mCachePath   = cachePath;
    initialize(initialSize);
    parseFile(filename);
 }
@@ -873,55 +953,201 @@ int PVParams::newActiveParamSweep() {
 }
 
 int PVParams::parseFile(const char *filename) {
-   int rootproc      = 0;
-   char *paramBuffer = nullptr;
-   size_t bufferlen;
+   // The root process parses the params file, or reads the cache, and broadcasts the result.
+   int rootproc = 0;
+   std::vector<char> serialized;
    if (worldRank == rootproc) {
+      // The cache is keyed on the params text given to the parser, not on the file itself, so
+      // a Lua params program is always run, and its output is checked against the cache.
       std::string paramBufferString("");
       loadParamBuffer(filename, paramBufferString);
-      bufferlen = paramBufferString.size();
-      // Older versions of MPI_Send require void*, not void const*
-      paramBuffer = (char *)pvMalloc(bufferlen + 1);
-      memcpy(paramBuffer, paramBufferString.c_str(), bufferlen);
-      paramBuffer[bufferlen] = '\0';
-
-#ifdef PV_USE_MPI
-      int sz = worldSize;
-      for (int i = 0; i < sz; i++) {
-         if (i == rootproc)
-            continue;
-         MPI_Send(paramBuffer, (int)bufferlen, MPI_CHAR, i, 31, icComm->globalCommunicator());
+      bool const useCache = !mCachePath.empty();
+      if (useCache and readCache(paramBufferString, serialized)) {
+         deserialize(serialized);
+         parseStatus      = 0;
+         mLoadedFromCache = true;
+      }
+      else {
+         parseBuffer(paramBufferString.c_str(), (long int)paramBufferString.size());
+         serialized = serialize();
+         if (useCache and parseStatus == 0) {
+            writeCache(paramBufferString, serialized);
+         }
       }
-#endif // PV_USE_MPI
    }
-   else { // rank != rootproc
+
 #ifdef PV_USE_MPI
-      MPI_Status mpi_status;
-      int count;
-      MPI_Probe(rootproc, 31, icComm->globalCommunicator(), &mpi_status);
-      // int status =
-      MPI_Get_count(&mpi_status, MPI_CHAR, &count);
-      bufferlen   = (size_t)count;
-      paramBuffer = (char *)malloc(bufferlen);
-      if (paramBuffer == NULL) {
-         Fatal().printf(
-               "PVParams::parseFile: Rank %d process unable to allocate memory for params buffer\n",
-               worldRank);
-      }
-      MPI_Recv(
-            paramBuffer,
-            (int)bufferlen,
+   if (worldSize > 1) {
+      long long header[3];
+      if (worldRank == rootproc) {
+         header[0] = (long long)parseStatus;
+         header[1] = (long long)mLoadedFromCache;
+         header[2] = (long long)serialized.size();
+      }
+      MPI_Bcast(header, 3, MPI_LONG_LONG, rootproc, icComm->globalCommunicator());
+      if (worldRank != rootproc) {
+         serialized.resize((std::size_t)header[2]);
+      }
+      MPI_Bcast(
+            serialized.data(),
+            (int)header[2],
             MPI_CHAR,
             rootproc,
-            31,
-            icComm->globalCommunicator(),
-            MPI_STATUS_IGNORE);
+            icComm->globalCommunicator());
+      if (worldRank != rootproc) {
+         deserialize(serialized);
+         parseStatus      = (int)header[0];
+         mLoadedFromCache = header[1] != 0LL;
+      }
+   }
 #endif // PV_USE_MPI
+   return PV_SUCCESS;
+}
+
+std::vector<char> PVParams::serialize() {
+   std::vector<char> buffer;
+   appendInt(buffer, numGroups);
+   for (int g = 0; g < numGroups; g++) {
+      groups[g]->serialize(buffer);
+   }
+   appendInt(buffer, numParamSweeps);
+   for (int k = 0; k < numParamSweeps; k++) {
+      ParameterSweep *sweep = paramSweeps[k];
+      appendString(buffer, sweep->getGroupName());
+      appendString(buffer, sweep->getParamName());
+      appendInt(buffer, (int)sweep->getType());
+      appendInt(buffer, sweep->getNumValues());
+      for (int n = 0; n < sweep->getNumValues(); n++) {
+         if (sweep->getType() == SWEEP_NUMBER) {
+            double v;
+            sweep->getNumericValue(n, &v);
+            appendDouble(buffer, v);
+         }
+         else {
+            appendString(buffer, sweep->getStringValue(n));
+         }
+      }
+   }
+   return buffer;
+}
+
+void PVParams::deserialize(std::vector<char> const &serialized) {
+   FatalIf(
+         numGroups != 0 or numParamSweeps != 0,
+         "PVParams::deserialize called on params that already have groups.\n");
+   SerialReader reader{serialized, 0};
+   std::string keyword, groupName, paramName, stringValue;
+   int const groupCount = readInt(reader);
+   for (int g = 0; g < groupCount; g++) {
+      readString(reader, keyword);
+      readString(reader, groupName);
+      int const numParams = readInt(reader);
+      for (int i = 0; i < numParams; i++) {
+         readString(reader, paramName);
+         stack->push(new Parameter(paramName.c_str(), readDouble(reader)));
+      }
+      int const numArrays = readInt(reader);
+      for (int i = 0; i < numArrays; i++) {
+         readString(reader, paramName);
+         int const arraySize  = readInt(reader);
+         ParameterArray *pArr = new ParameterArray(PARAMETERARRAY_INITIALSIZE);
+         pArr->setName(paramName.c_str());
+         for (int k = 0; k < arraySize; k++) {
+            pArr->pushValue(readDouble(reader));
+         }
+         arrayStack->push(pArr);
+      }
+      int const numStrings = readInt(reader);
+      for (int i = 0; i < numStrings; i++) {
+         readString(reader, paramName);
+         bool const notNull = readString(reader, stringValue);
+         stringStack->push(
+               new ParameterString(paramName.c_str(), notNull ? stringValue.c_str() : NULL));
+      }
+      addGroup(&keyword[0], &groupName[0]);
+   }
+   int const sweepCount = readInt(reader);
+   for (int k = 0; k < sweepCount; k++) {
+      readString(reader, groupName);
+      readString(reader, paramName);
+      SweepType const type = (SweepType)readInt(reader);
+      int const numValues  = readInt(reader);
+      for (int n = 0; n < numValues; n++) {
+         if (type == SWEEP_NUMBER) {
+            activeParamSweep->pushNumericValue(readDouble(reader));
+         }
+         else {
+            readString(reader, stringValue);
+            activeParamSweep->pushStringValue(stringValue.c_str());
+         }
+      }
+      addActiveParamSweep(groupName.c_str(), paramName.c_str());
    }
+   FatalIf(
+         reader.mOffset != serialized.size(),
+         "Serialized params have %zu unread bytes.\n",
+         serialized.size() - reader.mOffset);
+   setParameterSweepSize();
+   clearHasBeenReadFlags();
+}
 
-   int status = parseBuffer(paramBuffer, bufferlen);
-   free(paramBuffer);
-   return status;
+bool PVParams::readCache(std::string const &source, std::vector<char> &serialized) {
+   std::ifstream cacheStream(mCachePath.c_str(), std::ios_base::in | std::ios_base::binary);
+   if (!cacheStream) {
+      return false;
+   }
+   CacheHeader header;
+   cacheStream.read(reinterpret_cast<char *>(&header), sizeof(header));
+   if (!cacheStream or memcmp(header.mMagic, cacheMagic, sizeof(cacheMagic)) != 0
+       or header.mVersion != cacheVersion) {
+      WarnLog().printf(
+            "\"%s\" is not a params cache file; the params file will be parsed.\n",
+            mCachePath.c_str());
+      return false;
+   }
+   if (header.mSourceSize != (std::uint64_t)source.size()
+       or header.mSourceHash != hashBytes(source.data(), source.size())) {
+      InfoLog().printf(
+            "Params cache \"%s\" was written from a different params file.\n",
+            mCachePath.c_str());
+      return false;
+   }
+   serialized.resize((std::size_t)header.mPayloadSize);
+   cacheStream.read(serialized.data(), (std::streamsize)serialized.size());
+   bool const complete = cacheStream and cacheStream.peek() == std::char_traits<char>::eof();
+   if (!complete or header.mPayloadHash != hashBytes(serialized.data(), serialized.size())) {
+      WarnLog().printf(
+            "Params cache \"%s\" is damaged; the params file will be parsed.\n",
+            mCachePath.c_str());
+      serialized.clear();
+      return false;
+   }
+   InfoLog().printf("Read params from cache \"%s\".\n", mCachePath.c_str());
+   return true;
+}
+
+void PVParams::writeCache(std::string const &source, std::vector<char> const &serialized) {
+   CacheHeader header;
+   memcpy(header.mMagic, cacheMagic, sizeof(cacheMagic));
+   header.mVersion     = cacheVersion;
+   header.mReserved    = 0U;
+   header.mSourceSize  = (std::uint64_t)source.size();
+   header.mSourceHash  = hashBytes(source.data(), source.size());
+   header.mPayloadSize = (std::uint64_t)serialized.size();
+   header.mPayloadHash = hashBytes(serialized.data(), serialized.size());
+
+   // Write to a temporary file and rename it, so that a run reading the cache never sees a
+   // partly written file.
+   std::string const tempPath = mCachePath + ".tmp";
+   std::ofstream cacheStream(
+         tempPath.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+   cacheStream.write(reinterpret_cast<char const *>(&header), sizeof(header));
+   cacheStream.write(serialized.data(), (std::streamsize)serialized.size());
+   cacheStream.close();
+   if (!cacheStream or rename(tempPath.c_str(), mCachePath.c_str()) != 0) {
+      WarnLog().printf("Unable to write params cache \"%s\".\n", mCachePath.c_str());
+      remove(tempPath.c_str());
+   }
 }
 
 void PVParams::loadParamBuffer(char const *filename, std::string &paramsFileString) {
@@ -1555,12 +1781,8 @@ void PVParams::writeParamString(const char *paramName, const char *svalue) {
  * @groupName
  */
 ParameterGroup *PVParams::group(const char *groupName) {
-   for (int i = 0; i < numGroups; i++) {
-      if (strcmp(groupName, groups[i]->name()) == 0) {
-         return groups[i];
-      }
-   }
-   return NULL;
+   auto found = mGroupIndex.find(std::string(groupName));
+   return found != mGroupIndex.end() ? found->second : NULL;
 }
 
 const char *PVParams::groupNameFromIndex(int index) {
@@ -1590,10 +1812,8 @@ void PVParams::addGroup(char *keyword, char *name) {
    assert((size_t)numGroups <= groupArraySize);
 
    // Verify that the new group's name is not an existing group's name
-   for (int k = 0; k < numGroups; k++) {
-      if (!strcmp(name, groups[k]->name())) {
-         Fatal().printf("Rank %d process: group name \"%s\" duplicated\n", worldRank, name);
-      }
+   if (mGroupIndex.find(std::string(name)) != mGroupIndex.end()) {
+      Fatal().printf("Rank %d process: group name \"%s\" duplicated\n", worldRank, name);
    }
 
    if ((size_t)numGroups == groupArraySize) {
@@ -1610,6 +1830,7 @@ void PVParams::addGroup(char *keyword, char *name) {
 
    groups[numGroups] = new ParameterGroup(name, stack, arrayStack, stringStack, worldRank);
    groups[numGroups]->setGroupKeyword(keyword);
+   mGroupIndex.emplace(std::string(name), groups[numGroups]);
 
    // the parameter group takes over control of the PVParams's stack and stringStack; make new ones.
    stack       = new ParameterStack(MAX_PARAMS);
@@ -2131,13 +2352,7 @@ void PVParams::action_include_directive(const char *stringval) {
    // Grab the parameter value
    char *param_value = stripQuotationMarks(stringval);
    // Grab the included group's ParameterGroup object
-   ParameterGroup *includeGroup = NULL;
-   for (int groupidx = 0; groupidx < numGroups; groupidx++) {
-      // If strings are matching
-      if (strcmp(groups[groupidx]->name(), param_value) == 0) {
-         includeGroup = groups[groupidx];
-      }
-   }
+   ParameterGroup *includeGroup = group(param_value);
    // If group not found
    if (!includeGroup) {
       ErrorLog().printf("Include: include group %s is not defined.\n", param_value);
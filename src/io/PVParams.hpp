@@ -18,6 +18,9 @@
 #include <cstring>
 #include <limits>
 #include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 // TODO - make MAX_PARAMS dynamic
 #define MAX_PARAMS 100 // maximum number of parameters in a group
@@ -44,6 +47,7 @@ class Parameter {
       hasBeenReadFlag = true;
       return &paramDblValue;
    }
+   double peekValue() { return paramDblValue; }
    bool hasBeenRead() { return hasBeenReadFlag; }
    void clearHasBeenRead() { hasBeenReadFlag = false; }
    void setValue(double v) {
@@ -103,6 +107,7 @@ class ParameterString {
       hasBeenReadFlag = true;
       return paramValue;
    }
+   const char *peekValue() { return paramValue; }
    bool hasBeenRead() { return hasBeenReadFlag; }
    void clearHasBeenRead() { hasBeenReadFlag = false; }
    void setValue(const char *s) {
@@ -200,6 +205,16 @@ class ParameterGroup {
    ParameterArrayStack *copyArrayStack();
    ParameterStringStack *copyStringStack();
 
+   /**
+    * Appends the group's keyword, name and parameters to the buffer, in the format read by
+    * PVParams::deserialize().
+    */
+   void serialize(std::vector<char> &buffer);
+
+  private:
+   /** Rebuilds the name indices from the stacks. */
+   void indexParameters();
+
   private:
    char *groupName;
    char *groupKeyword;
@@ -207,6 +222,11 @@ class ParameterGroup {
    ParameterArrayStack *arrayStack;
    ParameterStringStack *stringStack;
    int processRank;
+
+   // Indices of the parameters in the stacks by name, so that lookups do not scan the stacks.
+   std::unordered_map<std::string, Parameter *> mParameterIndex;
+   std::unordered_map<std::string, ParameterArray *> mArrayIndex;
+   std::unordered_map<std::string, ParameterString *> mStringIndex;
 };
 
 enum SweepType { SWEEP_UNDEF = 0, SWEEP_NUMBER = 1, SWEEP_STRING = 2 };
@@ -236,15 +256,40 @@ class ParameterSweep {
    char **valuesString;
 };
 
+/**
+ * The parameters of a run, parsed from a params file or a buffer.
+ *
+ * When reading a params file, only the root process parses it; the parsed params are serialized
+ * and broadcast to the other processes. If a cache path is given, the root process first looks
+ * for a cache file there, written by an earlier run from the same params text. On a hit, the
+ * serialized params are read from the cache and the parser is not run; on a miss, the cache file
+ * is written after parsing. For a Lua params program, the params text is the program's
+ * paramsFileString, so the program is run every time, and changes to the files it reads are
+ * never missed.
+ */
 class PVParams {
   public:
    PVParams(size_t initialSize, Communicator *inIcComm);
-   PVParams(const char *filename, size_t initialSize, Communicator *inIcComm);
+   PVParams(
+         const char *filename,
+         size_t initialSize,
+         Communicator *inIcComm,
+         std::string const &cachePath = std::string());
    PVParams(const char *buffer, long int bufferLength, size_t initialSize, Communicator *inIcComm);
    virtual ~PVParams();
 
    bool getParseStatus() { return parseStatus; }
 
+   /** True if the params were read from the cache file instead of being parsed. */
+   bool getLoadedFromCache() const { return mLoadedFromCache; }
+
+   /**
+    * Returns the parsed params in a compact binary format: the groups, with their keywords and
+    * parameters, and the parameter sweeps. Two PVParams objects with the same parameters and
+    * sweeps, in the same order, have the same serialization.
+    */
+   std::vector<char> serialize();
+
    template <typename T>
    void ioParamValueRequired(
          enum ParamsIOFlag ioFlag,
@@ -406,9 +451,26 @@ class PVParams {
    FileStream *mPrintParamsStream = nullptr;
    FileStream *mPrintLuaStream    = nullptr;
 
+   std::unordered_map<std::string, ParameterGroup *> mGroupIndex; // the groups, by name
+   std::string mCachePath;
+   bool mLoadedFromCache = false;
+
    int initialize(size_t initialSize);
    int parseFile(const char *filename);
    void loadParamBuffer(char const *filename, std::string &paramsFileString);
+
+   /**
+    * Called by the root process. If the cache file exists and was written from the given params
+    * text, reads the serialized params from it and returns true.
+    */
+   bool readCache(std::string const &source, std::vector<char> &serialized);
+
+   /** Called by the root process. Writes the serialized params to the cache file. */
+   void writeCache(std::string const &source, std::vector<char> const &serialized);
+
+   /** Replaces the groups and parameter sweeps with those of a serialize() buffer. */
+   void deserialize(std::vector<char> const &serialized);
+
    int parseBuffer(const char *buffer, long int bufferLength);
    int setParameterSweepSize();
    void addGroup(char *keyword, char *name);
@@ -0,0 +1,130 @@
+#include "ProbeBinaryFile.hpp"
+#include "io/io.hpp"
+#include "utils/BufferUtilsCompress.hpp"
+#include "utils/PVLog.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace PV {
+
+namespace {
+
+struct ProbeBinaryHeader {
+   char mMagic[4];
+   std::uint32_t mVersion;
+   std::uint32_t mHeaderSize;
+   std::uint32_t mNumColumns;
+   std::uint32_t mRecordSize;
+   std::uint32_t mCompressed;
+   std::uint32_t mRecordsPerBlock;
+   std::uint32_t mSchemaSize;
+};
+
+} // end anonymous namespace
+
+ProbeBinaryFile::ProbeBinaryFile(
+      std::string const &path,
+      std::string const &probeName,
+      std::vector<std::string> const &columnNames,
+      bool compressed,
+      bool append,
+      bool verifyWrites) {
+   mNumColumns = (std::uint32_t)columnNames.size();
+   FatalIf(mNumColumns == 0U, "Probe binary file \"%s\" must have a column.\n", path.c_str());
+   mRecordSize = (std::uint32_t)(2 * sizeof(double) + mNumColumns * sizeof(double));
+   mCompressed = compressed;
+   // Blocks the size of a compressLossless block are big enough to compress well, and to make the
+   // writes of an uncompressed file efficient.
+   mRecordsPerBlock = std::max((int)(BufferUtils::losslessBlockSize / mRecordSize), 1);
+   mBlock.resize((std::size_t)mRecordsPerBlock * (std::size_t)mRecordSize);
+
+   std::vector<char> header = makeHeader(probeName, columnNames);
+   bool writeHeader         = true;
+   if (append) {
+      std::ifstream existing(expandLeadingTilde(path), std::ios_base::in | std::ios_base::binary);
+      if (existing.is_open() and existing.peek() != std::ifstream::traits_type::eof()) {
+         std::vector<char> existingHeader(header.size());
+         existing.read(existingHeader.data(), (std::streamsize)existingHeader.size());
+         FatalIf(
+               existing.gcount() != (std::streamsize)header.size() or existingHeader != header,
+               "Unable to append to probe binary file \"%s\": its header does not match.\n",
+               path.c_str());
+         writeHeader = false;
+      }
+   }
+   std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+   if (!writeHeader) {
+      mode |= std::ios_base::app;
+   }
+   mStream = new FileStream(path.c_str(), mode, verifyWrites);
+   if (writeHeader) {
+      mStream->write(header.data(), (long)header.size());
+   }
+}
+
+ProbeBinaryFile::~ProbeBinaryFile() {
+   flush();
+   delete mStream;
+}
+
+std::vector<char> ProbeBinaryFile::makeHeader(
+      std::string const &probeName,
+      std::vector<std::string> const &columnNames) const {
+   std::string schema = probeName + "\n";
+   for (auto const &c : columnNames) {
+      schema.append(c).append("\n");
+   }
+   std::size_t const paddedSchemaSize = (schema.size() + 7) & ~(std::size_t)7;
+
+   ProbeBinaryHeader header;
+   memcpy(header.mMagic, "PVPB", sizeof(header.mMagic));
+   header.mVersion         = version;
+   header.mHeaderSize      = (std::uint32_t)(sizeof(header) + paddedSchemaSize);
+   header.mNumColumns      = mNumColumns;
+   header.mRecordSize      = mRecordSize;
+   header.mCompressed      = mCompressed ? 1U : 0U;
+   header.mRecordsPerBlock = (std::uint32_t)mRecordsPerBlock;
+   header.mSchemaSize      = (std::uint32_t)schema.size();
+
+   std::vector<char> bytes((std::size_t)header.mHeaderSize, '\0');
+   memcpy(bytes.data(), &header, sizeof(header));
+   memcpy(&bytes[sizeof(header)], schema.data(), schema.size());
+   return bytes;
+}
+
+void ProbeBinaryFile::write(double timestamp, int batchIndex, double const *values) {
+   char *record                = &mBlock[(std::size_t)mNumBuffered * (std::size_t)mRecordSize];
+   std::int32_t batchFields[2] = {(std::int32_t)batchIndex, 0};
+   memcpy(record, &timestamp, sizeof(timestamp));
+   memcpy(record + sizeof(double), batchFields, sizeof(batchFields));
+   memcpy(record + 2 * sizeof(double), values, (std::size_t)mNumColumns * sizeof(double));
+   mNumBuffered++;
+   if (mNumBuffered == mRecordsPerBlock) {
+      writeBlock();
+   }
+}
+
+void ProbeBinaryFile::flush() {
+   if (mNumBuffered > 0) {
+      writeBlock();
+   }
+   mStream->flush();
+}
+
+void ProbeBinaryFile::writeBlock() {
+   std::size_t const size = (std::size_t)mNumBuffered * (std::size_t)mRecordSize;
+   if (mCompressed) {
+      std::vector<unsigned char> chunk =
+            BufferUtils::compressLossless(mBlock.data(), size, sizeof(double));
+      std::uint64_t const chunkSize = (std::uint64_t)chunk.size();
+      mStream->write(&chunkSize, (long)sizeof(chunkSize));
+      mStream->write(chunk.data(), (long)chunk.size());
+   }
+   else {
+      mStream->write(mBlock.data(), (long)size);
+   }
+   mNumBuffered = 0;
+}
+
+} // namespace PV
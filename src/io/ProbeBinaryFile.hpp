@@ -0,0 +1,83 @@
+#ifndef PROBEBINARYFILE_HPP_
+#define PROBEBINARYFILE_HPP_
+
+#include "io/FileStream.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * Writes probe output in a binary, columnar format, as an alternative to the text lines
+ * written by the probes' outputState methods.
+ *
+ * The file begins with a header:
+ *    char magic[4]           "PVPB"
+ *    uint32 version          currently 1
+ *    uint32 headerSize       the size in bytes of the header, including the schema
+ *    uint32 numColumns       the number of values in each record
+ *    uint32 recordSize       the size in bytes of each record, 16 + 8 * numColumns
+ *    uint32 compressed       0 for uncompressed, 1 for compressed
+ *    uint32 recordsPerBlock  the maximum number of records in a compressed block
+ *    uint32 schemaSize       the length of the schema text
+ * followed by the schema: the probe name and then the column names, each terminated by a newline,
+ * padded with nulls to a multiple of eight bytes.
+ *
+ * Each record is a double-precision time, a 32-bit batch index, 32 bits of padding, and
+ * numColumns double-precision values. In an uncompressed file, the records follow the header
+ * directly, so that the file can be memory-mapped as an array of records. In a compressed file,
+ * the records are grouped into blocks of at most recordsPerBlock records; each block is written as
+ * a 64-bit length followed by a chunk created by BufferUtils::compressLossless(), with an element
+ * size of eight bytes.
+ *
+ * The python reader for this format is python/pvtools/readprobefile.py.
+ */
+class ProbeBinaryFile {
+  public:
+   /**
+    * Opens the file at the given path. If append is true and the file already holds a header,
+    * the header must match the one this object would write, and records are added to the end of
+    * the file; otherwise the file is truncated and the header is written.
+    */
+   ProbeBinaryFile(
+         std::string const &path,
+         std::string const &probeName,
+         std::vector<std::string> const &columnNames,
+         bool compressed,
+         bool append,
+         bool verifyWrites = false);
+
+   /** Writes any buffered records before closing the file. */
+   ~ProbeBinaryFile();
+
+   /** Adds a record. The values array must hold one value for each column. */
+   void write(double timestamp, int batchIndex, double const *values);
+
+   /** Writes any buffered records to the file. */
+   void flush();
+
+   int getNumColumns() const { return (int)mNumColumns; }
+
+  private:
+   std::vector<char> makeHeader(
+         std::string const &probeName,
+         std::vector<std::string> const &columnNames) const;
+   void writeBlock();
+
+  public:
+   static std::uint32_t const version = 1;
+
+  private:
+   FileStream *mStream = nullptr;
+   std::uint32_t mNumColumns;
+   std::uint32_t mRecordSize;
+   bool mCompressed;
+   int mRecordsPerBlock;
+   int mNumBuffered = 0;
+   std::vector<char> mBlock;
+};
+
+} // namespace PV
+
+#endif // PROBEBINARYFILE_HPP_
@@ -1,4 +1,7 @@
 #include "WeightsFileIO.hpp"
+#include "utils/BufferUtilsCompress.hpp"
+#include <algorithm>
+#include <climits>
 #include <cstdint>
 
 namespace PV {
@@ -120,6 +123,7 @@ bool WeightsFileIO::isCompressedHeader(BufferUtils::WeightHeader const &header)
          isCompressed = true;
          break;
       case BufferUtils::FLOAT:
+      case BufferUtils::LOSSLESS_FLOAT:
          FatalIf(
                header.baseHeader.dataSize != (int)sizeof(float),
                "File \"%s\" has dataSize=%d, inconsistent with dataType FLOAT (%d)\n",
@@ -148,10 +152,23 @@ double WeightsFileIO::readSharedWeights(int frameNumber, BufferUtils::WeightHead
    long arborSizeInPvpLocal = arborSizeInPvpFile;
    std::vector<unsigned char> readBuffer(arborSizeInPvpLocal);
 
+   bool const lossless = header.baseHeader.dataType == BufferUtils::LOSSLESS_FLOAT;
+   long frameStartFile = 0L;
+   std::vector<std::uint64_t> chunkSizes;
+   if (lossless and mMPIBlock->getRank() == mRootProcess) {
+      frameStartFile = mFileStream->getInPos();
+      chunkSizes     = readArborChunkSizes(header);
+   }
+
    int const numArbors = mWeights->getNumArbors();
    for (int arbor = 0; arbor < numArbors; arbor++) {
       if (mMPIBlock->getRank() == mRootProcess) {
-         mFileStream->read(readBuffer.data(), arborSizeInPvpFile);
+         if (lossless) {
+            readLosslessArbor(frameStartFile, chunkSizes, arbor, readBuffer);
+         }
+         else {
+            mFileStream->read(readBuffer.data(), arborSizeInPvpFile);
+         }
       }
       MPI_Bcast(
             readBuffer.data(), arborSizeInPvpFile, MPI_BYTE, mRootProcess, mMPIBlock->getComm());
@@ -162,87 +179,122 @@ double WeightsFileIO::readSharedWeights(int frameNumber, BufferUtils::WeightHead
 
 double
 WeightsFileIO::readNonsharedWeights(int frameNumber, BufferUtils::WeightHeader const &header) {
-   bool compressed          = isCompressedHeader(header);
-   long arborSizeInPvpFile  = calcArborSizeFile(compressed);
-   long arborSizeInPvpLocal = calcArborSizeLocal(compressed);
-   std::vector<unsigned char> readBuffer(arborSizeInPvpLocal);
+   bool compressed         = isCompressedHeader(header);
+   long arborSizeInPvpFile = calcArborSizeFile(compressed);
 
    int const nxp           = mWeights->getPatchSizeX();
    int const nyp           = mWeights->getPatchSizeY();
    int const nfp           = mWeights->getPatchSizeF();
    long patchSizePvpFormat = (long)BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed);
 
+   // Each process needs the patches in its patch box; these are transferred from the root
+   // process a few lines at a time, so that no process holds more than two chunks of lines.
+   int startPatchX, endPatchX, startPatchY, endPatchY;
+   calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
+   int const lineCount     = (endPatchX - startPatchX) * mWeights->getNumDataPatchesF();
+   long const lineSize     = (long)lineCount * patchSizePvpFormat;
+   int const numLines      = endPatchY - startPatchY;
+   int const linesPerChunk = calcLinesPerChunk(lineSize, numLines);
+   int const numChunks     = (numLines + linesPerChunk - 1) / linesPerChunk;
+
+   std::vector<unsigned char> lineBuffers[2];
+   lineBuffers[0].resize((std::size_t)(linesPerChunk * lineSize));
+   lineBuffers[1].resize((std::size_t)(linesPerChunk * lineSize));
+   MPI_Request requests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+   MPI_Comm comm           = mMPIBlock->getComm();
+
+   bool const lossless = header.baseHeader.dataType == BufferUtils::LOSSLESS_FLOAT;
+   float const minVal  = header.minVal;
+   float const maxVal  = header.maxVal;
+
    int const numArbors = mWeights->getNumArbors();
    if (mMPIBlock->getRank() == mRootProcess) {
       long const frameStartFile = mFileStream->getInPos();
+      std::vector<std::uint64_t> chunkSizes;
+      std::vector<unsigned char> arborData;
+      if (lossless) {
+         chunkSizes = readArborChunkSizes(header);
+         arborData.resize((std::size_t)arborSizeInPvpFile);
+      }
+      int slot = 0;
       for (int arbor = 0; arbor < numArbors; arbor++) {
-         long const arborStartInFile = frameStartFile + (long)(arbor * arborSizeInPvpFile);
-         mFileStream->setInPos(arborStartInFile, true /*from beginning of file*/);
-
-         // For each process, need to determine patches to load from the PVP file.
-         // The patch atlas may have a bigger border than the PVP file.
-         int startPatchX, endPatchX, startPatchY, endPatchY;
-         calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
-         int lineCount = (endPatchX - startPatchX) * mWeights->getNumDataPatchesF();
-
-         PVLayerLoc const &preLoc  = mWeights->getGeometry()->getPreLoc();
-         PVLayerLoc const &postLoc = mWeights->getGeometry()->getPostLoc();
-
-         int marginX    = calcNeededBorder(preLoc.nx, postLoc.nx, nxp);
-         int nxExtended = preLoc.nx * mMPIBlock->getGlobalNumColumns() + marginX + marginX;
-
-         int marginY    = calcNeededBorder(preLoc.ny, postLoc.ny, nyp);
-         int nyExtended = preLoc.ny * mMPIBlock->getGlobalNumRows() + marginY + marginY;
+         long const arborStartInFile = frameStartFile + (long)arbor * arborSizeInPvpFile;
+         if (lossless) {
+            readLosslessArbor(frameStartFile, chunkSizes, arbor, arborData);
+         }
+         loadNonsharedPatchesOutsideBox(arbor, minVal, maxVal, compressed);
 
+         int tag = tagbase + arbor;
          for (int destRank = 0; destRank < mMPIBlock->getSize(); destRank++) {
-            int rowIndex, columnIndex, batchElemIndex;
-            mMPIBlock->calcRowColBatchFromRank(destRank, rowIndex, columnIndex, batchElemIndex);
-
-            for (int y = 0; y < endPatchY - startPatchY; y++) {
-               int const startFileX = columnIndex * preLoc.nx;
-               int const startFileY = y + rowIndex * preLoc.ny;
-               int const startFile  = kIndex(
-                     startFileX, startFileY, 0, nxExtended, nyExtended, header.baseHeader.nf);
-               long lineStartInFile = arborStartInFile + (long)startFile * patchSizePvpFormat;
-               mFileStream->setInPos(lineStartInFile, true /*from beginning of file*/);
-
-               int const startPatchLocal = kIndex(
-                     startPatchX,
-                     y + startPatchY,
-                     0,
-                     mWeights->getNumDataPatchesX(),
-                     mWeights->getNumDataPatchesY(),
-                     mWeights->getNumDataPatchesF());
-
-               unsigned char *lineLocInBuffer =
-                     &readBuffer[(long)startPatchLocal * patchSizePvpFormat];
-               std::size_t bufferSize = (std::size_t)lineCount * (std::size_t)patchSizePvpFormat;
-               mFileStream->read(lineLocInBuffer, bufferSize);
-            }
-            if (destRank == mRootProcess) {
-               loadWeightsFromBuffer(readBuffer, arbor, header.minVal, header.maxVal, compressed);
-            }
-            else {
-               int tag       = tagbase + arbor;
-               MPI_Comm comm = mMPIBlock->getComm();
-               MPI_Send(readBuffer.data(), (int)readBuffer.size(), MPI_BYTE, destRank, tag, comm);
+            for (int startLine = 0; startLine < numLines; startLine += linesPerChunk) {
+               int const chunkLines = std::min(linesPerChunk, numLines - startLine);
+
+               // Wait until the send that last used this buffer has finished.
+               MPI_Wait(&requests[slot], MPI_STATUS_IGNORE);
+               std::vector<unsigned char> &lineBuffer = lineBuffers[slot];
+               for (int line = 0; line < chunkLines; line++) {
+                  long lineStartInArbor =
+                        calcLineStartInArbor(destRank, startLine + line, patchSizePvpFormat);
+                  unsigned char *lineLocInBuffer = &lineBuffer[(long)line * lineSize];
+                  if (lossless) {
+                     memcpy(lineLocInBuffer, &arborData[lineStartInArbor], (std::size_t)lineSize);
+                  }
+                  else {
+                     long lineStartInFile = arborStartInFile + lineStartInArbor;
+                     mFileStream->setInPos(lineStartInFile, true /*from beginning of file*/);
+                     mFileStream->read(lineLocInBuffer, lineSize);
+                  }
+               }
+               if (destRank == mRootProcess) {
+                  loadNonsharedPatchLines(
+                        lineBuffer, arbor, startLine, chunkLines, minVal, maxVal, compressed);
+               }
+               else {
+                  int count = (int)(chunkLines * lineSize);
+                  MPI_Isend(
+                        lineBuffer.data(), count, MPI_BYTE, destRank, tag, comm, &requests[slot]);
+                  slot = 1 - slot;
+               }
             }
          }
       }
+      MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
    }
    else {
       for (int arbor = 0; arbor < numArbors; arbor++) {
-         int tag       = tagbase + arbor;
-         MPI_Comm comm = mMPIBlock->getComm();
-         MPI_Recv(
-               readBuffer.data(),
-               (int)readBuffer.size(),
-               MPI_BYTE,
-               mRootProcess,
-               tag,
-               comm,
-               MPI_STATUS_IGNORE);
-         loadWeightsFromBuffer(readBuffer, arbor, header.minVal, header.maxVal, compressed);
+         loadNonsharedPatchesOutsideBox(arbor, minVal, maxVal, compressed);
+
+         // Post the receive for each chunk before loading the previous one, so that the
+         // transfer overlaps with copying weights out of the buffer.
+         int tag = tagbase + arbor;
+         for (int chunk = 0; chunk <= numChunks; chunk++) {
+            if (chunk < numChunks) {
+               int const startLine  = chunk * linesPerChunk;
+               int const chunkLines = std::min(linesPerChunk, numLines - startLine);
+               MPI_Irecv(
+                     lineBuffers[chunk % 2].data(),
+                     (int)(chunkLines * lineSize),
+                     MPI_BYTE,
+                     mRootProcess,
+                     tag,
+                     comm,
+                     &requests[chunk % 2]);
+            }
+            if (chunk > 0) {
+               int const prevChunk  = chunk - 1;
+               int const startLine  = prevChunk * linesPerChunk;
+               int const chunkLines = std::min(linesPerChunk, numLines - startLine);
+               MPI_Wait(&requests[prevChunk % 2], MPI_STATUS_IGNORE);
+               loadNonsharedPatchLines(
+                     lineBuffers[prevChunk % 2],
+                     arbor,
+                     startLine,
+                     chunkLines,
+                     minVal,
+                     maxVal,
+                     compressed);
+            }
+         }
       }
    }
    return header.baseHeader.timestamp;
@@ -281,16 +333,30 @@ void WeightsFileIO::writeSharedWeights(double timestamp, bool compress) {
          minWeight,
          maxWeight);
 
-   mFileStream->write(&header, sizeof(header));
+   bool const lossless = mLosslessCompression and !compress;
+   if (!lossless) {
+      mFileStream->write(&header, sizeof(header));
+   }
 
    long arborSizeInPvpFile  = calcArborSizeLocal(compress);
    long arborSizeInPvpLocal = arborSizeInPvpFile;
    std::vector<unsigned char> writeBuffer(arborSizeInPvpLocal);
 
    int const numArbors = mWeights->getNumArbors();
+   std::vector<std::vector<unsigned char>> arborChunks;
    for (int arbor = 0; arbor < numArbors; arbor++) {
       storeSharedPatches(writeBuffer, arbor, minWeight, maxWeight, compress);
-      mFileStream->write(writeBuffer.data(), arborSizeInPvpFile);
+      if (lossless) {
+         std::size_t const arborSize = writeBuffer.size();
+         arborChunks.push_back(
+               BufferUtils::compressLossless(writeBuffer.data(), arborSize, sizeof(float)));
+      }
+      else {
+         mFileStream->write(writeBuffer.data(), arborSizeInPvpFile);
+      }
+   }
+   if (lossless) {
+      writeLosslessFrame(header, arborChunks);
    }
 }
 
@@ -301,9 +367,30 @@ void WeightsFileIO::writeNonsharedWeights(double timestamp, bool compress) {
    MPI_Allreduce(MPI_IN_PLACE, extrema, 2, MPI_FLOAT, MPI_MIN, mMPIBlock->getComm());
    extrema[1] = -extrema[1];
 
-   long arborSizeInPvpFile  = calcArborSizeFile(compress);
-   long arborSizeInPvpLocal = calcArborSizeLocal(compress);
-   std::vector<unsigned char> writeBuffer(arborSizeInPvpLocal);
+   long arborSizeInPvpFile = calcArborSizeFile(compress);
+
+   int const nxp                 = mWeights->getPatchSizeX();
+   int const nyp                 = mWeights->getPatchSizeY();
+   int const nfp                 = mWeights->getPatchSizeF();
+   auto const patchSizePvpFormat = BufferUtils::weightPatchSize(nxp * nyp * nfp, compress);
+
+   // Each process sends the patches in its patch box to the root process a few lines at a
+   // time, so that no process holds more than two chunks of lines.
+   int startPatchX, endPatchX, startPatchY, endPatchY;
+   calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
+   int const lineCount     = (endPatchX - startPatchX) * mWeights->getNumDataPatchesF();
+   long const lineSize     = (long)lineCount * (long)patchSizePvpFormat;
+   int const numLines      = endPatchY - startPatchY;
+   int const linesPerChunk = calcLinesPerChunk(lineSize, numLines);
+   int const numChunks     = (numLines + linesPerChunk - 1) / linesPerChunk;
+
+   std::vector<unsigned char> lineBuffers[2];
+   lineBuffers[0].resize((std::size_t)(linesPerChunk * lineSize));
+   lineBuffers[1].resize((std::size_t)(linesPerChunk * lineSize));
+   MPI_Request requests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+   MPI_Comm comm           = mMPIBlock->getComm();
+
+   bool const lossless = mLosslessCompression and !compress;
 
    int const numArbors = mWeights->getNumArbors();
    if (mMPIBlock->getRank() == mRootProcess) {
@@ -322,86 +409,102 @@ void WeightsFileIO::writeNonsharedWeights(double timestamp, bool compress) {
             extrema[0] /*min weight*/,
             extrema[1] /*max weight*/,
             compress);
-      mFileStream->write(&header, sizeof(header));
 
-      long const frameStartFile = mFileStream->getOutPos();
+      // In lossless mode, each arbor is assembled in memory and compressed, and the frame is
+      // written once all arbors are done. Otherwise, patches are written directly to the file.
+      std::vector<std::vector<unsigned char>> arborChunks;
+      std::vector<unsigned char> arborData;
+      long frameStartFile = 0L;
+      if (lossless) {
+         arborData.resize((std::size_t)arborSizeInPvpFile);
+      }
+      else {
+         mFileStream->write(&header, sizeof(header));
+         frameStartFile = mFileStream->getOutPos();
+      }
+      int const numSteps = mMPIBlock->getSize() * numChunks;
       for (int arbor = 0; arbor < numArbors; arbor++) {
-         long const arborStartFile = frameStartFile + (long)(arbor * arborSizeInPvpFile);
-         mFileStream->setOutPos(arborStartFile, true /*from beginning of file*/);
-
-         // For each process, need to determine patches to write to the PVP file.
-         // The patch atlas may have a bigger border than the PVP file has.
-         int startPatchX, endPatchX, startPatchY, endPatchY;
-         calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
-         int const numDataPatchesF = mWeights->getNumDataPatchesF();
-         int startPatchK           = startPatchX * numDataPatchesF;
-         int endPatchK             = endPatchX * numDataPatchesF;
-         int const numDataPatchesK = mWeights->getNumDataPatchesX() * numDataPatchesF;
-
-         int const nxp                 = mWeights->getPatchSizeX();
-         int const nyp                 = mWeights->getPatchSizeY();
-         int const nfp                 = mWeights->getPatchSizeF();
-         auto const patchSizePvpFormat = BufferUtils::weightPatchSize(nxp * nyp * nfp, compress);
-
-         for (int sourceRank = 0; sourceRank < mMPIBlock->getSize(); sourceRank++) {
-            int rowIndex, columnIndex, batchElemIndex;
-            mMPIBlock->calcRowColBatchFromRank(sourceRank, rowIndex, columnIndex, batchElemIndex);
-
-            if (sourceRank == mRootProcess) {
-               storeNonsharedPatches(writeBuffer, arbor, extrema[0], extrema[1], compress);
-            }
-            else {
-               int tag       = tagbase + arbor;
-               MPI_Comm comm = mMPIBlock->getComm();
-               MPI_Recv(
-                     writeBuffer.data(),
-                     (int)writeBuffer.size(),
-                     MPI_BYTE,
-                     sourceRank,
-                     tag,
-                     comm,
-                     MPI_STATUS_IGNORE);
-            }
+         long const arborStartFile = frameStartFile + (long)arbor * arborSizeInPvpFile;
+         if (lossless) {
+            std::fill(arborData.begin(), arborData.end(), (unsigned char)0);
+         }
 
-            for (int y = 0; y < endPatchY - startPatchY; y++) {
-               PVLayerLoc const &preLoc = mWeights->getGeometry()->getPreLoc();
-               int const startFileX     = columnIndex * preLoc.nx;
-               int const startFileY     = y + rowIndex * preLoc.ny;
-               int const startFile      = kIndex(
-                     startFileX,
-                     startFileY,
-                     0,
-                     header.baseHeader.nxExtended,
-                     header.baseHeader.nyExtended,
-                     header.baseHeader.nf);
-               long lineStartFile = arborStartFile + (long)startFile * (long)patchSizePvpFormat;
-               mFileStream->setOutPos(lineStartFile, true /*from beginning of file*/);
-
-               int const startPatchLocal = kIndex(
-                     startPatchX,
-                     y + startPatchY,
-                     0,
-                     mWeights->getNumDataPatchesX(),
-                     mWeights->getNumDataPatchesY(),
-                     mWeights->getNumDataPatchesF());
-
-               for (int k = startPatchK; k < endPatchK; k++) {
-                  int patchIndexLocal = kIndex(
-                        k, y + startPatchY, 0, numDataPatchesK, mWeights->getNumDataPatchesY(), 1);
-                  unsigned char *patchLocInBuffer =
-                        &writeBuffer[patchIndexLocal * patchSizePvpFormat];
-                  writePatch(patchLocInBuffer, compress);
+         // Chunks are taken in order of source rank, and in order of lines within a rank.
+         // The receive for each chunk is posted before the previous chunk is written, so that
+         // the transfer overlaps with the file output.
+         int tag = tagbase + arbor;
+         for (int step = 0; step <= numSteps; step++) {
+            if (step < numSteps) {
+               int const sourceRank = step / numChunks;
+               int const startLine  = (step % numChunks) * linesPerChunk;
+               int const chunkLines = std::min(linesPerChunk, numLines - startLine);
+               if (sourceRank == mRootProcess) {
+                  storeNonsharedPatchLines(
+                        lineBuffers[step % 2],
+                        arbor,
+                        startLine,
+                        chunkLines,
+                        extrema[0],
+                        extrema[1],
+                        compress);
+               }
+               else {
+                  MPI_Irecv(
+                        lineBuffers[step % 2].data(),
+                        (int)(chunkLines * lineSize),
+                        MPI_BYTE,
+                        sourceRank,
+                        tag,
+                        comm,
+                        &requests[step % 2]);
                }
             }
+            if (step > 0) {
+               int const prevStep   = step - 1;
+               int const sourceRank = prevStep / numChunks;
+               int const startLine  = (prevStep % numChunks) * linesPerChunk;
+               int const chunkLines = std::min(linesPerChunk, numLines - startLine);
+               MPI_Wait(&requests[prevStep % 2], MPI_STATUS_IGNORE);
+               std::vector<unsigned char> const &lineBuffer = lineBuffers[prevStep % 2];
+               for (int line = 0; line < chunkLines; line++) {
+                  long lineStartInArbor = calcLineStartInArbor(
+                        sourceRank, startLine + line, (long)patchSizePvpFormat);
+                  if (!lossless) {
+                     long lineStartFile = arborStartFile + lineStartInArbor;
+                     mFileStream->setOutPos(lineStartFile, true /*from beginning of file*/);
+                  }
+                  for (int k = 0; k < lineCount; k++) {
+                     long patchIndexInBuffer = (long)line * lineCount + (long)k;
+                     long patchStartInBuffer = patchIndexInBuffer * (long)patchSizePvpFormat;
+                     unsigned char const *patchLocInBuffer = &lineBuffer[patchStartInBuffer];
+                     if (lossless) {
+                        long patchStartInArbor =
+                              lineStartInArbor + (long)k * (long)patchSizePvpFormat;
+                        copyPatch(&arborData[patchStartInArbor], patchLocInBuffer);
+                     }
+                     else {
+                        writePatch(patchLocInBuffer, compress);
+                     }
+                  }
+               }
+            }
+         }
+         if (lossless) {
+            arborChunks.push_back(
+                  BufferUtils::compressLossless(arborData.data(), arborData.size(), sizeof(float)));
          }
       }
+      if (lossless) {
+         writeLosslessFrame(header, arborChunks);
+         return;
+      }
       // If file length is shorter than it should be, the last patch is shrunken at the end.
       // In this case, we need to pad out the file length so that file reading does not hit
       // end-of-file too early.
       // If file length is longer than required by this frame, we don't need to do anything. This
       // situation can arise, for example, for the outputPath file from a connection if we restart
       // from a checkpoint when several frames were written after that checkpoint.
-      long const frameEndFile = frameStartFile + (long)(numArbors * arborSizeInPvpFile);
+      long const frameEndFile = frameStartFile + (long)numArbors * arborSizeInPvpFile;
       mFileStream->setOutPos(0L, std::ios_base::end);
       long const endOfFile = mFileStream->getOutPos();
       if (endOfFile < frameEndFile) {
@@ -411,12 +514,22 @@ void WeightsFileIO::writeNonsharedWeights(double timestamp, bool compress) {
       mFileStream->setOutPos(frameEndFile, true /*from beginning*/);
    }
    else {
+      // Pack each chunk while the previous one is still being sent.
+      int slot = 0;
       for (int arbor = 0; arbor < numArbors; arbor++) {
-         storeNonsharedPatches(writeBuffer, arbor, extrema[0], extrema[1], compress);
-         int tag       = tagbase + arbor;
-         MPI_Comm comm = mMPIBlock->getComm();
-         MPI_Send(writeBuffer.data(), (int)writeBuffer.size(), MPI_BYTE, mRootProcess, tag, comm);
+         int tag = tagbase + arbor;
+         for (int startLine = 0; startLine < numLines; startLine += linesPerChunk) {
+            int const chunkLines = std::min(linesPerChunk, numLines - startLine);
+            MPI_Wait(&requests[slot], MPI_STATUS_IGNORE);
+            std::vector<unsigned char> &lineBuffer = lineBuffers[slot];
+            storeNonsharedPatchLines(
+                  lineBuffer, arbor, startLine, chunkLines, extrema[0], extrema[1], compress);
+            int count = (int)(chunkLines * lineSize);
+            MPI_Isend(lineBuffer.data(), count, MPI_BYTE, mRootProcess, tag, comm, &requests[slot]);
+            slot = 1 - slot;
+         }
       }
+      MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
    }
 }
 
@@ -474,8 +587,118 @@ void WeightsFileIO::writePatch(unsigned char const *patchBuffer, bool compressed
    mFileStream->setOutPos(patchEndInFile, true /*from start of file*/);
 }
 
+void WeightsFileIO::copyPatch(unsigned char *patchInArbor, unsigned char const *patchBuffer) {
+   int const nxp = mWeights->getPatchSizeX();
+   int const nfp = mWeights->getPatchSizeF();
+
+   Patch patch;
+
+   // As in writePatch, the patch header in the arbor is always unshrunken.
+   patch.nx     = (std::uint16_t)nxp;
+   patch.ny     = (std::uint16_t)mWeights->getPatchSizeY();
+   patch.offset = (std::uint32_t)0;
+   memcpy(patchInArbor, &patch.nx, sizeof(patch.nx));
+   memcpy(&patchInArbor[sizeof(patch.nx)], &patch.ny, sizeof(patch.ny));
+   memcpy(&patchInArbor[sizeof(patch.nx) + sizeof(patch.ny)], &patch.offset, sizeof(patch.offset));
+
+   memcpy(&patch.nx, patchBuffer, sizeof(patch.nx));
+   memcpy(&patch.ny, &patchBuffer[sizeof(patch.nx)], sizeof(patch.ny));
+   memcpy(&patch.offset, &patchBuffer[sizeof(patch.nx) + sizeof(patch.ny)], sizeof(patch.offset));
+
+   std::size_t patchHeaderSize = sizeof(patch.nx) + sizeof(patch.ny) + sizeof(patch.offset);
+   std::size_t dataStart       = patchHeaderSize + (std::size_t)patch.offset * sizeof(float);
+   std::size_t stride          = (std::size_t)(nfp * nxp) * sizeof(float);
+   std::size_t lineLength      = (std::size_t)nfp * (std::size_t)patch.nx * sizeof(float);
+   for (std::uint16_t y = (std::uint16_t)0; y < patch.ny; y++) {
+      std::size_t lineOffset = dataStart + (std::size_t)y * stride;
+      memcpy(&patchInArbor[lineOffset], &patchBuffer[lineOffset], lineLength);
+   }
+}
+
+std::vector<std::uint64_t>
+WeightsFileIO::readArborChunkSizes(BufferUtils::WeightHeader const &header) {
+   std::vector<std::uint64_t> chunkSizes((std::size_t)header.baseHeader.nBands);
+   mFileStream->read(chunkSizes.data(), (long)(chunkSizes.size() * sizeof(std::uint64_t)));
+   return chunkSizes;
+}
+
+void WeightsFileIO::readLosslessArbor(
+      long frameStart,
+      std::vector<std::uint64_t> const &chunkSizes,
+      int arbor,
+      std::vector<unsigned char> &arborData) {
+   long chunkStart = frameStart + (long)(chunkSizes.size() * sizeof(std::uint64_t));
+   for (int a = 0; a < arbor; a++) {
+      chunkStart += (long)chunkSizes[a];
+   }
+   std::vector<unsigned char> chunk((std::size_t)chunkSizes[arbor]);
+   mFileStream->setInPos(chunkStart, true /*from beginning of file*/);
+   mFileStream->read(chunk.data(), (long)chunk.size());
+   BufferUtils::decompressLossless(chunk.data(), chunk.size(), arborData.data(), arborData.size());
+}
+
+void WeightsFileIO::writeLosslessFrame(
+      BufferUtils::WeightHeader &header,
+      std::vector<std::vector<unsigned char>> const &arborChunks) {
+   std::vector<std::uint64_t> chunkSizes;
+   long frameSize = (long)(arborChunks.size() * sizeof(std::uint64_t));
+   for (auto const &chunk : arborChunks) {
+      chunkSizes.push_back((std::uint64_t)chunk.size());
+      frameSize += (long)chunk.size();
+   }
+   FatalIf(
+         frameSize > (long)INT_MAX,
+         "Compressed weights for \"%s\" take %ld bytes, too many for the recordSize field.\n",
+         mWeights->getName().c_str(),
+         frameSize);
+   // The whole frame is one record, so that moveToFrame can skip over it.
+   header.baseHeader.dataType   = BufferUtils::LOSSLESS_FLOAT;
+   header.baseHeader.numRecords = 1;
+   header.baseHeader.recordSize = (int)frameSize;
+   mFileStream->write(&header, sizeof(header));
+   mFileStream->write(chunkSizes.data(), (long)(chunkSizes.size() * sizeof(std::uint64_t)));
+   for (auto const &chunk : arborChunks) {
+      mFileStream->write(chunk.data(), (long)chunk.size());
+   }
+}
+
 // utility function members
 
+int WeightsFileIO::calcLinesPerChunk(long lineSize, int numLines) {
+   long linesPerChunk = (long)mStreamBufferSize / lineSize;
+   if (linesPerChunk < 1L) {
+      linesPerChunk = 1L;
+   }
+   if (linesPerChunk > (long)numLines) {
+      linesPerChunk = (long)numLines;
+   }
+   FatalIf(
+         linesPerChunk * lineSize > (long)INT_MAX,
+         "Weights for \"%s\" have lines of %ld bytes, too many for an MPI message.\n",
+         mWeights->getName().c_str(),
+         lineSize);
+   return (int)linesPerChunk;
+}
+
+long WeightsFileIO::calcLineStartInArbor(int rank, int line, long patchSize) {
+   PVLayerLoc const &preLoc  = mWeights->getGeometry()->getPreLoc();
+   PVLayerLoc const &postLoc = mWeights->getGeometry()->getPostLoc();
+
+   int marginX    = calcNeededBorder(preLoc.nx, postLoc.nx, mWeights->getPatchSizeX());
+   int nxExtended = preLoc.nx * mMPIBlock->getGlobalNumColumns() + marginX + marginX;
+
+   int marginY    = calcNeededBorder(preLoc.ny, postLoc.ny, mWeights->getPatchSizeY());
+   int nyExtended = preLoc.ny * mMPIBlock->getGlobalNumRows() + marginY + marginY;
+
+   int rowIndex, columnIndex, batchElemIndex;
+   mMPIBlock->calcRowColBatchFromRank(rank, rowIndex, columnIndex, batchElemIndex);
+
+   int const startFileX = columnIndex * preLoc.nx;
+   int const startFileY = line + rowIndex * preLoc.ny;
+   int const startFile  = kIndex(startFileX, startFileY, 0, nxExtended, nyExtended, preLoc.nf);
+   return (long)startFile * patchSize;
+}
+
 void WeightsFileIO::moveToFrame(
       BufferUtils::WeightHeader &header,
       FileStream &fileStream,
@@ -594,23 +817,89 @@ void WeightsFileIO::loadWeightsFromBuffer(
    int const nfp        = mWeights->getPatchSizeF();
    int const numPatches = mWeights->getNumDataPatches();
 
-   auto const patchSizePvpFormat     = BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed);
+   auto const patchSizePvpFormat = BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed);
+   for (int k = 0; k < numPatches; k++) {
+      std::size_t const offsetInFile = patchSizePvpFormat * (std::size_t)k;
+      loadPatch(&dataFromFile[offsetInFile], arbor, k, minValue, maxValue, compressed);
+   }
+}
+
+void WeightsFileIO::loadNonsharedPatchLines(
+      std::vector<unsigned char> const &lineData,
+      int arbor,
+      int startLine,
+      int numLines,
+      float minValue,
+      float maxValue,
+      bool compressed) {
+   int const nxp                 = mWeights->getPatchSizeX();
+   int const nyp                 = mWeights->getPatchSizeY();
+   int const nfp                 = mWeights->getPatchSizeF();
+   auto const patchSizePvpFormat = BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed);
+
+   int startPatchX, endPatchX, startPatchY, endPatchY;
+   calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
+   int const numDataPatchesF = mWeights->getNumDataPatchesF();
+   int const numDataPatchesK = mWeights->getNumDataPatchesX() * numDataPatchesF;
+   int const startPatchK     = startPatchX * numDataPatchesF;
+   int const lineCount       = (endPatchX - startPatchX) * numDataPatchesF;
+
+   for (int line = 0; line < numLines; line++) {
+      int const y = startPatchY + startLine + line;
+      for (int k = 0; k < lineCount; k++) {
+         int patchIndexLocal = kIndex(
+               startPatchK + k, y, 0, numDataPatchesK, mWeights->getNumDataPatchesY(), 1);
+         std::size_t const patchIndexInBuffer = (std::size_t)(line * lineCount + k);
+         unsigned char const *patchInBuffer   = &lineData[patchIndexInBuffer * patchSizePvpFormat];
+         loadPatch(patchInBuffer, arbor, patchIndexLocal, minValue, maxValue, compressed);
+      }
+   }
+}
+
+void WeightsFileIO::loadNonsharedPatchesOutsideBox(
+      int arbor,
+      float minValue,
+      float maxValue,
+      bool compressed) {
+   int const nxp = mWeights->getPatchSizeX();
+   int const nyp = mWeights->getPatchSizeY();
+   int const nfp = mWeights->getPatchSizeF();
+   std::vector<unsigned char> zeroPatch(BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed));
+
+   int startPatchX, endPatchX, startPatchY, endPatchY;
+   calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
+   int const numPatchesX = mWeights->getNumDataPatchesX();
+   int const numPatchesY = mWeights->getNumDataPatchesY();
+   int const numPatchesF = mWeights->getNumDataPatchesF();
+   int const numPatches  = mWeights->getNumDataPatches();
+   for (int k = 0; k < numPatches; k++) {
+      int x = kxPos(k, numPatchesX, numPatchesY, numPatchesF);
+      int y = kyPos(k, numPatchesX, numPatchesY, numPatchesF);
+      if (x < startPatchX or x >= endPatchX or y < startPatchY or y >= endPatchY) {
+         loadPatch(zeroPatch.data(), arbor, k, minValue, maxValue, compressed);
+      }
+   }
+}
+
+void WeightsFileIO::loadPatch(
+      unsigned char const *patchFromFile,
+      int arbor,
+      int patchIndex,
+      float minValue,
+      float maxValue,
+      bool compressed) {
+   int const nxp = mWeights->getPatchSizeX();
+   int const nyp = mWeights->getPatchSizeY();
+   int const nfp = mWeights->getPatchSizeF();
+
    std::size_t const patchHeaderSize = sizeof(unsigned int) + 2UL * sizeof(unsigned short);
+   unsigned char const *patchData    = &patchFromFile[patchHeaderSize];
+   float *weightsInPatch             = mWeights->getDataFromDataIndex(arbor, patchIndex);
    if (compressed) {
-      for (int k = 0; k < numPatches; k++) {
-         std::size_t const offsetInFile     = patchSizePvpFormat * (std::size_t)k;
-         unsigned char const *patchFromFile = &dataFromFile[offsetInFile + patchHeaderSize];
-         float *weightsInPatch              = mWeights->getDataFromDataIndex(arbor, k);
-         decompressPatch(patchFromFile, weightsInPatch, nxp * nyp * nfp, minValue, maxValue);
-      }
+      decompressPatch(patchData, weightsInPatch, nxp * nyp * nfp, minValue, maxValue);
    }
    else {
-      for (int k = 0; k < numPatches; k++) {
-         std::size_t const offsetInFile     = patchSizePvpFormat * (std::size_t)k;
-         unsigned char const *patchFromFile = &dataFromFile[offsetInFile + patchHeaderSize];
-         float *weightsInPatch              = mWeights->getDataFromDataIndex(arbor, k);
-         memcpy(weightsInPatch, patchFromFile, (std::size_t)(nxp * nyp * nfp) * sizeof(float));
-      }
+      memcpy(weightsInPatch, patchData, (std::size_t)(nxp * nyp * nfp) * sizeof(float));
    }
 }
 
@@ -676,54 +965,66 @@ void WeightsFileIO::storeSharedPatches(
    }
 }
 
-void WeightsFileIO::storeNonsharedPatches(
-      std::vector<unsigned char> &dataFromFile,
+void WeightsFileIO::storeNonsharedPatchLines(
+      std::vector<unsigned char> &lineData,
+      int arbor,
+      int startLine,
+      int numLines,
+      float minValue,
+      float maxValue,
+      bool compressed) {
+   int const nxp                 = mWeights->getPatchSizeX();
+   int const nyp                 = mWeights->getPatchSizeY();
+   int const nfp                 = mWeights->getPatchSizeF();
+   auto const patchSizePvpFormat = BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed);
+
+   int startPatchX, endPatchX, startPatchY, endPatchY;
+   calcPatchBox(startPatchX, endPatchX, startPatchY, endPatchY);
+   int const numDataPatchesF = mWeights->getNumDataPatchesF();
+   int const numDataPatchesK = mWeights->getNumDataPatchesX() * numDataPatchesF;
+   int const startPatchK     = startPatchX * numDataPatchesF;
+   int const lineCount       = (endPatchX - startPatchX) * numDataPatchesF;
+
+   for (int line = 0; line < numLines; line++) {
+      int const y = startPatchY + startLine + line;
+      for (int k = 0; k < lineCount; k++) {
+         int patchIndexLocal = kIndex(
+               startPatchK + k, y, 0, numDataPatchesK, mWeights->getNumDataPatchesY(), 1);
+         std::size_t const patchIndexInBuffer = (std::size_t)(line * lineCount + k);
+         unsigned char *patchInBuffer         = &lineData[patchIndexInBuffer * patchSizePvpFormat];
+         storeNonsharedPatch(patchInBuffer, arbor, patchIndexLocal, minValue, maxValue, compressed);
+      }
+   }
+}
+
+void WeightsFileIO::storeNonsharedPatch(
+      unsigned char *patchForFile,
       int arbor,
+      int patchIndex,
       float minValue,
       float maxValue,
       bool compressed) {
-   int const nxp            = mWeights->getPatchSizeX();
-   int const nyp            = mWeights->getPatchSizeY();
-   int const nfp            = mWeights->getPatchSizeF();
-   int const numDataPatches = mWeights->getNumDataPatches();
+   int const nxp = mWeights->getPatchSizeX();
+   int const nyp = mWeights->getPatchSizeY();
+   int const nfp = mWeights->getPatchSizeF();
 
-   auto const patchSizePvpFormat     = BufferUtils::weightPatchSize(nxp * nyp * nfp, compressed);
    std::size_t const patchHeaderSize = sizeof(std::uint32_t) + 2UL * sizeof(std::uint16_t);
-   if (compressed) {
-      for (int k = 0; k < numDataPatches; k++) {
-         std::size_t const offsetInFile = patchSizePvpFormat * (std::size_t)k;
-         unsigned char *patchFromFile   = &dataFromFile[offsetInFile];
 
-         Patch const &patch = mWeights->getPatch(k);
-         std::uint16_t shortDim;
-         shortDim = (std::uint16_t)patch.nx;
-         memcpy(patchFromFile, &shortDim, sizeof(shortDim));
-         shortDim = (std::uint16_t)patch.ny;
-         memcpy(&patchFromFile[sizeof(shortDim)], &shortDim, sizeof(shortDim));
-         std::uint32_t offset = (std::uint32_t)patch.offset;
-         memcpy(&patchFromFile[2UL * sizeof(shortDim)], &offset, sizeof(offset));
-         patchFromFile += patchHeaderSize;
-         float const *weightsInPatch = mWeights->getDataFromDataIndex(arbor, k);
-         compressPatch(patchFromFile, weightsInPatch, nxp * nyp * nfp, minValue, maxValue);
-      }
+   Patch const &patch = mWeights->getPatch(patchIndex);
+   std::uint16_t shortDim;
+   shortDim = (std::uint16_t)patch.nx;
+   memcpy(patchForFile, &shortDim, sizeof(shortDim));
+   shortDim = (std::uint16_t)patch.ny;
+   memcpy(&patchForFile[sizeof(shortDim)], &shortDim, sizeof(shortDim));
+   std::uint32_t offset = (std::uint32_t)patch.offset;
+   memcpy(&patchForFile[2UL * sizeof(shortDim)], &offset, sizeof(offset));
+   unsigned char *patchData    = &patchForFile[patchHeaderSize];
+   float const *weightsInPatch = mWeights->getDataFromDataIndex(arbor, patchIndex);
+   if (compressed) {
+      compressPatch(patchData, weightsInPatch, nxp * nyp * nfp, minValue, maxValue);
    }
    else {
-      for (int k = 0; k < numDataPatches; k++) {
-         std::size_t const offsetInFile = patchSizePvpFormat * (std::size_t)k;
-         unsigned char *patchFromFile   = &dataFromFile[offsetInFile];
-
-         Patch const &patch = mWeights->getPatch(k);
-         std::uint16_t shortDim;
-         shortDim = (std::uint16_t)patch.nx;
-         memcpy(patchFromFile, &shortDim, sizeof(shortDim));
-         shortDim = (std::uint16_t)patch.ny;
-         memcpy(&patchFromFile[sizeof(shortDim)], &shortDim, sizeof(shortDim));
-         std::uint32_t offset = (std::uint32_t)patch.offset;
-         memcpy(&patchFromFile[2UL * sizeof(shortDim)], &offset, sizeof(offset));
-         patchFromFile += patchHeaderSize;
-         float const *weightsInPatch = mWeights->getDataFromDataIndex(arbor, k);
-         memcpy(patchFromFile, weightsInPatch, (std::size_t)(nxp * nyp * nfp) * sizeof(float));
-      }
+      memcpy(patchData, weightsInPatch, (std::size_t)(nxp * nyp * nfp) * sizeof(float));
    }
 }
 
@@ -5,6 +5,8 @@
 #include "io/FileStream.hpp"
 #include "structures/MPIBlock.hpp"
 #include "utils/BufferUtilsPvp.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace PV {
@@ -24,6 +26,26 @@ class WeightsFileIO {
 
    void writeWeights(double timestamp, bool compress);
 
+   /**
+    * If the lossless-compression flag is set, writeWeights() with compress false writes the
+    * weights as compressed float data (dataType LOSSLESS_FLOAT) instead of as raw floats.
+    * Each arbor is compressed separately with BufferUtils::compressLossless(), and the frame
+    * starts with a table of the compressed arbor sizes, so that any arbor can be located
+    * without decompressing the others. The flag does not affect writes with compress true,
+    * which use the lossy 8-bit format. readWeights() recognizes compressed files on its own.
+    */
+   void setLosslessCompression(bool losslessCompression) {
+      mLosslessCompression = losslessCompression;
+   }
+
+   /**
+    * Sets the approximate size in bytes of the buffers used to move nonshared weights between
+    * the MPI processes and the file. Nonshared weights are transferred a chunk of patch lines
+    * at a time, and each process holds at most two chunks, so that memory use depends on this
+    * size rather than on the size of the layer. A chunk always holds at least one line.
+    */
+   void setStreamBufferSize(std::size_t streamBufferSize) { mStreamBufferSize = streamBufferSize; }
+
    /**
     * Positions a weight pvp file to the start of the data (i.e. just past the end of the header)
     * of the indicated frame. The header for that frame is read into the buffer pointed by the
@@ -47,6 +69,30 @@ class WeightsFileIO {
 
    void writeNonsharedWeights(double timestamp, bool compress);
 
+   /**
+    * Reads the table of compressed arbor sizes at the start of a LOSSLESS_FLOAT frame.
+    * The FileStream must be positioned at the start of the frame data.
+    */
+   std::vector<std::uint64_t> readArborChunkSizes(BufferUtils::WeightHeader const &header);
+
+   /**
+    * Reads the compressed data for the given arbor of a LOSSLESS_FLOAT frame, whose data starts
+    * at position frameStart in the file, and decompresses it into arborData.
+    */
+   void readLosslessArbor(
+         long frameStart,
+         std::vector<std::uint64_t> const &chunkSizes,
+         int arbor,
+         std::vector<unsigned char> &arborData);
+
+   /**
+    * Writes the header, the table of compressed arbor sizes, and the compressed arbors of a
+    * LOSSLESS_FLOAT frame. The header's dataType, numRecords and recordSize fields are set here.
+    */
+   void writeLosslessFrame(
+         BufferUtils::WeightHeader &header,
+         std::vector<std::vector<unsigned char>> const &arborChunks);
+
    /**
     * The size in bytes of one arbor in the PVP file. This is the number of patches times
     * the patch size in bytes. For shared weights, the number of patches is
@@ -72,6 +118,18 @@ class WeightsFileIO {
     */
    long calcArborSizeLocal(bool compressed);
 
+   /**
+    * Returns the number of lines of the patch box to transfer at a time, given the size in
+    * bytes of one line in PVP format and the number of lines in the patch box.
+    */
+   int calcLinesPerChunk(long lineSize, int numLines);
+
+   /**
+    * Returns the position, relative to the start of an arbor in the PVP file, of the given line
+    * of the patch box of the given rank. The argument patchSize is the patch size in bytes.
+    */
+   long calcLineStartInArbor(int rank, int line, long patchSize);
+
    void calcPatchBox(int &startPatchX, int &endPatchX, int &startPatchY, int &endPatchY);
 
    void calcPatchRange(
@@ -92,6 +150,33 @@ class WeightsFileIO {
          float maxValue,
          bool compressed);
 
+   /**
+    * Loads numLines lines of the patch box, starting at line startLine, from a buffer in
+    * PVP format into the given arbor.
+    */
+   void loadNonsharedPatchLines(
+         std::vector<unsigned char> const &lineData,
+         int arbor,
+         int startLine,
+         int numLines,
+         float minValue,
+         float maxValue,
+         bool compressed);
+
+   /**
+    * Patches outside the patch box do not appear in the PVP file. They are loaded as though
+    * they were read from a patch of zeroes.
+    */
+   void loadNonsharedPatchesOutsideBox(int arbor, float minValue, float maxValue, bool compressed);
+
+   void loadPatch(
+         unsigned char const *patchFromFile,
+         int arbor,
+         int patchIndex,
+         float minValue,
+         float maxValue,
+         bool compressed);
+
    void decompressPatch(
          unsigned char const *dataFromFile,
          float *destWeights,
@@ -106,9 +191,23 @@ class WeightsFileIO {
          float maxValue,
          bool compressed);
 
-   void storeNonsharedPatches(
-         std::vector<unsigned char> &dataFromFile,
+   /**
+    * Stores numLines lines of the patch box, starting at line startLine, of the given arbor
+    * into a buffer in PVP format.
+    */
+   void storeNonsharedPatchLines(
+         std::vector<unsigned char> &lineData,
+         int arbor,
+         int startLine,
+         int numLines,
+         float minValue,
+         float maxValue,
+         bool compressed);
+
+   void storeNonsharedPatch(
+         unsigned char *patchForFile,
          int arbor,
+         int patchIndex,
          float minValue,
          float maxValue,
          bool compressed);
@@ -129,12 +228,22 @@ class WeightsFileIO {
     */
    void writePatch(unsigned char const *patchBuffer, bool compressed);
 
+   /**
+    * The in-memory counterpart of writePatch, for uncompressed patches: copies the patch from
+    * patchBuffer to patchInArbor, an uncompressed arbor laid out as in the PVP file. Only the
+    * active region of the patch is copied.
+    */
+   void copyPatch(unsigned char *patchInArbor, unsigned char const *patchBuffer);
+
    // Data members
   private:
    FileStream *mFileStream   = nullptr;
    MPIBlock const *mMPIBlock = nullptr;
    Weights *mWeights         = nullptr;
 
+   bool mLosslessCompression     = false;
+   std::size_t mStreamBufferSize = (std::size_t)1 << 22;
+
    int const mRootProcess = 0;
    int const tagbase      = 500;
 }; // class WeightsFileIO
@@ -6,6 +6,7 @@
  */
 
 #include "fileio.hpp"
+#include "FileContainer.hpp"
 #include "connections/weight_conversions.hpp"
 #include "structures/Buffer.hpp"
 #include "utils/BufferUtilsMPI.hpp"
@@ -534,6 +535,10 @@ static inline int makeDirectory(char const *dir) {
 void ensureDirExists(MPIBlock const *mpiBlock, char const *dirname) {
    // If rank zero, see if path exists, and try to create it if it doesn't.
    // If not rank zero, the routine does nothing.
+   // The mount point of a FileContainer is not a directory on disk, so nothing is created.
+   if (FileContainer::isMountPoint(dirname)) {
+      return;
+   }
    int rank = mpiBlock->getRank();
    struct stat pathstat;
    int resultcode = checkDirExists(mpiBlock, dirname, &pathstat);
@@ -28,6 +28,14 @@ void usage() {
    InfoLog().printf(" [-l <output log file>]\n");
    InfoLog().printf(" [-w <working directory>]\n");
    InfoLog().printf(" [-r|-c <checkpoint directory>]\n");
+   InfoLog().printf(" [-rows <rows>] [-columns <columns>] [-batchwidth <batch width>]\n");
+   InfoLog().printf(" [--auto-decomposition]\n");
+   InfoLog().printf(" [-trace <trace output file>]\n");
+   InfoLog().printf(" [--benchmark [number of warm-up steps]] [--benchmark-quiet]\n");
+   InfoLog().printf(" [--cost-calibration <pvbenchmarks results file>]\n");
+   InfoLog().printf(
+         " [--serve <socket path> --serve-input <layer name> --serve-output <layer name>]\n");
+   InfoLog().printf(" [--params-cache <params cache file>]\n");
 #ifdef PV_USE_OPENMP_THREADS
    InfoLog().printf(" [-t [number of threads]\n");
    InfoLog().printf(" [-n]\n");
@@ -60,6 +68,16 @@ int parse_options(
       int *num_rows,
       int *num_columns,
       int *batch_width,
+      int *auto_decomposition,
+      char **trace_file,
+      bool *useDefaultBenchmarkWarmup,
+      int *benchmarkWarmup,
+      int *benchmark_quiet,
+      char **cost_calibration_file,
+      char **serve_socket,
+      char **serve_input,
+      char **serve_output,
+      char **params_cache_file,
       int *dry_run) {
    paramusage[0] = true;
    int arg;
@@ -84,6 +102,20 @@ int parse_options(
    pv_getopt_int(argc, argv, "-rows", num_rows, paramusage);
    pv_getopt_int(argc, argv, "-columns", num_columns, paramusage);
    pv_getopt_int(argc, argv, "-batchwidth", batch_width, paramusage);
+   if (pv_getopt(argc, argv, "--auto-decomposition", paramusage) == 0) {
+      *auto_decomposition = 1;
+   }
+   pv_getopt_str(argc, argv, "-trace", trace_file, paramusage);
+   pv_getoptionalopt_int(
+         argc, argv, "--benchmark", benchmarkWarmup, useDefaultBenchmarkWarmup, paramusage);
+   if (pv_getopt(argc, argv, "--benchmark-quiet", paramusage) == 0) {
+      *benchmark_quiet = 1;
+   }
+   pv_getopt_str(argc, argv, "--cost-calibration", cost_calibration_file, paramusage);
+   pv_getopt_str(argc, argv, "--serve", serve_socket, paramusage);
+   pv_getopt_str(argc, argv, "--serve-input", serve_input, paramusage);
+   pv_getopt_str(argc, argv, "--serve-output", serve_output, paramusage);
+   pv_getopt_str(argc, argv, "--params-cache", params_cache_file, paramusage);
    if (pv_getopt(argc, argv, "-n", paramusage) == 0) {
       *dry_run = 1;
    }
@@ -121,6 +121,16 @@ int parse_options(
       int *numRows,
       int *numColumns,
       int *batch_width,
+      int *auto_decomposition,
+      char **trace_file,
+      bool *useDefaultBenchmarkWarmup,
+      int *benchmarkWarmup,
+      int *benchmark_quiet,
+      char **cost_calibration_file,
+      char **serve_socket,
+      char **serve_input,
+      char **serve_output,
+      char **params_cache_file,
       int *dryrun);
 
 /** If a filename begins with "~/" or is "~", presume the user means the home directory.
@@ -33,12 +33,13 @@ double readRandState(
    int const numLocal   = nxLocal * nyLocal * nf;
    std::size_t numBytes = sizeof(taus_uint4) * (std::size_t)numLocal;
 
+   BufferUtils::SparseFileTable frameTable;
    for (int m = 0; m < mpiBlock->getBatchDimension(); m++) {
       for (int b = 0; b < loc->nbatch; b++) {
          int globalBatchIndex = b + loc->nbatch * m;
          if (mpiBlock->getRank() == rootProcess) {
-            timestamps[globalBatchIndex] =
-                  BufferUtils::readDenseFromPvp(path.c_str(), &buffer, globalBatchIndex);
+            timestamps[globalBatchIndex] = BufferUtils::readDenseFromPvp(
+                  path.c_str(), &buffer, globalBatchIndex, &frameTable);
          }
          BufferUtils::scatter(mpiBlock, buffer, loc->nx, loc->ny, m, rootProcess);
          if (mpiBlock->getBatchIndex() == m) {
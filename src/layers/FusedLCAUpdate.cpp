@@ -0,0 +1,245 @@
+#include "FusedLCAUpdate.hpp"
+#include "cMakeHeader.h"
+#include "utils/PVAssert.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace PV {
+
+namespace {
+
+// The row loops below use the same expressions as the applyGSyn kernels in
+// updateStateFunctions.h, so that the fused update gives the same values. G1 is null if the layer
+// has only one channel.
+
+void updateLCARow(
+      int n,
+      float const *G0,
+      float const *G1,
+      float const *A,
+      float expTau,
+      float selfInteract,
+      float *V) {
+   if (G1 == nullptr) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int k = 0; k < n; k++) {
+         V[k] = expTau * V[k] + (1.0f - expTau) * (G0[k] + selfInteract * A[k]);
+      }
+   }
+   else {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int k = 0; k < n; k++) {
+         V[k] = expTau * V[k] + (1.0f - expTau) * (G0[k] - G1[k] + selfInteract * A[k]);
+      }
+   }
+}
+
+void updateMomentumLCARow(
+      int n,
+      float const *G0,
+      float const *G1,
+      float const *A,
+      float expTau,
+      float selfInteract,
+      float LCAMomentumRate,
+      float *V,
+      float *prevDrive) {
+   if (G1 == nullptr) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int k = 0; k < n; k++) {
+         float const drive = (1.0f - expTau) * (G0[k] + selfInteract * A[k]);
+         V[k]              = expTau * V[k] + drive + LCAMomentumRate * prevDrive[k];
+         prevDrive[k]      = drive;
+      }
+   }
+   else {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int k = 0; k < n; k++) {
+         float const drive = (1.0f - expTau) * ((G0[k] - G1[k]) + selfInteract * A[k]);
+         V[k]              = expTau * V[k] + drive + LCAMomentumRate * prevDrive[k];
+         prevDrive[k]      = drive;
+      }
+   }
+}
+
+void updateISTARow(
+      int n,
+      float const *G0,
+      float const *G1,
+      float const *A,
+      float rate,
+      float VThresh,
+      float *V) {
+   for (int k = 0; k < n; k++) {
+      float const sign = A[k] != 0.0f ? A[k] / fabsf(A[k]) : 0.0f;
+      float const G    = G1 == nullptr ? G0[k] : G0[k] - G1[k];
+      V[k] += rate * (G - (VThresh * sign));
+   }
+}
+
+} // namespace
+
+FusedLCAUpdate::FusedLCAUpdate(PVLayerLoc const *loc, int numChannels, bool emitActiveIndices) {
+   PVHalo const *halo = &loc->halo;
+   mLoc               = *loc;
+   mNumChannels       = numChannels;
+   mNumNeurons        = loc->nx * loc->ny * loc->nf;
+   mNumExtended       = (loc->nx + halo->lt + halo->rt) * (loc->ny + halo->dn + halo->up) * loc->nf;
+   if (emitActiveIndices) {
+      mRowEntries.resize((std::size_t)(loc->nbatch * mNumNeurons));
+      mRowCounts.resize((std::size_t)(loc->nbatch * loc->ny));
+   }
+}
+
+void FusedLCAUpdate::updateLCA(
+      float const *GSynHead,
+      float *V,
+      float *A,
+      double const *dtAdapt,
+      float tau,
+      bool selfInteract,
+      PtwiseLinearTransfer const &transfer) {
+   int const nbatch               = mLoc.nbatch;
+   int const ny                   = mLoc.ny;
+   int const rowSize              = mLoc.nx * mLoc.nf;
+   int const channelSize          = nbatch * mNumNeurons;
+   float const selfInteractFactor = selfInteract ? 1.0f : 0.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for collapse(2) schedule(static)
+#endif
+   for (int b = 0; b < nbatch; b++) {
+      for (int y = 0; y < ny; y++) {
+         int const kRow = b * mNumNeurons + y * rowSize;
+         float *rowV    = &V[kRow];
+         if (mNumChannels == 1 or mNumChannels == 2) {
+            float const expTau = (float)exp(-dtAdapt[b] / (double)tau);
+            float const *G1    = mNumChannels == 2 ? &GSynHead[channelSize + kRow] : nullptr;
+            float const *rowA  = &A[b * mNumExtended + restrictedRowStart(y)];
+            updateLCARow(rowSize, &GSynHead[kRow], G1, rowA, expTau, selfInteractFactor, rowV);
+         }
+         finishRow(b, y, rowV, A, &transfer);
+      }
+   }
+}
+
+void FusedLCAUpdate::updateMomentumLCA(
+      float const *GSynHead,
+      float *V,
+      float *A,
+      float *prevDrive,
+      double const *dtAdapt,
+      float tau,
+      float LCAMomentumRate,
+      bool selfInteract,
+      PtwiseLinearTransfer const &transfer) {
+   int const nbatch               = mLoc.nbatch;
+   int const ny                   = mLoc.ny;
+   int const rowSize              = mLoc.nx * mLoc.nf;
+   int const channelSize          = nbatch * mNumNeurons;
+   float const selfInteractFactor = selfInteract ? 1.0f : 0.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for collapse(2) schedule(static)
+#endif
+   for (int b = 0; b < nbatch; b++) {
+      for (int y = 0; y < ny; y++) {
+         int const kRow = b * mNumNeurons + y * rowSize;
+         float *rowV    = &V[kRow];
+         if (mNumChannels == 1 or mNumChannels == 2) {
+            float const expTau = expf((float)-dtAdapt[b] / tau);
+            float const *G1    = mNumChannels == 2 ? &GSynHead[channelSize + kRow] : nullptr;
+            float const *rowA  = &A[b * mNumExtended + restrictedRowStart(y)];
+            updateMomentumLCARow(
+                  rowSize,
+                  &GSynHead[kRow],
+                  G1,
+                  rowA,
+                  expTau,
+                  selfInteractFactor,
+                  LCAMomentumRate,
+                  rowV,
+                  &prevDrive[kRow]);
+         }
+         finishRow(b, y, rowV, A, &transfer);
+      }
+   }
+}
+
+void FusedLCAUpdate::updateISTA(
+      float const *GSynHead,
+      float *V,
+      float *A,
+      double const *dtAdapt,
+      float tau,
+      float VThresh) {
+   int const nbatch      = mLoc.nbatch;
+   int const ny          = mLoc.ny;
+   int const rowSize     = mLoc.nx * mLoc.nf;
+   int const channelSize = nbatch * mNumNeurons;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for collapse(2) schedule(static)
+#endif
+   for (int b = 0; b < nbatch; b++) {
+      for (int y = 0; y < ny; y++) {
+         int const kRow = b * mNumNeurons + y * rowSize;
+         float *rowV    = &V[kRow];
+         if (mNumChannels == 1 or mNumChannels == 2) {
+            float const *G1   = mNumChannels == 2 ? &GSynHead[channelSize + kRow] : nullptr;
+            float const *rowA = &A[b * mNumExtended + restrictedRowStart(y)];
+            updateISTARow(
+                  rowSize, &GSynHead[kRow], G1, rowA, (float)dtAdapt[b] / tau, VThresh, rowV);
+         }
+         finishRow(b, y, rowV, A, nullptr);
+      }
+   }
+}
+
+void FusedLCAUpdate::finishRow(
+      int b,
+      int y,
+      float const *rowV,
+      float *A,
+      PtwiseLinearTransfer const *transfer) {
+   int const rowSize = mLoc.nx * mLoc.nf;
+   int const kexRow  = restrictedRowStart(y);
+   float *rowA       = &A[b * mNumExtended + kexRow];
+   if (transfer) {
+      transfer->applyRow(rowV, rowA, rowSize);
+   }
+   else {
+      std::memcpy(rowA, rowV, sizeof(float) * (std::size_t)rowSize);
+   }
+   if (mRowEntries.empty()) {
+      return;
+   }
+
+   // Every value is written to the next free entry, but only a nonzero value advances the count,
+   // so that the loop has no branch that depends on the data.
+   SparseList<float>::Entry *entries = &mRowEntries[(b * mLoc.ny + y) * rowSize];
+   int count                         = 0;
+   for (int k = 0; k < rowSize; k++) {
+      float const a        = rowA[k];
+      entries[count].index = (uint32_t)(kexRow + k);
+      entries[count].value = a;
+      count += a != 0.0f ? 1 : 0;
+   }
+   mRowCounts[b * mLoc.ny + y] = count;
+}
+
+int FusedLCAUpdate::restrictedRowStart(int y) const {
+   int const extendedRowSize = (mLoc.nx + mLoc.halo.lt + mLoc.halo.rt) * mLoc.nf;
+   return (y + mLoc.halo.up) * extendedRowSize + mLoc.halo.lt * mLoc.nf;
+}
+
+std::size_t FusedLCAUpdate::getMemorySize() const {
+   return mRowEntries.size() * sizeof(SparseList<float>::Entry) + mRowCounts.size() * sizeof(int);
+}
+
+} // namespace PV
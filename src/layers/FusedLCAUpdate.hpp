@@ -0,0 +1,107 @@
+#ifndef FUSEDLCAUPDATE_HPP_
+#define FUSEDLCAUPDATE_HPP_
+
+#include "PtwiseLinearTransfer.hpp"
+#include "include/PVLayerLoc.h"
+#include "structures/SparseList.hpp"
+#include <vector>
+
+namespace PV {
+
+/**
+ * Computes the CPU update of HyPerLCALayer, MomentumLCALayer and ISTALayer in a single pass over
+ * the layer. Each thread takes one row (one y and batch element) of the restricted region at a
+ * time, and while the row is in cache it
+ *   integrates the GSyn channels into V,
+ *   applies the transfer function (the identity for ISTALayer) to set A, and
+ *   if the layer is sparse, lists the nonzero activities of the row as (extended index, value)
+ *   pairs.
+ * The values of V and A are the same as those of updateV_HyPerLCALayer, updateV_MomentumLCALayer
+ * and updateV_ISTALayer, which the GPU still uses.
+ *
+ * The lists let the Publisher build the active indices of the published activity by scanning only
+ * the margins, instead of scanning the whole extended buffer a second time (see
+ * Publisher::setRestrictedActiveIndices()).
+ */
+class FusedLCAUpdate {
+  public:
+   /**
+    * The loc gives the size of the layer and its margins. If emitActiveIndices is false, the
+    * update does not list the active neurons, and getRowEntries() and getRowCounts() return null.
+    */
+   FusedLCAUpdate(PVLayerLoc const *loc, int numChannels, bool emitActiveIndices);
+
+   /**
+    * The HyPerLCALayer update: V = e*V + (1-e)*(G + s*A) with e = exp(-dt/tau), where G is the
+    * first channel minus the second if there are two, and s is 1 or 0 according to selfInteract;
+    * then A = transfer(V).
+    */
+   void updateLCA(
+         float const *GSynHead,
+         float *V,
+         float *A,
+         double const *dtAdapt,
+         float tau,
+         bool selfInteract,
+         PtwiseLinearTransfer const &transfer);
+
+   /**
+    * The MomentumLCALayer update: the LCA drive (1-e)*(G + s*A) is added to e*V together with
+    * LCAMomentumRate times the drive of the previous update, which is kept in prevDrive.
+    */
+   void updateMomentumLCA(
+         float const *GSynHead,
+         float *V,
+         float *A,
+         float *prevDrive,
+         double const *dtAdapt,
+         float tau,
+         float LCAMomentumRate,
+         bool selfInteract,
+         PtwiseLinearTransfer const &transfer);
+
+   /** The ISTALayer update: V += (dt/tau)*(G - VThresh*sign(A)), then A = V. */
+   void updateISTA(
+         float const *GSynHead,
+         float *V,
+         float *A,
+         double const *dtAdapt,
+         float tau,
+         float VThresh);
+
+   /**
+    * The nonzero activities found by the last update. The entries of row y of batch element b
+    * start at index (b * ny + y) * nx * nf, and there are getRowCounts()[b * ny + y] of them, in
+    * increasing order of extended index.
+    */
+   SparseList<float>::Entry const *getRowEntries() const {
+      return mRowEntries.empty() ? nullptr : mRowEntries.data();
+   }
+
+   int const *getRowCounts() const { return mRowCounts.empty() ? nullptr : mRowCounts.data(); }
+
+   /** Returns the number of bytes held by the lists of nonzero activities. */
+   std::size_t getMemorySize() const;
+
+  private:
+   /**
+    * Sets row y of batch element b of A from the updated row of V, and lists its nonzero values
+    * if the layer is sparse. If transfer is null, the row of V is copied.
+    */
+   void finishRow(int b, int y, float const *rowV, float *A, PtwiseLinearTransfer const *transfer);
+
+   /** The extended index, within a batch element, of the start of restricted row y. */
+   int restrictedRowStart(int y) const;
+
+  private:
+   PVLayerLoc mLoc;
+   int mNumChannels;
+   int mNumNeurons;
+   int mNumExtended;
+   std::vector<SparseList<float>::Entry> mRowEntries;
+   std::vector<int> mRowCounts;
+};
+
+} // namespace PV
+
+#endif // FUSEDLCAUPDATE_HPP_
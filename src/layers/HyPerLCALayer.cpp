@@ -6,6 +6,7 @@
  */
 
 #include "HyPerLCALayer.hpp"
+#include "utils/MemoryTracker.hpp"
 #include <iostream>
 
 #ifdef PV_USE_CUDA
@@ -14,28 +15,6 @@
 
 #endif
 
-void HyPerLCALayer_update_state(
-      const int nbatch,
-      const int numNeurons,
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-      const int numChannels,
-      float *V,
-      int numVertices,
-      float *verticesV,
-      float *verticesA,
-      float *slopes,
-      const bool selfInteract,
-      double *dtAdapt,
-      const float tau,
-      float *GSynHead,
-      float *activity);
-
 namespace PV {
 
 HyPerLCALayer::HyPerLCALayer() { initialize_base(); }
@@ -45,7 +24,13 @@ HyPerLCALayer::HyPerLCALayer(const char *name, HyPerCol *hc) {
    initialize(name, hc);
 }
 
-HyPerLCALayer::~HyPerLCALayer() { free(mAdaptiveTimeScaleProbeName); }
+HyPerLCALayer::~HyPerLCALayer() {
+   free(mAdaptiveTimeScaleProbeName);
+   if (publisher) {
+      publisher->wait(); // The publisher may still hold the update's lists of active neurons.
+   }
+   delete mFusedUpdate;
+}
 
 int HyPerLCALayer::initialize_base() {
    numChannels = 1; // If a connection connects to this layer on inhibitory channel,
@@ -69,6 +54,11 @@ Response::Status HyPerLCALayer::allocateDataStructures() {
          mAdaptiveTimeScaleProbe == nullptr
          || getLayerLoc()->nbatch == mAdaptiveTimeScaleProbe->getNumValues());
    mDeltaTimes.resize(getLayerLoc()->nbatch);
+   mFusedUpdate = new FusedLCAUpdate(getLayerLoc(), numChannels, getSparseFlag());
+   if (getSparseFlag()) {
+      MemoryTracker::instance()->allocate(
+            name, "active index lists", mFusedUpdate->getMemorySize());
+   }
    return Response::SUCCESS;
 }
 
@@ -234,45 +224,25 @@ Response::Status HyPerLCALayer::updateStateGpu(double time, double dt) {
 double HyPerLCALayer::getDeltaUpdateTime() { return parent->getDeltaTime(); }
 
 Response::Status HyPerLCALayer::updateState(double time, double dt) {
-   const PVLayerLoc *loc = getLayerLoc();
-   float *A              = clayer->activity->data;
-   float *V              = getV();
-   int num_channels      = getNumChannels();
-   float *gSynHead       = GSyn == NULL ? NULL : GSyn[0];
-   {
-      int nx          = loc->nx;
-      int ny          = loc->ny;
-      int nf          = loc->nf;
-      int num_neurons = nx * ny * nf;
-      int nbatch      = loc->nbatch;
-      // Only update when the probe updates
-
-      HyPerLCALayer_update_state(
-            nbatch,
-            num_neurons,
-            nx,
-            ny,
-            nf,
-            loc->halo.lt,
-            loc->halo.rt,
-            loc->halo.dn,
-            loc->halo.up,
-            numChannels,
-            V,
-            numVertices,
-            verticesV,
-            verticesA,
-            slopes,
-            selfInteract,
-            deltaTimes(),
-            timeConstantTau / (float)dt,
-            gSynHead,
-            A);
-   }
-
+   float *gSynHead = GSyn == NULL ? NULL : GSyn[0];
+   PtwiseLinearTransfer transfer(numVertices, verticesV, verticesA, slopes);
+   mFusedUpdate->updateLCA(
+         gSynHead,
+         getV(),
+         clayer->activity->data,
+         deltaTimes(),
+         timeConstantTau / (float)dt,
+         selfInteract,
+         transfer);
+   publishRestrictedActiveIndices();
    return Response::SUCCESS;
 }
 
+void HyPerLCALayer::publishRestrictedActiveIndices() {
+   HyPerLayer::publishRestrictedActiveIndices(
+         mFusedUpdate->getRowEntries(), mFusedUpdate->getRowCounts());
+}
+
 double *HyPerLCALayer::deltaTimes() {
    if (mAdaptiveTimeScaleProbe) {
       mAdaptiveTimeScaleProbe->getValues(parent->simulationTime(), &mDeltaTimes);
@@ -284,48 +254,3 @@ double *HyPerLCALayer::deltaTimes() {
 }
 
 } /* namespace PV */
-
-void HyPerLCALayer_update_state(
-      const int nbatch,
-      const int numNeurons,
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-      const int numChannels,
-
-      float *V,
-      int numVertices,
-      float *verticesV,
-      float *verticesA,
-      float *slopes,
-      const bool selfInteract,
-      double *dtAdapt,
-      const float tau,
-      float *GSynHead,
-      float *activity) {
-   updateV_HyPerLCALayer(
-         nbatch,
-         numNeurons,
-         numChannels,
-         V,
-         GSynHead,
-         activity,
-         numVertices,
-         verticesV,
-         verticesA,
-         slopes,
-         dtAdapt,
-         tau,
-         selfInteract,
-         nx,
-         ny,
-         nf,
-         lt,
-         rt,
-         dn,
-         up);
-}
@@ -9,6 +9,7 @@
 #define HYPERLCALAYER_HPP_
 
 #include "ANNLayer.hpp"
+#include "FusedLCAUpdate.hpp"
 #include "probes/AdaptiveTimeScaleProbe.hpp"
 
 namespace PV {
@@ -55,6 +56,12 @@ class HyPerLCALayer : public PV::ANNLayer {
 
    virtual Response::Status updateState(double time, double dt) override;
 
+   /**
+    * If the layer is sparse, passes the lists of nonzero activities that the last update made to
+    * the publisher, so that the active indices can be found without scanning the whole layer.
+    */
+   void publishRestrictedActiveIndices();
+
 #ifdef PV_USE_CUDA
    virtual Response::Status updateStateGpu(double time, double dt) override;
 #endif
@@ -80,6 +87,7 @@ class HyPerLCALayer : public PV::ANNLayer {
    char *mAdaptiveTimeScaleProbeName               = nullptr;
    AdaptiveTimeScaleProbe *mAdaptiveTimeScaleProbe = nullptr;
    std::vector<double> mDeltaTimes;
+   FusedLCAUpdate *mFusedUpdate = nullptr;
 
 #ifdef PV_USE_CUDA
    PVCuda::CudaBuffer *d_dtAdapt;
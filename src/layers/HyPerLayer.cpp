@@ -21,6 +21,9 @@
 #include "include/pv_common.h"
 #include "io/FileStream.hpp"
 #include "io/io.hpp"
+#include "probes/LayerStatistics.hpp"
+#include "utils/MemoryTracker.hpp"
+#include "utils/Tracer.hpp"
 #include <assert.h>
 #include <iostream>
 #include <sstream>
@@ -194,6 +197,7 @@ HyPerLayer::~HyPerLayer() {
 #endif
 
    delete mOutputStateStream;
+   delete mStatistics;
 
    delete mInitVObject;
    freeClayer();
@@ -238,6 +242,7 @@ HyPerLayer::~HyPerLayer() {
       free(thread_gSyn);
    }
    delete publisher;
+   MemoryTracker::instance()->releaseOwner(name);
 }
 
 template <typename T>
@@ -316,6 +321,7 @@ void HyPerLayer::allocateBuffer(T **buf, int bufsize, const char *bufname) {
             bufname,
             strerror(errno));
    }
+   MemoryTracker::instance()->allocate(name, "layer buffers", sizeof(T) * (std::size_t)bufsize);
 }
 // Declare the instantiations of allocateBuffer that occur in other .cpp files; otherwise you may
 // get linker errors.
@@ -338,6 +344,8 @@ void HyPerLayer::allocateActivity() {
    clayer->activity = pvcube_new(&clayer->loc, getNumExtendedAllBatches());
    FatalIf(
          clayer->activity == nullptr, "%s failed to allocate activity cube.\n", getDescription_c());
+   MemoryTracker::instance()->allocate(
+         name, "activity", sizeof(float) * (std::size_t)getNumExtendedAllBatches());
 }
 
 void HyPerLayer::allocatePrevActivity() {
@@ -481,12 +489,17 @@ void HyPerLayer::allocateGSyn() {
       for (int m = 1; m < numChannels; m++) {
          GSyn[m] = GSyn[0] + m * getNumNeuronsAllBatches();
       }
+      MemoryTracker::instance()->allocate(
+            name,
+            "GSyn",
+            sizeof(float) * (std::size_t)getNumNeuronsAllBatches() * (std::size_t)numChannels);
    }
 }
 
 void HyPerLayer::addPublisher() {
    MPIBlock const *mpiBlock = parent->getCommunicator()->getLocalMPIBlock();
    publisher = new Publisher(*mpiBlock, clayer->activity, getNumDelayLevels(), getSparseFlag());
+   MemoryTracker::instance()->allocate(name, "data store", publisher->getMemorySize());
 }
 
 void HyPerLayer::checkpointPvpActivityFloat(
@@ -515,6 +528,10 @@ void HyPerLayer::checkpointRandState(
       char const *bufferName,
       Random *randState,
       bool extendedFlag) {
+   if (randState->isCounterBased()) {
+      // A counter-based generator has no state to save.
+      return;
+   }
    bool registerSucceeded = checkpointer->registerCheckpointEntry(
          std::make_shared<CheckpointEntryRandState>(
                getName(),
@@ -1442,6 +1459,11 @@ Response::Status HyPerLayer::allocateDataStructures() {
          }
          thread_gSyn[i] = tempMem;
       }
+      MemoryTracker::instance()->allocate(
+            name,
+            "thread GSyn",
+            sizeof(float) * (std::size_t)getNumNeuronsAllBatches()
+                  * (std::size_t)parent->getNumThreads());
    }
 
 // Allocate cuda stuff on gpu if set
@@ -1666,6 +1688,11 @@ Response::Status HyPerLayer::registerData(Checkpointer *checkpointer) {
    io_timer = new Timer(getName(), "layer", "io     ");
    checkpointer->registerTimer(io_timer);
 
+   mMetrics = checkpointer->getMetricsRegistry()->addCounters(std::string(getName()), "layer");
+   if (publisher) {
+      publisher->setMetrics(mMetrics);
+   }
+
    if (mInitVObject) {
       auto message = std::make_shared<RegisterDataMessage<Checkpointer>>(checkpointer);
       mInitVObject->respond(message);
@@ -1742,6 +1769,7 @@ Response::Status HyPerLayer::callUpdateState(double simTime, double dt) {
       }
 
       update_timer->start();
+      std::uint64_t const updateStart = Tracer::now();
 #ifdef PV_USE_CUDA
       if (mUpdateGpu) {
          gpu_update_timer->start();
@@ -1760,6 +1788,15 @@ Response::Status HyPerLayer::callUpdateState(double simTime, double dt) {
       updatedDeviceDatastore = true;
 #endif
       update_timer->stop();
+      if (mMetrics) {
+         // The update reads the GSyn channels and V, and writes V and A.
+         std::uint64_t const numNeurons  = (std::uint64_t)getNumNeuronsAllBatches();
+         std::uint64_t const numExtended = (std::uint64_t)getNumExtendedAllBatches();
+         mMetrics->mComputeTime += Tracer::now() - updateStart;
+         mMetrics->mNeuronUpdates += numNeurons;
+         mMetrics->mBytesMoved +=
+               (numNeurons * (std::uint64_t)(numChannels + 2) + numExtended) * sizeof(float);
+      }
       mNeedToPublish  = true;
       mLastUpdateTime = simTime;
    }
@@ -1913,9 +1950,24 @@ int HyPerLayer::setActivity() {
          loc->halo.up);
 }
 
+LayerStatistics *HyPerLayer::getStatistics() {
+   if (mStatistics == nullptr) {
+      mStatistics = new LayerStatistics(this, parent->getCommunicator()->communicator());
+   }
+   return mStatistics;
+}
+
 // Updates active indices for all levels (delays) here
 void HyPerLayer::updateAllActiveIndices() { publisher->updateAllActiveIndices(); }
 
+void HyPerLayer::publishRestrictedActiveIndices(
+      SparseList<float>::Entry const *rowEntries,
+      int const *rowCounts) {
+   if (getSparseFlag()) {
+      publisher->setRestrictedActiveIndices(rowEntries, rowCounts);
+   }
+}
+
 void HyPerLayer::updateActiveIndices() { publisher->updateActiveIndices(0); }
 
 bool HyPerLayer::isExchangeFinished(int delay) { return publisher->isExchangeFinished(delay); }
@@ -1948,6 +2000,7 @@ int HyPerLayer::recvAllSynapticInput() {
             switchGpu = true;
          }
 #endif
+         TraceZone deliverZone(conn->getName(), "deliver");
          conn->deliver();
       }
 #ifdef PV_USE_CUDA
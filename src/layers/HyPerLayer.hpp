@@ -54,6 +54,7 @@ namespace PV {
 
 class PVParams;
 class BaseConnection;
+class LayerStatistics;
 
 typedef enum TriggerBehaviorTypeEnum {
    NO_TRIGGER,
@@ -215,6 +216,15 @@ class HyPerLayer : public BaseLayer {
    virtual void allocateGSyn();
    void addPublisher();
 
+   /**
+    * If the layer is sparse, hands the publisher the per-row lists of active neurons that the
+    * layer's update built, so that the publisher need not rescan the activity. The lists must
+    * stay valid until the publisher is done with them (see Publisher::setRestrictedActiveIndices).
+    */
+   void publishRestrictedActiveIndices(
+         SparseList<float>::Entry const *rowEntries,
+         int const *rowCounts);
+
    /*
     * Allocates a buffer of the given length.  The membrane potential and activity buffer, among
     * others, are created using allocateBuffer.
@@ -493,6 +503,15 @@ class HyPerLayer : public BaseLayer {
 
    Publisher *getPublisher() { return publisher; }
 
+   /**
+    * Returns the object that computes, and caches, the summary statistics of the layer's
+    * activity and membrane potential that probes report. It is created on the first call.
+    */
+   LayerStatistics *getStatistics();
+
+   /** The layer's performance counters, or null before registerData() has been called. */
+   PerformanceCounters const *getMetrics() const { return mMetrics; }
+
   protected:
    virtual Response::Status
    communicateInitInfo(std::shared_ptr<CommunicateInitInfoMessage const> message) override;
@@ -681,6 +700,10 @@ class HyPerLayer : public BaseLayer {
    Timer *timescale_timer;
    Timer *io_timer;
 
+   PerformanceCounters *mMetrics = nullptr;
+
+   LayerStatistics *mStatistics = nullptr;
+
 #ifdef PV_USE_CUDA
    PVCuda::CudaTimer *gpu_recvsyn_timer;
    PVCuda::CudaTimer *gpu_update_timer;
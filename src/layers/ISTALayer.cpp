@@ -6,6 +6,7 @@
  */
 
 #include "ISTALayer.hpp"
+#include "utils/MemoryTracker.hpp"
 #include <iostream>
 
 #ifdef PV_USE_CUDA
@@ -14,25 +15,6 @@
 
 #endif
 
-void ISTALayer_update_state(
-      const int nbatch,
-      const int numNeurons,
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-      const int numChannels,
-
-      float *V,
-      const float Vth,
-      double *dtAdapt,
-      const float tau,
-      float *GSynHead,
-      float *activity);
-
 namespace PV {
 
 ISTALayer::ISTALayer() { initialize_base(); }
@@ -42,7 +24,12 @@ ISTALayer::ISTALayer(const char *name, HyPerCol *hc) {
    initialize(name, hc);
 }
 
-ISTALayer::~ISTALayer() {}
+ISTALayer::~ISTALayer() {
+   if (publisher) {
+      publisher->wait(); // The publisher may still hold the update's lists of active neurons.
+   }
+   delete mFusedUpdate;
+}
 
 int ISTALayer::initialize_base() {
    numChannels = 1; // If a connection connects to this layer on inhibitory channel,
@@ -58,7 +45,18 @@ int ISTALayer::initialize(const char *name, HyPerCol *hc) {
    return PV_SUCCESS;
 }
 
-Response::Status ISTALayer::allocateDataStructures() { return ANNLayer::allocateDataStructures(); }
+Response::Status ISTALayer::allocateDataStructures() {
+   auto status = ANNLayer::allocateDataStructures();
+   if (!Response::completed(status)) {
+      return status;
+   }
+   mFusedUpdate = new FusedLCAUpdate(getLayerLoc(), numChannels, getSparseFlag());
+   if (getSparseFlag()) {
+      MemoryTracker::instance()->allocate(
+            name, "active index lists", mFusedUpdate->getMemorySize());
+   }
+   return Response::SUCCESS;
+}
 
 int ISTALayer::ioParamsFillGroup(enum ParamsIOFlag ioFlag) {
    int status = ANNLayer::ioParamsFillGroup(ioFlag);
@@ -175,41 +173,18 @@ Response::Status ISTALayer::updateStateGpu(double time, double dt) {
 double ISTALayer::getDeltaUpdateTime() { return parent->getDeltaTime(); }
 
 Response::Status ISTALayer::updateState(double time, double dt) {
-   const PVLayerLoc *loc = getLayerLoc();
-   float *A              = clayer->activity->data;
-   float *V              = getV();
-   int num_channels      = getNumChannels();
-   float *gSynHead       = GSyn == NULL ? NULL : GSyn[0];
-   int nx                = loc->nx;
-   int ny                = loc->ny;
-   int nf                = loc->nf;
-   int num_neurons       = nx * ny * nf;
-   int nbatch            = loc->nbatch;
-   // Only update when the probe updates
+   float *A        = clayer->activity->data;
+   float *V        = getV();
+   float *gSynHead = GSyn == NULL ? NULL : GSyn[0];
 
    if (triggerLayer != NULL && triggerLayer->needUpdate(time, parent->getDeltaTime())) {
-      for (int i = 0; i < num_neurons * nbatch; i++) {
+      for (int i = 0; i < getNumNeuronsAllBatches(); i++) {
          V[i] = 0.0;
       }
    }
 
-   ISTALayer_update_state(
-         nbatch,
-         num_neurons,
-         nx,
-         ny,
-         nf,
-         loc->halo.lt,
-         loc->halo.rt,
-         loc->halo.dn,
-         loc->halo.up,
-         numChannels,
-         V,
-         VThresh,
-         deltaTimes(),
-         timeConstantTau / (float)dt,
-         gSynHead,
-         A);
+   mFusedUpdate->updateISTA(gSynHead, V, A, deltaTimes(), timeConstantTau / (float)dt, VThresh);
+   publishRestrictedActiveIndices(mFusedUpdate->getRowEntries(), mFusedUpdate->getRowCounts());
    return Response::SUCCESS;
 }
 
@@ -224,40 +199,3 @@ double *ISTALayer::deltaTimes() {
 }
 
 } /* namespace PV */
-
-void ISTALayer_update_state(
-      const int nbatch,
-      const int numNeurons,
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-      const int numChannels,
-
-      float *V,
-      const float Vth,
-      double *dtAdapt,
-      const float tau,
-      float *GSynHead,
-      float *activity) {
-   updateV_ISTALayer(
-         nbatch,
-         numNeurons,
-         V,
-         GSynHead,
-         activity,
-         Vth,
-         dtAdapt,
-         tau,
-         nx,
-         ny,
-         nf,
-         lt,
-         rt,
-         dn,
-         up,
-         numChannels);
-}
@@ -10,6 +10,7 @@
 // TODO: Take care of code duplication between ISTALayer and HyPerLCALayer.
 
 #include "ANNLayer.hpp"
+#include "FusedLCAUpdate.hpp"
 #include "probes/AdaptiveTimeScaleProbe.hpp"
 
 namespace PV {
@@ -81,6 +82,7 @@ class ISTALayer : public PV::ANNLayer {
    char *mAdaptiveTimeScaleProbeName               = nullptr;
    AdaptiveTimeScaleProbe *mAdaptiveTimeScaleProbe = nullptr;
    std::vector<double> mDeltaTimes;
+   FusedLCAUpdate *mFusedUpdate = nullptr;
 }; // class ISTALayer
 
 } /* namespace PV */
@@ -26,6 +26,10 @@ int ImageFromMemoryBuffer::initialize_base() {
 }
 
 int ImageFromMemoryBuffer::initialize(char const *name, HyPerCol *hc) {
+   int status = InputLayer::initialize(name, hc);
+   if (status != PV_SUCCESS) {
+      return status;
+   }
    if (mUseInputBCflag && mAutoResizeFlag) {
       if (parent->columnId() == 0) {
          ErrorLog().printf(
@@ -65,21 +69,18 @@ int ImageFromMemoryBuffer::setMemoryBuffer(
       return PV_FAILURE;
    }
 
-   int newSize = height * width * numbands;
-
    if (parent->columnId() == 0) {
-      std::vector<float> newData(newSize);
-#ifdef PV_USE_OPENMP_THREADS
-#pragma omp parallel for
-#endif
-      for (int k = 0; k < newSize; k++) {
-         int x             = kxPos(k, width, height, numbands);
-         int y             = kyPos(k, width, height, numbands);
-         int f             = featureIndex(k, width, height, numbands);
-         int externalIndex = x * xstride + y * ystride + f * bandstride;
-         newData.at(k)     = pixelTypeConvert(externalBuffer[externalIndex], zeroval, oneval);
-      }
-      mImage = std::unique_ptr<Image>(new Image(newData, width, height, numbands));
+      mImage = convertMemoryBuffer(
+            externalBuffer,
+            height,
+            width,
+            numbands,
+            xstride,
+            ystride,
+            bandstride,
+            zeroval,
+            oneval);
+      mBatchImages.clear();
    }
    hasNewImageFlag = true;
 
@@ -95,6 +96,16 @@ template int ImageFromMemoryBuffer::setMemoryBuffer<uint8_t>(
       int bandstride,
       uint8_t zeroval,
       uint8_t oneval);
+template int ImageFromMemoryBuffer::setMemoryBuffer<float>(
+      float const *buffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      float zeroval,
+      float oneval);
 
 template <typename pixeltype>
 int ImageFromMemoryBuffer::setMemoryBuffer(
@@ -144,6 +155,136 @@ template int ImageFromMemoryBuffer::setMemoryBuffer<uint8_t>(
       int offsetX,
       int offsetY,
       char const *offsetAnchor);
+template int ImageFromMemoryBuffer::setMemoryBuffer<float>(
+      float const *buffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      float zeroval,
+      float oneval,
+      int offsetX,
+      int offsetY,
+      char const *offsetAnchor);
+
+template <typename pixeltype>
+int ImageFromMemoryBuffer::setMemoryBuffer(
+      int batchElement,
+      pixeltype const *externalBuffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      pixeltype zeroval,
+      pixeltype oneval) {
+   if (batchElement < 0 || batchElement >= parent->getNBatchGlobal()) {
+      if (parent->columnId() == 0) {
+         ErrorLog().printf(
+               "%s: setMemoryBuffer called for batch element %d, but nbatch is %d.\n",
+               getDescription_c(),
+               batchElement,
+               parent->getNBatchGlobal());
+      }
+      return PV_FAILURE;
+   }
+   if (height <= 0 || width <= 0 || numbands <= 0) {
+      if (parent->columnId() == 0) {
+         ErrorLog().printf(
+               "ImageFromMemoryBuffer::setMemoryBuffer: height, width, numbands "
+               "arguments must be positive.\n");
+      }
+      return PV_FAILURE;
+   }
+
+   if (parent->columnId() == 0) {
+      mBatchImages.resize(parent->getNBatchGlobal());
+      mBatchImages.at(batchElement) = convertMemoryBuffer(
+            externalBuffer,
+            height,
+            width,
+            numbands,
+            xstride,
+            ystride,
+            bandstride,
+            zeroval,
+            oneval);
+   }
+   hasNewImageFlag = true;
+
+   return PV_SUCCESS;
+}
+template int ImageFromMemoryBuffer::setMemoryBuffer<uint8_t>(
+      int batchElement,
+      uint8_t const *buffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      uint8_t zeroval,
+      uint8_t oneval);
+template int ImageFromMemoryBuffer::setMemoryBuffer<float>(
+      int batchElement,
+      float const *buffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      float zeroval,
+      float oneval);
+
+template <typename pixeltype>
+std::unique_ptr<Image> ImageFromMemoryBuffer::convertMemoryBuffer(
+      pixeltype const *externalBuffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      pixeltype zeroval,
+      pixeltype oneval) {
+   int newSize = height * width * numbands;
+   std::vector<float> newData(newSize);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
+   for (int k = 0; k < newSize; k++) {
+      int x             = kxPos(k, width, height, numbands);
+      int y             = kyPos(k, width, height, numbands);
+      int f             = featureIndex(k, width, height, numbands);
+      int externalIndex = x * xstride + y * ystride + f * bandstride;
+      newData.at(k)     = pixelTypeConvert(externalBuffer[externalIndex], zeroval, oneval);
+   }
+   return std::unique_ptr<Image>(new Image(newData, width, height, numbands));
+}
+template std::unique_ptr<Image> ImageFromMemoryBuffer::convertMemoryBuffer<uint8_t>(
+      uint8_t const *buffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      uint8_t zeroval,
+      uint8_t oneval);
+template std::unique_ptr<Image> ImageFromMemoryBuffer::convertMemoryBuffer<float>(
+      float const *buffer,
+      int height,
+      int width,
+      int numbands,
+      int xstride,
+      int ystride,
+      int bandstride,
+      float zeroval,
+      float oneval);
 
 template <typename pixeltype>
 float ImageFromMemoryBuffer::pixelTypeConvert(pixeltype q, pixeltype zeroval, pixeltype oneval) {
@@ -153,15 +294,39 @@ template float ImageFromMemoryBuffer::pixelTypeConvert<unsigned char>(
       unsigned char q,
       unsigned char zeroval,
       unsigned char oneval);
+template float ImageFromMemoryBuffer::pixelTypeConvert<float>(
+      float q,
+      float zeroval,
+      float oneval);
+
+void ImageFromMemoryBuffer::initializeActivity() {
+   InputLayer::initializeActivity();
+   hasNewImageFlag = false;
+}
 
-void ImageFromMemoryBuffer::initializeActivity(double time, double dt) { retrieveInput(time, dt); }
+void ImageFromMemoryBuffer::ioParam_batchMethod(enum ParamsIOFlag ioFlag) {
+   mBatchMethod = BatchIndexer::BYFILE;
+}
+
+void ImageFromMemoryBuffer::ioParam_start_frame_index(enum ParamsIOFlag ioFlag) {
+   mStartFrameIndex.assign(parent->getNBatchGlobal(), 0);
+}
+
+Buffer<float> ImageFromMemoryBuffer::retrieveData(int inputIndex) {
+   Image *image = mImage.get();
+   if (inputIndex < (int)mBatchImages.size() and mBatchImages.at(inputIndex) != nullptr) {
+      image = mBatchImages.at(inputIndex).get();
+   }
+   if (image == nullptr) {
+      return Buffer<float>(getTargetWidth(), getTargetHeight(), getLayerLoc()->nf);
+   }
+   return imageToBuffer(*image, describeInput(inputIndex));
+}
 
 Response::Status ImageFromMemoryBuffer::updateState(double time, double dt) {
    assert(hasNewImageFlag); // updateState shouldn't have been called otherwise.
-   Fatal() << "ImageFromMemoryBuffer is currently broken.\n"; // Marked broken Apr 24, 2017.
+   retrieveInput(time, dt);
    hasNewImageFlag = false;
-   // TODO: Need to refactor ImageFromMemoryBuffer to reflect the refactoring of the rest of
-   // the InputLayer hierarchy.
    return Response::SUCCESS;
 }
 
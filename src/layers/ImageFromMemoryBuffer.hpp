@@ -6,9 +6,13 @@
  *  A subclass of BaseInput that processes an image based on an existing memory
  *  buffer instead of reading from a file.
  *
- *  Before using the image (typically after initializing the object but before
- *  calling the parent HyPerCol's run method), call the setMemoryBuffer() method.
- *  If using buildandrun, setMemoryBuffer() can be called using the custominit hook.
+ *  Call the setMemoryBuffer() method to set the image. If it is called before the column is
+ *  allocated (if using buildandrun, in the custominit hook), the image is the initial activity;
+ *  until an image is set, the activity is zero. Each later call sets the image that the layer
+ *  shows from the next timestep on, so that a program embedding the column can push a new frame
+ *  between steps (see EmbeddedColumn::setInput()). Every batch element shows the same image,
+ *  unless it has been given its own image by the overload of setMemoryBuffer() that takes a batch
+ *  element (see InferenceServer, which puts a different request into each batch element).
  */
 
 #ifndef IMAGEFROMMEMORYBUFFER_HPP_
@@ -77,11 +81,28 @@ class ImageFromMemoryBuffer : public ImageLayer {
          int offsetY,
          char const *offsetAnchor);
 
+   /**
+    * Sets the image of one batch element, which the element shows instead of the image set for
+    * all batch elements. batchElement is the global batch index; the other arguments are as in
+    * the first form of setMemoryBuffer(), which clears the images of the individual elements.
+    * Returns PV_FAILURE if batchElement is out of range.
+    */
+   template <typename pixeltype>
+   int setMemoryBuffer(
+         int batchElement,
+         pixeltype const *externalBuffer,
+         int height,
+         int width,
+         int numbands,
+         int xstride,
+         int ystride,
+         int bandstride,
+         pixeltype zeroval,
+         pixeltype oneval);
+
    /**
     * Returns true if a new image has been set by a call to setMemoryBuffer without having been
-    * copied to the
-    * activity buffer by a call to copyBuffer() (which is called by either updateState or
-    * initializeActivity)
+    * copied to the activity buffer by updateState() or initializeActivity().
     */
    virtual bool needUpdate(double time, double dt) override { return hasNewImageFlag; }
 
@@ -92,8 +113,8 @@ class ImageFromMemoryBuffer : public ImageLayer {
    virtual double getDeltaUpdateTime() override;
 
    /**
-       * Overrides updateState
-       */
+    * Copies the image set by the last call to setMemoryBuffer() to the activity buffer.
+    */
    virtual Response::Status updateState(double time, double dt) override;
 
   protected:
@@ -117,9 +138,40 @@ class ImageFromMemoryBuffer : public ImageLayer {
    virtual void ioParam_inputPath(enum ParamsIOFlag ioFlag) override { return; }
 
    /**
-    * Called by HyPerLayer::setActivity() during InitializeState stage; calls copyBuffer()
+    * @brief imageCacheSize: Not used by ImageFromMemoryBuffer.
+    * @details ImageFromMemoryBuffer does not read images from files, so there is nothing to cache.
     */
-   virtual void initializeActivity(double time, double dt);
+   virtual void ioParam_imageCacheSize(enum ParamsIOFlag ioFlag) override { return; }
+
+   /**
+    * @brief batchMethod: Not used by ImageFromMemoryBuffer.
+    * @details The input index of each batch element is its global batch index, so that
+    * setMemoryBuffer() can address the batch elements individually.
+    */
+   virtual void ioParam_batchMethod(enum ParamsIOFlag ioFlag) override;
+
+   /**
+    * @brief start_frame_index: Not used by ImageFromMemoryBuffer.
+    */
+   virtual void ioParam_start_frame_index(enum ParamsIOFlag ioFlag) override;
+
+   /**
+    * Called during the InitializeState stage. Copies the image to the activity buffer if one has
+    * been set.
+    */
+   virtual void initializeActivity() override;
+
+   /** There is an input for each global batch element. */
+   virtual int countInputImages() override { return parent->getNBatchGlobal(); }
+
+   /**
+    * Returns the image of the batch element with the given global index, converted to the number
+    * of features of the layer: the element's own image if it has one, or else the image set for
+    * all batch elements; or, if no image has been set, a buffer of zeros the size of the layer.
+    */
+   virtual Buffer<float> retrieveData(int inputIndex) override;
+
+   virtual std::string describeInput(int index) override { return std::string("memory buffer"); }
 
   private:
    int initialize_base();
@@ -127,10 +179,30 @@ class ImageFromMemoryBuffer : public ImageLayer {
    template <typename pixeltype>
    float pixelTypeConvert(pixeltype q, pixeltype zeroval, pixeltype oneval);
 
+   /**
+    * Called by the root process. Converts the external buffer to an Image, as described in
+    * setMemoryBuffer().
+    */
+   template <typename pixeltype>
+   std::unique_ptr<Image> convertMemoryBuffer(
+         pixeltype const *externalBuffer,
+         int height,
+         int width,
+         int numbands,
+         int xstride,
+         int ystride,
+         int bandstride,
+         pixeltype zeroval,
+         pixeltype oneval);
+
    // Member variables
   protected:
-   bool hasNewImageFlag; // set to true by setMemoryBuffer; cleared to false by
-   // initializeActivity();
+   bool hasNewImageFlag; // set to true by setMemoryBuffer; cleared to false by updateState() and
+   // initializeActivity()
+
+   // The images of the individual batch elements, indexed by global batch index; held by the
+   // root process. A null entry shows the image set for all batch elements, mImage.
+   std::vector<std::unique_ptr<Image>> mBatchImages;
 }; // class ImageFromMemoryBuffer
 
 } // namespace PV
@@ -11,6 +11,63 @@ namespace PV {
 
 ImageLayer::ImageLayer(const char *name, HyPerCol *hc) { initialize(name, hc); }
 
+int ImageLayer::ioParamsFillGroup(enum ParamsIOFlag ioFlag) {
+   int status = InputLayer::ioParamsFillGroup(ioFlag);
+   ioParam_imageCacheSize(ioFlag);
+   ioParam_imageCacheDataType(ioFlag);
+   ioParam_imageCacheSpillPath(ioFlag);
+   return status;
+}
+
+void ImageLayer::ioParam_imageCacheSize(enum ParamsIOFlag ioFlag) {
+   parent->parameters()->ioParamValue(
+         ioFlag, name, "imageCacheSize", &mImageCacheSize, mImageCacheSize, false /*warnIfAbsent*/);
+}
+
+void ImageLayer::ioParam_imageCacheDataType(enum ParamsIOFlag ioFlag) {
+   pvAssert(!parent->parameters()->presentAndNotBeenRead(name, "imageCacheSize"));
+   if (mImageCacheSize <= 0.0) {
+      return;
+   }
+   char *dataTypeString = nullptr;
+   if (ioFlag == PARAMS_IO_WRITE) {
+      dataTypeString = strdup(mImageCacheType == ImageCache::BYTE ? "uint8" : "float");
+   }
+   parent->parameters()->ioParamString(
+         ioFlag, name, "imageCacheDataType", &dataTypeString, "float", true /*warnIfAbsent*/);
+   if (ioFlag == PARAMS_IO_READ) {
+      if (!strcmp(dataTypeString, "float")) {
+         mImageCacheType = ImageCache::FLOAT;
+      }
+      else if (!strcmp(dataTypeString, "uint8")) {
+         mImageCacheType = ImageCache::BYTE;
+      }
+      else {
+         Fatal().printf(
+               "%s: imageCacheDataType must be either \"float\" or \"uint8\".\n",
+               getDescription_c());
+      }
+   }
+   free(dataTypeString);
+}
+
+void ImageLayer::ioParam_imageCacheSpillPath(enum ParamsIOFlag ioFlag) {
+   pvAssert(!parent->parameters()->presentAndNotBeenRead(name, "imageCacheSize"));
+   if (mImageCacheSize <= 0.0) {
+      return;
+   }
+   char *spillPath = nullptr;
+   if (ioFlag == PARAMS_IO_WRITE) {
+      spillPath = strdup(mImageCacheSpillPath.c_str());
+   }
+   parent->parameters()->ioParamString(
+         ioFlag, name, "imageCacheSpillPath", &spillPath, "", false /*warnIfAbsent*/);
+   if (ioFlag == PARAMS_IO_READ) {
+      mImageCacheSpillPath = spillPath ? std::string(spillPath) : std::string("");
+   }
+   free(spillPath);
+}
+
 int ImageLayer::countInputImages() {
    // Check if the input path ends in ".txt" and enable the file list if so
    std::string txt = ".txt";
@@ -46,6 +103,30 @@ Response::Status ImageLayer::registerData(Checkpointer *checkpointer) {
       return status;
    }
    mURLDownloadTemplate = checkpointer->getOutputPath() + "/temp.XXXXXX";
+   if (mImageCacheSize > 0.0 and getMPIBlock()->getRank() == 0) {
+      std::size_t const capacity = (std::size_t)(mImageCacheSize * 1024.0 * 1024.0);
+      mImageCache = std::unique_ptr<ImageCache>(new ImageCache(capacity, mImageCacheType));
+      if (!mImageCacheSpillPath.empty()) {
+         if (mAutoResizeFlag) {
+            // Each MPIBlock reads its own inputs, so each needs its own spill file.
+            std::string spillPath = mImageCacheSpillPath;
+            if (getMPIBlock()->getGlobalRank() != 0) {
+               spillPath += "_" + std::to_string(getMPIBlock()->getGlobalRank());
+            }
+            mImageCache->openSpillFile(
+                  spillPath,
+                  getTargetWidth(),
+                  getTargetHeight(),
+                  getLayerLoc()->nf);
+         }
+         else {
+            WarnLog().printf(
+                  "%s: imageCacheSpillPath requires autoResizeFlag to be set. "
+                  "Images will be cached in memory only.\n",
+                  getDescription_c());
+         }
+      }
+   }
    return Response::SUCCESS;
 }
 
@@ -83,33 +164,60 @@ Buffer<float> ImageLayer::retrieveData(int inputIndex) {
       filename = getInputPath();
    }
    readImage(filename);
+   return imageToBuffer(*mImage, filename);
+}
 
-   if (mImage->getFeatures() != getLayerLoc()->nf) {
+Buffer<float> ImageLayer::imageToBuffer(Image &image, std::string const &source) {
+   if (image.getFeatures() != getLayerLoc()->nf) {
       switch (getLayerLoc()->nf) {
          case 1: // Grayscale
-            mImage->convertToGray(false);
+            image.convertToGray(false);
             break;
          case 2: // Grayscale + Alpha
-            mImage->convertToGray(true);
+            image.convertToGray(true);
             break;
          case 3: // RGB
-            mImage->convertToColor(false);
+            image.convertToColor(false);
             break;
          case 4: // RGBA
-            mImage->convertToColor(true);
+            image.convertToColor(true);
             break;
          default:
-            Fatal() << "Failed to read " << filename << ": Could not convert "
-                    << mImage->getFeatures() << " channels to " << getLayerLoc()->nf << std::endl;
+            Fatal() << "Failed to read " << source << ": Could not convert "
+                    << image.getFeatures() << " channels to " << getLayerLoc()->nf << std::endl;
             break;
       }
    }
 
-   Buffer<float> result(
-         mImage->asVector(), mImage->getWidth(), mImage->getHeight(), getLayerLoc()->nf);
+   Buffer<float> result(image.asVector(), image.getWidth(), image.getHeight(), getLayerLoc()->nf);
    return result;
 }
 
+Buffer<float> ImageLayer::retrieveResizedData(int inputIndex, int *width, int *height) {
+   if (mImageCache == nullptr) {
+      return InputLayer::retrieveResizedData(inputIndex, width, height);
+   }
+   std::string const key = imageCacheKey(inputIndex);
+   Buffer<float> result;
+   if (!mImageCache->find(key, &result, width, height)) {
+      result = InputLayer::retrieveResizedData(inputIndex, width, height);
+      mImageCache->insert(key, result, *width, *height);
+   }
+   return result;
+}
+
+std::string ImageLayer::imageCacheKey(int inputIndex) {
+   std::string key = mUsingFileList ? mFileList.at(inputIndex) : getInputPath();
+   key += "|nf=" + std::to_string(getLayerLoc()->nf);
+   if (mAutoResizeFlag) {
+      key += "|" + std::to_string(getTargetWidth()) + "x" + std::to_string(getTargetHeight());
+      key += mRescaleMethod == BufferUtils::CROP ? "|crop" : "|pad";
+      key += mInterpolationMethod == BufferUtils::BICUBIC ? "|bicubic" : "|nearest";
+      key += "|anchor=" + std::to_string((int)mAnchor);
+   }
+   return key;
+}
+
 void ImageLayer::readImage(std::string filename) {
    const PVLayerLoc *loc = getLayerLoc();
    bool usingTempFile    = false;
@@ -3,17 +3,53 @@
 
 #include "InputLayer.hpp"
 #include "structures/Image.hpp"
+#include "structures/ImageCache.hpp"
 
 namespace PV {
 
 class ImageLayer : public InputLayer {
 
+  protected:
+   // imageCacheSize: The memory, in megabytes, for a cache of decoded and resized images, so that
+   // an image shown more than once is only read from disk and decoded once. The least recently
+   // used images are dropped when the cache is full. The default, zero, disables the cache.
+   virtual void ioParam_imageCacheSize(enum ParamsIOFlag ioFlag);
+
+   // imageCacheDataType: Either "float" (the default) or "uint8". A uint8 cache holds four times
+   // as many images, rounded to multiples of 1/255. Read only if imageCacheSize is positive.
+   virtual void ioParam_imageCacheDataType(enum ParamsIOFlag ioFlag);
+
+   // imageCacheSpillPath: If set, a .pvp file that also holds every cached image, so that images
+   // dropped from memory, and images cached by an earlier run with the same layer geometry, are
+   // read from it instead of being decoded. Requires autoResizeFlag, so that all the images have
+   // the same size. Read only if imageCacheSize is positive.
+   virtual void ioParam_imageCacheSpillPath(enum ParamsIOFlag ioFlag);
+
   protected:
    ImageLayer() {}
+   virtual int ioParamsFillGroup(enum ParamsIOFlag ioFlag) override;
    virtual int countInputImages() override;
    virtual Response::Status registerData(Checkpointer *checkpointer) override;
    void populateFileList();
    virtual Buffer<float> retrieveData(int inputIndex) override;
+
+   /**
+    * Converts the image to the number of features of the layer, if necessary, and returns it as a
+    * buffer. The source names the image in the error message if the conversion is not possible.
+    */
+   Buffer<float> imageToBuffer(Image &image, std::string const &source);
+
+   /**
+    * If the image cache is enabled, returns the image from the cache, or loads and rescales it
+    * and adds it to the cache. Otherwise, calls InputLayer::retrieveResizedData().
+    */
+   virtual Buffer<float> retrieveResizedData(int inputIndex, int *width, int *height) override;
+
+   /**
+    * The image cache key for the given input index: the file name, the layer geometry and the
+    * rescaling options, and the number of features.
+    */
+   std::string imageCacheKey(int inputIndex);
    virtual std::string describeInput(int index) override;
    void readImage(std::string filename);
 
@@ -23,6 +59,9 @@ class ImageLayer : public InputLayer {
    virtual std::string const &
    getCurrentFilename(int localBatchElement, int mpiBatchIndex) const override;
 
+   /** Returns the image cache, or null if the cache is disabled or this is not a root process. */
+   ImageCache const *getImageCache() const { return mImageCache.get(); }
+
   protected:
    std::unique_ptr<Image> mImage = nullptr;
 
@@ -35,6 +74,11 @@ class ImageLayer : public InputLayer {
 
    // Template for a temporary path for downloading URLs that appear in file list.
    std::string mURLDownloadTemplate;
+
+   double mImageCacheSize               = 0.0;
+   ImageCache::DataType mImageCacheType = ImageCache::FLOAT;
+   std::string mImageCacheSpillPath;
+   std::unique_ptr<ImageCache> mImageCache = nullptr;
 }; // end class ImageLayer
 } // end namespace PV
 
@@ -119,17 +119,11 @@ void InputLayer::retrieveInput(double timef, double dt) {
          if (getMPIBlock()->getRank() == 0) {
             int blockBatchElement = b + localNBatch * m;
             int inputIndex        = mBatchIndexer->getIndex(blockBatchElement);
-            mInputData.at(b)      = retrieveData(inputIndex);
-            int width             = mInputData.at(b).getWidth();
-            int height            = mInputData.at(b).getHeight();
-            int features          = mInputData.at(b).getFeatures();
-            mInputRegion.at(b)    = Buffer<float>(width, height, features);
-            int const N           = mInputRegion.at(b).getTotalElements();
-            for (int k = 0; k < N; k++) {
-               mInputRegion.at(b).set(k, 1.0f);
-            }
+            int width, height;
+            mInputData.at(b) = retrieveResizedData(inputIndex, &width, &height);
+            int features     = mInputData.at(b).getFeatures();
+            fitRegionToGlobalLayer(mInputRegion.at(b), width, height, features, blockBatchElement);
             fitBufferToGlobalLayer(mInputData.at(b), blockBatchElement);
-            fitBufferToGlobalLayer(mInputRegion.at(b), blockBatchElement);
             // Now dataBuffer has input over the global layer. Apply normalizeLuminanceFlag, etc.
             normalizePixels(b);
             // Finally, crop to the part of the image covered by the MPIBlock.
@@ -241,13 +235,39 @@ int InputLayer::scatterInput(int localBatchIndex, int mpiBatchIndex) {
    return PV_SUCCESS;
 }
 
+Buffer<float> InputLayer::retrieveResizedData(int inputIndex, int *width, int *height) {
+   Buffer<float> buffer = retrieveData(inputIndex);
+   *width               = buffer.getWidth();
+   *height              = buffer.getHeight();
+   if (mAutoResizeFlag) {
+      BufferUtils::rescale(
+            buffer,
+            getTargetWidth(),
+            getTargetHeight(),
+            mRescaleMethod,
+            mInterpolationMethod,
+            mAnchor);
+   }
+   return buffer;
+}
+
+int InputLayer::getTargetWidth() const {
+   PVLayerLoc const *loc = getLayerLoc();
+   int const xMargins    = mUseInputBCflag ? loc->halo.lt + loc->halo.rt : 0;
+   return loc->nxGlobal + xMargins;
+}
+
+int InputLayer::getTargetHeight() const {
+   PVLayerLoc const *loc = getLayerLoc();
+   int const yMargins    = mUseInputBCflag ? loc->halo.dn + loc->halo.up : 0;
+   return loc->nyGlobal + yMargins;
+}
+
 void InputLayer::fitBufferToGlobalLayer(Buffer<float> &buffer, int blockBatchElement) {
    pvAssert(getMPIBlock()->getRank() == 0);
    const PVLayerLoc *loc  = getLayerLoc();
-   int const xMargins     = mUseInputBCflag ? loc->halo.lt + loc->halo.rt : 0;
-   int const yMargins     = mUseInputBCflag ? loc->halo.dn + loc->halo.up : 0;
-   const int targetWidth  = loc->nxGlobal + xMargins;
-   const int targetHeight = loc->nyGlobal + yMargins;
+   const int targetWidth  = getTargetWidth();
+   const int targetHeight = getTargetHeight();
 
    FatalIf(
          buffer.getFeatures() != loc->nf,
@@ -257,8 +277,7 @@ void InputLayer::fitBufferToGlobalLayer(Buffer<float> &buffer, int blockBatchEle
          loc->nf);
 
    if (mAutoResizeFlag) {
-      BufferUtils::rescale(
-            buffer, targetWidth, targetHeight, mRescaleMethod, mInterpolationMethod, mAnchor);
+      // retrieveResizedData() has already rescaled the buffer to the global layer.
       buffer.translate(
             -mOffsetX + mRandomShiftX[blockBatchElement],
             -mOffsetY + mRandomShiftY[blockBatchElement]);
@@ -276,6 +295,38 @@ void InputLayer::fitBufferToGlobalLayer(Buffer<float> &buffer, int blockBatchEle
    }
 }
 
+void InputLayer::fitRegionToGlobalLayer(
+      Buffer<float> &region,
+      int width,
+      int height,
+      int features,
+      int blockBatchElement) {
+   pvAssert(getMPIBlock()->getRank() == 0);
+   const int targetWidth  = getTargetWidth();
+   const int targetHeight = getTargetHeight();
+
+   if (mAutoResizeFlag) {
+      region = BufferUtils::rescaledRegion(
+            width, height, features, targetWidth, targetHeight, mRescaleMethod, mAnchor);
+      region.translate(
+            -mOffsetX + mRandomShiftX[blockBatchElement],
+            -mOffsetY + mRandomShiftY[blockBatchElement]);
+   }
+   else {
+      std::vector<float> ones(width * height * features, 1.0f);
+      region.set(ones, width, height, features);
+      region.grow(targetWidth, targetHeight, mAnchor);
+      region.translate(
+            -mOffsetX + mRandomShiftX[blockBatchElement],
+            -mOffsetY + mRandomShiftY[blockBatchElement]);
+      region.crop(targetWidth, targetHeight, mAnchor);
+   }
+
+   if (mMirrorFlipX[blockBatchElement] || mMirrorFlipY[blockBatchElement]) {
+      region.flip(mMirrorFlipX[blockBatchElement], mMirrorFlipY[blockBatchElement]);
+   }
+}
+
 void InputLayer::normalizePixels(int batchElement) {
    Buffer<float> &dataBuffer         = mInputData.at(batchElement);
    Buffer<float> const &regionBuffer = mInputRegion.at(batchElement);
@@ -167,6 +167,22 @@ class InputLayer : public HyPerLayer {
     */
    virtual Buffer<float> retrieveData(int inputIndex) = 0;
 
+   /**
+    * Called by the root process for each batch element to load its input. Returns the input
+    * with the given index, rescaled to the global layer if autoResizeFlag is set, and sets
+    * *width and *height to the size of the input before rescaling. The default calls
+    * retrieveData() and BufferUtils::rescale(); subclasses can override it to reuse inputs that
+    * have already been loaded and rescaled.
+    */
+   virtual Buffer<float> retrieveResizedData(int inputIndex, int *width, int *height);
+
+   /**
+    * The size of the global layer that the input is fit to: nxGlobal and nyGlobal, plus the
+    * margins if useInputBCflag is set.
+    */
+   int getTargetWidth() const;
+   int getTargetHeight() const;
+
    /**
     * Each batch element loads its data with the input specified by the current
     * index for that batch element. The indices are not modified.
@@ -221,12 +237,26 @@ class InputLayer : public HyPerLayer {
 
   private:
    /**
-    * Resizes a buffer from the image size to the global layer size. If autoResizeFlag is true,
-    * it calls BufferUtils::rescale. If autoResizeFlag is false, it calls Buffer methods grow,
-    * translate, and crop. This method is called only by the root process.
+    * Fits a buffer returned by retrieveResizedData() to the global layer size. If autoResizeFlag
+    * is true, the buffer has already been rescaled, and it calls Buffer method translate. If
+    * autoResizeFlag is false, it calls Buffer methods grow, translate, and crop. This method is
+    * called only by the root process.
     */
    void fitBufferToGlobalLayer(Buffer<float> &buffer, int blockBatchElement);
 
+   /**
+    * Sets the region buffer to the input region of a width-by-height image after
+    * fitBufferToGlobalLayer: one where the image covers the global layer, and zero elsewhere.
+    * The region is built directly at the global layer size instead of being fit like the image.
+    * This method is called only by the root process.
+    */
+   void fitRegionToGlobalLayer(
+         Buffer<float> &region,
+         int width,
+         int height,
+         int features,
+         int blockBatchElement);
+
    void cropToMPIBlock(Buffer<float> &buffer);
 
   protected:
@@ -281,6 +311,9 @@ class InputLayer : public HyPerLayer {
    std::unique_ptr<BatchIndexer> mBatchIndexer;
    BatchIndexer::BatchMethod mBatchMethod;
 
+   // An array of starting file list indices, one per batch
+   std::vector<int> mStartFrameIndex;
+
   private:
    // Data read from disk, one per batch element.
    std::vector<Buffer<float>> mInputData;
@@ -324,9 +357,6 @@ class InputLayer : public HyPerLayer {
    // Flag to write filenames and batch indices to disk as they are loaded
    bool mWriteFrameToTimestamp = true;
 
-   // An array of starting file list indices, one per batch
-   std::vector<int> mStartFrameIndex;
-
    // An array indicating how far to advance each index, one per batch
    std::vector<int> mSkipFrameIndex;
 
@@ -13,6 +13,7 @@
 #include "include/pv_common.h"
 #include "io/fileio.hpp"
 #include "io/randomstateio.hpp"
+#include "utils/MemoryTracker.hpp"
 
 #include <cassert>
 #include <cfloat>
@@ -22,81 +23,6 @@
 #include <cstring>
 #include <memory>
 
-void LIF_update_state_arma(
-      const int nbatch,
-      const int numNeurons,
-      const float time,
-      const float dt,
-
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-
-      LIF_params *params,
-      taus_uint4 *rnd,
-
-      float *V,
-      float *Vth,
-      float *G_E,
-      float *G_I,
-      float *G_IB,
-      float *GSynHead,
-      float *activity);
-
-void LIF_update_state_beginning(
-      const int nbatch,
-      const int numNeurons,
-      const float time,
-      const float dt,
-
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-
-      LIF_params *params,
-      taus_uint4 *rnd,
-
-      float *V,
-      float *Vth,
-      float *G_E,
-      float *G_I,
-      float *G_IB,
-      float *GSynHead,
-      float *activity);
-
-void LIF_update_state_original(
-      const int nbatch,
-      const int numNeurons,
-      const float time,
-      const float dt,
-
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-
-      LIF_params *params,
-      taus_uint4 *rnd,
-
-      float *V,
-      float *Vth,
-      float *G_E,
-      float *G_I,
-      float *G_IB,
-      float *GSynHead,
-      float *activity);
-
 namespace PV {
 
 LIF::LIF() { initialize_base(); }
@@ -113,6 +39,10 @@ LIF::~LIF() {
    }
    free(Vth);
    delete randState;
+   if (publisher) {
+      publisher->wait(); // The publisher may still hold the update's lists of spikes.
+   }
+   delete mLIFUpdate;
    free(methodString);
 }
 
@@ -305,11 +235,17 @@ Response::Status LIF::allocateDataStructures() {
    }
 
    // // a random state variable is needed for every neuron/clthread
-   randState = new Random(getLayerLoc(), false /*isExtended*/);
+   randState = new Random(
+         getLayerLoc(), false /*isExtended*/, RandomSeed::instance()->getGenerator());
    if (randState == nullptr) {
       Fatal().printf(
             "LIF::initialize:  %s unable to create object of Random class.\n", getDescription_c());
    }
+   mLIFUpdate = new LIFUpdate(getLayerLoc(), &lParams, getSparseFlag());
+   if (mLIFUpdate->getMemorySize() > 0) {
+      MemoryTracker::instance()->allocate(
+            name, "noise and active index lists", mLIFUpdate->getMemorySize());
+   }
 
    int numNeurons = getNumNeuronsAllBatches();
    assert(Vth); // Allocated when HyPerLayer::allocateDataStructures() called allocateBuffers().
@@ -384,6 +320,9 @@ void LIF::readG_IBFromCheckpoint(Checkpointer *checkpointer) {
 }
 
 void LIF::readRandStateFromCheckpoint(Checkpointer *checkpointer) {
+   if (randState->isCounterBased()) {
+      return; // A counter-based generator has no state to restore.
+   }
    checkpointer->readNamedCheckpointEntry(std::string(name), "rand_state", false /*not constant*/);
 }
 
@@ -402,90 +341,42 @@ Response::Status LIF::registerData(Checkpointer *checkpointer) {
 
 Response::Status LIF::updateState(double time, double dt) {
    update_timer->start();
+   generateNoise(time, dt, 0.001f * (float)dt);
+   mLIFUpdate->update(updateMethod(), &lParams, (float)dt, updateBuffers());
+   publishRestrictedActiveIndices();
+   update_timer->stop();
+   return Response::SUCCESS;
+}
 
-   const int nx       = clayer->loc.nx;
-   const int ny       = clayer->loc.ny;
-   const int nf       = clayer->loc.nf;
-   const PVHalo *halo = &clayer->loc.halo;
-   const int nbatch   = clayer->loc.nbatch;
-
-   float *GSynHead = GSyn[0];
-   float *activity = clayer->activity->data;
+LIFUpdate::Buffers LIF::updateBuffers() {
+   LIFUpdate::Buffers buffers;
+   buffers.V        = clayer->V;
+   buffers.Vth      = Vth;
+   buffers.G_E      = G_E;
+   buffers.G_I      = G_I;
+   buffers.G_IB     = G_IB;
+   buffers.GSynHead = GSyn[0];
+   buffers.activity = clayer->activity->data;
+   return buffers;
+}
 
+LIFUpdate::Method LIF::updateMethod() const {
    switch (method) {
-      case 'a':
-         LIF_update_state_arma(
-               nbatch,
-               getNumNeurons(),
-               time,
-               dt,
-               nx,
-               ny,
-               nf,
-               halo->lt,
-               halo->rt,
-               halo->dn,
-               halo->up,
-               &lParams,
-               randState->getRNG(0),
-               clayer->V,
-               Vth,
-               G_E,
-               G_I,
-               G_IB,
-               GSynHead,
-               activity);
-         break;
-      case 'b':
-         LIF_update_state_beginning(
-               nbatch,
-               getNumNeurons(),
-               time,
-               dt,
-               nx,
-               ny,
-               nf,
-               halo->lt,
-               halo->rt,
-               halo->dn,
-               halo->up,
-               &lParams,
-               randState->getRNG(0),
-               clayer->V,
-               Vth,
-               G_E,
-               G_I,
-               G_IB,
-               GSynHead,
-               activity);
-         break;
-      case 'o':
-         LIF_update_state_original(
-               nbatch,
-               getNumNeurons(),
-               time,
-               dt,
-               nx,
-               ny,
-               nf,
-               halo->lt,
-               halo->rt,
-               halo->dn,
-               halo->up,
-               &lParams,
-               randState->getRNG(0),
-               clayer->V,
-               Vth,
-               G_E,
-               G_I,
-               G_IB,
-               GSynHead,
-               activity);
-         break;
-      default: assert(0); break;
+      case 'a': return LIFUpdate::ARMA;
+      case 'b': return LIFUpdate::BEGINNING;
+      case 'o': return LIFUpdate::ORIGINAL;
+      default: assert(0); return LIFUpdate::ARMA;
    }
-   update_timer->stop();
-   return Response::SUCCESS;
+}
+
+void LIF::generateNoise(double time, double dt, float dtSeconds) {
+   long const step = (long)std::nearbyint(time / dt);
+   mLIFUpdate->generateNoise(&lParams, dtSeconds, randState, step);
+}
+
+void LIF::publishRestrictedActiveIndices() {
+   HyPerLayer::publishRestrictedActiveIndices(
+         mLIFUpdate->getRowEntries(), mLIFUpdate->getRowCounts());
 }
 
 float LIF::getChannelTimeConst(enum ChannelType channel_type) {
@@ -517,540 +408,3 @@ int LIF::findPostSynaptic(
 }
 
 } // namespace PV
-
-///////////////////////////////////////////////////////
-//
-// implementation of LIF kernels
-//
-
-inline float LIF_Vmem_derivative(
-      const float Vmem,
-      const float G_E,
-      const float G_I,
-      const float G_IB,
-      const float V_E,
-      const float V_I,
-      const float V_IB,
-      const float Vrest,
-      const float tau) {
-   float totalconductance = 1.0f + G_E + G_I + G_IB;
-   float Vmeminf          = (Vrest + V_E * G_E + V_I * G_I + V_IB * G_IB) / totalconductance;
-   return totalconductance * (Vmeminf - Vmem) / tau;
-}
-//
-// update the state of a retinal layer (spiking)
-//
-//    assume called with 1D kernel
-//
-// LIF_update_state_original uses an Euler scheme for V where the conductances over the entire
-// timestep are taken to be the values calculated at the end of the timestep
-// LIF_update_state_beginning uses a Heun scheme for V, using values of the conductances at both the
-// beginning and end of the timestep.  Spikes in the input are applied at the beginning of the
-// timestep.
-// LIF_update_state_arma uses an auto-regressive moving average filter for V, applying the GSyn at
-// the start of the timestep and assuming that tau_inf and V_inf vary linearly over the timestep.
-// See van Hateren, Journal of Vision (2005), p. 331.
-//
-void LIF_update_state_original(
-      const int nbatch,
-      const int numNeurons,
-      const float time,
-      const float dt,
-
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-
-      LIF_params *params,
-      taus_uint4 *rnd,
-      float *V,
-      float *Vth,
-      float *G_E,
-      float *G_I,
-      float *G_IB,
-      float *GSynHead,
-      float *activity) {
-   int k;
-
-   const float exp_tauE   = expf(-dt / params->tauE);
-   const float exp_tauI   = expf(-dt / params->tauI);
-   const float exp_tauIB  = expf(-dt / params->tauIB);
-   const float exp_tauVth = expf(-dt / params->tauVth);
-
-   const float dt_sec = 0.001f * dt; // convert to seconds
-
-   for (k = 0; k < nx * ny * nf * nbatch; k++) {
-      int kex = kIndexExtendedBatch(k, nbatch, nx, ny, nf, lt, rt, dn, up);
-
-      //
-      // kernel (nonheader part) begins here
-      //
-
-      // local param variables
-      float tau, Vrest, VthRest, Vexc, Vinh, VinhB, deltaVth, deltaGIB;
-
-      const float GMAX = 10.0f;
-
-      // local variables
-      float l_activ;
-
-      taus_uint4 l_rnd = rnd[k];
-
-      float l_V   = V[k];
-      float l_Vth = Vth[k];
-
-      float l_G_E  = G_E[k];
-      float l_G_I  = G_I[k];
-      float l_G_IB = G_IB[k];
-
-      float *GSynExc   = &GSynHead[CHANNEL_EXC * nbatch * numNeurons];
-      float *GSynInh   = &GSynHead[CHANNEL_INH * nbatch * numNeurons];
-      float *GSynInhB  = &GSynHead[CHANNEL_INHB * nbatch * numNeurons];
-      float l_GSynExc  = GSynExc[k];
-      float l_GSynInh  = GSynInh[k];
-      float l_GSynInhB = GSynInhB[k];
-
-      // temporary arrays
-      float tauInf, VmemInf;
-
-      //
-      // start of LIF2_update_exact_linear
-      //
-
-      // define local param variables
-      //
-      tau   = params->tau;
-      Vexc  = params->Vexc;
-      Vinh  = params->Vinh;
-      VinhB = params->VinhB;
-      Vrest = params->Vrest;
-
-      VthRest  = params->VthRest;
-      deltaVth = params->deltaVth;
-      deltaGIB = params->deltaGIB;
-
-      // add noise
-      //
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqE) {
-         l_rnd     = cl_random_get(l_rnd);
-         l_GSynExc = l_GSynExc + params->noiseAmpE * cl_random_prob(l_rnd);
-      }
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqI) {
-         l_rnd     = cl_random_get(l_rnd);
-         l_GSynInh = l_GSynInh + params->noiseAmpI * cl_random_prob(l_rnd);
-      }
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqIB) {
-         l_rnd      = cl_random_get(l_rnd);
-         l_GSynInhB = l_GSynInhB + params->noiseAmpIB * cl_random_prob(l_rnd);
-      }
-
-      l_G_E  = l_GSynExc + l_G_E * exp_tauE;
-      l_G_I  = l_GSynInh + l_G_I * exp_tauI;
-      l_G_IB = l_GSynInhB + l_G_IB * exp_tauIB;
-
-      l_G_E  = (l_G_E > GMAX) ? GMAX : l_G_E;
-      l_G_I  = (l_G_I > GMAX) ? GMAX : l_G_I;
-      l_G_IB = (l_G_IB > GMAX) ? GMAX : l_G_IB;
-
-      tauInf  = (dt / tau) * (1.0f + l_G_E + l_G_I + l_G_IB);
-      VmemInf = (Vrest + l_G_E * Vexc + l_G_I * Vinh + l_G_IB * VinhB)
-                / (1.0f + l_G_E + l_G_I + l_G_IB);
-
-      l_V = VmemInf + (l_V - VmemInf) * expf(-tauInf);
-
-      //
-      // start of LIF2_update_finish
-      //
-
-      l_Vth = VthRest + (l_Vth - VthRest) * exp_tauVth;
-
-      //
-      // start of update_f
-      //
-
-      bool fired_flag = (l_V > l_Vth);
-
-      l_activ = fired_flag ? 1.0f : 0.0f;
-      l_V     = fired_flag ? Vrest : l_V;
-      l_Vth   = fired_flag ? l_Vth + deltaVth : l_Vth;
-      l_G_IB  = fired_flag ? l_G_IB + deltaGIB : l_G_IB;
-
-      //
-      // These actions must be done outside of kernel
-      //    1. set activity to 0 in boundary (if needed)
-      //    2. update active indices
-      //
-
-      // store local variables back to global memory
-      //
-      rnd[k] = l_rnd;
-
-      activity[kex] = l_activ;
-
-      V[k]   = l_V;
-      Vth[k] = l_Vth;
-
-      G_E[k]  = l_G_E;
-      G_I[k]  = l_G_I;
-      G_IB[k] = l_G_IB;
-
-      GSynExc[k]  = 0.0f;
-      GSynInh[k]  = 0.0f;
-      GSynInhB[k] = 0.0f;
-
-   } // loop over k
-}
-
-void LIF_update_state_beginning(
-      const int nbatch,
-      const int numNeurons,
-      const float time,
-      const float dt,
-
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-
-      LIF_params *params,
-      taus_uint4 *rnd,
-      float *V,
-      float *Vth,
-      float *G_E,
-      float *G_I,
-      float *G_IB,
-      float *GSynHead,
-      //    float * GSynExc,
-      //    float * GSynInh,
-      //    float * GSynInhB,
-      float *activity) {
-   int k;
-
-   const float exp_tauE   = expf(-dt / params->tauE);
-   const float exp_tauI   = expf(-dt / params->tauI);
-   const float exp_tauIB  = expf(-dt / params->tauIB);
-   const float exp_tauVth = expf(-dt / params->tauVth);
-
-   const float dt_sec = 0.001f * dt; // convert to seconds
-
-   for (k = 0; k < nx * ny * nf * nbatch; k++) {
-
-      int kex = kIndexExtendedBatch(k, nbatch, nx, ny, nf, lt, rt, dn, up);
-
-      //
-      // kernel (nonheader part) begins here
-      //
-
-      // local param variables
-      float tau, Vrest, VthRest, Vexc, Vinh, VinhB, deltaVth, deltaGIB;
-
-      const float GMAX = 10.0f;
-
-      // local variables
-      float l_activ;
-
-      taus_uint4 l_rnd = rnd[k];
-
-      float l_V   = V[k];
-      float l_Vth = Vth[k];
-
-      // The correction factors to the conductances are so that if l_GSyn_* is the same every
-      // timestep,
-      // then the asymptotic value of l_G_* will be l_GSyn_*
-      float l_G_E  = G_E[k];
-      float l_G_I  = G_I[k];
-      float l_G_IB = G_IB[k];
-
-      float *GSynExc   = &GSynHead[CHANNEL_EXC * nbatch * numNeurons];
-      float *GSynInh   = &GSynHead[CHANNEL_INH * nbatch * numNeurons];
-      float *GSynInhB  = &GSynHead[CHANNEL_INHB * nbatch * numNeurons];
-      float l_GSynExc  = GSynExc[k];
-      float l_GSynInh  = GSynInh[k];
-      float l_GSynInhB = GSynInhB[k];
-
-      //
-      // start of LIF2_update_exact_linear
-      //
-
-      // define local param variables
-      //
-      tau   = params->tau;
-      Vexc  = params->Vexc;
-      Vinh  = params->Vinh;
-      VinhB = params->VinhB;
-      Vrest = params->Vrest;
-
-      VthRest  = params->VthRest;
-      deltaVth = params->deltaVth;
-      deltaGIB = params->deltaGIB;
-
-      // add noise
-      //
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqE) {
-         l_rnd     = cl_random_get(l_rnd);
-         l_GSynExc = l_GSynExc + params->noiseAmpE * cl_random_prob(l_rnd);
-      }
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqI) {
-         l_rnd     = cl_random_get(l_rnd);
-         l_GSynInh = l_GSynInh + params->noiseAmpI * cl_random_prob(l_rnd);
-      }
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqIB) {
-         l_rnd      = cl_random_get(l_rnd);
-         l_GSynInhB = l_GSynInhB + params->noiseAmpIB * cl_random_prob(l_rnd);
-      }
-
-      // The portion of code below uses the newer method of calculating l_V.
-      float G_E_initial, G_I_initial, G_IB_initial, G_E_final, G_I_final, G_IB_final;
-      float dV1, dV2, dV;
-
-      G_E_initial  = l_G_E + l_GSynExc;
-      G_I_initial  = l_G_I + l_GSynInh;
-      G_IB_initial = l_G_IB + l_GSynInhB;
-
-      G_E_initial  = (G_E_initial > GMAX) ? GMAX : G_E_initial;
-      G_I_initial  = (G_I_initial > GMAX) ? GMAX : G_I_initial;
-      G_IB_initial = (G_IB_initial > GMAX) ? GMAX : G_IB_initial;
-
-      G_E_final  = G_E_initial * exp_tauE;
-      G_I_final  = G_I_initial * exp_tauI;
-      G_IB_final = G_IB_initial * exp_tauIB;
-
-      dV1 = LIF_Vmem_derivative(
-            l_V, G_E_initial, G_I_initial, G_IB_initial, Vexc, Vinh, VinhB, Vrest, tau);
-      dV2 = LIF_Vmem_derivative(
-            l_V + dt * dV1, G_E_final, G_I_final, G_IB_final, Vexc, Vinh, VinhB, Vrest, tau);
-      dV  = (dV1 + dV2) * 0.5f;
-      l_V = l_V + dt * dV;
-
-      l_G_E  = G_E_final;
-      l_G_I  = G_I_final;
-      l_G_IB = G_IB_final;
-
-      l_Vth = VthRest + (l_Vth - VthRest) * exp_tauVth;
-      // End of code unique to newer method.
-
-      //
-      // start of update_f
-      //
-
-      bool fired_flag = (l_V > l_Vth);
-
-      l_activ = fired_flag ? 1.0f : 0.0f;
-      l_V     = fired_flag ? Vrest : l_V;
-      l_Vth   = fired_flag ? l_Vth + deltaVth : l_Vth;
-      l_G_IB  = fired_flag ? l_G_IB + deltaGIB : l_G_IB;
-
-      //
-      // These actions must be done outside of kernel
-      //    1. set activity to 0 in boundary (if needed)
-      //    2. update active indices
-      //
-
-      // store local variables back to global memory
-      //
-      rnd[k] = l_rnd;
-
-      activity[kex] = l_activ;
-
-      V[k]   = l_V;
-      Vth[k] = l_Vth;
-
-      G_E[k]  = l_G_E;
-      G_I[k]  = l_G_I;
-      G_IB[k] = l_G_IB;
-
-   } // loop over k
-}
-
-void LIF_update_state_arma(
-      const int nbatch,
-      const int numNeurons,
-      const float time,
-      const float dt,
-
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-
-      LIF_params *params,
-      taus_uint4 *rnd,
-      float *V,
-      float *Vth,
-      float *G_E,
-      float *G_I,
-      float *G_IB,
-      float *GSynHead,
-      float *activity) {
-   int k;
-
-   const float exp_tauE   = expf(-dt / params->tauE);
-   const float exp_tauI   = expf(-dt / params->tauI);
-   const float exp_tauIB  = expf(-dt / params->tauIB);
-   const float exp_tauVth = expf(-dt / params->tauVth);
-
-   const float dt_sec = 0.001f * dt; // convert to seconds
-
-   for (k = 0; k < nx * ny * nf * nbatch; k++) {
-      int kex = kIndexExtendedBatch(k, nbatch, nx, ny, nf, lt, rt, dn, up);
-
-      //
-      // kernel (nonheader part) begins here
-      //
-
-      // local param variables
-      float tau, Vrest, VthRest, Vexc, Vinh, VinhB, deltaVth, deltaGIB;
-
-      const float GMAX = 10.0;
-
-      // local variables
-      float l_activ;
-
-      taus_uint4 l_rnd = rnd[k];
-
-      float l_V   = V[k];
-      float l_Vth = Vth[k];
-
-      // The correction factors to the conductances are so that if l_GSyn_* is the same every
-      // timestep,
-      // then the asymptotic value of l_G_* will be l_GSyn_*
-      float l_G_E  = G_E[k];
-      float l_G_I  = G_I[k];
-      float l_G_IB = G_IB[k];
-
-      float *GSynExc   = &GSynHead[CHANNEL_EXC * nbatch * numNeurons];
-      float *GSynInh   = &GSynHead[CHANNEL_INH * nbatch * numNeurons];
-      float *GSynInhB  = &GSynHead[CHANNEL_INHB * nbatch * numNeurons];
-      float l_GSynExc  = GSynExc[k];
-      float l_GSynInh  = GSynInh[k];
-      float l_GSynInhB = GSynInhB[k];
-
-      //
-      // start of LIF2_update_exact_linear
-      //
-
-      // define local param variables
-      //
-      tau   = params->tau;
-      Vexc  = params->Vexc;
-      Vinh  = params->Vinh;
-      VinhB = params->VinhB;
-      Vrest = params->Vrest;
-
-      VthRest  = params->VthRest;
-      deltaVth = params->deltaVth;
-      deltaGIB = params->deltaGIB;
-
-      // add noise
-      //
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqE) {
-         l_rnd     = cl_random_get(l_rnd);
-         l_GSynExc = l_GSynExc + params->noiseAmpE * cl_random_prob(l_rnd);
-      }
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqI) {
-         l_rnd     = cl_random_get(l_rnd);
-         l_GSynInh = l_GSynInh + params->noiseAmpI * cl_random_prob(l_rnd);
-      }
-
-      l_rnd = cl_random_get(l_rnd);
-      if (cl_random_prob(l_rnd) < dt_sec * params->noiseFreqIB) {
-         l_rnd      = cl_random_get(l_rnd);
-         l_GSynInhB = l_GSynInhB + params->noiseAmpIB * cl_random_prob(l_rnd);
-      }
-
-      // The portion of code below uses the newer method of calculating l_V.
-      float G_E_initial, G_I_initial, G_IB_initial, G_E_final, G_I_final, G_IB_final;
-      float tau_inf_initial, tau_inf_final, V_inf_initial, V_inf_final;
-
-      G_E_initial     = l_G_E + l_GSynExc;
-      G_I_initial     = l_G_I + l_GSynInh;
-      G_IB_initial    = l_G_IB + l_GSynInhB;
-      tau_inf_initial = tau / (1 + G_E_initial + G_I_initial + G_IB_initial);
-      V_inf_initial   = (Vrest + Vexc * G_E_initial + Vinh * G_I_initial + VinhB * G_IB_initial)
-                      / (1 + G_E_initial + G_I_initial + G_IB_initial);
-
-      G_E_initial  = (G_E_initial > GMAX) ? GMAX : G_E_initial;
-      G_I_initial  = (G_I_initial > GMAX) ? GMAX : G_I_initial;
-      G_IB_initial = (G_IB_initial > GMAX) ? GMAX : G_IB_initial;
-
-      G_E_final  = G_E_initial * exp_tauE;
-      G_I_final  = G_I_initial * exp_tauI;
-      G_IB_final = G_IB_initial * exp_tauIB;
-
-      tau_inf_final = tau / (1 + G_E_final + G_I_final + G_IB_initial);
-      V_inf_final   = (Vrest + Vexc * G_E_final + Vinh * G_I_final + VinhB * G_IB_final)
-                    / (1 + G_E_final + G_I_final + G_IB_final);
-
-      float tau_slope = (tau_inf_final - tau_inf_initial) / dt;
-      float f1        = tau_slope == 0.0f ? expf(-dt / tau_inf_initial)
-                                   : powf(tau_inf_final / tau_inf_initial, -1 / tau_slope);
-      float f2 = tau_slope == -1.0f
-                       ? tau_inf_initial / dt * logf(tau_inf_final / tau_inf_initial + 1.0f)
-                       : (1 - tau_inf_initial / dt * (1 - f1)) / (1 + tau_slope);
-      float f3 = 1.0f - f1 - f2;
-      l_V      = f1 * l_V + f2 * V_inf_initial + f3 * V_inf_final;
-
-      l_G_E  = G_E_final;
-      l_G_I  = G_I_final;
-      l_G_IB = G_IB_final;
-
-      l_Vth = VthRest + (l_Vth - VthRest) * exp_tauVth;
-      // End of code unique to newer method.
-
-      //
-      // start of update_f
-      //
-
-      bool fired_flag = (l_V > l_Vth);
-
-      l_activ = fired_flag ? 1.0f : 0.0f;
-      l_V     = fired_flag ? Vrest : l_V;
-      l_Vth   = fired_flag ? l_Vth + deltaVth : l_Vth;
-      l_G_IB  = fired_flag ? l_G_IB + deltaGIB : l_G_IB;
-
-      //
-      // These actions must be done outside of kernel
-      //    1. set activity to 0 in boundary (if needed)
-      //    2. update active indices
-      //
-
-      // store local variables back to global memory
-      //
-      rnd[k] = l_rnd;
-
-      activity[kex] = l_activ;
-
-      V[k]   = l_V;
-      Vth[k] = l_Vth;
-
-      G_E[k]  = l_G_E;
-      G_I[k]  = l_G_I;
-      G_IB[k] = l_G_IB;
-   }
-}
@@ -11,6 +11,7 @@
 
 #include "../columns/Random.hpp"
 #include "HyPerLayer.hpp"
+#include "LIFUpdate.hpp"
 //#include "../kernels/LIF_params.h"
 
 #define NUM_LIF_EVENTS 4
@@ -84,6 +85,7 @@ class LIF : public PV::HyPerLayer {
 
    char *methodString; // 'arma', 'before', or 'original'
    char method; // 'a', 'b', or 'o', the first character of methodString
+   LIFUpdate *mLIFUpdate = nullptr;
 
   protected:
    LIF();
@@ -117,6 +119,18 @@ class LIF : public PV::HyPerLayer {
    virtual void readG_IBFromCheckpoint(Checkpointer *checkpointer);
    virtual void readRandStateFromCheckpoint(Checkpointer *checkpointer);
 
+   /** The buffers that LIFUpdate integrates. LIFGap adds its gap strengths. */
+   LIFUpdate::Buffers updateBuffers();
+
+   /** The integration method given by the method param. */
+   LIFUpdate::Method updateMethod() const;
+
+   /** Draws the noise of the timestep; dtSeconds is the timestep in seconds. */
+   void generateNoise(double time, double dt, float dtSeconds);
+
+   /** Passes the spikes listed by the update to the publisher, if the layer is sparse. */
+   void publishRestrictedActiveIndices();
+
   private:
    int initialize_base();
    int findPostSynaptic(
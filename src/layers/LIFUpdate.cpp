@@ -0,0 +1,712 @@
+#include "LIFUpdate.hpp"
+#include "LIF.hpp"
+#include "cMakeHeader.h"
+#include "columns/Random.hpp"
+#include "include/pv_types.h"
+#include "utils/PVAssert.hpp"
+#include "utils/PVLog.hpp"
+#include "utils/cl_random.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace PV {
+
+namespace {
+
+// Returns a where the bits of mask are set and b where they are clear. The spike tests and the
+// conductance limits use this instead of the conditional operator, which keeps the compiler from
+// vectorizing the loops.
+inline float blend(std::int32_t mask, float a, float b) {
+   std::int32_t aBits, bBits;
+   std::memcpy(&aBits, &a, sizeof(aBits));
+   std::memcpy(&bBits, &b, sizeof(bBits));
+   std::int32_t const bits = (aBits & mask) | (bBits & ~mask);
+   float result;
+   std::memcpy(&result, &bits, sizeof(result));
+   return result;
+}
+
+inline float limit(float g, float gMax) { return blend(-(std::int32_t)(g > gMax), gMax, g); }
+
+// The parameters of the update, with the decay factors over one timestep.
+struct LIFConstants {
+   float tau;
+   float Vrest;
+   float Vexc;
+   float Vinh;
+   float VinhB;
+   float VthRest;
+   float deltaVth;
+   float deltaGIB;
+   float dt;
+   float decayE;
+   float decayI;
+   float decayIB;
+   float decayVth;
+};
+
+LIFConstants makeConstants(LIF_params const *params, float dt) {
+   LIFConstants c;
+   c.tau      = params->tau;
+   c.Vrest    = params->Vrest;
+   c.Vexc     = params->Vexc;
+   c.Vinh     = params->Vinh;
+   c.VinhB    = params->VinhB;
+   c.VthRest  = params->VthRest;
+   c.deltaVth = params->deltaVth;
+   c.deltaGIB = params->deltaGIB;
+   c.dt       = dt;
+   c.decayE   = expf(-dt / params->tauE);
+   c.decayI   = expf(-dt / params->tauI);
+   c.decayIB  = expf(-dt / params->tauIB);
+   c.decayVth = expf(-dt / params->tauVth);
+   return c;
+}
+
+// One row of the layer. Without gap junctions, GSynGap and gapStrength point to a row of zeros.
+struct LIFRow {
+   int n;
+   float *V;
+   float *Vth;
+   float *G_E;
+   float *G_I;
+   float *G_IB;
+   float const *GSynExc;
+   float const *GSynInh;
+   float const *GSynInhB;
+   float const *GSynGap;
+   float const *gapStrength;
+   float const *noiseE;
+   float const *noiseI;
+   float const *noiseIB;
+   float *activity;
+};
+
+// Per-thread arrays for the values passed from the vectorized passes to the scalar one.
+struct LIFScratch {
+   float *tauInitial;
+   float *tauFinal;
+   float *VInfInitial;
+   float *VInfFinal;
+};
+
+// The rows below use the same expressions as the per-neuron kernels that LIF, LIFGap and
+// LCALIFLayer used before, so that the values are the same.
+
+// The conductances of the arma method. tau_inf at the end of the timestep uses the initial G_I if
+// the bits of initialGIMask are set, and the initial G_IB if those of initialGIBMask are.
+void armaConductancesRow(
+      LIFRow const &row,
+      LIFConstants const &c,
+      float gMax,
+      std::int32_t initialGIMask,
+      std::int32_t initialGIBMask,
+      LIFScratch const &scratch) {
+   int const n              = row.n;
+   float *G_E               = row.G_E;
+   float *G_I               = row.G_I;
+   float *G_IB              = row.G_IB;
+   float const *GSynExc     = row.GSynExc;
+   float const *GSynInh     = row.GSynInh;
+   float const *GSynInhB    = row.GSynInhB;
+   float const *GSynGap     = row.GSynGap;
+   float const *gapStrength = row.gapStrength;
+   float const *noiseE      = row.noiseE;
+   float const *noiseI      = row.noiseI;
+   float const *noiseIB     = row.noiseIB;
+   float *tauInitial        = scratch.tauInitial;
+   float *tauFinal          = scratch.tauFinal;
+   float *VInfInitial       = scratch.VInfInitial;
+   float *VInfFinal         = scratch.VInfFinal;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      float const gap   = GSynGap[k];
+      float const gapS  = gapStrength[k];
+      float gEInitial   = G_E[k] + (GSynExc[k] + noiseE[k]);
+      float gIInitial   = G_I[k] + (GSynInh[k] + noiseI[k]);
+      float gIBInitial  = G_IB[k] + (GSynInhB[k] + noiseIB[k]);
+      float const total = 1.0f + gEInitial + gIInitial + gIBInitial + gapS;
+      tauInitial[k]     = c.tau / total;
+      VInfInitial[k] =
+            (c.Vrest + c.Vexc * gEInitial + c.Vinh * gIInitial + c.VinhB * gIBInitial + gap)
+            / total;
+
+      gEInitial  = limit(gEInitial, gMax);
+      gIInitial  = limit(gIInitial, gMax);
+      gIBInitial = limit(gIBInitial, gMax);
+
+      float const gEFinal  = gEInitial * c.decayE;
+      float const gIFinal  = gIInitial * c.decayI;
+      float const gIBFinal = gIBInitial * c.decayIB;
+      float const gITau    = blend(initialGIMask, gIInitial, gIFinal);
+      float const gIBTau   = blend(initialGIBMask, gIBInitial, gIBFinal);
+      tauFinal[k]          = c.tau / (1.0f + gEFinal + gITau + gIBTau + gapS);
+      VInfFinal[k] = (c.Vrest + c.Vexc * gEFinal + c.Vinh * gIFinal + c.VinhB * gIBFinal + gap)
+                     / (1.0f + gEFinal + gIFinal + gIBFinal + gapS);
+
+      G_E[k]  = gEFinal;
+      G_I[k]  = gIFinal;
+      G_IB[k] = gIBFinal;
+   }
+}
+
+// The arma filter, with tau_inf and V_inf varying linearly over the timestep (van Hateren,
+// Journal of Vision (2005), p. 331). The powers and logarithms are left to the scalar libm calls.
+void armaIntegrateRow(int n, float dt, LIFScratch const &scratch, float *V) {
+   for (int k = 0; k < n; k++) {
+      float const tauInitial = scratch.tauInitial[k];
+      float const tauFinal   = scratch.tauFinal[k];
+      float const tauSlope   = (tauFinal - tauInitial) / dt;
+      float const f1         = tauSlope == 0.0f ? expf(-dt / tauInitial)
+                                        : powf(tauFinal / tauInitial, -1.0f / tauSlope);
+      float const f2 = tauSlope == -1.0f
+                             ? tauInitial / dt * logf(tauFinal / tauInitial + 1.0f)
+                             : (1.0f - tauInitial / dt * (1.0f - f1)) / (1.0f + tauSlope);
+      float const f3 = 1.0f - f1 - f2;
+      V[k]           = f1 * V[k] + f2 * scratch.VInfInitial[k] + f3 * scratch.VInfFinal[k];
+   }
+}
+
+inline float VmemDerivative(
+      float Vmem,
+      float gE,
+      float gI,
+      float gIB,
+      float gap,
+      float gapStrength,
+      LIFConstants const &c) {
+   float const totalConductance = 1.0f + gE + gI + gIB + gapStrength;
+   float const Vmeminf =
+         (c.Vrest + c.Vexc * gE + c.Vinh * gI + c.VinhB * gIB + gap) / totalConductance;
+   return totalConductance * (Vmeminf - Vmem) / c.tau;
+}
+
+// The Heun scheme of the beginning method, which needs no transcendental functions.
+void beginningRow(LIFRow const &row, LIFConstants const &c) {
+   int const n              = row.n;
+   float *V                 = row.V;
+   float *G_E               = row.G_E;
+   float *G_I               = row.G_I;
+   float *G_IB              = row.G_IB;
+   float const *GSynExc     = row.GSynExc;
+   float const *GSynInh     = row.GSynInh;
+   float const *GSynInhB    = row.GSynInhB;
+   float const *GSynGap     = row.GSynGap;
+   float const *gapStrength = row.gapStrength;
+   float const *noiseE      = row.noiseE;
+   float const *noiseI      = row.noiseI;
+   float const *noiseIB     = row.noiseIB;
+   float const GMAX         = 10.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      float const gap        = GSynGap[k];
+      float const gapS       = gapStrength[k];
+      float const gEInitial  = limit(G_E[k] + (GSynExc[k] + noiseE[k]), GMAX);
+      float const gIInitial  = limit(G_I[k] + (GSynInh[k] + noiseI[k]), GMAX);
+      float const gIBInitial = limit(G_IB[k] + (GSynInhB[k] + noiseIB[k]), GMAX);
+      float const gEFinal    = gEInitial * c.decayE;
+      float const gIFinal    = gIInitial * c.decayI;
+      float const gIBFinal   = gIBInitial * c.decayIB;
+
+      float const v   = V[k];
+      float const dV1 = VmemDerivative(v, gEInitial, gIInitial, gIBInitial, gap, gapS, c);
+      float const dV2 = VmemDerivative(v + c.dt * dV1, gEFinal, gIFinal, gIBFinal, gap, gapS, c);
+      V[k]            = v + c.dt * ((dV1 + dV2) * 0.5f);
+
+      G_E[k]  = gEFinal;
+      G_I[k]  = gIFinal;
+      G_IB[k] = gIBFinal;
+   }
+}
+
+// The conductances of the original method, which takes them to be the values at the end of the
+// timestep for the whole timestep.
+void originalConductancesRow(LIFRow const &row, LIFConstants const &c, LIFScratch const &scratch) {
+   int const n              = row.n;
+   float *G_E               = row.G_E;
+   float *G_I               = row.G_I;
+   float *G_IB              = row.G_IB;
+   float const *GSynExc     = row.GSynExc;
+   float const *GSynInh     = row.GSynInh;
+   float const *GSynInhB    = row.GSynInhB;
+   float const *GSynGap     = row.GSynGap;
+   float const *gapStrength = row.gapStrength;
+   float const *noiseE      = row.noiseE;
+   float const *noiseI      = row.noiseI;
+   float const *noiseIB     = row.noiseIB;
+   float *tauInf            = scratch.tauInitial;
+   float *VmemInf           = scratch.VInfInitial;
+   float const GMAX         = 10.0f;
+   float const dtOverTau    = c.dt / c.tau;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      float const gap   = GSynGap[k];
+      float const gapS  = gapStrength[k];
+      float const gE    = limit((GSynExc[k] + noiseE[k]) + G_E[k] * c.decayE, GMAX);
+      float const gI    = limit((GSynInh[k] + noiseI[k]) + G_I[k] * c.decayI, GMAX);
+      float const gIB   = limit((GSynInhB[k] + noiseIB[k]) + G_IB[k] * c.decayIB, GMAX);
+      float const total = 1.0f + gE + gI + gIB + gapS;
+      tauInf[k]         = dtOverTau * total;
+      VmemInf[k]        = (c.Vrest + gE * c.Vexc + gI * c.Vinh + gIB * c.VinhB + gap) / total;
+
+      G_E[k]  = gE;
+      G_I[k]  = gI;
+      G_IB[k] = gIB;
+   }
+}
+
+void originalIntegrateRow(int n, LIFScratch const &scratch, float *V) {
+   for (int k = 0; k < n; k++) {
+      float const VmemInf = scratch.VInfInitial[k];
+      V[k]                = VmemInf + (V[k] - VmemInf) * expf(-scratch.tauInitial[k]);
+   }
+}
+
+// The threshold decay, the spike test and the resets of LIF and LIFGap.
+void fireRow(LIFRow const &row, LIFConstants const &c) {
+   int const n     = row.n;
+   float *V        = row.V;
+   float *Vth      = row.Vth;
+   float *G_IB     = row.G_IB;
+   float *activity = row.activity;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      float const vth          = c.VthRest + (Vth[k] - c.VthRest) * c.decayVth;
+      float const v            = V[k];
+      float const gIB          = G_IB[k];
+      std::int32_t const fired = -(std::int32_t)(v > vth);
+      activity[k]              = blend(fired, 1.0f, 0.0f);
+      V[k]                     = blend(fired, c.Vrest, v);
+      Vth[k]                   = blend(fired, vth + c.deltaVth, vth);
+      G_IB[k]                  = blend(fired, gIB + c.deltaGIB, gIB);
+   }
+}
+
+// The values that LCALIFLayer keeps for checkpointing: the inhibitory input, the noise, and the
+// asymptotic potential with the limited initial conductances.
+void lcalifInputsRow(
+      LIFRow const &row,
+      LIFConstants const &c,
+      float *GSynInhEffective,
+      float *excitatoryNoise,
+      float *inhibitoryNoise,
+      float *inhibNoiseB,
+      float *Vmeminf) {
+   int const n              = row.n;
+   float const *G_E         = row.G_E;
+   float const *G_I         = row.G_I;
+   float const *G_IB        = row.G_IB;
+   float const *GSynExc     = row.GSynExc;
+   float const *GSynInh     = row.GSynInh;
+   float const *GSynInhB    = row.GSynInhB;
+   float const *GSynGap     = row.GSynGap;
+   float const *gapStrength = row.gapStrength;
+   float const *noiseE      = row.noiseE;
+   float const *noiseI      = row.noiseI;
+   float const *noiseIB     = row.noiseIB;
+   float const GMAX         = FLT_MAX;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      GSynInhEffective[k]    = GSynInh[k];
+      excitatoryNoise[k]     = noiseE[k];
+      inhibitoryNoise[k]     = noiseI[k];
+      inhibNoiseB[k]         = noiseIB[k];
+      float const gEInitial  = limit(G_E[k] + (GSynExc[k] + noiseE[k]), GMAX);
+      float const gIInitial  = limit(G_I[k] + (GSynInh[k] + noiseI[k]), GMAX);
+      float const gIBInitial = limit(G_IB[k] + (GSynInhB[k] + noiseIB[k]), GMAX);
+      float const total      = 1.0f + gEInitial + gIInitial + gIBInitial + gapStrength[k];
+      Vmeminf[k] =
+            (c.Vrest + c.Vexc * gEInitial + c.Vinh * gIInitial + c.VinhB * gIBInitial + GSynGap[k])
+            / total;
+   }
+}
+
+// The spike test and resets of LCALIFLayer, whose threshold decays toward the adaptive
+// threshold Vadpt, and which keeps a decaying count of its spikes.
+void lcalifFireRow(
+      LIFRow const &row,
+      LIFConstants const &c,
+      float decayO,
+      float *Vadpt,
+      float *Vattained,
+      float *integratedSpikeCount) {
+   int const n         = row.n;
+   float *V            = row.V;
+   float *Vth          = row.Vth;
+   float *G_IB         = row.G_IB;
+   float *activity     = row.activity;
+   float const VthAdpt = -60.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      Vadpt[k]                 = VthAdpt;
+      float const vth          = VthAdpt + c.decayVth * (Vth[k] - VthAdpt);
+      float const v            = V[k];
+      float const gIB          = G_IB[k];
+      std::int32_t const fired = -(std::int32_t)(v > vth);
+      float const activ        = blend(fired, 1.0f, 0.0f);
+      activity[k]              = activ;
+      Vattained[k]             = v;
+      V[k]                     = blend(fired, c.Vrest, v);
+      Vth[k]                   = blend(fired, vth + c.deltaVth, vth);
+      G_IB[k]                  = blend(fired, gIB + c.deltaGIB, gIB);
+      integratedSpikeCount[k]  = decayO * (activ + integratedSpikeCount[k]);
+   }
+}
+
+} // namespace
+
+LIFUpdate::LIFUpdate(PVLayerLoc const *loc, LIF_params const *params, bool emitActiveIndices) {
+   PVHalo const *halo = &loc->halo;
+   mLoc               = *loc;
+   mNumNeurons        = loc->nx * loc->ny * loc->nf;
+   mNumExtended       = (loc->nx + halo->lt + halo->rt) * (loc->ny + halo->dn + halo->up) * loc->nf;
+   mZeroRow.resize((std::size_t)(loc->nx * loc->nf), 0.0f);
+   bool const hasNoise = (params->noiseAmpE != 0.0f and params->noiseFreqE > 0.0f)
+                         or (params->noiseAmpI != 0.0f and params->noiseFreqI > 0.0f)
+                         or (params->noiseAmpIB != 0.0f and params->noiseFreqIB > 0.0f);
+   if (hasNoise) {
+      mNoise.resize((std::size_t)(3 * loc->nbatch * mNumNeurons));
+   }
+   if (emitActiveIndices) {
+      mRowEntries.resize((std::size_t)(loc->nbatch * mNumNeurons));
+      mRowCounts.resize((std::size_t)(loc->nbatch * loc->ny));
+   }
+}
+
+void LIFUpdate::generateNoise(
+      LIF_params const *params,
+      float dtSeconds,
+      Random *randState,
+      long step) {
+   float const probE  = dtSeconds * params->noiseFreqE;
+   float const probI  = dtSeconds * params->noiseFreqI;
+   float const probIB = dtSeconds * params->noiseFreqIB;
+   float const ampE   = params->noiseAmpE;
+   float const ampI   = params->noiseAmpI;
+   float const ampIB  = params->noiseAmpIB;
+   mNoiseActive       = (ampE != 0.0f and probE > 0.0f) or (ampI != 0.0f and probI > 0.0f)
+                        or (ampIB != 0.0f and probIB > 0.0f);
+   int const numNeuronsAllBatches = mLoc.nbatch * mNumNeurons;
+   if (!mNoiseActive) {
+      if (!randState->isCounterBased()) {
+         // The per-neuron kernels draw each channel's test (and its amplitude if the test
+         // succeeds) even when there is no noise, so the generators still advance as they would.
+         taus_uint4 *rnd = randState->getRNG(0);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(static)
+#endif
+         for (int k = 0; k < numNeuronsAllBatches; k++) {
+            taus_uint4 state = cl_random_get(rnd[k]);
+            if (cl_random_prob(state) < probE) {
+               state = cl_random_get(state);
+            }
+            state = cl_random_get(state);
+            if (cl_random_prob(state) < probI) {
+               state = cl_random_get(state);
+            }
+            state = cl_random_get(state);
+            if (cl_random_prob(state) < probIB) {
+               state = cl_random_get(state);
+            }
+            rnd[k] = state;
+         }
+      }
+      return;
+   }
+   pvAssert(!mNoise.empty());
+
+   float *noiseE  = &mNoise[0];
+   float *noiseI  = &mNoise[numNeuronsAllBatches];
+   float *noiseIB = &mNoise[2 * numNeuronsAllBatches];
+   if (randState->isCounterBased()) {
+      // Positions 2c and 2c+1 of each neuron's sequence are the test and the amplitude of
+      // channel c.
+      int const nbatch     = mLoc.nbatch;
+      int const ny         = mLoc.ny;
+      int const rowSize    = mLoc.nx * mLoc.nf;
+      float const probs[3] = {probE, probI, probIB};
+      float const amps[3]  = {ampE, ampI, ampIB};
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel
+#endif
+      {
+         std::vector<float> amplitude((std::size_t)rowSize);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp for collapse(2) schedule(static)
+#endif
+         for (int b = 0; b < nbatch; b++) {
+            for (int y = 0; y < ny; y++) {
+               int const kRow = b * mNumNeurons + y * rowSize;
+               for (int channel = 0; channel < 3; channel++) {
+                  float *noise    = &mNoise[channel * numNeuronsAllBatches + kRow];
+                  float *u        = amplitude.data();
+                  float const p   = probs[channel];
+                  float const amp = amps[channel];
+                  randState->fillUniform(noise, kRow, rowSize, step, 2U * channel);
+                  randState->fillUniform(u, kRow, rowSize, step, 2U * channel + 1U);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+                  for (int k = 0; k < rowSize; k++) {
+                     noise[k] = blend(-(std::int32_t)(noise[k] < p), amp * u[k], 0.0f);
+                  }
+               }
+            }
+         }
+      }
+   }
+   else {
+      // Each neuron's generator is advanced exactly as in the per-neuron kernels: one number for
+      // each channel's test, and one more for its amplitude if the test succeeds.
+      taus_uint4 *rnd = randState->getRNG(0);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(static)
+#endif
+      for (int k = 0; k < numNeuronsAllBatches; k++) {
+         taus_uint4 state = rnd[k];
+         float e          = 0.0f;
+         float i          = 0.0f;
+         float ib         = 0.0f;
+         state            = cl_random_get(state);
+         if (cl_random_prob(state) < probE) {
+            state = cl_random_get(state);
+            e     = ampE * cl_random_prob(state);
+         }
+         state = cl_random_get(state);
+         if (cl_random_prob(state) < probI) {
+            state = cl_random_get(state);
+            i     = ampI * cl_random_prob(state);
+         }
+         state = cl_random_get(state);
+         if (cl_random_prob(state) < probIB) {
+            state = cl_random_get(state);
+            ib    = ampIB * cl_random_prob(state);
+         }
+         rnd[k]     = state;
+         noiseE[k]  = e;
+         noiseI[k]  = i;
+         noiseIB[k] = ib;
+      }
+   }
+}
+
+void LIFUpdate::update(Method method, LIF_params const *params, float dt, Buffers const &buffers) {
+   int const nbatch      = mLoc.nbatch;
+   int const ny          = mLoc.ny;
+   int const rowSize     = mLoc.nx * mLoc.nf;
+   int const channelSize = nbatch * mNumNeurons;
+   bool const hasGap     = buffers.gapStrength != nullptr;
+   LIFConstants const c  = makeConstants(params, dt);
+   float *GSynGapHead    = hasGap ? &buffers.GSynHead[CHANNEL_GAP * channelSize] : nullptr;
+   // Without gap junctions, LIF's arma method uses the initial G_IB in the final tau_inf.
+   std::int32_t const initialGIBMask = hasGap ? 0 : -1;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel
+#endif
+   {
+      std::vector<float> scratchValues((std::size_t)(4 * rowSize));
+      LIFScratch scratch;
+      scratch.tauInitial  = &scratchValues[0];
+      scratch.tauFinal    = &scratchValues[rowSize];
+      scratch.VInfInitial = &scratchValues[2 * rowSize];
+      scratch.VInfFinal   = &scratchValues[3 * rowSize];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp for collapse(2) schedule(static)
+#endif
+      for (int b = 0; b < nbatch; b++) {
+         for (int y = 0; y < ny; y++) {
+            int const kRow  = b * mNumNeurons + y * rowSize;
+            float *GSynExc  = &buffers.GSynHead[CHANNEL_EXC * channelSize + kRow];
+            float *GSynInh  = &buffers.GSynHead[CHANNEL_INH * channelSize + kRow];
+            float *GSynInhB = &buffers.GSynHead[CHANNEL_INHB * channelSize + kRow];
+            float *GSynGap  = hasGap ? &GSynGapHead[kRow] : nullptr;
+
+            LIFRow row;
+            row.n           = rowSize;
+            row.V           = &buffers.V[kRow];
+            row.Vth         = &buffers.Vth[kRow];
+            row.G_E         = &buffers.G_E[kRow];
+            row.G_I         = &buffers.G_I[kRow];
+            row.G_IB        = &buffers.G_IB[kRow];
+            row.GSynExc     = GSynExc;
+            row.GSynInh     = GSynInh;
+            row.GSynInhB    = GSynInhB;
+            row.GSynGap     = hasGap ? GSynGap : mZeroRow.data();
+            row.gapStrength = hasGap ? &buffers.gapStrength[kRow] : mZeroRow.data();
+            row.noiseE      = noiseRow(0, kRow);
+            row.noiseI      = noiseRow(1, kRow);
+            row.noiseIB     = noiseRow(2, kRow);
+            row.activity    = &buffers.activity[b * mNumExtended + restrictedRowStart(y)];
+
+            switch (method) {
+               case ARMA:
+                  armaConductancesRow(row, c, 10.0f, 0, initialGIBMask, scratch);
+                  armaIntegrateRow(rowSize, dt, scratch, row.V);
+                  break;
+               case BEGINNING: beginningRow(row, c); break;
+               case ORIGINAL:
+                  originalConductancesRow(row, c, scratch);
+                  originalIntegrateRow(rowSize, scratch, row.V);
+                  break;
+            }
+            fireRow(row, c);
+
+            if (method == ORIGINAL) {
+               std::size_t const rowBytes = sizeof(float) * (std::size_t)rowSize;
+               std::memset(GSynExc, 0, rowBytes);
+               std::memset(GSynInh, 0, rowBytes);
+               std::memset(GSynInhB, 0, rowBytes);
+               if (hasGap) {
+                  std::memset(GSynGap, 0, rowBytes);
+               }
+            }
+            emitRow(b, y, row.activity);
+         }
+      }
+   }
+}
+
+void LIFUpdate::updateLCALIF(
+      LIF_params const *params,
+      float dt,
+      double time,
+      Buffers const &buffers,
+      LCALIFBuffers const &lcalifBuffers) {
+   int const nbatch          = mLoc.nbatch;
+   int const ny              = mLoc.ny;
+   int const rowSize         = mLoc.nx * mLoc.nf;
+   int const channelSize     = nbatch * mNumNeurons;
+   LIFConstants const c      = makeConstants(params, dt);
+   float const targetRatekHz = lcalifBuffers.targetRateHz / 1000.0f;
+   float const tauO          = 1.0f / targetRatekHz;
+   float const decayO        = expf(-dt / tauO);
+   pvAssert(buffers.gapStrength != nullptr);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel
+#endif
+   {
+      std::vector<float> scratchValues((std::size_t)(4 * rowSize));
+      LIFScratch scratch;
+      scratch.tauInitial  = &scratchValues[0];
+      scratch.tauFinal    = &scratchValues[rowSize];
+      scratch.VInfInitial = &scratchValues[2 * rowSize];
+      scratch.VInfFinal   = &scratchValues[3 * rowSize];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp for collapse(2) schedule(static)
+#endif
+      for (int b = 0; b < nbatch; b++) {
+         for (int y = 0; y < ny; y++) {
+            int const kRow        = b * mNumNeurons + y * rowSize;
+            float const *GSynExc  = &buffers.GSynHead[CHANNEL_EXC * channelSize + kRow];
+            float const *GSynNorm = &buffers.GSynHead[CHANNEL_NORM * channelSize + kRow];
+            float *excEffective   = &lcalifBuffers.GSynExcEffective[kRow];
+
+            // The normalized excitatory input replaces GSynExc in the rest of the update.
+            if (lcalifBuffers.normalizeInput) {
+               for (int k = 0; k < rowSize; k++) {
+                  float const norm = GSynNorm[k];
+                  float const exc  = GSynExc[k];
+                  FatalIf(
+                        norm == 0.0f and exc != 0.0f,
+                        "time = %f, k = %d, normalizeInputFlag is true but GSynNorm is zero and "
+                        "l_GSynExc = %f\n",
+                        time,
+                        kRow + k,
+                        (double)exc);
+                  excEffective[k] = exc / (norm + (norm == 0.0f ? 1.0f : 0.0f));
+               }
+            }
+            else {
+               std::memcpy(excEffective, GSynExc, sizeof(float) * (std::size_t)rowSize);
+            }
+
+            LIFRow row;
+            row.n           = rowSize;
+            row.V           = &buffers.V[kRow];
+            row.Vth         = &buffers.Vth[kRow];
+            row.G_E         = &buffers.G_E[kRow];
+            row.G_I         = &buffers.G_I[kRow];
+            row.G_IB        = &buffers.G_IB[kRow];
+            row.GSynExc     = excEffective;
+            row.GSynInh     = &buffers.GSynHead[CHANNEL_INH * channelSize + kRow];
+            row.GSynInhB    = &buffers.GSynHead[CHANNEL_INHB * channelSize + kRow];
+            row.GSynGap     = &buffers.GSynHead[CHANNEL_GAP * channelSize + kRow];
+            row.gapStrength = &buffers.gapStrength[kRow];
+            row.noiseE      = noiseRow(0, kRow);
+            row.noiseI      = noiseRow(1, kRow);
+            row.noiseIB     = noiseRow(2, kRow);
+            row.activity    = &buffers.activity[b * mNumExtended + restrictedRowStart(y)];
+
+            lcalifInputsRow(
+                  row,
+                  c,
+                  &lcalifBuffers.GSynInhEffective[kRow],
+                  &lcalifBuffers.excitatoryNoise[kRow],
+                  &lcalifBuffers.inhibitoryNoise[kRow],
+                  &lcalifBuffers.inhibNoiseB[kRow],
+                  &lcalifBuffers.Vmeminf[kRow]);
+            armaConductancesRow(row, c, FLT_MAX, -1, -1, scratch);
+            armaIntegrateRow(rowSize, dt, scratch, row.V);
+            lcalifFireRow(
+                  row,
+                  c,
+                  decayO,
+                  &lcalifBuffers.Vadpt[kRow],
+                  &lcalifBuffers.Vattained[kRow],
+                  &lcalifBuffers.integratedSpikeCount[kRow]);
+            emitRow(b, y, row.activity);
+         }
+      }
+   }
+}
+
+void LIFUpdate::emitRow(int b, int y, float const *rowActivity) {
+   if (mRowEntries.empty()) {
+      return;
+   }
+   // As in FusedLCAUpdate, every position is written and only a spike advances the count.
+   int const rowSize                 = mLoc.nx * mLoc.nf;
+   int const kexRow                  = restrictedRowStart(y);
+   SparseList<float>::Entry *entries = &mRowEntries[(b * mLoc.ny + y) * rowSize];
+   int count                         = 0;
+   for (int k = 0; k < rowSize; k++) {
+      float const a        = rowActivity[k];
+      entries[count].index = (uint32_t)(kexRow + k);
+      entries[count].value = a;
+      count += a != 0.0f ? 1 : 0;
+   }
+   mRowCounts[b * mLoc.ny + y] = count;
+}
+
+int LIFUpdate::restrictedRowStart(int y) const {
+   int const extendedRowSize = (mLoc.nx + mLoc.halo.lt + mLoc.halo.rt) * mLoc.nf;
+   return (y + mLoc.halo.up) * extendedRowSize + mLoc.halo.lt * mLoc.nf;
+}
+
+float const *LIFUpdate::noiseRow(int channel, int kRow) const {
+   if (!mNoiseActive) {
+      return mZeroRow.data();
+   }
+   return &mNoise[channel * mLoc.nbatch * mNumNeurons + kRow];
+}
+
+std::size_t LIFUpdate::getMemorySize() const {
+   return (mNoise.size() + mZeroRow.size()) * sizeof(float)
+          + mRowEntries.size() * sizeof(SparseList<float>::Entry) + mRowCounts.size() * sizeof(int);
+}
+
+} // namespace PV
@@ -0,0 +1,135 @@
+#ifndef LIFUPDATE_HPP_
+#define LIFUPDATE_HPP_
+
+#include "include/PVLayerLoc.h"
+#include "structures/SparseList.hpp"
+#include <vector>
+
+struct LIF_params;
+
+namespace PV {
+
+class Random;
+
+/**
+ * Computes the CPU update of LIF, LIFGap and LCALIFLayer. The state of the layer is kept as one
+ * array per variable (V, Vth, G_E, G_I, G_IB, ...), and the update works through it one row (one
+ * y and batch element) of the restricted region at a time, with the rows divided among the
+ * OpenMP threads. Each row is processed in passes over short arrays: the conductances and the
+ * asymptotic potentials in a vectorized loop, the exponentials of the integration scheme in a
+ * scalar loop, and the spike test and resets in a vectorized loop. The values are the same as
+ * those of the per-neuron kernels the layers used before.
+ *
+ * The noise added to the GSyn channels is drawn for the whole layer before the update, by
+ * generateNoise(). With the Tausworthe generator each neuron's generator is advanced exactly as
+ * before, so the runs are reproducible whatever the number of threads; with the Philox generator
+ * the numbers are drawn a row at a time. If every noise channel has zero amplitude or frequency,
+ * no noise is computed, but the Tausworthe generators still advance as they did before; the
+ * Philox generator draws no numbers.
+ *
+ * If the layer is sparse, the update also lists the spikes of each row as (extended index, value)
+ * pairs, which the Publisher uses to build the active indices (see
+ * Publisher::setRestrictedActiveIndices()).
+ */
+class LIFUpdate {
+  public:
+   enum Method { ARMA, BEGINNING, ORIGINAL };
+
+   /**
+    * The buffers of a LIF layer. All but activity are restricted, with all the batch elements.
+    * GSynHead holds the channels in the order of ChannelType: excitatory, inhibitory, inhibitory
+    * B and, if gapStrength is not null, the gap channel.
+    */
+   struct Buffers {
+      float *V                 = nullptr;
+      float *Vth               = nullptr;
+      float *G_E               = nullptr;
+      float *G_I               = nullptr;
+      float *G_IB              = nullptr;
+      float *GSynHead          = nullptr;
+      float *activity          = nullptr;
+      float const *gapStrength = nullptr;
+   };
+
+   /** The additional buffers of an LCALIFLayer. */
+   struct LCALIFBuffers {
+      float *Vadpt                = nullptr;
+      float *integratedSpikeCount = nullptr;
+      float *Vattained            = nullptr;
+      float *Vmeminf              = nullptr;
+      float *GSynExcEffective     = nullptr;
+      float *GSynInhEffective     = nullptr;
+      float *excitatoryNoise      = nullptr;
+      float *inhibitoryNoise      = nullptr;
+      float *inhibNoiseB          = nullptr;
+      bool normalizeInput         = false;
+      float targetRateHz          = 1.0f;
+   };
+
+   /**
+    * The loc gives the size of the layer and its margins, and the params tell whether the layer
+    * needs noise buffers. If emitActiveIndices is false, the update does not list the spikes, and
+    * getRowEntries() and getRowCounts() return null.
+    */
+   LIFUpdate(PVLayerLoc const *loc, LIF_params const *params, bool emitActiveIndices);
+
+   /**
+    * Draws the noise for the timestep from randState, which must have been created on the
+    * restricted layer. dtSeconds is the timestep in seconds, which scales the noise frequencies.
+    * The step is used only by a counter-based generator.
+    */
+   void generateNoise(LIF_params const *params, float dtSeconds, Random *randState, long step);
+
+   /**
+    * The LIF and LIFGap update with the given integration method. Without gap junctions, the
+    * arma method computes the final time constant with the initial inhibitory B conductance, as
+    * LIF always has.
+    */
+   void update(Method method, LIF_params const *params, float dt, Buffers const &buffers);
+
+   /** The LCALIFLayer update, which uses the arma method with an adaptive threshold. */
+   void updateLCALIF(
+         LIF_params const *params,
+         float dt,
+         double time,
+         Buffers const &buffers,
+         LCALIFBuffers const &lcalifBuffers);
+
+   /**
+    * The spikes of the last update. The entries of row y of batch element b start at index
+    * (b * ny + y) * nx * nf, and there are getRowCounts()[b * ny + y] of them, in increasing
+    * order of extended index.
+    */
+   SparseList<float>::Entry const *getRowEntries() const {
+      return mRowEntries.empty() ? nullptr : mRowEntries.data();
+   }
+
+   int const *getRowCounts() const { return mRowCounts.empty() ? nullptr : mRowCounts.data(); }
+
+   /** Returns the number of bytes held by the noise buffers and the lists of spikes. */
+   std::size_t getMemorySize() const;
+
+  private:
+   /** Lists the spikes of row y of batch element b, if the layer is sparse. */
+   void emitRow(int b, int y, float const *rowActivity);
+
+   /** The extended index, within a batch element, of the start of restricted row y. */
+   int restrictedRowStart(int y) const;
+
+   /** The noise of the given channel for the row that starts at restricted index kRow. */
+   float const *noiseRow(int channel, int kRow) const;
+
+  private:
+   PVLayerLoc mLoc;
+   int mNumNeurons;
+   int mNumExtended;
+   bool mNoiseActive = false;
+   std::vector<float> mNoise; // three channels of nbatch * numNeurons values
+   std::vector<float> mZeroRow;
+   std::vector<SparseList<float>::Entry> mRowEntries;
+   std::vector<int> mRowCounts;
+};
+
+} // namespace PV
+
+#endif // LIFUPDATE_HPP_
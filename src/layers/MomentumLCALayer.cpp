@@ -14,30 +14,6 @@
 
 #endif
 
-void MomentumLCALayer_update_state(
-      const int nbatch,
-      const int numNeurons,
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-      const int numChannels,
-      float *V,
-      int numVertices,
-      float *verticesV,
-      float *verticesA,
-      float *slopes,
-      const bool selfInteract,
-      double *dtAdapt,
-      const float tau,
-      const float LCAMomentumRate,
-      float *GSynHead,
-      float *activity,
-      float *prevDrive);
-
 namespace PV {
 
 MomentumLCALayer::MomentumLCALayer() { initialize_base(); }
@@ -190,41 +166,19 @@ Response::Status MomentumLCALayer::updateStateGpu(double time, double dt) {
 #endif
 
 Response::Status MomentumLCALayer::updateState(double time, double dt) {
-   const PVLayerLoc *loc = getLayerLoc();
-   float *A              = clayer->activity->data;
-   float *V              = getV();
-   int num_channels      = getNumChannels();
-   float *gSynHead       = GSyn == NULL ? NULL : GSyn[0];
-   int nx                = loc->nx;
-   int ny                = loc->ny;
-   int nf                = loc->nf;
-   int num_neurons       = nx * ny * nf;
-   int nbatch            = loc->nbatch;
-   // Only update when the probe updates
-
-   MomentumLCALayer_update_state(
-         nbatch,
-         num_neurons,
-         nx,
-         ny,
-         nf,
-         loc->halo.lt,
-         loc->halo.rt,
-         loc->halo.dn,
-         loc->halo.up,
-         numChannels,
-         V,
-         numVertices,
-         verticesV,
-         verticesA,
-         slopes,
-         selfInteract,
+   float *gSynHead = GSyn == NULL ? NULL : GSyn[0];
+   PtwiseLinearTransfer transfer(numVertices, verticesV, verticesA, slopes);
+   mFusedUpdate->updateMomentumLCA(
+         gSynHead,
+         getV(),
+         clayer->activity->data,
+         prevDrive,
          deltaTimes(),
          timeConstantTau / (float)dt,
          LCAMomentumRate,
-         gSynHead,
-         A,
-         prevDrive);
+         selfInteract,
+         transfer);
+   publishRestrictedActiveIndices();
    return Response::SUCCESS;
 }
 
@@ -274,52 +228,3 @@ Response::Status MomentumLCALayer::prepareCheckpointWrite() {
 }
 
 } // end namespace PV
-
-void MomentumLCALayer_update_state(
-      const int nbatch,
-      const int numNeurons,
-      const int nx,
-      const int ny,
-      const int nf,
-      const int lt,
-      const int rt,
-      const int dn,
-      const int up,
-      const int numChannels,
-
-      float *V,
-      int numVertices,
-      float *verticesV,
-      float *verticesA,
-      float *slopes,
-      const bool selfInteract,
-      double *dtAdapt,
-      const float tau,
-      const float LCAMomentumRate,
-      float *GSynHead,
-      float *activity,
-      float *prevDrive) {
-   updateV_MomentumLCALayer(
-         nbatch,
-         numNeurons,
-         numChannels,
-         V,
-         GSynHead,
-         activity,
-         prevDrive,
-         numVertices,
-         verticesV,
-         verticesA,
-         slopes,
-         dtAdapt,
-         tau,
-         LCAMomentumRate,
-         selfInteract,
-         nx,
-         ny,
-         nf,
-         lt,
-         rt,
-         dn,
-         up);
-}
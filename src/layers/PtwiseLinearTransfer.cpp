@@ -0,0 +1,150 @@
+#include "PtwiseLinearTransfer.hpp"
+#include "cMakeHeader.h"
+#include "utils/PVAssert.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace PV {
+
+namespace {
+
+// Returns a where the bits of mask are set and b where they are clear. The transfer function
+// kernels select values with this instead of the conditional operator: the compiler does not
+// vectorize a conditional floating-point expression unless trapping math is turned off.
+inline float blend(std::int32_t mask, float a, float b) {
+   std::int32_t aBits, bBits;
+   std::memcpy(&aBits, &a, sizeof(aBits));
+   std::memcpy(&bBits, &b, sizeof(bBits));
+   std::int32_t const bits = (aBits & mask) | (bBits & ~mask);
+   float result;
+   std::memcpy(&result, &bits, sizeof(result));
+   return result;
+}
+
+} // namespace
+
+PtwiseLinearTransfer::PtwiseLinearTransfer(
+      int numVertices,
+      float const *verticesV,
+      float const *verticesA,
+      float const *slopes)
+      : mNumVertices(numVertices), mVerticesV(verticesV), mVerticesA(verticesA), mSlopes(slopes) {
+   pvAssert(numVertices > 0);
+   if (numVertices == 1 and slopes[0] == slopes[1]) {
+      mKernel = LINEAR;
+   }
+   else if (numVertices <= maxSelectVertices) {
+      mKernel = SELECT;
+   }
+   else {
+      mKernel = SEARCH;
+   }
+}
+
+void PtwiseLinearTransfer::apply(
+      int nbatch,
+      int nx,
+      int ny,
+      int nf,
+      int lt,
+      int rt,
+      int dn,
+      int up,
+      float const *V,
+      float *A) const {
+   int const rowSize         = nx * nf;
+   int const extendedRowSize = (nx + lt + rt) * nf;
+   int const numNeurons      = rowSize * ny;
+   int const numExtended     = extendedRowSize * (ny + dn + up);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for collapse(2) schedule(static)
+#endif
+   for (int b = 0; b < nbatch; b++) {
+      for (int y = 0; y < ny; y++) {
+         float const *rowV = &V[b * numNeurons + y * rowSize];
+         float *rowA       = &A[b * numExtended + (y + up) * extendedRowSize + lt * nf];
+         applyRow(rowV, rowA, rowSize);
+      }
+   }
+}
+
+void PtwiseLinearTransfer::applyRow(float const *V, float *A, int n) const {
+   switch (mKernel) {
+      case LINEAR: applyLinear(V, A, n); break;
+      case SELECT: applySelect(V, A, n); break;
+      case SEARCH: applySearch(V, A, n); break;
+      default: pvAssert(0); break;
+   }
+}
+
+void PtwiseLinearTransfer::applyLinear(float const *V, float *A, int n) const {
+   float const vertexV = mVerticesV[0];
+   float const vertexA = mVerticesA[0];
+   float const slope   = mSlopes[0];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      float const v           = V[k];
+      std::int32_t const mask = -(std::int32_t)(v == v);
+      A[k]                    = blend(mask, vertexA + slope * (v - vertexV), 0.0f);
+   }
+}
+
+void PtwiseLinearTransfer::applySelect(float const *V, float *A, int n) const {
+   // The first pass sets the values below the first vertex, and zero (for NaN) elsewhere. Each
+   // later pass overwrites the values at or above its vertex, so that each value ends up on the
+   // segment that starts at the last vertex not above it.
+   float const firstV     = mVerticesV[0];
+   float const firstA     = mVerticesA[0];
+   float const firstSlope = mSlopes[0];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < n; k++) {
+      float const v           = V[k];
+      std::int32_t const mask = -(std::int32_t)(v < firstV);
+      A[k]                    = blend(mask, firstA + firstSlope * (v - firstV), 0.0f);
+   }
+   for (int i = 0; i < mNumVertices; i++) {
+      float const vertexV = mVerticesV[i];
+      float const vertexA = mVerticesA[i];
+      float const slope   = mSlopes[i + 1];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+      for (int k = 0; k < n; k++) {
+         float const v           = V[k];
+         std::int32_t const mask = -(std::int32_t)(v >= vertexV);
+         A[k]                    = blend(mask, vertexA + slope * (v - vertexV), A[k]);
+      }
+   }
+}
+
+void PtwiseLinearTransfer::applySearch(float const *V, float *A, int n) const {
+   for (int k = 0; k < n; k++) {
+      float const v = V[k];
+      if (v != v) {
+         A[k] = 0.0f;
+         continue;
+      }
+      // Find the number of vertices at or below v by a binary search whose steps are conditional
+      // moves rather than branches, since the branches would be unpredictable.
+      float const *base = mVerticesV;
+      int length        = mNumVertices;
+      while (length > 1) {
+         int const half = length / 2;
+         base           = base[half] <= v ? base + half : base;
+         length -= half;
+      }
+      int const i = (int)(base - mVerticesV) + (*base <= v ? 1 : 0) - 1;
+      if (i < 0) {
+         A[k] = mVerticesA[0] + mSlopes[0] * (v - mVerticesV[0]);
+      }
+      else {
+         A[k] = mVerticesA[i] + mSlopes[i + 1] * (v - mVerticesV[i]);
+      }
+   }
+}
+
+} // namespace PV
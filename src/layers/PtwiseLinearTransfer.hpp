@@ -0,0 +1,73 @@
+#ifndef PTWISELINEARTRANSFER_HPP_
+#define PTWISELINEARTRANSFER_HPP_
+
+namespace PV {
+
+/**
+ * Applies the piecewise-linear transfer function that ANNLayer describes by its vertices and
+ * slopes: verticesV and verticesA hold the numVertices vertices, slopes[0] is the slope below the
+ * first vertex, slopes[numVertices] the slope above the last, and slopes[k] the slope from vertex
+ * k-1 to vertex k.
+ *
+ * The constructor classifies the function once, and apply() uses the matching kernel:
+ *   LINEAR: one vertex with the same slope on either side, so the function is affine.
+ *   SELECT: at most maxSelectVertices vertices. Each row is computed with one branch-free pass
+ *           per vertex, which the compiler vectorizes. Hard, soft and firm thresholds, with or
+ *           without AMax, and rectified linear functions all take this path.
+ *   SEARCH: more vertices. The segment of each potential is found by binary search.
+ * All three give the same values as the vertex scan that setActivity_PtwiseLinearTransferLayer
+ * used to do: at a jump, the activity is that of the last vertex at that potential, and a NaN
+ * potential gives zero activity.
+ *
+ * The object keeps pointers to the vertex and slope arrays, which must outlive it.
+ */
+class PtwiseLinearTransfer {
+  public:
+   enum Kernel { LINEAR, SELECT, SEARCH };
+
+   static int const maxSelectVertices = 16;
+
+   PtwiseLinearTransfer(
+         int numVertices,
+         float const *verticesV,
+         float const *verticesA,
+         float const *slopes);
+
+   /**
+    * Sets the restricted part of each of the nbatch extended buffers in A, whose margins are lt,
+    * rt, dn and up, by applying the transfer function to the corresponding restricted buffer in V.
+    * The margins of A are left unchanged.
+    */
+   void apply(
+         int nbatch,
+         int nx,
+         int ny,
+         int nf,
+         int lt,
+         int rt,
+         int dn,
+         int up,
+         float const *V,
+         float *A) const;
+
+   /** Applies the transfer function to the n contiguous values of V, writing n values to A. */
+   void applyRow(float const *V, float *A, int n) const;
+
+   Kernel getKernel() const { return mKernel; }
+
+  private:
+   void applyLinear(float const *V, float *A, int n) const;
+   void applySelect(float const *V, float *A, int n) const;
+   void applySearch(float const *V, float *A, int n) const;
+
+  private:
+   int mNumVertices;
+   float const *mVerticesV;
+   float const *mVerticesA;
+   float const *mSlopes;
+   Kernel mKernel;
+};
+
+} // namespace PV
+
+#endif // PTWISELINEARTRANSFER_HPP_
@@ -12,6 +12,7 @@
 #ifndef PV_USE_CUDA
 #include "../include/pv_types.h"
 #include "../utils/conversions.h"
+#include "PtwiseLinearTransfer.hpp"
 #endif // PV_USE_CUDA
 
 #include "../include/pv_common.h"
@@ -1843,16 +1844,13 @@ int setActivity_PtwiseLinearTransferLayer(
       float *verticesV,
       float *verticesA,
       float *slopes) {
-   int kbatch;
-   int last = numVertices - 1;
 #ifndef PV_USE_CUDA
-#ifdef PV_USE_OPENMP_THREADS
-#pragma omp parallel for
-#endif
-   for (kbatch = 0; kbatch < numNeurons * nbatch; kbatch++)
+   // Classifying the transfer function takes a few comparisons, so it is done on each call.
+   PV::PtwiseLinearTransfer transfer(numVertices, verticesV, verticesA, slopes);
+   transfer.apply(nbatch, nx, ny, nf, lt, rt, dn, up, V, A);
 #else
-   kbatch = getIndex();
-#endif // PV_USE_CUDA
+   int kbatch = getIndex();
+   int last   = numVertices - 1;
    {
       int b         = kbatch / numNeurons;
       int k         = kbatch % numNeurons;
@@ -1885,6 +1883,7 @@ int setActivity_PtwiseLinearTransferLayer(
       }
       ABatch[kex] = activity;
    }
+#endif // PV_USE_CUDA
    return PV_SUCCESS;
 }
 
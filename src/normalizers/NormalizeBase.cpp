@@ -11,6 +11,7 @@
 #include "components/WeightsPair.hpp"
 #include "layers/HyPerLayer.hpp"
 #include "utils/MapLookupByType.hpp"
+#include <algorithm>
 
 namespace PV {
 
@@ -153,10 +154,14 @@ int NormalizeBase::accumulateSum(float *dataPatchStart, int weights_in_patch, fl
    // Do not call with sum uninitialized.
    // sum, sumsq, max are not cleared inside this routine so that you can accumulate the stats over
    // several patches with multiple calls
+   float patchSum = 0.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(+ : patchSum)
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
-      float w = dataPatchStart[k];
-      *sum += w;
+      patchSum += dataPatchStart[k];
    }
+   *sum += patchSum;
    return PV_SUCCESS;
 }
 
@@ -174,10 +179,7 @@ int NormalizeBase::accumulateSumShrunken(
    float *dataPatchStartOffset = dataPatchStart + offsetShrunken;
    int weights_in_row          = xPatchStride * nxpShrunken;
    for (int ky = 0; ky < nypShrunken; ky++) {
-      for (int k = 0; k < weights_in_row; k++) {
-         float w = dataPatchStartOffset[k];
-         *sum += w;
-      }
+      accumulateSum(dataPatchStartOffset, weights_in_row, sum);
       dataPatchStartOffset += yPatchStride;
    }
    return PV_SUCCESS;
@@ -187,10 +189,15 @@ int NormalizeBase::accumulateSumSquared(float *dataPatchStart, int weights_in_pa
    // Do not call with sumsq uninitialized.
    // sum, sumsq, max are not cleared inside this routine so that you can accumulate the stats over
    // several patches with multiple calls
+   float patchSumSq = 0.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(+ : patchSumSq)
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
       float w = dataPatchStart[k];
-      *sumsq += w * w;
+      patchSumSq += w * w;
    }
+   *sumsq += patchSumSq;
    return PV_SUCCESS;
 }
 
@@ -208,10 +215,7 @@ int NormalizeBase::accumulateSumSquaredShrunken(
    float *dataPatchStartOffset = dataPatchStart + offsetShrunken;
    int weights_in_row          = xPatchStride * nxpShrunken;
    for (int ky = 0; ky < nypShrunken; ky++) {
-      for (int k = 0; k < weights_in_row; k++) {
-         float w = dataPatchStartOffset[k];
-         *sumsq += w * w;
-      }
+      accumulateSumSquared(dataPatchStartOffset, weights_in_row, sumsq);
       dataPatchStartOffset += yPatchStride;
    }
    return PV_SUCCESS;
@@ -222,10 +226,11 @@ int NormalizeBase::accumulateMaxAbs(float *dataPatchStart, int weights_in_patch,
    // sum, sumsq, max are not cleared inside this routine so that you can accumulate the stats over
    // several patches with multiple calls
    float newmax = *max;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(max : newmax)
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
-      float w = fabsf(dataPatchStart[k]);
-      if (w > newmax)
-         newmax = w;
+      newmax = std::max(newmax, fabsf(dataPatchStart[k]));
    }
    *max = newmax;
    return PV_SUCCESS;
@@ -236,10 +241,11 @@ int NormalizeBase::accumulateMax(float *dataPatchStart, int weights_in_patch, fl
    // sum, sumsq, max are not cleared inside this routine so that you can accumulate the stats over
    // several patches with multiple calls
    float newmax = *max;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(max : newmax)
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
-      float w = dataPatchStart[k];
-      if (w > newmax)
-         newmax = w;
+      newmax = std::max(newmax, dataPatchStart[k]);
    }
    *max = newmax;
    return PV_SUCCESS;
@@ -250,10 +256,11 @@ int NormalizeBase::accumulateMin(float *dataPatchStart, int weights_in_patch, fl
    // min is cleared inside this routine so that you can accumulate the stats over several patches
    // with multiple calls
    float newmin = *min;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(min : newmin)
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
-      float w = dataPatchStart[k];
-      if (w < newmin)
-         newmin = w;
+      newmin = std::min(newmin, dataPatchStart[k]);
    }
    *min = newmin;
    return PV_SUCCESS;
@@ -49,6 +49,28 @@ class NormalizeBase : public BaseObject {
    bool getNormalizeOnInitialize() const { return mNormalizeOnInitialize; }
    bool getNormalizeOnWeightUpdate() const { return mNormalizeOnWeightUpdate; }
 
+   /**
+    * Returns true if the normalizer can be applied one data patch at a time, by a weight updater
+    * that calls normalizePatchFused() on each patch as soon as it has updated it, instead of in a
+    * separate pass over all the weights in response to ConnectionNormalizeMessage.
+    * The base class returns false; normalizers that support fusion override this method.
+    */
+   virtual bool canFuseWithUpdate() const { return false; }
+
+   /**
+    * Normalizes the data patch with the given index, in all arbors. This method may be called for
+    * different patches from several threads at once, and so does not print anything. It returns
+    * false if the patch, or the patch in any arbor, was left unchanged because its norm was within
+    * the tolerance of zero. Only called if canFuseWithUpdate() returns true.
+    */
+   virtual bool normalizePatchFused(int patchIndex) { return true; }
+
+   /**
+    * Called by the weight updater once every patch has been through normalizePatchFused(), so that
+    * the next ConnectionNormalizeMessage does not normalize the same update a second time.
+    */
+   void recordFusedNormalization(double simTime) { mLastTimeNormalized = simTime; }
+
   protected:
    NormalizeBase() {}
 
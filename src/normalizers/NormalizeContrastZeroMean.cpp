@@ -97,21 +97,39 @@ int NormalizeContrastZeroMean::normalizeWeights() {
 
    int nArbors        = weights0->getNumArbors();
    int numDataPatches = weights0->getNumDataPatches();
+   // Patches are normalized in parallel; the patches that had to be skipped are recorded so that
+   // the warnings can be printed afterward, in order.
+   std::vector<char> patchSkipped(numDataPatches);
    if (mNormalizeArborsIndividually) {
       for (int arborID = 0; arborID < nArbors; arborID++) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
          for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
-            float sum           = 0.0f;
-            float sumsq         = 0.0f;
-            int weightsPerPatch = 0;
+            float sum   = 0.0f;
+            float sumsq = 0.0f;
+            int count   = 0;
             for (auto &weights : mWeightsList) {
-               int nxp = weights0->getPatchSizeX();
-               int nyp = weights0->getPatchSizeY();
-               int nfp = weights0->getPatchSizeF();
-               weightsPerPatch += nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateSumAndSumSquared(dataStartPatch, weightsPerPatch, &sum, &sumsq);
+               count += weightsPerPatch;
             }
-            if (fabsf(sum) <= minSumTolerated) {
+            patchSkipped[patchindex] = fabsf(sum) <= minSumTolerated;
+            if (patchSkipped[patchindex]) {
+               continue;
+            }
+            float mean = sum / count;
+            float var  = sumsq / count - mean * mean;
+            for (auto &weights : mWeightsList) {
+               int weightsPerPatch   = weights->getPatchSizeOverall();
+               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
+               subtractOffsetAndNormalize(
+                     dataStartPatch, weightsPerPatch, mean, sqrtf(var) / scale_factor);
+            }
+         }
+         for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+            if (patchSkipped[patchindex]) {
                WarnLog().printf(
                      "for NormalizeContrastZeroMean \"%s\": sum of weights in patch %d of arbor %d "
                      "is within minSumTolerated=%f of zero. Weights in this patch unchanged.\n",
@@ -119,56 +137,51 @@ int NormalizeContrastZeroMean::normalizeWeights() {
                      patchindex,
                      arborID,
                      (double)minSumTolerated);
-               continue;
-            }
-            float mean = sum / weightsPerPatch;
-            float var  = sumsq / weightsPerPatch - mean * mean;
-            for (auto &weights : mWeightsList) {
-               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
-               subtractOffsetAndNormalize(
-                     dataStartPatch,
-                     weightsPerPatch,
-                     sum / weightsPerPatch,
-                     sqrtf(var) / scale_factor);
             }
          }
       }
    }
    else {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
       for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
-         float sum           = 0.0f;
-         float sumsq         = 0.0f;
-         int weightsPerPatch = 0;
+         float sum   = 0.0f;
+         float sumsq = 0.0f;
+         int count   = 0;
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp = weights0->getPatchSizeX();
-               int nyp = weights0->getPatchSizeY();
-               int nfp = weights0->getPatchSizeF();
-               weightsPerPatch += nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateSumAndSumSquared(dataStartPatch, weightsPerPatch, &sum, &sumsq);
+               count += weightsPerPatch;
             }
          }
-         if (fabsf(sum) <= minSumTolerated) {
-            WarnLog().printf(
-                  "for NormalizeContrastZeroMean \"%s\": sum of weights in patch %d is within "
-                  "minSumTolerated=%f of zero. Weights in this patch unchanged.\n",
-                  getName(),
-                  patchindex,
-                  (double)minSumTolerated);
+         patchSkipped[patchindex] = fabsf(sum) <= minSumTolerated;
+         if (patchSkipped[patchindex]) {
             continue;
          }
-         int count  = weightsPerPatch * nArbors;
          float mean = sum / count;
          float var  = sumsq / count - mean * mean;
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                subtractOffsetAndNormalize(
                      dataStartPatch, weightsPerPatch, mean, sqrtf(var) / scale_factor);
             }
          }
       }
+      for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+         if (patchSkipped[patchindex]) {
+            WarnLog().printf(
+                  "for NormalizeContrastZeroMean \"%s\": sum of weights in patch %d is within "
+                  "minSumTolerated=%f of zero. Weights in this patch unchanged.\n",
+                  getName(),
+                  patchindex,
+                  (double)minSumTolerated);
+         }
+      }
    }
 
    return status;
@@ -179,6 +192,9 @@ void NormalizeContrastZeroMean::subtractOffsetAndNormalize(
       int weightsPerPatch,
       float offset,
       float normalizer) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
    for (int k = 0; k < weightsPerPatch; k++) {
       dataStartPatch[k] -= offset;
       dataStartPatch[k] /= normalizer;
@@ -193,11 +209,18 @@ int NormalizeContrastZeroMean::accumulateSumAndSumSquared(
    // Do not call with sum uninitialized.
    // sum, sumsq, max are not cleared inside this routine so that you can accumulate the stats over
    // several patches with multiple calls
+   float patchSum   = 0.0f;
+   float patchSumSq = 0.0f;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(+ : patchSum, patchSumSq)
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
       float w = dataPatchStart[k];
-      *sum += w;
-      *sumsq += w * w;
+      patchSum += w;
+      patchSumSq += w * w;
    }
+   *sum += patchSum;
+   *sumsq += patchSumSq;
    return PV_SUCCESS;
 }
 
@@ -63,20 +63,34 @@ int NormalizeL2::normalizeWeights() {
 
    int nArbors        = weights0->getNumArbors();
    int numDataPatches = weights0->getNumDataPatches();
+   // Patches are normalized in parallel; the patches that had to be skipped are recorded so that
+   // the warnings can be printed afterward, in order.
+   std::vector<char> patchSkipped(numDataPatches);
    if (mNormalizeArborsIndividually) {
       for (int arborID = 0; arborID < nArbors; arborID++) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
          for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
             float sumsq = 0.0f;
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateSumSquared(dataStartPatch, weightsPerPatch, &sumsq);
             }
-            float l2norm = sqrtf(sumsq);
-            if (fabsf(l2norm) <= minL2NormTolerated) {
+            float l2norm             = sqrtf(sumsq);
+            patchSkipped[patchindex] = fabsf(l2norm) <= minL2NormTolerated;
+            if (patchSkipped[patchindex]) {
+               continue;
+            }
+            for (auto &weights : mWeightsList) {
+               int weightsPerPatch   = weights->getPatchSizeOverall();
+               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
+               normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / l2norm);
+            }
+         }
+         for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+            if (patchSkipped[patchindex]) {
                WarnLog().printf(
                      "for NormalizeL2 \"%s\": sum of squares of weights in patch %d of arbor %d is "
                      "within minL2NormTolerated=%f of zero.  Weights in this patch unchanged.\n",
@@ -84,59 +98,97 @@ int NormalizeL2::normalizeWeights() {
                      patchindex,
                      arborID,
                      (double)minL2NormTolerated);
-               continue;
-            }
-            for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
-               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
-               normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / l2norm);
             }
          }
       }
    }
    else {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
       for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
          float sumsq = 0.0f;
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int xPatchStride      = weights->getPatchStrideX();
-               int yPatchStride      = weights->getPatchStrideY();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateSumSquared(dataStartPatch, weightsPerPatch, &sumsq);
             }
          }
-         float l2norm = sqrtf(sumsq);
-         if (fabsf(sumsq) <= minL2NormTolerated) {
-            WarnLog().printf(
-                  "for NormalizeL2 \"%s\": sum of squares of weights in patch %d is within "
-                  "minL2NormTolerated=%f of zero.  Weights in this patch unchanged.\n",
-                  getName(),
-                  patchindex,
-                  (double)minL2NormTolerated);
-            break;
+         float l2norm             = sqrtf(sumsq);
+         patchSkipped[patchindex] = fabsf(sumsq) <= minL2NormTolerated;
+         if (patchSkipped[patchindex]) {
+            continue;
          }
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / l2norm);
             }
          }
       }
+      for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+         if (patchSkipped[patchindex]) {
+            WarnLog().printf(
+                  "for NormalizeL2 \"%s\": sum of squares of weights in patch %d is within "
+                  "minL2NormTolerated=%f of zero.  Weights in this patch unchanged.\n",
+                  getName(),
+                  patchindex,
+                  (double)minL2NormTolerated);
+         }
+      }
    }
    return status;
 }
 
+bool NormalizeL2::canFuseWithUpdate() const { return canFuseGroup() and canFuseConstraints(); }
+
+bool NormalizeL2::normalizePatchFused(int patchIndex) {
+   // Does the same computations for one patch as normalizeWeights() does for all of them, in the
+   // same order, so that the results agree exactly.
+   Weights *weights     = mWeightsList[0];
+   float scaleFactor    = calcScaleFactor(weights);
+   int nArbors          = weights->getNumArbors();
+   int weightsPerPatch  = weights->getPatchSizeOverall();
+   bool patchNormalized = true;
+   if (mNonnegativeConstraintFlag) {
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         applyNonnegativeConstraint(dataStartPatch, weightsPerPatch);
+      }
+   }
+   if (mNormalizeArborsIndividually) {
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         float sumsq           = 0.0f;
+         accumulateSumSquared(dataStartPatch, weightsPerPatch, &sumsq);
+         float l2norm = sqrtf(sumsq);
+         if (fabsf(l2norm) <= minL2NormTolerated) {
+            patchNormalized = false;
+            continue;
+         }
+         normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / l2norm);
+      }
+   }
+   else {
+      float sumsq = 0.0f;
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         accumulateSumSquared(dataStartPatch, weightsPerPatch, &sumsq);
+      }
+      float l2norm = sqrtf(sumsq);
+      if (fabsf(sumsq) <= minL2NormTolerated) {
+         return false;
+      }
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / l2norm);
+      }
+   }
+   return patchNormalized;
+}
+
 NormalizeL2::~NormalizeL2() {}
 
 } /* namespace PV */
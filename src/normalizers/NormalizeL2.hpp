@@ -21,6 +21,10 @@ class NormalizeL2 : public PV::NormalizeMultiply {
    virtual int ioParamsFillGroup(enum ParamsIOFlag ioFlag) override;
    virtual int normalizeWeights() override;
 
+   virtual bool canFuseWithUpdate() const override;
+
+   virtual bool normalizePatchFused(int patchIndex) override;
+
   protected:
    NormalizeL2();
    int initialize(const char *name, HyPerCol *hc);
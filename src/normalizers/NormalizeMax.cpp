@@ -63,19 +63,33 @@ int NormalizeMax::normalizeWeights() {
 
    int nArbors        = weights0->getNumArbors();
    int numDataPatches = weights0->getNumDataPatches();
+   // Patches are normalized in parallel; the patches that had to be skipped are recorded so that
+   // the warnings can be printed afterward, in order.
+   std::vector<char> patchSkipped(numDataPatches);
    if (mNormalizeArborsIndividually) {
       for (int arborID = 0; arborID < nArbors; arborID++) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
          for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
             float max = 0.0f;
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateMax(dataStartPatch, weightsPerPatch, &max);
             }
-            if (max <= minMaxTolerated) {
+            patchSkipped[patchindex] = max <= minMaxTolerated;
+            if (patchSkipped[patchindex]) {
+               continue;
+            }
+            for (auto &weights : mWeightsList) {
+               int weightsPerPatch   = weights->getPatchSizeOverall();
+               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
+               normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / max);
+            }
+         }
+         for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+            if (patchSkipped[patchindex]) {
                WarnLog().printf(
                      "for NormalizeMax \"%s\": max of weights in patch %d of arbor %d is within "
                      "minMaxTolerated=%f of zero.  Weights in this patch unchanged.\n",
@@ -83,53 +97,46 @@ int NormalizeMax::normalizeWeights() {
                      patchindex,
                      arborID,
                      (double)minMaxTolerated);
-               continue;
-            }
-            for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
-               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
-               normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / max);
             }
          }
       }
    }
    else {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
       for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
-         float max = 0.0;
+         float max = 0.0f;
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateMax(dataStartPatch, weightsPerPatch, &max);
             }
          }
-         if (max <= minMaxTolerated) {
-            WarnLog().printf(
-                  "for NormalizeMax \"%s\": max of weights in patch %d is within "
-                  "minMaxTolerated=%f of zero. Weights in this patch unchanged.\n",
-                  getName(),
-                  patchindex,
-                  (double)minMaxTolerated);
+         patchSkipped[patchindex] = max <= minMaxTolerated;
+         if (patchSkipped[patchindex]) {
             continue;
          }
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / max);
             }
          }
+      } // patchindex
+      for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+         if (patchSkipped[patchindex]) {
+            WarnLog().printf(
+                  "for NormalizeMax \"%s\": max of weights in patch %d is within "
+                  "minMaxTolerated=%f of zero. Weights in this patch unchanged.\n",
+                  getName(),
+                  patchindex,
+                  (double)minMaxTolerated);
+         }
       }
-   }
+   } // mNormalizeArborsIndividually
    return status;
 }
 
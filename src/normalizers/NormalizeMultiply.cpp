@@ -135,6 +135,9 @@ int NormalizeMultiply::normalizeWeights() {
          int num_weights_in_patch = weights->getPatchSizeOverall();
          for (int arbor = 0; arbor < num_arbors; arbor++) {
             float *dataPatchStart = weights->getData(arbor);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
             for (int patchindex = 0; patchindex < num_patches; patchindex++) {
                applyRMin(
                      dataPatchStart + patchindex * num_weights_in_patch,
@@ -155,14 +158,14 @@ int NormalizeMultiply::normalizeWeights() {
          int num_arbors           = weights->getNumArbors();
          int num_patches          = weights->getNumDataPatches();
          int num_weights_in_patch = weights->getPatchSizeOverall();
-         int num_weights_in_arbor = num_patches * num_weights_in_patch;
          for (int arbor = 0; arbor < num_arbors; arbor++) {
             float *dataStart = weights->getData(arbor);
-            for (int weightindex = 0; weightindex < num_weights_in_arbor; weightindex++) {
-               float *w = &dataStart[weightindex];
-               if (*w < 0) {
-                  *w = 0;
-               }
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
+            for (int patchindex = 0; patchindex < num_patches; patchindex++) {
+               applyNonnegativeConstraint(
+                     dataStart + patchindex * num_weights_in_patch, num_weights_in_patch);
             }
          }
       }
@@ -177,6 +180,9 @@ int NormalizeMultiply::normalizeWeights() {
          int num_weights_in_patch = weights->getPatchSizeOverall();
          for (int arbor = 0; arbor < num_arbors; arbor++) {
             float *dataStart = weights->getData(arbor);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for reduction(max : max)
+#endif
             for (int patchindex = 0; patchindex < num_patches; patchindex++) {
                accumulateMaxAbs(
                      dataStart + patchindex * num_weights_in_patch, num_weights_in_patch, &max);
@@ -189,6 +195,9 @@ int NormalizeMultiply::normalizeWeights() {
          int num_weights_in_patch = weights->getPatchSizeOverall();
          for (int arbor = 0; arbor < num_arbors; arbor++) {
             float *dataStart = weights->getData(arbor);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
             for (int patchindex = 0; patchindex < num_patches; patchindex++) {
                applyThreshold(
                      dataStart + patchindex * num_weights_in_patch, num_weights_in_patch, max);
@@ -209,6 +218,9 @@ int NormalizeMultiply::normalizeWeights() {
 int NormalizeMultiply::applyThreshold(float *dataPatchStart, int weights_in_patch, float wMax) {
    assert(mNormalizeCutoff > 0); // Don't call this routine unless normalize_cutoff was set
    float threshold = wMax * mNormalizeCutoff;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
    for (int k = 0; k < weights_in_patch; k++) {
       if (fabsf(dataPatchStart[k]) < threshold)
          dataPatchStart[k] = 0;
@@ -249,8 +261,46 @@ int NormalizeMultiply::applyRMin(
 }
 
 void NormalizeMultiply::normalizePatch(float *patchData, int weightsPerPatch, float multiplier) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
    for (int k = 0; k < weightsPerPatch; k++)
       patchData[k] *= multiplier;
 }
 
+bool NormalizeMultiply::canFuseGroup() const {
+   if (mWeightsList.size() != (std::size_t)1 or !mNormalizeOnWeightUpdate) {
+      return false;
+   }
+   if (mNormalizeFromPostPerspective and !mWeightsList[0]->getSharedFlag()) {
+      return false; // Leave it to normalizeWeights() to report the error.
+   }
+   return true;
+}
+
+bool NormalizeMultiply::canFuseConstraints() const {
+   return !(mRMinX > 0.5f && mRMinY > 0.5f) and !(mNormalizeCutoff > 0);
+}
+
+void NormalizeMultiply::applyNonnegativeConstraint(float *patchData, int weightsPerPatch) const {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+   for (int k = 0; k < weightsPerPatch; k++) {
+      patchData[k] = patchData[k] < 0 ? 0 : patchData[k];
+   }
+}
+
+float NormalizeMultiply::calcScaleFactor(Weights const *weights) const {
+   float scaleFactor = 1.0f;
+   if (mNormalizeFromPostPerspective) {
+      PVLayerLoc const &preLoc  = weights->getGeometry()->getPreLoc();
+      PVLayerLoc const &postLoc = weights->getGeometry()->getPostLoc();
+      int numNeuronsPre         = preLoc.nx * preLoc.ny * preLoc.nf;
+      int numNeuronsPost        = postLoc.nx * postLoc.ny * postLoc.nf;
+      scaleFactor               = ((float)numNeuronsPost) / ((float)numNeuronsPre);
+   }
+   return scaleFactor * mStrength;
+}
+
 } /* namespace PV */
@@ -105,6 +105,31 @@ class NormalizeMultiply : public NormalizeBase {
 
    static void normalizePatch(float *patchData, int weightsPerPatch, float multiplier);
 
+   /**
+    * Returns true if the normalization group allows the weights to be normalized one patch at a
+    * time during the weight update: the group consists of a single connection, weights are
+    * normalized on weight update, and normalizeFromPostPerspective is not set for nonshared
+    * weights. Subclasses that implement normalizePatchFused() call this from canFuseWithUpdate().
+    */
+   bool canFuseGroup() const;
+
+   /**
+    * Returns true if neither rMinX/rMinY nor normalize_cutoff is in effect. The rMin region is
+    * not applied by normalizePatchFused(), and normalize_cutoff needs the maximum over all patches.
+    */
+   bool canFuseConstraints() const;
+
+   /**
+    * The per-patch counterpart of the nonnegativeConstraintFlag part of normalizeWeights().
+    */
+   void applyNonnegativeConstraint(float *patchData, int weightsPerPatch) const;
+
+   /**
+    * Returns the strength, multiplied by the ratio of postsynaptic to presynaptic neurons if
+    * normalizeFromPostPerspective is set.
+    */
+   float calcScaleFactor(Weights const *weights) const;
+
    // Member variables
   protected:
    float mRMinX                       = 0.0f;
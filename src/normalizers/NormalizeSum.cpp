@@ -71,19 +71,33 @@ int NormalizeSum::normalizeWeights() {
 
    int nArbors        = weights0->getNumArbors();
    int numDataPatches = weights0->getNumDataPatches();
+   // Patches are normalized in parallel; the patches that had to be skipped are recorded so that
+   // the warnings can be printed afterward, in order.
+   std::vector<char> patchSkipped(numDataPatches);
    if (mNormalizeArborsIndividually) {
       for (int arborID = 0; arborID < nArbors; arborID++) {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
          for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
-            float sum = 0.0;
+            float sum = 0.0f;
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateSum(dataStartPatch, weightsPerPatch, &sum);
             }
-            if (fabsf(sum) <= mMinSumTolerated) {
+            patchSkipped[patchindex] = fabsf(sum) <= mMinSumTolerated;
+            if (patchSkipped[patchindex]) {
+               continue;
+            }
+            for (auto &weights : mWeightsList) {
+               int weightsPerPatch   = weights->getPatchSizeOverall();
+               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
+               normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / sum);
+            }
+         }
+         for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+            if (patchSkipped[patchindex]) {
                WarnLog().printf(
                      "NormalizeSum for %s: sum of weights in patch %d of arbor %d is within "
                      "minSumTolerated=%f of zero. Weights in this patch unchanged.\n",
@@ -91,54 +105,86 @@ int NormalizeSum::normalizeWeights() {
                      patchindex,
                      arborID,
                      (double)mMinSumTolerated);
-               continue;
-            }
-            for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
-               float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
-               normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / sum);
             }
          }
       }
    }
    else {
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif
       for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
-         float sum = 0.0;
+         float sum = 0.0f;
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                accumulateSum(dataStartPatch, weightsPerPatch, &sum);
             }
          }
-         if (fabsf(sum) <= mMinSumTolerated) {
-            WarnLog().printf(
-                  "NormalizeSum for %s: sum of weights in patch %d is within minSumTolerated=%f of "
-                  "zero.  Weights in this patch unchanged.\n",
-                  getDescription_c(),
-                  patchindex,
-                  (double)mMinSumTolerated);
+         patchSkipped[patchindex] = fabsf(sum) <= mMinSumTolerated;
+         if (patchSkipped[patchindex]) {
             continue;
          }
          for (int arborID = 0; arborID < nArbors; arborID++) {
             for (auto &weights : mWeightsList) {
-               int nxp               = weights->getPatchSizeX();
-               int nyp               = weights->getPatchSizeY();
-               int nfp               = weights->getPatchSizeF();
-               int weightsPerPatch   = nxp * nyp * nfp;
+               int weightsPerPatch   = weights->getPatchSizeOverall();
                float *dataStartPatch = weights->getData(arborID) + patchindex * weightsPerPatch;
                normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / sum);
             }
          }
       } // patchindex
+      for (int patchindex = 0; patchindex < numDataPatches; patchindex++) {
+         if (patchSkipped[patchindex]) {
+            WarnLog().printf(
+                  "NormalizeSum for %s: sum of weights in patch %d is within minSumTolerated=%f of "
+                  "zero.  Weights in this patch unchanged.\n",
+                  getDescription_c(),
+                  patchindex,
+                  (double)mMinSumTolerated);
+         }
+      }
    } // mNormalizeArborsIndividually
    return status;
 }
 
+bool NormalizeSum::canFuseWithUpdate() const { return canFuseGroup(); }
+
+bool NormalizeSum::normalizePatchFused(int patchIndex) {
+   // Does the same computations for one patch as normalizeWeights() does for all of them, in the
+   // same order, so that the results agree exactly.
+   Weights *weights     = mWeightsList[0];
+   float scaleFactor    = calcScaleFactor(weights);
+   int nArbors          = weights->getNumArbors();
+   int weightsPerPatch  = weights->getPatchSizeOverall();
+   bool patchNormalized = true;
+   if (mNormalizeArborsIndividually) {
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         float sum             = 0.0;
+         accumulateSum(dataStartPatch, weightsPerPatch, &sum);
+         if (fabsf(sum) <= mMinSumTolerated) {
+            patchNormalized = false;
+            continue;
+         }
+         normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / sum);
+      }
+   }
+   else {
+      float sum = 0.0;
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         accumulateSum(dataStartPatch, weightsPerPatch, &sum);
+      }
+      if (fabsf(sum) <= mMinSumTolerated) {
+         return false;
+      }
+      for (int arborID = 0; arborID < nArbors; arborID++) {
+         float *dataStartPatch = weights->getData(arborID) + patchIndex * weightsPerPatch;
+         normalizePatch(dataStartPatch, weightsPerPatch, scaleFactor / sum);
+      }
+   }
+   return patchNormalized;
+}
+
 } /* namespace PV */
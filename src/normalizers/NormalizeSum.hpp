@@ -21,6 +21,10 @@ class NormalizeSum : public PV::NormalizeMultiply {
    virtual int ioParamsFillGroup(enum ParamsIOFlag ioFlag) override;
    virtual int normalizeWeights() override;
 
+   virtual bool canFuseWithUpdate() const override;
+
+   virtual bool normalizePatchFused(int patchIndex) override;
+
   protected:
    NormalizeSum();
    int initialize(const char *name, HyPerCol *hc);
@@ -107,8 +107,7 @@ void BaseConnectionProbe::initOutputStreams(const char *filename, Checkpointer *
          if (path[0] != '/') {
             path = checkpointer->makeOutputPathFilename(path);
          }
-         auto stream = new FileStream(path.c_str(), mode, checkpointer->doesVerifyWrites());
-         mOutputStreams.push_back(stream);
+         mOutputStreams.push_back(openOutputFileStream(path, mode, checkpointer));
       }
       else {
          auto stream = new PrintStream(PV::getOutputStream());
@@ -7,6 +7,7 @@
 
 #include "BaseProbe.hpp"
 #include "ColumnEnergyProbe.hpp"
+#include "io/AsyncPrintStream.hpp"
 #include "layers/HyPerLayer.hpp"
 #include <float.h>
 #include <limits>
@@ -23,6 +24,7 @@ BaseProbe::~BaseProbe() {
       delete s;
    }
    mOutputStreams.clear();
+   delete mBinaryOutputFile;
    free(targetName);
    targetName = NULL;
    free(msgparams);
@@ -78,6 +80,8 @@ int BaseProbe::ioParamsFillGroup(enum ParamsIOFlag ioFlag) {
    ioParam_message(ioFlag);
    ioParam_textOutputFlag(ioFlag);
    ioParam_probeOutputFile(ioFlag);
+   ioParam_probeOutputFormat(ioFlag);
+   ioParam_probeOutputCompression(ioFlag);
    ioParam_triggerLayerName(ioFlag);
    ioParam_triggerFlag(ioFlag);
    ioParam_triggerOffset(ioFlag);
@@ -124,6 +128,49 @@ void BaseProbe::ioParam_probeOutputFile(enum ParamsIOFlag ioFlag) {
    }
 }
 
+void BaseProbe::ioParam_probeOutputFormat(enum ParamsIOFlag ioFlag) {
+   assert(!parent->parameters()->presentAndNotBeenRead(name, "probeOutputFile"));
+   if (!textOutputFlag) {
+      return;
+   }
+   char *format = nullptr;
+   if (ioFlag == PARAMS_IO_WRITE) {
+      format = strdup(mBinaryOutputFlag ? "binary" : "text");
+   }
+   parent->parameters()->ioParamString(
+         ioFlag, name, "probeOutputFormat", &format, "text", false /*warnIfAbsent*/);
+   if (ioFlag == PARAMS_IO_READ) {
+      if (!strcmp(format, "binary")) {
+         mBinaryOutputFlag = true;
+      }
+      else if (strcmp(format, "text")) {
+         Fatal().printf(
+               "%s: probeOutputFormat \"%s\" is not recognized; it must be \"text\" or "
+               "\"binary\".\n",
+               getDescription_c(),
+               format);
+      }
+      bool const haveOutputFile = probeOutputFilename != nullptr and probeOutputFilename[0];
+      FatalIf(
+            mBinaryOutputFlag and !haveOutputFile,
+            "%s: probeOutputFormat \"binary\" requires probeOutputFile to be set.\n",
+            getDescription_c());
+   }
+   free(format);
+}
+
+void BaseProbe::ioParam_probeOutputCompression(enum ParamsIOFlag ioFlag) {
+   assert(!parent->parameters()->presentAndNotBeenRead(name, "probeOutputFormat"));
+   if (mBinaryOutputFlag) {
+      parent->parameters()->ioParamValue(
+            ioFlag,
+            name,
+            "probeOutputCompression",
+            &mBinaryOutputCompression,
+            mBinaryOutputCompression);
+   }
+}
+
 void BaseProbe::ioParam_triggerLayerName(enum ParamsIOFlag ioFlag) {
    parent->parameters()->ioParamString(
          ioFlag, name, "triggerLayerName", &triggerLayerName, NULL, false /*warnIfAbsent*/);
@@ -201,8 +248,7 @@ void BaseProbe::initOutputStreams(const char *filename, Checkpointer *checkpoint
             if (batchPath[0] != '/') {
                batchPath = checkpointer->makeOutputPathFilename(batchPath);
             }
-            auto fs = new FileStream(batchPath.c_str(), mode, checkpointer->doesVerifyWrites());
-            mOutputStreams[b] = fs;
+            mOutputStreams[b] = openOutputFileStream(batchPath, mode, checkpointer);
          }
       }
       else {
@@ -216,6 +262,74 @@ void BaseProbe::initOutputStreams(const char *filename, Checkpointer *checkpoint
    }
 }
 
+void BaseProbe::initBinaryOutputFile(Checkpointer *checkpointer) {
+   MPIBlock const *mpiBlock = checkpointer->getMPIBlock();
+   if (mpiBlock->getColumnIndex() != 0 or mpiBlock->getRowIndex() != 0) {
+      return;
+   }
+   int mpiBatchIndex  = mpiBlock->getStartBatch() + mpiBlock->getBatchIndex();
+   mBinaryBatchOffset = parent->getNBatch() * mpiBatchIndex;
+
+   std::string path(probeOutputFilename);
+   auto extensionStart = path.rfind('.');
+   if (extensionStart != std::string::npos) {
+      path = path.substr(0, extensionStart);
+   }
+   if (mpiBlock->getGlobalBatchDimension() > 1) {
+      path.append("_batchProcess_").append(std::to_string(mpiBatchIndex));
+   }
+   path.append(".pvprobe");
+   if (path[0] != '/') {
+      path = checkpointer->makeOutputPathFilename(path);
+   }
+   bool const append = !checkpointer->getCheckpointReadDirectory().empty();
+   mBinaryOutputFile = new ProbeBinaryFile(
+         path,
+         std::string(name),
+         getBinaryColumnNames(),
+         mBinaryOutputCompression,
+         append,
+         checkpointer->doesVerifyWrites());
+}
+
+Response::Status BaseProbe::cleanup() {
+   if (mBinaryOutputFile) {
+      mBinaryOutputFile->flush();
+   }
+   return Response::SUCCESS;
+}
+
+std::vector<std::string> BaseProbe::getBinaryColumnNames() const {
+   return std::vector<std::string>{"value"};
+}
+
+void BaseProbe::writeBinaryRecord(double timestamp, int localBatchIndex, double const *values) {
+   if (mBinaryOutputFile) {
+      mBinaryOutputFile->write(timestamp, localBatchIndex + mBinaryBatchOffset, values);
+   }
+}
+
+PrintStream *BaseProbe::openOutputFileStream(
+      std::string const &path,
+      std::ios_base::openmode mode,
+      Checkpointer *checkpointer) {
+   PrintStream *stream = new FileStream(path.c_str(), mode, checkpointer->doesVerifyWrites());
+   std::shared_ptr<AsyncWriter> writer = checkpointer->getProbeOutputWriter();
+   if (writer) {
+      stream = new AsyncPrintStream(stream, writer);
+   }
+   return stream;
+}
+
+void BaseProbe::submitOutput() {
+   for (auto &s : mOutputStreams) {
+      auto *asyncStream = dynamic_cast<AsyncPrintStream *>(s);
+      if (asyncStream) {
+         asyncStream->submit();
+      }
+   }
+}
+
 void BaseProbe::initNumValues() { setNumValues(parent->getNBatch()); }
 
 void BaseProbe::setNumValues(int n) {
@@ -322,7 +436,12 @@ Response::Status BaseProbe::registerData(Checkpointer *checkpointer) {
    if (!Response::completed(status)) {
       return status;
    }
-   initOutputStreams(probeOutputFilename, checkpointer);
+   if (mBinaryOutputFlag) {
+      initBinaryOutputFile(checkpointer);
+   }
+   else {
+      initOutputStreams(probeOutputFilename, checkpointer);
+   }
    return Response::SUCCESS;
 }
 
@@ -358,9 +477,28 @@ double BaseProbe::getValue(double timevalue, int index) {
 Response::Status BaseProbe::outputStateWrapper(double timef, double dt) {
    auto status = Response::NO_ACTION;
    if (textOutputFlag && needUpdate(timef, dt)) {
-      status = outputState(timef);
+      if (mBinaryOutputFlag) {
+         status = outputBinaryState(timef);
+      }
+      else {
+         status = outputState(timef);
+         submitOutput();
+      }
    }
    return status;
 }
 
+Response::Status BaseProbe::outputBinaryState(double timef) {
+   int const nbatch = parent->getNBatch();
+   FatalIf(
+         getNumValues() != nbatch,
+         "%s does not support probeOutputFormat \"binary\".\n",
+         getDescription_c());
+   getValues(timef);
+   for (int b = 0; b < nbatch; b++) {
+      writeBinaryRecord(timef, b, &probeValues[b]);
+   }
+   return Response::SUCCESS;
+}
+
 } // namespace PV
@@ -10,6 +10,7 @@
 #include "columns/BaseObject.hpp"
 #include "include/pv_common.h"
 #include "io/FileStream.hpp"
+#include "io/ProbeBinaryFile.hpp"
 #include "io/io.hpp"
 #include <stdio.h>
 #include <vector>
@@ -73,6 +74,15 @@ class BaseProbe : public BaseObject {
     * A pure virtual method for writing output to the output file.
     */
    virtual Response::Status outputState(double timef) = 0;
+
+   /**
+    * The method that outputStateWrapper calls instead of outputState when probeOutputFormat is
+    * "binary". BaseProbe::outputBinaryState writes one record for each batch element, whose only
+    * column is the value returned by getValues(). Probes whose values are not one per batch
+    * element, or that write other quantities, should override this method and
+    * getBinaryColumnNames().
+    */
+   virtual Response::Status outputBinaryState(double timef);
    virtual int writeTimer(PrintStream &stream) { return PV_SUCCESS; }
 
    /**
@@ -181,6 +191,23 @@ class BaseProbe : public BaseObject {
     */
    virtual void ioParam_probeOutputFile(enum ParamsIOFlag ioFlag);
 
+   /**
+    * @brief probeOutputFormat: If textOutputFlag is true, probeOutputFormat is either "text"
+    * (the default) or "binary". In binary format, each MPI batch process writes a single file
+    * in the format described in ProbeBinaryFile, in place of the text files for its batch
+    * elements. The file name is probeOutputFile with its extension replaced by ".pvprobe"; if
+    * there is more than one MPI batch process, "_batchProcess_" and the batch process index are
+    * inserted before the extension. Binary format requires probeOutputFile to be set.
+    */
+   virtual void ioParam_probeOutputFormat(enum ParamsIOFlag ioFlag);
+
+   /**
+    * @brief probeOutputCompression: If probeOutputFormat is "binary", probeOutputCompression
+    * specifies whether the records are compressed in blocks. Defaults to false, so that the
+    * file can be memory-mapped.
+    */
+   virtual void ioParam_probeOutputCompression(enum ParamsIOFlag ioFlag);
+
    /**
     * @brief triggerFlag: If false, the needUpdate method always returns true,
     * so that outputState is called every timestep.  If true, the needUpdate
@@ -231,6 +258,30 @@ class BaseProbe : public BaseObject {
     */
    virtual void initOutputStreams(const char *filename, Checkpointer *checkpointer);
 
+   /**
+    * Called by registerData instead of initOutputStreams when probeOutputFormat is "binary".
+    * If the MPIBlock row index and column index are zero, this method opens the binary output
+    * file, whose columns are given by getBinaryColumnNames(). Otherwise it does nothing.
+    */
+   void initBinaryOutputFile(Checkpointer *checkpointer);
+
+   /**
+    * Writes any records still buffered by the binary output file at the end of the run.
+    */
+   virtual Response::Status cleanup() override;
+
+   /**
+    * Returns the names of the values in each record of the binary output.
+    * BaseProbe::getBinaryColumnNames() returns a single column, "value".
+    */
+   virtual std::vector<std::string> getBinaryColumnNames() const;
+
+   /**
+    * Adds a record to the binary output file, if this process has one. The batch index is the
+    * local batch index; the record holds the corresponding global batch index.
+    */
+   void writeBinaryRecord(double timestamp, int localBatchIndex, double const *values);
+
    /**
     * A pure virtual method for that should return true if the quantities being
     * measured by the probe have changed since the last time the quantities were
@@ -290,6 +341,22 @@ class BaseProbe : public BaseObject {
     */
    PrintStream &output(int b) { return *mOutputStreams.at(b); }
 
+   /**
+    * Opens the file at the given path for the probe's text output. If the checkpointer's
+    * asyncProbeOutput flag is set, the FileStream is wrapped in an AsyncPrintStream, so that
+    * the output is written by a background thread.
+    */
+   PrintStream *openOutputFileStream(
+         std::string const &path,
+         std::ios_base::openmode mode,
+         Checkpointer *checkpointer);
+
+   /**
+    * Hands any output collected by asynchronous output streams to the background writer.
+    * Called by outputStateWrapper after each call to outputState.
+    */
+   void submitOutput();
+
    /**
     * initNumValues is called by initialize.
     * BaseProbe::initNumValues sets numValues to the parent HyPerCol's
@@ -323,6 +390,11 @@ class BaseProbe : public BaseObject {
     */
    inline bool getTextOutputFlag() const { return textOutputFlag; }
 
+   /**
+    * Returns true if probeOutputFormat is "binary".
+    */
+   inline bool getBinaryOutputFlag() const { return mBinaryOutputFlag; }
+
    /**
     * Returns true if a probeOutputFile is being used.
     * Otherwise, returns false (indicating output is going to getOutputStream().
@@ -367,8 +439,12 @@ class BaseProbe : public BaseObject {
    double *probeValues;
    double lastUpdateTime; // The time of the last time calcValues was called.
    bool textOutputFlag;
-   bool mInitInfoCommunicatedFlag    = false;
-   bool mDataStructuresAllocatedFlag = false;
+   bool mBinaryOutputFlag             = false;
+   bool mBinaryOutputCompression      = false;
+   ProbeBinaryFile *mBinaryOutputFile = nullptr;
+   int mBinaryBatchOffset             = 0;
+   bool mInitInfoCommunicatedFlag     = false;
+   bool mDataStructuresAllocatedFlag  = false;
 };
 }
 
@@ -8,6 +8,7 @@
 #include "L0NormProbe.hpp"
 #include "columns/HyPerCol.hpp"
 #include "layers/HyPerLayer.hpp"
+#include "probes/LayerStatistics.hpp"
 
 namespace PV {
 
@@ -130,4 +131,17 @@ double L0NormProbe::getValueInternal(double timevalue, int index) {
 
 int L0NormProbe::setNormDescription() { return setNormDescriptionToString("L0-norm"); }
 
+void L0NormProbe::calcValues(double timevalue) {
+   if (getMaskLayer()) {
+      AbstractNormProbe::calcValues(timevalue);
+      return;
+   }
+   LayerStatistics::Statistics const &stats =
+         getTargetLayer()->getStatistics()->compute(BufActivity, nnzThreshold, timevalue);
+   double *valuesBuffer = getValuesBuffer();
+   for (int b = 0; b < getNumValues(); b++) {
+      valuesBuffer[b] = stats.mNumNonzero[b];
+   }
+}
+
 } // end namespace PV
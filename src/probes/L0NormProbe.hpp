@@ -27,6 +27,13 @@ class L0NormProbe : public AbstractNormProbe {
    int initialize(const char *name, HyPerCol *hc);
    virtual double getValueInternal(double timevalue, int index) override;
 
+   /**
+    * Without masking, the count is taken from the target layer's statistics,
+    * which are shared with any other probe of the layer's activity that uses
+    * the same threshold. With masking, it calls AbstractNormProbe::calcValues.
+    */
+   virtual void calcValues(double timevalue) override;
+
    virtual int ioParamsFillGroup(enum ParamsIOFlag ioFlag) override;
    /**
     * List of parameters for the L0NormProbe class
@@ -10,6 +10,7 @@
 #include "L1NormProbe.hpp"
 #include "columns/HyPerCol.hpp"
 #include "layers/HyPerLayer.hpp"
+#include "probes/LayerStatistics.hpp"
 
 namespace PV {
 
@@ -120,4 +121,17 @@ double L1NormProbe::getValueInternal(double timevalue, int index) {
 
 int L1NormProbe::setNormDescription() { return setNormDescriptionToString("L1-norm"); }
 
+void L1NormProbe::calcValues(double timevalue) {
+   if (getMaskLayer()) {
+      AbstractNormProbe::calcValues(timevalue);
+      return;
+   }
+   LayerStatistics::Statistics const &stats =
+         getTargetLayer()->getStatistics()->compute(BufActivity, 0.0f, timevalue);
+   double *valuesBuffer = getValuesBuffer();
+   for (int b = 0; b < getNumValues(); b++) {
+      valuesBuffer[b] = stats.mSumAbs[b];
+   }
+}
+
 } // end namespace PV
@@ -26,9 +26,17 @@ class L1NormProbe : public AbstractNormProbe {
    /**
     * For each MPI process, getValueInternal returns the sum of the absolute
     * values of the activities in the restricted space of that MPI process.
+    * It is only called when masking is used.
     */
    virtual double getValueInternal(double timevalue, int index) override;
 
+   /**
+    * Without masking, the L1-norm is taken from the target layer's statistics,
+    * which are shared with any other probe of the layer's activity.
+    * With masking, it calls AbstractNormProbe::calcValues.
+    */
+   virtual void calcValues(double timevalue) override;
+
    /**
     * Overrides AbstractNormProbe::setNormDescription() to set normDescription to
     * "L1-norm".
@@ -8,6 +8,7 @@
 #include "L2NormProbe.hpp"
 #include "columns/HyPerCol.hpp"
 #include "layers/HyPerLayer.hpp"
+#include "probes/LayerStatistics.hpp"
 
 namespace PV {
 
@@ -148,7 +149,17 @@ double L2NormProbe::getValueInternal(double timevalue, int index) {
 }
 
 void L2NormProbe::calcValues(double timevalue) {
-   AbstractNormProbe::calcValues(timevalue);
+   if (getMaskLayer()) {
+      AbstractNormProbe::calcValues(timevalue);
+   }
+   else {
+      LayerStatistics::Statistics const &stats =
+            getTargetLayer()->getStatistics()->compute(BufActivity, 0.0f, timevalue);
+      double *valuesBuffer = getValuesBuffer();
+      for (int b = 0; b < getNumValues(); b++) {
+         valuesBuffer[b] = stats.mSumSquared[b];
+      }
+   }
    if (exponent != 2.0) {
       double *valBuf = getValuesBuffer();
       int numVals    = this->getNumValues();
@@ -38,13 +38,15 @@ class L2NormProbe : public AbstractNormProbe {
 
    /**
     * Overrides AbstractNormProbe::calcValues method to apply the exponent.
+    * Without masking, the sum of squares is taken from the target layer's
+    * statistics, which are shared with any other probe of the layer's activity.
     */
    virtual void calcValues(double timevalue) override;
 
    /**
     * Each MPI process returns the sum of the squares of the activities in its
     * restricted activity space.  Note that the exponent parameter is not applied
-    * inside the call to getValueInternal.
+    * inside the call to getValueInternal. It is only called when masking is used.
     */
    virtual double getValueInternal(double timevalue, int index) override;
 
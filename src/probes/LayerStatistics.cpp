@@ -0,0 +1,148 @@
+#include "LayerStatistics.hpp"
+#include "layers/HyPerLayer.hpp"
+#include "utils/PVAssert.hpp"
+#include <cfloat>
+#include <cmath>
+
+namespace PV {
+
+LayerStatistics::LayerStatistics(HyPerLayer *layer, MPI_Comm comm) : mLayer(layer), mComm(comm) {}
+
+LayerStatistics::Statistics const &
+LayerStatistics::compute(PVBufType type, float nnzThreshold, double timestamp) {
+   double const layerUpdateTime = mLayer->getLastUpdateTime();
+   CacheEntry *entry            = nullptr;
+   for (auto &c : mCache) {
+      if (c.mType == type and c.mNnzThreshold == nnzThreshold) {
+         entry = &c;
+         break;
+      }
+   }
+   if (entry == nullptr) {
+      mCache.emplace_back();
+      entry                = &mCache.back();
+      entry->mType         = type;
+      entry->mNnzThreshold = nnzThreshold;
+   }
+   else if (entry->mTimestamp == timestamp and entry->mLayerUpdateTime == layerUpdateTime) {
+      return entry->mStatistics;
+   }
+   entry->mTimestamp       = timestamp;
+   entry->mLayerUpdateTime = layerUpdateTime;
+   computeLocal(type, nnzThreshold, entry->mStatistics);
+   reduce(entry->mStatistics);
+   return entry->mStatistics;
+}
+
+void LayerStatistics::computeLocal(PVBufType type, float nnzThreshold, Statistics &stats) {
+   PVLayerLoc const *loc = mLayer->getLayerLoc();
+   int const nbatch      = loc->nbatch;
+   int const ny          = loc->ny;
+   int const rowLength   = loc->nx * loc->nf;
+
+   // V is restricted; the activity is extended, so each restricted row starts past the left
+   // margin and the rows are separated by the width of the extended region.
+   float const *buffer = nullptr;
+   int batchStride, rowStride, rowOffset;
+   switch (type) {
+      case BufV:
+         buffer      = mLayer->getV();
+         batchStride = mLayer->getNumNeurons();
+         rowStride   = rowLength;
+         rowOffset   = 0;
+         break;
+      case BufActivity:
+         buffer      = mLayer->getLayerData();
+         batchStride = mLayer->getNumExtended();
+         rowStride   = (loc->nx + loc->halo.lt + loc->halo.rt) * loc->nf;
+         rowOffset   = loc->halo.up * rowStride + loc->halo.lt * loc->nf;
+         break;
+      default: pvAssert(0); break;
+   }
+   pvAssert(buffer != nullptr);
+
+   stats.mSum.assign(nbatch, 0.0);
+   stats.mSumSquared.assign(nbatch, 0.0);
+   stats.mSumAbs.assign(nbatch, 0.0);
+   stats.mNumNonzero.assign(nbatch, 0.0);
+   stats.mMin.assign(nbatch, FLT_MAX);
+   stats.mMax.assign(nbatch, -FLT_MAX);
+   stats.mNumGlobalNeurons = mLayer->getNumGlobalNeurons();
+
+   for (int b = 0; b < nbatch; b++) {
+      float const *batchStart = buffer + b * batchStride + rowOffset;
+      double sum              = 0.0;
+      double sumSquared       = 0.0;
+      double sumAbs           = 0.0;
+      double numNonzero       = 0.0;
+      float minValue          = FLT_MAX;
+      float maxValue          = -FLT_MAX;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for reduction(+ : sum, sumSquared, sumAbs, numNonzero) \
+      reduction(min : minValue) reduction(max : maxValue)
+#endif // PV_USE_OPENMP_THREADS
+      for (int y = 0; y < ny; y++) {
+         float const *row = batchStart + y * rowStride;
+         double rowSum = 0.0, rowSumSquared = 0.0, rowSumAbs = 0.0, rowNonzero = 0.0;
+         float rowMin = FLT_MAX, rowMax = -FLT_MAX;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd reduction(+ : rowSum, rowSumSquared, rowSumAbs, rowNonzero) \
+      reduction(min : rowMin) reduction(max : rowMax)
+#endif // PV_USE_OPENMP_THREADS
+         for (int k = 0; k < rowLength; k++) {
+            float const a  = row[k];
+            double const d = (double)a;
+            rowSum += d;
+            rowSumSquared += d * d;
+            rowSumAbs += std::fabs(d);
+            rowNonzero += std::fabs(a) > nnzThreshold ? 1.0 : 0.0;
+            rowMin = a < rowMin ? a : rowMin;
+            rowMax = a > rowMax ? a : rowMax;
+         }
+         sum += rowSum;
+         sumSquared += rowSumSquared;
+         sumAbs += rowSumAbs;
+         numNonzero += rowNonzero;
+         minValue = rowMin < minValue ? rowMin : minValue;
+         maxValue = rowMax > maxValue ? rowMax : maxValue;
+      }
+      stats.mSum[b]        = sum;
+      stats.mSumSquared[b] = sumSquared;
+      stats.mSumAbs[b]     = sumAbs;
+      stats.mNumNonzero[b] = numNonzero;
+      stats.mMin[b]        = minValue;
+      stats.mMax[b]        = maxValue;
+   }
+}
+
+void LayerStatistics::reduce(Statistics &stats) {
+   // The sums are packed into one reduction and the extrema, with the minimum negated, into
+   // another, since MPI has no single operation that both sums and takes the maximum.
+   int const nbatch = (int)stats.mSum.size();
+   std::vector<double> sums(4 * nbatch);
+   std::vector<float> extrema(2 * nbatch);
+   for (int b = 0; b < nbatch; b++) {
+      sums[4 * b + 0]    = stats.mSum[b];
+      sums[4 * b + 1]    = stats.mSumSquared[b];
+      sums[4 * b + 2]    = stats.mSumAbs[b];
+      sums[4 * b + 3]    = stats.mNumNonzero[b];
+      extrema[2 * b + 0] = stats.mMax[b];
+      extrema[2 * b + 1] = -stats.mMin[b];
+   }
+   MPI_Request requests[2];
+   MPI_Iallreduce(
+         MPI_IN_PLACE, sums.data(), 4 * nbatch, MPI_DOUBLE, MPI_SUM, mComm, &requests[0]);
+   MPI_Iallreduce(
+         MPI_IN_PLACE, extrema.data(), 2 * nbatch, MPI_FLOAT, MPI_MAX, mComm, &requests[1]);
+   MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+   for (int b = 0; b < nbatch; b++) {
+      stats.mSum[b]        = sums[4 * b + 0];
+      stats.mSumSquared[b] = sums[4 * b + 1];
+      stats.mSumAbs[b]     = sums[4 * b + 2];
+      stats.mNumNonzero[b] = sums[4 * b + 3];
+      stats.mMax[b]        = extrema[2 * b + 0];
+      stats.mMin[b]        = -extrema[2 * b + 1];
+   }
+}
+
+} // namespace PV
@@ -0,0 +1,73 @@
+#ifndef LAYERSTATISTICS_HPP_
+#define LAYERSTATISTICS_HPP_
+
+#include "probes/LayerProbe.hpp"
+#include <vector>
+
+namespace PV {
+
+class HyPerLayer;
+
+/**
+ * Computes the summary statistics of a layer's activity or membrane potential that StatsProbe
+ * and the L0, L1 and L2 norm probes report: the sum, the sum of squares, the sum of absolute
+ * values, the number of values whose magnitude exceeds a threshold, the minimum and the maximum,
+ * for each batch element, over the restricted region of the whole column.
+ *
+ * All the statistics are computed in a single multithreaded pass over the rows of the restricted
+ * region, and reduced across the MPI processes of the layer's communicator with nonblocking
+ * reductions that are started together. The result is cached, so that any number of probes
+ * on the same layer, buffer and threshold share one pass and one set of reductions per update.
+ *
+ * Each HyPerLayer owns a LayerStatistics object, returned by HyPerLayer::getStatistics().
+ */
+class LayerStatistics {
+  public:
+   struct Statistics {
+      std::vector<double> mSum;
+      std::vector<double> mSumSquared;
+      std::vector<double> mSumAbs;
+      std::vector<double> mNumNonzero; // count of values with |value| > the threshold
+      std::vector<float> mMin;
+      std::vector<float> mMax;
+      int mNumGlobalNeurons = 0;
+   };
+
+   /**
+    * The communicator is the one the layer's column is divided over, within a single batch
+    * process, as returned by Communicator::communicator().
+    */
+   LayerStatistics(HyPerLayer *layer, MPI_Comm comm);
+   ~LayerStatistics() {}
+
+   /**
+    * Returns the statistics of the given buffer of the layer, with nonzero meaning a magnitude
+    * greater than nnzThreshold. The statistics are recomputed only if the timestamp or the
+    * layer's last update time has changed since the last call with the same buffer and threshold.
+    * Since the result may involve MPI reductions, this function must be called by all processes
+    * in the layer's communicator, with the same arguments.
+    * The V buffer must not be null when type is BufV.
+    */
+   Statistics const &compute(PVBufType type, float nnzThreshold, double timestamp);
+
+  private:
+   struct CacheEntry {
+      PVBufType mType;
+      float mNnzThreshold;
+      double mTimestamp;
+      double mLayerUpdateTime;
+      Statistics mStatistics;
+   };
+
+   void computeLocal(PVBufType type, float nnzThreshold, Statistics &stats);
+   void reduce(Statistics &stats);
+
+  private:
+   HyPerLayer *mLayer = nullptr;
+   MPI_Comm mComm;
+   std::vector<CacheEntry> mCache;
+};
+
+} // namespace PV
+
+#endif // LAYERSTATISTICS_HPP_
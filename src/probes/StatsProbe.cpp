@@ -7,6 +7,8 @@
 
 #include "StatsProbe.hpp"
 #include "../layers/HyPerLayer.hpp"
+#include "LayerStatistics.hpp"
+#include <cmath>
 #include <float.h> // FLT_MAX/MIN
 #include <string.h>
 
@@ -26,11 +28,9 @@ StatsProbe::~StatsProbe() {
    int rank = parent->columnId();
    if (rank == 0 and !mOutputStreams.empty()) {
       iotimer->fprint_time(output(0));
-      mpitimer->fprint_time(output(0));
       comptimer->fprint_time(output(0));
    }
    delete iotimer;
-   delete mpitimer;
    delete comptimer;
    free(sum);
    free(sum2);
@@ -52,7 +52,6 @@ int StatsProbe::initialize_base() {
 
    type         = BufV;
    iotimer      = NULL;
-   mpitimer     = NULL;
    comptimer    = NULL;
    nnzThreshold = (float)0;
    return PV_SUCCESS;
@@ -180,10 +179,6 @@ Response::Status StatsProbe::registerData(Checkpointer *checkpointer) {
    iotimer      = new Timer(timermessage.c_str());
    checkpointer->registerTimer(iotimer);
 
-   timermessage = timermessagehead + " MPI  timer ";
-   mpitimer     = new Timer(timermessage.c_str());
-   checkpointer->registerTimer(mpitimer);
-
    timermessage = timermessagehead + " Comp timer ";
    comptimer    = new Timer(timermessage.c_str());
    checkpointer->registerTimer(comptimer);
@@ -193,99 +188,42 @@ Response::Status StatsProbe::registerData(Checkpointer *checkpointer) {
 Response::Status StatsProbe::outputState(double timed) {
 #ifdef PV_USE_MPI
    Communicator *icComm = parent->getCommunicator();
-   MPI_Comm comm        = icComm->communicator();
    int rank             = icComm->commRank();
    const int rcvProc    = 0;
 #endif // PV_USE_MPI
 
-   int nk;
-   const float *buf;
    resetStats();
 
-   nk = getTargetLayer()->getNumNeurons();
-
    int nbatch = getTargetLayer()->getLayerLoc()->nbatch;
 
-   comptimer->start();
-   switch (type) {
-      case BufV:
-         for (int b = 0; b < nbatch; b++) {
-            buf = getTargetLayer()->getV() + b * getTargetLayer()->getNumNeurons();
-            if (buf == NULL) {
+   if (type == BufV and getTargetLayer()->getV() == nullptr) {
 #ifdef PV_USE_MPI
-               if (rank != rcvProc) {
-                  return Response::SUCCESS;
-               }
+      if (rank != rcvProc) {
+         return Response::SUCCESS;
+      }
 #endif // PV_USE_MPI
-               output(b) << getMessage() << "V buffer is NULL\n";
-               return Response::SUCCESS;
-            }
-            for (int k = 0; k < nk; k++) {
-               float a = buf[k];
-               sum[b] += (double)a;
-               sum2[b] += (double)(a * a);
-               if (fabsf(a) > nnzThreshold) {
-                  nnz[b]++;
-               }
-               if (a < fMin[b]) {
-                  fMin[b] = a;
-               }
-               if (a > fMax[b]) {
-                  fMax[b] = a;
-               }
-            }
-         }
-         break;
-      case BufActivity:
-         for (int b = 0; b < nbatch; b++) {
-            buf = getTargetLayer()->getLayerData() + b * getTargetLayer()->getNumExtended();
-            assert(buf != NULL);
-            for (int k = 0; k < nk; k++) {
-               const PVLayerLoc *loc = getTargetLayer()->getLayerLoc();
-               int kex               = kIndexExtended(
-                     k,
-                     loc->nx,
-                     loc->ny,
-                     loc->nf,
-                     loc->halo.lt,
-                     loc->halo.rt,
-                     loc->halo.dn,
-                     loc->halo.up); // TODO: faster to use strides
-               // and a double-loop than
-               // compute
-               // kIndexExtended for every neuron?
-               float a = buf[kex];
-               sum[b] += (double)a;
-               sum2[b] += (double)(a * a);
-               if (fabsf(a) > nnzThreshold) {
-                  nnz[b]++; // Optimize for different datatypes of a?
-               }
-               if (a < fMin[b]) {
-                  fMin[b] = a;
-               }
-               if (a > fMax[b]) {
-                  fMax[b] = a;
-               }
-            }
-         }
-         break;
-      default: pvAssert(0); break;
+      for (int b = 0; b < nbatch; b++) {
+         output(b) << getMessage() << "V buffer is NULL\n";
+      }
+      return Response::SUCCESS;
    }
+
+   // The layer computes the statistics in one pass and reduces them across processes, sharing
+   // the result with any other probe that asks for the same buffer and threshold this timestep.
+   comptimer->start();
+   LayerStatistics::Statistics const &stats =
+         getTargetLayer()->getStatistics()->compute(type, nnzThreshold, timed);
    comptimer->stop();
+   for (int b = 0; b < nbatch; b++) {
+      sum[b]  = stats.mSum[b];
+      sum2[b] = stats.mSumSquared[b];
+      nnz[b]  = (int)stats.mNumNonzero[b];
+      fMin[b] = stats.mMin[b];
+      fMax[b] = stats.mMax[b];
+   }
+   int nk = stats.mNumGlobalNeurons;
 
 #ifdef PV_USE_MPI
-   mpitimer->start();
-   int ierr;
-
-   // In place reduction to prevent allocating a temp recv buffer
-   ierr = MPI_Allreduce(MPI_IN_PLACE, sum, nbatch, MPI_DOUBLE, MPI_SUM, comm);
-   ierr = MPI_Allreduce(MPI_IN_PLACE, sum2, nbatch, MPI_DOUBLE, MPI_SUM, comm);
-   ierr = MPI_Allreduce(MPI_IN_PLACE, nnz, nbatch, MPI_INT, MPI_SUM, comm);
-   ierr = MPI_Allreduce(MPI_IN_PLACE, fMin, nbatch, MPI_FLOAT, MPI_MIN, comm);
-   ierr = MPI_Allreduce(MPI_IN_PLACE, fMax, nbatch, MPI_FLOAT, MPI_MAX, comm);
-   ierr = MPI_Allreduce(MPI_IN_PLACE, &nk, 1, MPI_INT, MPI_SUM, comm);
-
-   mpitimer->stop();
    if (rank != rcvProc) {
       return Response::SUCCESS;
    }
@@ -329,9 +267,41 @@ Response::Status StatsProbe::outputState(double timed) {
    return Response::SUCCESS;
 }
 
+Response::Status StatsProbe::outputBinaryState(double timed) {
+   if (type == BufV and getTargetLayer()->getV() == nullptr) {
+      return Response::SUCCESS;
+   }
+   comptimer->start();
+   LayerStatistics::Statistics const &stats =
+         getTargetLayer()->getStatistics()->compute(type, nnzThreshold, timed);
+   comptimer->stop();
+
+   iotimer->start();
+   int nbatch      = getTargetLayer()->getLayerLoc()->nbatch;
+   double const nk = (double)stats.mNumGlobalNeurons;
+   for (int b = 0; b < nbatch; b++) {
+      double const mean     = stats.mSum[b] / nk;
+      double const variance = stats.mSumSquared[b] / nk - mean * mean;
+      double values[7];
+      values[0] = nk;
+      values[1] = stats.mSum[b];
+      values[2] = (double)stats.mMin[b];
+      values[3] = mean;
+      values[4] = (double)stats.mMax[b];
+      values[5] = std::sqrt(variance > 0.0 ? variance : 0.0);
+      values[6] = stats.mNumNonzero[b];
+      writeBinaryRecord(timed, b, values);
+   }
+   iotimer->stop();
+   return Response::SUCCESS;
+}
+
+std::vector<std::string> StatsProbe::getBinaryColumnNames() const {
+   return std::vector<std::string>{"N", "Total", "Min", "Avg", "Max", "sigma", "nnz"};
+}
+
 int StatsProbe::checkpointTimers(PrintStream &timerstream) {
    iotimer->fprint_time(timerstream);
-   mpitimer->fprint_time(timerstream);
    comptimer->fprint_time(timerstream);
    return PV_SUCCESS;
 }
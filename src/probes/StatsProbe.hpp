@@ -18,6 +18,13 @@ class StatsProbe : public PV::LayerProbe {
    virtual ~StatsProbe();
 
    virtual Response::Status outputState(double timef) override;
+
+   /**
+    * Writes one binary record per batch element, with the columns returned by
+    * getBinaryColumnNames(). Unlike the text output, the average is not converted to hertz
+    * for sparse layers.
+    */
+   virtual Response::Status outputBinaryState(double timef) override;
    virtual int checkpointTimers(PrintStream &timerstream);
 
   protected:
@@ -40,6 +47,11 @@ class StatsProbe : public PV::LayerProbe {
 
    virtual Response::Status registerData(Checkpointer *checkpointer) override;
 
+   /**
+    * Returns the quantities in the text output: N, Total, Min, Avg, Max, sigma, and nnz.
+    */
+   virtual std::vector<std::string> getBinaryColumnNames() const override;
+
    /**
     * Implements needRecalc() for StatsProbe to always return false (getValues
     * and getValue methods
@@ -68,8 +80,7 @@ class StatsProbe : public PV::LayerProbe {
 
    float nnzThreshold;
    Timer *iotimer; // A timer for the i/o part of outputState
-   Timer *mpitimer; // A timer for the MPI part of outputState
-   Timer *comptimer; // A timer for the basic computation of outputState
+   Timer *comptimer; // A timer for computing and reducing the statistics in outputState
 
   private:
    int initialize_base();
@@ -0,0 +1,348 @@
+#include "ImageCache.hpp"
+#include "io/FileStream.hpp"
+#include "io/io.hpp"
+#include "utils/BufferUtilsPvp.hpp"
+#include "utils/PVAssert.hpp"
+#include "utils/PVLog.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace PV {
+
+namespace {
+
+std::uint8_t quantize(float value) {
+   float const clamped = std::min(std::max(value, 0.0f), 1.0f);
+   return (std::uint8_t)std::lround(clamped * 255.0f);
+}
+
+std::string indexPath(std::string const &spillPath) { return spillPath + ".index"; }
+
+bool fileExists(std::string const &path) {
+   struct stat fileStat;
+   return stat(path.c_str(), &fileStat) == 0;
+}
+
+} // namespace
+
+ImageCache::ImageCache(std::size_t capacity, DataType dataType)
+      : mCapacity(capacity), mDataType(dataType) {}
+
+ImageCache::~ImageCache() { unmapSpillFile(); }
+
+std::size_t ImageCache::frameBytes(int numElements) const {
+   std::size_t const elementSize = mDataType == BYTE ? sizeof(std::uint8_t) : sizeof(float);
+   return (std::size_t)numElements * elementSize;
+}
+
+void ImageCache::openSpillFile(std::string const &path, int width, int height, int features) {
+   unmapSpillFile();
+   mSpilled.clear();
+   mNumSpilledFrames = 0;
+   mSpillPath        = path;
+   mSpillWidth       = width;
+   mSpillHeight      = height;
+   mSpillFeatures    = features;
+   if (!readSpillIndex()) {
+      createSpillFile();
+   }
+   mapSpillFile();
+}
+
+bool ImageCache::readSpillIndex() {
+   if (!fileExists(mSpillPath) or !fileExists(indexPath(mSpillPath))) {
+      return false;
+   }
+   BufferUtils::ActivityHeader header;
+   {
+      FileStream headerStream(mSpillPath.c_str(), std::ios_base::in | std::ios_base::binary);
+      header = BufferUtils::readActivityHeader(headerStream);
+   }
+   BufferUtils::HeaderDataType const dataType =
+         mDataType == BYTE ? BufferUtils::BYTE : BufferUtils::FLOAT;
+   if (header.fileType != PVP_NONSPIKING_ACT_FILE_TYPE or header.nx != mSpillWidth
+       or header.ny != mSpillHeight or header.nf != mSpillFeatures or header.dataType != dataType
+       or (std::size_t)header.dataSize != frameBytes(1)) {
+      WarnLog().printf(
+            "Image cache spill file \"%s\" does not hold %dx%dx%d %s frames. Replacing it.\n",
+            mSpillPath.c_str(),
+            mSpillWidth,
+            mSpillHeight,
+            mSpillFeatures,
+            mDataType == BYTE ? "byte" : "float");
+      return false;
+   }
+
+   // A run that stopped while appending a frame can leave the file and its index with different
+   // numbers of frames. Only the frames that both hold completely are used.
+   struct stat fileStat;
+   stat(mSpillPath.c_str(), &fileStat);
+   std::size_t const frameSize =
+         sizeof(double) + frameBytes(mSpillWidth * mSpillHeight * mSpillFeatures);
+   long const numStoredFrames =
+         ((long)fileStat.st_size - (long)header.headerSize) / (long)frameSize;
+   int const numFrames = (int)std::min((long)header.nBands, std::max(numStoredFrames, 0L));
+
+   std::ifstream indexStream(indexPath(mSpillPath));
+   std::vector<std::string> lines;
+   std::string line;
+   while ((int)lines.size() < numFrames and std::getline(indexStream, line)) {
+      std::istringstream fields(line);
+      SpillEntry entry;
+      entry.mFrameIndex = (int)lines.size();
+      std::string key;
+      fields >> entry.mSourceWidth >> entry.mSourceHeight;
+      fields.get();
+      std::getline(fields, key);
+      if (fields.fail() or key.empty()) {
+         break;
+      }
+      mSpilled[key] = entry;
+      lines.push_back(line);
+   }
+   indexStream.close();
+   mNumSpilledFrames = (int)lines.size();
+
+   // Rewrite the index if it lists frames that the file does not hold, so that lines appended
+   // later line up with their frames.
+   std::ofstream rewritten(indexPath(mSpillPath), std::ios_base::out | std::ios_base::trunc);
+   for (auto const &l : lines) {
+      rewritten << l << "\n";
+   }
+   FatalIf(
+         rewritten.fail(),
+         "Unable to write image cache index \"%s\": %s\n",
+         indexPath(mSpillPath).c_str(),
+         strerror(errno));
+   InfoLog().printf(
+         "Image cache spill file \"%s\" holds %d frames.\n",
+         mSpillPath.c_str(),
+         mNumSpilledFrames);
+   return true;
+}
+
+void ImageCache::createSpillFile() {
+   mSpilled.clear();
+   mNumSpilledFrames = 0;
+   {
+      FileStream spillStream(mSpillPath.c_str(), std::ios_base::out | std::ios_base::binary);
+      BufferUtils::ActivityHeader header;
+      if (mDataType == BYTE) {
+         header = BufferUtils::buildActivityHeader<std::uint8_t>(
+               mSpillWidth, mSpillHeight, mSpillFeatures, 0);
+      }
+      else {
+         header = BufferUtils::buildActivityHeader<float>(
+               mSpillWidth, mSpillHeight, mSpillFeatures, 0);
+      }
+      BufferUtils::writeActivityHeader(spillStream, header);
+   }
+   std::ofstream indexStream(indexPath(mSpillPath), std::ios_base::out | std::ios_base::trunc);
+   FatalIf(
+         indexStream.fail(),
+         "Unable to create image cache index \"%s\": %s\n",
+         indexPath(mSpillPath).c_str(),
+         strerror(errno));
+}
+
+void ImageCache::mapSpillFile() {
+   unmapSpillFile();
+   int fd = open(mSpillPath.c_str(), O_RDONLY);
+   FatalIf(fd < 0, "ImageCache unable to open \"%s\": %s\n", mSpillPath.c_str(), strerror(errno));
+   struct stat fileStat;
+   FatalIf(
+         fstat(fd, &fileStat) != 0,
+         "ImageCache unable to stat \"%s\": %s\n",
+         mSpillPath.c_str(),
+         strerror(errno));
+   mMappedSize = (std::size_t)fileStat.st_size;
+   mMappedFile = mmap(nullptr, mMappedSize, PROT_READ, MAP_SHARED, fd, 0);
+   FatalIf(
+         mMappedFile == MAP_FAILED,
+         "ImageCache unable to map \"%s\": %s\n",
+         mSpillPath.c_str(),
+         strerror(errno));
+   close(fd);
+   mNumMappedFrames = mNumSpilledFrames;
+}
+
+void ImageCache::unmapSpillFile() {
+   if (mMappedFile != nullptr) {
+      munmap(mMappedFile, mMappedSize);
+      mMappedFile = nullptr;
+      mMappedSize = (std::size_t)0;
+   }
+   mNumMappedFrames = 0;
+}
+
+Buffer<float> ImageCache::readSpilledFrame(int frameIndex) {
+   if (frameIndex >= mNumMappedFrames) {
+      // The frame was appended after the file was mapped.
+      mapSpillFile();
+   }
+   pvAssert(frameIndex < mNumMappedFrames);
+   int const numElements       = mSpillWidth * mSpillHeight * mSpillFeatures;
+   std::size_t const frameSize = sizeof(double) + frameBytes(numElements);
+   char const *mapped          = static_cast<char const *>(mMappedFile);
+   int headerSize;
+   std::memcpy(&headerSize, mapped, sizeof(headerSize));
+   char const *data = mapped + headerSize + (std::size_t)frameIndex * frameSize + sizeof(double);
+   std::vector<float> values(numElements);
+   if (mDataType == BYTE) {
+      std::uint8_t const *bytes = reinterpret_cast<std::uint8_t const *>(data);
+      for (int k = 0; k < numElements; k++) {
+         values[k] = (float)bytes[k] / 255.0f;
+      }
+   }
+   else {
+      std::memcpy(values.data(), data, frameBytes(numElements));
+   }
+   return Buffer<float>(values, mSpillWidth, mSpillHeight, mSpillFeatures);
+}
+
+bool ImageCache::find(
+      std::string const &key,
+      Buffer<float> *frame,
+      int *sourceWidth,
+      int *sourceHeight) {
+   auto found = mEntries.find(key);
+   if (found != mEntries.end()) {
+      Entry const &entry = found->second;
+      mRecency.splice(mRecency.begin(), mRecency, entry.mRecency);
+      if (mDataType == BYTE) {
+         std::vector<float> values(entry.mByteData.size());
+         for (std::size_t k = 0; k < values.size(); k++) {
+            values[k] = (float)entry.mByteData[k] / 255.0f;
+         }
+         frame->set(values, entry.mWidth, entry.mHeight, entry.mFeatures);
+      }
+      else {
+         frame->set(entry.mFloatData, entry.mWidth, entry.mHeight, entry.mFeatures);
+      }
+      *sourceWidth  = entry.mSourceWidth;
+      *sourceHeight = entry.mSourceHeight;
+      mNumMemoryHits++;
+      return true;
+   }
+   auto spilled = mSpilled.find(key);
+   if (spilled != mSpilled.end()) {
+      SpillEntry const entry = spilled->second;
+      *frame                 = readSpilledFrame(entry.mFrameIndex);
+      *sourceWidth           = entry.mSourceWidth;
+      *sourceHeight          = entry.mSourceHeight;
+      storeInMemory(key, *frame, entry.mSourceWidth, entry.mSourceHeight);
+      mNumSpillHits++;
+      return true;
+   }
+   mNumMisses++;
+   return false;
+}
+
+void ImageCache::insert(
+      std::string const &key,
+      Buffer<float> const &frame,
+      int sourceWidth,
+      int sourceHeight) {
+   storeInMemory(key, frame, sourceWidth, sourceHeight);
+   if (!mSpillPath.empty() and mSpilled.find(key) == mSpilled.end()
+       and frame.getWidth() == mSpillWidth and frame.getHeight() == mSpillHeight
+       and frame.getFeatures() == mSpillFeatures) {
+      appendToSpillFile(key, frame, sourceWidth, sourceHeight);
+   }
+}
+
+void ImageCache::storeInMemory(
+      std::string const &key,
+      Buffer<float> const &frame,
+      int sourceWidth,
+      int sourceHeight) {
+   auto found = mEntries.find(key);
+   if (found != mEntries.end()) {
+      mSize -= frameBytes(found->second.mWidth * found->second.mHeight * found->second.mFeatures);
+      mRecency.erase(found->second.mRecency);
+      mEntries.erase(found);
+   }
+   std::size_t const bytes = frameBytes(frame.getTotalElements());
+   if (bytes > mCapacity) {
+      return;
+   }
+   evict(bytes);
+
+   mRecency.push_front(key);
+   Entry &entry        = mEntries[key];
+   entry.mWidth        = frame.getWidth();
+   entry.mHeight       = frame.getHeight();
+   entry.mFeatures     = frame.getFeatures();
+   entry.mSourceWidth  = sourceWidth;
+   entry.mSourceHeight = sourceHeight;
+   entry.mRecency      = mRecency.begin();
+   if (mDataType == BYTE) {
+      int const numElements = frame.getTotalElements();
+      entry.mByteData.resize(numElements);
+      for (int k = 0; k < numElements; k++) {
+         entry.mByteData[k] = quantize(frame.at(k));
+      }
+   }
+   else {
+      entry.mFloatData = frame.asVector();
+   }
+   mSize += bytes;
+}
+
+void ImageCache::evict(std::size_t newFrameBytes) {
+   while (!mRecency.empty() and mSize + newFrameBytes > mCapacity) {
+      auto oldest = mEntries.find(mRecency.back());
+      pvAssert(oldest != mEntries.end());
+      Entry const &entry = oldest->second;
+      mSize -= frameBytes(entry.mWidth * entry.mHeight * entry.mFeatures);
+      mEntries.erase(oldest);
+      mRecency.pop_back();
+   }
+}
+
+void ImageCache::appendToSpillFile(
+      std::string const &key,
+      Buffer<float> const &frame,
+      int sourceWidth,
+      int sourceHeight) {
+   int const frameIndex = mNumSpilledFrames;
+   if (mDataType == BYTE) {
+      int const numElements = frame.getTotalElements();
+      std::vector<std::uint8_t> bytes(numElements);
+      for (int k = 0; k < numElements; k++) {
+         bytes[k] = quantize(frame.at(k));
+      }
+      Buffer<std::uint8_t> byteFrame(
+            bytes, frame.getWidth(), frame.getHeight(), frame.getFeatures());
+      BufferUtils::appendToPvp(mSpillPath.c_str(), &byteFrame, frameIndex, (double)frameIndex);
+   }
+   else {
+      Buffer<float> floatFrame(frame);
+      BufferUtils::appendToPvp(mSpillPath.c_str(), &floatFrame, frameIndex, (double)frameIndex);
+   }
+
+   std::ofstream indexStream(indexPath(mSpillPath), std::ios_base::out | std::ios_base::app);
+   indexStream << sourceWidth << " " << sourceHeight << " " << key << "\n";
+   FatalIf(
+         indexStream.fail(),
+         "Unable to append to image cache index \"%s\": %s\n",
+         indexPath(mSpillPath).c_str(),
+         strerror(errno));
+
+   SpillEntry &entry   = mSpilled[key];
+   entry.mFrameIndex   = frameIndex;
+   entry.mSourceWidth  = sourceWidth;
+   entry.mSourceHeight = sourceHeight;
+   mNumSpilledFrames++;
+}
+
+} // namespace PV
@@ -0,0 +1,143 @@
+#ifndef IMAGECACHE_HPP_
+#define IMAGECACHE_HPP_
+
+#include "structures/Buffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * A size-bounded cache of decoded input frames. Each frame is stored under a key that identifies
+ * its source and everything done to it; ImageLayer uses the file name, the size of the global
+ * layer, the rescaling options and the number of color channels. With each frame, the cache
+ * keeps the width and height of its source before any rescaling.
+ *
+ * Frames are held in memory either as floats or, to fit four times as many, as bytes. Byte
+ * frames are clamped to [0, 1] and rounded to multiples of 1/255, which loses nothing for images
+ * decoded from 8-bit files and not interpolated. When the frames in memory would exceed the
+ * capacity, the least recently used frames are dropped.
+ *
+ * The cache can also keep its frames in a spill file: a nonspiking-activity .pvp file whose
+ * frames all have the same size, alongside an index file (the spill path with ".index" appended)
+ * that lists the source width, source height and key of each frame, one frame per line. Every
+ * frame inserted is appended to the spill file. The spill file is memory-mapped and read when a
+ * key is not in memory, so a later run that opens the same spill file starts with all of its
+ * frames available without decoding them.
+ */
+class ImageCache {
+  public:
+   enum DataType { FLOAT, BYTE };
+
+   /**
+    * Creates an empty cache that holds up to capacity bytes of frame data in memory.
+    */
+   ImageCache(std::size_t capacity, DataType dataType);
+
+   ~ImageCache();
+
+   /**
+    * Opens the spill file at the given path for frames of the given size. If the file and its
+    * index exist and hold frames of that size and data type, their frames become available.
+    * Otherwise, both files are replaced by empty ones.
+    */
+   void openSpillFile(std::string const &path, int width, int height, int features);
+
+   /**
+    * If the cache holds a frame with the given key, copies it into *frame, sets *sourceWidth and
+    * *sourceHeight to the size of its source, and returns true. Otherwise returns false and
+    * leaves the arguments unchanged.
+    */
+   bool find(std::string const &key, Buffer<float> *frame, int *sourceWidth, int *sourceHeight);
+
+   /**
+    * Stores a frame under the given key, replacing any frame already stored under it in memory.
+    * The frame is also appended to the spill file, if one is open, the frame has the spill
+    * file's size, and the key is not already in the spill file. A frame larger than the capacity
+    * is not kept in memory.
+    */
+   void insert(
+         std::string const &key,
+         Buffer<float> const &frame,
+         int sourceWidth,
+         int sourceHeight);
+
+   std::size_t getCapacity() const { return mCapacity; }
+
+   /** The number of bytes of frame data held in memory. */
+   std::size_t getSize() const { return mSize; }
+
+   int getNumFramesInMemory() const { return (int)mEntries.size(); }
+   int getNumSpilledFrames() const { return mNumSpilledFrames; }
+   long getNumMemoryHits() const { return mNumMemoryHits; }
+   long getNumSpillHits() const { return mNumSpillHits; }
+   long getNumMisses() const { return mNumMisses; }
+
+  private:
+   struct Entry {
+      std::vector<float> mFloatData;
+      std::vector<std::uint8_t> mByteData;
+      int mWidth;
+      int mHeight;
+      int mFeatures;
+      int mSourceWidth;
+      int mSourceHeight;
+      std::list<std::string>::iterator mRecency;
+   };
+
+   struct SpillEntry {
+      int mFrameIndex;
+      int mSourceWidth;
+      int mSourceHeight;
+   };
+
+   std::size_t frameBytes(int numElements) const;
+   void storeInMemory(
+         std::string const &key,
+         Buffer<float> const &frame,
+         int sourceWidth,
+         int sourceHeight);
+   void evict(std::size_t newFrameBytes);
+   void createSpillFile();
+   bool readSpillIndex();
+   void appendToSpillFile(
+         std::string const &key,
+         Buffer<float> const &frame,
+         int sourceWidth,
+         int sourceHeight);
+   void mapSpillFile();
+   void unmapSpillFile();
+   Buffer<float> readSpilledFrame(int frameIndex);
+
+  private:
+   std::size_t mCapacity;
+   DataType mDataType;
+   std::size_t mSize = (std::size_t)0;
+
+   // Keys of the frames in memory, most recently used first.
+   std::list<std::string> mRecency;
+   std::map<std::string, Entry> mEntries;
+
+   std::string mSpillPath;
+   int mSpillWidth       = 0;
+   int mSpillHeight      = 0;
+   int mSpillFeatures    = 0;
+   int mNumSpilledFrames = 0;
+   std::map<std::string, SpillEntry> mSpilled;
+   void *mMappedFile       = nullptr;
+   std::size_t mMappedSize = (std::size_t)0;
+   int mNumMappedFrames    = 0;
+
+   long mNumMemoryHits = 0L;
+   long mNumSpillHits  = 0L;
+   long mNumMisses     = 0L;
+};
+
+} // namespace PV
+
+#endif // IMAGECACHE_HPP_
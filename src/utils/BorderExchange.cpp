@@ -14,6 +14,7 @@ BorderExchange::BorderExchange(MPIBlock const &mpiBlock, PVLayerLoc const &loc)
    mLayerLoc = loc;
    newDatatypes();
    initNeighbors();
+   computeNumBytesPerExchange();
 }
 
 BorderExchange::~BorderExchange() { freeDatatypes(); }
@@ -97,6 +98,23 @@ void BorderExchange::freeDatatypes() {
 #endif // PV_USE_MPI
 }
 
+void BorderExchange::computeNumBytesPerExchange() {
+   mNumBytesPerExchange = (std::size_t)0;
+#ifdef PV_USE_MPI
+   PVHalo const &halo = mLayerLoc.halo;
+   if (halo.lt == 0 && halo.rt == 0 && halo.dn == 0 && halo.up == 0) {
+      return;
+   }
+   for (int n = 1; n < NUM_NEIGHBORHOOD; n++) {
+      if (neighbors[n] == mMPIBlock->getRank())
+         continue; // exchange() does not send to itself
+      int typeSize = 0;
+      MPI_Type_size(mDatatypes[n], &typeSize);
+      mNumBytesPerExchange += (std::size_t)typeSize;
+   }
+#endif // PV_USE_MPI
+}
+
 void BorderExchange::initNeighbors() {
    neighbors.resize(NUM_NEIGHBORHOOD, -1);
    mNumNeighbors = 0U;
@@ -27,6 +27,11 @@ class BorderExchange {
 
    int getNumNeighbors() const { return mNumNeighbors; }
 
+   /**
+    * Returns the number of bytes that one call to exchange() sends to other processes.
+    */
+   std::size_t getNumBytesPerExchange() const { return mNumBytesPerExchange; }
+
    static int northwest(int row, int column, int numRows, int numColumns);
    static int north(int row, int column, int numRows, int numColumns);
    static int northeast(int row, int column, int numRows, int numColumns);
@@ -51,6 +56,8 @@ class BorderExchange {
 
    void initNeighbors();
 
+   void computeNumBytesPerExchange();
+
    /**
     * In a send/receive exchange, when rank A makes an MPI send to its neighbor
     * in direction x, that neighbor must make a complementary MPI receive call.
@@ -84,6 +91,7 @@ class BorderExchange {
    std::vector<MPI_Datatype> mDatatypes;
    std::vector<int> neighbors;
    unsigned int mNumNeighbors;
+   std::size_t mNumBytesPerExchange = (std::size_t)0;
 
    /**
     * Returns the rank of the neighbor in the given direction
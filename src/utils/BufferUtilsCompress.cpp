@@ -0,0 +1,320 @@
+#include "BufferUtilsCompress.hpp"
+#include "cMakeHeader.h"
+#include "utils/PVLog.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace PV {
+namespace BufferUtils {
+namespace { // Anonymous namespace for "private" functions
+
+struct ChunkHeader {
+   std::uint64_t uncompressedSize;
+   std::uint32_t elementSize;
+   std::uint32_t numBlocks;
+};
+
+// The high bit of a block record indicates that the block is stored uncompressed.
+std::uint32_t const storedFlag = (std::uint32_t)1 << 31;
+
+int const minMatch      = 4;
+int const hashLog       = 14;
+int const maxOffset     = 65535;
+int const lastLiterals  = 5; // Matches may not extend into the last few bytes of a block.
+int const mfLimit       = 12; // Matches may not start in the last few bytes of a block.
+int const tokenMaxCount = 15;
+int const skipTrigger   = 6;
+
+inline std::uint32_t read32(unsigned char const *p) {
+   std::uint32_t value;
+   memcpy(&value, p, sizeof(value));
+   return value;
+}
+
+inline int hashPosition(unsigned char const *p) {
+   return (int)((read32(p) * 2654435761U) >> (32 - hashLog));
+}
+
+void shuffle(unsigned char const *in, unsigned char *out, std::size_t size, std::size_t width) {
+   std::size_t const numElements = size / width;
+   for (std::size_t b = 0; b < width; b++) {
+      unsigned char *dest = &out[b * numElements];
+      for (std::size_t i = 0; i < numElements; i++) {
+         dest[i] = in[i * width + b];
+      }
+   }
+   std::size_t const tail = numElements * width;
+   memcpy(&out[tail], &in[tail], size - tail);
+}
+
+void unshuffle(unsigned char const *in, unsigned char *out, std::size_t size, std::size_t width) {
+   std::size_t const numElements = size / width;
+   for (std::size_t b = 0; b < width; b++) {
+      unsigned char const *source = &in[b * numElements];
+      for (std::size_t i = 0; i < numElements; i++) {
+         out[i * width + b] = source[i];
+      }
+   }
+   std::size_t const tail = numElements * width;
+   memcpy(&out[tail], &in[tail], size - tail);
+}
+
+unsigned char *appendCount(unsigned char *out, int count) {
+   while (count >= 255) {
+      *out++ = (unsigned char)255;
+      count -= 255;
+   }
+   *out++ = (unsigned char)count;
+   return out;
+}
+
+// Appends one sequence at out, and returns the position just past it.
+unsigned char *appendSequence(
+      unsigned char *out,
+      unsigned char const *literals,
+      int numLiterals,
+      int offset,
+      int matchLength) {
+   int const literalCode = numLiterals < tokenMaxCount ? numLiterals : tokenMaxCount;
+   int matchCode         = 0;
+   if (matchLength > 0) {
+      matchCode = matchLength - minMatch < tokenMaxCount ? matchLength - minMatch : tokenMaxCount;
+   }
+   *out++ = (unsigned char)((literalCode << 4) | matchCode);
+   if (literalCode == tokenMaxCount) {
+      out = appendCount(out, numLiterals - tokenMaxCount);
+   }
+   memcpy(out, literals, (std::size_t)numLiterals);
+   out += numLiterals;
+   if (matchLength > 0) {
+      *out++ = (unsigned char)(offset & 0xff);
+      *out++ = (unsigned char)(offset >> 8);
+      if (matchCode == tokenMaxCount) {
+         out = appendCount(out, matchLength - minMatch - tokenMaxCount);
+      }
+   }
+   return out;
+}
+
+// Compresses a block of at most losslessBlockSize bytes with a greedy LZ77 parse, in the LZ4
+// block format. Each sequence is a token byte (literal count in the high nibble, match length
+// minus minMatch in the low nibble, with 15 meaning that more count bytes follow), the literals,
+// and, except in the last sequence, a two-byte match offset. As LZ4 requires, no match starts
+// within mfLimit bytes of the end of the block, and the last lastLiterals bytes are literals.
+// Returns an empty vector if the block does not compress.
+std::vector<unsigned char> compressBlock(unsigned char const *in, int size) {
+   // Sequences are emitted only while the output is smaller than the input, so the output
+   // never exceeds the input size plus one worst-case sequence.
+   std::vector<unsigned char> out((std::size_t)(size + size / 255 + 16));
+   unsigned char *outPos = out.data();
+   unsigned char *outEnd = outPos + size;
+   std::vector<int> table((std::size_t)1 << hashLog, -1);
+   int const matchLimit = size - lastLiterals;
+   int anchor           = 0;
+   int pos              = 0;
+   int numMisses        = 0;
+   while (pos + mfLimit <= size) {
+      int const h         = hashPosition(&in[pos]);
+      int const candidate = table[h];
+      table[h]            = pos;
+      bool const isMatch  = candidate >= 0 and pos - candidate <= maxOffset
+                           and read32(&in[candidate]) == read32(&in[pos]);
+      if (!isMatch) {
+         // Step faster through data that is not matching, as LZ4 does.
+         pos += 1 + (numMisses++ >> skipTrigger);
+         continue;
+      }
+      numMisses  = 0;
+      int length = minMatch;
+      while (pos + length < matchLimit and in[candidate + length] == in[pos + length]) {
+         length++;
+      }
+      outPos = appendSequence(outPos, &in[anchor], pos - anchor, pos - candidate, length);
+      pos += length;
+      anchor = pos;
+      if (outPos >= outEnd) {
+         return std::vector<unsigned char>();
+      }
+   }
+   outPos = appendSequence(outPos, &in[anchor], size - anchor, 0, 0);
+   if (outPos >= outEnd) {
+      return std::vector<unsigned char>();
+   }
+   out.resize((std::size_t)(outPos - out.data()));
+   return out;
+}
+
+bool readCount(unsigned char const *&in, unsigned char const *inEnd, int &count) {
+   unsigned char byte;
+   do {
+      if (in == inEnd) {
+         return false;
+      }
+      byte = *in++;
+      count += (int)byte;
+   } while (byte == 255);
+   return true;
+}
+
+bool decompressBlock(unsigned char const *in, int inSize, unsigned char *out, int outSize) {
+   unsigned char const *inEnd = in + inSize;
+   int pos                    = 0;
+   while (in < inEnd) {
+      int const token = (int)*in++;
+      int numLiterals = token >> 4;
+      if (numLiterals == tokenMaxCount and !readCount(in, inEnd, numLiterals)) {
+         return false;
+      }
+      if (numLiterals > inEnd - in or numLiterals > outSize - pos) {
+         return false;
+      }
+      memcpy(&out[pos], in, (std::size_t)numLiterals);
+      in += numLiterals;
+      pos += numLiterals;
+      if (in == inEnd) {
+         break; // The last sequence has no match.
+      }
+      if (inEnd - in < 2) {
+         return false;
+      }
+      int const offset = (int)in[0] | ((int)in[1] << 8);
+      in += 2;
+      int matchLength = token & 0x0f;
+      if (matchLength == tokenMaxCount and !readCount(in, inEnd, matchLength)) {
+         return false;
+      }
+      matchLength += minMatch;
+      if (offset == 0 or offset > pos or matchLength > outSize - pos) {
+         return false;
+      }
+      // Matches can overlap the bytes they produce, so copy byte by byte.
+      unsigned char const *match = &out[pos - offset];
+      for (int k = 0; k < matchLength; k++) {
+         out[pos + k] = match[k];
+      }
+      pos += matchLength;
+   }
+   return pos == outSize;
+}
+
+ChunkHeader readChunkHeader(unsigned char const *chunk, std::size_t chunkSize) {
+   ChunkHeader header;
+   FatalIf(chunkSize < sizeof(header), "Compressed chunk is too short to hold its header.\n");
+   memcpy(&header, chunk, sizeof(header));
+   std::size_t const expectedBlocks =
+         (std::size_t)((header.uncompressedSize + losslessBlockSize - 1) / losslessBlockSize);
+   FatalIf(
+         header.numBlocks != expectedBlocks
+               or chunkSize < sizeof(header) + header.numBlocks * sizeof(std::uint32_t),
+         "Compressed chunk has a corrupt header.\n");
+   return header;
+}
+
+} // end anonymous namespace
+
+std::vector<unsigned char>
+compressLossless(void const *data, std::size_t size, std::size_t elementSize) {
+   FatalIf(
+         elementSize != 1 and elementSize != 2 and elementSize != 4 and elementSize != 8,
+         "compressLossless: element size %zu must be 1, 2, 4, or 8.\n",
+         elementSize);
+   unsigned char const *bytes = static_cast<unsigned char const *>(data);
+   int const numBlocks        = (int)((size + losslessBlockSize - 1) / losslessBlockSize);
+
+   std::vector<std::vector<unsigned char>> blocks((std::size_t)numBlocks);
+   std::vector<std::uint32_t> records((std::size_t)numBlocks);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(dynamic)
+#endif
+   for (int b = 0; b < numBlocks; b++) {
+      std::size_t const start     = (std::size_t)b * losslessBlockSize;
+      std::size_t const blockSize = std::min(losslessBlockSize, size - start);
+      std::vector<unsigned char> shuffled(blockSize);
+      shuffle(&bytes[start], shuffled.data(), blockSize, elementSize);
+      blocks[b] = compressBlock(shuffled.data(), (int)blockSize);
+      if (blocks[b].empty()) {
+         blocks[b].assign(&bytes[start], &bytes[start + blockSize]);
+         records[b] = (std::uint32_t)blockSize | storedFlag;
+      }
+      else {
+         records[b] = (std::uint32_t)blocks[b].size();
+      }
+   }
+
+   ChunkHeader header;
+   header.uncompressedSize = (std::uint64_t)size;
+   header.elementSize      = (std::uint32_t)elementSize;
+   header.numBlocks        = (std::uint32_t)numBlocks;
+   std::size_t chunkSize   = sizeof(header) + records.size() * sizeof(std::uint32_t);
+   for (auto const &b : blocks) {
+      chunkSize += b.size();
+   }
+   std::vector<unsigned char> chunk;
+   chunk.reserve(chunkSize);
+   unsigned char const *headerBytes = reinterpret_cast<unsigned char const *>(&header);
+   chunk.insert(chunk.end(), headerBytes, headerBytes + sizeof(header));
+   unsigned char const *recordBytes = reinterpret_cast<unsigned char const *>(records.data());
+   chunk.insert(chunk.end(), recordBytes, recordBytes + records.size() * sizeof(std::uint32_t));
+   for (auto const &b : blocks) {
+      chunk.insert(chunk.end(), b.begin(), b.end());
+   }
+   return chunk;
+}
+
+std::size_t losslessUncompressedSize(unsigned char const *chunk, std::size_t chunkSize) {
+   return (std::size_t)readChunkHeader(chunk, chunkSize).uncompressedSize;
+}
+
+void decompressLossless(
+      unsigned char const *chunk,
+      std::size_t chunkSize,
+      void *data,
+      std::size_t size) {
+   ChunkHeader const header = readChunkHeader(chunk, chunkSize);
+   FatalIf(
+         header.uncompressedSize != (std::uint64_t)size,
+         "decompressLossless: chunk holds %llu bytes, but %zu bytes were expected.\n",
+         (unsigned long long)header.uncompressedSize,
+         size);
+   int const numBlocks = (int)header.numBlocks;
+   std::vector<std::uint32_t> records((std::size_t)numBlocks);
+   memcpy(records.data(), &chunk[sizeof(header)], records.size() * sizeof(std::uint32_t));
+   std::vector<std::size_t> blockStarts((std::size_t)numBlocks + 1);
+   blockStarts[0] = sizeof(header) + records.size() * sizeof(std::uint32_t);
+   for (int b = 0; b < numBlocks; b++) {
+      blockStarts[b + 1] = blockStarts[b] + (std::size_t)(records[b] & ~storedFlag);
+   }
+   FatalIf(blockStarts[numBlocks] > chunkSize, "Compressed chunk is truncated.\n");
+
+   unsigned char *bytes          = static_cast<unsigned char *>(data);
+   std::size_t const elementSize = (std::size_t)header.elementSize;
+   bool corrupt                  = false;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(dynamic) reduction(|| : corrupt)
+#endif
+   for (int b = 0; b < numBlocks; b++) {
+      std::size_t const start      = (std::size_t)b * losslessBlockSize;
+      std::size_t const blockSize  = std::min(losslessBlockSize, size - start);
+      unsigned char const *payload = &chunk[blockStarts[b]];
+      int const payloadSize        = (int)(records[b] & ~storedFlag);
+      if (records[b] & storedFlag) {
+         if ((std::size_t)payloadSize != blockSize) {
+            corrupt = true;
+            continue;
+         }
+         memcpy(&bytes[start], payload, blockSize);
+         continue;
+      }
+      std::vector<unsigned char> shuffled(blockSize);
+      if (!decompressBlock(payload, payloadSize, shuffled.data(), (int)blockSize)) {
+         corrupt = true;
+         continue;
+      }
+      unshuffle(shuffled.data(), &bytes[start], blockSize, elementSize);
+   }
+   FatalIf(corrupt, "decompressLossless: compressed chunk is corrupt.\n");
+}
+
+} // End BufferUtils namespace
+} // End PV namespace
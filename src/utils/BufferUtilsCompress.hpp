@@ -0,0 +1,51 @@
+#ifndef __BUFFERUTILSCOMPRESS_HPP__
+#define __BUFFERUTILSCOMPRESS_HPP__
+
+#include <cstddef>
+#include <vector>
+
+namespace PV {
+namespace BufferUtils {
+
+/**
+ * The size in bytes of the blocks that compressLossless() divides its input into.
+ * Blocks are compressed independently, so that they can be processed in parallel.
+ */
+std::size_t const losslessBlockSize = (std::size_t)1 << 16;
+
+/**
+ * Compresses size bytes starting at data, without loss, and returns the compressed chunk.
+ * The data are treated as an array of elements of elementSize bytes each (elementSize must
+ * be 1, 2, 4, or 8). Within each block, the bytes are shuffled so that the first bytes of
+ * all the elements come first, then the second bytes, and so on; the shuffled block is then
+ * compressed with an LZ77-type byte-oriented compressor whose output is in the LZ4 block
+ * format, so that other tools can decode it. The shuffle puts the slowly-varying sign and
+ * exponent bytes of floating-point data next to each other, and makes runs of zeroes in sparse
+ * data easy to find. A block that does not compress is stored unchanged.
+ *
+ * The chunk begins with the uncompressed size, the element size, and the number of blocks,
+ * followed by the compressed size of each block, so that the chunk can be decompressed
+ * without any other information.
+ */
+std::vector<unsigned char>
+compressLossless(void const *data, std::size_t size, std::size_t elementSize);
+
+/**
+ * Returns the number of bytes that the compressed chunk decompresses to.
+ */
+std::size_t losslessUncompressedSize(unsigned char const *chunk, std::size_t chunkSize);
+
+/**
+ * Decompresses a chunk created by compressLossless() into the memory pointed to by data.
+ * The size argument must equal the uncompressed size recorded in the chunk.
+ * Exits with an error if the chunk is corrupt.
+ */
+void decompressLossless(
+      unsigned char const *chunk,
+      std::size_t chunkSize,
+      void *data,
+      std::size_t size);
+
+} // End BufferUtils namespace
+} // End PV namespace
+#endif
@@ -26,11 +26,14 @@ typedef enum HeaderDataTypeEnum {
    FLOAT                 = 3,
    // datatype 4 is obsolete;
    TAUS_UINT4 = 5,
+   // Float data compressed without loss by BufferUtils::compressLossless(). Each frame's data
+   // is stored as one or more compressed chunks instead of as an array of dataSize-byte values.
+   LOSSLESS_FLOAT = 6,
 } HeaderDataType;
 
 // This structure is used to avoid having to traverse
-// a sparse pvp file from start to finish every time
-// we want to load data from it.
+// a sparse or LOSSLESS_FLOAT pvp file from start to finish
+// every time we want to load data from it.
 struct SparseFileTable {
    vector<long> frameStartOffsets;
    vector<long> frameLengths;
@@ -56,6 +59,21 @@ void writeFrame(FileStream &fStream, Buffer<T> *buffer, double timeStamp);
 template <typename T>
 double readFrame(FileStream &fStream, Buffer<T> *buffer);
 
+/**
+ * Writes a frame whose data are compressed without loss: the timestamp, the size in bytes of
+ * the compressed chunk as a 64-bit integer, and the chunk created by compressLossless().
+ * The file's header should have dataType LOSSLESS_FLOAT.
+ */
+template <typename T>
+void writeLosslessFrame(FileStream &fStream, Buffer<T> *buffer, double timeStamp);
+
+/**
+ * Reads a frame written by writeLosslessFrame. Returns the timestamp.
+ * Assumes that buffer is already the correct dimensions for the expected data.
+ */
+template <typename T>
+double readLosslessFrame(FileStream &fStream, Buffer<T> *buffer);
+
 template <typename T>
 double readFrameWindow(
       FileStream &fStream,
@@ -89,9 +107,9 @@ void appendToPvp(
  * Reads a frame from an activity layer of any activity file type into a buffer.
  * The buffer will be resized to the size indicated in the pvp file's header.
  * If the SparseFileTable pointer is null, it is ignored. If it is not null and
- * the path points to a sparse-binary or sparse-values activity file, the table
- * is used to speed navigation of the pvp file. If the SparseFileTable is empty
- * it is initialized.
+ * the path points to a sparse-binary or sparse-values activity file, or to a
+ * LOSSLESS_FLOAT file, the table is used to speed navigation of the pvp file.
+ * If the SparseFileTable is empty it is initialized.
  */
 template <typename T>
 double readActivityFromPvp(
@@ -102,10 +120,18 @@ double readActivityFromPvp(
 
 /**
  * Reads a frame from a nonspiking activity layer into a buffer. If the file type
- * is anything else, exits with an error.
+ * is anything else, exits with an error. The frames of a LOSSLESS_FLOAT file vary
+ * in size, so they are located through a table of frame offsets. If cachedTable
+ * is not null, the table is kept there: it is built for the whole file when the
+ * table is empty, and reused afterward. Otherwise the table is built up to the
+ * frame being read.
  */
 template <typename T>
-double readDenseFromPvp(const char *fName, Buffer<T> *buffer, int frameReadIndex);
+double readDenseFromPvp(
+      const char *fName,
+      Buffer<T> *buffer,
+      int frameReadIndex,
+      SparseFileTable *cachedTable = nullptr);
 
 template <typename T>
 void writeSparseFrame(FileStream &fStream, SparseList<T> *list, double timeStamp);
@@ -176,6 +202,7 @@ double readDenseFromSparseBinaryPvp(
 static void writeActivityHeader(FileStream &fStream, ActivityHeader const &header);
 static ActivityHeader readActivityHeader(FileStream &fStream);
 static SparseFileTable buildSparseFileTable(FileStream &fStream, int upToIndex);
+static SparseFileTable buildLosslessFileTable(FileStream &fStream, int upToIndex);
 
 template <typename T>
 std::size_t weightPatchSize(int numWeightsInPatch);
@@ -1,5 +1,7 @@
 #include "io/io.hpp"
+#include "utils/BufferUtilsCompress.hpp"
 #include "utils/conversions.h"
+#include <cstdint>
 #include <limits>
 
 namespace PV {
@@ -31,6 +33,31 @@ double readFrame(FileStream &fStream, Buffer<T> *buffer) {
    return timeStamp;
 }
 
+template <typename T>
+void writeLosslessFrame(FileStream &fStream, Buffer<T> *buffer, double timeStamp) {
+   std::vector<unsigned char> chunk = compressLossless(
+         buffer->asVector().data(), (std::size_t)buffer->getTotalElements() * sizeof(T), sizeof(T));
+   std::uint64_t chunkSize = (std::uint64_t)chunk.size();
+   fStream.write(&timeStamp, sizeof(double));
+   fStream.write(&chunkSize, sizeof(chunkSize));
+   fStream.write(chunk.data(), (long)chunk.size());
+}
+
+template <typename T>
+double readLosslessFrame(FileStream &fStream, Buffer<T> *buffer) {
+   double timeStamp;
+   std::uint64_t chunkSize;
+   fStream.read(&timeStamp, sizeof(double));
+   fStream.read(&chunkSize, sizeof(chunkSize));
+   std::vector<unsigned char> chunk((std::size_t)chunkSize);
+   fStream.read(chunk.data(), (long)chunkSize);
+
+   vector<T> data(buffer->getTotalElements());
+   decompressLossless(chunk.data(), chunk.size(), data.data(), data.size() * sizeof(T));
+   buffer->set(data, buffer->getWidth(), buffer->getHeight(), buffer->getFeatures());
+   return timeStamp;
+}
+
 template <typename T>
 double readFrameWindow(
       FileStream &fStream,
@@ -232,7 +259,8 @@ double readActivityFromPvp(
    }
    switch (fileType) {
       case PVP_NONSPIKING_ACT_FILE_TYPE:
-         timestamp = BufferUtils::readDenseFromPvp<T>(fName, buffer, frameReadIndex);
+         timestamp =
+               BufferUtils::readDenseFromPvp<T>(fName, buffer, frameReadIndex, sparseFileTable);
          break;
       case PVP_ACT_SPARSEVALUES_FILE_TYPE:
          timestamp = BufferUtils::readDenseFromSparsePvp<T>(
@@ -254,7 +282,11 @@ double readActivityFromPvp(
 }
 
 template <typename T>
-double readDenseFromPvp(const char *fName, Buffer<T> *buffer, int frameReadIndex) {
+double readDenseFromPvp(
+      const char *fName,
+      Buffer<T> *buffer,
+      int frameReadIndex,
+      SparseFileTable *cachedTable) {
    FileStream fStream(fName, std::ios_base::in | std::ios_base::binary, false);
    ActivityHeader header = readActivityHeader(fStream);
    FatalIf(
@@ -263,7 +295,27 @@ double readDenseFromPvp(const char *fName, Buffer<T> *buffer, int frameReadIndex
          "(PVP_NONSPIKING_ACT_FILE_TYPE)\n");
    FatalIf(header.nBands <= 0, "\"%s\" header does not have a positive nbands field.\n", fName);
    buffer->resize(header.nx, header.ny, header.nf);
-   int frameIndex   = frameReadIndex % header.nBands;
+   int frameIndex = frameReadIndex % header.nBands;
+   if (header.dataType == LOSSLESS_FLOAT) {
+      FatalIf(
+            header.dataSize != (int)sizeof(T),
+            "\"%s\" has dataSize %d, but is being read into a buffer of %d-byte values.\n",
+            fName,
+            header.dataSize,
+            (int)sizeof(T));
+      // Compressed frames vary in size; find the frame in a table of frame offsets.
+      SparseFileTable table;
+      SparseFileTable const *frameTable = cachedTable;
+      if (cachedTable == nullptr) {
+         table      = buildLosslessFileTable(fStream, frameIndex);
+         frameTable = &table;
+      }
+      else if (cachedTable->frameStartOffsets.empty()) {
+         *cachedTable = buildLosslessFileTable(fStream, header.nBands - 1);
+      }
+      fStream.setInPos(frameTable->frameStartOffsets.at(frameIndex), true);
+      return readLosslessFrame<T>(fStream, buffer);
+   }
    long frameOffset = frameIndex * (header.recordSize * header.dataSize + sizeof(double));
    fStream.setInPos(frameOffset, false);
    return readFrame<T>(fStream, buffer);
@@ -359,6 +411,36 @@ static SparseFileTable buildSparseFileTable(FileStream &fStream, int upToIndex)
    return result;
 }
 
+// Builds a table of offsets and compressed lengths for each frame
+// of a LOSSLESS_FLOAT pvp file, up to and including upToIndex,
+// in a single pass over the frames.
+static SparseFileTable buildLosslessFileTable(FileStream &fStream, int upToIndex) {
+   ActivityHeader header = readActivityHeader(fStream);
+   FatalIf(
+         upToIndex >= header.nBands,
+         "buildLosslessFileTable requested frame %d / %d.\n",
+         upToIndex,
+         header.nBands);
+
+   SparseFileTable result;
+   result.valuesIncluded = true;
+   result.frameLengths.resize(upToIndex + 1, 0);
+   result.frameStartOffsets.resize(upToIndex + 1, 0);
+
+   for (int f = 0; f < upToIndex + 1; ++f) {
+      std::uint64_t chunkSize = 0;
+      long frameStartOffset   = fStream.getInPos();
+      fStream.setInPos((long)sizeof(double), false);
+      fStream.read(&chunkSize, sizeof(chunkSize));
+      result.frameLengths.at(f)      = (long)chunkSize;
+      result.frameStartOffsets.at(f) = frameStartOffset;
+      if (f < upToIndex) {
+         fStream.setInPos((long)chunkSize, false);
+      }
+   }
+   return result;
+}
+
 template <typename T>
 void writeSparseToPvp(
       const char *fName,
@@ -422,14 +504,16 @@ double readSparseFromPvp(
          header.dataSize);
 
    SparseFileTable table;
+   SparseFileTable const *frameTable = cachedTable;
    if (cachedTable == nullptr) {
-      table = buildSparseFileTable(fStream, frameReadIndex);
+      table      = buildSparseFileTable(fStream, frameReadIndex);
+      frameTable = &table;
    }
-   else {
-      table = *cachedTable;
+   else if (cachedTable->frameStartOffsets.empty()) {
+      *cachedTable = buildSparseFileTable(fStream, header.nBands - 1);
    }
 
-   long frameOffset = table.frameStartOffsets.at(frameReadIndex);
+   long frameOffset = frameTable->frameStartOffsets.at(frameReadIndex);
    fStream.setInPos(frameOffset, true);
    return readSparseFrame<T>(fStream, list);
 }
@@ -473,14 +557,16 @@ double readSparseBinaryFromPvp(
          header.dataSize);
 
    SparseFileTable table;
+   SparseFileTable const *frameTable = cachedTable;
    if (cachedTable == nullptr) {
-      table = buildSparseFileTable(fStream, frameReadIndex);
+      table      = buildSparseFileTable(fStream, frameReadIndex);
+      frameTable = &table;
    }
-   else {
-      table = *cachedTable;
+   else if (cachedTable->frameStartOffsets.empty()) {
+      *cachedTable = buildSparseFileTable(fStream, header.nBands - 1);
    }
 
-   long frameOffset = table.frameStartOffsets.at(frameReadIndex);
+   long frameOffset = frameTable->frameStartOffsets.at(frameReadIndex);
    fStream.setInPos(frameOffset, true);
    return readSparseBinaryFrame<T>(fStream, list, oneVal);
 }
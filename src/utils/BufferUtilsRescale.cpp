@@ -1,7 +1,9 @@
 #include "BufferUtilsRescale.hpp"
+#include "cMakeHeader.h"
 #include "conversions.h"
+#include "utils/PVAssert.hpp"
 #include <cmath>
-#include <cstring>
+#include <vector>
 
 namespace PV {
 namespace BufferUtils {
@@ -13,6 +15,36 @@ inline static float bicubic(float x) {
                                                               : 0;
 }
 
+// The four source coordinates and bicubic weights that contribute to one output coordinate.
+// Coordinates beyond the edge of the source are reflected back into it.
+struct BicubicTaps {
+   int index[4];
+   float weight[4];
+};
+
+std::vector<BicubicTaps> computeBicubicTaps(int sizeIn, int sizeOut) {
+   std::vector<BicubicTaps> taps(sizeOut);
+   float d = (float)(sizeIn - 1) / (float)(sizeOut - 1);
+   for (int k = 0; k < sizeOut; k++) {
+      float x      = d * (float)k;
+      float xfloor = floorf(x);
+      int xinteger = (int)xfloor;
+      float xfrac  = x - xfloor;
+      for (int t = 0; t < 4; t++) {
+         int offset = t - 1;
+         int fetch  = xinteger + offset;
+         if (fetch < 0)
+            fetch = -fetch;
+         if (fetch >= sizeIn)
+            fetch = sizeIn - (fetch - sizeIn) - 1;
+         pvAssert(fetch >= 0 && fetch < sizeIn);
+         taps[k].index[t]  = fetch;
+         taps[k].weight[t] = bicubic(xfrac - (float)offset);
+      }
+   }
+   return taps;
+}
+
 void nearestNeighborInterp(
       float const *bufferIn,
       int widthIn,
@@ -26,7 +58,7 @@ void nearestNeighborInterp(
       int heightOut) {
 
    /* Interpolation using nearest neighbor interpolation */
-   int xinteger[widthOut];
+   std::vector<int> xinteger(widthOut);
    float dx = (float)(widthIn - 1) / (float)(widthOut - 1);
 
    for (int kx = 0; kx < widthOut; kx++) {
@@ -34,7 +66,7 @@ void nearestNeighborInterp(
       xinteger[kx] = (int)nearbyintf(x);
    }
 
-   int yinteger[heightOut];
+   std::vector<int> yinteger(heightOut);
    float dy = (float)(heightIn - 1) / (float)(heightOut - 1);
 
    for (int ky = 0; ky < heightOut; ky++) {
@@ -42,92 +74,120 @@ void nearestNeighborInterp(
       yinteger[ky] = (int)nearbyintf(y);
    }
 
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(static)
+#endif
    for (int ky = 0; ky < heightOut; ky++) {
-      float yfetch = yinteger[ky];
+      float const *rowIn = &bufferIn[yinteger[ky] * yStrideIn];
+      float *rowOut      = &bufferOut[kIndex(0, ky, 0, widthOut, heightOut, numBands)];
       for (int kx = 0; kx < widthOut; kx++) {
-         int xfetch = xinteger[kx];
+         float const *pixelIn = &rowIn[xinteger[kx] * xStrideIn];
+         float *pixelOut      = &rowOut[kx * numBands];
          for (int f = 0; f < numBands; f++) {
-            int fetchIdx         = yfetch * yStrideIn + xfetch * xStrideIn + f * bandStrideIn;
-            int outputIdx        = kIndex(kx, ky, f, widthOut, heightOut, numBands);
-            bufferOut[outputIdx] = bufferIn[fetchIdx];
+            pixelOut[f] = pixelIn[f * bandStrideIn];
          }
       }
    }
 }
 
+// The input is in the layout that kIndex() describes: features, then columns, then rows.
 void bicubicInterp(
       float const *bufferIn,
       int widthIn,
       int heightIn,
       int numBands,
-      int xStrideIn,
-      int yStrideIn,
-      int bandStrideIn,
       float *bufferOut,
       int widthOut,
       int heightOut) {
 
    // Interpolation using bicubic convolution with a = -1
    // (following Octave image toolbox's imremap function - change this?)
-   float xinterp[widthOut];
-   int xinteger[widthOut];
-   float xfrac[widthOut];
-   float dx = (float)(widthIn - 1) / (float)(widthOut - 1);
-
-   for (int kx = 0; kx < widthOut; kx++) {
-      float x      = dx * (float)kx;
-      xinterp[kx]  = x;
-      float xfloor = floorf(x);
-      xinteger[kx] = (int)xfloor;
-      xfrac[kx]    = x - xfloor;
-   }
+   // The kernel is separable, so each output row is interpolated from four input rows, and then
+   // along that row. The weights are the same for every feature, so they are computed once for
+   // each output row and column beforehand. The first pass runs over contiguous input rows, which
+   // vectorizes well; the second only touches the output row's four columns per pixel.
+   std::vector<BicubicTaps> xTaps = computeBicubicTaps(widthIn, widthOut);
+   std::vector<BicubicTaps> yTaps = computeBicubicTaps(heightIn, heightOut);
+   int const rowSizeIn            = widthIn * numBands;
 
-   float yinterp[heightOut];
-   int yinteger[heightOut];
-   float yfrac[heightOut];
-   float dy = (float)(heightIn - 1) / (float)(heightOut - 1);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel
+#endif
+   {
+      // Each thread interpolates its rows through its own scratch row.
+      std::vector<float> row(rowSizeIn);
+      float *rowData = row.data();
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp for schedule(static)
+#endif
+      for (int ky = 0; ky < heightOut; ky++) {
+         BicubicTaps const &yTap = yTaps[ky];
+         float const *r0         = &bufferIn[yTap.index[0] * rowSizeIn];
+         float const *r1         = &bufferIn[yTap.index[1] * rowSizeIn];
+         float const *r2         = &bufferIn[yTap.index[2] * rowSizeIn];
+         float const *r3         = &bufferIn[yTap.index[3] * rowSizeIn];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+         for (int k = 0; k < rowSizeIn; k++) {
+            rowData[k] = yTap.weight[0] * r0[k] + yTap.weight[1] * r1[k] + yTap.weight[2] * r2[k]
+                         + yTap.weight[3] * r3[k];
+         }
 
-   for (int ky = 0; ky < heightOut; ky++) {
-      float y      = dy * (float)ky;
-      yinterp[ky]  = y;
-      float yfloor = floorf(y);
-      yinteger[ky] = (int)yfloor;
-      yfrac[ky]    = y - yfloor;
+         float *rowOut = &bufferOut[kIndex(0, ky, 0, widthOut, heightOut, numBands)];
+         for (int kx = 0; kx < widthOut; kx++) {
+            BicubicTaps const &xTap = xTaps[kx];
+            float const *p0         = &rowData[xTap.index[0] * numBands];
+            float const *p1         = &rowData[xTap.index[1] * numBands];
+            float const *p2         = &rowData[xTap.index[2] * numBands];
+            float const *p3         = &rowData[xTap.index[3] * numBands];
+            float *pixelOut         = &rowOut[kx * numBands];
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp simd
+#endif
+            for (int f = 0; f < numBands; f++) {
+               pixelOut[f] = xTap.weight[0] * p0[f] + xTap.weight[1] * p1[f]
+                             + xTap.weight[2] * p2[f] + xTap.weight[3] * p3[f];
+            }
+         }
+      }
    }
+}
 
-   memset(bufferOut, 0, sizeof(*bufferOut) * size_t(widthOut * heightOut * numBands));
-
-   for (int xOff = 2; xOff > -2; xOff--) {
-      for (int yOff = 2; yOff > -2; yOff--) {
-         for (int ky = 0; ky < heightOut; ky++) {
-            float ycoeff = bicubic(yfrac[ky] - (float)yOff);
-            int yfetch   = yinteger[ky] + yOff;
-
-            if (yfetch < 0)
-               yfetch = -yfetch;
-            if (yfetch >= heightIn)
-               yfetch = heightIn - (yfetch - heightIn) - 1;
-
-            for (int kx = 0; kx < widthOut; kx++) {
-               float xcoeff = bicubic(xfrac[kx] - (float)xOff);
-               int xfetch   = xinteger[kx] + xOff;
+// The size that rescale() resizes a width-by-height buffer to before cropping or padding it to
+// newWidth-by-newHeight.
+void computeResizedSize(
+      int width,
+      int height,
+      int newWidth,
+      int newHeight,
+      enum RescaleMethod rescaleMethod,
+      int *resizedWidth,
+      int *resizedHeight) {
+   float xRatio       = (float)newWidth / width;
+   float yRatio       = (float)newHeight / height;
+   float resizeFactor = 1.0f;
 
-               if (xfetch < 0)
-                  xfetch = -xfetch;
-               if (xfetch >= widthIn)
-                  xfetch = widthIn - (xfetch - widthIn) - 1;
+   switch (rescaleMethod) {
+      case CROP: resizeFactor = xRatio < yRatio ? yRatio : xRatio; break;
+      case PAD: resizeFactor  = xRatio < yRatio ? xRatio : yRatio; break;
+   }
 
-               assert(xfetch >= 0 && xfetch < widthIn && yfetch >= 0 && yfetch < heightIn);
+   *resizedWidth  = (int)nearbyintf(resizeFactor * width);
+   *resizedHeight = (int)nearbyintf(resizeFactor * height);
+}
 
-               for (int f = 0; f < numBands; f++) {
-                  int fetchIdx  = yfetch * yStrideIn + xfetch * xStrideIn + f * bandStrideIn;
-                  float p       = bufferIn[fetchIdx];
-                  int outputIdx = kIndex(kx, ky, f, widthOut, heightOut, numBands);
-                  bufferOut[outputIdx] += xcoeff * ycoeff * p;
-               }
-            }
-         }
-      }
+// Crops or pads a resized buffer to newWidth-by-newHeight.
+void fitResizedBuffer(
+      Buffer<float> &buffer,
+      int newWidth,
+      int newHeight,
+      enum RescaleMethod rescaleMethod,
+      enum Buffer<float>::Anchor anchor) {
+   // If our rescaleMethod was PAD, this actually grows the buffer to include the padded region.
+   switch (rescaleMethod) {
+      case CROP: buffer.crop(newWidth, newHeight, anchor); break;
+      case PAD: buffer.grow(newWidth, newHeight, anchor); break;
    }
 }
 } // End anonymous namespace
@@ -140,19 +200,15 @@ void rescale(
       enum RescaleMethod rescaleMethod,
       enum InterpolationMethod interpMethod,
       enum Buffer<float>::Anchor anchor) {
-   float xRatio       = (float)newWidth / buffer.getWidth();
-   float yRatio       = (float)newHeight / buffer.getHeight();
-   int resizedWidth   = newWidth;
-   int resizedHeight  = newHeight;
-   float resizeFactor = 1.0f;
-
-   switch (rescaleMethod) {
-      case CROP: resizeFactor = xRatio < yRatio ? yRatio : xRatio; break;
-      case PAD: resizeFactor  = xRatio < yRatio ? xRatio : yRatio; break;
-   }
-
-   resizedWidth  = (int)nearbyintf(resizeFactor * buffer.getWidth());
-   resizedHeight = (int)nearbyintf(resizeFactor * buffer.getHeight());
+   int resizedWidth, resizedHeight;
+   computeResizedSize(
+         buffer.getWidth(),
+         buffer.getHeight(),
+         newWidth,
+         newHeight,
+         rescaleMethod,
+         &resizedWidth,
+         &resizedHeight);
 
    std::vector<float> rawInput = buffer.asVector();
    std::vector<float> scaledInput(resizedWidth * resizedHeight * buffer.getFeatures());
@@ -163,9 +219,6 @@ void rescale(
                buffer.getWidth(),
                buffer.getHeight(),
                buffer.getFeatures(),
-               buffer.getFeatures(),
-               buffer.getFeatures() * buffer.getWidth(),
-               1,
                scaledInput.data(),
                resizedWidth,
                resizedHeight);
@@ -187,12 +240,25 @@ void rescale(
    buffer.set(scaledInput, resizedWidth, resizedHeight, buffer.getFeatures());
 
    // This final call resizes the buffer to our specified
-   // newWidth and newHeight. If our rescaleMethod was PAD,
-   // this actually grows the buffer to include the padded region.
-   switch (rescaleMethod) {
-      case CROP: buffer.crop(newWidth, newHeight, anchor); break;
-      case PAD: buffer.grow(newWidth, newHeight, anchor); break;
-   }
+   // newWidth and newHeight.
+   fitResizedBuffer(buffer, newWidth, newHeight, rescaleMethod, anchor);
+}
+
+Buffer<float> rescaledRegion(
+      int width,
+      int height,
+      int features,
+      int newWidth,
+      int newHeight,
+      enum RescaleMethod rescaleMethod,
+      enum Buffer<float>::Anchor anchor) {
+   int resizedWidth, resizedHeight;
+   computeResizedSize(
+         width, height, newWidth, newHeight, rescaleMethod, &resizedWidth, &resizedHeight);
+   std::vector<float> ones(resizedWidth * resizedHeight * features, 1.0f);
+   Buffer<float> region(ones, resizedWidth, resizedHeight, features);
+   fitResizedBuffer(region, newWidth, newHeight, rescaleMethod, anchor);
+   return region;
 }
 } // End BufferUtils namespace
 } // End PV namespace
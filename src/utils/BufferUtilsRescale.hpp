@@ -18,6 +18,21 @@ void rescale(
       enum InterpolationMethod interpMethod,
       enum Buffer<float>::Anchor anchor);
 
+/**
+ * Returns the input region of a width-by-height image after rescale() with the same arguments:
+ * a newWidth-by-newHeight buffer that is one on the pixels of the rescaled image and zero on any
+ * padding. This is what rescaling a buffer of ones gives, up to rounding, but the region is
+ * computed directly instead of interpolated.
+ */
+Buffer<float> rescaledRegion(
+      int width,
+      int height,
+      int features,
+      int newWidth,
+      int newHeight,
+      enum RescaleMethod rescaleMethod,
+      enum Buffer<float>::Anchor anchor);
+
 } // End BufferUtils namespace
 } // End PV namespace
 #endif
@@ -0,0 +1,131 @@
+#include "MemoryTracker.hpp"
+#include "utils/PVLog.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace PV {
+
+namespace {
+
+std::string formatMiB(std::size_t bytes) {
+   char buffer[32];
+   std::snprintf(buffer, sizeof(buffer), "%.3f MiB", (double)bytes / 1048576.0);
+   return std::string(buffer);
+}
+
+bool compareOwnerSizes(
+      std::pair<std::size_t, std::string> const &a,
+      std::pair<std::size_t, std::string> const &b) {
+   return a.first > b.first or (a.first == b.first and a.second < b.second);
+}
+
+} // namespace
+
+void MemoryTracker::allocate(
+      std::string const &owner,
+      std::string const &category,
+      std::size_t bytes) {
+   std::lock_guard<std::mutex> lock(mMutex);
+   mAllocations[owner][category] += bytes;
+   mCurrentBytes += bytes;
+   mPeakBytes = std::max(mPeakBytes, mCurrentBytes);
+   if (mBudget > 0U and mCurrentBytes > mBudget) {
+      std::string const report = formatReportLocked();
+      Fatal().printf(
+            "Allocating %s for %s of \"%s\" exceeds the memory budget of %s.\n%s",
+            formatMiB(bytes).c_str(),
+            category.c_str(),
+            owner.c_str(),
+            formatMiB(mBudget).c_str(),
+            report.c_str());
+   }
+}
+
+void MemoryTracker::release(
+      std::string const &owner,
+      std::string const &category,
+      std::size_t bytes) {
+   std::lock_guard<std::mutex> lock(mMutex);
+   auto ownerFound = mAllocations.find(owner);
+   if (ownerFound == mAllocations.end()) {
+      return;
+   }
+   auto categoryFound = ownerFound->second.find(category);
+   if (categoryFound == ownerFound->second.end()) {
+      return;
+   }
+   std::size_t const released = std::min(bytes, categoryFound->second);
+   categoryFound->second -= released;
+   mCurrentBytes -= released;
+   if (categoryFound->second == 0U) {
+      ownerFound->second.erase(categoryFound);
+   }
+   if (ownerFound->second.empty()) {
+      mAllocations.erase(ownerFound);
+   }
+}
+
+void MemoryTracker::releaseOwner(std::string const &owner) {
+   std::lock_guard<std::mutex> lock(mMutex);
+   auto ownerFound = mAllocations.find(owner);
+   if (ownerFound == mAllocations.end()) {
+      return;
+   }
+   for (auto const &c : ownerFound->second) {
+      mCurrentBytes -= c.second;
+   }
+   mAllocations.erase(ownerFound);
+}
+
+void MemoryTracker::setBudget(std::size_t bytes) {
+   std::lock_guard<std::mutex> lock(mMutex);
+   mBudget = bytes;
+}
+
+std::size_t MemoryTracker::getOwnerBytes(std::string const &owner) const {
+   std::lock_guard<std::mutex> lock(mMutex);
+   std::size_t total = 0U;
+   auto ownerFound   = mAllocations.find(owner);
+   if (ownerFound != mAllocations.end()) {
+      for (auto const &c : ownerFound->second) {
+         total += c.second;
+      }
+   }
+   return total;
+}
+
+std::string MemoryTracker::formatReport() const {
+   std::lock_guard<std::mutex> lock(mMutex);
+   return formatReportLocked();
+}
+
+std::string MemoryTracker::formatReportLocked() const {
+   std::vector<std::pair<std::size_t, std::string>> ownerSizes;
+   for (auto const &a : mAllocations) {
+      std::size_t total = 0U;
+      for (auto const &c : a.second) {
+         total += c.second;
+      }
+      ownerSizes.emplace_back(total, a.first);
+   }
+   std::sort(ownerSizes.begin(), ownerSizes.end(), compareOwnerSizes);
+
+   std::string report("Memory allocated by object:\n");
+   for (auto const &o : ownerSizes) {
+      report.append("   ").append(formatMiB(o.first)).append("  \"").append(o.second).append("\"");
+      char const *separator = ": ";
+      for (auto const &c : mAllocations.at(o.second)) {
+         report.append(separator).append(c.first).append(" ").append(formatMiB(c.second));
+         separator = ", ";
+      }
+      report.append("\n");
+   }
+   report.append("   total ").append(formatMiB(mCurrentBytes));
+   report.append(", high-water mark ").append(formatMiB(mPeakBytes)).append("\n");
+   return report;
+}
+
+} // namespace PV
@@ -0,0 +1,74 @@
+#ifndef MEMORYTRACKER_HPP_
+#define MEMORYTRACKER_HPP_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace PV {
+
+/**
+ * Attributes the large allocations of a run to the objects that own them. Each allocation is
+ * recorded under the name of its owning object (a layer, or a connection and its components)
+ * and a category such as "weights" or "data store". The tracker keeps the current total and
+ * its high-water mark, and can format a report of the allocations, largest object first.
+ *
+ * If a budget is set, an allocation that takes the current total above it is a fatal error,
+ * and the error message includes the report, so that the object responsible is visible before
+ * the operating system runs out of memory. Only allocations recorded with the tracker count
+ * against the budget; the process as a whole uses more.
+ *
+ * There is one tracker per process. The destructors of HyPerLayer and BaseConnection release
+ * everything recorded under the object's name by calling releaseOwner(); other objects that
+ * record allocations must release them themselves.
+ */
+class MemoryTracker {
+  public:
+   static MemoryTracker *instance() {
+      static MemoryTracker *singleton = new MemoryTracker();
+      return singleton;
+   }
+
+   /**
+    * Records an allocation of the given size. If a budget is set and the allocation takes the
+    * current total above it, exits with an error that lists the allocations.
+    */
+   void allocate(std::string const &owner, std::string const &category, std::size_t bytes);
+
+   /** Records a deallocation. The amount recorded for the owner and category stops at zero. */
+   void release(std::string const &owner, std::string const &category, std::size_t bytes);
+
+   /** Releases everything recorded under the given owner. */
+   void releaseOwner(std::string const &owner);
+
+   /** Sets the budget, in bytes. Zero, the default, means there is no budget. */
+   void setBudget(std::size_t bytes);
+
+   std::size_t getBudget() const { return mBudget; }
+   std::size_t getCurrentBytes() const { return mCurrentBytes; }
+   std::size_t getPeakBytes() const { return mPeakBytes; }
+
+   /** Returns the number of bytes currently recorded under the given owner, in all categories. */
+   std::size_t getOwnerBytes(std::string const &owner) const;
+
+   /**
+    * Returns a report of the current allocations: one line per owner, in decreasing order of
+    * size, with the owner's categories, followed by the total and the high-water mark.
+    */
+   std::string formatReport() const;
+
+  private:
+   MemoryTracker() {}
+   std::string formatReportLocked() const;
+
+   mutable std::mutex mMutex;
+   std::map<std::string, std::map<std::string, std::size_t>> mAllocations;
+   std::size_t mCurrentBytes = 0U;
+   std::size_t mPeakBytes    = 0U;
+   std::size_t mBudget       = 0U;
+};
+
+} // namespace PV
+
+#endif // MEMORYTRACKER_HPP_
@@ -0,0 +1,78 @@
+#include "MetricsRegistry.hpp"
+#include "utils/PVLog.hpp"
+
+namespace PV {
+
+MetricsRegistry::MetricsRegistry(MPI_Comm comm) : mComm(comm) {}
+
+MetricsRegistry::~MetricsRegistry() { delete mOutputStream; }
+
+PerformanceCounters *
+MetricsRegistry::addCounters(std::string const &objectName, std::string const &objectType) {
+   std::unique_ptr<Entry> entry(new Entry);
+   entry->mObjectName = objectName;
+   entry->mObjectType = objectType;
+   PerformanceCounters *counters = &entry->mCounters;
+   mEntries.push_back(std::move(entry));
+   return counters;
+}
+
+void MetricsRegistry::write(std::string const &path, double simTime) {
+   int rank;
+   MPI_Comm_rank(mComm, &rank);
+
+   // The MPI stub used when PV_USE_MPI is off has no 64-bit integer type, so the counters are
+   // reduced as doubles. Doubles hold integers exactly up to 2^53, far beyond one interval's count.
+   int const numEntries = (int)mEntries.size();
+   std::vector<double> sums(4 * numEntries);
+   std::vector<double> maxes(2 * numEntries);
+   for (int n = 0; n < numEntries; n++) {
+      PerformanceCounters const &c    = mEntries[n]->mCounters;
+      PerformanceCounters const &last = mEntries[n]->mLastWritten;
+      sums[4 * n + 0]                 = (double)(c.mSynapticOps - last.mSynapticOps);
+      sums[4 * n + 1]                 = (double)(c.mActiveNeurons - last.mActiveNeurons);
+      sums[4 * n + 2]                 = (double)(c.mBytesMoved - last.mBytesMoved);
+      sums[4 * n + 3]                 = (double)(c.mHaloBytes - last.mHaloBytes);
+      maxes[2 * n + 0]                = (double)(c.mMPIWaitTime - last.mMPIWaitTime) * 1.0e-9;
+      maxes[2 * n + 1]                = (double)(c.mComputeTime - last.mComputeTime) * 1.0e-9;
+      mEntries[n]->mLastWritten       = c;
+   }
+   if (rank == 0) {
+      MPI_Reduce(MPI_IN_PLACE, sums.data(), 4 * numEntries, MPI_DOUBLE, MPI_SUM, 0, mComm);
+      MPI_Reduce(MPI_IN_PLACE, maxes.data(), 2 * numEntries, MPI_DOUBLE, MPI_MAX, 0, mComm);
+   }
+   else {
+      MPI_Reduce(sums.data(), nullptr, 4 * numEntries, MPI_DOUBLE, MPI_SUM, 0, mComm);
+      MPI_Reduce(maxes.data(), nullptr, 2 * numEntries, MPI_DOUBLE, MPI_MAX, 0, mComm);
+   }
+   if (rank != 0) {
+      return;
+   }
+
+   if (mOutputStream == nullptr) {
+      mOutputStream = new FileStream(path.c_str(), std::ios_base::out);
+      mOutputStream->printf(
+            "time,name,type,synapticOps,activeNeurons,bytesMoved,haloBytes,"
+            "mpiWaitSeconds,computeSeconds,gflops\n");
+   }
+   for (int n = 0; n < numEntries; n++) {
+      Entry const &entry    = *mEntries[n];
+      double computeSeconds = maxes[2 * n + 1];
+      double gflops         = computeSeconds > 0.0 ? 2.0e-9 * sums[4 * n] / computeSeconds : 0.0;
+      mOutputStream->printf(
+            "%g,%s,%s,%.0f,%.0f,%.0f,%.0f,%.9f,%.9f,%.6f\n",
+            simTime,
+            entry.mObjectName.c_str(),
+            entry.mObjectType.c_str(),
+            sums[4 * n + 0],
+            sums[4 * n + 1],
+            sums[4 * n + 2],
+            sums[4 * n + 3],
+            maxes[2 * n + 0],
+            computeSeconds,
+            gflops);
+   }
+   mOutputStream->flush();
+}
+
+} // namespace PV
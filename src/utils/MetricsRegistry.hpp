@@ -0,0 +1,81 @@
+#ifndef METRICSREGISTRY_HPP_
+#define METRICSREGISTRY_HPP_
+
+#include "arch/mpi/mpi.h"
+#include "io/FileStream.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * The performance counters that one object reports into a MetricsRegistry. Objects add to the
+ * counters as they work, and the counters accumulate over the whole run, so that other code
+ * (for example the --benchmark run mode) can take the difference of two readings.
+ * The counters are not atomic, so they must be updated outside of OpenMP parallel regions.
+ */
+struct PerformanceCounters {
+   std::uint64_t mSynapticOps   = 0U; // multiply-accumulate operations, one per synapse used
+   std::uint64_t mActiveNeurons = 0U; // presynaptic neurons that contributed to a delivery
+   std::uint64_t mBytesMoved    = 0U; // estimated bytes of weights, activity and GSyn touched
+   std::uint64_t mHaloBytes     = 0U; // bytes sent to other processes: halos and reductions
+   std::uint64_t mMPIWaitTime   = 0U; // nanoseconds spent waiting for MPI requests to complete
+   std::uint64_t mComputeTime   = 0U; // nanoseconds spent doing the object's work
+   std::uint64_t mNeuronUpdates = 0U; // neurons updated by a layer, over all batch elements
+
+   void clear() { *this = PerformanceCounters(); }
+};
+
+/**
+ * Holds a set of PerformanceCounters, one for each (name, type) pair registered by an object,
+ * and writes them as a time series in CSV format. Each call to write() reduces the counters
+ * across all the processes of the communicator and appends one row per registered counter set
+ * to the output file. Each row holds the change in the counters since the previous write, so
+ * that it covers the interval since then.
+ *
+ * Counts and bytes are summed over processes. Times are the maximum over processes, since the
+ * slowest process determines the run time. The gflops column is two floating-point operations
+ * per synaptic operation, divided by the compute time.
+ *
+ * All processes must register the same counter sets in the same order, which holds because each
+ * process builds the same objects from the same params file.
+ */
+class MetricsRegistry {
+  public:
+   MetricsRegistry(MPI_Comm comm);
+   ~MetricsRegistry();
+
+   /**
+    * Returns a pointer to a new set of counters for the given object. The pointer remains valid
+    * for the lifetime of the registry.
+    */
+   PerformanceCounters *addCounters(std::string const &objectName, std::string const &objectType);
+
+   /**
+    * Reduces the change in the counters since the previous write across processes, and writes
+    * one row per counter set to the given path. The file is created, with a header line, on the
+    * first call.
+    * This function must be called by all processes in the communicator.
+    */
+   void write(std::string const &path, double simTime);
+
+   std::size_t getNumCounterSets() const { return mEntries.size(); }
+
+  private:
+   struct Entry {
+      std::string mObjectName;
+      std::string mObjectType;
+      PerformanceCounters mCounters;
+      PerformanceCounters mLastWritten;
+   };
+
+   MPI_Comm mComm;
+   std::vector<std::unique_ptr<Entry>> mEntries;
+   FileStream *mOutputStream = nullptr;
+};
+
+} // namespace PV
+
+#endif // METRICSREGISTRY_HPP_
@@ -1,4 +1,5 @@
 #include "PVAlloc.hpp"
+#include "utils/MemoryTracker.hpp"
 #include "utils/PVLog.hpp"
 #include <stdarg.h>
 #include <stdio.h>
@@ -50,4 +51,16 @@ void *pv_calloc(const char *file, int line, size_t count, size_t size, const cha
    }
    return ptr;
 }
+
+void *pv_calloc_tracked(
+      const char *file,
+      int line,
+      const char *owner,
+      const char *category,
+      size_t count,
+      size_t size) {
+   void *ptr = pv_calloc(file, line, count, size);
+   MemoryTracker::instance()->allocate(owner, category, count * size);
+   return ptr;
+}
 }
@@ -48,6 +48,14 @@
  */
 #define pvCallocError(count, size, fmt, ...)                                                       \
    PV::pv_calloc(__FILE__, __LINE__, count, size, fmt, ##__VA_ARGS__)
+/**
+ * pvCallocTracked(owner, category, count, size)
+ *
+ * Like pvCalloc, but also records the allocation with the MemoryTracker, under the given owner
+ * name and category.
+ */
+#define pvCallocTracked(owner, category, count, size)                                              \
+   PV::pv_calloc_tracked(__FILE__, __LINE__, owner, category, count, size)
 /**
  * Wraps a call to delete
  *
@@ -61,6 +69,13 @@ void *pv_malloc(const char *file, int line, size_t size);
 void *pv_malloc(const char *file, int line, size_t size, const char *fmt, ...);
 void *pv_calloc(const char *file, int line, size_t count, size_t size);
 void *pv_calloc(const char *file, int line, size_t count, size_t size, const char *fmt, ...);
+void *pv_calloc_tracked(
+      const char *file,
+      int line,
+      const char *owner,
+      const char *category,
+      size_t count,
+      size_t size);
 
 template <typename T>
 void pv_delete(const char *file, int line, T *ptr) {
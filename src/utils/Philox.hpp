@@ -0,0 +1,48 @@
+#ifndef PHILOX_HPP_
+#define PHILOX_HPP_
+
+#include <cstdint>
+
+namespace PV {
+
+/**
+ * The Philox4x32-10 generator of Salmon, Moraes, Dror and Shaw, "Parallel random numbers: as easy
+ * as 1, 2, 3" (SC '11). It is a keyed bijection of 128-bit counters: the four 32-bit words of
+ * result are random functions of the four words of counter and the two words of key. It has no
+ * state, so a number can be computed from its counter alone, in any order and on any process;
+ * and the loop body has no branches, so the compiler can vectorize loops over counters.
+ */
+inline void
+philox4x32(std::uint32_t const counter[4], std::uint32_t const key[2], std::uint32_t result[4]) {
+   std::uint32_t c0 = counter[0];
+   std::uint32_t c1 = counter[1];
+   std::uint32_t c2 = counter[2];
+   std::uint32_t c3 = counter[3];
+   std::uint32_t k0 = key[0];
+   std::uint32_t k1 = key[1];
+   for (int round = 0; round < 10; round++) {
+      std::uint64_t const product0 = (std::uint64_t)0xD2511F53U * (std::uint64_t)c0;
+      std::uint64_t const product1 = (std::uint64_t)0xCD9E8D57U * (std::uint64_t)c2;
+      std::uint32_t const next0    = (std::uint32_t)(product1 >> 32) ^ c1 ^ k0;
+      std::uint32_t const next2    = (std::uint32_t)(product0 >> 32) ^ c3 ^ k1;
+      c1                           = (std::uint32_t)product1;
+      c3                           = (std::uint32_t)product0;
+      c0                           = next0;
+      c2                           = next2;
+      k0 += 0x9E3779B9U;
+      k1 += 0xBB67AE85U;
+   }
+   result[0] = c0;
+   result[1] = c1;
+   result[2] = c2;
+   result[3] = c3;
+}
+
+/** Converts a random 32-bit word to a float uniformly distributed on [0, 1). */
+inline float philoxToUniform(std::uint32_t word) {
+   return (float)(word >> 8) * (1.0f / 16777216.0f);
+}
+
+} // namespace PV
+
+#endif // PHILOX_HPP_
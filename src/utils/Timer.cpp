@@ -9,7 +9,9 @@
 
 #include "Timer.hpp"
 #include "utils/PVLog.hpp"
+#include "utils/Tracer.hpp"
 #include <stdio.h>
+#include <string>
 
 #ifdef __APPLE__
 #define USE_MACH_TIMER
@@ -19,8 +21,6 @@
 //#  include <CoreServices/CoreServices.h>
 #include <mach/mach.h>
 #include <mach/mach_time.h>
-#else
-#include <sys/time.h>
 #endif // USE_MACH_TIMER
 
 /**
@@ -30,9 +30,9 @@ uint64_t get_cpu_time() {
 #ifdef USE_MACH_TIMER
    return mach_absolute_time();
 #else
-   struct timeval tim;
-   gettimeofday(&tim, NULL);
-   return ((uint64_t)tim.tv_sec) * 1000000 + (uint64_t)tim.tv_usec;
+   // The monotonic clock, in nanoseconds; unlike gettimeofday, it is not affected by changes
+   // to the system time.
+   return PV::Tracer::now();
 #endif
 }
 
@@ -46,7 +46,7 @@ static double cpu_time_to_sec(uint64_t cpu_elapsed) {
    cpu_elapsed /= info.denom;
    us = (double)(cpu_elapsed / 1000); // microseconds
 #else
-   us = (double)cpu_elapsed;
+   us = (double)cpu_elapsed / 1000.0;
 #endif
    return us / 1000.0;
 }
@@ -57,12 +57,14 @@ Timer::Timer(double init_time) {
    rank = 0;
    reset(init_time);
    message = strdup("");
+   setTraceName("timer", "timer");
 }
 
 Timer::Timer(const char *timermessage, double init_time) {
    rank = 0;
    reset(init_time);
    message = strdup(timermessage ? timermessage : "");
+   setTraceName(message, "timer");
 }
 
 Timer::Timer(const char *objname, const char *objtype, const char *timertype, double init_time) {
@@ -83,6 +85,18 @@ Timer::Timer(const char *objname, const char *objtype, const char *timertype, do
    int chars_used = snprintf(
          message, charsneeded + 1, "%32s: total time in %6s %10s: ", objname, objtype, timertype);
    assert(chars_used <= charsneeded);
+
+   // The timer types are padded with spaces so that the timers.txt columns line up.
+   std::string traceName(objname);
+   std::string timerType(timertype);
+   timerType.erase(timerType.find_last_not_of(' ') + 1);
+   traceName.append(" ").append(timerType);
+   setTraceName(traceName.c_str(), objtype);
+}
+
+void Timer::setTraceName(char const *traceName, char const *traceCategory) {
+   mTraceName     = Tracer::instance()->internName(std::string(traceName));
+   mTraceCategory = Tracer::instance()->internName(std::string(traceCategory));
 }
 
 Timer::~Timer() { free(message); }
@@ -93,11 +107,20 @@ void Timer::reset(double init_time) {
    time_elapsed = init_time;
 }
 
-double Timer::start() { return (double)(time_start = get_cpu_time()); }
+double Timer::start() {
+   if (Tracer::enabled()) {
+      mTraceStart = Tracer::now();
+   }
+   return (double)(time_start = get_cpu_time());
+}
 
 double Timer::stop() {
    time_end = get_cpu_time();
    time_elapsed += time_end - time_start;
+   if (Tracer::enabled() and mTraceStart != 0U) {
+      Tracer::instance()->record(mTraceName, mTraceCategory, mTraceStart, Tracer::now());
+      mTraceStart = 0U;
+   }
    return (double)time_end;
 }
 
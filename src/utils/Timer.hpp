@@ -37,11 +37,18 @@ class Timer {
    virtual int fprint_time(PrintStream &stream) const;
 
   protected:
+   void setTraceName(char const *traceName, char const *traceCategory);
+
    int rank;
    char *message;
 
    uint64_t time_start, time_end;
    uint64_t time_elapsed;
+
+   // If tracing is enabled, each start/stop pair is also recorded as a zone in the Tracer.
+   char const *mTraceName     = nullptr;
+   char const *mTraceCategory = nullptr;
+   uint64_t mTraceStart       = 0U;
 };
 
 } // namespace PV
@@ -0,0 +1,174 @@
+#include "Tracer.hpp"
+#include "io/FileStream.hpp"
+#include "utils/PVLog.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <time.h>
+
+namespace PV {
+
+std::atomic<bool> Tracer::sEnabled{false};
+std::size_t const Tracer::defaultBufferCapacity;
+
+std::uint64_t Tracer::now() {
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (std::uint64_t)ts.tv_sec * (std::uint64_t)1000000000 + (std::uint64_t)ts.tv_nsec;
+}
+
+void Tracer::enable(std::size_t bufferCapacity) {
+   FatalIf(bufferCapacity == (std::size_t)0, "Tracer::enable called with zero buffer capacity.\n");
+   std::lock_guard<std::mutex> lock(mMutex);
+   mBufferCapacity = bufferCapacity;
+   // The thread buffers are kept, since each thread caches a pointer to its own buffer.
+   for (auto &b : mThreadBuffers) {
+      b->mEvents.resize(mBufferCapacity);
+      b->mCount.store(0U);
+   }
+   mEpoch = now();
+   sEnabled.store(true);
+}
+
+void Tracer::disable() { sEnabled.store(false); }
+
+char const *Tracer::internName(std::string const &name) {
+   std::lock_guard<std::mutex> lock(mMutex);
+   return mNames.insert(name).first->c_str();
+}
+
+Tracer::ThreadBuffer *Tracer::getThreadBuffer() {
+   static thread_local ThreadBuffer *threadBuffer = nullptr;
+   if (threadBuffer == nullptr) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      std::unique_ptr<ThreadBuffer> newBuffer(new ThreadBuffer);
+      newBuffer->mThreadIndex = (int)mThreadBuffers.size();
+      newBuffer->mEvents.resize(mBufferCapacity);
+      threadBuffer = newBuffer.get();
+      mThreadBuffers.push_back(std::move(newBuffer));
+   }
+   return threadBuffer;
+}
+
+void Tracer::record(
+      char const *name,
+      char const *category,
+      std::uint64_t start,
+      std::uint64_t stop) {
+   ThreadBuffer *buffer = getThreadBuffer();
+   std::uint64_t count  = buffer->mCount.load(std::memory_order_relaxed);
+   Event &event         = buffer->mEvents[count % buffer->mEvents.size()];
+   event.mName          = name;
+   event.mCategory      = category;
+   event.mStart         = start;
+   event.mDuration      = stop - start;
+   buffer->mCount.store(count + 1, std::memory_order_release);
+}
+
+std::size_t Tracer::getNumEvents() const {
+   std::size_t numEvents = 0;
+   for (auto &b : mThreadBuffers) {
+      std::uint64_t count = b->mCount.load(std::memory_order_acquire);
+      numEvents += (std::size_t)std::min(count, (std::uint64_t)b->mEvents.size());
+   }
+   return numEvents;
+}
+
+static void appendJSONString(std::string &json, char const *str) {
+   json.push_back('"');
+   for (char const *c = str; *c; c++) {
+      if (*c == '"' or *c == '\\') {
+         json.push_back('\\');
+         json.push_back(*c);
+      }
+      else if ((unsigned char)*c < 0x20) {
+         char escape[8];
+         std::snprintf(escape, sizeof(escape), "\\u%04x", (unsigned int)(unsigned char)*c);
+         json.append(escape);
+      }
+      else {
+         json.push_back(*c);
+      }
+   }
+   json.push_back('"');
+}
+
+std::string Tracer::eventsToJSON(int rank) const {
+   std::string json;
+   char numbers[128];
+   std::snprintf(
+         numbers,
+         sizeof(numbers),
+         "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}},\n",
+         rank,
+         rank);
+   json.append(numbers);
+   for (auto &b : mThreadBuffers) {
+      std::uint64_t count    = b->mCount.load(std::memory_order_acquire);
+      std::uint64_t capacity = (std::uint64_t)b->mEvents.size();
+      std::uint64_t first    = count > capacity ? count - capacity : 0U;
+      for (std::uint64_t n = first; n < count; n++) {
+         Event const &event = b->mEvents[n % capacity];
+         json.append("{\"name\":");
+         appendJSONString(json, event.mName);
+         json.append(",\"cat\":");
+         appendJSONString(json, event.mCategory);
+         // Chrome trace timestamps are in microseconds.
+         std::snprintf(
+               numbers,
+               sizeof(numbers),
+               ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d},\n",
+               (double)(event.mStart - mEpoch) * 1.0e-3,
+               (double)event.mDuration * 1.0e-3,
+               rank,
+               b->mThreadIndex);
+         json.append(numbers);
+      }
+   }
+   return json;
+}
+
+void Tracer::writeChromeTrace(std::string const &path, MPI_Comm comm) {
+   int rank, numProcs;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &numProcs);
+
+   std::string localJSON = eventsToJSON(rank);
+   int localSize         = (int)localJSON.size();
+   std::vector<int> sizes(rank == 0 ? numProcs : 0);
+   MPI_Gather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+
+   std::vector<int> displacements(sizes.size());
+   std::size_t totalSize = (std::size_t)0;
+   for (std::size_t r = 0; r < sizes.size(); r++) {
+      displacements[r] = (int)totalSize;
+      totalSize += (std::size_t)sizes[r];
+   }
+   std::vector<char> allJSON(totalSize);
+   MPI_Gatherv(
+         localJSON.data(),
+         localSize,
+         MPI_CHAR,
+         allJSON.data(),
+         sizes.data(),
+         displacements.data(),
+         MPI_CHAR,
+         0,
+         comm);
+
+   if (rank == 0) {
+      // Each event ends with a comma and a newline; drop the last comma to make valid JSON.
+      if (totalSize >= (std::size_t)2) {
+         allJSON[totalSize - 2] = '\n';
+         allJSON.resize(totalSize - 1);
+      }
+      FileStream traceStream(path.c_str(), std::ios_base::out);
+      std::string header("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+      traceStream.write(header.data(), (long)header.size());
+      traceStream.write(allJSON.data(), (long)allJSON.size());
+      std::string footer("]}\n");
+      traceStream.write(footer.data(), (long)footer.size());
+      InfoLog().printf("Wrote trace to \"%s\".\n", path.c_str());
+   }
+}
+
+} // namespace PV
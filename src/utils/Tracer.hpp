@@ -0,0 +1,128 @@
+#ifndef TRACER_HPP_
+#define TRACER_HPP_
+
+#include "arch/mpi/mpi.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace PV {
+
+/**
+ * A singleton that records timed zones (a name, a category, a start time and a duration) into
+ * per-thread ring buffers, and writes them as a Chrome trace event file that can be loaded into
+ * chrome://tracing or Perfetto. Tracing is off unless enable() has been called; while it is off,
+ * TraceZone and Timer do nothing beyond testing a flag.
+ *
+ * Each thread writes only to its own buffer, so recording needs no locks. When a buffer fills, the
+ * oldest events are overwritten. Timestamps come from clock_gettime(CLOCK_MONOTONIC).
+ */
+class Tracer {
+  public:
+   struct Event {
+      char const *mName;
+      char const *mCategory;
+      std::uint64_t mStart;
+      std::uint64_t mDuration;
+   };
+
+   static Tracer *instance() {
+      static Tracer *singleton = new Tracer();
+      return singleton;
+   }
+
+   /** Returns true if zones are being recorded. */
+   static bool enabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+   /** Returns the current value of the monotonic clock, in nanoseconds. */
+   static std::uint64_t now();
+
+   /**
+    * Discards any events already recorded, and starts recording. Each thread's ring buffer holds
+    * the most recent bufferCapacity events.
+    */
+   void enable(std::size_t bufferCapacity = defaultBufferCapacity);
+
+   /** Stops recording. Events already recorded are kept until the next call to enable(). */
+   void disable();
+
+   /**
+    * Returns a pointer to a copy of the given string that remains valid for the lifetime of the
+    * program. Zone names that are not string literals should be passed through this function.
+    */
+   char const *internName(std::string const &name);
+
+   /**
+    * Records a zone that started and stopped at the given times, as returned by now(),
+    * in the calling thread's buffer.
+    */
+   void record(char const *name, char const *category, std::uint64_t start, std::uint64_t stop);
+
+   /**
+    * Collects the events of all the processes in the communicator to the root process, which
+    * writes them to the given path in the Chrome trace event format. Each MPI process appears
+    * as a separate process in the trace, and each thread as a separate thread.
+    * This function must be called by all processes in the communicator, while no other thread
+    * is recording.
+    */
+   void writeChromeTrace(std::string const &path, MPI_Comm comm);
+
+   /** Returns the number of events held in all the thread buffers. */
+   std::size_t getNumEvents() const;
+
+   static std::size_t const defaultBufferCapacity = (std::size_t)1 << 18;
+
+  private:
+   struct ThreadBuffer {
+      int mThreadIndex;
+      std::vector<Event> mEvents;
+      std::atomic<std::uint64_t> mCount{0};
+   };
+
+   Tracer() {}
+   ThreadBuffer *getThreadBuffer();
+   std::string eventsToJSON(int rank) const;
+
+   static std::atomic<bool> sEnabled;
+
+   std::mutex mMutex;
+   std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+   std::set<std::string> mNames;
+   std::size_t mBufferCapacity = defaultBufferCapacity;
+   std::uint64_t mEpoch        = 0U;
+};
+
+/**
+ * Records a zone from its construction to the end of its scope, if tracing is enabled.
+ * The name and category pointers must remain valid until the trace is written;
+ * string literals and strings returned by Tracer::internName() qualify.
+ */
+class TraceZone {
+  public:
+   TraceZone(char const *name, char const *category) {
+      if (Tracer::enabled()) {
+         mName     = name;
+         mCategory = category;
+         mStart    = Tracer::now();
+      }
+   }
+
+   ~TraceZone() {
+      if (mName and Tracer::enabled()) {
+         Tracer::instance()->record(mName, mCategory, mStart, Tracer::now());
+      }
+   }
+
+  private:
+   char const *mName     = nullptr;
+   char const *mCategory = nullptr;
+   std::uint64_t mStart  = 0U;
+};
+
+} // namespace PV
+
+#endif // TRACER_HPP_
@@ -13,7 +13,10 @@
 
 namespace PV {
 
-InitGauss2DWeights::InitGauss2DWeights(char const *name, HyPerCol *hc) { initialize(name, hc); }
+InitGauss2DWeights::InitGauss2DWeights(char const *name, HyPerCol *hc) {
+   initialize(name, hc);
+   mThreadSafePatches = true;
+}
 
 InitGauss2DWeights::InitGauss2DWeights() {}
 
@@ -154,12 +157,14 @@ void InitGauss2DWeights::calcWeights() {
    if (mNumOrientationsPre <= 0) {
       mNumOrientationsPre = mWeights->getGeometry()->getPreLoc().nf;
    }
+   // These do not depend on the patch; calculateThetas() sets them too, for derived classes.
+   mDeltaThetaPost = PI * mThetaMax / (float)mNumOrientationsPost;
+   mTheta0Post     = mRotate * mDeltaThetaPost / 2.0f;
    InitWeights::calcWeights();
 }
 
 void InitGauss2DWeights::calcWeights(int dataPatchIndex, int arborId) {
-   calcOtherParams(dataPatchIndex);
-   gauss2DCalcWeights(mWeights->getDataFromDataIndex(arborId, dataPatchIndex));
+   gauss2DCalcWeights(mWeights->getDataFromDataIndex(arborId, dataPatchIndex), dataPatchIndex);
    // Weight does not depend on the arborId.
 }
 
@@ -168,7 +173,17 @@ void InitGauss2DWeights::calcOtherParams(int patchIndex) {
    calculateThetas(kfPre_tmp, patchIndex);
 }
 
-void InitGauss2DWeights::gauss2DCalcWeights(float *dataStart) {
+void InitGauss2DWeights::gauss2DCalcWeights(float *dataStart, int dataPatchIndex) {
+   PatchOffsets offsets;
+   const int kfPre      = kernelIndexCalculations(dataPatchIndex, offsets);
+   const float dthPre   = PI * mThetaMax / (float)mNumOrientationsPre;
+   const float th0Pre   = mRotate * dthPre / 2.0f;
+   const int featurePre = dataPatchIndex % mWeights->getGeometry()->getPreLoc().nf;
+   pvAssert(featurePre == kfPre);
+   const float thetaPre = th0Pre + (dataPatchIndex % mNumOrientationsPre) * dthPre;
+   const int preColor   = featurePre / mNumOrientationsPre;
+   const bool selfConn  = mWeights->getGeometry()->getSelfConnectionFlag();
+
    int nfPatch = mWeights->getPatchSizeF();
    int nyPatch = mWeights->getPatchSizeY();
    int nxPatch = mWeights->getPatchSizeX();
@@ -180,20 +195,22 @@ void InitGauss2DWeights::gauss2DCalcWeights(float *dataStart) {
 
    // loop over all post-synaptic cells in temporary patch
    for (int fPost = 0; fPost < nfPatch; fPost++) {
-      float thPost = calcThPost(fPost);
+      float thPost = (mNumOrientationsPost == 1 && mNumOrientationsPre > 1)
+                           ? thetaPre
+                           : mTheta0Post + (fPost % mNumOrientationsPost) * mDeltaThetaPost;
       // TODO: add additional weight factor for difference between thPre and thPost
-      if (checkThetaDiff(thPost)) {
+      if (std::abs(thetaPre - thPost) > mDeltaThetaMax) {
          continue;
       }
-      if (checkColorDiff(fPost)) {
+      if (fPost / mNumOrientationsPost != preColor) {
          continue;
       }
       for (int jPost = 0; jPost < nyPatch; jPost++) {
-         float yDelta = calcYDelta(jPost);
+         float yDelta = calcDelta(jPost, offsets.mDyPost, offsets.mYDistHeadPreUnits);
          for (int iPost = 0; iPost < nxPatch; iPost++) {
-            float xDelta = calcXDelta(iPost);
+            float xDelta = calcDelta(iPost, offsets.mDxPost, offsets.mXDistHeadPreUnits);
 
-            if (isSameLocAndSelf(xDelta, yDelta, fPost)) {
+            if (selfConn and featurePre == fPost and xDelta == 0.0f and yDelta == 0.0f) {
                continue;
             }
 
@@ -73,7 +73,12 @@ class InitGauss2DWeights : public PV::InitWeights {
    bool checkBowtieAngle(float xp, float yp);
 
   private:
-   void gauss2DCalcWeights(float *dataStart);
+   /**
+    * Computes the given patch. The per-patch quantities that calcOtherParams() stores in data
+    * members are kept in local variables instead, so that several threads can compute patches
+    * at once.
+    */
+   void gauss2DCalcWeights(float *dataStart, int dataPatchIndex);
 
   protected:
    // params
@@ -11,6 +11,7 @@ namespace PV {
 
 InitGaussianRandomWeights::InitGaussianRandomWeights(char const *name, HyPerCol *hc) {
    initialize(name, hc);
+   mThreadSafePatches = true;
 }
 
 InitGaussianRandomWeights::InitGaussianRandomWeights() {}
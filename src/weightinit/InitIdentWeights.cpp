@@ -9,7 +9,10 @@
 
 namespace PV {
 
-InitIdentWeights::InitIdentWeights(char const *name, HyPerCol *hc) { initialize(name, hc); }
+InitIdentWeights::InitIdentWeights(char const *name, HyPerCol *hc) {
+   initialize(name, hc);
+   mThreadSafePatches = true;
+}
 
 InitIdentWeights::InitIdentWeights() {}
 
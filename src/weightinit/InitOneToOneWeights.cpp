@@ -9,7 +9,10 @@
 
 namespace PV {
 
-InitOneToOneWeights::InitOneToOneWeights(char const *name, HyPerCol *hc) { initialize(name, hc); }
+InitOneToOneWeights::InitOneToOneWeights(char const *name, HyPerCol *hc) {
+   initialize(name, hc);
+   mThreadSafePatches = true;
+}
 
 InitOneToOneWeights::InitOneToOneWeights() {}
 
@@ -11,6 +11,7 @@ namespace PV {
 
 InitOneToOneWeightsWithDelays::InitOneToOneWeightsWithDelays(char const *name, HyPerCol *hc) {
    initialize(name, hc);
+   mThreadSafePatches = true;
 }
 
 InitOneToOneWeightsWithDelays::InitOneToOneWeightsWithDelays() {}
@@ -11,6 +11,7 @@ namespace PV {
 
 InitSmartWeights::InitSmartWeights(char const *name, HyPerCol *hc) : InitWeights() {
    InitSmartWeights::initialize(name, hc);
+   mThreadSafePatches = true;
 }
 
 InitSmartWeights::InitSmartWeights() {}
@@ -11,6 +11,7 @@ namespace PV {
 
 InitUniformRandomWeights::InitUniformRandomWeights(char const *name, HyPerCol *hc) {
    initialize(name, hc);
+   mThreadSafePatches = true;
 }
 
 InitUniformRandomWeights::InitUniformRandomWeights() {}
@@ -37,6 +38,13 @@ void InitUniformRandomWeights::ioParam_wMinInit(enum ParamsIOFlag ioFlag) {
 
 void InitUniformRandomWeights::ioParam_wMaxInit(enum ParamsIOFlag ioFlag) {
    parent->parameters()->ioParamValue(ioFlag, name, "wMaxInit", &mWMax, mWMax);
+   if (ioFlag == PARAMS_IO_READ and mWMax < mWMin) {
+      WarnLog().printf(
+            "uniformWeights maximum less than minimum.  Changing max = %f to min value of %f\n",
+            (double)mWMax,
+            (double)mWMin);
+      mWMax = mWMin;
+   }
 }
 
 void InitUniformRandomWeights::ioParam_sparseFraction(enum ParamsIOFlag ioFlag) {
@@ -54,14 +62,8 @@ void InitUniformRandomWeights::ioParam_minNNZ(enum ParamsIOFlag ioFlag) {
  */
 void InitUniformRandomWeights::randomWeights(float *patchDataStart, int patchIndex) {
    double p;
+   // ioParam_wMaxInit makes sure that mWMax is at least mWMin.
    if (mWMax <= mWMin) {
-      if (mWMax < mWMin) {
-         WarnLog().printf(
-               "uniformWeights maximum less than minimum.  Changing max = %f to min value of %f\n",
-               (double)mWMax,
-               (double)mWMin);
-         mWMax = mWMin;
-      }
       p = 0.0;
    }
    else {
@@ -9,7 +9,10 @@
 
 namespace PV {
 
-InitUniformWeights::InitUniformWeights(char const *name, HyPerCol *hc) { initialize(name, hc); }
+InitUniformWeights::InitUniformWeights(char const *name, HyPerCol *hc) {
+   initialize(name, hc);
+   mThreadSafePatches = true;
+}
 
 InitUniformWeights::InitUniformWeights() {}
 
@@ -144,6 +144,20 @@ Response::Status InitWeights::initializeState() {
 void InitWeights::calcWeights() {
    int numArbors  = mWeights->getNumArbors();
    int numPatches = mWeights->getNumDataPatches();
+   if (mThreadSafePatches) {
+      // A patch's arbors are done in the same order as in the serial loop below, so that the
+      // random numbers of initializers that have a generator for each patch do not depend on the
+      // number of threads.
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(guided)
+#endif // PV_USE_OPENMP_THREADS
+      for (int dataPatchIndex = 0; dataPatchIndex < numPatches; dataPatchIndex++) {
+         for (int arbor = 0; arbor < numArbors; arbor++) {
+            calcWeights(dataPatchIndex, arbor);
+         }
+      }
+      return;
+   }
    for (int arbor = 0; arbor < numArbors; arbor++) {
       for (int dataPatchIndex = 0; dataPatchIndex < numPatches; dataPatchIndex++) {
          calcWeights(dataPatchIndex, arbor);
@@ -230,7 +244,7 @@ int InitWeights::dataIndexToUnitCellIndex(int dataIndex, int *kx, int *ky, int *
    return kUnitCell;
 }
 
-int InitWeights::kernelIndexCalculations(int dataPatchIndex) {
+int InitWeights::kernelIndexCalculations(int dataPatchIndex, PatchOffsets &offsets) {
    // kernel index stuff:
    int kxKernelIndex;
    int kyKernelIndex;
@@ -271,18 +285,28 @@ int InitWeights::kernelIndexCalculations(int dataPatchIndex) {
    yDistHeadPostUnits = yDistNNPostUnits + (kyHead - kyNN);
    float xRelativeScale =
          xDistNNPreUnits == xDistNNPostUnits ? 1.0f : xDistNNPreUnits / xDistNNPostUnits;
-   mXDistHeadPreUnits = xDistHeadPostUnits * xRelativeScale;
+   offsets.mXDistHeadPreUnits = xDistHeadPostUnits * xRelativeScale;
    float yRelativeScale =
          yDistNNPreUnits == yDistNNPostUnits ? 1.0f : yDistNNPreUnits / yDistNNPostUnits;
-   mYDistHeadPreUnits = yDistHeadPostUnits * yRelativeScale;
+   offsets.mYDistHeadPreUnits = yDistHeadPostUnits * yRelativeScale;
 
    // sigma is in units of pre-synaptic layer
-   mDxPost = xRelativeScale;
-   mDyPost = yRelativeScale;
+   offsets.mDxPost = xRelativeScale;
+   offsets.mDyPost = yRelativeScale;
 
    return kfPre;
 }
 
+int InitWeights::kernelIndexCalculations(int dataPatchIndex) {
+   PatchOffsets offsets;
+   int kfPre          = kernelIndexCalculations(dataPatchIndex, offsets);
+   mDxPost            = offsets.mDxPost;
+   mDyPost            = offsets.mDyPost;
+   mXDistHeadPreUnits = offsets.mXDistHeadPreUnits;
+   mYDistHeadPreUnits = offsets.mYDistHeadPreUnits;
+   return kfPre;
+}
+
 float InitWeights::calcYDelta(int jPost) { return calcDelta(jPost, mDyPost, mYDistHeadPreUnits); }
 
 float InitWeights::calcXDelta(int iPost) { return calcDelta(iPost, mDxPost, mXDistHeadPreUnits); }
@@ -97,7 +97,8 @@ class InitWeights : public BaseObject {
    /**
     * Called by initializeWeights, to calculate the weights in all arbors and all patches.
     * The base implementation callse calcWeights(int, int) in a loop over arbors and
-    * patches
+    * patches. If mThreadSafePatches is set, the patches are divided among the OpenMP threads,
+    * and each patch does its arbors in order.
     */
    virtual void calcWeights();
 
@@ -113,6 +114,30 @@ class InitWeights : public BaseObject {
 
    int
    dataIndexToUnitCellIndex(int dataIndex, int *kx = nullptr, int *ky = nullptr, int *kf = nullptr);
+
+   /**
+    * The distances from a presynaptic neuron to the head of its patch, and the spacing of the
+    * postsynaptic neurons, in presynaptic units.
+    */
+   struct PatchOffsets {
+      float mDxPost;
+      float mDyPost;
+      float mXDistHeadPreUnits;
+      float mYDistHeadPreUnits;
+   };
+
+   /**
+    * Computes the offsets of the given patch, and returns the feature index of its presynaptic
+    * neuron. Unlike kernelIndexCalculations(int), it does not change the object, so it can be
+    * called by several threads at once.
+    */
+   int kernelIndexCalculations(int patchIndex, PatchOffsets &offsets);
+
+   /**
+    * Computes the offsets of the given patch into the mDxPost, mDyPost, mXDistHeadPreUnits and
+    * mYDistHeadPreUnits data members, which calcXDelta() and calcYDelta() use, and returns the
+    * feature index of its presynaptic neuron.
+    */
    int kernelIndexCalculations(int patchIndex);
    float calcYDelta(int jPost);
    float calcXDelta(int iPost);
@@ -125,6 +150,12 @@ class InitWeights : public BaseObject {
 
    char *mFilename  = nullptr;
    int mFrameNumber = 0;
+
+   // True if calcWeights(int, int) writes only the given patch and changes no data members, so
+   // that calcWeights() can compute the patches in parallel. Only the public constructor of a
+   // class for which this holds sets it, so that a derived class does not inherit it.
+   bool mThreadSafePatches = false;
+
    float mDxPost;
    float mDyPost;
    float mXDistHeadPreUnits;
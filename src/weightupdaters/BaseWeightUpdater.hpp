@@ -37,6 +37,12 @@ class BaseWeightUpdater : public BaseObject {
 
    bool getPlasticityFlag() const { return mPlasticityFlag; };
 
+   /**
+    * Turns plasticity off for the rest of the run, so that the weights stay as they are. The data
+    * structures allocated for learning are kept. Should be called between timesteps.
+    */
+   void turnOffPlasticity() { mPlasticityFlag = false; }
+
   protected:
    BaseWeightUpdater() {}
 
@@ -10,6 +10,7 @@
 #include "columns/ObjectMapComponent.hpp"
 #include "components/WeightsPair.hpp"
 #include "utils/MapLookupByType.hpp"
+#include "utils/Tracer.hpp"
 #include "utils/TransposeWeights.hpp"
 
 namespace PV {
@@ -37,6 +38,7 @@ int HebbianUpdater::ioParamsFillGroup(enum ParamsIOFlag ioFlag) {
    ioParam_normalizeDw(ioFlag);
    ioParam_useMask(ioFlag);
    ioParam_combine_dW_with_W_flag(ioFlag);
+   ioParam_fuseNormalization(ioFlag);
    return PV_SUCCESS;
 }
 
@@ -193,6 +195,19 @@ void HebbianUpdater::ioParam_combine_dW_with_W_flag(enum ParamsIOFlag ioFlag) {
    }
 }
 
+void HebbianUpdater::ioParam_fuseNormalization(enum ParamsIOFlag ioFlag) {
+   pvAssert(!parent->parameters()->presentAndNotBeenRead(name, "plasticityFlag"));
+   if (mPlasticityFlag) {
+      parent->parameters()->ioParamValue(
+            ioFlag,
+            name,
+            "fuseNormalization",
+            &mFuseNormalization,
+            mFuseNormalization,
+            false /*warnIfAbsent*/);
+   }
+}
+
 Response::Status
 HebbianUpdater::communicateInitInfo(std::shared_ptr<CommunicateInitInfoMessage const> message) {
    auto componentMap       = message->mHierarchy;
@@ -225,6 +240,12 @@ HebbianUpdater::communicateInitInfo(std::shared_ptr<CommunicateInitInfoMessage c
    mArborList = mapLookupByType<ArborList>(message->mHierarchy, getDescription());
    FatalIf(mArborList == nullptr, "%s requires a ArborList component.\n", getDescription_c());
 
+   if (mFuseNormalization) {
+      // Whether the normalizer can actually be fused is checked at each update, since the
+      // normalization group is not complete until all the normalizers have communicated.
+      mNormalizer = mapLookupByType<NormalizeBase>(message->mHierarchy, getDescription());
+   }
+
    if (mTriggerFlag) {
       auto *objectMapComponent = mapLookupByType<ObjectMapComponent>(componentMap, desc);
       pvAssert(objectMapComponent);
@@ -285,6 +306,7 @@ Response::Status HebbianUpdater::allocateDataStructures() {
          }
          mDeltaWeights = new Weights(name);
          mDeltaWeights->initialize(mWeights);
+         mDeltaWeights->setMemoryCategory("delta weights");
          mDeltaWeights->setMargins(
                mConnectionData->getPre()->getLayerLoc()->halo,
                mConnectionData->getPost()->getLayerLoc()->halo);
@@ -296,7 +318,8 @@ Response::Status HebbianUpdater::allocateDataStructures() {
          mNumKernelActivations    = (long **)pvCalloc(numArbors, sizeof(long *));
          int const sp             = mDeltaWeights->getPatchSizeOverall();
          std::size_t numWeights   = (std::size_t)(sp) * (std::size_t)nPatches;
-         mNumKernelActivations[0] = (long *)pvCalloc(numWeights, sizeof(long));
+         mNumKernelActivations[0] = (long *)pvCallocTracked(
+               name, "kernel activations", numWeights * numArbors, sizeof(long));
          for (int arborId = 0; arborId < numArbors; arborId++) {
             mNumKernelActivations[arborId] = (mNumKernelActivations[0] + sp * nPatches * arborId);
          } // loop over arbors
@@ -349,6 +372,9 @@ Response::Status HebbianUpdater::registerData(Checkpointer *checkpointer) {
             true /*broadcast*/,
             false /*not constant*/);
    }
+   if (mPlasticityFlag) {
+      mMetrics = checkpointer->getMetricsRegistry()->addCounters(nameString, "updater");
+   }
    return Response::SUCCESS;
 }
 
@@ -368,6 +394,7 @@ Response::Status HebbianUpdater::readStateFromCheckpoint(Checkpointer *checkpoin
 void HebbianUpdater::updateState(double simTime, double dt) {
    if (needUpdate(simTime, dt)) {
       pvAssert(mPlasticityFlag);
+      std::uint64_t const updateStart = Tracer::now();
       if (mImmediateWeightUpdate) {
          updateWeightsImmediate(simTime, dt);
       }
@@ -381,6 +408,9 @@ void HebbianUpdater::updateState(double simTime, double dt) {
       mWeights->setTimestamp(simTime);
       computeNewWeightUpdateTime(simTime, mWeightUpdateTime);
       mNeedFinalize = true;
+      if (mMetrics) {
+         mMetrics->mComputeTime += Tracer::now() - updateStart;
+      }
    }
    mLastTimeUpdateCalled = simTime;
 }
@@ -429,6 +459,15 @@ void HebbianUpdater::updateLocal_dW() {
       }
    }
    pvAssert(status == PV_SUCCESS or status == PV_BREAK);
+   if (mMetrics) {
+      HyPerLayer *pre              = mConnectionData->getPre();
+      std::uint64_t const numPre   = (std::uint64_t)pre->getNumExtendedAllBatches();
+      std::uint64_t const numOps   = numPre * (std::uint64_t)mWeights->getPatchSizeOverall();
+      mMetrics->mActiveNeurons += numPre * (std::uint64_t)numArbors;
+      mMetrics->mSynapticOps += numOps * (std::uint64_t)numArbors;
+      // Each operation reads a pre activity, a post activity and dW, and writes dW.
+      mMetrics->mBytesMoved += numOps * (std::uint64_t)numArbors * 4U * sizeof(float);
+   }
 }
 
 int HebbianUpdater::initialize_dW(int arborId) {
@@ -685,18 +724,24 @@ int HebbianUpdater::reduceKernels(int arborID) {
       const int numPatches    = mWeights->getNumDataPatches();
       const size_t patchSize  = (size_t)mWeights->getPatchSizeOverall();
       const size_t localSize  = (size_t)numPatches * (size_t)patchSize;
-      const size_t arborSize  = localSize * (size_t)mArborList->getNumAxonalArbors();
-
-      auto sz = mDeltaWeightsReduceRequests.size();
-      mDeltaWeightsReduceRequests.resize(sz + 1);
-      MPI_Iallreduce(
-            MPI_IN_PLACE,
-            mDeltaWeights->getData(arborID),
-            arborSize,
-            MPI_FLOAT,
-            MPI_SUM,
-            mpi_comm,
-            &(mDeltaWeightsReduceRequests.data())[sz]);
+      int const numArbors     = mArborList->getNumAxonalArbors();
+
+      // Each arbor's data is stored separately, so each arbor needs its own reduction.
+      for (int kArbor = 0; kArbor < numArbors; kArbor++) {
+         auto sz = mDeltaWeightsReduceRequests.size();
+         mDeltaWeightsReduceRequests.resize(sz + 1);
+         MPI_Iallreduce(
+               MPI_IN_PLACE,
+               mDeltaWeights->getData(kArbor),
+               localSize,
+               MPI_FLOAT,
+               MPI_SUM,
+               mpi_comm,
+               &(mDeltaWeightsReduceRequests.data())[sz]);
+      }
+      if (mMetrics) {
+         mMetrics->mHaloBytes += (std::uint64_t)(localSize * numArbors) * sizeof(float);
+      }
    }
 
    return PV_BREAK;
@@ -716,11 +761,12 @@ int HebbianUpdater::reduceActivations(int arborID) {
       const size_t localSize  = numPatches * patchSize;
       const size_t arborSize  = localSize * mArborList->getNumAxonalArbors();
 
+      // The activation counts for all arbors are stored contiguously, starting at arbor 0.
       auto sz = mDeltaWeightsReduceRequests.size();
       mDeltaWeightsReduceRequests.resize(sz + 1);
       MPI_Iallreduce(
             MPI_IN_PLACE,
-            mNumKernelActivations[arborID],
+            mNumKernelActivations[0],
             arborSize,
             MPI_LONG,
             MPI_SUM,
@@ -737,19 +783,24 @@ void HebbianUpdater::reduceAcrossBatch(int arborID) {
       const int numPatches     = mWeights->getNumDataPatches();
       const size_t patchSize   = (size_t)mWeights->getPatchSizeOverall();
       size_t const localSize   = (size_t)numPatches * (size_t)patchSize;
-      size_t const arborSize   = localSize * (size_t)mArborList->getNumAxonalArbors();
+      int const numArbors      = mArborList->getNumAxonalArbors();
       MPI_Comm const batchComm = parent->getCommunicator()->batchCommunicator();
 
-      auto sz = mDeltaWeightsReduceRequests.size();
-      mDeltaWeightsReduceRequests.resize(sz + 1);
-      MPI_Iallreduce(
-            MPI_IN_PLACE,
-            mDeltaWeights->getData(arborID),
-            arborSize,
-            MPI_FLOAT,
-            MPI_SUM,
-            batchComm,
-            &(mDeltaWeightsReduceRequests.data())[sz]);
+      for (int kArbor = 0; kArbor < numArbors; kArbor++) {
+         auto sz = mDeltaWeightsReduceRequests.size();
+         mDeltaWeightsReduceRequests.resize(sz + 1);
+         MPI_Iallreduce(
+               MPI_IN_PLACE,
+               mDeltaWeights->getData(kArbor),
+               localSize,
+               MPI_FLOAT,
+               MPI_SUM,
+               batchComm,
+               &(mDeltaWeightsReduceRequests.data())[sz]);
+      }
+      if (mMetrics) {
+         mMetrics->mHaloBytes += (std::uint64_t)(localSize * numArbors) * sizeof(float);
+      }
    }
 }
 
@@ -762,10 +813,14 @@ void HebbianUpdater::blockingNormalize_dW() {
 }
 
 void HebbianUpdater::wait_dWReduceRequests() {
+   std::uint64_t const waitStart = Tracer::now();
    MPI_Waitall(
          mDeltaWeightsReduceRequests.size(),
          mDeltaWeightsReduceRequests.data(),
          MPI_STATUSES_IGNORE);
+   if (mMetrics and !mDeltaWeightsReduceRequests.empty()) {
+      mMetrics->mMPIWaitTime += Tracer::now() - waitStart;
+   }
    mDeltaWeightsReduceRequests.clear();
 }
 
@@ -820,6 +875,10 @@ int HebbianUpdater::normalize_dW(int arbor_ID) {
 }
 
 void HebbianUpdater::updateArbors() {
+   if (canFuseNormalization()) {
+      updateAndNormalizeArbors();
+      return;
+   }
    int status          = PV_SUCCESS;
    int const numArbors = mArborList->getNumAxonalArbors();
    for (int arborId = 0; arborId < numArbors; arborId++) {
@@ -845,6 +904,48 @@ int HebbianUpdater::updateWeights(int arborId) {
    return PV_BREAK;
 }
 
+bool HebbianUpdater::canFuseNormalization() const {
+   // With combine_dW_with_W_flag set, dW and W share memory, so updating patch by patch would
+   // not give the same result as updating all of them first.
+   return mFuseNormalization and mNormalizer != nullptr and !mCombine_dWWithWFlag
+          and updatesByPatch() and mNormalizer->canFuseWithUpdate();
+}
+
+void HebbianUpdater::updateAndNormalizeArbors() {
+   int const numArbors  = mArborList->getNumAxonalArbors();
+   int const numPatches = mWeights->getNumDataPatches();
+   std::vector<char> patchNormalized((std::size_t)numPatches);
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for schedule(static)
+#endif
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      for (int arborId = 0; arborId < numArbors; arborId++) {
+         updatePatch(arborId, patchIndex);
+      }
+      patchNormalized[patchIndex] = (char)mNormalizer->normalizePatchFused(patchIndex);
+   }
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      if (!patchNormalized[patchIndex]) {
+         WarnLog().printf(
+               "%s: weights in patch %d are within the tolerance of %s of zero. "
+               "Weights in this patch were not normalized.\n",
+               getDescription_c(),
+               patchIndex,
+               mNormalizer->getDescription_c());
+      }
+   }
+   mNormalizer->recordFusedNormalization(parent->simulationTime());
+}
+
+void HebbianUpdater::updatePatch(int arborId, int patchIndex) {
+   int const patchSize       = mWeights->getPatchSizeOverall();
+   float *weights            = mWeights->getDataFromDataIndex(arborId, patchIndex);
+   float const *deltaWeights = mDeltaWeights->getDataFromDataIndex(arborId, patchIndex);
+   for (int k = 0; k < patchSize; k++) {
+      weights[k] += deltaWeights[k];
+   }
+}
+
 void HebbianUpdater::decay_dWMax() {
    if (mDWMaxDecayInterval > 0) {
       if (--mDWMaxDecayTimer < 0) {
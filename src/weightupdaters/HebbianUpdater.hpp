@@ -9,6 +9,8 @@
 #define HEBBIANUPDATER_HPP_
 
 #include "components/Weights.hpp"
+#include "normalizers/NormalizeBase.hpp"
+#include "utils/MetricsRegistry.hpp"
 #include "weightupdaters/BaseWeightUpdater.hpp"
 
 namespace PV {
@@ -33,6 +35,20 @@ class HebbianUpdater : public BaseWeightUpdater {
    virtual void ioParam_useMask(enum ParamsIOFlag ioFlag);
    virtual void ioParam_combine_dW_with_W_flag(enum ParamsIOFlag ioFlag);
 
+   /**
+    * @brief fuseNormalization: If true, and the connection's normalizer supports it, the weight
+    * update and the normalization are done together, one data patch at a time: each patch has
+    * dW (and any momentum) applied and is then normalized while it is still in cache, instead of
+    * the normalizer making a second pass over all the weights in response to the
+    * ConnectionNormalizeMessage. NormalizeL2 and NormalizeSum support fusion when the normalization
+    * group consists of the connection alone; NormalizeL2 also requires that rMinX/rMinY and
+    * normalize_cutoff be off. Fusion also requires an updater whose per-patch update matches
+    * updateWeights() (see updatesByPatch()). Otherwise the update and normalization are done
+    * separately.
+    * Default is false.
+    */
+   virtual void ioParam_fuseNormalization(enum ParamsIOFlag ioFlag);
+
    /** @} */ // end of HebbianUpdater parameters
 
   public:
@@ -50,6 +66,9 @@ class HebbianUpdater : public BaseWeightUpdater {
       return mDeltaWeights->getDataFromDataIndex(arborId, dataIndex);
    }
 
+   char const *getTriggerLayerName() const { return mTriggerLayerName; }
+   double getWeightUpdatePeriod() const { return mWeightUpdatePeriod; }
+
   protected:
    HebbianUpdater() {}
 
@@ -123,6 +142,35 @@ class HebbianUpdater : public BaseWeightUpdater {
 
    virtual int updateWeights(int arborId);
 
+   /**
+    * Returns true if fuseNormalization is set, the updater updates by patch, and the normalizer
+    * can be fused with the update.
+    */
+   bool canFuseNormalization() const;
+
+   /**
+    * Returns true if calling updatePatch() for every patch of every arbor does what updateWeights()
+    * does, so that the update can be fused with the normalization. HebbianUpdater returns true.
+    * A subclass that overrides updateWeights() without overriding updatePatch() to match must
+    * override this method to return false.
+    */
+   virtual bool updatesByPatch() const { return true; }
+
+   /**
+    * Applies the weight update to each data patch in turn, across all arbors, and normalizes the
+    * patch immediately afterward. Used instead of updateWeights() if canFuseNormalization() is
+    * true.
+    */
+   void updateAndNormalizeArbors();
+
+   /**
+    * The per-patch counterpart of updateWeights(): adds dW to W for the given data patch of the
+    * given arbor. Called by updateAndNormalizeArbors(), possibly from several threads at once for
+    * different patches. Subclasses that override updateWeights() should override this method to
+    * match, or else override updatesByPatch() to return false.
+    */
+   virtual void updatePatch(int arborId, int patchIndex);
+
    /**
     * Decrements the counter for dWMaxDecayInterval, and if at the end of the interval,
     * decays the dWMax value.
@@ -146,11 +194,13 @@ class HebbianUpdater : public BaseWeightUpdater {
    float mDWMaxDecayInterval          = 0.0f;
    bool mNormalizeDw                  = true;
    bool mCombine_dWWithWFlag          = false;
+   bool mFuseNormalization            = false;
    bool mWriteCompressedCheckpoints   = false;
    bool mInitializeFromCheckpointFlag = false;
 
    Weights *mWeights            = nullptr;
    Weights *mDeltaWeights       = nullptr;
+   NormalizeBase *mNormalizer   = nullptr;
    HyPerLayer *mTriggerLayer    = nullptr;
    bool mTriggerFlag            = false;
    double mWeightUpdateTime     = 0.0;
@@ -166,6 +216,11 @@ class HebbianUpdater : public BaseWeightUpdater {
    // m_dWReduceRequests as the signal to blockingNormalize_dW because the
    // requests are not created if there is only a single MPI processes.
    std::vector<ConnectionData *> mClones;
+
+   // The counters this updater reports into: compute time for the weight update, one synaptic
+   // operation per presynaptic extended neuron per weight, and the bytes and wait time of the
+   // dW reductions across processes.
+   PerformanceCounters *mMetrics = nullptr;
 };
 
 } // namespace PV
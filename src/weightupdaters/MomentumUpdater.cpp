@@ -84,6 +84,7 @@ Response::Status MomentumUpdater::allocateDataStructures() {
    }
    mPrevDeltaWeights = new Weights(name);
    mPrevDeltaWeights->initialize(mWeights);
+   mPrevDeltaWeights->setMemoryCategory("previous delta weights");
    mPrevDeltaWeights->setMargins(
          mConnectionData->getPre()->getLayerLoc()->halo,
          mConnectionData->getPost()->getLayerLoc()->halo);
@@ -120,27 +121,66 @@ Response::Status MomentumUpdater::readStateFromCheckpoint(Checkpointer *checkpoi
 }
 
 int MomentumUpdater::updateWeights(int arborId) {
-   // Add momentum right before updateWeights
-   applyMomentum(arborId);
-
-   // Current dW saved to prev_dW
-   pvAssert(mPrevDeltaWeights);
-   std::memcpy(
-         mPrevDeltaWeights->getData(arborId),
-         mDeltaWeights->getDataReadOnly(arborId),
-         sizeof(float) * mDeltaWeights->getPatchSizeOverall() * mDeltaWeights->getNumDataPatches());
+   // HebbianUpdater::updateWeights adds dW to W for all arbors at once, so momentum has to be
+   // applied to all arbors here as well.
+   int const numArbors = mArborList->getNumAxonalArbors();
+   for (int kArbor = 0; kArbor < numArbors; kArbor++) {
+      // Add momentum right before updateWeights
+      applyMomentum(kArbor);
+
+      // Current dW saved to prev_dW
+      pvAssert(mPrevDeltaWeights);
+      std::memcpy(
+            mPrevDeltaWeights->getData(kArbor),
+            mDeltaWeights->getDataReadOnly(kArbor),
+            sizeof(float) * mDeltaWeights->getPatchSizeOverall()
+                  * mDeltaWeights->getNumDataPatches());
+   }
 
    // add dw to w
    return HebbianUpdater::updateWeights(arborId);
 }
 
+void MomentumUpdater::updatePatch(int arborId, int patchIndex) {
+   float dwFactor, wFactor;
+   calcMomentumFactors(dwFactor, wFactor);
+   int const patchSizeOverall = mDeltaWeights->getPatchSizeOverall();
+   float *dwdata_start        = mDeltaWeights->getDataFromDataIndex(arborId, patchIndex);
+   float *prev_dw_start       = mPrevDeltaWeights->getDataFromDataIndex(arborId, patchIndex);
+   float const *wdata_start   = mWeights->getDataFromDataIndex(arborId, patchIndex);
+   for (int k = 0; k < patchSizeOverall; k++) {
+      dwdata_start[k] += dwFactor * prev_dw_start[k] - wFactor * wdata_start[k];
+      prev_dw_start[k] = dwdata_start[k];
+   }
+   HebbianUpdater::updatePatch(arborId, patchIndex);
+}
+
 void MomentumUpdater::applyMomentum(int arborId) {
    // Shared weights done in parallel, parallel in numkernels
+   float dwFactor, wFactor;
+   calcMomentumFactors(dwFactor, wFactor);
+   applyMomentum(arborId, dwFactor, wFactor);
+}
+
+void MomentumUpdater::calcMomentumFactors(float &dwFactor, float &wFactor) const {
    switch (mMethod) {
-      case SIMPLE: applyMomentum(arborId, mMomentumTau, mMomentumDecay); break;
-      case VISCOSITY: applyMomentum(arborId, std::exp(-1.0f / mMomentumTau), mMomentumDecay); break;
-      case ALEX: applyMomentum(arborId, mMomentumTau, mMomentumDecay * mDWMax); break;
-      default: pvAssertMessage(0, "Unrecognized momentumMethod\n"); break;
+      case SIMPLE:
+         dwFactor = mMomentumTau;
+         wFactor  = mMomentumDecay;
+         break;
+      case VISCOSITY:
+         dwFactor = std::exp(-1.0f / mMomentumTau);
+         wFactor  = mMomentumDecay;
+         break;
+      case ALEX:
+         dwFactor = mMomentumTau;
+         wFactor  = mMomentumDecay * mDWMax;
+         break;
+      default:
+         pvAssertMessage(0, "Unrecognized momentumMethod\n");
+         dwFactor = 0.0f;
+         wFactor  = 0.0f;
+         break;
    }
 }
 
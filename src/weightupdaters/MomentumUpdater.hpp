@@ -57,10 +57,22 @@ class MomentumUpdater : public HebbianUpdater {
 
    virtual int updateWeights(int arborId) override;
 
+   /**
+    * Applies momentum to dW for the given patch, saves the result as the previous dW, and then
+    * adds it to the weights; the per-patch counterpart of updateWeights().
+    */
+   virtual void updatePatch(int arborId, int patchIndex) override;
+
    void applyMomentum(int arborId);
 
    void applyMomentum(int arborId, float dwFactor, float wFactor);
 
+   /**
+    * Computes the factors multiplying the previous dW and the current weights in the momentum
+    * update, according to the momentumMethod parameter.
+    */
+   void calcMomentumFactors(float &dwFactor, float &wFactor) const;
+
   protected:
    enum Method { UNDEFINED_METHOD, SIMPLE, VISCOSITY, ALEX };
 
@@ -0,0 +1,96 @@
+/*
+ * main.cpp for AsyncProbeOutputTest
+ *
+ * Runs a network whose probes write through the background writer, and checks that the probe
+ * output files are complete and in order when the run ends. Then checks that an AsyncPrintStream
+ * preserves the order of many small submissions.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <io/AsyncPrintStream.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+int checkProbeFiles(HyPerCol *hc, int argc, char *argv[]);
+void checkProbeFile(std::string const &path, char const *message, int numSteps);
+void checkSubmissionOrder(std::string const &path);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkProbeFiles);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkProbeFiles(HyPerCol *hc, int argc, char *argv[]) {
+   if (hc->getCommunicator()->globalCommRank() != 0) {
+      return PV_SUCCESS;
+   }
+   FatalIf(
+         !hc->getPV_InitObj()->getParams()->value(hc->getName(), "asyncProbeOutput"),
+         "AsyncProbeOutputTest must be run with asyncProbeOutput set to true.\n");
+   std::string const outputPath(hc->getOutputPath());
+   int const numSteps = 10;
+   for (int b = 0; b < hc->getNBatch(); b++) {
+      std::string const suffix = std::string("_batchElement_") + std::to_string(b) + ".txt";
+      checkProbeFile(outputPath + "/OutputStats" + suffix, "OutputStats", numSteps);
+      checkProbeFile(outputPath + "/InputStats" + suffix, "InputStats", numSteps);
+   }
+   checkSubmissionOrder(outputPath + "/submissions.txt");
+   return PV_SUCCESS;
+}
+
+void checkProbeFile(std::string const &path, char const *message, int numSteps) {
+   std::ifstream probeStream(path);
+   FatalIf(probeStream.fail(), "Unable to open probe output file \"%s\".\n", path.c_str());
+   std::string line;
+   int numLines = 0;
+   while (std::getline(probeStream, line)) {
+      char expected[64];
+      std::snprintf(expected, sizeof(expected), "%s:t==%6.1f ", message, (double)numLines);
+      FatalIf(
+            line.compare(0, std::strlen(expected), expected) != 0,
+            "Line %d of \"%s\" is \"%s\".\n",
+            numLines + 1,
+            path.c_str(),
+            line.c_str());
+      numLines++;
+   }
+   FatalIf(
+         numLines != numSteps + 1,
+         "\"%s\" has %d lines instead of %d.\n",
+         path.c_str(),
+         numLines,
+         numSteps + 1);
+}
+
+void checkSubmissionOrder(std::string const &path) {
+   int const numSubmissions = 1000;
+   {
+      auto writer = std::make_shared<PV::AsyncWriter>();
+      PV::AsyncPrintStream stream(new PV::FileStream(path.c_str(), std::ios_base::out), writer);
+      for (int n = 0; n < numSubmissions; n++) {
+         stream.printf("%d\n", n);
+         stream.submit();
+      }
+      // The destructor writes whatever is still pending.
+   }
+   std::ifstream inStream(path);
+   FatalIf(inStream.fail(), "Unable to open \"%s\".\n", path.c_str());
+   int value, expected = 0;
+   while (inStream >> value) {
+      FatalIf(
+            value != expected,
+            "\"%s\" has %d where %d was expected.\n",
+            path.c_str(),
+            value,
+            expected);
+      expected++;
+   }
+   FatalIf(
+         expected != numSubmissions,
+         "\"%s\" has %d values instead of %d.\n",
+         path.c_str(),
+         expected,
+         numSubmissions);
+}
@@ -0,0 +1,84 @@
+/*
+ * main.cpp for BenchmarkRunTest
+ *
+ * Runs a small network with the --benchmark 2 --benchmark-quiet options and checks the report
+ * written to benchmark.json, and that the quiet timed window did not write layer output.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <io/FileStream.hpp>
+#include <layers/HyPerLayer.hpp>
+#include <utils/BufferUtilsPvp.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+int checkBenchmarkReport(HyPerCol *hc, int argc, char *argv[]);
+void checkField(std::string const &report, std::string const &field);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkBenchmarkReport);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkBenchmarkReport(HyPerCol *hc, int argc, char *argv[]) {
+   auto *input = dynamic_cast<HyPerLayer *>(hc->getObjectFromName("Input"));
+   FatalIf(input == nullptr, "No layer named \"Input\".\n");
+
+   // stopTime is 10, so the timed window has the 8 steps after the 2 warm-up steps. On each step,
+   // the convolution visits every extended presynaptic neuron with its 3x3x4 patch.
+   int const numTimedSteps    = 8;
+   double localEvents         = (double)input->getNumExtendedAllBatches() * 36.0 * numTimedSteps;
+   double expectedEvents      = 0.0;
+   Communicator *communicator = hc->getCommunicator();
+   MPI_Allreduce(
+         &localEvents, &expectedEvents, 1, MPI_DOUBLE, MPI_SUM, communicator->globalCommunicator());
+   if (communicator->globalCommRank() != 0) {
+      return PV_SUCCESS;
+   }
+   PV::Configuration::IntOptional benchmarkArg =
+         hc->getPV_InitObj()->getIntOptionalArgument("Benchmark");
+   FatalIf(
+         benchmarkArg.mUseDefault or benchmarkArg.mValue != 2,
+         "BenchmarkRunTest must be run with the --benchmark 2 option.\n");
+   FatalIf(
+         !hc->getPV_InitObj()->getBooleanArgument("BenchmarkQuiet"),
+         "BenchmarkRunTest must be run with the --benchmark-quiet option.\n");
+
+   std::string const outputPath(hc->getOutputPath());
+   std::string const reportPath = outputPath + "/benchmark.json";
+   std::ifstream reportStream(reportPath);
+   FatalIf(reportStream.fail(), "Unable to open \"%s\".\n", reportPath.c_str());
+   std::stringstream buffer;
+   buffer << reportStream.rdbuf();
+   std::string const report = buffer.str();
+
+   // Each step updates the 16x16x4 neurons of Output; Input is a ConstantLayer and never updates.
+   int const numProcs = communicator->globalCommSize();
+   checkField(report, "\"numProcesses\": " + std::to_string(numProcs) + ",");
+   checkField(report, "\"warmupSteps\": 2,");
+   checkField(report, "\"timedSteps\": " + std::to_string(numTimedSteps) + ",");
+   checkField(report, "\"neuronUpdates\": " + std::to_string(numTimedSteps * 16 * 16 * 4) + ",");
+   checkField(report, "\"synapticEvents\": " + std::to_string((long)expectedEvents) + ",");
+   checkField(report, "{\"phase\": 0,");
+   checkField(report, "{\"phase\": 1,");
+
+   // Output is written at time 0 and after each warm-up step, but not during the timed window.
+   std::string const outputLayerPath = outputPath + "/Output.pvp";
+   PV::FileStream outputLayerStream(outputLayerPath.c_str(), std::ios_base::in, false);
+   BufferUtils::ActivityHeader header = BufferUtils::readActivityHeader(outputLayerStream);
+   FatalIf(
+         header.nBands != 3,
+         "\"%s\" has %d frames instead of 3.\n",
+         outputLayerPath.c_str(),
+         header.nBands);
+   return PV_SUCCESS;
+}
+
+void checkField(std::string const &report, std::string const &field) {
+   FatalIf(
+         report.find(field) == std::string::npos,
+         "benchmark.json does not contain %s\n",
+         field.c_str());
+}
@@ -2,6 +2,7 @@
 #include "utils/BufferUtilsRescale.hpp"
 #include "utils/PVLog.hpp"
 
+#include <cmath>
 #include <vector>
 
 using PV::Buffer;
@@ -346,6 +347,97 @@ void testRescale() {
    }
 }
 
+float bicubicKernel(float x) {
+   float const absx = std::fabs(x);
+   return absx < 1 ? 1 + absx * absx * (-2 + absx) : absx < 2 ? 4 + absx * (-8 + absx * (5 - absx))
+                                                              : 0;
+}
+
+int reflect(int index, int size) {
+   if (index < 0) {
+      index = -index;
+   }
+   if (index >= size) {
+      index = size - (index - size) - 1;
+   }
+   return index;
+}
+
+// Bicubic interpolation of one output value, applying the 4x4 kernel directly.
+float bicubicReference(
+      Buffer<float> const &input,
+      int widthOut,
+      int heightOut,
+      int x,
+      int y,
+      int f) {
+   float const dx     = (float)(input.getWidth() - 1) / (float)(widthOut - 1);
+   float const dy     = (float)(input.getHeight() - 1) / (float)(heightOut - 1);
+   float const xIn    = dx * (float)x;
+   float const yIn    = dy * (float)y;
+   float const xFloor = std::floor(xIn);
+   float const yFloor = std::floor(yIn);
+   float value        = 0.0f;
+   for (int yOff = -1; yOff <= 2; yOff++) {
+      int const yFetch   = reflect((int)yFloor + yOff, input.getHeight());
+      float const yCoeff = bicubicKernel(yIn - yFloor - (float)yOff);
+      for (int xOff = -1; xOff <= 2; xOff++) {
+         int const xFetch   = reflect((int)xFloor + xOff, input.getWidth());
+         float const xCoeff = bicubicKernel(xIn - xFloor - (float)xOff);
+         value += xCoeff * yCoeff * input.at(xFetch, yFetch, f);
+      }
+   }
+   return value;
+}
+
+// BufferUtils::rescale with BICUBIC interpolation, compared with the 4x4 kernel applied directly,
+// and BufferUtils::rescaledRegion, compared with rescaling a buffer of ones.
+void testRescaleBicubic() {
+   int const width    = 12;
+   int const height   = 9;
+   int const features = 3;
+   Buffer<float> input(width, height, features);
+   for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+         for (int f = 0; f < features; ++f) {
+            input.set(x, y, f, (float)((x * 7 + y * 3 + f * 5) % 11) + 0.25f * (float)f);
+         }
+      }
+   }
+
+   // Shrinking to 8 columns gives 6 rows; PAD then adds a row above and below.
+   Buffer<float> bicubic = input;
+   BufferUtils::rescale(
+         bicubic, 8, 8, BufferUtils::PAD, BufferUtils::BICUBIC, Buffer<float>::CENTER);
+   FatalIf(
+         bicubic.getWidth() != 8 or bicubic.getHeight() != 8 or bicubic.getFeatures() != features,
+         "Failed (Bicubic size).\n");
+   for (int y = 0; y < 6; ++y) {
+      for (int x = 0; x < 8; ++x) {
+         for (int f = 0; f < features; ++f) {
+            float const expected = bicubicReference(input, 8, 6, x, y, f);
+            float const observed = bicubic.at(x, y + 1, f);
+            FatalIf(
+                  std::fabs(observed - expected) > 1.0e-5f * (1.0f + std::fabs(expected)),
+                  "Failed (Bicubic). Expected %f at (%d, %d, %d), found %f.\n",
+                  (double)expected,
+                  x,
+                  y,
+                  f,
+                  (double)observed);
+         }
+      }
+   }
+
+   Buffer<float> ones(std::vector<float>(width * height * features, 1.0f), width, height, features);
+   BufferUtils::rescale(ones, 8, 8, BufferUtils::PAD, BufferUtils::NEAREST, Buffer<float>::CENTER);
+   Buffer<float> region = BufferUtils::rescaledRegion(
+         width, height, features, 8, 8, BufferUtils::PAD, Buffer<float>::CENTER);
+   FatalIf(
+         region.asVector() != ones.asVector(),
+         "Failed (Region). The region differs from a rescaled buffer of ones.\n");
+}
+
 int main(int argc, char **argv) {
    InfoLog() << "Testing Buffer::at(): ";
    testAtSet();
@@ -371,6 +463,10 @@ int main(int argc, char **argv) {
    testRescale();
    InfoLog() << "Completed.\n";
 
+   InfoLog() << "Testing BufferUtils::rescale() with bicubic interpolation: ";
+   testRescaleBicubic();
+   InfoLog() << "Completed.\n";
+
    InfoLog() << "Buffer tests completed successfully!\n";
    return EXIT_SUCCESS;
 }
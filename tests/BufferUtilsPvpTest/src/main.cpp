@@ -1,8 +1,13 @@
 #include "structures/Buffer.hpp"
 #include "structures/SparseList.hpp"
+#include "utils/BufferUtilsCompress.hpp"
 #include "utils/BufferUtilsPvp.hpp"
 #include "utils/PVLog.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
 #include <vector>
 
 using PV::Buffer;
@@ -262,6 +267,164 @@ void testReadFromSparseBinaryPvp() {
       }
    }
 }
+void testWriteLosslessPvp() {
+
+   // Writes three frames compressed without loss, large enough to span several compression
+   // blocks and mostly zero, as sparse activity would be, then reads them back out of order.
+   int const nx = 64, ny = 64, nf = 8;
+   vector<vector<float>> allFrames(3);
+   {
+      PV::FileStream fStream("lossless.pvp", std::ios_base::out | std::ios_base::binary, true);
+      BufferUtils::ActivityHeader header = BufferUtils::buildActivityHeader<float>(nx, ny, nf, 3);
+      header.dataType                    = BufferUtils::LOSSLESS_FLOAT;
+      BufferUtils::writeActivityHeader(fStream, header);
+      for (int frame = 0; frame < 3; ++frame) {
+         vector<float> testData(nx * ny * nf, 0.0f);
+         for (int i = frame; i < nx * ny * nf; i += 7) {
+            testData.at(i) = 1.0f / (float)(i + 1);
+         }
+         allFrames.at(frame) = testData;
+         Buffer<float> outBuffer(testData, nx, ny, nf);
+         BufferUtils::writeLosslessFrame<float>(fStream, &outBuffer, (double)(frame + 1));
+      }
+   }
+
+   // Reads the frames once without a frame table, and again through a cached one.
+   BufferUtils::SparseFileTable frameTable;
+   std::vector<BufferUtils::SparseFileTable *> const tables = {nullptr, &frameTable};
+   for (BufferUtils::SparseFileTable *cachedTable : tables) {
+      for (int frame : {2, 0, 1}) {
+         Buffer<float> testBuffer;
+         double timeVal = BufferUtils::readDenseFromPvp<float>(
+               "lossless.pvp", &testBuffer, frame, cachedTable);
+         FatalIf(
+               timeVal != (double)frame + 1,
+               "Failed on frame %d. Expected time %d, found %d.\n",
+               frame,
+               frame + 1,
+               (int)timeVal);
+         FatalIf(
+               testBuffer.getWidth() != nx or testBuffer.getHeight() != ny
+                     or testBuffer.getFeatures() != nf,
+               "Failed on frame %d. Buffer has the wrong dimensions.\n",
+               frame);
+         vector<float> readData = testBuffer.asVector();
+         FatalIf(
+               readData != allFrames.at(frame),
+               "Failed on frame %d. Data read back differs from data written.\n",
+               frame);
+      }
+   }
+   FatalIf(
+         frameTable.frameStartOffsets.size() != (std::size_t)3,
+         "The cached frame table has %zu frames instead of 3.\n",
+         frameTable.frameStartOffsets.size());
+}
+
+// Reads an LZ4 count that continues through bytes of 255.
+int readLZ4Count(unsigned char const *&in, int count) {
+   unsigned char byte;
+   do {
+      byte = *in++;
+      count += (int)byte;
+   } while (byte == 255);
+   return count;
+}
+
+// Walks the sequences of a compressed block and checks the rules that an LZ4 decoder enforces at
+// the end of a block: no match starts within the last 12 bytes, no match extends into the last
+// 5 bytes, and the last sequence has no match.
+void checkLZ4Block(unsigned char const *in, int inSize, int blockSize, char const *description) {
+   unsigned char const *inEnd = in + inSize;
+   int pos                    = 0;
+   while (in < inEnd) {
+      int const token = (int)*in++;
+      int numLiterals = token >> 4;
+      if (numLiterals == 15) {
+         numLiterals = readLZ4Count(in, numLiterals);
+      }
+      in += numLiterals;
+      pos += numLiterals;
+      if (in == inEnd) {
+         break;
+      }
+      in += 2; // offset
+      int matchLength = token & 0x0f;
+      if (matchLength == 15) {
+         matchLength = readLZ4Count(in, matchLength);
+      }
+      matchLength += 4;
+      FatalIf(
+            pos > blockSize - 12,
+            "%s: a match starts at %d, within 12 bytes of the end of a %d-byte block.\n",
+            description,
+            pos,
+            blockSize);
+      FatalIf(
+            pos + matchLength > blockSize - 5,
+            "%s: a match ends at %d, within 5 bytes of the end of a %d-byte block.\n",
+            description,
+            pos + matchLength,
+            blockSize);
+      pos += matchLength;
+   }
+   FatalIf(
+         pos != blockSize,
+         "%s: the block decodes to %d bytes instead of %d.\n",
+         description,
+         pos,
+         blockSize);
+}
+
+void testLosslessIsLZ4() {
+
+   // Compresses data of several kinds and sizes, checks that each compressed block keeps the
+   // LZ4 end-of-block rules, and that the chunk decompresses to the original data.
+   std::uint32_t const storedFlag = (std::uint32_t)1 << 31;
+   for (int pattern = 0; pattern < 4; ++pattern) {
+      for (int numValues : {3, 40, 1000, 40000}) {
+         vector<float> data(numValues);
+         for (int k = 0; k < numValues; ++k) {
+            switch (pattern) {
+               case 0: data[k] = 0.0f; break;
+               case 1: data[k] = (float)(k % 17) * 0.5f; break;
+               case 2: data[k] = (k * 7919) % 23 == 0 ? (float)(k % 5) : 0.0f; break;
+               case 3: data[k] = (float)((k / 7) % 3); break;
+            }
+         }
+         std::string const description = std::string("pattern ") + std::to_string(pattern)
+                                         + ", " + std::to_string(numValues) + " values";
+         std::size_t const size        = data.size() * sizeof(float);
+         vector<unsigned char> chunk =
+               BufferUtils::compressLossless(data.data(), size, sizeof(float));
+
+         std::uint32_t numBlocks;
+         std::memcpy(&numBlocks, &chunk[12], sizeof(numBlocks));
+         std::size_t payloadPos = 16 + 4 * (std::size_t)numBlocks;
+         for (std::uint32_t b = 0; b < numBlocks; ++b) {
+            std::uint32_t record;
+            std::memcpy(&record, &chunk[16 + 4 * b], sizeof(record));
+            std::size_t const blockStart = b * BufferUtils::losslessBlockSize;
+            std::size_t const blockSize =
+                  std::min(BufferUtils::losslessBlockSize, size - blockStart);
+            int const payloadSize = (int)(record & ~storedFlag);
+            if (!(record & storedFlag)) {
+               checkLZ4Block(
+                     &chunk[payloadPos], payloadSize, (int)blockSize, description.c_str());
+            }
+            payloadPos += (std::size_t)payloadSize;
+         }
+
+         vector<float> readBack(numValues);
+         BufferUtils::decompressLossless(chunk.data(), chunk.size(), readBack.data(), size);
+         FatalIf(
+               readBack != data,
+               "%s: the data decompressed differ from the data compressed.\n",
+               description.c_str());
+      }
+   }
+}
+
 int main(int argc, char **argv) {
 
    InfoLog() << "Testing BufferUtils:readDenseFromPvp(): ";
@@ -284,6 +447,14 @@ int main(int argc, char **argv) {
    testReadFromSparseBinaryPvp();
    InfoLog() << "Completed.\n";
 
+   InfoLog() << "Testing BufferUtils:writeLosslessFrame(): ";
+   testWriteLosslessPvp();
+   InfoLog() << "Completed.\n";
+
+   InfoLog() << "Testing BufferUtils:compressLossless() output is LZ4: ";
+   testLosslessIsLZ4();
+   InfoLog() << "Completed.\n";
+
    InfoLog() << "BufferUtils tests completed successfully!\n";
    return EXIT_SUCCESS;
 }
@@ -41,6 +41,9 @@ int main(int argc, char *argv[]) {
    FatalIf(configParser.getIntegerArgument("NumRows") != 2, "Parsing NumRows failed.\n");
    FatalIf(configParser.getIntegerArgument("NumColumns") != 3, "Parsing NumColumns failed.\n");
    FatalIf(configParser.getIntegerArgument("BatchWidth") != 4, "Parsing BatchWidth failed.\n");
+   FatalIf(
+         configParser.getBooleanArgument("AutoDecomposition") != true,
+         "Parsing AutoDecomposition failed.\n");
    FatalIf(
          configParser.getStringArgument("OutputPath") != "outputPath",
          "Parsing OutputPath failed.\n");
@@ -54,5 +57,26 @@ int main(int argc, char *argv[]) {
    FatalIf(
          configParser.getStringArgument("CheckpointReadDirectory") != "outputPath/checkpoints",
          "Parsing CheckpointReadDirectory failed.\n");
+   FatalIf(
+         configParser.getStringArgument("TraceFile") != "trace.json",
+         "Parsing TraceFile failed.\n");
+   PV::Configuration::IntOptional benchmark = configParser.getIntOptionalArgument("Benchmark");
+   FatalIf(benchmark.mUseDefault != false, "Parsing Benchmark failed.\n");
+   FatalIf(benchmark.mValue != 5, "Parsing Benchmark failed.\n");
+   FatalIf(
+         configParser.getBooleanArgument("BenchmarkQuiet") != true,
+         "Parsing BenchmarkQuiet failed.\n");
+   FatalIf(
+         configParser.getStringArgument("CostCalibration") != "benchmarks.json",
+         "Parsing CostCalibration failed.\n");
+   FatalIf(configParser.getStringArgument("Serve") != "/tmp/pv.sock", "Parsing Serve failed.\n");
+   FatalIf(
+         configParser.getStringArgument("ServeInput") != "Input", "Parsing ServeInput failed.\n");
+   FatalIf(
+         configParser.getStringArgument("ServeOutput") != "Output",
+         "Parsing ServeOutput failed.\n");
+   FatalIf(
+         configParser.getStringArgument("ParamsCache") != "params.cache",
+         "Parsing ParamsCache failed.\n");
    return 0;
 }
@@ -0,0 +1,131 @@
+/*
+ * main.cpp for CostModelTest
+ *
+ * Runs a small network with the dry-run flag, and checks the cost model's predictions for the
+ * input layer and the plastic connection, and its suggested decompositions of four processes.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <columns/CostModel.hpp>
+#include <layers/HyPerLayer.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+int checkCostModel(HyPerCol *hc, int argc, char *argv[]);
+void checkCalibration(HyPerCol *hc);
+void checkValue(std::string const &description, double observed, double expected);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkCostModel);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkCostModel(HyPerCol *hc, int argc, char *argv[]) {
+   FatalIf(
+         !hc->getPV_InitObj()->getBooleanArgument("DryRun"),
+         "CostModelTest must be run with the -n option.\n");
+   CostModel const *costModel = hc->getCostModel();
+   FatalIf(costModel == nullptr, "The dry run did not create a cost model.\n");
+   auto *input = dynamic_cast<HyPerLayer *>(hc->getObjectFromName("Input"));
+   FatalIf(input == nullptr, "No layer named \"Input\".\n");
+   PVHalo const &halo = input->getLayerLoc()->halo;
+   FatalIf(
+         halo.lt != 2 or halo.rt != 2 or halo.dn != 2 or halo.up != 2,
+         "Input should have margins of 2 after the CommunicateInitInfo stage.\n");
+
+   // On one process, Input is 16x16x2 with a margin of 2, and the batch has 2 elements.
+   std::vector<CostModel::Estimate> estimates = costModel->estimate({1, 1, 1});
+   FatalIf(
+         estimates.size() != (std::size_t)3,
+         "Expected 3 estimates, got %zu.\n",
+         estimates.size());
+   CostModel::Estimate const &inputEstimate = estimates[0];
+   FatalIf(inputEstimate.mName != "Input", "The first estimate is not Input's.\n");
+   double const numChannels = (double)input->getNumChannels();
+   double const numDelays   = (double)input->getNumDelayLevels();
+   checkValue("Input FLOPs", inputEstimate.mFlops, (numChannels + 3.0) * 512.0 * 2.0);
+   checkValue(
+         "Input state bytes",
+         inputEstimate.mStateBytes,
+         4.0 * 2.0 * (512.0 * (1.0 + numChannels) + 800.0 * (1.0 + numDelays)));
+   checkValue("Input exchange bytes on one process", inputEstimate.mExchangeBytes, 0.0);
+
+   // Presynaptic delivery visits the 20x20x2 extended input neurons with 5x5x4 patches. The
+   // shared weights have one kernel per input feature, and are updated every second step.
+   CostModel::Estimate const &connEstimate = estimates[2];
+   FatalIf(connEstimate.mName != "InputToOutput", "The last estimate is not InputToOutput's.\n");
+   double const synapses    = 800.0 * 100.0 * 2.0;
+   double const weightBytes = 4.0 * 200.0 + 4.0 * 800.0;
+   double threadGSynBytes   = 0.0;
+   if (hc->getNumThreads() > 1) {
+      threadGSynBytes = 4.0 * (double)hc->getNumThreads() * 16.0 * 16.0 * 4.0;
+   }
+   checkValue("InputToOutput FLOPs", connEstimate.mFlops, 2.0 * synapses);
+   checkValue("InputToOutput learning FLOPs", connEstimate.mLearningFlops, synapses);
+   checkValue(
+         "InputToOutput state bytes",
+         connEstimate.mStateBytes,
+         2.0 * weightBytes + 8.0 * 200.0 + threadGSynBytes);
+   checkValue("InputToOutput exchange bytes on one process", connEstimate.mExchangeBytes, 0.0);
+
+   // Splitting the columns and the batch halves the local input, whose halo is exchanged on each
+   // timestep, and the weight changes are reduced on every second step.
+   estimates = costModel->estimate({1, 2, 2});
+   checkValue(
+         "Input exchange bytes for 1x2x2", estimates[0].mExchangeBytes, 4.0 * (480.0 - 256.0));
+   checkValue("InputToOutput exchange bytes for 1x2x2", estimates[2].mExchangeBytes, 400.0);
+
+   FatalIf(costModel->isValid({3, 1, 1}), "16 rows should not divide among 3 processes.\n");
+   FatalIf(costModel->isValid({1, 1, 4}), "A batch of 2 should not divide among 4 processes.\n");
+   FatalIf(costModel->isValid({16, 1, 1}), "Local layers should not be narrower than margins.\n");
+
+   // Of the decompositions of 4 processes, those that split the batch exchange the smallest halos.
+   std::vector<CostModel::Decomposition> suggestions = costModel->suggestDecompositions(4, 10);
+   FatalIf(suggestions.size() != (std::size_t)5, "Expected 5 suggestions.\n");
+   FatalIf(suggestions[0].mBatchWidth != 2, "The best suggestion should split the batch.\n");
+   FatalIf(
+         costModel->predictStepSeconds(suggestions[0])
+               > costModel->predictStepSeconds({2, 2, 1}),
+         "The best suggestion is predicted to be slower than 2 rows and 2 columns.\n");
+
+   checkCalibration(hc);
+   return PV_SUCCESS;
+}
+
+void checkCalibration(HyPerCol *hc) {
+   // A calibration file in the format written by pvbenchmarks. Each rate is the median of the
+   // throughputs of the cases with the corresponding name.
+   std::string const path = std::string(hc->getOutputPath()) + "/calibration_"
+                            + std::to_string(hc->getCommunicator()->globalCommRank()) + ".json";
+   std::ofstream calibrationStream(path);
+   calibrationStream << "{\n  \"results\": [\n";
+   calibrationStream << "    {\"name\": \"ConvolveDelivery\", \"throughput\": 1e9},\n";
+   calibrationStream << "    {\"name\": \"ConvolveDelivery\", \"throughput\": 3e9},\n";
+   calibrationStream << "    {\"name\": \"ConvolveDelivery\", \"throughput\": 4e9},\n";
+   calibrationStream << "    {\"name\": \"PoolingDelivery\", \"throughput\": 5e9},\n";
+   calibrationStream << "    {\"name\": \"BorderExchange\", \"throughput\": 2e8}\n";
+   calibrationStream << "  ]\n}\n";
+   calibrationStream.close();
+
+   CostModel costModel(1, 1.0);
+   double const defaultLearningRate = costModel.getLearningSynapsesPerSecond();
+   costModel.calibrate(path);
+   FatalIf(!costModel.isCalibrated(), "Calibrating the cost model failed.\n");
+   checkValue("Calibrated synapses per second", costModel.getSynapsesPerSecond(), 3.0e9);
+   checkValue("Calibrated exchange bytes per second", costModel.getExchangeBytesPerSecond(), 2.0e8);
+   checkValue(
+         "Learning synapses per second without a HebbianUpdate case",
+         costModel.getLearningSynapsesPerSecond(),
+         defaultLearningRate);
+}
+
+void checkValue(std::string const &description, double observed, double expected) {
+   FatalIf(
+         observed != expected,
+         "%s is %.17g instead of %.17g.\n",
+         description.c_str(),
+         observed,
+         expected);
+}
@@ -0,0 +1,136 @@
+/*
+ * main.cpp for DecompositionSearchTest
+ *
+ * Checks DecompositionSearch's choice for layers added directly, and then the decomposition
+ * that the --auto-decomposition flag chooses for the params file, and runs the network with it.
+ */
+
+#include <columns/DecompositionSearch.hpp>
+#include <columns/buildandrun.hpp>
+
+using namespace PV;
+
+void checkChoice(
+      DecompositionSearch const &search,
+      int rows,
+      int columns,
+      int batchWidth,
+      char const *description);
+void checkSearch();
+void checkAutoDecomposition(PV_Init *pv_init);
+
+int main(int argc, char *argv[]) {
+   PV_Init pv_init{&argc, &argv, false /*do not allow unrecognized arguments*/};
+   checkSearch();
+   if (pv_init.isExtraProc()) {
+      return EXIT_SUCCESS;
+   }
+   checkAutoDecomposition(&pv_init);
+   int status = buildandrun(&pv_init);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void checkChoice(
+      DecompositionSearch const &search,
+      int rows,
+      int columns,
+      int batchWidth,
+      char const *description) {
+   DecompositionSearch::Candidate best = search.findBest();
+   FatalIf(
+         best.mRows != rows or best.mColumns != columns or best.mBatchWidth != batchWidth,
+         "%s: expected %d rows, %d columns and batch width %d; got %d, %d and %d.\n",
+         description,
+         rows,
+         columns,
+         batchWidth,
+         best.mRows,
+         best.mColumns,
+         best.mBatchWidth);
+}
+
+void checkSearch() {
+   // A wide layer exchanges the smallest halo when it is split into columns only.
+   DecompositionSearch search(4);
+   search.addLayer("Wide", 64, 16, 1);
+   search.requireMargins("Wide", 2, 2);
+   checkChoice(search, 1, 4, 1, "64x16 layer on 4 processes");
+
+   // Checkpoint cells of two rows restrict the search to an even number of rows.
+   search.setCheckpointCellSize(2, 0, 0);
+   checkChoice(search, 2, 2, 1, "64x16 layer with 2-row checkpoint cells");
+   search.setCheckpointCellSize(0, 0, 0);
+
+   // Splitting the batch needs no border exchange.
+   search.setBatchSize(4);
+   checkChoice(search, 1, 1, 4, "64x16 layer with a batch of 4");
+
+   // A margin wider than the local layer rules out the decompositions that would need it.
+   DecompositionSearch narrow(4);
+   narrow.addLayer("Narrow", 8, 8, 1);
+   narrow.requireMargins("Narrow", 3, 3);
+   std::vector<DecompositionSearch::Candidate> candidates = narrow.search();
+   for (auto const &c : candidates) {
+      FatalIf(
+            c.mRows > 2 or c.mColumns > 2,
+            "8x8 layer with margin 3 should not be divided into %d rows and %d columns.\n",
+            c.mRows,
+            c.mColumns);
+   }
+
+   // Every candidate uses all the processes. The decompositions of 16x16 with a batch of 2 into
+   // 2 processes would leave one of 3 processes idle, so there are none.
+   DecompositionSearch partial(3);
+   partial.addLayer("Layer", 16, 16, 1);
+   partial.setBatchSize(2);
+   FatalIf(
+         !partial.search().empty(),
+         "16x16 layer with a batch of 2 on 3 processes should have no decomposition.\n");
+   for (auto const &c : search.search()) {
+      FatalIf(
+            c.mRows * c.mColumns * c.mBatchWidth != 4,
+            "The decomposition into %d rows, %d columns and batch width %d does not use all 4 "
+            "processes.\n",
+            c.mRows,
+            c.mColumns,
+            c.mBatchWidth);
+   }
+}
+
+void checkAutoDecomposition(PV_Init *pv_init) {
+   FatalIf(
+         !pv_init->getBooleanArgument("AutoDecomposition"),
+         "DecompositionSearchTest must be run with the --auto-decomposition flag.\n");
+   Communicator *communicator = pv_init->getCommunicator();
+   int worldSize;
+   MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+
+   DecompositionSearch search(worldSize);
+   search.addParams(pv_init->getParams());
+   DecompositionSearch::Candidate best = search.findBest();
+   if (worldSize == 1) {
+      checkChoice(search, 1, 1, 1, "params file on 1 process");
+   }
+   else if (worldSize == 2) {
+      checkChoice(search, 1, 1, 2, "params file on 2 processes");
+   }
+   else if (worldSize == 4) {
+      checkChoice(search, 1, 2, 2, "params file on 4 processes");
+   }
+   FatalIf(
+         communicator->numCommRows() != best.mRows
+               or communicator->numCommColumns() != best.mColumns
+               or communicator->numCommBatches() != best.mBatchWidth,
+         "Communicator has %d rows, %d columns and batch width %d instead of %d, %d and %d.\n",
+         communicator->numCommRows(),
+         communicator->numCommColumns(),
+         communicator->numCommBatches(),
+         best.mRows,
+         best.mColumns,
+         best.mBatchWidth);
+   FatalIf(
+         pv_init->getIntegerArgument("NumRows") != best.mRows
+               or pv_init->getIntegerArgument("NumColumns") != best.mColumns
+               or pv_init->getIntegerArgument("BatchWidth") != best.mBatchWidth,
+         "The chosen decomposition was not recorded in the arguments.\n");
+}
@@ -0,0 +1,177 @@
+/*
+ * main.cpp for EmbeddedColumnTest
+ *
+ * Builds a column from a params string with EmbeddedColumn, and drives it a step at a time past
+ * its stopTime: pushes float and uint8 frames into an ImageFromMemoryBuffer layer, and checks the
+ * views of the layers' activity and V, the view of the weights (including that a change made
+ * through the view is seen by the column), and the values of a probe.
+ */
+
+#include "bindings/EmbeddedColumn.hpp"
+#include "columns/PV_Init.hpp"
+#include "utils/PVLog.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using PV::EmbeddedColumn;
+
+int const nx = 8;
+int const ny = 6;
+
+char const *paramsString =
+      "debugParsing = false;\n"
+      "HyPerCol \"column\" = {\n"
+      "   dt = 1; stopTime = 2; progressInterval = 10; writeProgressToErr = false;\n"
+      "   verifyWrites = false; outputPath = \"output/\"; printParamsFilename = \"pv.params\";\n"
+      "   randomSeed = 1234567890; nx = 8; ny = 6; nbatch = 1;\n"
+      "   initializeFromCheckpointDir = \"\"; checkpointWrite = false;\n"
+      "   lastCheckpointDir = \"output/Last\"; errorOnNotANumber = true;\n"
+      "};\n"
+      "ImageFromMemoryBuffer \"Input\" = {\n"
+      "   nxScale = 1; nyScale = 1; nf = 1; phase = 0; writeStep = -1; mirrorBCflag = false;\n"
+      "   valueBC = 0.0; sparseLayer = false; displayPeriod = 0; offsetAnchor = \"tl\";\n"
+      "   offsetX = 0; offsetY = 0; autoResizeFlag = false; inverseFlag = false;\n"
+      "   normalizeLuminanceFlag = false; useInputBCflag = false; padValue = 0;\n"
+      "};\n"
+      "ANNLayer \"Output\" = {\n"
+      "   nxScale = 1; nyScale = 1; nf = 1; phase = 1; writeStep = -1; mirrorBCflag = false;\n"
+      "   valueBC = 0.0; sparseLayer = false; triggerLayerName = NULL; InitVType = \"ZeroV\";\n"
+      "   VThresh = -infinity; AMax = infinity; AMin = -infinity; AShift = 0.0; VWidth = 0.0;\n"
+      "};\n"
+      "HyPerConn \"InputToOutput\" = {\n"
+      "   preLayerName = \"Input\"; postLayerName = \"Output\"; channelCode = 0; delay = [0.0];\n"
+      "   numAxonalArbors = 1; plasticityFlag = false; sharedWeights = true; nxp = 1; nyp = 1;\n"
+      "   weightInitType = \"UniformWeight\"; weightInit = 2.0; connectOnlySameFeatures = false;\n"
+      "   normalizeMethod = \"none\"; pvpatchAccumulateType = \"convolve\";\n"
+      "   convertRateToSpikeCount = false; updateGSynFromPostPerspective = false;\n"
+      "   writeStep = -1; writeCompressedCheckpoints = false;\n"
+      "};\n"
+      "L2NormProbe \"OutputL2Norm\" = {\n"
+      "   targetLayer = \"Output\"; message = NULL; textOutputFlag = false;\n"
+      "   triggerLayerName = NULL; energyProbe = NULL; maskLayerName = NULL; exponent = 2;\n"
+      "};\n";
+
+void checkShape(EmbeddedColumn::View const &view, int s0, int s1, int s2, int s3, char const *n) {
+   FatalIf(view.data == nullptr, "%s view is null.\n", n);
+   FatalIf(
+         view.shape[0] != s0 or view.shape[1] != s1 or view.shape[2] != s2 or view.shape[3] != s3,
+         "%s view has shape (%d, %d, %d, %d) instead of (%d, %d, %d, %d).\n",
+         n,
+         view.shape[0],
+         view.shape[1],
+         view.shape[2],
+         view.shape[3],
+         s0,
+         s1,
+         s2,
+         s3);
+}
+
+// Checks that the input is the frame, and that the output's V and activity are weight times the
+// frame, and, after the first timestep, that the probe's value is the sum of their squares.
+void checkStep(EmbeddedColumn &column, std::vector<float> const &frame, float weight) {
+   EmbeddedColumn::View input  = column.getActivity("Input");
+   EmbeddedColumn::View output = column.getActivity("Output");
+   EmbeddedColumn::View V      = column.getV("Output");
+   checkShape(input, 1, ny, nx, 1, "Input activity");
+   checkShape(output, 1, ny, nx, 1, "Output activity");
+   checkShape(V, 1, ny, nx, 1, "Output V");
+   double sumSquares = 0.0;
+   for (int k = 0; k < nx * ny; k++) {
+      float const expected = weight * frame[k];
+      FatalIf(
+            input.data[k] != frame[k],
+            "At time %g, Input[%d] is %g instead of %g.\n",
+            column.getSimulationTime(),
+            k,
+            (double)input.data[k],
+            (double)frame[k]);
+      FatalIf(
+            V.data[k] != expected or output.data[k] != expected,
+            "At time %g, Output V[%d] is %g and A[%d] is %g instead of %g.\n",
+            column.getSimulationTime(),
+            k,
+            (double)V.data[k],
+            k,
+            (double)output.data[k],
+            (double)expected);
+      sumSquares += (double)expected * (double)expected;
+   }
+   std::vector<double> values;
+   if (column.getSimulationTime() == 0.0) {
+      FatalIf(
+            column.getProbeValues("OutputL2Norm", &values) == PV_SUCCESS,
+            "getProbeValues succeeded before the first timestep.\n");
+      return;
+   }
+   FatalIf(
+         column.getProbeValues("OutputL2Norm", &values) != PV_SUCCESS,
+         "getProbeValues failed.\n");
+   FatalIf(values.size() != (std::size_t)1, "The probe has %zu values.\n", values.size());
+   FatalIf(
+         std::fabs(values[0] - sumSquares) > 1.0e-5 * sumSquares,
+         "At time %g, the probe value is %g instead of %g.\n",
+         column.getSimulationTime(),
+         values[0],
+         sumSquares);
+}
+
+int main(int argc, char *argv[]) {
+   PV::PV_Init initObj(&argc, &argv, false /*allowUnrecognizedArguments*/);
+   EmbeddedColumn column(&initObj, std::string(paramsString));
+
+   FatalIf(column.getActivity("Input").data != nullptr, "A view was returned before allocation.\n");
+   FatalIf(column.advance(0) != PV_SUCCESS, "advance(0) failed.\n");
+   FatalIf(column.getSimulationTime() != 0.0, "advance(0) advanced the column.\n");
+   std::vector<float> zeros(nx * ny, 0.0f);
+   checkStep(column, zeros, 2.0f);
+
+   FatalIf(column.getActivity("NoSuchLayer").data != nullptr, "Found a nonexistent layer.\n");
+   FatalIf(column.getV("Input").data != nullptr, "Found V for an input layer.\n");
+   FatalIf(column.getWeights("InputToOutput", 1).data != nullptr, "Found a nonexistent arbor.\n");
+   std::vector<double> values;
+   FatalIf(column.getProbeValues("Output", &values) == PV_SUCCESS, "Found a nonexistent probe.\n");
+
+   std::vector<float> floatFrame(nx * ny);
+   for (int k = 0; k < nx * ny; k++) {
+      floatFrame[k] = (float)(k % 7) * 0.125f;
+   }
+   FatalIf(
+         column.setInput("Output", floatFrame.data(), ny, nx, 1, 0.0f, 1.0f) == PV_SUCCESS,
+         "setInput accepted a layer that is not an ImageFromMemoryBuffer.\n");
+   FatalIf(
+         column.setInput("Input", floatFrame.data(), ny, nx, 1, 0.0f, 1.0f) != PV_SUCCESS,
+         "setInput failed.\n");
+   column.advance(1);
+   checkStep(column, floatFrame, 2.0f);
+
+   // Without a new frame, the input is unchanged. The column runs past its stopTime.
+   column.advance(2);
+   FatalIf(column.getSimulationTime() != 3.0, "The time is %g.\n", column.getSimulationTime());
+   checkStep(column, floatFrame, 2.0f);
+
+   // Weights changed through the view are used by the next step.
+   EmbeddedColumn::View weights = column.getWeights("InputToOutput", 0);
+   checkShape(weights, 1, 1, 1, 1, "InputToOutput weights");
+   FatalIf(weights.data[0] != 2.0f, "The weight is %g.\n", (double)weights.data[0]);
+   weights.data[0] = 3.0f;
+
+   std::vector<std::uint8_t> byteFrame(nx * ny);
+   std::vector<float> byteFrameValues(nx * ny);
+   for (int k = 0; k < nx * ny; k++) {
+      byteFrame[k]       = (std::uint8_t)((k * 37) % 256);
+      byteFrameValues[k] = (float)byteFrame[k] / 255.0f;
+   }
+   column.setInput("Input", byteFrame.data(), ny, nx, 1, (std::uint8_t)0, (std::uint8_t)255);
+   column.advance(1);
+   checkStep(column, byteFrameValues, 3.0f);
+
+   column.finish();
+   FatalIf(column.advance(1) == PV_SUCCESS, "The column advanced after finish().\n");
+   checkStep(column, byteFrameValues, 3.0f);
+
+   InfoLog() << "Test passed." << std::endl;
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * main.cpp for FileContainerTest
+ *
+ * Writes files into a mounted FileContainer through FileStream and BufferUtils,
+ * saves the container both as a per-process file and as a shared MPI-IO file,
+ * and verifies that reading through the mounted containers recovers the data.
+ * Also writes a container only as a shared file, and checks that no temporary image
+ * is left behind.
+ */
+
+#include "columns/CommandLineArguments.hpp"
+#include "columns/Communicator.hpp"
+#include "io/FileContainer.hpp"
+#include "io/FileStream.hpp"
+#include "io/fileio.hpp"
+#include "structures/Buffer.hpp"
+#include "structures/MPIBlock.hpp"
+#include "utils/BufferUtilsPvp.hpp"
+#include "utils/PVLog.hpp"
+
+#include <sys/stat.h>
+#include <vector>
+
+using PV::Buffer;
+using PV::FileContainer;
+using PV::FileStream;
+namespace BufferUtils = PV::BufferUtils;
+
+// Each process writes values that depend on its rank, so that reading the wrong block
+// of a shared container is detected.
+std::vector<float> makeData(int rank, int frame) {
+   std::vector<float> data(8 * 4 * 2);
+   for (std::size_t i = 0; i < data.size(); i++) {
+      data[i] = (float)(1000 * rank + 100 * frame) + (float)i;
+   }
+   return data;
+}
+
+void writeEntries(std::string const &mountPoint, int rank) {
+   // A pvp file that is created and then extended by reopening it for reading and writing.
+   std::string pvpPath = mountPoint + "/buffer.pvp";
+   for (int frame = 0; frame < 3; frame++) {
+      Buffer<float> buffer{makeData(rank, frame), 8, 4, 2};
+      if (frame == 0) {
+         BufferUtils::writeToPvp<float>(pvpPath.c_str(), &buffer, (double)frame, false);
+      }
+      else {
+         BufferUtils::appendToPvp<float>(pvpPath.c_str(), &buffer, frame, (double)frame, false);
+      }
+   }
+
+   // A binary file that is rewritten in place through an in/out stream. The last value is
+   // written first, past the end of the file, as WeightsFileIO does for nonshared weights.
+   std::string binPath = mountPoint + "/values.bin";
+   {
+      FileStream binStream(binPath.c_str(), std::ios_base::out, false);
+      int values[4] = {rank, 1, 2, 3};
+      binStream.setOutPos(3 * sizeof(int), true);
+      binStream.write(&values[3], sizeof(int));
+      binStream.setOutPos(0L, true);
+      binStream.write(values, 3 * sizeof(int));
+   }
+   {
+      FileStream binStream(binPath.c_str(), std::ios_base::in | std::ios_base::out, false);
+      binStream.setOutPos(sizeof(int), true);
+      int replacement = -rank - 1;
+      binStream.write(&replacement, sizeof(replacement));
+   }
+
+   // A text file written through the PrintStream interface.
+   std::string txtPath = mountPoint + "/notes.txt";
+   FileStream txtStream(txtPath.c_str(), std::ios_base::out, false);
+   txtStream << "rank " << rank << "\n";
+}
+
+void checkEntries(std::string const &mountPoint, int rank) {
+   std::string pvpPath = mountPoint + "/buffer.pvp";
+   for (int frame = 0; frame < 3; frame++) {
+      Buffer<float> buffer;
+      double timestamp = BufferUtils::readDenseFromPvp<float>(pvpPath.c_str(), &buffer, frame);
+      FatalIf(timestamp != (double)frame, "Frame %d has timestamp %f.\n", frame, timestamp);
+      std::vector<float> expected = makeData(rank, frame);
+      FatalIf(
+            buffer.asVector() != expected,
+            "Rank %d: frame %d of \"%s\" does not match the data written.\n",
+            rank,
+            frame,
+            pvpPath.c_str());
+   }
+
+   std::string binPath = mountPoint + "/values.bin";
+   FileStream binStream(binPath.c_str(), std::ios_base::in, false);
+   int values[4];
+   binStream.read(values, sizeof(values));
+   FatalIf(
+         values[0] != rank or values[1] != -rank - 1 or values[2] != 2 or values[3] != 3,
+         "Rank %d: \"%s\" does not match the data written.\n",
+         rank,
+         binPath.c_str());
+
+   std::string txtPath = mountPoint + "/notes.txt";
+   FileStream txtStream(txtPath.c_str(), std::ios_base::in, false);
+   std::string expectedText = "rank " + std::to_string(rank) + "\n";
+   std::vector<char> text(expectedText.size());
+   txtStream.read(text.data(), (long)text.size());
+   FatalIf(
+         std::string(text.data(), text.size()) != expectedText,
+         "Rank %d: \"%s\" does not match the text written.\n",
+         rank,
+         txtPath.c_str());
+}
+
+int main(int argc, char *argv[]) {
+   PV::CommandLineArguments arguments{argc, argv, false /*do not allow unrecognized arguments*/};
+   MPI_Init(&argc, &argv);
+   PV::Communicator *comm = new PV::Communicator(&arguments);
+
+   // Treat each process as its own MPIBlock, so that the shared container holds one block
+   // per process.
+   PV::MPIBlock const *globalBlock = comm->getGlobalMPIBlock();
+   PV::MPIBlock mpiBlock{globalBlock->getComm(),
+                         globalBlock->getGlobalNumRows(),
+                         globalBlock->getGlobalNumColumns(),
+                         globalBlock->getGlobalBatchDimension(),
+                         1,
+                         1,
+                         1};
+   int const rank = mpiBlock.getGlobalRank();
+
+   std::string directory("output");
+   ensureDirExists(globalBlock, directory.c_str());
+   MPI_Barrier(globalBlock->getComm());
+   std::string blockName  = "block" + std::to_string(rank);
+   std::string mountPoint = directory + "/" + blockName;
+   std::string blockFile  = directory + "/" + blockName + ".pvcp";
+   std::string sharedFile = directory + "/shared.pvcp";
+
+   FileContainer *container = new FileContainer(mountPoint);
+   writeEntries(mountPoint, rank);
+   container->writeFile(blockFile, true /*verifyWrites*/);
+   container->writeShared(sharedFile, &mpiBlock, blockName);
+   delete container;
+
+   // Nothing should have been written to the mount point itself, and the image that the
+   // entries were written to as they were committed has been renamed to the block file.
+   struct stat mountStat;
+   FatalIf(
+         stat(mountPoint.c_str(), &mountStat) == 0,
+         "Mount point \"%s\" was created on disk.\n",
+         mountPoint.c_str());
+   std::string imagePath = mountPoint + ".part";
+   FatalIf(
+         stat(imagePath.c_str(), &mountStat) == 0,
+         "The container image \"%s\" was not removed.\n",
+         imagePath.c_str());
+
+   container = new FileContainer(mountPoint);
+   container->openFile(blockFile, blockName);
+   checkEntries(mountPoint, rank);
+   delete container;
+
+   container = new FileContainer(mountPoint);
+   container->openFile(sharedFile, blockName);
+   checkEntries(mountPoint, rank);
+   delete container;
+
+   std::string sharedOnlyFile = directory + "/sharedonly.pvcp";
+   container                  = new FileContainer(mountPoint);
+   writeEntries(mountPoint, rank);
+   container->writeShared(sharedOnlyFile, &mpiBlock, blockName);
+   delete container;
+   FatalIf(
+         stat(imagePath.c_str(), &mountStat) == 0,
+         "The container image \"%s\" was not removed after writing a shared file.\n",
+         imagePath.c_str());
+   container = new FileContainer(mountPoint);
+   container->openFile(sharedOnlyFile, blockName);
+   checkEntries(mountPoint, rank);
+   delete container;
+
+   delete comm;
+   MPI_Finalize();
+   InfoLog() << "Test passed.\n";
+   return 0;
+}
@@ -0,0 +1,276 @@
+/*
+ * main.cpp for FusedLCAUpdateTest
+ *
+ * Compares each update of FusedLCAUpdate, with one and with two channels, with the updateV
+ * kernels in updateStateFunctions.h that the layers used before, and compares the active indices
+ * that DataStore builds from the update's lists of nonzero activities with those found by
+ * scanning the whole buffer. Some margin values are nonzero, as they would be after a border
+ * exchange.
+ */
+
+#include "columns/DataStore.hpp"
+#include "layers/FusedLCAUpdate.hpp"
+#include "utils/PVLog.hpp"
+
+#ifdef PV_USE_CUDA
+#undef PV_USE_CUDA
+#include "layers/updateStateFunctions.h"
+#define PV_USE_CUDA
+#else
+#include "layers/updateStateFunctions.h"
+#endif // PV_USE_CUDA
+
+#include <cstring>
+#include <vector>
+
+using PV::DataStore;
+using PV::FusedLCAUpdate;
+using PV::PtwiseLinearTransfer;
+using PV::SparseList;
+
+enum Rule { LCA, MOMENTUM_LCA, ISTA };
+
+char const *ruleName(Rule rule) {
+   switch (rule) {
+      case LCA: return "LCA";
+      case MOMENTUM_LCA: return "MomentumLCA";
+      case ISTA: return "ISTA";
+      default: return "unknown";
+   }
+}
+
+PVLayerLoc makeLoc() {
+   // Rows whose lengths are not multiples of a vector width, and margins of different widths.
+   PVLayerLoc loc;
+   loc.nbatch       = 2;
+   loc.nx           = 13;
+   loc.ny           = 5;
+   loc.nf           = 3;
+   loc.nbatchGlobal = loc.nbatch;
+   loc.nxGlobal     = loc.nx;
+   loc.nyGlobal     = loc.ny;
+   loc.kb0          = 0;
+   loc.kx0          = 0;
+   loc.ky0          = 0;
+   loc.halo.lt      = 1;
+   loc.halo.rt      = 2;
+   loc.halo.dn      = 3;
+   loc.halo.up      = 2;
+   return loc;
+}
+
+// A deterministic sequence of values in [-1, 1), with about a third of them zero.
+std::vector<float> makeValues(std::size_t count, int seed) {
+   std::vector<float> values(count);
+   for (std::size_t k = 0; k < count; k++) {
+      int const n = (int)((k * 7919 + (std::size_t)seed * 104729) % 997);
+      values[k]   = n % 3 == 0 ? 0.0f : (float)(n - 498) / 498.0f;
+   }
+   return values;
+}
+
+void compareBuffers(
+      Rule rule,
+      int numChannels,
+      char const *bufferName,
+      std::vector<float> const &expected,
+      std::vector<float> const &observed) {
+   for (std::size_t k = 0; k < expected.size(); k++) {
+      FatalIf(
+            observed[k] != expected[k],
+            "%s with %d channel(s): %s[%zu] is %g instead of %g.\n",
+            ruleName(rule),
+            numChannels,
+            bufferName,
+            k,
+            (double)observed[k],
+            (double)expected[k]);
+   }
+}
+
+void compareActiveIndices(
+      Rule rule,
+      int numChannels,
+      PVLayerLoc const &loc,
+      std::vector<float> const &A,
+      FusedLCAUpdate const &update) {
+   int const numExtended = (int)A.size() / loc.nbatch;
+   DataStore scanned(loc.nbatch, numExtended, 1, true /*sparse*/);
+   DataStore merged(loc.nbatch, numExtended, 1, true /*sparse*/);
+   for (int b = 0; b < loc.nbatch; b++) {
+      std::size_t const size = sizeof(float) * (std::size_t)numExtended;
+      std::memcpy(scanned.buffer(b, 0), &A[b * numExtended], size);
+      std::memcpy(merged.buffer(b, 0), &A[b * numExtended], size);
+      scanned.updateActiveIndices(b, 0);
+      merged.updateActiveIndices(b, 0, loc, update.getRowEntries(), update.getRowCounts());
+
+      long const numActive = *scanned.numActiveBuffer(b, 0);
+      FatalIf(
+            *merged.numActiveBuffer(b, 0) != numActive,
+            "%s with %d channel(s), batch %d: %ld active indices instead of %ld.\n",
+            ruleName(rule),
+            numChannels,
+            b,
+            *merged.numActiveBuffer(b, 0),
+            numActive);
+      SparseList<float>::Entry const *expected = scanned.activeIndicesBuffer(b, 0);
+      SparseList<float>::Entry const *observed = merged.activeIndicesBuffer(b, 0);
+      for (long n = 0; n < numActive; n++) {
+         FatalIf(
+               observed[n].index != expected[n].index or observed[n].value != expected[n].value,
+               "%s with %d channel(s), batch %d: active entry %ld is (%u, %g) instead of "
+               "(%u, %g).\n",
+               ruleName(rule),
+               numChannels,
+               b,
+               n,
+               (unsigned)observed[n].index,
+               (double)observed[n].value,
+               (unsigned)expected[n].index,
+               (double)expected[n].value);
+      }
+   }
+}
+
+void checkUpdate(Rule rule, int numChannels) {
+   PVLayerLoc const loc    = makeLoc();
+   PVHalo const &halo      = loc.halo;
+   int const numNeurons    = loc.nx * loc.ny * loc.nf;
+   int const numExtended   = (loc.nx + halo.lt + halo.rt) * (loc.ny + halo.dn + halo.up) * loc.nf;
+   std::size_t const numV  = (std::size_t)(loc.nbatch * numNeurons);
+   std::size_t const numA  = (std::size_t)(loc.nbatch * numExtended);
+   float const tau         = 5.0f;
+   float const momentum    = 0.5f;
+   bool const selfInteract = true;
+   float const VThresh     = 0.25f;
+   std::vector<double> dtAdapt{1.0, 0.75};
+
+   // A soft threshold at VThresh, so that the activity is sparse.
+   std::vector<float> verticesV{VThresh};
+   std::vector<float> verticesA{0.0f};
+   std::vector<float> slopes{0.0f, 1.0f};
+   PtwiseLinearTransfer transfer(1, verticesV.data(), verticesA.data(), slopes.data());
+
+   std::vector<float> GSyn          = makeValues(numV * (std::size_t)numChannels, 1);
+   std::vector<float> expectedV     = makeValues(numV, 2);
+   std::vector<float> expectedA     = makeValues(numA, 3);
+   std::vector<float> expectedDrive = makeValues(numV, 4);
+   std::vector<float> observedV     = expectedV;
+   std::vector<float> observedA     = expectedA;
+   std::vector<float> observedDrive = expectedDrive;
+
+   switch (rule) {
+      case LCA:
+         updateV_HyPerLCALayer(
+               loc.nbatch,
+               numNeurons,
+               numChannels,
+               expectedV.data(),
+               GSyn.data(),
+               expectedA.data(),
+               1,
+               verticesV.data(),
+               verticesA.data(),
+               slopes.data(),
+               dtAdapt.data(),
+               tau,
+               selfInteract,
+               loc.nx,
+               loc.ny,
+               loc.nf,
+               halo.lt,
+               halo.rt,
+               halo.dn,
+               halo.up);
+         break;
+      case MOMENTUM_LCA:
+         updateV_MomentumLCALayer(
+               loc.nbatch,
+               numNeurons,
+               numChannels,
+               expectedV.data(),
+               GSyn.data(),
+               expectedA.data(),
+               expectedDrive.data(),
+               1,
+               verticesV.data(),
+               verticesA.data(),
+               slopes.data(),
+               dtAdapt.data(),
+               tau,
+               momentum,
+               selfInteract,
+               loc.nx,
+               loc.ny,
+               loc.nf,
+               halo.lt,
+               halo.rt,
+               halo.dn,
+               halo.up);
+         break;
+      case ISTA:
+         updateV_ISTALayer(
+               loc.nbatch,
+               numNeurons,
+               expectedV.data(),
+               GSyn.data(),
+               expectedA.data(),
+               VThresh,
+               dtAdapt.data(),
+               tau,
+               loc.nx,
+               loc.ny,
+               loc.nf,
+               halo.lt,
+               halo.rt,
+               halo.dn,
+               halo.up,
+               numChannels);
+         break;
+   }
+
+   FusedLCAUpdate update(&loc, numChannels, true /*emit active indices*/);
+   switch (rule) {
+      case LCA:
+         update.updateLCA(
+               GSyn.data(),
+               observedV.data(),
+               observedA.data(),
+               dtAdapt.data(),
+               tau,
+               selfInteract,
+               transfer);
+         break;
+      case MOMENTUM_LCA:
+         update.updateMomentumLCA(
+               GSyn.data(),
+               observedV.data(),
+               observedA.data(),
+               observedDrive.data(),
+               dtAdapt.data(),
+               tau,
+               momentum,
+               selfInteract,
+               transfer);
+         break;
+      case ISTA:
+         update.updateISTA(
+               GSyn.data(), observedV.data(), observedA.data(), dtAdapt.data(), tau, VThresh);
+         break;
+   }
+
+   compareBuffers(rule, numChannels, "V", expectedV, observedV);
+   compareBuffers(rule, numChannels, "A", expectedA, observedA);
+   compareBuffers(rule, numChannels, "prevDrive", expectedDrive, observedDrive);
+   compareActiveIndices(rule, numChannels, loc, observedA, update);
+}
+
+int main(int argc, char *argv[]) {
+   for (int numChannels = 1; numChannels <= 2; numChannels++) {
+      checkUpdate(LCA, numChannels);
+      checkUpdate(MOMENTUM_LCA, numChannels);
+      checkUpdate(ISTA, numChannels);
+   }
+   InfoLog() << "Test passed." << std::endl;
+   return EXIT_SUCCESS;
+}
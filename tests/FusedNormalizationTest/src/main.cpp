@@ -0,0 +1,82 @@
+/*
+ * main.cpp for FusedNormalizationTest
+ *
+ * Runs connections that differ only in the fuseNormalization flag, and checks that the weights
+ * of each pair agree exactly, and that the normalization held for the fused connections.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <connections/HyPerConn.hpp>
+
+int checkWeights(HyPerCol *hc, int argc, char *argv[]);
+void comparePair(HyPerCol *hc, std::string const &baseName);
+void checkL2Norms(HyPerConn *conn);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkWeights);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkWeights(HyPerCol *hc, int argc, char *argv[]) {
+   comparePair(hc, std::string("L2Momentum"));
+   comparePair(hc, std::string("SumNonshared"));
+   checkL2Norms(dynamic_cast<HyPerConn *>(hc->getObjectFromName("FusedL2Momentum")));
+   return PV_SUCCESS;
+}
+
+void comparePair(HyPerCol *hc, std::string const &baseName) {
+   std::string separateName = std::string("Separate") + baseName;
+   std::string fusedName    = std::string("Fused") + baseName;
+
+   auto *separateConn = dynamic_cast<HyPerConn *>(hc->getObjectFromName(separateName.c_str()));
+   FatalIf(separateConn == nullptr, "No connection named \"%s\".\n", separateName.c_str());
+   auto *fusedConn = dynamic_cast<HyPerConn *>(hc->getObjectFromName(fusedName.c_str()));
+   FatalIf(fusedConn == nullptr, "No connection named \"%s\".\n", fusedName.c_str());
+
+   int const numArbors  = separateConn->getNumAxonalArbors();
+   int const numPatches = separateConn->getNumDataPatches();
+   int const patchSize  = separateConn->getPatchSizeX() * separateConn->getPatchSizeY()
+                         * separateConn->getPatchSizeF();
+   FatalIf(fusedConn->getNumAxonalArbors() != numArbors, "Test failed.\n");
+   FatalIf(fusedConn->getNumDataPatches() != numPatches, "Test failed.\n");
+
+   for (int arbor = 0; arbor < numArbors; arbor++) {
+      float const *separateWeights = separateConn->getWeightsDataStart(arbor);
+      float const *fusedWeights    = fusedConn->getWeightsDataStart(arbor);
+      for (int k = 0; k < numPatches * patchSize; k++) {
+         FatalIf(
+               separateWeights[k] != fusedWeights[k],
+               "Weight %d of arbor %d differs: %s has %f but %s has %f.\n",
+               k,
+               arbor,
+               separateName.c_str(),
+               (double)separateWeights[k],
+               fusedName.c_str(),
+               (double)fusedWeights[k]);
+      }
+   }
+}
+
+void checkL2Norms(HyPerConn *conn) {
+   FatalIf(conn == nullptr, "Test failed.\n");
+   int const numArbors  = conn->getNumAxonalArbors();
+   int const numPatches = conn->getNumDataPatches();
+   int const patchSize  = conn->getPatchSizeX() * conn->getPatchSizeY() * conn->getPatchSizeF();
+   float const strength = (float)conn->getStrength();
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      float sumsq = 0.0f;
+      for (int arbor = 0; arbor < numArbors; arbor++) {
+         float const *patch = conn->getWeightsDataHead(arbor, patchIndex);
+         for (int k = 0; k < patchSize; k++) {
+            sumsq += patch[k] * patch[k];
+         }
+      }
+      FatalIf(
+            std::fabs(std::sqrt(sumsq) - strength) > 1.0e-5f * strength,
+            "%s: patch %d has L2 norm %f instead of %f.\n",
+            conn->getDescription_c(),
+            patchIndex,
+            (double)std::sqrt(sumsq),
+            (double)strength);
+   }
+}
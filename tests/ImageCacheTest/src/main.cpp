@@ -0,0 +1,148 @@
+/*
+ * main.cpp for ImageCacheTest
+ *
+ * Checks the ImageCache class directly, and then runs a network with an ImageLayer that caches
+ * its images twice: the first run decodes each image once and spills it to disk, and the second
+ * run reads every image from the spill file left by the first.
+ */
+
+#include <columns/HyPerCol.hpp>
+#include <columns/PV_Init.hpp>
+#include <io/fileio.hpp>
+#include <layers/ImageLayer.hpp>
+#include <structures/Image.hpp>
+#include <structures/ImageCache.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace PV;
+
+int const numImages = 3;
+
+Buffer<float> makeFrame(int width, int height, int features, float offset);
+void checkCacheClass();
+void writeImages(PV_Init *pv_init);
+void runColumn(PV_Init *pv_init, bool warmStart);
+
+int main(int argc, char *argv[]) {
+   PV_Init pv_init{&argc, &argv, false /*do not allow unrecognized arguments*/};
+   checkCacheClass();
+   if (pv_init.isExtraProc()) {
+      return EXIT_SUCCESS;
+   }
+   writeImages(&pv_init);
+   runColumn(&pv_init, false /*warmStart*/);
+   runColumn(&pv_init, true /*warmStart*/);
+   InfoLog() << "Test passed." << std::endl;
+   return EXIT_SUCCESS;
+}
+
+Buffer<float> makeFrame(int width, int height, int features, float offset) {
+   Buffer<float> frame(width, height, features);
+   for (int k = 0; k < frame.getTotalElements(); k++) {
+      frame.set(k, offset + (float)(k % 7) / 8.0f);
+   }
+   return frame;
+}
+
+void checkCacheClass() {
+   // A float cache with room for two 4x4x2 frames drops the least recently used frame.
+   std::size_t const frameSize = (std::size_t)(4 * 4 * 2) * sizeof(float);
+   ImageCache cache(2 * frameSize, ImageCache::FLOAT);
+   cache.insert("a", makeFrame(4, 4, 2, 0.0f), 10, 20);
+   cache.insert("b", makeFrame(4, 4, 2, 1.0f), 11, 21);
+   Buffer<float> frame;
+   int sourceWidth, sourceHeight;
+   FatalIf(!cache.find("a", &frame, &sourceWidth, &sourceHeight), "Frame \"a\" is missing.\n");
+   FatalIf(
+         frame.asVector() != makeFrame(4, 4, 2, 0.0f).asVector() or sourceWidth != 10
+               or sourceHeight != 20,
+         "Frame \"a\" did not survive the cache.\n");
+   cache.insert("c", makeFrame(4, 4, 2, 2.0f), 12, 22);
+   FatalIf(
+         cache.find("b", &frame, &sourceWidth, &sourceHeight),
+         "Frame \"b\" should have been dropped as the least recently used.\n");
+   FatalIf(!cache.find("a", &frame, &sourceWidth, &sourceHeight), "Frame \"a\" was dropped.\n");
+   FatalIf(!cache.find("c", &frame, &sourceWidth, &sourceHeight), "Frame \"c\" is missing.\n");
+   FatalIf(cache.getSize() != 2 * frameSize, "The cache should be full.\n");
+   FatalIf(
+         cache.getNumMemoryHits() != 3L or cache.getNumMisses() != 1L,
+         "Expected 3 hits and 1 miss; found %ld and %ld.\n",
+         cache.getNumMemoryHits(),
+         cache.getNumMisses());
+
+   // A byte cache rounds to multiples of 1/255, and clamps to [0, 1].
+   ImageCache byteCache(frameSize, ImageCache::BYTE);
+   std::vector<float> values = {-0.5f, 0.0f, 0.5f, 100.0f / 255.0f, 1.0f, 1.5f};
+   byteCache.insert("v", Buffer<float>(values, 6, 1, 1), 6, 1);
+   FatalIf(!byteCache.find("v", &frame, &sourceWidth, &sourceHeight), "Frame \"v\" is missing.\n");
+   std::vector<float> expected = {0.0f, 0.0f, 128.0f / 255.0f, 100.0f / 255.0f, 1.0f, 1.0f};
+   FatalIf(frame.asVector() != expected, "The byte cache did not round as expected.\n");
+}
+
+void writeImages(PV_Init *pv_init) {
+   Communicator *communicator = pv_init->getCommunicator();
+   if (communicator->globalCommRank() == 0) {
+      ensureDirExists(communicator->getLocalMPIBlock(), "output/images");
+      std::remove("output/ImageCacheTest.pvp");
+      std::remove("output/ImageCacheTest.pvp.index");
+      std::ofstream listStream("output/images/list.txt");
+      for (int i = 0; i < numImages; i++) {
+         // 12x10 RGB images, so that the layer rescales them.
+         std::vector<float> data(12 * 10 * 3);
+         for (std::size_t k = 0; k < data.size(); k++) {
+            data[k] = (float)((k * (std::size_t)(i + 3)) % 256) / 255.0f;
+         }
+         std::string const path = "output/images/" + std::to_string(i) + ".png";
+         Image(data, 12, 10, 3).write(path);
+         listStream << path << "\n";
+      }
+   }
+   MPI_Barrier(communicator->globalCommunicator());
+}
+
+void runColumn(PV_Init *pv_init, bool warmStart) {
+   HyPerCol *hc = new HyPerCol(pv_init);
+   int status   = hc->run();
+   FatalIf(status != PV_SUCCESS, "HyPerCol::run failed.\n");
+
+   auto *input     = dynamic_cast<ImageLayer *>(hc->getObjectFromName("Input"));
+   auto *reference = dynamic_cast<ImageLayer *>(hc->getObjectFromName("Reference"));
+   FatalIf(input == nullptr or reference == nullptr, "Missing Input or Reference layer.\n");
+   int const numExtended = input->getNumExtendedAllBatches();
+   for (int k = 0; k < numExtended; k++) {
+      FatalIf(
+            input->getActivity()[k] != reference->getActivity()[k],
+            "Input and Reference differ at extended index %d: %f versus %f.\n",
+            k,
+            (double)input->getActivity()[k],
+            (double)reference->getActivity()[k]);
+   }
+
+   // Only the root process of each MPIBlock reads images, so only it has a cache.
+   ImageCache const *cache = input->getImageCache();
+   if (cache != nullptr) {
+      FatalIf(
+            cache->getNumSpilledFrames() != numImages,
+            "The spill file has %d frames instead of %d.\n",
+            cache->getNumSpilledFrames(),
+            numImages);
+      long const expectedMisses    = warmStart ? 0L : (long)numImages;
+      long const expectedSpillHits = warmStart ? (long)numImages : 0L;
+      FatalIf(
+            cache->getNumMisses() != expectedMisses
+                  or cache->getNumSpillHits() != expectedSpillHits,
+            "Expected %ld misses and %ld spill hits; found %ld and %ld.\n",
+            expectedMisses,
+            expectedSpillHits,
+            cache->getNumMisses(),
+            cache->getNumSpillHits());
+      FatalIf(
+            cache->getNumMemoryHits() == 0L,
+            "Images shown a second time should come from memory.\n");
+   }
+   delete hc;
+}
@@ -0,0 +1,235 @@
+/*
+ * main.cpp for InferenceServerTest
+ *
+ * Runs a column with the --serve option. On the root process, a client thread first pipelines a
+ * batch's worth of frames and checks that the server processes them together; then several
+ * clients send frames concurrently. Each code is checked against the expected sparse code, and
+ * then the client checks the stats, that a bad frame is rejected, and the shutdown reply. Finally
+ * the test checks that the plastic connection's weights were frozen.
+ */
+
+#include <columns/InferenceClient.hpp>
+#include <columns/buildandrun.hpp>
+#include <connections/HyPerConn.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using PV::InferenceClient;
+using PV::InferenceProtocol::StatsReply;
+
+int const nx              = 8;
+int const ny              = 8;
+int const nf              = 2;
+int const batchWidth      = 4;
+int const numClients      = 3;
+int const framesPerClient = 5;
+double const timeout      = 60.0;
+
+std::thread driverThread;
+
+int startClients(HyPerCol *hc, int argc, char *argv[]);
+int checkWeights(HyPerCol *hc, int argc, char *argv[]);
+void driveServer(std::string socketPath);
+void runClient(std::string socketPath, int clientIndex);
+int pixelLevel(int frameId, int x, int y);
+std::vector<float> makeFloatFrame(int frameId);
+std::vector<std::uint8_t> makeUint8Frame(int frameId);
+void checkCode(InferenceClient::SparseCode const &code, int frameId, bool uint8Frame);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, startClients, checkWeights);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int startClients(HyPerCol *hc, int argc, char *argv[]) {
+   std::string const &socketPath = hc->getPV_InitObj()->getStringArgument("Serve");
+   FatalIf(socketPath.empty(), "InferenceServerTest must be run with the --serve option.\n");
+   FatalIf(
+         hc->getNBatchGlobal() != batchWidth,
+         "InferenceServerTest needs a global batch width of %d.\n",
+         batchWidth);
+   if (hc->getCommunicator()->globalCommRank() == 0) {
+      driverThread = std::thread(driveServer, socketPath);
+   }
+   return PV_SUCCESS;
+}
+
+int checkWeights(HyPerCol *hc, int argc, char *argv[]) {
+   if (driverThread.joinable()) {
+      driverThread.join();
+   }
+   auto *conn = dynamic_cast<HyPerConn *>(hc->getObjectFromName("InputToOutput"));
+   FatalIf(conn == nullptr, "No connection named \"InputToOutput\".\n");
+   float const *weights = conn->getWeightsDataStart(0);
+   for (int k = 0; k < nf; k++) {
+      FatalIf(
+            weights[k] != 2.0f,
+            "Weight %d of InputToOutput is %f instead of 2; the server did not freeze it.\n",
+            k,
+            (double)weights[k]);
+   }
+   return PV_SUCCESS;
+}
+
+void driveServer(std::string socketPath) {
+   // A batch's worth of frames sent together should be processed in one batch.
+   InferenceClient pipelined;
+   FatalIf(pipelined.connect(socketPath, timeout) != PV_SUCCESS, "Unable to connect.\n");
+   std::vector<std::vector<float>> frames(batchWidth);
+   for (int b = 0; b < batchWidth; b++) {
+      frames[b] = makeFloatFrame(b);
+      pipelined.submit(frames[b].data(), ny, nx, 1);
+   }
+   for (int b = 0; b < batchWidth; b++) {
+      InferenceClient::SparseCode code;
+      FatalIf(pipelined.receive(&code) != PV_SUCCESS, "Pipelined frame %d failed.\n", b);
+      checkCode(code, b, false);
+      FatalIf(
+            code.mBatchSize != batchWidth,
+            "Pipelined frame %d was in a batch of %d instead of %d.\n",
+            b,
+            code.mBatchSize,
+            batchWidth);
+   }
+
+   std::vector<std::thread> clients;
+   for (int c = 0; c < numClients; c++) {
+      clients.emplace_back(runClient, socketPath, c);
+   }
+   for (auto &client : clients) {
+      client.join();
+   }
+
+   int const numRequests = batchWidth + numClients * framesPerClient;
+   StatsReply stats;
+   FatalIf(pipelined.requestStats(&stats) != PV_SUCCESS, "The stats request failed.\n");
+   FatalIf(
+         stats.mNumRequests != numRequests,
+         "The server reports %lld requests instead of %d.\n",
+         (long long)stats.mNumRequests,
+         numRequests);
+   int const minBatches = 1 + (numClients * framesPerClient + batchWidth - 1) / batchWidth;
+   FatalIf(
+         stats.mNumBatches < minBatches or stats.mNumBatches > 1 + numClients * framesPerClient,
+         "The server reports %lld batches, which is impossible for %d requests.\n",
+         (long long)stats.mNumBatches,
+         numRequests);
+   FatalIf(
+         !(stats.mMeanLatency > 0.0 and stats.mLatency50 <= stats.mLatency90
+           and stats.mLatency90 <= stats.mLatency99 and stats.mLatency99 <= stats.mMaxLatency),
+         "The latency statistics are inconsistent.\n");
+
+   // A frame with more bands than the input layer can take is rejected.
+   InferenceClient rejected;
+   FatalIf(rejected.connect(socketPath, timeout) != PV_SUCCESS, "Unable to connect.\n");
+   std::vector<float> badFrame(nx * ny * 7, 0.0f);
+   InferenceClient::SparseCode badCode;
+   FatalIf(
+         rejected.infer(badFrame.data(), ny, nx, 7, &badCode) == PV_SUCCESS,
+         "The server accepted a frame with 7 bands for a layer with one feature.\n");
+
+   FatalIf(pipelined.requestShutdown(&stats) != PV_SUCCESS, "The shutdown request failed.\n");
+   FatalIf(
+         stats.mNumRequests != numRequests,
+         "The shutdown reply reports %lld requests instead of %d.\n",
+         (long long)stats.mNumRequests,
+         numRequests);
+}
+
+void runClient(std::string socketPath, int clientIndex) {
+   InferenceClient client;
+   FatalIf(client.connect(socketPath, timeout) != PV_SUCCESS, "Unable to connect.\n");
+   // The first client sends 8-bit frames, and the others float frames.
+   bool const uint8Frames = clientIndex == 0;
+   for (int i = 0; i < framesPerClient; i++) {
+      int const frameId = 10 * (clientIndex + 1) + i;
+      InferenceClient::SparseCode code;
+      int status;
+      if (uint8Frames) {
+         std::vector<std::uint8_t> frame = makeUint8Frame(frameId);
+         status                          = client.infer(frame.data(), ny, nx, 1, &code);
+      }
+      else {
+         std::vector<float> frame = makeFloatFrame(frameId);
+         status                   = client.infer(frame.data(), ny, nx, 1, &code);
+      }
+      FatalIf(status != PV_SUCCESS, "Client %d, frame %d failed.\n", clientIndex, i);
+      checkCode(code, frameId, uint8Frames);
+      FatalIf(
+            code.mBatchSize < 1 or code.mBatchSize > batchWidth,
+            "Client %d, frame %d was in a batch of %d.\n",
+            clientIndex,
+            i,
+            code.mBatchSize);
+   }
+}
+
+// Pixel levels 0, 1, 2 and 3 are the values 0, 1/3, 2/3 and 1.
+int pixelLevel(int frameId, int x, int y) { return (x + 2 * y + frameId) % 4; }
+
+std::vector<float> makeFloatFrame(int frameId) {
+   std::vector<float> frame(nx * ny);
+   for (int y = 0; y < ny; y++) {
+      for (int x = 0; x < nx; x++) {
+         frame[y * nx + x] = (float)pixelLevel(frameId, x, y) / 3.0f;
+      }
+   }
+   return frame;
+}
+
+std::vector<std::uint8_t> makeUint8Frame(int frameId) {
+   std::vector<std::uint8_t> frame(nx * ny);
+   for (int y = 0; y < ny; y++) {
+      for (int x = 0; x < nx; x++) {
+         frame[y * nx + x] = (std::uint8_t)(85 * pixelLevel(frameId, x, y));
+      }
+   }
+   return frame;
+}
+
+// Each output feature is twice the input pixel, and is active where that is above one, that is,
+// where the pixel level is 2 or 3.
+void checkCode(InferenceClient::SparseCode const &code, int frameId, bool uint8Frame) {
+   FatalIf(
+         code.mNumNeurons != nx * ny * nf,
+         "Frame %d: the output layer has %d neurons instead of %d.\n",
+         frameId,
+         code.mNumNeurons,
+         nx * ny * nf);
+   std::size_t k = 0;
+   for (int y = 0; y < ny; y++) {
+      for (int x = 0; x < nx; x++) {
+         int const level = pixelLevel(frameId, x, y);
+         if (level < 2) {
+            continue;
+         }
+         float const pixel = uint8Frame ? (float)(85 * level) / 255.0f : (float)level / 3.0f;
+         for (int f = 0; f < nf; f++) {
+            int const index = (y * nx + x) * nf + f;
+            FatalIf(
+                  k >= code.mIndices.size() or code.mIndices[k] != index,
+                  "Frame %d: neuron %d is missing from the code.\n",
+                  frameId,
+                  index);
+            FatalIf(
+                  std::fabs(code.mValues[k] - 2.0f * pixel) > 1.0e-6f,
+                  "Frame %d: neuron %d has value %f instead of %f.\n",
+                  frameId,
+                  index,
+                  (double)code.mValues[k],
+                  (double)(2.0f * pixel));
+            k++;
+         }
+      }
+   }
+   FatalIf(
+         k != code.mIndices.size(),
+         "Frame %d: the code has %zu active neurons instead of %zu.\n",
+         frameId,
+         code.mIndices.size(),
+         k);
+}
@@ -0,0 +1,748 @@
+/*
+ * main.cpp for LIFUpdateTest
+ *
+ * Compares LIFUpdate with copies of the per-neuron kernels that LIF, LIFGap and LCALIFLayer used
+ * before, for each integration method, with and without gap junctions, and with the noise drawn
+ * from the Tausworthe generator. The state, the generators and the activity must agree exactly
+ * over several timesteps, and the active indices built from the update's lists of spikes must
+ * agree with those found by scanning the activity.
+ */
+
+#include "columns/DataStore.hpp"
+#include "columns/Random.hpp"
+#include "columns/RandomSeed.hpp"
+#include "layers/LIF.hpp"
+#include "layers/LIFUpdate.hpp"
+#include "utils/PVLog.hpp"
+#include "utils/cl_random.h"
+#include "utils/conversions.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using PV::DataStore;
+using PV::LIFUpdate;
+using PV::Random;
+using PV::RandomSeed;
+using PV::SparseList;
+
+unsigned int const seed = 12345678U;
+int const numSteps      = 4;
+float const dt          = 1.0f;
+
+PVLayerLoc makeLoc() {
+   // Rows whose lengths are not multiples of a vector width, and margins of different widths.
+   PVLayerLoc loc;
+   loc.nbatch       = 2;
+   loc.nx           = 13;
+   loc.ny           = 5;
+   loc.nf           = 3;
+   loc.nbatchGlobal = loc.nbatch;
+   loc.nxGlobal     = loc.nx;
+   loc.nyGlobal     = loc.ny;
+   loc.kb0          = 0;
+   loc.kx0          = 0;
+   loc.ky0          = 0;
+   loc.halo.lt      = 1;
+   loc.halo.rt      = 2;
+   loc.halo.dn      = 3;
+   loc.halo.up      = 2;
+   return loc;
+}
+
+LIF_params makeParams(bool noise) {
+   LIF_params params;
+   params.Vrest       = -70.0f;
+   params.Vexc        = 0.0f;
+   params.Vinh        = -75.0f;
+   params.VinhB       = -90.0f;
+   params.tau         = 20.0f;
+   params.tauE        = 2.0f;
+   params.tauI        = 5.0f;
+   params.tauIB       = 10.0f;
+   params.VthRest     = -55.0f;
+   params.tauVth      = 10.0f;
+   params.deltaVth    = 5.0f;
+   params.deltaGIB    = 1.0f;
+   params.noiseFreqE  = noise ? 400.0f : 0.0f;
+   params.noiseAmpE   = 0.75f;
+   params.noiseFreqI  = noise ? 300.0f : 0.0f;
+   params.noiseAmpI   = 0.5f;
+   params.noiseFreqIB = noise ? 200.0f : 0.0f;
+   params.noiseAmpIB  = 0.25f;
+   return params;
+}
+
+// A deterministic sequence of values in [low, high), with about a third of them zero if
+// withZeros is true.
+std::vector<float> makeValues(std::size_t count, int seed, float low, float high, bool withZeros) {
+   std::vector<float> values(count);
+   for (std::size_t k = 0; k < count; k++) {
+      int const n   = (int)((k * 7919 + (std::size_t)seed * 104729) % 997);
+      float const x = low + (high - low) * (float)n / 997.0f;
+      values[k]     = withZeros and n % 3 == 0 ? 0.0f : x;
+   }
+   return values;
+}
+
+// The state of a layer.
+struct State {
+   std::vector<float> V, Vth, G_E, G_I, G_IB, GSyn, activity, gapStrength;
+   std::vector<float> Vadpt, integratedSpikeCount, Vattained, Vmeminf;
+   std::vector<float> GSynExcEffective, GSynInhEffective, excitatoryNoise, inhibitoryNoise;
+   std::vector<float> inhibNoiseB;
+};
+
+State makeState(PVLayerLoc const &loc, int numChannels) {
+   int const numNeurons  = loc.nx * loc.ny * loc.nf;
+   PVHalo const &halo    = loc.halo;
+   int const numExtended = (loc.nx + halo.lt + halo.rt) * (loc.ny + halo.dn + halo.up) * loc.nf;
+   std::size_t const n   = (std::size_t)(loc.nbatch * numNeurons);
+   State state;
+   state.V           = makeValues(n, 1, -75.0f, -45.0f, false);
+   state.Vth         = makeValues(n, 2, -60.0f, -50.0f, false);
+   state.G_E         = makeValues(n, 3, 0.0f, 3.0f, true);
+   state.G_I         = makeValues(n, 4, 0.0f, 3.0f, true);
+   state.G_IB        = makeValues(n, 5, 0.0f, 3.0f, true);
+   state.gapStrength = makeValues(n, 6, 0.0f, 1.0f, true);
+   state.activity    = makeValues((std::size_t)(loc.nbatch * numExtended), 7, 0.0f, 1.0f, true);
+   state.GSyn.resize(n * (std::size_t)numChannels);
+   for (auto *buffer : {&state.Vadpt,
+                        &state.integratedSpikeCount,
+                        &state.Vattained,
+                        &state.Vmeminf,
+                        &state.GSynExcEffective,
+                        &state.GSynInhEffective,
+                        &state.excitatoryNoise,
+                        &state.inhibitoryNoise,
+                        &state.inhibNoiseB}) {
+      buffer->assign(n, 0.0f);
+   }
+   state.integratedSpikeCount.assign(n, 0.001f);
+   return state;
+}
+
+// The input of a timestep. The excitatory input sometimes exceeds the limit of 10 on the
+// conductances. The normalizing channel, if any, is zero only where the excitatory input is.
+void setGSyn(State &state, int numChannels, int step) {
+   std::size_t const n = state.V.size();
+   std::vector<float> exc  = makeValues(n, 10 + step, 0.0f, 12.0f, true);
+   std::vector<float> inh  = makeValues(n, 20 + step, 0.0f, 4.0f, true);
+   std::vector<float> inhB = makeValues(n, 30 + step, 0.0f, 2.0f, true);
+   std::memcpy(&state.GSyn[0], exc.data(), sizeof(float) * n);
+   std::memcpy(&state.GSyn[n], inh.data(), sizeof(float) * n);
+   std::memcpy(&state.GSyn[2 * n], inhB.data(), sizeof(float) * n);
+   if (numChannels > 3) {
+      std::vector<float> gap = makeValues(n, 40 + step, -20.0f, 20.0f, true);
+      std::memcpy(&state.GSyn[3 * n], gap.data(), sizeof(float) * n);
+   }
+   if (numChannels > 4) {
+      std::vector<float> norm = makeValues(n, 50 + step, 0.5f, 4.0f, false);
+      for (std::size_t k = 0; k < n; k++) {
+         state.GSyn[4 * n + k] = exc[k] == 0.0f and k % 2 == 0 ? 0.0f : norm[k];
+      }
+   }
+}
+
+///////////////////////////////////////////////////////
+//
+// The kernels that LIFUpdate replaced
+//
+
+void addNoise(
+      LIF_params const *params,
+      float dt_sec,
+      taus_uint4 *rnd,
+      float *noiseE,
+      float *noiseI,
+      float *noiseIB) {
+   *noiseE  = 0.0f;
+   *noiseI  = 0.0f;
+   *noiseIB = 0.0f;
+   *rnd     = cl_random_get(*rnd);
+   if (cl_random_prob(*rnd) < dt_sec * params->noiseFreqE) {
+      *rnd    = cl_random_get(*rnd);
+      *noiseE = params->noiseAmpE * cl_random_prob(*rnd);
+   }
+   *rnd = cl_random_get(*rnd);
+   if (cl_random_prob(*rnd) < dt_sec * params->noiseFreqI) {
+      *rnd    = cl_random_get(*rnd);
+      *noiseI = params->noiseAmpI * cl_random_prob(*rnd);
+   }
+   *rnd = cl_random_get(*rnd);
+   if (cl_random_prob(*rnd) < dt_sec * params->noiseFreqIB) {
+      *rnd     = cl_random_get(*rnd);
+      *noiseIB = params->noiseAmpIB * cl_random_prob(*rnd);
+   }
+}
+
+inline float LIF_Vmem_derivative(
+      const float Vmem,
+      const float G_E,
+      const float G_I,
+      const float G_IB,
+      const float V_E,
+      const float V_I,
+      const float V_IB,
+      const float Vrest,
+      const float tau) {
+   float totalconductance = 1.0f + G_E + G_I + G_IB;
+   float Vmeminf          = (Vrest + V_E * G_E + V_I * G_I + V_IB * G_IB) / totalconductance;
+   return totalconductance * (Vmeminf - Vmem) / tau;
+}
+
+inline float LIFGap_Vmem_derivative(
+      const float Vmem,
+      const float G_E,
+      const float G_I,
+      const float G_IB,
+      const float G_Gap,
+      const float V_E,
+      const float V_I,
+      const float V_IB,
+      const float sum_gap,
+      const float Vrest,
+      const float tau) {
+   float totalconductance = 1.0f + G_E + G_I + G_IB + sum_gap;
+   float Vmeminf = (Vrest + V_E * G_E + V_I * G_I + V_IB * G_IB + G_Gap) / totalconductance;
+   return totalconductance * (Vmeminf - Vmem) / tau;
+}
+
+// The LIF kernels if gap is false, and the LIFGap kernels if it is true.
+void referenceLIF(
+      char method,
+      bool gap,
+      PVLayerLoc const &loc,
+      LIF_params const *params,
+      taus_uint4 *rnd,
+      State &state) {
+   int const nbatch      = loc.nbatch;
+   int const numNeurons  = loc.nx * loc.ny * loc.nf;
+   PVHalo const &halo    = loc.halo;
+   float *GSynExc        = &state.GSyn[CHANNEL_EXC * nbatch * numNeurons];
+   float *GSynInh        = &state.GSyn[CHANNEL_INH * nbatch * numNeurons];
+   float *GSynInhB       = &state.GSyn[CHANNEL_INHB * nbatch * numNeurons];
+   float *GSynGap        = gap ? &state.GSyn[CHANNEL_GAP * nbatch * numNeurons] : nullptr;
+   const float exp_tauE   = expf(-dt / params->tauE);
+   const float exp_tauI   = expf(-dt / params->tauI);
+   const float exp_tauIB  = expf(-dt / params->tauIB);
+   const float exp_tauVth = expf(-dt / params->tauVth);
+   const float dt_sec     = 0.001f * dt;
+   const float GMAX       = 10.0f;
+
+   float const tau      = params->tau;
+   float const Vexc     = params->Vexc;
+   float const Vinh     = params->Vinh;
+   float const VinhB    = params->VinhB;
+   float const Vrest    = params->Vrest;
+   float const VthRest  = params->VthRest;
+   float const deltaVth = params->deltaVth;
+   float const deltaGIB = params->deltaGIB;
+
+   for (int k = 0; k < numNeurons * nbatch; k++) {
+      int kex = kIndexExtendedBatch(
+            k, nbatch, loc.nx, loc.ny, loc.nf, halo.lt, halo.rt, halo.dn, halo.up);
+      taus_uint4 l_rnd    = rnd[k];
+      float l_V           = state.V[k];
+      float l_Vth         = state.Vth[k];
+      float l_G_E         = state.G_E[k];
+      float l_G_I         = state.G_I[k];
+      float l_G_IB        = state.G_IB[k];
+      float l_gapStrength = gap ? state.gapStrength[k] : 0.0f;
+      float l_GSynExc     = GSynExc[k];
+      float l_GSynInh     = GSynInh[k];
+      float l_GSynInhB    = GSynInhB[k];
+      float l_GSynGap     = gap ? GSynGap[k] : 0.0f;
+
+      float noiseE, noiseI, noiseIB;
+      addNoise(params, dt_sec, &l_rnd, &noiseE, &noiseI, &noiseIB);
+      if (noiseE != 0.0f) {
+         l_GSynExc = l_GSynExc + noiseE;
+      }
+      if (noiseI != 0.0f) {
+         l_GSynInh = l_GSynInh + noiseI;
+      }
+      if (noiseIB != 0.0f) {
+         l_GSynInhB = l_GSynInhB + noiseIB;
+      }
+
+      if (method == 'o') {
+         l_G_E  = l_GSynExc + l_G_E * exp_tauE;
+         l_G_I  = l_GSynInh + l_G_I * exp_tauI;
+         l_G_IB = l_GSynInhB + l_G_IB * exp_tauIB;
+         l_G_E  = (l_G_E > GMAX) ? GMAX : l_G_E;
+         l_G_I  = (l_G_I > GMAX) ? GMAX : l_G_I;
+         l_G_IB = (l_G_IB > GMAX) ? GMAX : l_G_IB;
+         float tauInf, VmemInf;
+         if (gap) {
+            tauInf  = (dt / tau) * (1.0f + l_G_E + l_G_I + l_G_IB + l_gapStrength);
+            VmemInf = (Vrest + l_G_E * Vexc + l_G_I * Vinh + l_G_IB * VinhB + l_GSynGap)
+                      / (1.0f + l_G_E + l_G_I + l_G_IB + l_gapStrength);
+         }
+         else {
+            tauInf  = (dt / tau) * (1.0f + l_G_E + l_G_I + l_G_IB);
+            VmemInf = (Vrest + l_G_E * Vexc + l_G_I * Vinh + l_G_IB * VinhB)
+                      / (1.0f + l_G_E + l_G_I + l_G_IB);
+         }
+         l_V = VmemInf + (l_V - VmemInf) * expf(-tauInf);
+      }
+      else {
+         float G_E_initial  = l_G_E + l_GSynExc;
+         float G_I_initial  = l_G_I + l_GSynInh;
+         float G_IB_initial = l_G_IB + l_GSynInhB;
+         float tau_inf_initial, V_inf_initial;
+         if (gap) {
+            tau_inf_initial =
+                  tau / (1.0f + G_E_initial + G_I_initial + G_IB_initial + l_gapStrength);
+            V_inf_initial =
+                  (Vrest + Vexc * G_E_initial + Vinh * G_I_initial + VinhB * G_IB_initial
+                   + l_GSynGap)
+                  / (1.0f + G_E_initial + G_I_initial + G_IB_initial + l_gapStrength);
+         }
+         else {
+            tau_inf_initial = tau / (1 + G_E_initial + G_I_initial + G_IB_initial);
+            V_inf_initial =
+                  (Vrest + Vexc * G_E_initial + Vinh * G_I_initial + VinhB * G_IB_initial)
+                  / (1 + G_E_initial + G_I_initial + G_IB_initial);
+         }
+         G_E_initial      = (G_E_initial > GMAX) ? GMAX : G_E_initial;
+         G_I_initial      = (G_I_initial > GMAX) ? GMAX : G_I_initial;
+         G_IB_initial     = (G_IB_initial > GMAX) ? GMAX : G_IB_initial;
+         float G_E_final  = G_E_initial * exp_tauE;
+         float G_I_final  = G_I_initial * exp_tauI;
+         float G_IB_final = G_IB_initial * exp_tauIB;
+
+         if (method == 'b') {
+            float dV1, dV2;
+            if (gap) {
+               dV1 = LIFGap_Vmem_derivative(
+                     l_V,
+                     G_E_initial,
+                     G_I_initial,
+                     G_IB_initial,
+                     l_GSynGap,
+                     Vexc,
+                     Vinh,
+                     VinhB,
+                     l_gapStrength,
+                     Vrest,
+                     tau);
+               dV2 = LIFGap_Vmem_derivative(
+                     l_V + dt * dV1,
+                     G_E_final,
+                     G_I_final,
+                     G_IB_final,
+                     l_GSynGap,
+                     Vexc,
+                     Vinh,
+                     VinhB,
+                     l_gapStrength,
+                     Vrest,
+                     tau);
+            }
+            else {
+               dV1 = LIF_Vmem_derivative(
+                     l_V, G_E_initial, G_I_initial, G_IB_initial, Vexc, Vinh, VinhB, Vrest, tau);
+               dV2 = LIF_Vmem_derivative(
+                     l_V + dt * dV1,
+                     G_E_final,
+                     G_I_final,
+                     G_IB_final,
+                     Vexc,
+                     Vinh,
+                     VinhB,
+                     Vrest,
+                     tau);
+            }
+            float dV = (dV1 + dV2) * 0.5f;
+            l_V      = l_V + dt * dV;
+         }
+         else {
+            float tau_inf_final, V_inf_final;
+            if (gap) {
+               tau_inf_final = tau / (1.0f + G_E_final + G_I_final + G_IB_final + l_gapStrength);
+               V_inf_final =
+                     (Vrest + Vexc * G_E_final + Vinh * G_I_final + VinhB * G_IB_final + l_GSynGap)
+                     / (1.0f + G_E_final + G_I_final + G_IB_final + l_gapStrength);
+            }
+            else {
+               tau_inf_final = tau / (1 + G_E_final + G_I_final + G_IB_initial);
+               V_inf_final   = (Vrest + Vexc * G_E_final + Vinh * G_I_final + VinhB * G_IB_final)
+                             / (1 + G_E_final + G_I_final + G_IB_final);
+            }
+            float tau_slope = (tau_inf_final - tau_inf_initial) / dt;
+            float f1        = tau_slope == 0.0f ? expf(-dt / tau_inf_initial)
+                                         : powf(tau_inf_final / tau_inf_initial, -1 / tau_slope);
+            float f2 = tau_slope == -1.0f
+                             ? tau_inf_initial / dt * logf(tau_inf_final / tau_inf_initial + 1.0f)
+                             : (1 - tau_inf_initial / dt * (1 - f1)) / (1 + tau_slope);
+            float f3 = 1.0f - f1 - f2;
+            l_V      = f1 * l_V + f2 * V_inf_initial + f3 * V_inf_final;
+         }
+         l_G_E  = G_E_final;
+         l_G_I  = G_I_final;
+         l_G_IB = G_IB_final;
+      }
+
+      l_Vth = VthRest + (l_Vth - VthRest) * exp_tauVth;
+
+      bool fired_flag = (l_V > l_Vth);
+      float l_activ   = fired_flag ? 1.0f : 0.0f;
+      l_V             = fired_flag ? Vrest : l_V;
+      l_Vth           = fired_flag ? l_Vth + deltaVth : l_Vth;
+      l_G_IB          = fired_flag ? l_G_IB + deltaGIB : l_G_IB;
+
+      rnd[k]                    = l_rnd;
+      state.activity[kex]       = l_activ;
+      state.V[k]                = l_V;
+      state.Vth[k]              = l_Vth;
+      state.G_E[k]              = l_G_E;
+      state.G_I[k]              = l_G_I;
+      state.G_IB[k]             = l_G_IB;
+      if (method == 'o') {
+         GSynExc[k]  = 0.0f;
+         GSynInh[k]  = 0.0f;
+         GSynInhB[k] = 0.0f;
+         if (gap) {
+            GSynGap[k] = 0.0f;
+         }
+      }
+   }
+}
+
+// The LCALIFLayer kernel.
+void referenceLCALIF(
+      PVLayerLoc const &loc,
+      LIF_params const *params,
+      bool normalizeInputFlag,
+      float targetRateHz,
+      taus_uint4 *rnd,
+      State &state) {
+   int const nbatch     = loc.nbatch;
+   int const numNeurons = loc.nx * loc.ny * loc.nf;
+   PVHalo const &halo   = loc.halo;
+   float *GSynExc       = &state.GSyn[CHANNEL_EXC * nbatch * numNeurons];
+   float *GSynInh       = &state.GSyn[CHANNEL_INH * nbatch * numNeurons];
+   float *GSynInhB      = &state.GSyn[CHANNEL_INHB * nbatch * numNeurons];
+   float *GSynGap       = &state.GSyn[CHANNEL_GAP * nbatch * numNeurons];
+   float *GSynNorm      = &state.GSyn[CHANNEL_NORM * nbatch * numNeurons];
+
+   float targetRatekHz  = targetRateHz / 1000.0f;
+   const float tauO     = 1 / targetRatekHz;
+   const float decayE   = expf((float)-dt / params->tauE);
+   const float decayI   = expf((float)-dt / params->tauI);
+   const float decayIB  = expf((float)-dt / params->tauIB);
+   const float decayVth = expf((float)-dt / params->tauVth);
+   const float decayO   = expf((float)-dt / tauO);
+   const float dt_sec   = (float)(0.001 * dt);
+   const float GMAX     = FLT_MAX;
+
+   float const tau      = params->tau;
+   float const Vexc     = params->Vexc;
+   float const Vinh     = params->Vinh;
+   float const VinhB    = params->VinhB;
+   float const Vrest    = params->Vrest;
+   float const deltaVth = params->deltaVth;
+   float const deltaGIB = params->deltaGIB;
+
+   for (int k = 0; k < numNeurons * nbatch; k++) {
+      int kex = kIndexExtendedBatch(
+            k, nbatch, loc.nx, loc.ny, loc.nf, halo.lt, halo.rt, halo.dn, halo.up);
+      taus_uint4 l_rnd    = rnd[k];
+      float l_V           = state.V[k];
+      float l_Vth         = state.Vth[k];
+      float l_G_E         = state.G_E[k];
+      float l_G_I         = state.G_I[k];
+      float l_G_IB        = state.G_IB[k];
+      float l_gapStrength = state.gapStrength[k];
+      float l_GSynExc     = GSynExc[k];
+      float l_GSynInh     = GSynInh[k];
+      float l_GSynInhB    = GSynInhB[k];
+      float l_GSynGap     = GSynGap[k];
+      float l_GSynNorm    = normalizeInputFlag ? GSynNorm[k] : 1.0f;
+
+      l_GSynExc /= (l_GSynNorm + (l_GSynNorm == 0 ? 1 : 0));
+      state.GSynExcEffective[k] = l_GSynExc;
+      state.GSynInhEffective[k] = l_GSynInh;
+
+      addNoise(
+            params,
+            dt_sec,
+            &l_rnd,
+            &state.excitatoryNoise[k],
+            &state.inhibitoryNoise[k],
+            &state.inhibNoiseB[k]);
+      if (state.excitatoryNoise[k] != 0.0f) {
+         l_GSynExc = l_GSynExc + state.excitatoryNoise[k];
+      }
+      if (state.inhibitoryNoise[k] != 0.0f) {
+         l_GSynInh = l_GSynInh + state.inhibitoryNoise[k];
+      }
+      if (state.inhibNoiseB[k] != 0.0f) {
+         l_GSynInhB = l_GSynInhB + state.inhibNoiseB[k];
+      }
+
+      float G_E_initial     = l_G_E + l_GSynExc;
+      float G_I_initial     = l_G_I + l_GSynInh;
+      float G_IB_initial    = l_G_IB + l_GSynInhB;
+      float tau_inf_initial = tau / (1 + G_E_initial + G_I_initial + G_IB_initial + l_gapStrength);
+      float V_inf_initial =
+            (Vrest + Vexc * G_E_initial + Vinh * G_I_initial + VinhB * G_IB_initial + l_GSynGap)
+            / (1 + G_E_initial + G_I_initial + G_IB_initial + l_gapStrength);
+
+      G_E_initial  = (G_E_initial > GMAX) ? GMAX : G_E_initial;
+      G_I_initial  = (G_I_initial > GMAX) ? GMAX : G_I_initial;
+      G_IB_initial = (G_IB_initial > GMAX) ? GMAX : G_IB_initial;
+
+      float totalconductance = 1.0f + G_E_initial + G_I_initial + G_IB_initial + l_gapStrength;
+      state.Vmeminf[k] =
+            (Vrest + Vexc * G_E_initial + Vinh * G_I_initial + VinhB * G_IB_initial + l_GSynGap)
+            / totalconductance;
+
+      float G_E_final     = G_E_initial * decayE;
+      float G_I_final     = G_I_initial * decayI;
+      float G_IB_final    = G_IB_initial * decayIB;
+      float tau_inf_final = tau / (1 + G_E_final + G_I_initial + G_IB_initial + l_gapStrength);
+      float V_inf_final =
+            (Vrest + Vexc * G_E_final + Vinh * G_I_final + VinhB * G_IB_final + l_GSynGap)
+            / (1 + G_E_final + G_I_final + G_IB_final + l_gapStrength);
+
+      float tau_slope = (tau_inf_final - tau_inf_initial) / (float)dt;
+      float f1        = tau_slope == 0.0f ? expf(-(float)dt / tau_inf_initial)
+                                   : powf(tau_inf_final / tau_inf_initial, -1.0f / tau_slope);
+      float f2 = tau_slope == -1.0f
+                       ? tau_inf_initial / (float)dt * logf(tau_inf_final / tau_inf_initial + 1.0f)
+                       : (1.0f - tau_inf_initial / (float)dt * (1.0f - f1)) / (1.0f + tau_slope);
+      float f3 = 1.0f - f1 - f2;
+      l_V      = f1 * l_V + f2 * V_inf_initial + f3 * V_inf_final;
+
+      l_G_E  = G_E_final;
+      l_G_I  = G_I_final;
+      l_G_IB = G_IB_final;
+
+      state.Vadpt[k] = -60.0f;
+      l_Vth          = state.Vadpt[k] + decayVth * (l_Vth - state.Vadpt[k]);
+
+      bool fired_flag    = (l_V > l_Vth);
+      float l_activ      = fired_flag ? 1.0f : 0.0f;
+      state.Vattained[k] = l_V;
+      l_V                = fired_flag ? Vrest : l_V;
+      l_Vth              = fired_flag ? l_Vth + deltaVth : l_Vth;
+      l_G_IB             = fired_flag ? l_G_IB + deltaGIB : l_G_IB;
+
+      state.integratedSpikeCount[k] = decayO * (l_activ + state.integratedSpikeCount[k]);
+
+      rnd[k]              = l_rnd;
+      state.activity[kex] = l_activ;
+      state.V[k]          = l_V;
+      state.Vth[k]        = l_Vth;
+      state.G_E[k]        = l_G_E;
+      state.G_I[k]        = l_G_I;
+      state.G_IB[k]       = l_G_IB;
+   }
+}
+
+///////////////////////////////////////////////////////
+//
+// The comparisons
+//
+
+void compareBuffers(
+      std::string const &description,
+      char const *bufferName,
+      std::vector<float> const &expected,
+      std::vector<float> const &observed) {
+   for (std::size_t k = 0; k < expected.size(); k++) {
+      FatalIf(
+            observed[k] != expected[k],
+            "%s: %s[%zu] is %g instead of %g.\n",
+            description.c_str(),
+            bufferName,
+            k,
+            (double)observed[k],
+            (double)expected[k]);
+   }
+}
+
+void compareGenerators(
+      std::string const &description,
+      int count,
+      Random &expected,
+      Random &observed) {
+   for (int k = 0; k < count; k++) {
+      taus_uint4 const *e = expected.getRNG(k);
+      taus_uint4 const *o = observed.getRNG(k);
+      FatalIf(
+            o->s0 != e->s0 or o->state.s1 != e->state.s1 or o->state.s2 != e->state.s2
+                  or o->state.s3 != e->state.s3,
+            "%s: the generator of neuron %d differs.\n",
+            description.c_str(),
+            k);
+   }
+}
+
+void compareActiveIndices(
+      std::string const &description,
+      PVLayerLoc const &loc,
+      std::vector<float> const &A,
+      LIFUpdate const &update) {
+   int const numExtended = (int)A.size() / loc.nbatch;
+   DataStore scanned(loc.nbatch, numExtended, 1, true /*sparse*/);
+   DataStore merged(loc.nbatch, numExtended, 1, true /*sparse*/);
+   for (int b = 0; b < loc.nbatch; b++) {
+      std::size_t const size = sizeof(float) * (std::size_t)numExtended;
+      std::memcpy(scanned.buffer(b, 0), &A[b * numExtended], size);
+      std::memcpy(merged.buffer(b, 0), &A[b * numExtended], size);
+      scanned.updateActiveIndices(b, 0);
+      merged.updateActiveIndices(b, 0, loc, update.getRowEntries(), update.getRowCounts());
+
+      long const numActive = *scanned.numActiveBuffer(b, 0);
+      FatalIf(
+            *merged.numActiveBuffer(b, 0) != numActive,
+            "%s, batch %d: %ld active indices instead of %ld.\n",
+            description.c_str(),
+            b,
+            *merged.numActiveBuffer(b, 0),
+            numActive);
+      SparseList<float>::Entry const *expected = scanned.activeIndicesBuffer(b, 0);
+      SparseList<float>::Entry const *observed = merged.activeIndicesBuffer(b, 0);
+      for (long n = 0; n < numActive; n++) {
+         FatalIf(
+               observed[n].index != expected[n].index or observed[n].value != expected[n].value,
+               "%s, batch %d: active entry %ld is (%u, %g) instead of (%u, %g).\n",
+               description.c_str(),
+               b,
+               n,
+               (unsigned)observed[n].index,
+               (double)observed[n].value,
+               (unsigned)expected[n].index,
+               (double)expected[n].value);
+      }
+   }
+}
+
+void compareStates(std::string const &description, State const &expected, State const &observed) {
+   compareBuffers(description, "V", expected.V, observed.V);
+   compareBuffers(description, "Vth", expected.Vth, observed.Vth);
+   compareBuffers(description, "G_E", expected.G_E, observed.G_E);
+   compareBuffers(description, "G_I", expected.G_I, observed.G_I);
+   compareBuffers(description, "G_IB", expected.G_IB, observed.G_IB);
+   compareBuffers(description, "GSyn", expected.GSyn, observed.GSyn);
+   compareBuffers(description, "activity", expected.activity, observed.activity);
+   compareBuffers(description, "Vadpt", expected.Vadpt, observed.Vadpt);
+   compareBuffers(
+         description,
+         "integratedSpikeCount",
+         expected.integratedSpikeCount,
+         observed.integratedSpikeCount);
+   compareBuffers(description, "Vattained", expected.Vattained, observed.Vattained);
+   compareBuffers(description, "Vmeminf", expected.Vmeminf, observed.Vmeminf);
+   compareBuffers(
+         description, "GSynExcEffective", expected.GSynExcEffective, observed.GSynExcEffective);
+   compareBuffers(
+         description, "GSynInhEffective", expected.GSynInhEffective, observed.GSynInhEffective);
+   compareBuffers(
+         description, "excitatoryNoise", expected.excitatoryNoise, observed.excitatoryNoise);
+   compareBuffers(
+         description, "inhibitoryNoise", expected.inhibitoryNoise, observed.inhibitoryNoise);
+   compareBuffers(description, "inhibNoiseB", expected.inhibNoiseB, observed.inhibNoiseB);
+}
+
+LIFUpdate::Buffers makeBuffers(State &state, bool gap) {
+   LIFUpdate::Buffers buffers;
+   buffers.V           = state.V.data();
+   buffers.Vth         = state.Vth.data();
+   buffers.G_E         = state.G_E.data();
+   buffers.G_I         = state.G_I.data();
+   buffers.G_IB        = state.G_IB.data();
+   buffers.GSynHead    = state.GSyn.data();
+   buffers.activity    = state.activity.data();
+   buffers.gapStrength = gap ? state.gapStrength.data() : nullptr;
+   return buffers;
+}
+
+LIFUpdate::LCALIFBuffers makeLCALIFBuffers(State &state, bool normalizeInput, float targetRateHz) {
+   LIFUpdate::LCALIFBuffers buffers;
+   buffers.Vadpt                = state.Vadpt.data();
+   buffers.integratedSpikeCount = state.integratedSpikeCount.data();
+   buffers.Vattained            = state.Vattained.data();
+   buffers.Vmeminf              = state.Vmeminf.data();
+   buffers.GSynExcEffective     = state.GSynExcEffective.data();
+   buffers.GSynInhEffective     = state.GSynInhEffective.data();
+   buffers.excitatoryNoise      = state.excitatoryNoise.data();
+   buffers.inhibitoryNoise      = state.inhibitoryNoise.data();
+   buffers.inhibNoiseB          = state.inhibNoiseB.data();
+   buffers.normalizeInput       = normalizeInput;
+   buffers.targetRateHz         = targetRateHz;
+   return buffers;
+}
+
+// The layer is LIF if numChannels is 3, LIFGap if it is 4 and LCALIFLayer if it is 5.
+void checkUpdate(char method, int numChannels, bool noise, bool normalizeInput) {
+   PVLayerLoc const loc    = makeLoc();
+   LIF_params const params = makeParams(noise);
+   bool const gap          = numChannels > 3;
+   float const targetRate  = 40.0f;
+   int const numNeurons    = loc.nbatch * loc.nx * loc.ny * loc.nf;
+   std::string description = std::string("method ") + method + ", " + std::to_string(numChannels)
+                             + " channels" + (noise ? ", with noise" : "")
+                             + (normalizeInput ? ", normalized" : "");
+
+   State expected = makeState(loc, numChannels);
+   State observed = makeState(loc, numChannels);
+   RandomSeed::instance()->initialize(seed);
+   Random expectedRandom(&loc, false /*restricted*/);
+   RandomSeed::instance()->initialize(seed);
+   Random observedRandom(&loc, false /*restricted*/);
+
+   LIFUpdate update(&loc, &params, true /*emit active indices*/);
+   LIFUpdate::Method updateMethod = LIFUpdate::ORIGINAL;
+   if (method == 'a') {
+      updateMethod = LIFUpdate::ARMA;
+   }
+   else if (method == 'b') {
+      updateMethod = LIFUpdate::BEGINNING;
+   }
+   for (int step = 0; step < numSteps; step++) {
+      setGSyn(expected, numChannels, step);
+      setGSyn(observed, numChannels, step);
+      LIFUpdate::Buffers buffers = makeBuffers(observed, gap);
+      if (numChannels == 5) {
+         referenceLCALIF(
+               loc, &params, normalizeInput, targetRate, expectedRandom.getRNG(0), expected);
+         update.generateNoise(&params, (float)(0.001 * dt), &observedRandom, (long)step);
+         update.updateLCALIF(
+               &params,
+               dt,
+               (double)step * dt,
+               buffers,
+               makeLCALIFBuffers(observed, normalizeInput, targetRate));
+      }
+      else {
+         referenceLIF(method, gap, loc, &params, expectedRandom.getRNG(0), expected);
+         update.generateNoise(&params, 0.001f * dt, &observedRandom, (long)step);
+         update.update(updateMethod, &params, dt, buffers);
+      }
+      std::string const stepDescription = description + ", step " + std::to_string(step);
+      compareStates(stepDescription, expected, observed);
+      compareActiveIndices(stepDescription, loc, observed.activity, update);
+      compareGenerators(stepDescription, numNeurons, expectedRandom, observedRandom);
+   }
+}
+
+int main(int argc, char *argv[]) {
+   for (char method : {'a', 'b', 'o'}) {
+      for (int numChannels = 3; numChannels <= 4; numChannels++) {
+         checkUpdate(method, numChannels, true /*noise*/, false);
+      }
+   }
+   checkUpdate('a', 3, false /*noise*/, false);
+   checkUpdate('a', 5, true /*noise*/, false /*normalize*/);
+   checkUpdate('a', 5, true /*noise*/, true /*normalize*/);
+   checkUpdate('a', 5, false /*noise*/, true /*normalize*/);
+   InfoLog() << "Test passed." << std::endl;
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/*
+ * main.cpp for LayerStatisticsTest
+ *
+ * Runs a layer probed by a StatsProbe and the L0, L1 and L2 norm probes, and checks the probe
+ * values and the layer's statistics against sums computed directly from the layer's activity.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <layers/HyPerLayer.hpp>
+#include <probes/AbstractNormProbe.hpp>
+#include <probes/LayerStatistics.hpp>
+
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+int checkStatistics(HyPerCol *hc, int argc, char *argv[]);
+void checkProbe(HyPerCol *hc, char const *probeName, std::vector<double> const &correct);
+void checkValue(char const *description, int b, double observed, double correct);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkStatistics);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkStatistics(HyPerCol *hc, int argc, char *argv[]) {
+   auto *layer = dynamic_cast<HyPerLayer *>(hc->getObjectFromName("Output"));
+   FatalIf(layer == nullptr, "No layer named \"Output\".\n");
+   PVLayerLoc const *loc = layer->getLayerLoc();
+   PVHalo const &halo    = loc->halo;
+   int const nbatch      = loc->nbatch;
+   int const numNeurons  = layer->getNumNeurons();
+   float const threshold = 0.5f;
+
+   // Reduce the direct sums across the processes of the column.
+   std::vector<double> sums(4 * nbatch, 0.0);
+   std::vector<float> minima(nbatch, FLT_MAX);
+   std::vector<float> maxima(nbatch, -FLT_MAX);
+   for (int b = 0; b < nbatch; b++) {
+      float const *activity = layer->getLayerData() + b * layer->getNumExtended();
+      for (int k = 0; k < numNeurons; k++) {
+         int kExt =
+               kIndexExtended(k, loc->nx, loc->ny, loc->nf, halo.lt, halo.rt, halo.dn, halo.up);
+         float a = activity[kExt];
+         sums[4 * b + 0] += (double)a;
+         sums[4 * b + 1] += (double)a * (double)a;
+         sums[4 * b + 2] += std::fabs((double)a);
+         sums[4 * b + 3] += std::fabs(a) > threshold ? 1.0 : 0.0;
+         minima[b] = std::min(minima[b], a);
+         maxima[b] = std::max(maxima[b], a);
+      }
+   }
+   MPI_Comm comm = hc->getCommunicator()->communicator();
+   MPI_Allreduce(MPI_IN_PLACE, sums.data(), 4 * nbatch, MPI_DOUBLE, MPI_SUM, comm);
+   MPI_Allreduce(MPI_IN_PLACE, minima.data(), nbatch, MPI_FLOAT, MPI_MIN, comm);
+   MPI_Allreduce(MPI_IN_PLACE, maxima.data(), nbatch, MPI_FLOAT, MPI_MAX, comm);
+
+   std::vector<double> l0(nbatch), l1(nbatch), l2(nbatch);
+   for (int b = 0; b < nbatch; b++) {
+      l2[b] = sums[4 * b + 1];
+      l1[b] = sums[4 * b + 2];
+      l0[b] = sums[4 * b + 3];
+      FatalIf(
+            l0[b] == 0.0 or l0[b] == (double)layer->getNumGlobalNeurons(),
+            "Batch element %d does not have activities on both sides of the threshold.\n",
+            b);
+   }
+   checkProbe(hc, "OutputL0Norm", l0);
+   checkProbe(hc, "OutputL1Norm", l1);
+   checkProbe(hc, "OutputL2Norm", l2);
+
+   LayerStatistics::Statistics const &stats =
+         layer->getStatistics()->compute(BufActivity, threshold, hc->simulationTime());
+   FatalIf(
+         stats.mNumGlobalNeurons != layer->getNumGlobalNeurons(),
+         "Statistics have %d neurons instead of %d.\n",
+         stats.mNumGlobalNeurons,
+         layer->getNumGlobalNeurons());
+   for (int b = 0; b < nbatch; b++) {
+      checkValue("sum", b, stats.mSum[b], sums[4 * b + 0]);
+      checkValue("sum of squares", b, stats.mSumSquared[b], sums[4 * b + 1]);
+      checkValue("sum of absolute values", b, stats.mSumAbs[b], sums[4 * b + 2]);
+      checkValue("number of nonzero values", b, stats.mNumNonzero[b], sums[4 * b + 3]);
+      checkValue("minimum", b, (double)stats.mMin[b], (double)minima[b]);
+      checkValue("maximum", b, (double)stats.mMax[b], (double)maxima[b]);
+   }
+   return PV_SUCCESS;
+}
+
+void checkProbe(HyPerCol *hc, char const *probeName, std::vector<double> const &correct) {
+   auto *probe = dynamic_cast<AbstractNormProbe *>(hc->getObjectFromName(probeName));
+   FatalIf(probe == nullptr, "No norm probe named \"%s\".\n", probeName);
+   std::vector<double> values;
+   probe->getValues(hc->simulationTime(), &values);
+   FatalIf(
+         values.size() != correct.size(),
+         "%s has %zu values instead of %zu.\n",
+         probeName,
+         values.size(),
+         correct.size());
+   for (std::size_t b = 0; b < values.size(); b++) {
+      checkValue(probeName, (int)b, values[b], correct[b]);
+   }
+}
+
+void checkValue(char const *description, int b, double observed, double correct) {
+   double const tolerance = 1.0e-6 * std::max(std::fabs(correct), 1.0);
+   FatalIf(
+         std::fabs(observed - correct) > tolerance,
+         "Batch element %d has %s %f instead of %f.\n",
+         b,
+         description,
+         observed,
+         correct);
+}
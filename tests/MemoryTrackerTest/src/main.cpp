@@ -0,0 +1,72 @@
+/*
+ * main.cpp for MemoryTrackerTest
+ *
+ * Runs a network with a plastic shared-weights connection, checks the memory that the
+ * MemoryTracker attributes to the connection, and checks that deleting the HyPerCol releases
+ * everything the network recorded.
+ */
+
+#include <columns/HyPerCol.hpp>
+#include <columns/PV_Init.hpp>
+#include <connections/HyPerConn.hpp>
+#include <layers/HyPerLayer.hpp>
+#include <utils/MemoryTracker.hpp>
+
+using namespace PV;
+
+int main(int argc, char *argv[]) {
+   PV_Init pv_init{&argc, &argv, false /*do not allow unrecognized arguments*/};
+   MemoryTracker *memoryTracker   = MemoryTracker::instance();
+   std::size_t const initialBytes = memoryTracker->getCurrentBytes();
+
+   HyPerCol *hc = new HyPerCol(&pv_init);
+   FatalIf(
+         memoryTracker->getBudget() != (std::size_t)64 * (std::size_t)1048576,
+         "memoryBudget was not passed to the MemoryTracker.\n");
+   int status = hc->run();
+   FatalIf(status != PV_SUCCESS, "HyPerCol::run failed.\n");
+
+   auto *conn = dynamic_cast<HyPerConn *>(hc->getObjectFromName("InputToOutput"));
+   FatalIf(conn == nullptr, "No connection named \"InputToOutput\".\n");
+   auto *output = dynamic_cast<HyPerLayer *>(hc->getObjectFromName("Output"));
+   FatalIf(output == nullptr, "No layer named \"Output\".\n");
+
+   // The weights and the weight changes each hold the patch data and the patch-to-data lookup
+   // table of the shared weights; normalizeDw adds a count of kernel activations per weight.
+   std::size_t const patchSize =
+         (std::size_t)(conn->getPatchSizeX() * conn->getPatchSizeY() * conn->getPatchSizeF());
+   std::size_t const numPatches = (std::size_t)conn->getNumDataPatches();
+   std::size_t const numWeights = (std::size_t)conn->getNumAxonalArbors() * numPatches * patchSize;
+   std::size_t const weightsBytes =
+         sizeof(float) * numWeights + sizeof(int) * (std::size_t)conn->getNumGeometryPatches();
+   std::size_t expectedBytes = 2 * weightsBytes + sizeof(long) * numWeights;
+   int const numThreads      = hc->getNumThreads();
+   if (numThreads > 1) {
+      std::size_t const numPostNeurons = (std::size_t)output->getNumNeurons();
+      expectedBytes += sizeof(float) * (std::size_t)numThreads * numPostNeurons;
+   }
+   std::size_t const connBytes = memoryTracker->getOwnerBytes("InputToOutput");
+   FatalIf(
+         connBytes != expectedBytes,
+         "MemoryTracker has %zu bytes for InputToOutput instead of %zu.\n",
+         connBytes,
+         expectedBytes);
+   FatalIf(
+         memoryTracker->getOwnerBytes("Output") == (std::size_t)0,
+         "MemoryTracker has no allocations for Output.\n");
+   std::string const report = memoryTracker->formatReport();
+   FatalIf(
+         report.find("\"InputToOutput\": delta weights") == std::string::npos,
+         "Memory report does not list the delta weights of InputToOutput.\n");
+
+   delete hc;
+   FatalIf(
+         memoryTracker->getCurrentBytes() != initialBytes,
+         "MemoryTracker has %zu bytes after deleting the HyPerCol instead of %zu.\n",
+         memoryTracker->getCurrentBytes(),
+         initialBytes);
+   FatalIf(
+         memoryTracker->getPeakBytes() < initialBytes + connBytes,
+         "MemoryTracker high-water mark is lower than the connection's allocations.\n");
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/*
+ * main.cpp for MetricsRegistryTest
+ *
+ * Runs a small network that writes its performance metrics every five timesteps, and checks the
+ * rows of the metrics file against the sizes of the layers and the connection.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <connections/HyPerConn.hpp>
+#include <layers/HyPerLayer.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int checkMetricsFile(HyPerCol *hc, int argc, char *argv[]);
+std::vector<std::string> splitLine(std::string const &line);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkMetricsFile);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkMetricsFile(HyPerCol *hc, int argc, char *argv[]) {
+   auto *conn = dynamic_cast<HyPerConn *>(hc->getObjectFromName("InputToOutput"));
+   FatalIf(conn == nullptr, "No connection named \"InputToOutput\".\n");
+   auto *input = dynamic_cast<HyPerLayer *>(hc->getObjectFromName("Input"));
+   FatalIf(input == nullptr, "No layer named \"Input\".\n");
+
+   // The convolution visits every extended presynaptic neuron on each timestep, on each process.
+   int const writeInterval = 5;
+   int const patchSize     = conn->getPatchSizeX() * conn->getPatchSizeY() * conn->getPatchSizeF();
+   double localOps         = (double)input->getNumExtendedAllBatches() * (double)patchSize
+                     * (double)writeInterval;
+   double expectedOps = 0.0;
+   Communicator *communicator = hc->getCommunicator();
+   MPI_Allreduce(
+         &localOps, &expectedOps, 1, MPI_DOUBLE, MPI_SUM, communicator->globalCommunicator());
+   if (communicator->globalCommRank() != 0) {
+      return PV_SUCCESS;
+   }
+
+   std::string const path = std::string(hc->getOutputPath()) + "/metrics.csv";
+   std::ifstream metricsStream(path);
+   FatalIf(metricsStream.fail(), "Unable to open metrics file \"%s\".\n", path.c_str());
+   std::string line;
+   std::getline(metricsStream, line);
+   FatalIf(
+         line != "time,name,type,synapticOps,activeNeurons,bytesMoved,haloBytes,"
+                 "mpiWaitSeconds,computeSeconds,gflops",
+         "Metrics file has header \"%s\".\n",
+         line.c_str());
+
+   // One row per counter set (two layers and one connection) at times 5 and 10.
+   int numRows = 0;
+   while (std::getline(metricsStream, line)) {
+      std::vector<std::string> fields = splitLine(line);
+      FatalIf(
+            fields.size() != (std::size_t)10,
+            "Metrics row \"%s\" has the wrong length.\n",
+            line.c_str());
+      double const time = std::stod(fields[0]);
+      FatalIf(
+            time != (double)(writeInterval * (numRows / 3 + 1)),
+            "Metrics row \"%s\" has the wrong time.\n",
+            line.c_str());
+      for (std::size_t k = 3; k < fields.size(); k++) {
+         FatalIf(
+               std::stod(fields[k]) < 0.0,
+               "Metrics row \"%s\" has a negative value.\n",
+               line.c_str());
+      }
+      if (fields[1] == "InputToOutput") {
+         FatalIf(fields[2] != "delivery", "Connection row has type \"%s\".\n", fields[2].c_str());
+         double const synapticOps = std::stod(fields[3]);
+         FatalIf(
+               synapticOps != expectedOps,
+               "InputToOutput has %.0f synaptic operations at time %g instead of %.0f.\n",
+               synapticOps,
+               time,
+               expectedOps);
+      }
+      else if (fields[1] == "Input" or fields[1] == "Output") {
+         FatalIf(fields[2] != "layer", "Layer row has type \"%s\".\n", fields[2].c_str());
+      }
+      else {
+         Fatal() << "Metrics file has an unexpected row \"" << line << "\".\n";
+      }
+      numRows++;
+   }
+   FatalIf(numRows != 6, "Metrics file has %d rows instead of 6.\n", numRows);
+   return PV_SUCCESS;
+}
+
+std::vector<std::string> splitLine(std::string const &line) {
+   std::vector<std::string> fields;
+   std::stringstream lineStream(line);
+   std::string field;
+   while (std::getline(lineStream, field, ',')) {
+      fields.push_back(field);
+   }
+   return fields;
+}
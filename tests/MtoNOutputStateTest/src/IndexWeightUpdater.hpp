@@ -27,6 +27,9 @@ class IndexWeightUpdater : public HebbianUpdater {
    int initialize(char const *name, HyPerCol *hc);
 
    virtual int updateWeights(int arborId) override;
+
+   // updateWeights() is overridden but updatePatch() is not, so the update cannot be fused.
+   virtual bool updatesByPatch() const override { return false; }
 };
 
 } // namespace PV
@@ -0,0 +1,163 @@
+/*
+ * main.cpp for NormalizeBenchmarkTest
+ *
+ * Runs a plastic connection for each type of normalization, and checks that every data patch
+ * satisfies its normalization at the end of the run. The time spent in each normalizer is
+ * reported by the "conn normalize" timers.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <connections/HyPerConn.hpp>
+
+#include <vector>
+
+int checkNormalizations(HyPerCol *hc, int argc, char *argv[]);
+HyPerConn *findConn(HyPerCol *hc, char const *connName);
+void checkSum(std::vector<HyPerConn *> const &conns, bool individually, float strength);
+void checkL2(std::vector<HyPerConn *> const &conns, bool individually, float strength);
+void checkMax(std::vector<HyPerConn *> const &conns, bool individually, float strength);
+void checkContrastZeroMean(HyPerConn *conn, bool individually, float strength);
+void checkValue(
+      HyPerConn *conn,
+      char const *quantity,
+      int patchIndex,
+      float observed,
+      float correct);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkNormalizations);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkNormalizations(HyPerCol *hc, int argc, char *argv[]) {
+   float const strength = 2.0f;
+   checkSum({findConn(hc, "SumAcrossArbors")}, false, strength);
+   checkSum({findConn(hc, "SumIndividually")}, true, strength);
+   checkL2({findConn(hc, "L2AcrossArbors")}, false, strength);
+   checkL2({findConn(hc, "L2Individually")}, true, strength);
+   checkMax({findConn(hc, "MaxAcrossArbors")}, false, strength);
+   checkMax({findConn(hc, "MaxIndividually")}, true, strength);
+   checkContrastZeroMean(findConn(hc, "ContrastZeroMeanAcrossArbors"), false, strength);
+   checkContrastZeroMean(findConn(hc, "ContrastZeroMeanIndividually"), true, strength);
+   checkL2({findConn(hc, "GroupHead"), findConn(hc, "GroupMember")}, false, strength);
+   return PV_SUCCESS;
+}
+
+HyPerConn *findConn(HyPerCol *hc, char const *connName) {
+   auto *conn = dynamic_cast<HyPerConn *>(hc->getObjectFromName(connName));
+   FatalIf(conn == nullptr, "No connection named \"%s\".\n", connName);
+   return conn;
+}
+
+int getPatchSize(HyPerConn *conn) {
+   return conn->getPatchSizeX() * conn->getPatchSizeY() * conn->getPatchSizeF();
+}
+
+void checkSum(std::vector<HyPerConn *> const &conns, bool individually, float strength) {
+   HyPerConn *conn0     = conns[0];
+   int const numArbors  = conn0->getNumAxonalArbors();
+   int const numPatches = conn0->getNumDataPatches();
+   int const numSums    = individually ? numArbors : 1;
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      std::vector<float> sums(numSums, 0.0f);
+      for (auto &c : conns) {
+         int const patchSize = getPatchSize(c);
+         for (int arbor = 0; arbor < numArbors; arbor++) {
+            float const *patch = c->getWeightsDataHead(arbor, patchIndex);
+            for (int k = 0; k < patchSize; k++) {
+               sums[individually ? arbor : 0] += patch[k];
+            }
+         }
+      }
+      for (auto &s : sums) {
+         checkValue(conn0, "sum", patchIndex, s, strength);
+      }
+   }
+}
+
+void checkL2(std::vector<HyPerConn *> const &conns, bool individually, float strength) {
+   HyPerConn *conn0     = conns[0];
+   int const numArbors  = conn0->getNumAxonalArbors();
+   int const numPatches = conn0->getNumDataPatches();
+   int const numSums    = individually ? numArbors : 1;
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      std::vector<float> sumsq(numSums, 0.0f);
+      for (auto &c : conns) {
+         int const patchSize = getPatchSize(c);
+         for (int arbor = 0; arbor < numArbors; arbor++) {
+            float const *patch = c->getWeightsDataHead(arbor, patchIndex);
+            for (int k = 0; k < patchSize; k++) {
+               sumsq[individually ? arbor : 0] += patch[k] * patch[k];
+            }
+         }
+      }
+      for (auto &s : sumsq) {
+         checkValue(conn0, "L2 norm", patchIndex, std::sqrt(s), strength);
+      }
+   }
+}
+
+void checkMax(std::vector<HyPerConn *> const &conns, bool individually, float strength) {
+   HyPerConn *conn0     = conns[0];
+   int const numArbors  = conn0->getNumAxonalArbors();
+   int const numPatches = conn0->getNumDataPatches();
+   int const numMaxes   = individually ? numArbors : 1;
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      std::vector<float> maxes(numMaxes, -FLT_MAX);
+      for (auto &c : conns) {
+         int const patchSize = getPatchSize(c);
+         for (int arbor = 0; arbor < numArbors; arbor++) {
+            float const *patch = c->getWeightsDataHead(arbor, patchIndex);
+            float &max         = maxes[individually ? arbor : 0];
+            for (int k = 0; k < patchSize; k++) {
+               max = patch[k] > max ? patch[k] : max;
+            }
+         }
+      }
+      for (auto &m : maxes) {
+         checkValue(conn0, "maximum", patchIndex, m, strength);
+      }
+   }
+}
+
+void checkContrastZeroMean(HyPerConn *conn, bool individually, float strength) {
+   int const numArbors  = conn->getNumAxonalArbors();
+   int const numPatches = conn->getNumDataPatches();
+   int const patchSize  = getPatchSize(conn);
+   int const numGroups  = individually ? numArbors : 1;
+   int const count      = individually ? patchSize : patchSize * numArbors;
+   for (int patchIndex = 0; patchIndex < numPatches; patchIndex++) {
+      std::vector<double> sums(numGroups, 0.0);
+      std::vector<double> sumsq(numGroups, 0.0);
+      for (int arbor = 0; arbor < numArbors; arbor++) {
+         float const *patch = conn->getWeightsDataHead(arbor, patchIndex);
+         for (int k = 0; k < patchSize; k++) {
+            sums[individually ? arbor : 0] += (double)patch[k];
+            sumsq[individually ? arbor : 0] += (double)patch[k] * (double)patch[k];
+         }
+      }
+      for (int g = 0; g < numGroups; g++) {
+         double mean = sums[g] / count;
+         double var  = sumsq[g] / count - mean * mean;
+         checkValue(conn, "mean", patchIndex, (float)mean, 0.0f);
+         checkValue(conn, "standard deviation", patchIndex, (float)std::sqrt(var), strength);
+      }
+   }
+}
+
+void checkValue(
+      HyPerConn *conn,
+      char const *quantity,
+      int patchIndex,
+      float observed,
+      float correct) {
+   float const tolerance = 1.0e-4f * (std::fabs(correct) > 1.0f ? std::fabs(correct) : 1.0f);
+   FatalIf(
+         std::fabs(observed - correct) > tolerance,
+         "%s: patch %d has %s %f instead of %f.\n",
+         conn->getDescription_c(),
+         patchIndex,
+         quantity,
+         (double)observed,
+         (double)correct);
+}
@@ -0,0 +1,84 @@
+/*
+ * main.cpp for ParallelWeightInitTest
+ *
+ * Builds the column with one thread and then with several, and checks that the weights of each
+ * connection agree exactly: the initializers that compute their patches in parallel must give
+ * the same weights, including the random ones, whatever the number of threads. Also checks that
+ * the time to the first step was measured.
+ */
+
+#include <columns/HyPerCol.hpp>
+#include <columns/PV_Init.hpp>
+#include <connections/HyPerConn.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace PV;
+
+#ifdef PV_USE_OPENMP_THREADS
+int const numThreads = 4;
+#else
+int const numThreads = 1;
+#endif // PV_USE_OPENMP_THREADS
+
+std::vector<std::string> const connNames = {"GaussianRandomConn",
+                                             "UniformRandomConn",
+                                             "Gauss2DConn"};
+
+std::vector<std::vector<float>> buildWeights(PV_Init *pv_init, int threads);
+
+int main(int argc, char *argv[]) {
+   PV_Init pv_init{&argc, &argv, false /*do not allow unrecognized arguments*/};
+   std::vector<std::vector<float>> const serial   = buildWeights(&pv_init, 1);
+   std::vector<std::vector<float>> const threaded = buildWeights(&pv_init, numThreads);
+
+   for (std::size_t c = 0; c < connNames.size(); c++) {
+      char const *connName = connNames[c].c_str();
+      bool nonzero         = false;
+      for (std::size_t k = 0; k < serial[c].size(); k++) {
+         FatalIf(
+               serial[c][k] != threaded[c][k],
+               "%s: weight %zu is %f with one thread and %f with %d threads.\n",
+               connName,
+               k,
+               (double)serial[c][k],
+               (double)threaded[c][k],
+               numThreads);
+         nonzero |= serial[c][k] != 0.0f;
+      }
+      FatalIf(!nonzero, "%s: the weights are all zero.\n", connName);
+   }
+   if (pv_init.getCommunicator()->globalCommRank() == 0) {
+      InfoLog() << "Test passed.\n";
+   }
+   return EXIT_SUCCESS;
+}
+
+std::vector<std::vector<float>> buildWeights(PV_Init *pv_init, int threads) {
+   Configuration::IntOptional numThreadsArg;
+   numThreadsArg.mValue = threads;
+   pv_init->setIntOptionalArgument("NumThreads", numThreadsArg);
+   HyPerCol *hc = new HyPerCol(pv_init);
+   hc->allocateColumn();
+   FatalIf(hc->getNumThreads() != threads, "The column did not use %d threads.\n", threads);
+   FatalIf(!(hc->getTimeToFirstStep() > 0.0), "The time to the first step was not measured.\n");
+
+   std::vector<std::vector<float>> weights;
+   for (auto const &connName : connNames) {
+      auto *conn = dynamic_cast<HyPerConn *>(hc->getObjectFromName(connName));
+      FatalIf(conn == nullptr, "No connection named \"%s\".\n", connName.c_str());
+      std::size_t const arborSize = (std::size_t)conn->getNumDataPatches()
+                                    * (std::size_t)conn->getPatchSizeX()
+                                    * (std::size_t)conn->getPatchSizeY()
+                                    * (std::size_t)conn->getPatchSizeF();
+      std::vector<float> connWeights;
+      for (int arbor = 0; arbor < conn->getNumAxonalArbors(); arbor++) {
+         float const *arborStart = conn->getWeightsDataStart(arbor);
+         connWeights.insert(connWeights.end(), arborStart, arborStart + arborSize);
+      }
+      weights.push_back(connWeights);
+   }
+   delete hc;
+   return weights;
+}
@@ -0,0 +1,162 @@
+/*
+ * main.cpp for ParamsCacheTest
+ *
+ * Parses a params file without a cache, and then twice with a cache: the first time the cache
+ * file is written, and the second time the params are read from it. The params read from the
+ * cache must be the same as the parsed ones, on every process. Then checks that the cache is not
+ * used for a params file with different contents, or when the cache file is damaged.
+ */
+
+#include "columns/CommandLineArguments.hpp"
+#include "columns/Communicator.hpp"
+#include "io/PVParams.hpp"
+#include "utils/PVLog.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+char const *paramsFile         = "input/ParamsCacheTest.params";
+char const *modifiedParamsFile = "ParamsCacheTestModified.params";
+char const *cacheFile          = "ParamsCacheTest.cache";
+
+PV::PVParams *readParams(char const *filename, PV::Communicator *comm, bool expectCacheHit);
+void checkParams(PV::PVParams *params);
+void checkSameParams(PV::PVParams *params, std::vector<char> const &reference, char const *what);
+
+int main(int argc, char *argv[]) {
+   PV::CommandLineArguments arguments{argc, argv, false /*do not allow unrecognized arguments*/};
+   MPI_Init(&argc, &argv);
+   PV::Communicator *comm = new PV::Communicator(&arguments);
+   bool const isRoot      = comm->globalCommRank() == 0;
+
+   PV::PVParams *reference = new PV::PVParams(paramsFile, 1, comm);
+   FatalIf(reference->getLoadedFromCache(), "Params without a cache path came from a cache.\n");
+   std::vector<char> const referenceSerialized = reference->serialize();
+   checkParams(reference);
+   delete reference;
+
+   if (isRoot) {
+      std::remove(cacheFile);
+   }
+   MPI_Barrier(comm->globalCommunicator());
+
+   PV::PVParams *params = readParams(paramsFile, comm, false /*expect a miss*/);
+   checkSameParams(params, referenceSerialized, "parsed while writing the cache");
+   delete params;
+
+   params = readParams(paramsFile, comm, true /*expect a hit*/);
+   checkSameParams(params, referenceSerialized, "read from the cache");
+   checkParams(params);
+   delete params;
+
+   // A params file with different contents must not use the cache written from the original.
+   if (isRoot) {
+      std::ifstream original(paramsFile);
+      std::ofstream modified(modifiedParamsFile);
+      modified << original.rdbuf();
+      modified << "HyPerLayer \"ExtraLayer\" = {\n   nf = 2;\n};\n";
+   }
+   MPI_Barrier(comm->globalCommunicator());
+   params = readParams(modifiedParamsFile, comm, false /*expect a miss*/);
+   FatalIf(params->group("ExtraLayer") == nullptr, "The modified params file was not parsed.\n");
+   delete params;
+
+   // The cache now holds the modified params, so the original is parsed again.
+   params = readParams(paramsFile, comm, false /*expect a miss*/);
+   checkSameParams(params, referenceSerialized, "parsed after the params file changed");
+   delete params;
+
+   // A damaged cache file is not used.
+   if (isRoot) {
+      std::ifstream cacheStream(cacheFile, std::ios_base::in | std::ios_base::binary);
+      std::vector<char> contents(
+            (std::istreambuf_iterator<char>(cacheStream)), std::istreambuf_iterator<char>());
+      cacheStream.close();
+      FatalIf(contents.empty(), "The cache file \"%s\" was not written.\n", cacheFile);
+      contents.back() ^= (char)0x5a;
+      std::ofstream damaged(cacheFile, std::ios_base::out | std::ios_base::binary);
+      damaged.write(contents.data(), (std::streamsize)contents.size());
+   }
+   MPI_Barrier(comm->globalCommunicator());
+   params = readParams(paramsFile, comm, false /*expect a miss*/);
+   checkSameParams(params, referenceSerialized, "parsed after the cache was damaged");
+   delete params;
+
+   if (isRoot) {
+      std::remove(modifiedParamsFile);
+      InfoLog() << "Test passed.\n";
+   }
+   delete comm;
+   MPI_Finalize();
+   return EXIT_SUCCESS;
+}
+
+PV::PVParams *readParams(char const *filename, PV::Communicator *comm, bool expectCacheHit) {
+   PV::PVParams *params = new PV::PVParams(filename, 1, comm, std::string(cacheFile));
+   FatalIf(
+         params->getParseStatus(),
+         "Rank %d: parsing \"%s\" failed.\n",
+         comm->globalCommRank(),
+         filename);
+   FatalIf(
+         params->getLoadedFromCache() != expectCacheHit,
+         "Rank %d: reading \"%s\" was %s instead of %s.\n",
+         comm->globalCommRank(),
+         filename,
+         params->getLoadedFromCache() ? "a cache hit" : "a cache miss",
+         expectCacheHit ? "a cache hit" : "a cache miss");
+   return params;
+}
+
+// Checks a few of the params. Leaves the parameter sweeps set to their first values.
+void checkParams(PV::PVParams *params) {
+   FatalIf(
+         params->numberOfGroups() != 4,
+         "Expected 4 groups, found %d.\n",
+         params->numberOfGroups());
+   FatalIf(params->value("CopiedLayer", "nf") != 5.0, "CopiedLayer:nf should be 5.\n");
+   FatalIf(
+         params->value("CopiedLayer", "phase") != 1.0,
+         "CopiedLayer:phase should be included from Layer.\n");
+   FatalIf(
+         params->stringPresent("Layer", "triggerLayerName") == 0
+               or params->stringValue("Layer", "triggerLayerName") != nullptr,
+         "Layer:triggerLayerName should be present and NULL.\n");
+   FatalIf(
+         std::strcmp(params->groupKeywordFromName("LayerToCopiedLayer"), "HyPerConn") != 0,
+         "LayerToCopiedLayer should be a HyPerConn.\n");
+
+   int delaySize          = 0;
+   double const *delays   = params->arrayValuesDbl("LayerToCopiedLayer", "delay", &delaySize);
+   double const correct[] = {0.0, 1.0, 2.5};
+   FatalIf(delaySize != 3, "LayerToCopiedLayer:delay should have 3 values.\n");
+   for (int k = 0; k < delaySize; k++) {
+      FatalIf(delays[k] != correct[k], "LayerToCopiedLayer:delay[%d] is wrong.\n", k);
+   }
+
+   // The two sweeps in the file, and the outputPath and checkpointWriteDir sweeps added for them.
+   FatalIf(
+         params->numberOfParameterSweeps() != 4 or params->getParameterSweepSize() != 2,
+         "Expected 4 parameter sweeps of 2 values.\n");
+   params->setParameterSweepValues(1);
+   FatalIf(params->value("column", "dt") != 0.25, "The dt sweep was not applied.\n");
+   FatalIf(
+         std::strcmp(params->stringValue("Layer", "InitVType"), "ConstantV") != 0,
+         "The InitVType sweep was not applied.\n");
+   FatalIf(
+         std::strcmp(params->stringValue("column", "outputPath"), "output//paramsweep_1/") != 0,
+         "The outputPath sweep is \"%s\".\n",
+         params->stringValue("column", "outputPath"));
+   params->setParameterSweepValues(0);
+}
+
+void checkSameParams(PV::PVParams *params, std::vector<char> const &reference, char const *what) {
+   FatalIf(
+         params->serialize() != reference,
+         "The params %s differ from the params parsed without a cache.\n",
+         what);
+}
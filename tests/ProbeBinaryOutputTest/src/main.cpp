@@ -0,0 +1,196 @@
+/*
+ * main.cpp for ProbeBinaryOutputTest
+ *
+ * Runs a layer probed by a StatsProbe writing uncompressed binary output and an L2 norm probe
+ * writing compressed binary output, and checks the header and records of each file against the
+ * probe's schema and the layer's final statistics.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <layers/HyPerLayer.hpp>
+#include <probes/AbstractNormProbe.hpp>
+#include <probes/LayerStatistics.hpp>
+#include <utils/BufferUtilsCompress.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct ProbeRecord {
+   double mTime;
+   int mBatch;
+   std::vector<double> mValues;
+};
+
+int checkBinaryOutput(HyPerCol *hc, int argc, char *argv[]);
+std::vector<ProbeRecord> readProbeFile(
+      std::string const &path,
+      std::string const &expectedSchema,
+      bool expectedCompressed);
+void checkRecords(
+      std::vector<ProbeRecord> const &records,
+      int nbatch,
+      double finalTime,
+      std::vector<std::vector<double>> const &finalValues);
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkBinaryOutput);
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkBinaryOutput(HyPerCol *hc, int argc, char *argv[]) {
+   auto *layer = dynamic_cast<HyPerLayer *>(hc->getObjectFromName("Output"));
+   FatalIf(layer == nullptr, "No layer named \"Output\".\n");
+   auto *l2Probe = dynamic_cast<AbstractNormProbe *>(hc->getObjectFromName("OutputL2Norm"));
+   FatalIf(l2Probe == nullptr, "No norm probe named \"OutputL2Norm\".\n");
+   int const nbatch       = layer->getLayerLoc()->nbatch;
+   double const finalTime = hc->simulationTime();
+
+   // The statistics and the norms involve reductions, so every process computes them.
+   LayerStatistics::Statistics const &stats =
+         layer->getStatistics()->compute(BufActivity, 0.0f, finalTime);
+   std::vector<double> l2Norms;
+   l2Probe->getValues(finalTime, &l2Norms);
+   if (hc->getCommunicator()->globalCommRank() != 0) {
+      return PV_SUCCESS;
+   }
+
+   std::vector<std::vector<double>> finalStats(nbatch);
+   std::vector<std::vector<double>> finalNorms(nbatch);
+   for (int b = 0; b < nbatch; b++) {
+      double const nk   = (double)stats.mNumGlobalNeurons;
+      double const mean = stats.mSum[b] / nk;
+      double const var  = stats.mSumSquared[b] / nk - mean * mean;
+      finalStats[b].push_back(nk);
+      finalStats[b].push_back(stats.mSum[b]);
+      finalStats[b].push_back((double)stats.mMin[b]);
+      finalStats[b].push_back(mean);
+      finalStats[b].push_back((double)stats.mMax[b]);
+      finalStats[b].push_back(std::sqrt(var > 0.0 ? var : 0.0));
+      finalStats[b].push_back(stats.mNumNonzero[b]);
+      finalNorms[b].push_back(l2Norms[b]);
+   }
+
+   std::string const outputPath  = std::string(hc->getOutputPath()) + "/";
+   std::string const statsSchema = "OutputStats\nN\nTotal\nMin\nAvg\nMax\nsigma\nnnz\n";
+   std::vector<ProbeRecord> statsRecords =
+         readProbeFile(outputPath + "OutputStats.pvprobe", statsSchema, false);
+   checkRecords(statsRecords, nbatch, finalTime, finalStats);
+   std::vector<ProbeRecord> normRecords =
+         readProbeFile(outputPath + "OutputL2Norm.pvprobe", "OutputL2Norm\nvalue\n", true);
+   checkRecords(normRecords, nbatch, finalTime, finalNorms);
+   FatalIf(
+         statsRecords.size() != normRecords.size(),
+         "OutputStats has %zu records but OutputL2Norm has %zu.\n",
+         statsRecords.size(),
+         normRecords.size());
+   return PV_SUCCESS;
+}
+
+std::vector<ProbeRecord> readProbeFile(
+      std::string const &path,
+      std::string const &expectedSchema,
+      bool expectedCompressed) {
+   std::ifstream stream(path, std::ios_base::in | std::ios_base::binary);
+   FatalIf(!stream.is_open(), "Unable to open \"%s\".\n", path.c_str());
+   std::vector<char> contents(
+         (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+   // magic, version, headerSize, numColumns, recordSize, compressed, recordsPerBlock, schemaSize
+   std::uint32_t header[8];
+   FatalIf(contents.size() < sizeof(header), "\"%s\" is too short.\n", path.c_str());
+   memcpy(header, contents.data(), sizeof(header));
+   FatalIf(memcmp(contents.data(), "PVPB", 4) != 0, "\"%s\" has the wrong magic.\n", path.c_str());
+   FatalIf(header[1] != 1U, "\"%s\" has version %u.\n", path.c_str(), (unsigned)header[1]);
+   std::string schema(&contents[sizeof(header)], (std::size_t)header[7]);
+   FatalIf(schema != expectedSchema, "\"%s\" has schema \"%s\".\n", path.c_str(), schema.c_str());
+   std::size_t const numColumns = (std::size_t)header[3];
+   std::size_t const recordSize = (std::size_t)header[4];
+   FatalIf(
+         recordSize != (2 + numColumns) * sizeof(double),
+         "\"%s\" has record size %zu.\n",
+         path.c_str(),
+         recordSize);
+   FatalIf(
+         (header[5] != 0U) != expectedCompressed,
+         "\"%s\" has the wrong compression flag.\n",
+         path.c_str());
+
+   std::vector<char> data;
+   std::size_t pos = (std::size_t)header[2];
+   if (expectedCompressed) {
+      while (pos < contents.size()) {
+         std::uint64_t chunkSize;
+         memcpy(&chunkSize, &contents[pos], sizeof(chunkSize));
+         pos += sizeof(chunkSize);
+         auto const *chunk       = reinterpret_cast<unsigned char const *>(&contents[pos]);
+         std::size_t const size  = BufferUtils::losslessUncompressedSize(chunk, chunkSize);
+         std::size_t const start = data.size();
+         data.resize(start + size);
+         BufferUtils::decompressLossless(chunk, chunkSize, &data[start], size);
+         pos += chunkSize;
+      }
+   }
+   else {
+      data.assign(contents.begin() + pos, contents.end());
+   }
+   FatalIf(data.size() % recordSize != 0, "\"%s\" has a partial record.\n", path.c_str());
+
+   std::vector<ProbeRecord> records(data.size() / recordSize);
+   for (std::size_t n = 0; n < records.size(); n++) {
+      char const *r = &data[n * recordSize];
+      std::int32_t batch;
+      memcpy(&records[n].mTime, r, sizeof(double));
+      memcpy(&batch, r + sizeof(double), sizeof(batch));
+      records[n].mBatch = (int)batch;
+      records[n].mValues.resize(numColumns);
+      memcpy(records[n].mValues.data(), r + 2 * sizeof(double), numColumns * sizeof(double));
+   }
+   return records;
+}
+
+void checkRecords(
+      std::vector<ProbeRecord> const &records,
+      int nbatch,
+      double finalTime,
+      std::vector<std::vector<double>> const &finalValues) {
+   // The probe writes every timestep, one record per batch element in order, from time 0 through
+   // the final time. The network is static after its first update, so the values of the last
+   // timestep equal the final statistics.
+   FatalIf(records.size() % nbatch != 0, "Number of records is not a multiple of nbatch.\n");
+   int const numTimes = (int)records.size() / nbatch;
+   FatalIf(numTimes < 2, "Only %d timesteps were written.\n", numTimes);
+   for (int t = 0; t < numTimes; t++) {
+      for (int b = 0; b < nbatch; b++) {
+         ProbeRecord const &record = records[t * nbatch + b];
+         FatalIf(
+               record.mTime != records[t * nbatch].mTime or record.mBatch != b,
+               "Record %d has time %f and batch index %d.\n",
+               t * nbatch + b,
+               record.mTime,
+               record.mBatch);
+      }
+   }
+   FatalIf(
+         records.back().mTime != finalTime,
+         "Last record has time %f instead of %f.\n",
+         records.back().mTime,
+         finalTime);
+   for (int b = 0; b < nbatch; b++) {
+      ProbeRecord const &record = records[(numTimes - 1) * nbatch + b];
+      for (std::size_t k = 0; k < finalValues[b].size(); k++) {
+         double const correct   = finalValues[b][k];
+         double const tolerance = 1.0e-6 * std::max(std::fabs(correct), 1.0);
+         FatalIf(
+               std::fabs(record.mValues[k] - correct) > tolerance,
+               "Batch element %d has value %f instead of %f in column %zu.\n",
+               b,
+               record.mValues[k],
+               correct,
+               k);
+      }
+   }
+}
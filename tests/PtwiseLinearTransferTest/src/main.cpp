@@ -0,0 +1,222 @@
+/*
+ * main.cpp for PtwiseLinearTransferTest
+ *
+ * Compares each kernel of PtwiseLinearTransfer with the vertex scan that the transfer function
+ * was originally computed with, on potentials that include the vertices themselves, jumps, NaN
+ * and values far outside the vertices, and checks that the margins of the activity are untouched.
+ */
+
+#include "layers/PtwiseLinearTransfer.hpp"
+#include "utils/PVLog.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using PV::PtwiseLinearTransfer;
+
+struct TransferFunction {
+   char const *mName;
+   std::vector<float> mVerticesV;
+   std::vector<float> mVerticesA;
+   std::vector<float> mSlopes;
+   PtwiseLinearTransfer::Kernel mKernel;
+};
+
+// Computes the slopes the same way as ANNLayer::setSlopes().
+std::vector<float> computeSlopes(
+      std::vector<float> const &verticesV,
+      std::vector<float> const &verticesA,
+      float slopeNegInf,
+      float slopePosInf) {
+   int const numVertices = (int)verticesV.size();
+   std::vector<float> slopes(numVertices + 1);
+   slopes[0] = slopeNegInf;
+   for (int k = 1; k < numVertices; k++) {
+      float V1 = verticesV[k - 1];
+      float V2 = verticesV[k];
+      if (V1 != V2) {
+         slopes[k] = (verticesA[k] - verticesA[k - 1]) / (V2 - V1);
+      }
+      else {
+         slopes[k] = verticesA[k] > verticesA[k - 1]
+                           ? std::numeric_limits<float>::infinity()
+                           : verticesA[k] < verticesA[k - 1]
+                                   ? -std::numeric_limits<float>::infinity()
+                                   : std::numeric_limits<float>::quiet_NaN();
+      }
+   }
+   slopes[numVertices] = slopePosInf;
+   return slopes;
+}
+
+TransferFunction makeTransferFunction(
+      char const *name,
+      std::vector<float> const &verticesV,
+      std::vector<float> const &verticesA,
+      float slopeNegInf,
+      float slopePosInf,
+      PtwiseLinearTransfer::Kernel kernel) {
+   TransferFunction transfer;
+   transfer.mName      = name;
+   transfer.mVerticesV = verticesV;
+   transfer.mVerticesA = verticesA;
+   transfer.mSlopes    = computeSlopes(verticesV, verticesA, slopeNegInf, slopePosInf);
+   transfer.mKernel    = kernel;
+   return transfer;
+}
+
+// A transfer function that rises by 0.2 over an interval of 0.2 and then by 0.05 over an interval
+// of 0.3, numSteps times, except that the fourth rise of 0.2 is a vertical jump.
+TransferFunction
+makeStaircase(char const *name, int numSteps, PtwiseLinearTransfer::Kernel kernel) {
+   std::vector<float> verticesV;
+   std::vector<float> verticesA;
+   for (int k = 0; k < numSteps; k++) {
+      verticesV.push_back(-1.0f + 0.5f * (float)k);
+      verticesA.push_back(0.25f * (float)k);
+      verticesV.push_back(-1.0f + 0.5f * (float)k + (k == 3 ? 0.0f : 0.2f));
+      verticesA.push_back(0.25f * (float)k + 0.2f);
+   }
+   return makeTransferFunction(name, verticesV, verticesA, 0.5f, -0.5f, kernel);
+}
+
+// The vertex scan that setActivity_PtwiseLinearTransferLayer used, for one potential.
+float referenceActivity(TransferFunction const &transfer, float potential) {
+   float const *verticesV = transfer.mVerticesV.data();
+   float const *verticesA = transfer.mVerticesA.data();
+   float const *slopes    = transfer.mSlopes.data();
+   int const numVertices  = (int)transfer.mVerticesV.size();
+   int const last         = numVertices - 1;
+   float activity         = 0.0f;
+   if (potential < verticesV[0]) {
+      activity = verticesA[0] + slopes[0] * (potential - verticesV[0]);
+   }
+   else if (potential >= verticesV[last]) {
+      activity = verticesA[last] + slopes[numVertices] * (potential - verticesV[last]);
+   }
+   else {
+      for (int v = 0; v < last; v++) {
+         if (potential < verticesV[v]) {
+            break;
+         }
+         if (potential == verticesV[v]) {
+            activity = verticesA[v];
+         }
+         else if (potential > verticesV[v] && potential < verticesV[v + 1]) {
+            activity = verticesA[v] + slopes[v + 1] * (potential - verticesV[v]);
+         }
+      }
+   }
+   return activity;
+}
+
+std::vector<float> makePotentials(TransferFunction const &transfer, int count) {
+   std::vector<float> potentials;
+   for (float v : transfer.mVerticesV) {
+      potentials.push_back(v);
+      potentials.push_back(std::nextafter(v, -INFINITY));
+      potentials.push_back(std::nextafter(v, INFINITY));
+   }
+   potentials.push_back(std::numeric_limits<float>::quiet_NaN());
+   potentials.push_back(-1.0e6f);
+   potentials.push_back(1.0e6f);
+   for (int k = 0; (int)potentials.size() < count; k++) {
+      potentials.push_back(-3.0f + 0.02f * (float)k);
+   }
+   potentials.resize(count);
+   return potentials;
+}
+
+void checkTransferFunction(TransferFunction const &transfer) {
+   PtwiseLinearTransfer engine(
+         (int)transfer.mVerticesV.size(),
+         transfer.mVerticesV.data(),
+         transfer.mVerticesA.data(),
+         transfer.mSlopes.data());
+   FatalIf(
+         engine.getKernel() != transfer.mKernel,
+         "%s: expected kernel %d, got %d.\n",
+         transfer.mName,
+         (int)transfer.mKernel,
+         (int)engine.getKernel());
+
+   // Rows whose lengths are not multiples of a vector width, and margins of different widths.
+   int const nbatch      = 2;
+   int const nx          = 13;
+   int const ny          = 5;
+   int const nf          = 3;
+   int const lt          = 1;
+   int const rt          = 2;
+   int const dn          = 3;
+   int const up          = 2;
+   int const numNeurons  = nx * ny * nf;
+   int const nxExt       = nx + lt + rt;
+   int const nyExt       = ny + dn + up;
+   int const numExtended = nxExt * nyExt * nf;
+   float const sentinel  = -123.0f;
+
+   std::vector<float> V = makePotentials(transfer, nbatch * numNeurons);
+   std::vector<float> A(nbatch * numExtended, sentinel);
+   engine.apply(nbatch, nx, ny, nf, lt, rt, dn, up, V.data(), A.data());
+
+   for (int b = 0; b < nbatch; b++) {
+      for (int y = 0; y < nyExt; y++) {
+         for (int x = 0; x < nxExt; x++) {
+            for (int f = 0; f < nf; f++) {
+               int const kExt          = ((b * nyExt + y) * nxExt + x) * nf + f;
+               bool const inRestricted = x >= lt and x < lt + nx and y >= up and y < up + ny;
+               float expected          = sentinel;
+               if (inRestricted) {
+                  int const k = ((b * ny + y - up) * nx + x - lt) * nf + f;
+                  expected    = referenceActivity(transfer, V[k]);
+               }
+               FatalIf(
+                     A[kExt] != expected,
+                     "%s: batch %d, x=%d, y=%d, f=%d: expected %g, got %g.\n",
+                     transfer.mName,
+                     b,
+                     x,
+                     y,
+                     f,
+                     (double)expected,
+                     (double)A[kExt]);
+            }
+         }
+      }
+   }
+}
+
+int main(int argc, char *argv[]) {
+   std::vector<TransferFunction> transfers;
+   // The default ANNLayer: A = V - AShift, with AShift = 0.25.
+   transfers.push_back(makeTransferFunction(
+         "linear", {0.0f}, {-0.25f}, 1.0f, 1.0f, PtwiseLinearTransfer::LINEAR));
+   // Soft threshold (AShift = VThresh = 0.5).
+   transfers.push_back(makeTransferFunction(
+         "soft threshold", {0.5f}, {0.0f}, 0.0f, 1.0f, PtwiseLinearTransfer::SELECT));
+   // Hard threshold (VThresh = 0.5, AShift = 0), with a jump from 0 to 0.5.
+   transfers.push_back(makeTransferFunction(
+         "hard threshold", {0.5f, 0.5f}, {0.0f, 0.5f}, 0.0f, 1.0f, PtwiseLinearTransfer::SELECT));
+   // Firm threshold (VThresh = 0.25, VWidth = 0.5, AShift = 0.5) clipped at AMax = 1.
+   transfers.push_back(makeTransferFunction(
+         "firm threshold",
+         {0.25f, 0.75f, 1.5f},
+         {0.0f, 0.25f, 1.0f},
+         0.0f,
+         0.0f,
+         PtwiseLinearTransfer::SELECT));
+   // An indicator function, as in ANNLayerVerticesTest.
+   transfers.push_back(makeTransferFunction(
+         "indicator", {0.5f, 0.5f}, {0.0f, 1.0f}, 0.0f, 0.0f, PtwiseLinearTransfer::SELECT));
+   // Staircases with a vertical step, with as many vertices as the select kernel takes, and with
+   // more.
+   transfers.push_back(makeStaircase("short staircase", 8, PtwiseLinearTransfer::SELECT));
+   transfers.push_back(makeStaircase("long staircase", 10, PtwiseLinearTransfer::SEARCH));
+
+   for (auto const &transfer : transfers) {
+      checkTransferFunction(transfer);
+   }
+   InfoLog() << "Test passed." << std::endl;
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+/*
+ * main.cpp for RandomPhiloxTest
+ *
+ * Checks the Philox4x32-10 function against the known-answer vectors of the Random123 library,
+ * and checks that a Random with the Philox generator gives the same numbers to a neuron whatever
+ * the partition of the layer into processes, and whether the numbers are drawn one at a time or
+ * in bulk.
+ */
+
+#include "columns/Random.hpp"
+#include "columns/RandomSeed.hpp"
+#include "utils/PVLog.hpp"
+#include "utils/Philox.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using PV::Random;
+using PV::RandomSeed;
+
+unsigned int const seed = 12345678U;
+
+void checkKnownAnswer(
+      std::uint32_t const counter[4],
+      std::uint32_t const key[2],
+      std::uint32_t const expected[4]) {
+   std::uint32_t result[4];
+   PV::philox4x32(counter, key, result);
+   for (int k = 0; k < 4; k++) {
+      FatalIf(
+            result[k] != expected[k],
+            "philox4x32 of counter %08x %08x %08x %08x, key %08x %08x: word %d is %08x instead of "
+            "%08x.\n",
+            counter[0],
+            counter[1],
+            counter[2],
+            counter[3],
+            key[0],
+            key[1],
+            k,
+            result[k],
+            expected[k]);
+   }
+}
+
+void checkKnownAnswers() {
+   std::uint32_t const zeroCounter[4]   = {0U, 0U, 0U, 0U};
+   std::uint32_t const zeroKey[2]       = {0U, 0U};
+   std::uint32_t const zeroResult[4]    = {0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U};
+   std::uint32_t const onesCounter[4]   = {0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU};
+   std::uint32_t const onesKey[2]       = {0xffffffffU, 0xffffffffU};
+   std::uint32_t const onesResult[4]    = {0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU};
+   std::uint32_t const digitsCounter[4] = {0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U};
+   std::uint32_t const digitsKey[2]     = {0xa4093822U, 0x299f31d0U};
+   std::uint32_t const digitsResult[4]  = {0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U};
+   checkKnownAnswer(zeroCounter, zeroKey, zeroResult);
+   checkKnownAnswer(onesCounter, onesKey, onesResult);
+   checkKnownAnswer(digitsCounter, digitsKey, digitsResult);
+}
+
+PVLayerLoc makeGlobalLoc() {
+   PVLayerLoc loc;
+   loc.nbatch       = 2;
+   loc.nx           = 12;
+   loc.ny           = 6;
+   loc.nf           = 3;
+   loc.nbatchGlobal = loc.nbatch;
+   loc.nxGlobal     = loc.nx;
+   loc.nyGlobal     = loc.ny;
+   loc.kb0          = 0;
+   loc.kx0          = 0;
+   loc.ky0          = 0;
+   loc.halo.lt      = 2;
+   loc.halo.rt      = 2;
+   loc.halo.dn      = 1;
+   loc.halo.up      = 1;
+   return loc;
+}
+
+// The part of the layer that one process of a rows-by-columns partition would hold.
+PVLayerLoc makeLocalLoc(PVLayerLoc const &globalLoc, int rows, int columns, int row, int column) {
+   PVLayerLoc loc = globalLoc;
+   loc.nx         = globalLoc.nxGlobal / columns;
+   loc.ny         = globalLoc.nyGlobal / rows;
+   loc.kx0        = column * loc.nx;
+   loc.ky0        = row * loc.ny;
+   return loc;
+}
+
+// Checks that every neuron of each process's part of the extended layer, margins included, gets
+// the same numbers as the neuron with the same global position in the undivided layer.
+void checkDecomposition(int rows, int columns) {
+   PVLayerLoc const globalLoc = makeGlobalLoc();
+   RandomSeed::instance()->initialize(seed);
+   Random whole(&globalLoc, true /*extended*/, RandomSeed::PHILOX);
+   int const nxGlobalExt = globalLoc.nxGlobal + globalLoc.halo.lt + globalLoc.halo.rt;
+   int const nyGlobalExt = globalLoc.nyGlobal + globalLoc.halo.dn + globalLoc.halo.up;
+   int const nf          = globalLoc.nf;
+
+   for (int row = 0; row < rows; row++) {
+      for (int column = 0; column < columns; column++) {
+         PVLayerLoc const loc = makeLocalLoc(globalLoc, rows, columns, row, column);
+         RandomSeed::instance()->initialize(seed);
+         Random part(&loc, true /*extended*/, RandomSeed::PHILOX);
+         int const nxExt = loc.nx + loc.halo.lt + loc.halo.rt;
+         int const nyExt = loc.ny + loc.halo.dn + loc.halo.up;
+         for (int b = 0; b < loc.nbatch; b++) {
+            for (int y = 0; y < nyExt; y++) {
+               for (int x = 0; x < nxExt * nf; x++) {
+                  int const local  = (b * nyExt + y) * nxExt * nf + x;
+                  int const global = (b * nyGlobalExt + y + loc.ky0) * nxGlobalExt * nf
+                                     + x + loc.kx0 * nf;
+                  for (unsigned int position = 0U; position < 6U; position++) {
+                     long const step             = 3L + (long)position;
+                     unsigned int const expected = whole.counterUInt(global, step, position);
+                     unsigned int const observed = part.counterUInt(local, step, position);
+                     FatalIf(
+                           observed != expected,
+                           "%d-by-%d partition, process (%d, %d): local index %d gives %u instead "
+                           "of %u.\n",
+                           rows,
+                           columns,
+                           row,
+                           column,
+                           local,
+                           observed,
+                           expected);
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+// Checks that the bulk methods agree with counterUniform, across row boundaries of a part of a
+// layer, and that the values are in [0, 1).
+void checkBulkFills() {
+   PVLayerLoc const loc = makeLocalLoc(makeGlobalLoc(), 2, 2, 1, 0);
+   RandomSeed::instance()->initialize(seed);
+   Random random(&loc, false /*restricted*/, RandomSeed::PHILOX);
+   int const numNeurons = loc.nbatch * loc.nx * loc.ny * loc.nf;
+   long const step      = 1234567890123L;
+
+   std::vector<float> values(numNeurons);
+   std::vector<unsigned int> words(numNeurons);
+   for (unsigned int position = 0U; position < 9U; position++) {
+      random.fillUniform(values.data(), 0, numNeurons, step, position);
+      random.fillUInt(words.data(), 0, numNeurons, step, position);
+      for (int k = 0; k < numNeurons; k++) {
+         float const expected = random.counterUniform(k, step, position);
+         FatalIf(
+               values[k] != expected or words[k] != random.counterUInt(k, step, position),
+               "fillUniform and fillUInt disagree with counterUniform at index %d, position %u.\n",
+               k,
+               position);
+         FatalIf(
+               !(values[k] >= 0.0f and values[k] < 1.0f),
+               "Value %g at index %d, position %u is not in [0, 1).\n",
+               (double)values[k],
+               k,
+               position);
+      }
+   }
+
+   int const count = 11;
+   std::vector<float> sequence(count);
+   for (unsigned int first = 0U; first < 5U; first++) {
+      random.fillUniformSequence(sequence.data(), 7, step, first, count);
+      for (int k = 0; k < count; k++) {
+         FatalIf(
+               sequence[k] != random.counterUniform(7, step, first + (unsigned int)k),
+               "fillUniformSequence disagrees with counterUniform at position %u.\n",
+               first + (unsigned int)k);
+      }
+   }
+
+   // A different timestep gives different numbers.
+   int numEqual = 0;
+   for (int k = 0; k < numNeurons; k++) {
+      numEqual += random.counterUInt(k, step, 0U) == random.counterUInt(k, step + 1L, 0U);
+   }
+   FatalIf(numEqual > 0, "%d of %d numbers repeat in the next timestep.\n", numEqual, numNeurons);
+}
+
+int main(int argc, char *argv[]) {
+   checkKnownAnswers();
+   checkDecomposition(1, 1);
+   checkDecomposition(2, 3);
+   checkDecomposition(3, 2);
+   checkBulkFills();
+   InfoLog() << "Test passed." << std::endl;
+   return EXIT_SUCCESS;
+}
@@ -25,6 +25,9 @@ class IncrementingWeightUpdater : public HebbianUpdater {
    int initialize(char const *name, HyPerCol *hc);
 
    virtual int updateWeights(int arborId);
+
+   // updateWeights() is overridden but updatePatch() is not, so the update cannot be fused.
+   virtual bool updatesByPatch() const override { return false; }
 };
 
 } // namespace PV
@@ -0,0 +1,121 @@
+/*
+ * main.cpp for TracerTest
+ *
+ * Runs a small network with the -trace option and checks the zones in the trace file, then checks
+ * the Tracer's ring buffers and its enabled/disabled behavior directly.
+ */
+
+#include <columns/buildandrun.hpp>
+#include <utils/Tracer.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+int checkTraceFile(HyPerCol *hc, int argc, char *argv[]);
+int countOccurrences(std::string const &text, std::string const &pattern);
+void checkRingBuffers();
+
+int main(int argc, char *argv[]) {
+   int status = buildandrun(argc, argv, nullptr, checkTraceFile);
+   if (status == PV_SUCCESS) {
+      checkRingBuffers();
+   }
+   return status == PV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int checkTraceFile(HyPerCol *hc, int argc, char *argv[]) {
+   Communicator *communicator = hc->getCommunicator();
+   if (communicator->globalCommRank() != 0) {
+      return PV_SUCCESS;
+   }
+   std::string const &traceFile = hc->getPV_InitObj()->getStringArgument("TraceFile");
+   FatalIf(traceFile.empty(), "TracerTest must be run with the -trace option.\n");
+   std::ifstream traceStream(traceFile);
+   FatalIf(traceStream.fail(), "Unable to open trace file \"%s\".\n", traceFile.c_str());
+   std::stringstream buffer;
+   buffer << traceStream.rdbuf();
+   std::string const trace = buffer.str();
+
+   std::string const header("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+   std::string const footer("]}\n");
+   FatalIf(
+         trace.size() < header.size() + footer.size()
+               or trace.compare(0, header.size(), header) != 0
+               or trace.compare(trace.size() - footer.size(), footer.size(), footer) != 0,
+         "Trace file \"%s\" is not a Chrome trace event file.\n",
+         traceFile.c_str());
+   FatalIf(trace.find(",\n]}") != std::string::npos, "Trace file has a trailing comma.\n");
+
+   int const numProcs = communicator->globalCommSize();
+   int const numSteps = 10;
+   struct ExpectedZone {
+      std::string mPattern;
+      int mCount;
+   };
+   int const numZones = numSteps * numProcs;
+   ExpectedZone expected[] = {{"\"name\":\"process_name\"", numProcs},
+                              {"\"name\":\"column run\",\"cat\":\"column\"", numZones},
+                              {"\"name\":\"phase 0\",\"cat\":\"column\"", numZones},
+                              {"\"name\":\"phase 1\",\"cat\":\"column\"", numZones},
+                              {"\"name\":\"InputToOutput\",\"cat\":\"deliver\"", numZones},
+                              {"\"name\":\"Output update\",\"cat\":\"layer\"", numZones}};
+   for (auto &e : expected) {
+      int count = countOccurrences(trace, e.mPattern);
+      FatalIf(
+            count != e.mCount,
+            "Trace file has %d occurrences of %s instead of %d.\n",
+            count,
+            e.mPattern.c_str(),
+            e.mCount);
+   }
+   return PV_SUCCESS;
+}
+
+int countOccurrences(std::string const &text, std::string const &pattern) {
+   int count = 0;
+   auto pos  = text.find(pattern);
+   while (pos != std::string::npos) {
+      count++;
+      pos = text.find(pattern, pos + 1);
+   }
+   return count;
+}
+
+void checkRingBuffers() {
+   PV::Tracer *tracer = PV::Tracer::instance();
+
+   // When a thread's buffer is full, the oldest events are overwritten.
+   tracer->enable(4);
+   for (int n = 0; n < 10; n++) {
+      PV::TraceZone zone("zone", "test");
+   }
+   FatalIf(
+         tracer->getNumEvents() != (std::size_t)4,
+         "Ring buffer holds %zu events instead of 4.\n",
+         tracer->getNumEvents());
+
+   // Each thread records into its own buffer.
+   tracer->enable(1000);
+   int const numZones = 100;
+#ifdef PV_USE_OPENMP_THREADS
+#pragma omp parallel for
+#endif // PV_USE_OPENMP_THREADS
+   for (int n = 0; n < numZones; n++) {
+      PV::TraceZone zone("zone", "test");
+   }
+   FatalIf(
+         tracer->getNumEvents() != (std::size_t)numZones,
+         "Tracer recorded %zu events instead of %d.\n",
+         tracer->getNumEvents(),
+         numZones);
+
+   // Nothing is recorded while tracing is disabled.
+   tracer->disable();
+   for (int n = 0; n < 10; n++) {
+      PV::TraceZone zone("zone", "test");
+   }
+   FatalIf(
+         tracer->getNumEvents() != (std::size_t)numZones,
+         "Tracer recorded events while disabled.\n");
+}
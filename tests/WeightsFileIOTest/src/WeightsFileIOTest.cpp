@@ -90,7 +90,13 @@ bool isActiveWeight(int itemIndex, int localPatchIndex, PV::Weights const &weigh
    return (x >= startx and x < startx + patch.nx and y >= starty and y < starty + patch.ny);
 }
 
-void testWeights(PV::Weights &weights, PV::PV_Init &pv_init, bool sharedFlag, bool compressedFlag) {
+void testWeights(
+      PV::Weights &weights,
+      PV::PV_Init &pv_init,
+      bool sharedFlag,
+      bool compressedFlag,
+      bool losslessFlag,
+      std::size_t streamBufferSize) {
    int const numArbors         = weights.getNumArbors();
    int const numDataPatches    = weights.getNumDataPatches();
    int const nxp               = weights.getPatchSizeX();
@@ -150,6 +156,8 @@ void testWeights(PV::Weights &weights, PV::PV_Init &pv_init, bool sharedFlag, bo
       writeStream = new PV::FileStream(path.c_str(), std::ios_base::out, false);
    }
    PV::WeightsFileIO weightsFileWrite(writeStream, mpiBlock, &weights);
+   weightsFileWrite.setLosslessCompression(losslessFlag);
+   weightsFileWrite.setStreamBufferSize(streamBufferSize);
    weightsFileWrite.writeWeights(timestamp, false);
    delete writeStream;
 
@@ -167,6 +175,7 @@ void testWeights(PV::Weights &weights, PV::PV_Init &pv_init, bool sharedFlag, bo
       readStream = new PV::FileStream(path.c_str(), std::ios_base::in, false);
    }
    PV::WeightsFileIO weightsFileRead(readStream, mpiBlock, &weights);
+   weightsFileRead.setStreamBufferSize(streamBufferSize);
    int const frameNumber = 0;
    double readTimestamp  = weightsFileRead.readWeights(frameNumber);
    delete readStream;
@@ -233,18 +242,47 @@ void testWeights(PV::Weights &weights, PV::PV_Init &pv_init, bool sharedFlag, bo
    }
 }
 
+std::size_t const defaultBufferSize = (std::size_t)1 << 22;
+
 void testShared(PV::PV_Init &pv_init) {
    bool const shared         = true;
    bool const noncompressed  = false;
+   bool const raw            = false;
    PV::Weights weightsObject = makeWeights(pv_init, std::string("shared_weights"), shared);
-   testWeights(weightsObject, pv_init, shared, noncompressed);
+   testWeights(weightsObject, pv_init, shared, noncompressed, raw, defaultBufferSize);
 }
 
 void testNonshared(PV::PV_Init &pv_init) {
    bool const nonshared      = false;
    bool const noncompressed  = false;
+   bool const raw            = false;
    PV::Weights weightsObject = makeWeights(pv_init, std::string("nonshared_weights"), nonshared);
-   testWeights(weightsObject, pv_init, nonshared, noncompressed);
+   testWeights(weightsObject, pv_init, nonshared, noncompressed, raw, defaultBufferSize);
+}
+
+void testSharedLossless(PV::PV_Init &pv_init) {
+   bool const shared         = true;
+   bool const noncompressed  = false;
+   bool const lossless       = true;
+   PV::Weights weightsObject = makeWeights(pv_init, std::string("shared_lossless"), shared);
+   testWeights(weightsObject, pv_init, shared, noncompressed, lossless, defaultBufferSize);
+}
+
+void testNonsharedLossless(PV::PV_Init &pv_init) {
+   bool const nonshared      = false;
+   bool const noncompressed  = false;
+   bool const lossless       = true;
+   PV::Weights weightsObject = makeWeights(pv_init, std::string("nonshared_lossless"), nonshared);
+   testWeights(weightsObject, pv_init, nonshared, noncompressed, lossless, defaultBufferSize);
+}
+
+void testNonsharedStreaming(PV::PV_Init &pv_init) {
+   bool const nonshared      = false;
+   bool const noncompressed  = false;
+   bool const raw            = false;
+   PV::Weights weightsObject = makeWeights(pv_init, std::string("nonshared_streaming"), nonshared);
+   // A buffer smaller than one line of patches forces one line per chunk.
+   testWeights(weightsObject, pv_init, nonshared, noncompressed, raw, (std::size_t)1);
 }
 
 int main(int argc, char *argv[]) {
@@ -255,6 +293,9 @@ int main(int argc, char *argv[]) {
 
    testShared(pv_initObj);
    testNonshared(pv_initObj);
+   testSharedLossless(pv_initObj);
+   testNonsharedLossless(pv_initObj);
+   testNonsharedStreaming(pv_initObj);
 
    char *programPath = strdup(argv[0]);
    char *programName = basename(programPath);